@@ -11,5 +11,9 @@ for some program parts if implemented.
 Set the environment variable `GT_SEED` to an integer value to supply a seed for
 the random number generator. Can be overridden by the `-seed` option.
 
+Compiled type graphs of OBO files given to `-typecheck` are cached in the
+directory `$GT_CACHE_DIR`, if set, or in `$XDG_CACHE_HOME/genometools` or
+`$HOME/.cache/genometools` otherwise.
+
 Combinations are possible. Running the `gt` binary with `GT_ENV_OPTIONS=-help`
 shows all possible "environment options".]])
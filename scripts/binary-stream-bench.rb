@@ -0,0 +1,79 @@
+#!/usr/bin/env ruby
+
+# compare the time needed to read GFF3 files with the time needed to read the
+# same annotations from binary node streams (as written by gt gff3 -binaryout)
+
+require 'ostruct'
+require 'optparse'
+require 'tmpdir'
+
+def usage(opts,msg)
+  STDERR.puts "#{$0}: #{msg}\n#{opts.to_s}"
+  exit 1
+end
+
+def parseargs(argv)
+  options = OpenStruct.new
+  options.runs = 3
+  options.gt = "bin/gt"
+  opts = OptionParser.new
+  opts.banner = "Usage: #{$0} [options] GFF3_file [GFF3_file ...]"
+  opts.on("-r","--runs NUM",Integer,
+          "number of runs per invocation (default: #{options.runs})") do |x|
+    options.runs = x
+  end
+  opts.on("-g","--gt BINARY",
+          "gt binary to use (default: #{options.gt})") do |x|
+    options.gt = x
+  end
+  rest = opts.parse(argv)
+  if rest.empty?
+    usage(opts,"at least one GFF3 file is required")
+  end
+  if options.runs < 1
+    usage(opts,"number of runs must be positive")
+  end
+  options.files = rest
+  return options
+end
+
+def timed_run(cmd)
+  starttime = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  if not system("#{cmd} > /dev/null")
+    STDERR.puts "#{$0}: command failed: #{cmd}"
+    exit 1
+  end
+  return Process.clock_gettime(Process::CLOCK_MONOTONIC) - starttime
+end
+
+def invocations(gt,gff3file,binfile)
+  return [["read GFF3",        gff3file, "#{gt} gff3 -show no #{gff3file}"],
+          ["read binary",      binfile,  "#{gt} gff3 -binaryin -show no " +
+                                         "#{binfile}"],
+          ["GFF3 -> GFF3",     gff3file, "#{gt} gff3 #{gff3file}"],
+          ["binary -> GFF3",   binfile,  "#{gt} gff3 -binaryin #{binfile}"],
+          ["GFF3 -> binary",   gff3file, "#{gt} gff3 -binaryout #{gff3file}"],
+          ["binary -> binary", binfile,  "#{gt} gff3 -binaryin -binaryout " +
+                                         "#{binfile}"]]
+end
+
+options = parseargs(ARGV)
+Dir.mktmpdir do |tmpdir|
+  puts "# runs per invocation: #{options.runs}"
+  puts "# file\tinvocation\tinput_bytes\tmean_s\tmin_s"
+  options.files.each do |gff3file|
+    binfile = "#{tmpdir}/#{File.basename(gff3file)}.bin"
+    if not system("#{options.gt} gff3 -binaryout -force -o #{binfile} " +
+                  "#{gff3file}")
+      STDERR.puts "#{$0}: cannot convert #{gff3file}"
+      exit 1
+    end
+    invocations(options.gt,gff3file,binfile).each do |name,infile,cmd|
+      size = File.size(infile)
+      times = Array.new(options.runs) { timed_run(cmd) }
+      mean = times.inject(:+)/times.length
+      printf("%s\t%s\t%d\t%.2f\t%.2f\n",File.basename(gff3file),name,size,
+             mean,times.min)
+    end
+  end
+end
@@ -63,6 +63,10 @@ display_options = [
   ["blast",       "output matches in blast format 7 (tabular with comment " +
                   "lines; instead of gap opens, indels are displayed)"],
   ["gfa2",        "output matches in gfa2 format"],
+  ["paf",         "output matches in PAF format; the cigar string is added " +
+                  "as tag cg:Z: if cigar or cigarX is specified"],
+  ["sam",         "output matches in SAM format, without sequences and " +
+                  "with hard clipping of unaligned query ends"],
   ["custom",      "output matches in custom format, i.e. no columns are " +
                   "pre-defined; all columns have to be specified by the user"],
   ["cigar",       "display cigar string representing alignment " +
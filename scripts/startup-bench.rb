@@ -0,0 +1,76 @@
+#!/usr/bin/env ruby
+
+# measure the cold start latency of gt for a number of tool invocations on
+# small inputs, optionally for several gt binaries (e.g. before and after a
+# change of the driver)
+
+require 'ostruct'
+require 'optparse'
+require 'tmpdir'
+
+def usage(opts,msg)
+  STDERR.puts "#{$0}: #{msg}\n#{opts.to_s}"
+  exit 1
+end
+
+def parseargs(argv)
+  options = OpenStruct.new
+  options.runs = 50
+  options.testdata = "testdata"
+  opts = OptionParser.new
+  opts.banner = "Usage: #{$0} [options] gtbinary [gtbinary ...]"
+  opts.on("-r","--runs NUM",Integer,
+          "number of runs per invocation (default: #{options.runs})") do |x|
+    options.runs = x
+  end
+  opts.on("-t","--testdata DIR",
+          "directory with test data (default: #{options.testdata})") do |x|
+    options.testdata = x
+  end
+  rest = opts.parse(argv)
+  if rest.empty?
+    usage(opts,"at least one gt binary is required")
+  end
+  if options.runs < 1
+    usage(opts,"number of runs must be positive")
+  end
+  options.binaries = rest
+  return options
+end
+
+def invocations(testdata,indexname)
+  return [["version",        "-version"],
+          ["seqstat",        "seqstat #{testdata}/Atinsert.fna"],
+          ["encseq info",    "encseq info #{indexname}"],
+          ["gff3 tidy",      "gff3 -tidy " +
+                             "#{testdata}/standard_gene_as_tree.gff3"],
+          ["gff3validator",  "gff3validator " +
+                             "#{testdata}/standard_gene_as_tree.gff3"],
+          ["lua script",     "#{testdata}/gtscripts/arg.lua"]]
+end
+
+def timed_run(cmd)
+  starttime = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  system("#{cmd} > /dev/null 2>&1")
+  return Process.clock_gettime(Process::CLOCK_MONOTONIC) - starttime
+end
+
+options = parseargs(ARGV)
+Dir.mktmpdir do |tmpdir|
+  indexname = "#{tmpdir}/Atinsert"
+  if not system("#{options.binaries[0]} encseq encode -indexname " +
+                "#{indexname} #{options.testdata}/Atinsert.fna")
+    STDERR.puts "#{$0}: cannot encode #{options.testdata}/Atinsert.fna"
+    exit 1
+  end
+  puts "# runs per invocation: #{options.runs}"
+  puts "# invocation\tbinary\tmean_ms\tmin_ms"
+  invocations(options.testdata,indexname).each do |name,args|
+    options.binaries.each do |binary|
+      times = Array.new(options.runs) { timed_run("#{binary} #{args}") }
+      mean = 1000.0 * times.inject(:+)/times.length
+      min = 1000.0 * times.min
+      printf("%s\t%s\t%.2f\t%.2f\n",name,binary,mean,min)
+    end
+  end
+end
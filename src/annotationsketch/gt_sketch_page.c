@@ -27,6 +27,7 @@
 #if CAIRO_HAS_SVG_SURFACE
 #include <cairo-svg.h>
 #endif
+#include "core/assert_api.h"
 #include "core/bioseq.h"
 #include "core/cstr_api.h"
 #include "core/fileutils_api.h"
@@ -36,6 +37,7 @@
 #include "core/mathsupport.h"
 #include "core/option_api.h"
 #include "core/str.h"
+#include "core/str_array_api.h"
 #include "core/unused_api.h"
 #include "core/undef_api.h"
 #include "core/versionfunc.h"
@@ -44,6 +46,7 @@
 #include "annotationsketch/custom_track_gc_content_api.h"
 #include "annotationsketch/diagram.h"
 #include "extended/feature_index_memory.h"
+#include "extended/region_mapping.h"
 #include "annotationsketch/gt_sketch_page.h"
 #include "annotationsketch/layout.h"
 #include "annotationsketch/style.h"
@@ -218,6 +221,23 @@ static void draw_header(cairo_t *cr, const char *text, GT_UNUSED const char *fn,
   cairo_restore(cr);
 }
 
+/* If <seqfile> holds a single sequence, its description replaces <seqid>, so
+   that the sequence is used whatever its header says. */
+static bool sketch_page_single_seqid(GtStr *seqid, GtStr *seqfile)
+{
+  GtBioseq *bioseq;
+  bool replaced = false;
+  gt_assert(seqid && seqfile);
+  if ((bioseq = gt_bioseq_new(gt_str_get(seqfile), NULL))) {
+    if (gt_bioseq_number_of_sequences(bioseq) == 1) {
+      gt_str_set(seqid, gt_bioseq_get_description(bioseq, 0));
+      replaced = true;
+    }
+    gt_bioseq_delete(bioseq);
+  }
+  return replaced;
+}
+
 static int gt_sketch_page_runner(GT_UNUSED int argc,
                                  const char **argv,
                                  int parsed_args,
@@ -232,11 +252,11 @@ static int gt_sketch_page_runner(GT_UNUSED int argc,
   GtStr *prog, *gt_style_file;
   GtDiagram *d = NULL;
   GtLayout *l = NULL;
-  GtBioseq *bioseq = NULL;
+  GtRegionMapping *rm = NULL;
   GtCanvas *canvas = NULL;
   char *seqid = NULL;
-  const char *outfile = NULL;
-  GtUword start, height, num_pages = 0;
+  const char *outfile = NULL, *gcseq = NULL;
+  GtUword start, height, gcseqlen = 0, num_pages = 0;
   double offsetpos, usable_height;
   cairo_surface_t *surf = NULL;
   cairo_t *cr = NULL;
@@ -342,7 +362,25 @@ static int gt_sketch_page_runner(GT_UNUSED int argc,
                               - 4*TEXT_SPACER;
 
     if (gt_str_length(arguments->seqfile) > 0) {
-      bioseq = gt_bioseq_new(gt_str_get(arguments->seqfile), err);
+      GtStrArray *seqfiles = gt_str_array_new();
+      GtStr *seqidstr = gt_str_new_cstr(seqid);
+      gt_str_array_add(seqfiles, arguments->seqfile);
+      rm = gt_region_mapping_new_seqfiles(seqfiles, true, false);
+      gt_region_mapping_enable_match_desc_start(rm);
+      /* the view of the sequence is shared by the tracks of all pages */
+      had_err = gt_region_mapping_get_sequence_length(rm, &gcseqlen, seqidstr,
+                                                      err);
+      if (had_err && sketch_page_single_seqid(seqidstr, arguments->seqfile)) {
+        gt_error_unset(err);
+        had_err = gt_region_mapping_get_sequence_length(rm, &gcseqlen,
+                                                        seqidstr, err);
+      }
+      if (!had_err) {
+        had_err = gt_region_mapping_get_sequence_view(rm, &gcseq, seqidstr, 1,
+                                                      gcseqlen, err);
+      }
+      gt_str_delete(seqidstr);
+      gt_str_array_delete(seqfiles);
     }
 
     cr = cairo_create(surf);
@@ -353,7 +391,6 @@ static int gt_sketch_page_runner(GT_UNUSED int argc,
     {
       GtRange single_range;
       GtCustomTrack *ct = NULL;
-      const char *seq;
       single_range.start = start;
       single_range.end = start + arguments->width;
 
@@ -365,11 +402,9 @@ static int gt_sketch_page_runner(GT_UNUSED int argc,
         had_err = -1;
         break;
       }
-      if (bioseq) {
-        seq = gt_bioseq_get_sequence(bioseq, 0);
-        ct = gt_custom_track_gc_content_new(seq,
-                                      gt_bioseq_get_sequence_length(bioseq, 0),
-                                      800, 70, 0.4, true);
+      if (gcseq) {
+        ct = gt_custom_track_gc_content_new(gcseq, gcseqlen, 800, 70, 0.4,
+                                            true);
         gt_diagram_add_custom_track(d, ct);
       }
 
@@ -419,8 +454,7 @@ static int gt_sketch_page_runner(GT_UNUSED int argc,
     cairo_surface_finish(surf);
     cairo_surface_destroy(surf);
     cairo_debug_reset_static_data();
-    if (bioseq)
-      gt_bioseq_delete(bioseq);
+    gt_region_mapping_delete(rm);
     gt_style_delete(sty);
     gt_free(seqid);
     gt_str_delete(gt_style_file);
@@ -392,6 +392,25 @@ char* gt_bioseq_get_sequence_range(const GtBioseq *bs, GtUword idx,
   return out;
 }
 
+GtEncseqReader* gt_bioseq_create_reader(const GtBioseq *bs)
+{
+  gt_assert(bs);
+  return gt_encseq_create_reader_with_readmode(bs->encseq, GT_READMODE_FORWARD,
+                                               0);
+}
+
+void gt_bioseq_extract_sequence_range(const GtBioseq *bs, GtEncseqReader *esr,
+                                      char *out, GtUword idx, GtUword start,
+                                      GtUword end)
+{
+  GtUword startpos;
+  gt_assert(bs && esr && out);
+  gt_assert(idx < gt_encseq_num_of_sequences(bs->encseq) && end >= start);
+  startpos = gt_encseq_seqstartpos(bs->encseq, idx);
+  gt_encseq_extract_decoded_with_reader(esr, bs->encseq, out, startpos + start,
+                                        startpos + end);
+}
+
 GtUchar gt_bioseq_get_encoded_char(const GtBioseq *bs, GtUword index,
                                    GtUword position)
 {
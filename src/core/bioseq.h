@@ -48,6 +48,16 @@ char*       gt_bioseq_get_sequence(const GtBioseq*, GtUword index);
 char*       gt_bioseq_get_sequence_range(const GtBioseq*, GtUword index,
                                          GtUword start,
                                          GtUword end);
+/* Return a new reader which can be passed to
+   <gt_bioseq_extract_sequence_range()> for any <GtBioseq>. */
+GtEncseqReader* gt_bioseq_create_reader(const GtBioseq*);
+/* Write the characters from <start> to <end> of the sequence with given
+   <index> to <out>, which must have space for <end> - <start> + 1 characters.
+   <esr> is reused for reading, so that no memory is allocated. */
+void        gt_bioseq_extract_sequence_range(const GtBioseq*,
+                                             GtEncseqReader *esr, char *out,
+                                             GtUword index, GtUword start,
+                                             GtUword end);
 GtUchar     gt_bioseq_get_encoded_char(const GtBioseq*, GtUword index,
                                        GtUword position);
 void        gt_bioseq_get_encoded_sequence(const GtBioseq*, GtUchar *out,
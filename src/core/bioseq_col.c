@@ -33,6 +33,7 @@ struct GtBioseqCol {
   GtUword num_of_seqfiles;
   GtSeqInfoCache *grep_cache;
   GtHashmap *duplicates;
+  GtEncseqReader *esr;
   bool matchdescstart;
 };
 
@@ -48,6 +49,7 @@ static void gt_bioseq_col_delete(GtSeqCol *sc)
   if (!bsc) return;
   gt_seq_info_cache_delete(bsc->grep_cache);
   gt_hashmap_delete(bsc->duplicates);
+  gt_encseq_reader_delete(bsc->esr);
   for (i = 0; i < bsc->num_of_seqfiles; i++)
     gt_bioseq_delete(bsc->bioseqs[i]);
   gt_free(bsc->bioseqs);
@@ -232,7 +234,7 @@ static int gt_bioseq_col_grep_desc_sequence_length(GtSeqCol *sc,
   return had_err;
 }
 
-static int md5_to_index(GtBioseq **bioseq, GtUword *seqnum,
+static int md5_to_index(GtBioseq **bioseq, GtUword *filenum, GtUword *seqnum,
                         GtBioseqCol *bsc, GtStr *md5_seqid, GtError *err)
 {
   bool seqid_changed = false;
@@ -258,8 +260,11 @@ static int md5_to_index(GtBioseq **bioseq, GtUword *seqnum,
     *bioseq = bsc->bioseqs[i];
     *seqnum = gt_bioseq_md5_to_index(*bioseq, gt_str_get(md5_seqid) +
                                      GT_MD5_SEQID_PREFIX_LEN);
-    if (*seqnum != GT_UNDEF_UWORD)
+    if (*seqnum != GT_UNDEF_UWORD) {
+      if (filenum)
+        *filenum = i;
       break;
+    }
   }
   if (seqid_changed) /* reset seqid no matter what */
     seqid[GT_MD5_SEQID_TOTAL_LEN-1] = GT_MD5_SEQID_SEPARATOR;
@@ -282,7 +287,7 @@ static int gt_bioseq_col_md5_to_seq(GtSeqCol *sc, char **seq,
   gt_error_check(err);
   gt_assert(bsc && seq && md5_seqid && err);
   gt_assert(gt_md5_seqid_has_prefix(gt_str_get(md5_seqid)));
-  if (!(had_err = md5_to_index(&bioseq, &seqnum, bsc, md5_seqid, err))) {
+  if (!(had_err = md5_to_index(&bioseq, NULL, &seqnum, bsc, md5_seqid, err))) {
     gt_assert(seqnum != GT_UNDEF_UWORD);
     *seq = gt_bioseq_get_sequence_range(bioseq, seqnum, start, end);
   }
@@ -300,7 +305,7 @@ static int gt_bioseq_col_md5_to_description(GtSeqCol *sc, GtStr *desc,
   gt_error_check(err);
   gt_assert(bsc && desc && md5_seqid && err);
   gt_assert(gt_md5_seqid_has_prefix(gt_str_get(md5_seqid)));
-  if (!(had_err = md5_to_index(&bioseq, &seqnum, bsc, md5_seqid, err))) {
+  if (!(had_err = md5_to_index(&bioseq, NULL, &seqnum, bsc, md5_seqid, err))) {
     gt_assert(seqnum != GT_UNDEF_UWORD);
     gt_str_append_cstr(desc, gt_bioseq_get_description(bioseq, seqnum));
   }
@@ -318,7 +323,7 @@ int gt_bioseq_col_md5_to_sequence_length(GtSeqCol *sc, GtUword *len,
   gt_error_check(err);
   gt_assert(bsc && len && md5_seqid && err);
   gt_assert(gt_md5_seqid_has_prefix(gt_str_get(md5_seqid)));
-  if (!(had_err = md5_to_index(&bioseq, &seqnum, bsc, md5_seqid, err))) {
+  if (!(had_err = md5_to_index(&bioseq, NULL, &seqnum, bsc, md5_seqid, err))) {
     gt_assert(seqnum != GT_UNDEF_UWORD);
     *len = gt_bioseq_get_sequence_length(bioseq, seqnum);
   }
@@ -385,6 +390,43 @@ static GtUword gt_bioseq_col_get_sequence_length(const GtSeqCol *sc,
   return gt_bioseq_get_sequence_length(bsc->bioseqs[filenum], seqnum);
 }
 
+static int gt_bioseq_col_grep_desc_index(GtSeqCol *sc, GtUword *filenum,
+                                         GtUword *seqnum, GtStr *seqid,
+                                         GtError *err)
+{
+  GtBioseqCol *bsc;
+  bsc = gt_bioseq_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(bsc && filenum && seqnum && seqid);
+  return grep_desc(bsc, filenum, seqnum, seqid, err);
+}
+
+static int gt_bioseq_col_md5_to_index(GtSeqCol *sc, GtUword *filenum,
+                                      GtUword *seqnum, GtStr *md5_seqid,
+                                      GtError *err)
+{
+  GtBioseq *bioseq = NULL;
+  GtBioseqCol *bsc;
+  bsc = gt_bioseq_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(bsc && filenum && seqnum && md5_seqid);
+  gt_assert(gt_md5_seqid_has_prefix(gt_str_get(md5_seqid)));
+  return md5_to_index(&bioseq, filenum, seqnum, bsc, md5_seqid, err);
+}
+
+static void gt_bioseq_col_extract_sequence(GtSeqCol *sc, char *buffer,
+                                           GtUword filenum, GtUword seqnum,
+                                           GtUword start, GtUword end)
+{
+  GtBioseqCol *bsc;
+  bsc = gt_bioseq_col_cast(sc);
+  gt_assert(bsc && filenum < bsc->num_of_seqfiles);
+  if (!bsc->esr)
+    bsc->esr = gt_bioseq_create_reader(bsc->bioseqs[filenum]);
+  gt_bioseq_extract_sequence_range(bsc->bioseqs[filenum], bsc->esr, buffer,
+                                   seqnum, start, end);
+}
+
 const GtSeqColClass* gt_bioseq_col_class(void)
 {
   static const GtSeqColClass *bsc_class = NULL;
@@ -405,7 +447,10 @@ const GtSeqColClass* gt_bioseq_col_class(void)
                                        gt_bioseq_col_get_md5_fingerprint,
                                        gt_bioseq_col_get_sequence,
                                        gt_bioseq_col_get_description,
-                                       gt_bioseq_col_get_sequence_length);
+                                       gt_bioseq_col_get_sequence_length,
+                                       gt_bioseq_col_grep_desc_index,
+                                       gt_bioseq_col_md5_to_index,
+                                       gt_bioseq_col_extract_sequence);
   }
   gt_class_alloc_lock_leave();
   return bsc_class;
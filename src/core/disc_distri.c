@@ -22,15 +22,18 @@
 #include "core/assert_api.h"
 #include "core/compat.h"
 #include "core/ensure.h"
-#include "core/hashmap-generic.h"
+#include "core/inthashmap-generic.h"
 #include "core/ma.h"
 #include "core/unused_api.h"
 
 #include "core/disc_distri_api.h"
 #include "core/disc_distri.h"
 
+DECLARE_INTHASHMAP(GtUword, ul, GtUint64, ull)
+DEFINE_INTHASHMAP(GtUword, ul, GtUint64, ull)
+
 struct GtDiscDistri {
-  GtHashtable *hashdist;
+  ul_ull_inthashmap *hashdist;
   GtUint64 num_of_occurrences;
 };
 
@@ -44,10 +47,6 @@ void gt_disc_distri_add(GtDiscDistri *d, GtUword key)
   gt_disc_distri_add_multi(d, key, (GtUint64) 1);
 }
 
-DECLARE_HASHMAP(GtUword, ul, GtUint64, ull, static, inline)
-DEFINE_HASHMAP(GtUword, ul, GtUint64, ull, gt_ht_ul_elem_hash,
-               gt_ht_ul_elem_cmp, NULL_DESTRUCTOR, NULL_DESTRUCTOR, static,
-               inline)
 
 void gt_disc_distri_add_multi(GtDiscDistri *d, GtUword key,
                               GtUint64 occurrences)
@@ -56,11 +55,11 @@ void gt_disc_distri_add_multi(GtDiscDistri *d, GtUword key,
   gt_assert(d);
 
   if (!d->hashdist)
-    d->hashdist = ul_ull_gt_hashmap_new();
+    d->hashdist = ul_ull_gt_inthashmap_new();
 
-  valueptr = ul_ull_gt_hashmap_get(d->hashdist, key);
+  valueptr = ul_ull_gt_inthashmap_get(d->hashdist, key);
   if (!valueptr) {
-    ul_ull_gt_hashmap_add(d->hashdist, key, occurrences);
+    ul_ull_gt_inthashmap_add(d->hashdist, key, occurrences);
   }
   else
     (*valueptr) += occurrences;
@@ -72,7 +71,8 @@ GtUint64 gt_disc_distri_get(const GtDiscDistri *d, GtUword key)
 {
   GtUint64 *valueptr;
   gt_assert(d);
-  if (!d->hashdist || !(valueptr = ul_ull_gt_hashmap_get(d->hashdist, key)))
+  if (!d->hashdist ||
+      !(valueptr = ul_ull_gt_inthashmap_get(d->hashdist, key)))
     return 0;
   return *valueptr;
 }
@@ -112,8 +112,9 @@ void gt_disc_distri_show(const GtDiscDistri *d, GtFile *outfp)
     showvalueinfo.cumulative_probability = 0.0;
     showvalueinfo.num_of_occurrences = d->num_of_occurrences;
     showvalueinfo.outfp = outfp;
-    rval = ul_ull_gt_hashmap_foreach_in_default_order(d->hashdist, showvalue,
-                                                      &showvalueinfo, NULL);
+    rval = ul_ull_gt_inthashmap_foreach_in_default_order(d->hashdist,
+                                                         showvalue,
+                                                         &showvalueinfo, NULL);
     gt_assert(!rval); /* showvalue() is sane */
   }
 }
@@ -139,7 +140,7 @@ static
 void gt_disc_distri_foreach_generic(const GtDiscDistri *d,
                                     GtDiscDistriIterFunc func,
                                     void *data,
-                                    ul_ull_gt_hashmap_KeyCmp cmp)
+                                    ul_ull_gt_inthashmap_KeyCmp cmp)
 {
   DiscDistriForeachInfo info;
   GT_UNUSED int rval;
@@ -148,11 +149,11 @@ void gt_disc_distri_foreach_generic(const GtDiscDistri *d,
     info.func = func;
     info.data = data;
     if (cmp != NULL)
-      rval = ul_ull_gt_hashmap_foreach_ordered(d->hashdist,
+      rval = ul_ull_gt_inthashmap_foreach_ordered(d->hashdist,
                                                disc_distri_foreach_iterfunc,
                                                &info, cmp, NULL);
     else
-      rval = ul_ull_gt_hashmap_foreach_in_default_order(d->hashdist,
+      rval = ul_ull_gt_inthashmap_foreach_in_default_order(d->hashdist,
                                                disc_distri_foreach_iterfunc,
                                                &info, NULL);
     gt_assert(!rval); /* disc_distri_foreach_iterfunc() is sane */
@@ -258,6 +259,6 @@ int gt_disc_distri_unit_test(GtError *err)
 void gt_disc_distri_delete(GtDiscDistri *d)
 {
   if (!d) return;
-  gt_hashtable_delete(d->hashdist);
+  ul_ull_gt_inthashmap_delete(d->hashdist);
   gt_free(d);
 }
@@ -30,6 +30,7 @@
 #include "core/chardef.h"
 #include "core/checkencchar.h"
 #include "core/codetype.h"
+#include "core/compat.h"
 #include "core/complement.h"
 #include "core/cstr_api.h"
 #include "core/defined-types.h"
@@ -39,6 +40,7 @@
 #include "core/encseq_access_type.h"
 #include "core/encseq_metadata.h"
 #include "core/encseq_rep.h"
+#include "core/encseq_spool.h"
 #include "core/ensure.h"
 #include "core/error.h"
 #include "core/fa.h"
@@ -51,9 +53,11 @@
 #include "core/ma_api.h"
 #include "core/mapspec.h"
 #include "core/mathsupport.h"
-#include "core/md5_encoder_api.h"
+#include "core/md5_encoder.h"
+#include "core/md5_fingerprint.h"
 #include "core/minmax.h"
 #include "core/progressbar.h"
+#include "core/resource_cache.h"
 #include "core/sequence_buffer_fasta.h"
 #include "core/sequence_buffer_plain.h"
 #include "core/str.h"
@@ -4526,6 +4530,20 @@ int gt_encseq_seppos2ssptab(const char *indexname,
 
 #define SIZEOFFUNCTAB sizeof (encodedseqfunctab)/sizeof (encodedseqfunctab[0])
 
+/* Returns the buffer delivering the input of the encoding: the spool filled
+   in the first pass or the sequence files. */
+static GtSequenceBuffer *encseq_input_buffer_new(const GtStrArray *filenametab,
+                                                 bool plainformat,
+                                                 GtEncseqSpool *spool,
+                                                 GtError *err)
+{
+  if (spool != NULL)
+    return gt_encseq_spool_sequence_buffer_new(spool);
+  if (plainformat)
+    return gt_sequence_buffer_plain_new(filenametab);
+  return gt_sequence_buffer_new_guess_type(filenametab, err);
+}
+
 static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                                        const GtFilelengthvalues *filelengthtab,
                                        bool plainformat,
@@ -4549,6 +4567,7 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                                        GtUword wildcardranges,
                                        GtUword minseqlength,
                                        GtUword maxseqlength,
+                                       GtEncseqSpool *spool,
                                        GtLogger *logger,
                                        GtError *err)
 {
@@ -4595,12 +4614,7 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
     encseq->subsymbolmap = subsymbolmap;
     encseq->maxsubalphasize = maxsubalphasize;
     gt_assert(filenametab != NULL);
-    if (plainformat) {
-      fb = gt_sequence_buffer_plain_new(filenametab);
-    }
-    else {
-      fb = gt_sequence_buffer_new_guess_type(filenametab, err);
-    }
+    fb = encseq_input_buffer_new(filenametab, plainformat, spool, err);
     if (!fb)
       haserr = true;
   }
@@ -5361,6 +5375,7 @@ static void determine_original_subdist(const GtAlphabet *alpha,
 static int countnumberofexceptionranges(const GtAlphabet *alpha,
                                         bool plainformat,
                                         const GtStrArray *filenametab,
+                                        GtEncseqSpool *spool,
                                         GtSpecialcharinfo *specialcharinfo,
                                         char *maxchars,
                                         GtError *err)
@@ -5368,10 +5383,7 @@ static int countnumberofexceptionranges(const GtAlphabet *alpha,
   int had_err = 0;
   GtSequenceBuffer *fb;
   GtUword currentpos;
-  if (plainformat)
-    fb = gt_sequence_buffer_plain_new(filenametab);
-  else
-    fb = gt_sequence_buffer_new_guess_type(filenametab, err);
+  fb = encseq_input_buffer_new(filenametab, plainformat, spool, err);
   if (!fb) {
     gt_assert(gt_error_is_set(err));
     had_err = -1;
@@ -5418,6 +5430,115 @@ static int countnumberofexceptionranges(const GtAlphabet *alpha,
   return had_err;
 }
 
+/* Writes the MD5 fingerprints of the sequences to the .md5 table. Sequences
+   shorter than GT_MD5_FINGERPRINT_MULTI_MAXLEN are collected and hashed
+   GT_MD5_ENCODER_LANES at a time by gt_md5_encoder_multi(). A longer sequence
+   is hashed block by block while it is read, after the collected shorter
+   ones have been written, so the order of the table is maintained. */
+typedef struct
+{
+  FILE *fp;
+  GtMD5Encoder *enc;
+  char lanes[GT_MD5_ENCODER_LANES][GT_MD5_FINGERPRINT_MULTI_MAXLEN],
+       blockbuf[64];
+  GtUword lanelengths[GT_MD5_ENCODER_LANES],
+          numoflanes,
+          blockcount;
+  bool streaming;
+} EncseqMD5Writer;
+
+static EncseqMD5Writer *encseq_md5_writer_new(FILE *fp)
+{
+  EncseqMD5Writer *md5writer = gt_malloc(sizeof *md5writer);
+
+  md5writer->fp = fp;
+  md5writer->enc = gt_md5_encoder_new();
+  md5writer->numoflanes = 0;
+  md5writer->lanelengths[0] = 0;
+  md5writer->blockcount = 0;
+  md5writer->streaming = false;
+  return md5writer;
+}
+
+static void encseq_md5_writer_flush_lanes(EncseqMD5Writer *md5writer)
+{
+  const char *messages[GT_MD5_ENCODER_LANES];
+  char outbuf[GT_MD5_ENCODER_LANES][33], *outstr[GT_MD5_ENCODER_LANES];
+  GtUword i;
+
+  if (md5writer->numoflanes == 0)
+    return;
+  for (i = 0; i < md5writer->numoflanes; i++) {
+    messages[i] = md5writer->lanes[i];
+    outstr[i] = outbuf[i];
+  }
+  gt_md5_encoder_multi(messages, md5writer->lanelengths, md5writer->numoflanes,
+                       outstr);
+  for (i = 0; i < md5writer->numoflanes; i++)
+    gt_xfwrite(outbuf[i], sizeof (char), (size_t) 33, md5writer->fp);
+  md5writer->numoflanes = 0;
+  md5writer->lanelengths[0] = 0;
+}
+
+static void encseq_md5_writer_add_to_block(EncseqMD5Writer *md5writer, char cc)
+{
+  if (md5writer->blockcount == 64UL) {
+    gt_md5_encoder_add_block(md5writer->enc, md5writer->blockbuf,
+                             md5writer->blockcount);
+    md5writer->blockcount = 0;
+  }
+  md5writer->blockbuf[md5writer->blockcount++] = cc;
+}
+
+static void encseq_md5_writer_add(EncseqMD5Writer *md5writer, char cc)
+{
+  GtUword lane = md5writer->numoflanes, i;
+
+  if (!md5writer->streaming) {
+    if (md5writer->lanelengths[lane] < GT_MD5_FINGERPRINT_MULTI_MAXLEN - 1) {
+      md5writer->lanes[lane][md5writer->lanelengths[lane]++] = cc;
+      return;
+    }
+    /* too long for the lanes, continue with the encoder */
+    for (i = 0; i < md5writer->lanelengths[lane]; i++)
+      encseq_md5_writer_add_to_block(md5writer, md5writer->lanes[lane][i]);
+    md5writer->streaming = true;
+  }
+  encseq_md5_writer_add_to_block(md5writer, cc);
+}
+
+static void encseq_md5_writer_next_sequence(EncseqMD5Writer *md5writer)
+{
+  unsigned char output[16];
+  char outbuf[33];
+
+  if (md5writer->streaming) {
+    gt_md5_encoder_add_block(md5writer->enc, md5writer->blockbuf,
+                             md5writer->blockcount);
+    gt_md5_encoder_finish(md5writer->enc, output, outbuf);
+    gt_md5_encoder_reset(md5writer->enc);
+    md5writer->blockcount = 0;
+    md5writer->streaming = false;
+    encseq_md5_writer_flush_lanes(md5writer);
+    md5writer->lanelengths[md5writer->numoflanes] = 0;
+    gt_xfwrite(outbuf, sizeof (char), (size_t) 33, md5writer->fp);
+  } else {
+    if (++md5writer->numoflanes == GT_MD5_ENCODER_LANES)
+      encseq_md5_writer_flush_lanes(md5writer);
+    else
+      md5writer->lanelengths[md5writer->numoflanes] = 0;
+  }
+}
+
+static void encseq_md5_writer_delete(EncseqMD5Writer *md5writer)
+{
+  if (md5writer == NULL)
+    return;
+  encseq_md5_writer_flush_lanes(md5writer);
+  gt_md5_encoder_delete(md5writer->enc);
+  gt_free(md5writer);
+}
+
 static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                            GtUword *totallength,
                                            GtSpecialcharinfo *specialcharinfo,
@@ -5445,6 +5566,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                            GtUword *minseqlen,
                                            GtUword *maxseqlen,
                                            bool clip_desc,
+                                           GtEncseqSpool *spool,
                                            GtLogger *logger,
                                            GtError *err)
 {
@@ -5457,16 +5579,12 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                 lastnonspecialrangelength = 0,
                 lengthofcurrentsequence = 0,
                 lengthofalphadef,
-                *originaldistribution = NULL,
-                md5_blockcount = 0;
+                *originaldistribution = NULL;
   bool specialprefix = true, wildcardprefix = true, haserr = false;
   GtDiscDistri *distspecialrangelength = NULL, *distwildcardrangelength = NULL;
   GtDescBuffer *descqueue = NULL;
-  GtMD5Encoder *md5enc = NULL;
-  char *desc,
-       md5_blockbuf[64],
-       md5_outbuf[33];
-  unsigned char md5_output[16];
+  EncseqMD5Writer *md5writer = NULL;
+  char *desc;
   FILE *desfp = NULL, *sdsfp = NULL, *oisfp = NULL, *md5fp = NULL;
 
   gt_error_check(err);
@@ -5480,12 +5598,9 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
   specialcharinfo->lengthofwildcardsuffix = 0;
 
   if (plainformat) {
-    fb = gt_sequence_buffer_plain_new(filenametab);
     equallength->defined = false;
   }
-  else {
-    fb = gt_sequence_buffer_new_guess_type(filenametab, err);
-  }
+  fb = encseq_input_buffer_new(filenametab, plainformat, NULL, err);
   if (!fb)
     haserr = true;
   if (!haserr && outdestab) {
@@ -5521,7 +5636,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
     originaldistribution = gt_calloc((size_t) UCHAR_MAX,
                                      sizeof (GtUword));
     if (md5fp != NULL)
-      md5enc = gt_md5_encoder_new();
+      md5writer = encseq_md5_writer_new(md5fp);
     for (currentpos = 0; !haserr; currentpos++) {
 #if !(defined (_LP64) || defined (_WIN64))
 #define MAXSFXLENFOR32BIT 4294000000UL
@@ -5534,6 +5649,8 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
 #endif
       retval = gt_sequence_buffer_next_with_original(fb, &charcode, &cc, err);
       if (retval > 0) {
+        if (spool != NULL)
+          gt_encseq_spool_add(spool, charcode, cc);
 #define WITHEQUALLENGTH_DES_SSP
 #define WITHOISTAB
 #define WITHCOUNTMINMAX
@@ -5566,11 +5683,8 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
             gt_disc_distri_add(distwildcardrangelength,
                                lastwildcardrangelength);
           }
-          if (md5enc != NULL) {
-            gt_md5_encoder_add_block(md5enc, md5_blockbuf, md5_blockcount);
-            gt_md5_encoder_finish(md5enc, md5_output, md5_outbuf);
-            gt_xfwrite(md5_outbuf, sizeof (char), (size_t) 33, md5fp);
-          }
+          if (md5writer != NULL)
+            encseq_md5_writer_next_sequence(md5writer);
           if (equallength->defined) {
             if (equallength->valueunsignedlong > 0) {
               if (lengthofcurrentsequence != equallength->valueunsignedlong) {
@@ -5592,22 +5706,39 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
         break;
       }
     }
-    gt_md5_encoder_delete(md5enc);
+    encseq_md5_writer_delete(md5writer);
+  }
+  if (!haserr && spool != NULL) {
+    gt_encseq_spool_finish(spool);
   }
   if (!haserr) {
     alphabet_to_key_values(alpha, NULL, &lengthofalphadef, NULL,
                            customalphabet);
   }
   if (!haserr) {
-    determine_original_subdist(alpha, maxchars, allchars, subsymbolmap,
-                               maxsubalphasize, numofallchars,
-                               classstartpositions, originaldistribution);
     if (outoistab) {
+      determine_original_subdist(alpha, maxchars, allchars, subsymbolmap,
+                                 maxsubalphasize, numofallchars,
+                                 classstartpositions, originaldistribution);
       retval = countnumberofexceptionranges(alpha, plainformat, filenametab,
-                                            specialcharinfo, maxchars, err);
+                                            spool, specialcharinfo, maxchars,
+                                            err);
       if (retval != 0)
         haserr = true;
     }
+    else {
+      unsigned int idx;
+
+      /* the original characters are only kept with lossless support, so
+         otherwise each encoded character counts as one original character,
+         as in an encoding written from a two bit encoding */
+      *numofallchars = 0;
+      for (idx = 0; idx < gt_alphabet_num_of_chars(alpha); idx++) {
+        if (characterdistribution[idx] > 0)
+          (*numofallchars)++;
+      }
+      *maxsubalphasize = (unsigned char) 1;
+    }
   }
   if (!haserr) {
     if (desfp != NULL) {
@@ -5697,15 +5828,11 @@ static void sequence2specialcharinfo(GtSpecialcharinfo *specialcharinfo,
   GtUword currentpos,
                 lastspecialrangelength = 0,
                 lastnonspecialrangelength = 0,
-                lastwildcardrangelength = 0,
-                md5_blockcount = 0;
+                lastwildcardrangelength = 0;
   bool specialprefix = true, wildcardprefix = true;
   GtDiscDistri *distspecialrangelength,
                *distwildcardrangelength;
-  GtMD5Encoder *md5enc = NULL;
-  char md5_blockbuf[64];
-  GT_UNUSED char md5_outbuf[33];
-  unsigned char md5_output[16];
+  EncseqMD5Writer *md5writer = NULL;
 
   specialcharinfo->specialcharacters = 0;
   specialcharinfo->wildcards = 0;
@@ -5714,7 +5841,6 @@ static void sequence2specialcharinfo(GtSpecialcharinfo *specialcharinfo,
   distspecialrangelength = gt_disc_distri_new();
   distwildcardrangelength = gt_disc_distri_new();
 
-  md5enc = gt_md5_encoder_new();
   for (currentpos = 0; currentpos < len; currentpos++) {
     char cc = '\0';
     bool outoistab = false;
@@ -5740,7 +5866,6 @@ static void sequence2specialcharinfo(GtSpecialcharinfo *specialcharinfo,
   specialcharinfo->wildcardranges = specialcharinfo->realwildcardranges;
   gt_disc_distri_delete(distspecialrangelength);
   gt_disc_distri_delete(distwildcardrangelength);
-  gt_md5_encoder_delete(md5enc);
 }
 
 static GtUword fwdgetnexttwobitencodingstopposViaequallength(
@@ -7515,6 +7640,9 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                           bool outmd5tab,
                                           bool esq_no_header,
                                           bool clip_desc,
+                                          bool usespool,
+                                          GtAlphabet *inputalphabet,
+                                          bool inputcustomalphabet,
                                           GtLogger *logger,
                                           GtError *err)
 {
@@ -7543,6 +7671,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
   GtEncseqAccessType sat = GT_ACCESS_TYPE_UNDEFINED;
   char *allchars = NULL,
        *maxchars = NULL;
+  GtEncseqSpool *spool = NULL;
 
   gt_error_check(err);
   filenametab = gt_str_array_ref(filenametab);
@@ -7557,7 +7686,10 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
     forcetable = 3U;
   }
   if (!haserr) {
-    if (isdna) {
+    if (inputalphabet != NULL) {
+      customalphabet = inputcustomalphabet;
+      alphabet = gt_alphabet_ref(inputalphabet);
+    } else if (isdna) {
       alphabet = gt_alphabet_new_dna();
     } else if (isprotein) {
       alphabet = gt_alphabet_new_protein();
@@ -7578,6 +7710,10 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
     classstartpositions = gt_calloc((size_t) UCHAR_MAX,
                                     sizeof (*classstartpositions));
     memset(&subsymbolmap, 0, ((size_t) UCHAR_MAX+1) * sizeof (unsigned char));
+    /* the spool keeps the parsed input for the second pass, it is only
+       compact for alphabets fitting into the two bit encoding */
+    if (usespool && gt_alphabet_num_of_chars(alphabet) <= 4U)
+      spool = gt_encseq_spool_new();
     if (gt_inputfiles2sequencekeyvalues(indexname,
                                         &totallength,
                                         &specialcharinfo,
@@ -7605,6 +7741,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                         &minseqlen,
                                         &maxseqlen,
                                         clip_desc,
+                                        spool,
                                         logger,
                                         err) != 0) {
       char buf[BUFSIZ];
@@ -7669,6 +7806,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                    wildcardranges,
                                    minseqlen,
                                    maxseqlen,
+                                   spool,
                                    logger,
                                    err);
     if (encseq == NULL)
@@ -7702,6 +7840,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
     gt_free(allchars);
   if (classstartpositions != NULL)
     gt_free(classstartpositions);
+  gt_encseq_spool_delete(spool);
   if (haserr) {
     gt_free(characterdistribution);
     gt_free(filelengthtab);
@@ -8148,7 +8287,8 @@ struct GtEncseqEncoder {
        isprotein,
        isplain,
        esq_no_header,
-       clip_desc;
+       clip_desc,
+       spool;
   GtStr *sat,
         *smapfile;
   GtLogger *logger;
@@ -8343,6 +8483,18 @@ void gt_encseq_encoder_disable_esq_header(GtEncseqEncoder *ee)
   ee->esq_no_header = true;
 }
 
+void gt_encseq_encoder_enable_spooling(GtEncseqEncoder *ee)
+{
+  gt_assert(ee);
+  ee->spool = true;
+}
+
+void gt_encseq_encoder_disable_spooling(GtEncseqEncoder *ee)
+{
+  gt_assert(ee);
+  ee->spool = false;
+}
+
 void gt_encseq_encoder_enable_multiseq_support(GtEncseqEncoder *ee)
 {
   gt_assert(ee);
@@ -8496,6 +8648,9 @@ int gt_encseq_encoder_encode(GtEncseqEncoder *ee, GtStrArray *seqfiles,
                                     ee->md5tab,
                                     ee->esq_no_header,
                                     ee->clip_desc,
+                                    ee->spool,
+                                    NULL,
+                                    false,
                                     ee->logger,
                                     err);
   if (!encseq)
@@ -8504,6 +8659,776 @@ int gt_encseq_encoder_encode(GtEncseqEncoder *ee, GtStrArray *seqfiles,
   return 0;
 }
 
+/* the tables of a temporary index, the first two are rewritten on appending
+   and replace those of the index, the others extend them in place */
+static const char *encseq_append_suffixes[] = {GT_ENCSEQFILESUFFIX,
+                                               GT_SSPTABFILESUFFIX,
+                                               GT_DESTABFILESUFFIX,
+                                               GT_SDSTABFILESUFFIX,
+                                               GT_MD5TABFILESUFFIX,
+                                               GT_ALPHABETFILESUFFIX};
+
+#define GT_ENCSEQ_APPEND_NUMOFREWRITTEN 2
+
+/* Reserves a unique name for a temporary index next to <indexname> by
+   creating an empty file of that name, like mkstemp(3). */
+static int encseq_append_tmpname(GtStr *tmpname, const char *indexname,
+                                 GtError *err)
+{
+  int fd;
+
+  gt_str_set(tmpname, indexname);
+  gt_str_append_cstr(tmpname, "-append.XXXXXX");
+  if ((fd = gt_mkstemp(gt_str_get(tmpname))) == -1) {
+    gt_error_set(err, "cannot create temporary file %s: %s",
+                 gt_str_get(tmpname), strerror(errno));
+    gt_str_reset(tmpname);
+    return -1;
+  }
+  gt_xclose(fd);
+  return 0;
+}
+
+/* Removes the tables of the temporary index <tmpname> and the file reserving
+   its name. */
+static void encseq_append_remove_index(const GtStr *tmpname)
+{
+  size_t idx;
+  GtStr *filename;
+
+  if (gt_str_length(tmpname) == 0)
+    return;
+  filename = gt_str_new();
+  for (idx = 0; idx < sizeof encseq_append_suffixes /
+                      sizeof encseq_append_suffixes[0]; idx++) {
+    gt_str_set(filename, gt_str_get(tmpname));
+    gt_str_append_cstr(filename, encseq_append_suffixes[idx]);
+    if (gt_file_exists(gt_str_get(filename)))
+      gt_xunlink(gt_str_get(filename));
+  }
+  if (gt_file_exists(gt_str_get(tmpname)))
+    gt_xunlink(gt_str_get(tmpname));
+  gt_str_delete(filename);
+}
+
+static bool encseq_append_table_exists(const char *indexname,
+                                       const char *suffix)
+{
+  char buf[BUFSIZ];
+  (void) snprintf(buf, BUFSIZ, "%s%s", indexname, suffix);
+  return gt_file_exists(buf);
+}
+
+/* Reads the trailer of the .des file of <indexname>, that is the length of
+   the longest description and an end marker. */
+static int encseq_append_destab_trailer(const char *indexname,
+                                        GtUword *deslength,
+                                        GtUword *longestdesc,
+                                        GtError *err)
+{
+  FILE *fp;
+  GtUword fin = 0;
+  off_t size;
+  int had_err = 0;
+
+  fp = gt_fa_fopen_with_suffix(indexname, GT_DESTABFILESUFFIX, "rb", err);
+  if (fp == NULL)
+    return -1;
+  size = gt_file_size_with_suffix(indexname, GT_DESTABFILESUFFIX);
+  if (size < (off_t) (2 * sizeof (GtUword))) {
+    had_err = -1;
+  } else {
+    gt_xfseek(fp, (GtWord) size - (GtWord) (2 * sizeof (GtUword)), SEEK_SET);
+    (void) gt_xfread_one(longestdesc, fp);
+    (void) gt_xfread_one(&fin, fp);
+    if (fin != ~0UL)
+      had_err = -1;
+  }
+  if (had_err) {
+    gt_error_set(err, "cannot append to description table %s%s without "
+                      "length information", indexname, GT_DESTABFILESUFFIX);
+  } else {
+    *deslength = (GtUword) size - 2 * sizeof (GtUword);
+  }
+  gt_fa_xfclose(fp);
+  return had_err;
+}
+
+/* Copies <length> bytes from the current position of <in> to <out>. */
+static void encseq_append_copy(FILE *out, FILE *in, GtUword length)
+{
+  char buffer[BUFSIZ];
+
+  while (length > 0) {
+    size_t len = (size_t) MIN(length, (GtUword) sizeof buffer);
+    (void) gt_xfread(buffer, sizeof (char), len, in);
+    gt_xfwrite(buffer, sizeof (char), len, out);
+    length -= (GtUword) len;
+  }
+}
+
+/* Extends the .des, .sds and .md5 tables of <indexname> in place by the
+   tables of the index <appendname>. All tables are opened before anything is
+   written, so that an error leaves the tables of <indexname> unchanged. */
+static int encseq_append_extend_tables(const char *indexname,
+                                       const char *appendname,
+                                       GtUword appendnumofsequences,
+                                       bool destab,
+                                       bool sdstab,
+                                       bool md5tab,
+                                       GtError *err)
+{
+  FILE *desout = NULL, *desin = NULL, *sdsout = NULL, *sdsin = NULL,
+       *md5out = NULL, *md5in = NULL;
+  GtUword deslength = 0, longestdesc = 0, appenddeslength = 0,
+          appendlongestdesc = 0, fin = ~0UL;
+  int had_err = 0;
+
+  if (destab) {
+    had_err = encseq_append_destab_trailer(indexname, &deslength,
+                                           &longestdesc, err);
+    if (!had_err)
+      had_err = encseq_append_destab_trailer(appendname, &appenddeslength,
+                                             &appendlongestdesc, err);
+    if (!had_err && (desout = gt_fa_fopen_with_suffix(indexname,
+                                                      GT_DESTABFILESUFFIX,
+                                                      "r+b", err)) == NULL)
+      had_err = -1;
+    if (!had_err && (desin = gt_fa_fopen_with_suffix(appendname,
+                                                     GT_DESTABFILESUFFIX,
+                                                     "rb", err)) == NULL)
+      had_err = -1;
+  }
+  if (!had_err && destab && sdstab) {
+    if ((sdsout = gt_fa_fopen_with_suffix(indexname, GT_SDSTABFILESUFFIX,
+                                          "ab", err)) == NULL)
+      had_err = -1;
+    if (!had_err && (sdsin = gt_fa_fopen_with_suffix(appendname,
+                                                     GT_SDSTABFILESUFFIX,
+                                                     "rb", err)) == NULL)
+      had_err = -1;
+  }
+  if (!had_err && md5tab) {
+    if ((md5out = gt_fa_fopen_with_suffix(indexname, GT_MD5TABFILESUFFIX,
+                                          "ab", err)) == NULL)
+      had_err = -1;
+    if (!had_err && (md5in = gt_fa_fopen_with_suffix(appendname,
+                                                     GT_MD5TABFILESUFFIX,
+                                                     "rb", err)) == NULL)
+      had_err = -1;
+  }
+  if (!had_err && desout != NULL) {
+    /* the new descriptions overwrite the trailer, which is then rewritten */
+    gt_xfseek(desout, (GtWord) deslength, SEEK_SET);
+    encseq_append_copy(desout, desin, appenddeslength);
+    longestdesc = MAX(longestdesc, appendlongestdesc);
+    gt_xfwrite_one(&longestdesc, desout);
+    gt_xfwrite_one(&fin, desout);
+  }
+  if (!had_err && sdsout != NULL) {
+    GtUword idx, desoffset;
+
+    /* the last description of the existing index now has a successor */
+    gt_assert(deslength > 0);
+    desoffset = deslength - 1;
+    gt_xfwrite_one(&desoffset, sdsout);
+    for (idx = 0; idx + 1 < appendnumofsequences; idx++) {
+      (void) gt_xfread_one(&desoffset, sdsin);
+      desoffset += deslength;
+      gt_xfwrite_one(&desoffset, sdsout);
+    }
+  }
+  if (!had_err && md5out != NULL) {
+    encseq_append_copy(md5out, md5in,
+                       (GtUword) gt_file_size_with_suffix(appendname,
+                                                          GT_MD5TABFILESUFFIX));
+  }
+  gt_fa_xfclose(desout);
+  gt_fa_xfclose(desin);
+  gt_fa_xfclose(sdsout);
+  gt_fa_xfclose(sdsin);
+  gt_fa_xfclose(md5out);
+  gt_fa_xfclose(md5in);
+  return had_err;
+}
+
+/* Adds the range [<start>,<end>) to <ranges>. If <join> is set, a range
+   adjacent to the last range of <ranges> extends that range. */
+static void encseq_append_add_range(GtArray *ranges, GtUword start,
+                                    GtUword end, bool join)
+{
+  GtRange range;
+
+  if (join && gt_array_size(ranges) > 0) {
+    GtRange *last = (GtRange *) gt_array_get_last(ranges);
+
+    if (last->end == start) {
+      last->end = end;
+      return;
+    }
+  }
+  range.start = start;
+  range.end = end;
+  gt_array_add(ranges, range);
+}
+
+/* Adds the maximal special ranges, the separator positions and the wildcard
+   ranges of <encseq>, shifted by <offset>, to the given arrays. Only the
+   special ranges are visited, not the sequence. */
+static void encseq_append_collect_ranges(GtArray *specialranges,
+                                         GtArray *separators,
+                                         GtArray *wildcardranges,
+                                         const GtEncseq *encseq,
+                                         GtUword offset)
+{
+  GtSpecialrangeiterator *sri;
+  GtRange range;
+  GtUword *seppos = NULL, sepidx = 0,
+          numofseparators = encseq->numofdbsequences - 1;
+
+  if (!encseq->has_specialranges)
+    return;
+  if (numofseparators > 0)
+    seppos = encseq2markpositions(encseq);
+  sri = gt_specialrangeiterator_new(encseq, true);
+  while (gt_specialrangeiterator_next(sri, &range)) {
+    GtUword pos = range.start;
+
+    encseq_append_add_range(specialranges, offset + range.start,
+                            offset + range.end, true);
+    /* split the special range at the separators */
+    while (pos < range.end) {
+      GtUword end = range.end;
+
+      if (sepidx < numofseparators && seppos[sepidx] < range.end) {
+        gt_assert(seppos[sepidx] >= pos);
+        end = seppos[sepidx];
+      }
+      if (end > pos)
+        encseq_append_add_range(wildcardranges, offset + pos, offset + end,
+                                false);
+      if (end < range.end) {
+        encseq_append_add_range(separators, offset + end, offset + end + 1,
+                                false);
+        sepidx++;
+        pos = end + 1;
+      } else {
+        pos = end;
+      }
+    }
+  }
+  gt_assert(sepidx == numofseparators);
+  gt_specialrangeiterator_delete(sri);
+  gt_free(seppos);
+}
+
+/* Sums up the ranges in <ranges> and reports the lengths of the ranges at
+   the start and at the end of a sequence of the given <totallength>. */
+static GtUword encseq_append_sum_ranges(GtDiscDistri *distrangelength,
+                                        GtUword *prefixlength,
+                                        GtUword *suffixlength,
+                                        const GtArray *ranges,
+                                        GtUword totallength)
+{
+  GtUword idx, sum = 0;
+
+  *prefixlength = *suffixlength = 0;
+  for (idx = 0; idx < gt_array_size(ranges); idx++) {
+    const GtRange *range = (const GtRange *) gt_array_get(ranges, idx);
+    GtUword length = range->end - range->start;
+
+    gt_disc_distri_add(distrangelength, length);
+    sum += length;
+    if (range->start == 0)
+      *prefixlength = length;
+    if (range->end == totallength)
+      *suffixlength = length;
+  }
+  return sum;
+}
+
+static void encseq_append_fillSWtable(GtEncseqAccessType sat,
+                                      GtSWtable *swtable,
+                                      const GtArray *ranges,
+                                      bool withrangelengths)
+{
+  switch (sat) {
+    case GT_ACCESS_TYPE_UCHARTABLES:
+      fillSWtablefromranges_uchar(&swtable->st_uchar, ranges,
+                                  withrangelengths);
+      break;
+    case GT_ACCESS_TYPE_USHORTTABLES:
+      fillSWtablefromranges_uint16(&swtable->st_uint16, ranges,
+                                   withrangelengths);
+      break;
+    case GT_ACCESS_TYPE_UINT32TABLES:
+      fillSWtablefromranges_uint32(&swtable->st_uint32, ranges,
+                                   withrangelengths);
+      break;
+    default:
+      fprintf(stderr, "%s(%d) undefined\n", __func__, (int) sat);
+      exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+}
+
+/* Stores the encoded character <cc> at position <pos> of the sequence
+   representation of <encseq>, the same way the fill functions do. */
+static void encseq_append_store(GtEncseq *encseq, GtUword pos, GtUchar cc)
+{
+  GtTwobitencoding code, *unit;
+  unsigned int shift;
+
+  switch (encseq->sat) {
+    case GT_ACCESS_TYPE_DIRECTACCESS:
+      encseq->plainseq[pos] = cc;
+      break;
+    case GT_ACCESS_TYPE_BYTECOMPRESS:
+      if (ISSPECIAL(cc)) {
+        cc = (GtUchar) (cc == (GtUchar) SEPARATOR ? encseq->numofchars + 1
+                                                 : encseq->numofchars);
+      }
+      bitpackarray_store_uint32(encseq->bitpackarray, (BitOffset) pos,
+                                (uint32_t) cc);
+      break;
+    default:
+      if (ISNOTSPECIAL(cc))
+        code = (GtTwobitencoding) cc;
+      else if (encseq->sat == GT_ACCESS_TYPE_BITACCESS) {
+        GT_SETIBIT(encseq->specialbits, pos);
+        code = (GtTwobitencoding) (cc == (GtUchar) SEPARATOR
+                                     ? GT_TWOBITS_FOR_SEPARATOR
+                                     : GT_TWOBITS_FOR_WILDCARD);
+      } else
+        code = (GtTwobitencoding) encseq->leastprobablecharacter;
+      shift = (unsigned int) GT_MULT2(GT_UNITSIN2BITENC - 1 -
+                                      GT_MODBYUNITSIN2BITENC(pos));
+      unit = encseq->twobitencoding + GT_DIVBYUNITSIN2BITENC(pos);
+      *unit = (*unit & ~((GtTwobitencoding) 3 << shift)) | (code << shift);
+      break;
+  }
+}
+
+/* Stores the <length> characters of <source> at <offset> in <encseq>. */
+static void encseq_append_store_encseq(GtEncseq *encseq, GtUword offset,
+                                       const GtEncseq *source, GtUword length)
+{
+  GtEncseqReader *esr;
+  GtUword pos;
+
+  esr = gt_encseq_create_reader_with_readmode(source, GT_READMODE_FORWARD, 0);
+  for (pos = 0; pos < length; pos++) {
+    encseq_append_store(encseq, offset + pos,
+                        gt_encseq_reader_next_encoded_char(esr));
+  }
+  gt_encseq_reader_delete(esr);
+}
+
+/* Fills the sequence representation of <merged> with the sequence of
+   <encseq>, a separator and the sequence of <appendencseq>. If both
+   representations are of the same kind, the stored part of <encseq> is copied
+   as a block and only its special characters, which may be encoded
+   differently in <merged>, are stored again. */
+static void encseq_append_fill_sequence(GtEncseq *merged,
+                                        const GtEncseq *encseq,
+                                        const GtEncseq *appendencseq,
+                                        const GtArray *separators,
+                                        const GtArray *wildcardranges)
+{
+  GtUword idx, pos, oldlength = encseq->totallength;
+  bool copy = false;
+
+  switch (merged->sat) {
+    case GT_ACCESS_TYPE_DIRECTACCESS:
+      merged->plainseq = gt_malloc(sizeof (*merged->plainseq) *
+                                   merged->totallength);
+      merged->hasplainseqptr = false;
+      if (encseq->sat == GT_ACCESS_TYPE_DIRECTACCESS) {
+        memcpy(merged->plainseq, encseq->plainseq,
+               sizeof (*merged->plainseq) * oldlength);
+        copy = true;
+      }
+      break;
+    case GT_ACCESS_TYPE_BYTECOMPRESS:
+      merged->bitpackarray
+        = bitpackarray_new(gt_alphabet_bits_per_symbol(merged->alpha),
+                           (BitOffset) merged->totallength, true);
+      if (encseq->sat == GT_ACCESS_TYPE_BYTECOMPRESS) {
+        memcpy(BITPACKARRAYSTOREVAR(merged->bitpackarray),
+               BITPACKARRAYSTOREVAR(encseq->bitpackarray),
+               sizeofbitarray(gt_alphabet_bits_per_symbol(merged->alpha),
+                              (BitOffset) oldlength));
+        copy = true;
+      }
+      break;
+    default:
+      merged->twobitencoding = gt_calloc((size_t) merged->unitsoftwobitencoding,
+                                         sizeof (*merged->twobitencoding));
+      if (merged->sat == GT_ACCESS_TYPE_BITACCESS) {
+        GT_INITBITTAB(merged->specialbits,
+                      merged->totallength + GT_INTWORDSIZE);
+        for (pos = merged->totallength;
+             pos < merged->totallength + GT_INTWORDSIZE; pos++) {
+          GT_SETIBIT(merged->specialbits, pos);
+        }
+      }
+      if (gt_encseq_has_twobitencoding(encseq)) {
+        /* the bits following the last character are 0 in both encodings */
+        memcpy(merged->twobitencoding, encseq->twobitencoding,
+               sizeof (*merged->twobitencoding) *
+               (GT_DIVBYUNITSIN2BITENC(oldlength - 1) + 1));
+        copy = true;
+      }
+      break;
+  }
+  if (copy) {
+    for (idx = 0; idx < gt_array_size(separators); idx++) {
+      const GtRange *range = (const GtRange *) gt_array_get(separators, idx);
+
+      if (range->start >= oldlength)
+        break;
+      encseq_append_store(merged, range->start, (GtUchar) SEPARATOR);
+    }
+    for (idx = 0; idx < gt_array_size(wildcardranges); idx++) {
+      const GtRange *range = (const GtRange *) gt_array_get(wildcardranges,
+                                                            idx);
+
+      if (range->start >= oldlength)
+        break;
+      for (pos = range->start; pos < range->end; pos++)
+        encseq_append_store(merged, pos, (GtUchar) WILDCARD);
+    }
+  } else {
+    encseq_append_store_encseq(merged, 0, encseq, oldlength);
+  }
+  encseq_append_store(merged, oldlength, (GtUchar) SEPARATOR);
+  encseq_append_store_encseq(merged, oldlength + 1, appendencseq,
+                             appendencseq->totallength);
+}
+
+/* Writes the .esq and .ssp tables for the concatenation of <encseq> and
+   <appendencseq> to <outname>. The header values are combined from both
+   headers and the special character tables are built from the special
+   ranges, so neither sequence is parsed again. */
+static int encseq_append_write_encseq(GtEncseqEncoder *ee,
+                                      const char *outname,
+                                      const GtEncseq *encseq,
+                                      const GtEncseq *appendencseq,
+                                      bool ssptab,
+                                      GtError *err)
+{
+  GtSpecialcharinfo specialcharinfo =
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  GtArray *specialranges, *separators, *wildcardranges;
+  GtDiscDistri *distspecialrangelength, *distwildcardrangelength;
+  GtStrArray *filenametab;
+  GtFilelengthvalues *filelengthtab;
+  GtUword idx, totallength, numofsequences, numofdbfiles, lengthofdbfilenames,
+          lengthofalphadef, specialrangestab[3], wildcardrangestab[3],
+          specialranges_sat, wildcardranges_sat, minseqlen, maxseqlen,
+          *characterdistribution;
+  unsigned int forcetable = 3U, numofchars;
+  bool customalphabet;
+  Definedunsignedlong equallength;
+  GtEncseq *merged = NULL;
+  int retcode, had_err = 0;
+
+  gt_error_check(err);
+  if (gt_str_length(ee->sat) > 0) {
+    retcode = getsatforcevalue(gt_str_get(ee->sat), err);
+    if (retcode < 0)
+      return -1;
+    forcetable = (unsigned int) retcode;
+  }
+  totallength = encseq->totallength + 1 + appendencseq->totallength;
+  numofsequences = encseq->numofdbsequences + appendencseq->numofdbsequences;
+  numofdbfiles = encseq->numofdbfiles + appendencseq->numofdbfiles;
+  numofchars = gt_alphabet_num_of_chars(encseq->alpha);
+  customalphabet = encseq->alphatype == 2UL;
+  filenametab = gt_str_array_new();
+  filelengthtab = gt_malloc(sizeof (*filelengthtab) * numofdbfiles);
+  for (idx = 0; idx < encseq->numofdbfiles; idx++) {
+    gt_str_array_add(filenametab,
+                     gt_str_array_get_str(encseq->filenametab, idx));
+    filelengthtab[idx] = encseq->headerptr.filelengthtab[idx];
+  }
+  for (idx = 0; idx < appendencseq->numofdbfiles; idx++) {
+    gt_str_array_add(filenametab,
+                     gt_str_array_get_str(appendencseq->filenametab, idx));
+    filelengthtab[encseq->numofdbfiles + idx]
+      = appendencseq->headerptr.filelengthtab[idx];
+  }
+  lengthofdbfilenames = determinelengthofdbfilenames(filenametab);
+  characterdistribution = initcharacterdistribution(encseq->alpha);
+  for (idx = 0; idx < (GtUword) numofchars; idx++) {
+    characterdistribution[idx]
+      = encseq->headerptr.characterdistribution[idx] +
+        appendencseq->headerptr.characterdistribution[idx];
+  }
+  minseqlen = MIN(encseq->minseqlen, appendencseq->minseqlen);
+  maxseqlen = MAX(encseq->maxseqlen, appendencseq->maxseqlen);
+
+  /* the sequences are joined by a separator, which also joins the special
+     ranges at the end of <encseq> and at the start of <appendencseq> */
+  specialranges = gt_array_new(sizeof (GtRange));
+  separators = gt_array_new(sizeof (GtRange));
+  wildcardranges = gt_array_new(sizeof (GtRange));
+  encseq_append_collect_ranges(specialranges, separators, wildcardranges,
+                               encseq, 0);
+  encseq_append_add_range(specialranges, encseq->totallength,
+                          encseq->totallength + 1, true);
+  encseq_append_add_range(separators, encseq->totallength,
+                          encseq->totallength + 1, false);
+  encseq_append_collect_ranges(specialranges, separators, wildcardranges,
+                               appendencseq, encseq->totallength + 1);
+  gt_assert(gt_array_size(separators) == numofsequences - 1);
+
+  distspecialrangelength = gt_disc_distri_new();
+  distwildcardrangelength = gt_disc_distri_new();
+  specialcharinfo.specialcharacters
+    = encseq_append_sum_ranges(distspecialrangelength,
+                               &specialcharinfo.lengthofspecialprefix,
+                               &specialcharinfo.lengthofspecialsuffix,
+                               specialranges, totallength);
+  specialcharinfo.wildcards
+    = encseq_append_sum_ranges(distwildcardrangelength,
+                               &specialcharinfo.lengthofwildcardprefix,
+                               &specialcharinfo.lengthofwildcardsuffix,
+                               wildcardranges, totallength);
+  specialcharinfo.lengthoflongestnonspecial
+    = MAX(encseq->specialcharinfo.lengthoflongestnonspecial,
+          appendencseq->specialcharinfo.lengthoflongestnonspecial);
+  alphabet_to_key_values(encseq->alpha, NULL, &lengthofalphadef, NULL,
+                         customalphabet);
+  doupdatesumranges(&specialcharinfo,
+                    forcetable,
+                    totallength,
+                    numofsequences,
+                    numofdbfiles,
+                    lengthofdbfilenames,
+                    numofchars,
+                    lengthofalphadef,
+                    specialrangestab,
+                    distspecialrangelength,
+                    wildcardrangestab,
+                    distwildcardrangelength,
+                    ee->logger);
+  gt_disc_distri_delete(distspecialrangelength);
+  gt_disc_distri_delete(distwildcardrangelength);
+#ifndef NDEBUG
+  gt_GtSpecialcharinfo_check(&specialcharinfo, numofsequences - 1);
+#endif
+  equallength.defined = !ee->isplain && minseqlen == maxseqlen &&
+                        specialcharinfo.wildcards == 0;
+  equallength.valueunsignedlong = equallength.defined ? minseqlen : 0;
+
+  retcode = gt_encseq_access_type_determine(&specialranges_sat,
+                                            &wildcardranges_sat,
+                                            totallength,
+                                            numofsequences,
+                                            numofdbfiles,
+                                            lengthofalphadef,
+                                            lengthofdbfilenames,
+                                            specialrangestab,
+                                            wildcardrangestab,
+                                            &equallength,
+                                            numofchars,
+                                            gt_str_length(ee->sat) > 0
+                                              ? gt_str_get(ee->sat)
+                                              : NULL,
+                                            err);
+  if (retcode < 0)
+    had_err = -1;
+  if (!had_err) {
+    merged = determineencseqkeyvalues((GtEncseqAccessType) retcode,
+                                      totallength,
+                                      numofsequences,
+                                      numofdbfiles,
+                                      lengthofdbfilenames,
+                                      wildcardranges_sat,
+                                      0,
+                                      minseqlen,
+                                      maxseqlen,
+                                      false,
+                                      false,
+                                      &equallength,
+                                      gt_alphabet_ref(encseq->alpha),
+                                      customalphabet,
+                                      ee->logger);
+    merged->headerptr.characterdistribution = characterdistribution;
+    merged->leastprobablecharacter
+      = determineleastprobablecharacter(merged->alpha, characterdistribution);
+    merged->filenametab = filenametab;
+    merged->headerptr.filelengthtab = filelengthtab;
+    merged->specialcharinfo = specialcharinfo;
+    /* as in a fresh encoding without lossless support */
+    merged->numofallchars = 0;
+    for (idx = 0; idx < (GtUword) numofchars; idx++) {
+      if (characterdistribution[idx] > 0)
+        merged->numofallchars++;
+    }
+    merged->maxsubalphasize = (unsigned char) 1;
+    filenametab = NULL;
+    filelengthtab = NULL;
+    characterdistribution = NULL;
+    if (numofsequences > 1UL &&
+        merged->sat != GT_ACCESS_TYPE_EQUALLENGTH &&
+        (ssptab || merged->accesstype_via_utables)) {
+      encseq_append_fillSWtable(merged->satsep, &merged->ssptab, separators,
+                                false);
+      merged->has_ssptab = true;
+    } else {
+      merged->satsep = GT_ACCESS_TYPE_UNDEFINED;
+    }
+    if (merged->accesstype_via_utables) {
+      encseq_append_fillSWtable(merged->sat, &merged->wildcardrangetable,
+                                wildcardranges, true);
+    }
+    encseq_append_fill_sequence(merged, encseq, appendencseq, separators,
+                                wildcardranges);
+    if (gt_encseq_flush2file(outname, merged, false, err) != 0)
+      had_err = -1;
+  }
+  if (!had_err && merged->satsep != GT_ACCESS_TYPE_UNDEFINED) {
+    Gtssptransferinfo ssptransferinfo;
+
+    ssptransferinfo.totallength = merged->totallength;
+    ssptransferinfo.numofdbsequences = merged->numofdbsequences;
+    ssptransferinfo.satsep = merged->satsep;
+    ssptransferinfo.ssptabptr = &merged->ssptab;
+    if (flushssptab2file(outname, &ssptransferinfo, err) != 0)
+      had_err = -1;
+  }
+  gt_encseq_delete(merged);
+  gt_array_delete(specialranges);
+  gt_array_delete(separators);
+  gt_array_delete(wildcardranges);
+  gt_str_array_delete(filenametab);
+  gt_free(filelengthtab);
+  gt_free(characterdistribution);
+  return had_err;
+}
+
+int gt_encseq_encoder_append(GtEncseqEncoder *ee, GtStrArray *seqfiles,
+                             const char *indexname, GtError *err)
+{
+  GtEncseqLoader *el;
+  GtEncseq *encseq = NULL, *appendencseq = NULL;
+  GtStr *appendname, *mergedname, *appendsat;
+  bool destab, sdstab, md5tab, ssptab;
+  GtUword idx, numofsequences = 0, appendnumofsequences = 0;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(ee && seqfiles && indexname);
+  appendname = gt_str_new();
+  mergedname = gt_str_new();
+  appendsat = gt_str_new();
+  destab = encseq_append_table_exists(indexname, GT_DESTABFILESUFFIX);
+  sdstab = encseq_append_table_exists(indexname, GT_SDSTABFILESUFFIX);
+  md5tab = encseq_append_table_exists(indexname, GT_MD5TABFILESUFFIX);
+  ssptab = ee->ssptab ||
+           encseq_append_table_exists(indexname, GT_SSPTABFILESUFFIX);
+  if (ee->oistab ||
+      encseq_append_table_exists(indexname, GT_OISTABFILESUFFIX)) {
+    gt_error_set(err, "cannot append to index %s with lossless support",
+                 indexname);
+    had_err = -1;
+  }
+  if (!had_err) {
+    el = gt_encseq_loader_new();
+    gt_encseq_loader_disable_autosupport(el);
+    gt_encseq_loader_set_logger(el, ee->logger);
+    encseq = gt_encseq_loader_load(el, indexname, err);
+    gt_encseq_loader_delete(el);
+    if (encseq == NULL)
+      had_err = -1;
+  }
+  if (!had_err) {
+    GtUword deslength, longestdesc;
+
+    /* fail before anything is written */
+    if (destab && encseq_append_destab_trailer(indexname, &deslength,
+                                               &longestdesc, err) != 0)
+      had_err = -1;
+  }
+  if (!had_err)
+    had_err = encseq_append_tmpname(appendname, indexname, err);
+  if (!had_err)
+    had_err = encseq_append_tmpname(mergedname, indexname, err);
+  if (!had_err) {
+    /* encode the new files only, with the alphabet of the existing index */
+    numofsequences = encseq->numofdbsequences;
+    appendencseq = gt_encseq_new_from_files(ee->pt,
+                                            gt_str_get(appendname),
+                                            ee->smapfile,
+                                            appendsat,
+                                            seqfiles,
+                                            ee->isdna,
+                                            ee->isprotein,
+                                            ee->isplain,
+                                            destab,
+                                            sdstab,
+                                            true,
+                                            false,
+                                            md5tab,
+                                            false,
+                                            ee->clip_desc,
+                                            ee->spool,
+                                            encseq->alpha,
+                                            encseq->alphatype == 2UL,
+                                            ee->logger,
+                                            err);
+    if (appendencseq == NULL)
+      had_err = -1;
+  }
+  if (!had_err) {
+    appendnumofsequences = appendencseq->numofdbsequences;
+    had_err = encseq_append_write_encseq(ee, gt_str_get(mergedname), encseq,
+                                         appendencseq, ssptab, err);
+  }
+  gt_encseq_delete(appendencseq);
+  gt_encseq_delete(encseq);
+  if (!had_err) {
+    had_err = encseq_append_extend_tables(indexname, gt_str_get(appendname),
+                                          appendnumofsequences, destab, sdstab,
+                                          md5tab, err);
+  }
+  if (!had_err) {
+    /* the descriptions are extended, now replace the sequence tables */
+    GtStr *from = gt_str_new(), *to = gt_str_new();
+
+    for (idx = 0; idx < (GtUword) GT_ENCSEQ_APPEND_NUMOFREWRITTEN; idx++) {
+      gt_str_set(from, gt_str_get(mergedname));
+      gt_str_append_cstr(from, encseq_append_suffixes[idx]);
+      gt_str_set(to, indexname);
+      gt_str_append_cstr(to, encseq_append_suffixes[idx]);
+      if (gt_file_exists(gt_str_get(from))) {
+        if (rename(gt_str_get(from), gt_str_get(to)) != 0) {
+          gt_error_set(err, "cannot rename %s to %s: %s", gt_str_get(from),
+                       gt_str_get(to), strerror(errno));
+          had_err = -1;
+          break;
+        }
+      } else if (strcmp(encseq_append_suffixes[idx],
+                        GT_SSPTABFILESUFFIX) == 0 &&
+                 gt_file_exists(gt_str_get(to))) {
+        /* e.g. no .ssp table is needed for sequences of equal length */
+        gt_xunlink(gt_str_get(to));
+      }
+    }
+    gt_str_delete(from);
+    gt_str_delete(to);
+  }
+  gt_log_log("appended "GT_WU" sequences to "GT_WU" sequences in %s",
+             appendnumofsequences, numofsequences, indexname);
+  encseq_append_remove_index(appendname);
+  encseq_append_remove_index(mergedname);
+  gt_str_delete(appendname);
+  gt_str_delete(mergedname);
+  gt_str_delete(appendsat);
+  return had_err;
+}
+
 void gt_encseq_encoder_delete(GtEncseqEncoder *ee)
 {
   if (!ee) return;
@@ -8724,10 +9649,21 @@ void gt_encseq_loader_do_not_mirror(GtEncseqLoader *el)
   el->mirrored = false;
 }
 
+static void* encseq_resource_cache_ref(void *encseq)
+{
+  return gt_encseq_ref(encseq);
+}
+
+static void encseq_resource_cache_delete(void *encseq)
+{
+  gt_encseq_delete(encseq);
+}
+
 GtEncseq* gt_encseq_loader_load(GtEncseqLoader *el, const char *indexname,
                                 GtError *err)
 {
   GtEncseq *encseq = NULL;
+  char cachekey[BUFSIZ], esqfile[BUFSIZ];
   gt_assert(el && indexname);
 
   if (el->autodiscover) {
@@ -8753,6 +9689,21 @@ GtEncseq* gt_encseq_loader_load(GtEncseqLoader *el, const char *indexname,
              indexname, el->destab, el->sdstab, el->ssptab, el->oistab,
              el->md5tab, el->mirrored);
 
+  if (gt_resource_cache_enabled()) {
+    (void) snprintf(cachekey, BUFSIZ, "encseq %d%d%d%d%d%d %s", el->destab,
+                    el->sdstab, el->ssptab, el->oistab, el->md5tab,
+                    el->mirrored, indexname);
+    (void) snprintf(esqfile, BUFSIZ, "%s%s", indexname,
+                    GT_ENCSEQFILESUFFIX);
+    if ((encseq = gt_resource_cache_get(cachekey, esqfile))) {
+      /* a user of the cached encseq may have changed its mirroring state */
+      if (gt_encseq_is_mirrored(encseq) == el->mirrored)
+        return encseq;
+      gt_encseq_delete(encseq);
+      encseq = NULL;
+      gt_resource_cache_remove(cachekey);
+    }
+  }
   encseq = gt_encseq_new_from_index(indexname,
                                     el->destab,
                                     el->sdstab,
@@ -8767,6 +9718,11 @@ GtEncseq* gt_encseq_loader_load(GtEncseqLoader *el, const char *indexname,
       encseq = NULL;
     }
   }
+  if (encseq && gt_resource_cache_enabled()) {
+    gt_resource_cache_add(cachekey, esqfile, encseq,
+                          encseq_resource_cache_ref,
+                          encseq_resource_cache_delete);
+  }
   return encseq;
 }
 
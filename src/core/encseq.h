@@ -61,6 +61,12 @@ GtEncseqLoader* gt_encseq_loader_new_from_options(GtEncseqOptions *opts,
 
 void gt_encseq_encoder_disable_esq_header(GtEncseqEncoder *ee);
 
+/* Keep the parsed input in a compact temporary spool while the input files
+   are read for the first time, so that the second pass over the input does
+   not parse the files again. Only used for alphabets of size at most 4. */
+void gt_encseq_encoder_enable_spooling(GtEncseqEncoder *ee);
+void gt_encseq_encoder_disable_spooling(GtEncseqEncoder *ee);
+
 /* The following type stores a two bit encoding in <tbe> with information
   about the number of two bit units which do not store a special
   character in <unitsnotspecial>. To allow the comparison of these
@@ -348,6 +348,17 @@ int               gt_encseq_encoder_encode(GtEncseqEncoder *ee,
                                           GtStrArray *seqfiles,
                                           const char *indexname,
                                           GtError *err);
+/* Appends the sequence files given in <seqfiles> to the existing index with
+   prefix <indexname>, using its alphabet. Only the new files are parsed. The
+   description, description separator and MD5 tables are extended in place,
+   while the sequence representation and the sequence separator table are
+   rewritten from the existing encoding, which takes time linear in the total
+   sequence length. Indexes with lossless support cannot be extended. Returns
+   0 on success, or a negative value on error (<err> is set accordingly). */
+int               gt_encseq_encoder_append(GtEncseqEncoder *ee,
+                                           GtStrArray *seqfiles,
+                                           const char *indexname,
+                                           GtError *err);
 /* Deletes <ee>. */
 void              gt_encseq_encoder_delete(GtEncseqEncoder *ee);
 
@@ -34,6 +34,7 @@ struct GtEncseqCol {
   GtMD5Tab *md5_tab;
   GtSeqInfoCache *grep_cache;
   GtHashmap *duplicates;
+  GtEncseqReader *esr;
   bool matchstart;
 };
 
@@ -48,6 +49,7 @@ static void gt_encseq_col_delete(GtSeqCol *sc)
   if (!esc) return;
   gt_seq_info_cache_delete(esc->grep_cache);
   gt_hashmap_delete(esc->duplicates);
+  gt_encseq_reader_delete(esc->esr);
   gt_md5_tab_delete(esc->md5_tab);
   gt_encseq_delete(esc->encseq);
 }
@@ -427,6 +429,72 @@ static GtUword gt_encseq_col_get_sequence_length(const GtSeqCol *sc,
   return gt_encseq_seqlength(esc->encseq, encseq_seqnum);
 }
 
+static int gt_encseq_col_grep_desc_index(GtSeqCol *sc, GtUword *filenum,
+                                         GtUword *seqnum, GtStr *seqid,
+                                         GtError *err)
+{
+  GtEncseqCol *esc;
+  esc = gt_encseq_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(esc && filenum && seqnum && seqid);
+  return gt_encseq_col_do_grep_desc(esc, filenum, seqnum, seqid, err);
+}
+
+static int gt_encseq_col_md5_to_index(GtSeqCol *sc, GtUword *filenum,
+                                      GtUword *seqnum, GtStr *md5_seqid,
+                                      GtError *err)
+{
+  GtUword encseq_seqnum;
+  char md5[GT_MD5_SEQID_HASH_LEN + 1];
+  GtEncseqCol *esc;
+  esc = gt_encseq_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(esc && filenum && seqnum && md5_seqid);
+  gt_assert(gt_md5_seqid_has_prefix(gt_str_get(md5_seqid)));
+  if (gt_str_length(md5_seqid) >= GT_MD5_SEQID_TOTAL_LEN &&
+      gt_str_get(md5_seqid)[GT_MD5_SEQID_TOTAL_LEN-1]
+        != GT_MD5_SEQID_SEPARATOR) {
+    gt_error_set(err, "MD5 sequence id %s not terminated with '%c'",
+                 gt_str_get(md5_seqid), GT_MD5_SEQID_SEPARATOR);
+    return -1;
+  }
+  strncpy(md5, gt_str_get(md5_seqid) + GT_MD5_SEQID_PREFIX_LEN,
+          GT_MD5_SEQID_HASH_LEN);
+  md5[GT_MD5_SEQID_HASH_LEN] = '\0';
+  encseq_seqnum = gt_md5_tab_map(esc->md5_tab, md5);
+  if (encseq_seqnum == GT_UNDEF_UWORD) {
+    gt_error_set(err, "sequence %s not found", gt_str_get(md5_seqid));
+    return -1;
+  }
+  *filenum = gt_encseq_filenum(esc->encseq,
+                               gt_encseq_seqstartpos(esc->encseq,
+                                                     encseq_seqnum));
+  *seqnum = encseq_seqnum - gt_encseq_filenum_first_seqnum(esc->encseq,
+                                                           *filenum);
+  return 0;
+}
+
+static void gt_encseq_col_extract_sequence(GtSeqCol *sc, char *buffer,
+                                           GtUword filenum, GtUword seqnum,
+                                           GtUword start, GtUword end)
+{
+  GtEncseqCol *esc;
+  GtUword encseq_seqnum, startpos;
+  esc = gt_encseq_col_cast(sc);
+  gt_assert(esc && filenum < gt_encseq_num_of_files(esc->encseq));
+  encseq_seqnum = gt_encseq_filenum_first_seqnum(esc->encseq, filenum) + seqnum;
+  gt_assert(encseq_seqnum < gt_encseq_num_of_sequences(esc->encseq));
+  gt_assert(start <= end);
+  startpos = gt_encseq_seqstartpos(esc->encseq, encseq_seqnum);
+  if (!esc->esr) {
+    esc->esr = gt_encseq_create_reader_with_readmode(esc->encseq,
+                                                     GT_READMODE_FORWARD,
+                                                     startpos + start);
+  }
+  gt_encseq_extract_decoded_with_reader(esc->esr, esc->encseq, buffer,
+                                        startpos + start, startpos + end);
+}
+
 const GtSeqColClass* gt_encseq_col_class(void)
 {
   static const GtSeqColClass *esc_class = NULL;
@@ -447,7 +515,10 @@ const GtSeqColClass* gt_encseq_col_class(void)
                                        gt_encseq_col_get_md5_fingerprint,
                                        gt_encseq_col_get_sequence,
                                        gt_encseq_col_get_description,
-                                       gt_encseq_col_get_sequence_length);
+                                       gt_encseq_col_get_sequence_length,
+                                       gt_encseq_col_grep_desc_index,
+                                       gt_encseq_col_md5_to_index,
+                                       gt_encseq_col_extract_sequence);
   }
   gt_class_alloc_lock_leave();
   return esc_class;
@@ -0,0 +1,357 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/divmodmul.h"
+#include "core/encseq_spool.h"
+#include "core/fa.h"
+#include "core/intbits.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/sequence_buffer_rep.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+
+#define GT_ENCSEQ_SPOOL_BLOCKSIZE   ((GtUword) 1 << 20)
+#define GT_ENCSEQ_SPOOL_REGULARCODES 4U
+#define GT_ENCSEQ_SPOOL_NUMOFWORDS(N)\
+        (((N) + GT_UNITSIN2BITENC - 1) / GT_UNITSIN2BITENC)
+
+typedef struct
+{
+  uint32_t relpos;
+  GtUchar charcode;
+  char orig;
+} GtEncseqSpoolException;
+
+typedef struct
+{
+  GtUword numofchars,
+          numofexceptions;
+  unsigned char regularorig[GT_ENCSEQ_SPOOL_REGULARCODES];
+} GtEncseqSpoolBlockHeader;
+
+typedef struct
+{
+  GtUchar *charcodes;
+  char *origs;
+  GtTwobitencoding *words;
+  GtEncseqSpoolException *exceptions;
+  GtUword numofchars;
+  FILE *fp;
+} GtEncseqSpoolBlock;
+
+struct GtEncseqSpool
+{
+  GtEncseqSpoolBlock blocks[2];
+  unsigned int current;
+  GtUword totallength;
+  FILE *fp;
+  bool finished;
+#ifdef GT_THREADS_ENABLED
+  GtThread *packer;
+#endif
+};
+
+GtEncseqSpool* gt_encseq_spool_new(void)
+{
+  GtEncseqSpool *spool = gt_malloc(sizeof *spool);
+  unsigned int idx;
+
+  spool->fp = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+  for (idx = 0; idx < 2U; idx++) {
+    GtEncseqSpoolBlock *block = spool->blocks + idx;
+
+    block->charcodes = gt_malloc(sizeof (*block->charcodes) *
+                                 GT_ENCSEQ_SPOOL_BLOCKSIZE);
+    block->origs = gt_malloc(sizeof (*block->origs) *
+                             GT_ENCSEQ_SPOOL_BLOCKSIZE);
+    block->words
+      = gt_malloc(sizeof (*block->words) *
+                  GT_ENCSEQ_SPOOL_NUMOFWORDS(GT_ENCSEQ_SPOOL_BLOCKSIZE));
+    block->exceptions = NULL;
+    block->numofchars = 0;
+    block->fp = spool->fp;
+  }
+  spool->current = 0;
+  spool->totallength = 0;
+  spool->finished = false;
+#ifdef GT_THREADS_ENABLED
+  spool->packer = NULL;
+#endif
+  return spool;
+}
+
+/* Converts the characters of <block> into the two bit encoding plus the
+   exception list and appends the result to the spool file. */
+static void encseq_spool_pack(GtEncseqSpoolBlock *block)
+{
+  GtEncseqSpoolBlockHeader header;
+  bool seen[GT_ENCSEQ_SPOOL_REGULARCODES] = {false};
+  GtUword idx, allocatedexceptions = 0;
+
+  header.numofchars = block->numofchars;
+  header.numofexceptions = 0;
+  memset(header.regularorig, 0, sizeof header.regularorig);
+  memset(block->words, 0, sizeof (*block->words) *
+                          GT_ENCSEQ_SPOOL_NUMOFWORDS(block->numofchars));
+  for (idx = 0; idx < block->numofchars; idx++) {
+    GtUchar cc = block->charcodes[idx];
+    char orig = block->origs[idx];
+
+    if (cc < (GtUchar) GT_ENCSEQ_SPOOL_REGULARCODES) {
+      if (!seen[cc]) {
+        seen[cc] = true;
+        header.regularorig[cc] = (unsigned char) orig;
+      }
+      block->words[GT_DIVBYUNITSIN2BITENC(idx)]
+        |= ((GtTwobitencoding) cc)
+           << GT_MULT2(GT_UNITSIN2BITENC - 1 - GT_MODBYUNITSIN2BITENC(idx));
+      if ((unsigned char) orig == header.regularorig[cc]) {
+        continue;
+      }
+    }
+    if (header.numofexceptions == allocatedexceptions) {
+      allocatedexceptions = allocatedexceptions * 2 + 128UL;
+      block->exceptions = gt_realloc(block->exceptions,
+                                     sizeof (*block->exceptions) *
+                                     allocatedexceptions);
+    }
+    block->exceptions[header.numofexceptions].relpos = (uint32_t) idx;
+    block->exceptions[header.numofexceptions].charcode = cc;
+    block->exceptions[header.numofexceptions++].orig = orig;
+  }
+  gt_xfwrite_one(&header, block->fp);
+  gt_xfwrite(block->words, sizeof (*block->words),
+             (size_t) GT_ENCSEQ_SPOOL_NUMOFWORDS(block->numofchars),
+             block->fp);
+  if (header.numofexceptions > 0) {
+    gt_xfwrite(block->exceptions, sizeof (*block->exceptions),
+               (size_t) header.numofexceptions, block->fp);
+  }
+}
+
+#ifdef GT_THREADS_ENABLED
+static void *encseq_spool_pack_thread(void *data)
+{
+  encseq_spool_pack((GtEncseqSpoolBlock *) data);
+  return NULL;
+}
+
+static void encseq_spool_wait(GtEncseqSpool *spool)
+{
+  if (spool->packer != NULL) {
+    gt_thread_join(spool->packer);
+    gt_thread_delete(spool->packer);
+    spool->packer = NULL;
+  }
+}
+#endif
+
+/* Hands the current block to the packer and switches to the other block.
+   At most one block is packed while the next one is filled. */
+static void encseq_spool_flush(GtEncseqSpool *spool)
+{
+  GtEncseqSpoolBlock *block = spool->blocks + spool->current;
+
+#ifdef GT_THREADS_ENABLED
+  encseq_spool_wait(spool);
+  if (gt_jobs > 1U) {
+    spool->packer = gt_thread_new(encseq_spool_pack_thread, block, NULL);
+  }
+  if (spool->packer == NULL) {
+    encseq_spool_pack(block);
+  }
+#else
+  encseq_spool_pack(block);
+#endif
+  spool->current = 1U - spool->current;
+  spool->blocks[spool->current].numofchars = 0;
+}
+
+void gt_encseq_spool_add(GtEncseqSpool *spool, GtUchar charcode, char orig)
+{
+  GtEncseqSpoolBlock *block = spool->blocks + spool->current;
+
+  gt_assert(!spool->finished);
+  block->charcodes[block->numofchars] = charcode;
+  block->origs[block->numofchars++] = orig;
+  spool->totallength++;
+  if (block->numofchars == GT_ENCSEQ_SPOOL_BLOCKSIZE) {
+    encseq_spool_flush(spool);
+  }
+}
+
+void gt_encseq_spool_finish(GtEncseqSpool *spool)
+{
+  gt_assert(!spool->finished);
+  if (spool->blocks[spool->current].numofchars > 0) {
+    encseq_spool_flush(spool);
+  }
+#ifdef GT_THREADS_ENABLED
+  encseq_spool_wait(spool);
+#endif
+  gt_xfflush(spool->fp);
+  spool->finished = true;
+}
+
+void gt_encseq_spool_delete(GtEncseqSpool *spool)
+{
+  unsigned int idx;
+
+  if (spool == NULL) {
+    return;
+  }
+#ifdef GT_THREADS_ENABLED
+  encseq_spool_wait(spool);
+#endif
+  for (idx = 0; idx < 2U; idx++) {
+    gt_free(spool->blocks[idx].charcodes);
+    gt_free(spool->blocks[idx].origs);
+    gt_free(spool->blocks[idx].words);
+    gt_free(spool->blocks[idx].exceptions);
+  }
+  gt_fa_xfclose(spool->fp);
+  gt_free(spool);
+}
+
+typedef struct
+{
+  const GtSequenceBuffer parent_instance;
+  GtEncseqSpool *spool;
+  GtEncseqSpoolBlockHeader header;
+  GtTwobitencoding *words;
+  GtEncseqSpoolException *exceptions;
+  GtUword nextchar,
+          nextexception,
+          allocatedexceptions;
+} GtSequenceBufferSpool;
+
+static const GtSequenceBufferClass* gt_sequence_buffer_spool_class(void);
+
+#define gt_sequence_buffer_spool_cast(SB)\
+        gt_sequence_buffer_cast(gt_sequence_buffer_spool_class(), SB)
+
+static bool gt_sequence_buffer_spool_next_block(GtSequenceBufferSpool *sbs)
+{
+  FILE *fp = sbs->spool->fp;
+
+  if (gt_xfread_one(&sbs->header, fp) != (size_t) 1) {
+    return false;
+  }
+  gt_assert(sbs->header.numofchars <= GT_ENCSEQ_SPOOL_BLOCKSIZE);
+  (void) gt_xfread(sbs->words, sizeof (*sbs->words),
+                   (size_t) GT_ENCSEQ_SPOOL_NUMOFWORDS(sbs->header.numofchars),
+                   fp);
+  if (sbs->header.numofexceptions > sbs->allocatedexceptions) {
+    sbs->allocatedexceptions = sbs->header.numofexceptions;
+    sbs->exceptions = gt_realloc(sbs->exceptions,
+                                 sizeof (*sbs->exceptions) *
+                                 sbs->allocatedexceptions);
+  }
+  if (sbs->header.numofexceptions > 0) {
+    (void) gt_xfread(sbs->exceptions, sizeof (*sbs->exceptions),
+                     (size_t) sbs->header.numofexceptions, fp);
+  }
+  sbs->nextchar = sbs->nextexception = 0;
+  return true;
+}
+
+static int gt_sequence_buffer_spool_advance(GtSequenceBuffer *sb,
+                                            GT_UNUSED GtError *err)
+{
+  GtSequenceBufferSpool *sbs = gt_sequence_buffer_spool_cast(sb);
+  GtSequenceBufferMembers *pvt = sb->pvt;
+  GtUword idx, width, endchar;
+
+  if (sbs->nextchar == sbs->header.numofchars &&
+      !gt_sequence_buffer_spool_next_block(sbs)) {
+    pvt->complete = true;
+    pvt->nextfree = 0;
+    return 0;
+  }
+  width = MIN((GtUword) OUTBUFSIZE, sbs->header.numofchars - sbs->nextchar);
+  endchar = sbs->nextchar + width;
+  for (idx = 0; idx < width; idx++) {
+    GtUword pos = sbs->nextchar + idx;
+    GtUchar cc
+      = (GtUchar) ((sbs->words[GT_DIVBYUNITSIN2BITENC(pos)]
+                    >> GT_MULT2(GT_UNITSIN2BITENC - 1 -
+                                GT_MODBYUNITSIN2BITENC(pos))) & 3);
+
+    pvt->outbuf[idx] = cc;
+    pvt->outbuforig[idx] = sbs->header.regularorig[cc];
+  }
+  while (sbs->nextexception < sbs->header.numofexceptions &&
+         (GtUword) sbs->exceptions[sbs->nextexception].relpos < endchar) {
+    const GtEncseqSpoolException *exception
+      = sbs->exceptions + sbs->nextexception++;
+
+    idx = (GtUword) exception->relpos - sbs->nextchar;
+    pvt->outbuf[idx] = exception->charcode;
+    pvt->outbuforig[idx] = (unsigned char) exception->orig;
+  }
+  sbs->nextchar = endchar;
+  pvt->nextfree = width;
+  return 0;
+}
+
+static GtUword gt_sequence_buffer_spool_get_file_index(GT_UNUSED
+                                                       GtSequenceBuffer *sb)
+{
+  return 0;
+}
+
+static void gt_sequence_buffer_spool_free(GtSequenceBuffer *sb)
+{
+  GtSequenceBufferSpool *sbs = gt_sequence_buffer_spool_cast(sb);
+
+  gt_free(sbs->words);
+  gt_free(sbs->exceptions);
+}
+
+static const GtSequenceBufferClass* gt_sequence_buffer_spool_class(void)
+{
+  static const GtSequenceBufferClass sbc = { sizeof (GtSequenceBufferSpool),
+                                      gt_sequence_buffer_spool_advance,
+                                      gt_sequence_buffer_spool_get_file_index,
+                                      gt_sequence_buffer_spool_free };
+  return &sbc;
+}
+
+GtSequenceBuffer* gt_encseq_spool_sequence_buffer_new(GtEncseqSpool *spool)
+{
+  GtSequenceBuffer *sb;
+  GtSequenceBufferSpool *sbs;
+
+  gt_assert(spool != NULL && spool->finished);
+  sb = gt_sequence_buffer_create(gt_sequence_buffer_spool_class());
+  sbs = gt_sequence_buffer_spool_cast(sb);
+  sbs->spool = spool;
+  sbs->words
+    = gt_malloc(sizeof (*sbs->words) *
+                GT_ENCSEQ_SPOOL_NUMOFWORDS(GT_ENCSEQ_SPOOL_BLOCKSIZE));
+  sbs->exceptions = NULL;
+  sbs->allocatedexceptions = 0;
+  sbs->header.numofchars = sbs->header.numofexceptions = 0;
+  sbs->nextchar = sbs->nextexception = 0;
+  sb->pvt->nextread = sb->pvt->nextfree = 0;
+  sb->pvt->complete = false;
+  sb->pvt->lastspeciallength = 0;
+  rewind(spool->fp);
+  return sb;
+}
@@ -0,0 +1,49 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ENCSEQ_SPOOL_H
+#define ENCSEQ_SPOOL_H
+
+#include "core/sequence_buffer.h"
+#include "core/types_api.h"
+
+/* A <GtEncseqSpool> stores the character codes delivered by a
+   <GtSequenceBuffer> together with the original characters in a temporary
+   file, so that the input files do not have to be parsed again. Character
+   codes smaller than 4 are stored in a two bit encoding, all other codes and
+   all characters differing from the first original character seen for their
+   code in the same block are stored as exceptions. Hence the spool is only
+   compact for alphabets with at most four characters. If threads are
+   available, the blocks are packed by a separate thread while the next
+   block is filled. */
+typedef struct GtEncseqSpool GtEncseqSpool;
+
+GtEncseqSpool*    gt_encseq_spool_new(void);
+
+/* Appends character code <charcode> with original character <orig>. */
+void              gt_encseq_spool_add(GtEncseqSpool *spool, GtUchar charcode,
+                                      char orig);
+
+/* Writes the remaining characters, must be called before reading. */
+void              gt_encseq_spool_finish(GtEncseqSpool *spool);
+
+/* Returns a new <GtSequenceBuffer> delivering the characters appended to
+   <spool>. Only one such buffer may be used at the same time. */
+GtSequenceBuffer* gt_encseq_spool_sequence_buffer_new(GtEncseqSpool *spool);
+
+void              gt_encseq_spool_delete(GtEncseqSpool *spool);
+
+#endif
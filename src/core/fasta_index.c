@@ -0,0 +1,982 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include "core/array.h"
+#include "core/assert_api.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/fasta_index.h"
+#include "core/fileutils_api.h"
+#include "core/hashmap_api.h"
+#include "core/ma.h"
+#include "core/md5_encoder_api.h"
+#include "core/md5_fingerprint_api.h"
+#include "core/minmax.h"
+#include "core/str_api.h"
+#include "core/undef_api.h"
+#include "core/xansi_api.h"
+
+#define BGZF_MAX_BLOCK_SIZE   65536
+#define BGZF_HEADER_SIZE      18
+#define BGZF_FOOTER_SIZE      8
+/* number of characters extracted at once when computing MD5 fingerprints */
+#define MD5_CHUNK_SIZE        (64 * 1024)
+
+typedef struct {
+  char *name;
+  GtUword length,
+          offset,    /* uncompressed file offset of the first character */
+          linebases, /* number of characters per line */
+          linewidth; /* number of bytes per line, including the newline */
+} GtFastaIndexEntry;
+
+typedef struct {
+  GtUword coffset, /* compressed file offset of the block */
+          uoffset; /* uncompressed file offset of the first byte of the block */
+} GtFastaIndexBlock;
+
+struct GtFastaIndex {
+  GtStr *sequence_file;
+  GtArray *entries;
+  char **descriptions,
+       **md5_fingerprints;
+  GtHashmap *md5_map;
+  const unsigned char *data; /* the memory mapped sequence file */
+  size_t datalen;
+  GtUword ulen;              /* the uncompressed length of the sequence file */
+  bool bgzf,
+       zs_initialized;
+  GtArray *blocks;           /* the blocks of a BGZF compressed file */
+  z_stream zs;
+  unsigned char *blockbuf;   /* the inflated content of the cached block */
+  GtUword cached_block,
+          cached_blocklen;
+};
+
+typedef enum {
+  FAI_LINE_START,
+  FAI_HEADER,
+  FAI_SEQUENCE
+} GtFastaIndexScanState;
+
+/* the state of the scanner building the index */
+typedef struct {
+  GtFastaIndex *fi;
+  GtFastaIndexScanState state;
+  GtFastaIndexEntry entry;
+  GtStr *name;
+  GtUword pos,       /* uncompressed offset of the next byte */
+          linewidth; /* bytes of the current line read so far */
+  char lastchar;
+  bool in_record,
+       name_complete,
+       short_line,
+       empty_line;
+} GtFastaIndexScanner;
+
+static GtUword read_le16(const unsigned char *p)
+{
+  return (GtUword) p[0] | ((GtUword) p[1] << 8);
+}
+
+static GtUword read_le32(const unsigned char *p)
+{
+  return read_le16(p) | (read_le16(p + 2) << 16);
+}
+
+static GtUint64 read_le64(const unsigned char *p)
+{
+  return (GtUint64) read_le32(p) | ((GtUint64) read_le32(p + 4) << 32);
+}
+
+static void write_le64(unsigned char *p, GtUint64 value)
+{
+  int i;
+  for (i = 0; i < 8; i++) {
+    p[i] = (unsigned char) (value & 0xff);
+    value >>= 8;
+  }
+}
+
+/* Returns the total size of the BGZF block starting at <p>, or 0 if there is
+   no valid BGZF block header within the <avail> bytes at <p>. */
+static GtUword bgzf_block_size(const unsigned char *p, GtUword avail)
+{
+  GtUword xlen, pos, bsize = 0;
+  if (avail < BGZF_HEADER_SIZE || p[0] != 31 || p[1] != 139 || p[2] != 8
+        || !(p[3] & 4))
+    return 0;
+  xlen = read_le16(p + 10);
+  if (12 + xlen > avail)
+    return 0;
+  for (pos = 12; pos + 4 <= 12 + xlen; pos += 4 + read_le16(p + pos + 2)) {
+    if (p[pos] == 'B' && p[pos + 1] == 'C' && read_le16(p + pos + 2) == 2
+          && pos + 6 <= 12 + xlen) {
+      bsize = read_le16(p + pos + 4) + 1;
+      break;
+    }
+  }
+  if (bsize < 12 + xlen + BGZF_FOOTER_SIZE || bsize > avail)
+    return 0;
+  return bsize;
+}
+
+static GtUword bgzf_block_isize(const unsigned char *p, GtUword bsize)
+{
+  return read_le32(p + bsize - 4);
+}
+
+/* Inflating a block can only fail if its compressed data is corrupt, as the
+   headers and sizes of all blocks are checked when the index is loaded. */
+static void bgzf_inflate_failed(const GtFastaIndex *fi, GtUword coffset)
+{
+  fprintf(stderr, "cannot inflate BGZF block at offset "GT_WU" of file "
+          "\"%s\": %s\n", coffset, gt_str_get(fi->sequence_file),
+          fi->zs.msg != NULL ? fi->zs.msg : "unexpected block length");
+  exit(EXIT_FAILURE);
+}
+
+static void bgzf_load_block(GtFastaIndex *fi, GtUword blocknum)
+{
+  const GtFastaIndexBlock *block = gt_array_get(fi->blocks, blocknum);
+  const unsigned char *p = fi->data + block->coffset;
+  GtUword bsize, xlen, isize;
+  bsize = bgzf_block_size(p, fi->datalen - block->coffset);
+  gt_assert(bsize > 0);
+  xlen = read_le16(p + 10);
+  isize = bgzf_block_isize(p, bsize);
+  gt_assert(isize <= BGZF_MAX_BLOCK_SIZE);
+  if (inflateReset(&fi->zs) != Z_OK)
+    bgzf_inflate_failed(fi, block->coffset);
+  fi->zs.next_in = (Bytef*) p + 12 + xlen;
+  fi->zs.avail_in = (uInt) (bsize - 12 - xlen - BGZF_FOOTER_SIZE);
+  fi->zs.next_out = fi->blockbuf;
+  fi->zs.avail_out = BGZF_MAX_BLOCK_SIZE;
+  if (inflate(&fi->zs, Z_FINISH) != Z_STREAM_END || fi->zs.total_out != isize)
+    bgzf_inflate_failed(fi, block->coffset);
+  fi->cached_block = blocknum;
+  fi->cached_blocklen = isize;
+}
+
+/* Returns the number of the last block starting at or before <upos>. */
+static GtUword bgzf_find_block(const GtFastaIndex *fi, GtUword upos)
+{
+  const GtFastaIndexBlock *blocks = gt_array_get_space(fi->blocks);
+  GtUword left = 0, right = gt_array_size(fi->blocks) - 1, mid;
+  gt_assert(gt_array_size(fi->blocks) > 0);
+  while (left < right) {
+    mid = left + (right - left + 1) / 2;
+    if (blocks[mid].uoffset <= upos)
+      left = mid;
+    else
+      right = mid - 1;
+  }
+  return left;
+}
+
+/* Copies the <len> bytes at uncompressed offset <upos> to <out>. */
+static void fasta_index_read(GtFastaIndex *fi, char *out, GtUword upos,
+                             GtUword len)
+{
+  gt_assert(upos + len <= fi->ulen);
+  if (!fi->bgzf) {
+    memcpy(out, fi->data + upos, len);
+    return;
+  }
+  while (len > 0) {
+    const GtFastaIndexBlock *block;
+    GtUword blockpos, n;
+    if (fi->cached_block != GT_UNDEF_UWORD) {
+      block = gt_array_get(fi->blocks, fi->cached_block);
+      if (upos < block->uoffset
+            || upos >= block->uoffset + fi->cached_blocklen) {
+        bgzf_load_block(fi, bgzf_find_block(fi, upos));
+      }
+    }
+    else
+      bgzf_load_block(fi, bgzf_find_block(fi, upos));
+    block = gt_array_get(fi->blocks, fi->cached_block);
+    gt_assert(upos >= block->uoffset);
+    blockpos = upos - block->uoffset;
+    gt_assert(blockpos < fi->cached_blocklen);
+    n = MIN(len, fi->cached_blocklen - blockpos);
+    memcpy(out, fi->blockbuf + blockpos, n);
+    out += n;
+    upos += n;
+    len -= n;
+  }
+}
+
+static int bgzf_scan_blocks(GtFastaIndex *fi, GtError *err)
+{
+  GtUword coffset = 0, uoffset = 0;
+  gt_error_check(err);
+  while (coffset < fi->datalen) {
+    GtFastaIndexBlock block;
+    GtUword bsize, isize;
+    bsize = bgzf_block_size(fi->data + coffset, fi->datalen - coffset);
+    if (!bsize) {
+      gt_error_set(err, "file \"%s\" is not BGZF compressed or truncated "
+                   "(no valid block at offset "GT_WU"), compress it with "
+                   "'bgzip' to allow indexed access",
+                   gt_str_get(fi->sequence_file), coffset);
+      return -1;
+    }
+    isize = bgzf_block_isize(fi->data + coffset, bsize);
+    if (isize > BGZF_MAX_BLOCK_SIZE) {
+      gt_error_set(err, "BGZF block at offset "GT_WU" of file \"%s\" is too "
+                   "large", coffset, gt_str_get(fi->sequence_file));
+      return -1;
+    }
+    /* skip empty blocks, e.g., the end-of-file marker */
+    if (isize > 0) {
+      block.coffset = coffset;
+      block.uoffset = uoffset;
+      gt_array_add(fi->blocks, block);
+    }
+    coffset += bsize;
+    uoffset += isize;
+  }
+  fi->ulen = uoffset;
+  return 0;
+}
+
+/* Loads the block index <path> in the format written by 'bgzip -i': the number
+   of entries followed by pairs of compressed and uncompressed offsets, all as
+   little endian 64-bit values, omitting the first block. */
+static int bgzf_load_blocks(GtFastaIndex *fi, const char *path, GtError *err)
+{
+  GtFastaIndexBlock block = {0, 0};
+  const GtFastaIndexBlock *last, *blocks;
+  unsigned char *buf;
+  size_t len;
+  GtUword i, num_of_entries = 0, bsize = 0, isize = 0;
+  int had_err = 0;
+  gt_error_check(err);
+  if (!(buf = gt_fa_mmap_read(path, &len, err)))
+    return -1;
+  if (len >= 8)
+    num_of_entries = (GtUword) read_le64(buf);
+  if (len < 8 || (len - 8) / 16 != num_of_entries || (len - 8) % 16 != 0) {
+    gt_error_set(err, "BGZF index file \"%s\" is corrupt", path);
+    had_err = -1;
+  }
+  gt_array_add(fi->blocks, block);
+  for (i = 0; !had_err && i < num_of_entries; i++) {
+    last = gt_array_get_last(fi->blocks);
+    block.coffset = (GtUword) read_le64(buf + 8 + 16 * i);
+    block.uoffset = (GtUword) read_le64(buf + 16 + 16 * i);
+    if (block.coffset <= last->coffset || block.uoffset < last->uoffset
+          || block.coffset >= fi->datalen) {
+      gt_error_set(err, "BGZF index file \"%s\" does not match file \"%s\"",
+                   path, gt_str_get(fi->sequence_file));
+      had_err = -1;
+    }
+    else
+      gt_array_add(fi->blocks, block);
+  }
+  gt_fa_xmunmap(buf);
+  /* make sure that the listed blocks are valid and follow each other, so
+     that they can be inflated without further checks */
+  blocks = gt_array_get_space(fi->blocks);
+  for (i = 0; !had_err && i < gt_array_size(fi->blocks); i++) {
+    bsize = bgzf_block_size(fi->data + blocks[i].coffset,
+                            fi->datalen - blocks[i].coffset);
+    if (bsize > 0)
+      isize = bgzf_block_isize(fi->data + blocks[i].coffset, bsize);
+    if (!bsize || isize > BGZF_MAX_BLOCK_SIZE ||
+        (i + 1 < gt_array_size(fi->blocks) &&
+         (blocks[i+1].coffset < blocks[i].coffset + bsize ||
+          blocks[i+1].uoffset != blocks[i].uoffset + isize))) {
+      gt_error_set(err, "BGZF index file \"%s\" does not match file \"%s\" "
+                   "(block at offset "GT_WU")", path,
+                   gt_str_get(fi->sequence_file), blocks[i].coffset);
+      had_err = -1;
+    }
+  }
+  if (!had_err)
+    fi->ulen = blocks[gt_array_size(fi->blocks) - 1].uoffset + isize;
+  return had_err;
+}
+
+static void bgzf_write_blocks(const GtFastaIndex *fi, const char *path)
+{
+  unsigned char buf[16];
+  GtUword i, first;
+  FILE *fp;
+  if (!(fp = gt_fa_fopen(path, "wb", NULL)))
+    return;
+  /* the first block is implicit */
+  first = (gt_array_size(fi->blocks) > 0 &&
+           ((GtFastaIndexBlock*) gt_array_get_first(fi->blocks))->coffset == 0)
+          ? 1 : 0;
+  write_le64(buf, (GtUint64) (gt_array_size(fi->blocks) - first));
+  (void) fwrite(buf, 1, 8, fp);
+  for (i = first; i < gt_array_size(fi->blocks); i++) {
+    const GtFastaIndexBlock *block = gt_array_get(fi->blocks, i);
+    write_le64(buf, (GtUint64) block->coffset);
+    write_le64(buf + 8, (GtUint64) block->uoffset);
+    (void) fwrite(buf, 1, 16, fp);
+  }
+  if (ferror(fp)) {
+    gt_fa_fclose(fp);
+    (void) remove(path);
+    return;
+  }
+  gt_fa_fclose(fp);
+}
+
+static void scanner_add_entry(GtFastaIndexScanner *sc)
+{
+  gt_array_add(sc->fi->entries, sc->entry);
+  sc->entry.name = NULL;
+  sc->in_record = false;
+}
+
+static int scanner_end_header(GtFastaIndexScanner *sc, GtUword offset,
+                              GtError *err)
+{
+  gt_error_check(err);
+  if (!gt_str_length(sc->name)) {
+    gt_error_set(err, "empty sequence name in header at offset "GT_WU" of file "
+                 "\"%s\"", sc->pos, gt_str_get(sc->fi->sequence_file));
+    return -1;
+  }
+  sc->entry.name = gt_cstr_dup(gt_str_get(sc->name));
+  sc->entry.length = sc->entry.linebases = sc->entry.linewidth = 0;
+  sc->entry.offset = offset;
+  sc->in_record = true;
+  sc->short_line = sc->empty_line = false;
+  return 0;
+}
+
+static int scanner_end_line(GtFastaIndexScanner *sc, bool newline,
+                            GtError *err)
+{
+  GtFastaIndexEntry *e = &sc->entry;
+  GtUword bases = sc->linewidth;
+  gt_error_check(err);
+  if (newline) {
+    bases--;
+    if (bases > 0 && sc->lastchar == '\r')
+      bases--;
+  }
+  if (!sc->in_record) {
+    if (bases > 0) {
+      gt_error_set(err, "file \"%s\" does not start with a FASTA header line",
+                   gt_str_get(sc->fi->sequence_file));
+      return -1;
+    }
+    return 0;
+  }
+  if (bases == 0) {
+    sc->empty_line = true;
+    return 0;
+  }
+  if (sc->empty_line) {
+    gt_error_set(err, "empty line within sequence '%s' of file \"%s\" cannot "
+                 "be indexed", e->name, gt_str_get(sc->fi->sequence_file));
+    return -1;
+  }
+  if (e->linebases == 0) {
+    e->linebases = bases;
+    e->linewidth = newline ? sc->linewidth : bases + 1;
+  }
+  else if (sc->short_line || bases > e->linebases
+             || (newline && bases == e->linebases
+                 && sc->linewidth != e->linewidth)) {
+    gt_error_set(err, "sequence '%s' of file \"%s\" has lines of different "
+                 "length and cannot be indexed", e->name,
+                 gt_str_get(sc->fi->sequence_file));
+    return -1;
+  }
+  else if (bases < e->linebases)
+    sc->short_line = true;
+  e->length += bases;
+  return 0;
+}
+
+static int scanner_feed(GtFastaIndexScanner *sc, const char *buf, GtUword len,
+                        GtError *err)
+{
+  const char *end = buf + len, *nl;
+  int had_err = 0;
+  gt_error_check(err);
+  while (!had_err && buf < end) {
+    switch (sc->state) {
+      case FAI_LINE_START:
+        sc->linewidth = 0;
+        if (*buf == '>') {
+          if (sc->in_record)
+            scanner_add_entry(sc);
+          gt_str_reset(sc->name);
+          sc->name_complete = false;
+          sc->state = FAI_HEADER;
+          buf++;
+          sc->pos++;
+        }
+        else
+          sc->state = FAI_SEQUENCE;
+        break;
+      case FAI_HEADER:
+        if (*buf == '\n') {
+          had_err = scanner_end_header(sc, sc->pos + 1, err);
+          sc->state = FAI_LINE_START;
+        }
+        else if (!sc->name_complete) {
+          if (isspace((unsigned char) *buf))
+            sc->name_complete = true;
+          else
+            gt_str_append_char(sc->name, *buf);
+        }
+        buf++;
+        sc->pos++;
+        break;
+      case FAI_SEQUENCE:
+        nl = memchr(buf, '\n', end - buf);
+        if (nl) {
+          sc->linewidth += nl - buf + 1;
+          if (nl > buf)
+            sc->lastchar = *(nl - 1);
+          sc->pos += nl - buf + 1;
+          buf = nl + 1;
+          had_err = scanner_end_line(sc, true, err);
+          sc->lastchar = '\n';
+          sc->state = FAI_LINE_START;
+        }
+        else {
+          sc->linewidth += end - buf;
+          sc->lastchar = *(end - 1);
+          sc->pos += end - buf;
+          buf = end;
+        }
+        break;
+    }
+  }
+  return had_err;
+}
+
+static int scanner_finish(GtFastaIndexScanner *sc, GtError *err)
+{
+  int had_err = 0;
+  gt_error_check(err);
+  if (sc->state == FAI_HEADER)
+    had_err = scanner_end_header(sc, sc->pos, err);
+  else if (sc->state == FAI_SEQUENCE && sc->linewidth > 0)
+    had_err = scanner_end_line(sc, false, err);
+  if (!had_err && sc->in_record)
+    scanner_add_entry(sc);
+  if (!had_err && !gt_array_size(sc->fi->entries)) {
+    gt_error_set(err, "file \"%s\" does not contain any sequence",
+                 gt_str_get(sc->fi->sequence_file));
+    had_err = -1;
+  }
+  return had_err;
+}
+
+static int fasta_index_build(GtFastaIndex *fi, GtError *err)
+{
+  GtFastaIndexScanner sc;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  memset(&sc, 0, sizeof sc);
+  sc.fi = fi;
+  sc.state = FAI_LINE_START;
+  sc.name = gt_str_new();
+  if (!fi->bgzf)
+    had_err = scanner_feed(&sc, (const char*) fi->data, fi->datalen, err);
+  else {
+    for (i = 0; !had_err && i < gt_array_size(fi->blocks); i++) {
+      bgzf_load_block(fi, i);
+      had_err = scanner_feed(&sc, (const char*) fi->blockbuf,
+                             fi->cached_blocklen, err);
+    }
+  }
+  if (!had_err)
+    had_err = scanner_finish(&sc, err);
+  gt_free(sc.entry.name);
+  gt_str_delete(sc.name);
+  return had_err;
+}
+
+static void fasta_index_write(const GtFastaIndex *fi, const char *path)
+{
+  GtUword i;
+  FILE *fp;
+  if (!(fp = gt_fa_fopen(path, "w", NULL)))
+    return;
+  for (i = 0; i < gt_array_size(fi->entries); i++) {
+    const GtFastaIndexEntry *e = gt_array_get(fi->entries, i);
+    fprintf(fp, "%s\t"GT_WU"\t"GT_WU"\t"GT_WU"\t"GT_WU"\n", e->name, e->length,
+            e->offset, e->linebases, e->linewidth);
+  }
+  if (ferror(fp)) {
+    gt_fa_fclose(fp);
+    (void) remove(path);
+    return;
+  }
+  gt_fa_fclose(fp);
+}
+
+static const char* parse_uword(GtUword *value, const char *p, const char *end,
+                               char delim)
+{
+  if (p == end || !isdigit((unsigned char) *p))
+    return NULL;
+  *value = 0;
+  while (p < end && isdigit((unsigned char) *p))
+    *value = *value * 10 + (*p++ - '0');
+  if (p < end && *p == '\r')
+    p++;
+  if (p == end)
+    return delim == '\n' ? p : NULL;
+  return *p == delim ? p + 1 : NULL;
+}
+
+/* Checks that the last character of the sequence described by <e> lies within
+   the sequence file. */
+static bool entry_is_valid(const GtFastaIndex *fi, const GtFastaIndexEntry *e)
+{
+  GtUword last;
+  if (e->length == 0)
+    return e->offset <= fi->ulen;
+  if (e->linebases == 0 || e->linewidth <= e->linebases)
+    return false;
+  last = e->offset + ((e->length - 1) / e->linebases) * e->linewidth
+           + (e->length - 1) % e->linebases;
+  return last < fi->ulen;
+}
+
+static int fasta_index_load(GtFastaIndex *fi, const char *path, GtError *err)
+{
+  const char *buf, *p, *end, *tab;
+  GtFastaIndexEntry e;
+  size_t len;
+  int had_err = 0;
+  gt_error_check(err);
+  if (!(buf = gt_fa_mmap_read(path, &len, err)))
+    return -1;
+  end = buf + len;
+  for (p = buf; !had_err && p < end; /* nothing */) {
+    tab = memchr(p, '\t', end - p);
+    if (!tab || tab == p || memchr(p, '\n', tab - p)) {
+      had_err = -1;
+      break;
+    }
+    e.name = gt_cstr_dup_nt(p, tab - p);
+    if (!(p = parse_uword(&e.length, tab + 1, end, '\t'))
+          || !(p = parse_uword(&e.offset, p, end, '\t'))
+          || !(p = parse_uword(&e.linebases, p, end, '\t'))
+          || !(p = parse_uword(&e.linewidth, p, end, '\n'))
+          || !entry_is_valid(fi, &e)) {
+      gt_free(e.name);
+      had_err = -1;
+      break;
+    }
+    gt_array_add(fi->entries, e);
+  }
+  gt_fa_xmunmap((void*) buf);
+  if (had_err) {
+    gt_error_set(err, "FASTA index file \"%s\" is corrupt or does not match "
+                 "file \"%s\", remove it to rebuild the index", path,
+                 gt_str_get(fi->sequence_file));
+  }
+  else if (!gt_array_size(fi->entries)) {
+    gt_error_set(err, "FASTA index file \"%s\" is empty", path);
+    had_err = -1;
+  }
+  return had_err;
+}
+
+/* Returns true if the file <index> exists and is not older than the sequence
+   file of <fi>. */
+static bool index_is_current(const GtFastaIndex *fi, const char *index)
+{
+  return gt_file_exists(index)
+           && !gt_file_is_newer(gt_str_get(fi->sequence_file), index);
+}
+
+GtFastaIndex* gt_fasta_index_new(const char *sequence_file, GtError *err)
+{
+  GtFastaIndex *fi;
+  GtStr *index_file;
+  bool write_blocks = false, write_index = false;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(sequence_file);
+  fi = gt_calloc(1, sizeof *fi);
+  fi->sequence_file = gt_str_new_cstr(sequence_file);
+  fi->entries = gt_array_new(sizeof (GtFastaIndexEntry));
+  fi->blocks = gt_array_new(sizeof (GtFastaIndexBlock));
+  fi->cached_block = GT_UNDEF_UWORD;
+  index_file = gt_str_new();
+  if (!strcmp(sequence_file, "-")) {
+    gt_error_set(err, "cannot index sequences read from stdin");
+    had_err = -1;
+  }
+  if (!had_err && !gt_file_exists(sequence_file)) {
+    gt_error_set(err, "sequence file \"%s\" does not exist", sequence_file);
+    had_err = -1;
+  }
+  if (!had_err && gt_file_size(sequence_file) == 0) {
+    gt_error_set(err, "sequence file \"%s\" is empty", sequence_file);
+    had_err = -1;
+  }
+  if (!had_err) {
+    fi->data = gt_fa_mmap_read(sequence_file, &fi->datalen, err);
+    if (!fi->data)
+      had_err = -1;
+  }
+  if (!had_err) {
+    if (fi->datalen >= 3 && !strncmp((const char*) fi->data, "BZh", 3)) {
+      gt_error_set(err, "bzip2 compressed file \"%s\" cannot be indexed, "
+                   "compress it with 'bgzip' instead", sequence_file);
+      had_err = -1;
+    }
+    else if (fi->datalen >= 2 && fi->data[0] == 31 && fi->data[1] == 139)
+      fi->bgzf = true;
+    else
+      fi->ulen = fi->datalen;
+  }
+  if (!had_err && fi->bgzf) {
+    if (inflateInit2(&fi->zs, -MAX_WBITS) != Z_OK) {
+      gt_error_set(err, "cannot initialize zlib: %s",
+                   fi->zs.msg ? fi->zs.msg : "unknown error");
+      had_err = -1;
+    }
+    else
+      fi->zs_initialized = true;
+    fi->blockbuf = gt_malloc(BGZF_MAX_BLOCK_SIZE);
+    if (!had_err) {
+      gt_str_append_cstr(index_file, sequence_file);
+      gt_str_append_cstr(index_file, GT_FASTA_INDEX_BGZF_SUFFIX);
+      if (index_is_current(fi, gt_str_get(index_file)))
+        had_err = bgzf_load_blocks(fi, gt_str_get(index_file), err);
+      else {
+        had_err = bgzf_scan_blocks(fi, err);
+        write_blocks = true;
+      }
+    }
+    if (!had_err && write_blocks)
+      bgzf_write_blocks(fi, gt_str_get(index_file));
+  }
+  if (!had_err) {
+    gt_str_reset(index_file);
+    gt_str_append_cstr(index_file, sequence_file);
+    gt_str_append_cstr(index_file, GT_FASTA_INDEX_SUFFIX);
+    if (index_is_current(fi, gt_str_get(index_file)))
+      had_err = fasta_index_load(fi, gt_str_get(index_file), err);
+    else {
+      had_err = fasta_index_build(fi, err);
+      write_index = true;
+    }
+  }
+  if (!had_err && write_index)
+    fasta_index_write(fi, gt_str_get(index_file));
+  gt_str_delete(index_file);
+  if (had_err) {
+    gt_fasta_index_delete(fi);
+    return NULL;
+  }
+  return fi;
+}
+
+GtUword gt_fasta_index_number_of_sequences(const GtFastaIndex *fi)
+{
+  gt_assert(fi);
+  return gt_array_size(fi->entries);
+}
+
+const char* gt_fasta_index_get_name(const GtFastaIndex *fi, GtUword idx)
+{
+  const GtFastaIndexEntry *e;
+  gt_assert(fi && idx < gt_array_size(fi->entries));
+  e = gt_array_get(fi->entries, idx);
+  return e->name;
+}
+
+const char* gt_fasta_index_get_description(GtFastaIndex *fi, GtUword idx)
+{
+  const GtFastaIndexEntry *e;
+  gt_assert(fi && idx < gt_array_size(fi->entries));
+  if (!fi->descriptions)
+    fi->descriptions = gt_calloc(gt_array_size(fi->entries), sizeof (char*));
+  if (!fi->descriptions[idx]) {
+    GtUword start, end;
+    char c;
+    e = gt_array_get(fi->entries, idx);
+    /* the header line ends right before the first sequence character */
+    end = e->offset;
+    if (end > 0) {
+      fasta_index_read(fi, &c, end - 1, 1);
+      if (c == '\n')
+        end--;
+    }
+    if (end > 0) {
+      fasta_index_read(fi, &c, end - 1, 1);
+      if (c == '\r')
+        end--;
+    }
+    for (start = end; start > 0; start--) {
+      fasta_index_read(fi, &c, start - 1, 1);
+      if (c == '\n')
+        break;
+    }
+    if (start < end) {
+      fasta_index_read(fi, &c, start, 1);
+      if (c == '>')
+        start++;
+    }
+    fi->descriptions[idx] = gt_malloc(end - start + 1);
+    fasta_index_read(fi, fi->descriptions[idx], start, end - start);
+    fi->descriptions[idx][end - start] = '\0';
+  }
+  return fi->descriptions[idx];
+}
+
+GtUword gt_fasta_index_get_sequence_length(const GtFastaIndex *fi, GtUword idx)
+{
+  const GtFastaIndexEntry *e;
+  gt_assert(fi && idx < gt_array_size(fi->entries));
+  e = gt_array_get(fi->entries, idx);
+  return e->length;
+}
+
+void gt_fasta_index_extract_sequence_range(GtFastaIndex *fi, char *out,
+                                           GtUword idx, GtUword start,
+                                           GtUword end)
+{
+  const GtFastaIndexEntry *e;
+  GtUword line, column, n;
+  gt_assert(fi && out && idx < gt_array_size(fi->entries) && start <= end);
+  e = gt_array_get(fi->entries, idx);
+  gt_assert(end < e->length);
+  line = start / e->linebases;
+  column = start % e->linebases;
+  while (start <= end) {
+    n = MIN(e->linebases - column, end - start + 1);
+    fasta_index_read(fi, out, e->offset + line * e->linewidth + column, n);
+    out += n;
+    start += n;
+    line++;
+    column = 0;
+  }
+}
+
+char* gt_fasta_index_get_sequence_range(GtFastaIndex *fi, GtUword idx,
+                                        GtUword start, GtUword end)
+{
+  char *seq;
+  gt_assert(fi && start <= end);
+  seq = gt_malloc(end - start + 2);
+  gt_fasta_index_extract_sequence_range(fi, seq, idx, start, end);
+  seq[end - start + 1] = '\0';
+  return seq;
+}
+
+/* Computes the same fingerprint as <gt_md5_fingerprint()> without extracting
+   the whole sequence at once. */
+static char* fasta_index_md5_fingerprint(GtFastaIndex *fi, GtUword idx)
+{
+  unsigned char output[16];
+  char buf[64], *chunk, *fingerprint;
+  GtMD5Encoder *enc;
+  GtUword length, start, i, n, pos = 0;
+  length = gt_fasta_index_get_sequence_length(fi, idx);
+  chunk = gt_malloc(MD5_CHUNK_SIZE);
+  enc = gt_md5_encoder_new();
+  for (start = 0; start < length; start += n) {
+    n = MIN(MD5_CHUNK_SIZE, length - start);
+    gt_fasta_index_extract_sequence_range(fi, chunk, idx, start, start + n - 1);
+    for (i = 0; i < n; i++) {
+      if (pos == 64) {
+        gt_md5_encoder_add_block(enc, buf, 64);
+        pos = 0;
+      }
+      buf[pos++] = toupper((unsigned char) chunk[i]);
+    }
+  }
+  gt_md5_encoder_add_block(enc, buf, pos);
+  fingerprint = gt_calloc(33, sizeof (char));
+  gt_md5_encoder_finish(enc, output, fingerprint);
+  gt_md5_encoder_delete(enc);
+  gt_free(chunk);
+  return fingerprint;
+}
+
+const char* gt_fasta_index_get_md5_fingerprint(GtFastaIndex *fi, GtUword idx)
+{
+  gt_assert(fi && idx < gt_array_size(fi->entries));
+  if (!fi->md5_fingerprints) {
+    fi->md5_fingerprints = gt_calloc(gt_array_size(fi->entries),
+                                     sizeof (char*));
+  }
+  if (!fi->md5_fingerprints[idx])
+    fi->md5_fingerprints[idx] = fasta_index_md5_fingerprint(fi, idx);
+  return fi->md5_fingerprints[idx];
+}
+
+GtUword gt_fasta_index_md5_to_index(GtFastaIndex *fi, const char *md5)
+{
+  GtUword i;
+  void *value;
+  gt_assert(fi && md5);
+  if (!fi->md5_map) {
+    fi->md5_map = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
+    for (i = 0; i < gt_array_size(fi->entries); i++) {
+      const char *fingerprint = gt_fasta_index_get_md5_fingerprint(fi, i);
+      /* map to the first sequence with a given fingerprint */
+      if (!gt_hashmap_get(fi->md5_map, fingerprint))
+        gt_hashmap_add(fi->md5_map, (void*) fingerprint, (void*) (i + 1));
+    }
+  }
+  if ((value = gt_hashmap_get(fi->md5_map, md5)))
+    return (GtUword) value - 1;
+  return GT_UNDEF_UWORD;
+}
+
+void gt_fasta_index_delete(GtFastaIndex *fi)
+{
+  GtUword i;
+  if (!fi) return;
+  gt_hashmap_delete(fi->md5_map);
+  for (i = 0; i < gt_array_size(fi->entries); i++) {
+    GtFastaIndexEntry *e = gt_array_get(fi->entries, i);
+    gt_free(e->name);
+    if (fi->descriptions)
+      gt_free(fi->descriptions[i]);
+    if (fi->md5_fingerprints)
+      gt_free(fi->md5_fingerprints[i]);
+  }
+  gt_free(fi->descriptions);
+  gt_free(fi->md5_fingerprints);
+  gt_array_delete(fi->entries);
+  gt_array_delete(fi->blocks);
+  if (fi->zs_initialized)
+    (void) inflateEnd(&fi->zs);
+  gt_free(fi->blockbuf);
+  if (fi->data)
+    gt_fa_xmunmap((void*) fi->data);
+  gt_str_delete(fi->sequence_file);
+  gt_free(fi);
+}
+
+static int fasta_index_test_file(GtStr *filename, const char *content,
+                                 GtError *err)
+{
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_str_reset(filename);
+  fp = gt_xtmpfp(filename);
+  gt_xfputs(content, fp);
+  gt_fa_xfclose(fp);
+  gt_ensure(gt_file_exists(gt_str_get(filename)));
+  return had_err;
+}
+
+static void fasta_index_test_remove(GtStr *filename)
+{
+  GtStr *index_file = gt_str_clone(filename);
+  gt_str_append_cstr(index_file, GT_FASTA_INDEX_SUFFIX);
+  if (gt_file_exists(gt_str_get(index_file)))
+    gt_xremove(gt_str_get(index_file));
+  gt_xremove(gt_str_get(filename));
+  gt_str_delete(index_file);
+}
+
+int gt_fasta_index_unit_test(GtError *err)
+{
+  static const char *fasta = ">seq1 first sequence\n"
+                             "ACGTA\n"
+                             "CgtAC\n"
+                             "GT\n"
+                             ">seq2\r\n"
+                             "TTTT\r\n"
+                             "GG\r\n"
+                             ">empty\n"
+                             ">seq3\n"
+                             "acg",
+                    *ragged = ">seq1\n"
+                              "ACG\n"
+                              "A\n"
+                              "CGT\n";
+  GtFastaIndex *fi;
+  GtStr *filename;
+  GtUword pass;
+  char buf[16], *seq;
+  int had_err = 0;
+  gt_error_check(err);
+  filename = gt_str_new();
+  had_err = fasta_index_test_file(filename, fasta, err);
+  /* the first pass builds the index, the second one loads it */
+  for (pass = 0; !had_err && pass < 2; pass++) {
+    fi = gt_fasta_index_new(gt_str_get(filename), err);
+    gt_ensure(fi != NULL);
+    if (!had_err) {
+      gt_ensure(gt_fasta_index_number_of_sequences(fi) == 4);
+      gt_ensure(!strcmp(gt_fasta_index_get_name(fi, 0), "seq1"));
+      gt_ensure(!strcmp(gt_fasta_index_get_description(fi, 0),
+                        "seq1 first sequence"));
+      gt_ensure(!strcmp(gt_fasta_index_get_description(fi, 1), "seq2"));
+      gt_ensure(!strcmp(gt_fasta_index_get_description(fi, 2), "empty"));
+      gt_ensure(!strcmp(gt_fasta_index_get_name(fi, 3), "seq3"));
+      gt_ensure(gt_fasta_index_get_sequence_length(fi, 0) == 12);
+      gt_ensure(gt_fasta_index_get_sequence_length(fi, 1) == 6);
+      gt_ensure(gt_fasta_index_get_sequence_length(fi, 2) == 0);
+      gt_ensure(gt_fasta_index_get_sequence_length(fi, 3) == 3);
+      seq = gt_fasta_index_get_sequence_range(fi, 0, 0, 11);
+      gt_ensure(!strcmp(seq, "ACGTACgtACGT"));
+      gt_free(seq);
+      gt_fasta_index_extract_sequence_range(fi, buf, 0, 3, 10);
+      gt_ensure(!strncmp(buf, "TACgtACG", 8));
+      gt_fasta_index_extract_sequence_range(fi, buf, 1, 2, 5);
+      gt_ensure(!strncmp(buf, "TTGG", 4));
+      gt_fasta_index_extract_sequence_range(fi, buf, 3, 0, 2);
+      gt_ensure(!strncmp(buf, "acg", 3));
+      seq = gt_md5_fingerprint("ACGTACgtACGT", 12);
+      gt_ensure(!strcmp(gt_fasta_index_get_md5_fingerprint(fi, 0), seq));
+      gt_ensure(gt_fasta_index_md5_to_index(fi, seq) == 0);
+      gt_free(seq);
+      seq = gt_md5_fingerprint("", 0);
+      gt_ensure(gt_fasta_index_md5_to_index(fi, seq) == 2);
+      gt_free(seq);
+      gt_ensure(gt_fasta_index_md5_to_index(fi, "foo") == GT_UNDEF_UWORD);
+    }
+    gt_fasta_index_delete(fi);
+  }
+  fasta_index_test_remove(filename);
+  /* sequences with lines of different length cannot be indexed */
+  if (!had_err)
+    had_err = fasta_index_test_file(filename, ragged, err);
+  if (!had_err) {
+    fi = gt_fasta_index_new(gt_str_get(filename), err);
+    gt_ensure(fi == NULL && gt_error_is_set(err));
+    gt_fasta_index_delete(fi);
+    gt_error_unset(err);
+    fasta_index_test_remove(filename);
+  }
+  gt_str_delete(filename);
+  return had_err;
+}
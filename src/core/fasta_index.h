@@ -0,0 +1,81 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef FASTA_INDEX_H
+#define FASTA_INDEX_H
+
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* The suffix of the FASTA index file, which is compatible with the index
+   written by 'samtools faidx'. */
+#define GT_FASTA_INDEX_SUFFIX       ".fai"
+/* The suffix of the BGZF block index file, as written by 'bgzip -i'. */
+#define GT_FASTA_INDEX_BGZF_SUFFIX  ".gzi"
+
+/* A <GtFastaIndex> gives random access to the sequences of a FASTA file
+   without reading (or encoding) the whole file. It is based on a '.fai' index
+   which stores, for each sequence, its name, length, file offset and line
+   layout. The FASTA file can either be uncompressed, in which case it is
+   memory mapped, or BGZF compressed (as produced by 'bgzip'), in which case
+   only the blocks covering a requested range are inflated. Plain gzip or bzip2
+   compressed files are not supported, since they cannot be accessed at random
+   positions. */
+typedef struct GtFastaIndex GtFastaIndex;
+
+/* Return a new <GtFastaIndex> for <sequence_file>. If the index file
+   <sequence_file>'.fai' (and, for BGZF compressed files, <sequence_file>'.gzi')
+   exists and is not older than <sequence_file> it is loaded, otherwise the
+   index is built by scanning <sequence_file> once and written if possible.
+   Sequences whose lines (except for the last one) differ in length cannot be
+   indexed. Returns NULL and sets <err> on error. */
+GtFastaIndex* gt_fasta_index_new(const char *sequence_file, GtError *err);
+/* Return the number of sequences in <fi>. */
+GtUword       gt_fasta_index_number_of_sequences(const GtFastaIndex *fi);
+/* Return the name of sequence <idx>, that is, its description up to the first
+   whitespace. */
+const char*   gt_fasta_index_get_name(const GtFastaIndex *fi, GtUword idx);
+/* Return the complete description of sequence <idx>. It is read from the
+   sequence file upon first access. */
+const char*   gt_fasta_index_get_description(GtFastaIndex *fi, GtUword idx);
+/* Return the length of sequence <idx>. */
+GtUword       gt_fasta_index_get_sequence_length(const GtFastaIndex *fi,
+                                                 GtUword idx);
+/* Write the characters from <start> to <end> (inclusive, 0-based) of sequence
+   <idx> to <out>, which must have space for <end> - <start> + 1 characters.
+   Uses a block cache kept in <fi>, hence <fi> must not be shared between
+   threads using this function. */
+void          gt_fasta_index_extract_sequence_range(GtFastaIndex *fi, char *out,
+                                                    GtUword idx, GtUword start,
+                                                    GtUword end);
+/* Return the characters from <start> to <end> of sequence <idx> as a newly
+   allocated string. */
+char*         gt_fasta_index_get_sequence_range(GtFastaIndex *fi, GtUword idx,
+                                                GtUword start, GtUword end);
+/* Return the MD5 fingerprint of sequence <idx>, which is computed upon first
+   access. */
+const char*   gt_fasta_index_get_md5_fingerprint(GtFastaIndex *fi,
+                                                 GtUword idx);
+/* Return the index of the sequence with MD5 fingerprint <md5>, or
+   <GT_UNDEF_UWORD> if there is none. The first call computes the fingerprints
+   of all sequences. */
+GtUword       gt_fasta_index_md5_to_index(GtFastaIndex *fi, const char *md5);
+void          gt_fasta_index_delete(GtFastaIndex *fi);
+
+int           gt_fasta_index_unit_test(GtError *err);
+
+#endif
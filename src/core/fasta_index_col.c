@@ -0,0 +1,483 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/fasta_index.h"
+#include "core/fasta_index_col.h"
+#include "core/grep.h"
+#include "core/hashmap_api.h"
+#include "core/ma.h"
+#include "core/md5_seqid.h"
+#include "core/seq_col_rep.h"
+#include "core/seq_info_cache.h"
+#include "core/undef_api.h"
+
+struct GtFastaIndexCol {
+  GtSeqCol parent_instance;
+  GtFastaIndex **indices;
+  GtUword num_of_seqfiles;
+  GtSeqInfoCache *grep_cache;
+  GtHashmap *duplicates;
+  bool matchdescstart;
+};
+
+const GtSeqColClass* gt_fasta_index_col_class(void);
+#define gt_fasta_index_col_cast(SC)\
+        gt_seq_col_cast(gt_fasta_index_col_class(), SC)
+
+static void gt_fasta_index_col_delete(GtSeqCol *sc)
+{
+  GtUword i;
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  if (!fic) return;
+  gt_seq_info_cache_delete(fic->grep_cache);
+  gt_hashmap_delete(fic->duplicates);
+  for (i = 0; i < fic->num_of_seqfiles; i++)
+    gt_fasta_index_delete(fic->indices[i]);
+  gt_free(fic->indices);
+}
+
+static int grep_desc(GtFastaIndexCol *fic, GtUword *filenum,
+                     GtUword *seqnum, GtStr *seqid, GtError *err)
+{
+  GtUword i, j, num_matches = 0;
+  const GtSeqInfo *seq_info_ptr;
+  GtSeqInfo seq_info;
+  GtStr *pattern, *escaped;
+  bool match = false;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(fic && filenum && seqnum && seqid);
+  /* create cache */
+  if (!fic->grep_cache)
+    fic->grep_cache = gt_seq_info_cache_new();
+  /* try to read from cache */
+  seq_info_ptr = gt_seq_info_cache_get(fic->grep_cache, gt_str_get(seqid));
+  if (seq_info_ptr) {
+    if (fic->duplicates && gt_hashmap_get(fic->duplicates, gt_str_get(seqid))) {
+      gt_error_set(err, "query seqid '%s' could match more than one "
+                        "sequence description", gt_str_get(seqid));
+      return -1;
+    }
+    *filenum = seq_info_ptr->filenum;
+    *seqnum = seq_info_ptr->seqnum;
+    return 0;
+  }
+  pattern = gt_str_new();
+  escaped = gt_str_new();
+  gt_grep_escape_extended(escaped, gt_str_get(seqid), gt_str_length(seqid));
+  if (fic->matchdescstart)
+    gt_str_append_cstr(pattern, "^");
+  gt_str_append_str(pattern, escaped);
+  if (fic->matchdescstart)
+    gt_str_append_cstr(pattern, "([[:space:]]|$)");
+  for (i = 0; !had_err && i < fic->num_of_seqfiles; i++) {
+    GtFastaIndex *fi = fic->indices[i];
+    for (j = 0; !had_err && j < gt_fasta_index_number_of_sequences(fi); j++) {
+      const char *desc = gt_fasta_index_get_description(fi, j);
+      had_err = gt_grep(&match, gt_str_get(pattern), desc, err);
+      if (!had_err && match) {
+        num_matches++;
+        if (num_matches > 1) {
+          gt_error_set(err, "query seqid '%s' could match more than one "
+                            "sequence description", gt_str_get(seqid));
+          had_err = -1;
+          break;
+        }
+        *filenum = i;
+        *seqnum = j;
+        /* cache results */
+        seq_info.filenum = i;
+        seq_info.seqnum = j;
+        gt_seq_info_cache_add(fic->grep_cache, gt_str_get(seqid), &seq_info);
+      }
+    }
+    if (match)
+      break;
+  }
+  gt_str_delete(pattern);
+  gt_str_delete(escaped);
+  if (!had_err && num_matches == 0) {
+    gt_error_set(err, "no description matched sequence ID '%s'",
+                 gt_str_get(seqid));
+    had_err = -1;
+  }
+  return had_err;
+}
+
+static void gt_fasta_index_col_enable_match_desc_start(GtSeqCol *sc)
+{
+  GtFastaIndexCol *fic;
+  GtSeqInfo seq_info;
+  GtUword i,j;
+  gt_assert(sc);
+  fic = gt_fasta_index_col_cast(sc);
+  fic->matchdescstart = true;
+  /* pre-cache seqids for faster search, the index already contains the
+     descriptions up to the first whitespace */
+  if (!fic->grep_cache)
+    fic->grep_cache = gt_seq_info_cache_new();
+  for (i = 0; i < fic->num_of_seqfiles; i++) {
+    GtFastaIndex *fi = fic->indices[i];
+    for (j = 0; j < gt_fasta_index_number_of_sequences(fi); j++) {
+      const char *name = gt_fasta_index_get_name(fi, j);
+      seq_info.filenum = i;
+      seq_info.seqnum = j;
+      if (!gt_seq_info_cache_get(fic->grep_cache, name))
+        gt_seq_info_cache_add(fic->grep_cache, name, &seq_info);
+      else {
+        if (!fic->duplicates)
+          fic->duplicates = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
+        gt_hashmap_add(fic->duplicates, (void*) name, (void*) 1);
+      }
+    }
+  }
+}
+
+static int gt_fasta_index_col_grep_desc(GtSeqCol *sc, char **seq,
+                                        GtUword start, GtUword end,
+                                        GtStr *seqid, GtError *err)
+{
+  GtUword filenum = 0, seqnum = 0, seqlength;
+  int had_err;
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(fic && seq && seqid);
+  had_err = grep_desc(fic, &filenum, &seqnum, seqid, err);
+  if (!had_err) {
+    seqlength = gt_fasta_index_get_sequence_length(fic->indices[filenum],
+                                                   seqnum);
+    if (start > seqlength - 1 || end > seqlength - 1) {
+      had_err = -1;
+      gt_error_set(err, "trying to extract range "GT_WU"-"GT_WU" on sequence "
+                         "``%s'' which is not covered by that sequence (only "
+                         ""GT_WU" characters in size). Has the sequence-region "
+                         "to sequence mapping been defined correctly?",
+                   start, end, gt_str_get(seqid), seqlength);
+    }
+  }
+  if (!had_err) {
+    *seq = gt_fasta_index_get_sequence_range(fic->indices[filenum], seqnum,
+                                             start, end);
+  }
+  return had_err;
+}
+
+static int gt_fasta_index_col_grep_desc_md5(GtSeqCol *sc, const char **md5,
+                                            GtStr *seqid, GtError *err)
+{
+  GtUword filenum = 0, seqnum = 0;
+  int had_err;
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(fic && md5 && seqid);
+  had_err = grep_desc(fic, &filenum, &seqnum, seqid, err);
+  if (!had_err)
+    *md5 = gt_fasta_index_get_md5_fingerprint(fic->indices[filenum], seqnum);
+  return had_err;
+}
+
+static int gt_fasta_index_col_grep_desc_desc(GtSeqCol *sc, GtStr *desc,
+                                             GtStr *seqid, GtError *err)
+{
+  GtUword filenum = 0, seqnum = 0;
+  int had_err;
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(fic && desc && seqid);
+  had_err = grep_desc(fic, &filenum, &seqnum, seqid, err);
+  if (!had_err) {
+    const char *mydesc = gt_fasta_index_get_description(fic->indices[filenum],
+                                                        seqnum);
+    if (mydesc)
+      gt_str_append_cstr(desc, mydesc);
+  }
+  return had_err;
+}
+
+static int gt_fasta_index_col_grep_desc_sequence_length(GtSeqCol *sc,
+                                                        GtUword *length,
+                                                        GtStr *seqid,
+                                                        GtError *err)
+{
+  GtUword filenum = 0, seqnum = 0;
+  int had_err;
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(fic && length && seqid);
+  had_err = grep_desc(fic, &filenum, &seqnum, seqid, err);
+  if (!had_err)
+    *length = gt_fasta_index_get_sequence_length(fic->indices[filenum], seqnum);
+  return had_err;
+}
+
+static int md5_to_index(GtFastaIndex **fi, GtUword *filenum, GtUword *seqnum,
+                        GtFastaIndexCol *fic, GtStr *md5_seqid, GtError *err)
+{
+  bool seqid_changed = false;
+  char *seqid = NULL;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(seqnum && fic && md5_seqid);
+  /* performance hack to avoid string duplication */
+  if (gt_str_length(md5_seqid) >= GT_MD5_SEQID_TOTAL_LEN) {
+    seqid = gt_str_get(md5_seqid);
+    if (seqid[GT_MD5_SEQID_TOTAL_LEN-1] != GT_MD5_SEQID_SEPARATOR) {
+      gt_error_set(err, "MD5 sequence id %s not terminated with '%c'",
+                   gt_str_get(md5_seqid), GT_MD5_SEQID_SEPARATOR);
+      had_err = -1;
+    }
+    if (!had_err) {
+      seqid[GT_MD5_SEQID_TOTAL_LEN-1] = '\0';
+      seqid_changed = true;
+    }
+  }
+  for (i = 0; !had_err && i < fic->num_of_seqfiles; i++) {
+    *fi = fic->indices[i];
+    *seqnum = gt_fasta_index_md5_to_index(*fi, gt_str_get(md5_seqid) +
+                                          GT_MD5_SEQID_PREFIX_LEN);
+    if (*seqnum != GT_UNDEF_UWORD) {
+      if (filenum)
+        *filenum = i;
+      break;
+    }
+  }
+  if (seqid_changed) /* reset seqid no matter what */
+    seqid[GT_MD5_SEQID_TOTAL_LEN-1] = GT_MD5_SEQID_SEPARATOR;
+  if (!had_err && *seqnum == GT_UNDEF_UWORD) {
+    gt_error_set(err, "sequence %s not found", gt_str_get(md5_seqid));
+    had_err = -1;
+  }
+  return had_err;
+}
+
+static int gt_fasta_index_col_md5_to_seq(GtSeqCol *sc, char **seq,
+                                         GtUword start, GtUword end,
+                                         GtStr *md5_seqid, GtError *err)
+{
+  GtUword seqnum = GT_UNDEF_UWORD;
+  GtFastaIndex *fi = NULL;
+  GtFastaIndexCol *fic;
+  int had_err = 0;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(fic && seq && md5_seqid && err);
+  gt_assert(gt_md5_seqid_has_prefix(gt_str_get(md5_seqid)));
+  if (!(had_err = md5_to_index(&fi, NULL, &seqnum, fic, md5_seqid, err))) {
+    gt_assert(seqnum != GT_UNDEF_UWORD);
+    *seq = gt_fasta_index_get_sequence_range(fi, seqnum, start, end);
+  }
+  return had_err;
+}
+
+static int gt_fasta_index_col_md5_to_description(GtSeqCol *sc, GtStr *desc,
+                                                 GtStr *md5_seqid, GtError *err)
+{
+  GtUword seqnum = GT_UNDEF_UWORD;
+  GtFastaIndex *fi = NULL;
+  GtFastaIndexCol *fic;
+  int had_err = 0;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(fic && desc && md5_seqid && err);
+  gt_assert(gt_md5_seqid_has_prefix(gt_str_get(md5_seqid)));
+  if (!(had_err = md5_to_index(&fi, NULL, &seqnum, fic, md5_seqid, err))) {
+    gt_assert(seqnum != GT_UNDEF_UWORD);
+    gt_str_append_cstr(desc, gt_fasta_index_get_description(fi, seqnum));
+  }
+  return had_err;
+}
+
+static int gt_fasta_index_col_md5_to_sequence_length(GtSeqCol *sc,
+                                                     GtUword *len,
+                                                     GtStr *md5_seqid,
+                                                     GtError *err)
+{
+  GtUword seqnum = GT_UNDEF_UWORD;
+  GtFastaIndex *fi = NULL;
+  GtFastaIndexCol *fic;
+  int had_err = 0;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(fic && len && md5_seqid && err);
+  gt_assert(gt_md5_seqid_has_prefix(gt_str_get(md5_seqid)));
+  if (!(had_err = md5_to_index(&fi, NULL, &seqnum, fic, md5_seqid, err))) {
+    gt_assert(seqnum != GT_UNDEF_UWORD);
+    *len = gt_fasta_index_get_sequence_length(fi, seqnum);
+  }
+  return had_err;
+}
+
+static GtUword gt_fasta_index_col_num_of_files(const GtSeqCol *sc)
+{
+  const GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_assert(fic);
+  return fic->num_of_seqfiles;
+}
+
+static GtUword gt_fasta_index_col_num_of_seqs(const GtSeqCol *sc,
+                                              GtUword filenum)
+{
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_assert(fic && filenum < fic->num_of_seqfiles);
+  return gt_fasta_index_number_of_sequences(fic->indices[filenum]);
+}
+
+static const char* gt_fasta_index_col_get_md5_fingerprint(const GtSeqCol *sc,
+                                                          GtUword filenum,
+                                                          GtUword seqnum)
+{
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_assert(fic && filenum < fic->num_of_seqfiles);
+  return gt_fasta_index_get_md5_fingerprint(fic->indices[filenum], seqnum);
+}
+
+static char* gt_fasta_index_col_get_sequence(const GtSeqCol *sc,
+                                             GtUword filenum,
+                                             GtUword seqnum,
+                                             GtUword start,
+                                             GtUword end)
+{
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_assert(fic && filenum < fic->num_of_seqfiles);
+  return gt_fasta_index_get_sequence_range(fic->indices[filenum], seqnum, start,
+                                           end);
+}
+
+static char* gt_fasta_index_col_get_description(const GtSeqCol *sc,
+                                                GtUword filenum,
+                                                GtUword seqnum)
+{
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_assert(fic && filenum < fic->num_of_seqfiles);
+  return gt_cstr_dup(gt_fasta_index_get_description(fic->indices[filenum],
+                                                    seqnum));
+}
+
+static GtUword gt_fasta_index_col_get_sequence_length(const GtSeqCol *sc,
+                                                      GtUword filenum,
+                                                      GtUword seqnum)
+{
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_assert(fic && filenum < fic->num_of_seqfiles);
+  return gt_fasta_index_get_sequence_length(fic->indices[filenum], seqnum);
+}
+
+static int gt_fasta_index_col_grep_desc_index(GtSeqCol *sc, GtUword *filenum,
+                                              GtUword *seqnum, GtStr *seqid,
+                                              GtError *err)
+{
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(fic && filenum && seqnum && seqid);
+  return grep_desc(fic, filenum, seqnum, seqid, err);
+}
+
+static int gt_fasta_index_col_md5_to_index(GtSeqCol *sc, GtUword *filenum,
+                                           GtUword *seqnum, GtStr *md5_seqid,
+                                           GtError *err)
+{
+  GtFastaIndex *fi = NULL;
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_error_check(err);
+  gt_assert(fic && filenum && seqnum && md5_seqid);
+  gt_assert(gt_md5_seqid_has_prefix(gt_str_get(md5_seqid)));
+  return md5_to_index(&fi, filenum, seqnum, fic, md5_seqid, err);
+}
+
+static void gt_fasta_index_col_extract_sequence(GtSeqCol *sc, char *buffer,
+                                                GtUword filenum, GtUword seqnum,
+                                                GtUword start, GtUword end)
+{
+  GtFastaIndexCol *fic;
+  fic = gt_fasta_index_col_cast(sc);
+  gt_assert(fic && filenum < fic->num_of_seqfiles);
+  gt_fasta_index_extract_sequence_range(fic->indices[filenum], buffer, seqnum,
+                                        start, end);
+}
+
+const GtSeqColClass* gt_fasta_index_col_class(void)
+{
+  static const GtSeqColClass *fic_class = NULL;
+  gt_class_alloc_lock_enter();
+  if (!fic_class) {
+    fic_class = gt_seq_col_class_new(sizeof (GtFastaIndexCol),
+                gt_fasta_index_col_delete,
+                gt_fasta_index_col_enable_match_desc_start,
+                gt_fasta_index_col_grep_desc,
+                gt_fasta_index_col_grep_desc_desc,
+                gt_fasta_index_col_grep_desc_md5,
+                gt_fasta_index_col_grep_desc_sequence_length,
+                gt_fasta_index_col_md5_to_seq,
+                gt_fasta_index_col_md5_to_description,
+                gt_fasta_index_col_md5_to_sequence_length,
+                gt_fasta_index_col_num_of_files,
+                gt_fasta_index_col_num_of_seqs,
+                gt_fasta_index_col_get_md5_fingerprint,
+                gt_fasta_index_col_get_sequence,
+                gt_fasta_index_col_get_description,
+                gt_fasta_index_col_get_sequence_length,
+                gt_fasta_index_col_grep_desc_index,
+                gt_fasta_index_col_md5_to_index,
+                gt_fasta_index_col_extract_sequence);
+  }
+  gt_class_alloc_lock_leave();
+  return fic_class;
+}
+
+GtSeqCol* gt_fasta_index_col_new(GtStrArray *sequence_files, GtError *err)
+{
+  GtSeqCol *sc;
+  GtFastaIndexCol *fic;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(sequence_files);
+  gt_assert(gt_str_array_size(sequence_files));
+  sc = gt_seq_col_create(gt_fasta_index_col_class());
+  fic = gt_fasta_index_col_cast(sc);
+  fic->duplicates = NULL;
+  fic->num_of_seqfiles = gt_str_array_size(sequence_files);
+  fic->indices = gt_calloc(fic->num_of_seqfiles, sizeof (GtFastaIndex*));
+  for (i = 0; !had_err && i < fic->num_of_seqfiles; i++) {
+    fic->indices[i] = gt_fasta_index_new(gt_str_array_get(sequence_files, i),
+                                         err);
+    if (!fic->indices[i])
+      had_err = -1;
+  }
+  if (had_err) {
+    gt_seq_col_delete(sc);
+    return NULL;
+  }
+  fic->matchdescstart = false;
+  return sc;
+}
@@ -0,0 +1,33 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef FASTA_INDEX_COL_H
+#define FASTA_INDEX_COL_H
+
+#include "core/error_api.h"
+#include "core/seq_col.h"
+#include "core/str_array_api.h"
+
+typedef struct GtFastaIndexCol GtFastaIndexCol;
+
+/* Returns a <GtSeqCol> which accesses the FASTA files <sequence_files> through
+   a <GtFastaIndex> each, instead of encoding them like <gt_bioseq_col_new()>.
+   Hence its creation time does not depend on the sequence size once the
+   index files exist. */
+GtSeqCol*  gt_fasta_index_col_new(GtStrArray *sequence_files, GtError *err);
+
+#endif
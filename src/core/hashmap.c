@@ -20,6 +20,7 @@
 #include "core/ma.h"
 #include "core/hashmap.h"
 #include "core/hashmap-generic.h"
+#include "core/inthashmap-generic.h"
 #include "core/types_api.h"
 
 /* Hashmaps are implemented as Hashtables */
@@ -104,23 +105,48 @@ GtHashmap* gt_hashmap_ref(GtHashmap *hm)
 
 void* gt_hashmap_get(GtHashmap *hm, const void *key)
 {
-  struct map_entry *elem = gt_hashtable_get((GtHashtable*) hm, &key);
-  return (elem != NULL) ? elem->value : NULL;
+  struct map_entry elem;
+  return gt_hashtable_get_copy((GtHashtable*) hm, &key, &elem)
+         ? elem.value : NULL;
 }
 
 void* gt_hashmap_get_key(GtHashmap *hm, const void *key)
 {
-  struct map_entry *elem = gt_hashtable_get((GtHashtable*) hm, &key);
-  return (elem != NULL) ? elem->key : NULL;
+  struct map_entry elem;
+  return gt_hashtable_get_copy((GtHashtable*) hm, &key, &elem)
+         ? elem.key : NULL;
+}
+
+static void hm_update_value(void *stored, const void *elem,
+                            GT_UNUSED void *data)
+{
+  ((struct map_entry*) stored)->value = ((const struct map_entry*) elem)->value;
 }
 
 void gt_hashmap_add(GtHashmap *hm, void *key, void *value)
 {
   struct map_entry keyvalpair = { key, value };
-  if (!gt_hashtable_add((GtHashtable*) hm, &keyvalpair)) {
-    ((struct map_entry *)gt_hashtable_get((GtHashtable*) hm, &keyvalpair))
-      ->value = value;
-  }
+  (void) gt_hashtable_add_or_update((GtHashtable*) hm, &keyvalpair,
+                                    hm_update_value, NULL);
+}
+
+static void hm_get_value(void *stored, GT_UNUSED const void *elem, void *data)
+{
+  *(void**) data = ((struct map_entry*) stored)->value;
+}
+
+void* gt_hashmap_get_or_add(GtHashmap *hm, void *key, void *value)
+{
+  struct map_entry keyvalpair = { key, value };
+  void *stored_value = value;
+  (void) gt_hashtable_add_or_update((GtHashtable*) hm, &keyvalpair,
+                                    hm_get_value, &stored_value);
+  return stored_value;
+}
+
+GtUword gt_hashmap_size(GtHashmap *hm)
+{
+  return (GtUword) gt_hashtable_fill((GtHashtable*) hm);
 }
 
 void gt_hashmap_remove(GtHashmap *hm, const void *key)
@@ -195,6 +221,61 @@ DECLARE_HASHMAP(GtUword, testul, GtUint64, testull,
 DEFINE_HASHMAP(GtUword, testul, GtUint64, testull,
                gt_ht_ul_elem_hash, gt_ht_ul_elem_cmp,
                NULL_DESTRUCTOR, NULL_DESTRUCTOR, static, inline)
+DECLARE_INTHASHMAP(GtUword, testul, GtUint64, testull)
+DEFINE_INTHASHMAP(GtUword, testul, GtUint64, testull)
+
+static enum iterator_op
+gt_inthashmap_test_visit(GtUword key, GtUint64 value, void *data,
+                         GT_UNUSED GtError *err)
+{
+  GtUword *last = data;
+  if (value != (GtUint64) key * 3 || (*last != GT_UWORD_MAX && key <= *last))
+    return STOP_ITERATION;
+  *last = key;
+  return CONTINUE_ITERATION;
+}
+
+/* compare the integer specialised map with the generic one on a mix of
+   additions and removals of clustered keys */
+static int
+gt_inthashmap_test(void)
+{
+  testul_testull_inthashmap *map = testul_testull_gt_inthashmap_new();
+  GtHashtable *ref = testul_testull_gt_hashmap_new();
+  GtUint64 *valueptr, *refptr;
+  GtUword i, key, last = GT_UWORD_MAX;
+  int had_err = 0;
+  do {
+    for (i = 0; !had_err && i < 20000UL; i++) {
+      key = (i * 7919UL) % 4096UL;
+      if (i % 3 == 2) {
+        my_ensure(had_err, testul_testull_gt_inthashmap_remove(map, key)
+                           == testul_testull_gt_hashmap_remove(ref, key));
+      } else {
+        testul_testull_gt_inthashmap_add(map, key, (GtUint64) key * 3);
+        testul_testull_gt_hashmap_add(ref, key, (GtUint64) key * 3);
+      }
+    }
+    for (key = 0; !had_err && key < 4096UL; key++) {
+      valueptr = testul_testull_gt_inthashmap_get(map, key);
+      refptr = testul_testull_gt_hashmap_get(ref, key);
+      my_ensure(had_err, (valueptr == NULL) == (refptr == NULL));
+      my_ensure(had_err, valueptr == NULL || *valueptr == *refptr);
+    }
+    if (had_err)
+      break;
+    my_ensure(had_err, testul_testull_gt_inthashmap_fill(map)
+                       == (GtUword) gt_hashtable_fill(ref));
+    my_ensure(had_err, !testul_testull_gt_inthashmap_foreach_in_default_order(
+                         map, gt_inthashmap_test_visit, &last, NULL));
+    testul_testull_gt_inthashmap_reset(map);
+    my_ensure(had_err, testul_testull_gt_inthashmap_fill(map) == 0);
+    my_ensure(had_err, !testul_testull_gt_inthashmap_get(map, 1UL));
+  } while (0);
+  testul_testull_gt_inthashmap_delete(map);
+  gt_hashtable_delete(ref);
+  return had_err;
+}
 
 static int
 gt_hashmap_test(GtHashType hash_type)
@@ -283,6 +364,10 @@ gt_hashmap_unit_test(GtError *err)
   if (!had_err)
     had_err = gt_hashmap_test(GT_HASH_STRING);
 
+  /* integer specialised map */
+  if (!had_err)
+    had_err = gt_inthashmap_test();
+
   if (had_err)
   {
     gt_error_set(err, "hashmap operation created inconsistent state.");
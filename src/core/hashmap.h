@@ -18,9 +18,15 @@
 #define HASHMAP_H
 
 #include "core/hashmap_api.h"
+#include "core/types_api.h"
 
 /* Returns the key stored in <hm> for <key> or NULL if no such key exists. */
 void*      gt_hashmap_get_key(GtHashmap *hm, const void *key);
+/* Returns the value stored in <hm> for <key>. If no such key exists, <key> is
+   added with <value>, which is returned. Both happens under one lock. */
+void*      gt_hashmap_get_or_add(GtHashmap *hm, void *key, void *value);
+/* Returns the number of members of <hm>. */
+GtUword    gt_hashmap_size(GtHashmap *hm);
 GtHashmap* gt_hashmap_new_no_ma(GtHashType keyhashtype, GtFree keyfree,
                                 GtFree valuefree);
 
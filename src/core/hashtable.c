@@ -283,7 +283,7 @@ gt_ht_traverse_list_of_key_debug(GtHashtable *ht, const void *elem)
 void* gt_hashtable_get(GtHashtable *ht, const void *elem)
 {
   gt_assert(ht);
-  gt_rwlock_wrlock(ht->lock);
+  gt_rwlock_rdlock(ht->lock);
 #if TJ_DEBUG > 1
   gt_ht_traverse_list_of_key_debug(ht, elem);
 #endif
@@ -297,6 +297,22 @@ void* gt_hashtable_get(GtHashtable *ht, const void *elem)
   return NULL;
 }
 
+int gt_hashtable_get_copy(GtHashtable *ht, const void *elem, void *copy)
+{
+  gt_assert(ht && copy);
+  gt_rwlock_rdlock(ht->lock);
+  gt_ht_traverse_list_of_key(ht, elem, ,
+                          if (link != free_mark
+                              && !ht->table_info.cmp(elem,
+                                                     gt_ht_elem_ptr(ht, idx))) {
+                            memcpy(copy, gt_ht_elem_ptr(ht, idx),
+                                   ht->table_info.elem_size);
+                            gt_rwlock_unlock(ht->lock);
+                            return 1; },);
+  gt_rwlock_unlock(ht->lock);
+  return 0;
+}
+
 int gt_hashtable_add(GtHashtable *ht, const void *elem)
 {
   int insert_count;
@@ -322,6 +338,22 @@ int gt_hashtable_add_with_storage_ptr(GtHashtable *ht, const void *elem,
   return insert_count;
 }
 
+int gt_hashtable_add_or_update(GtHashtable *ht, const void *elem,
+                               GtHashtableUpdateFunc update, void *data)
+{
+  int insert_count;
+  void *stored;
+  gt_assert(ht && elem);
+  gt_rwlock_wrlock(ht->lock);
+  if (ht->current_fill + 1 > ht->high_fill)
+    gt_ht_resize(ht, ht->table_size_log + 1);
+  insert_count = gt_ht_insert(ht, elem, &stored);
+  if (!insert_count && update)
+    update(stored, elem, data);
+  gt_rwlock_unlock(ht->lock);
+  return insert_count;
+}
+
 static htsize_t
 gt_ht_find_free_idx(GtHashtable *ht, htsize_t start_idx, int search_dir)
 {
@@ -41,6 +41,11 @@ typedef enum iterator_op (*Elemvisitfunc)(void *elem, void *data,
 
 typedef void (*FreeFuncWData)(void *elem, void *table_data);
 
+/* Called by <gt_hashtable_add_or_update()> with the stored element which
+   compares equal to the new element <elem>, while the table is locked. */
+typedef void (*GtHashtableUpdateFunc)(void *stored, const void *elem,
+                                      void *data);
+
 typedef uint32_t htsize_t;
 typedef htsize_t (*HashFunc)(const void *elem);
 
@@ -70,6 +75,14 @@ GtHashtable* gt_hashtable_ref(GtHashtable*);
 GtHashtable* gt_hashtable_new_with_start_size(HashElemInfo htype,
                                               unsigned short size_log);
 void*        gt_hashtable_get(GtHashtable*, const void *elem);
+/**
+ * @brief copy the element comparing equal to <elem> to <copy>, which
+ * must provide space for one element. Contrary to gt_hashtable_get(),
+ * the copy stays valid if other threads modify the table.
+ * @return 1 if an element was found, 0 otherwise.
+ */
+int          gt_hashtable_get_copy(GtHashtable*, const void *elem,
+                                   void *copy);
 /**
  * @return 1 if add succeeded, 0 if elem is already in table.
  */
@@ -77,6 +90,14 @@ int          gt_hashtable_add(GtHashtable*, const void *elem);
 int          gt_hashtable_add_with_storage_ptr(GtHashtable*,
                                                const void *elem,
                                                void **stor_ptr);
+/**
+ * @brief add <elem> or, if an equal element is already stored, call
+ * <update> (if not NULL) on it, both under the same lock.
+ * @return 1 if <elem> was added, 0 if an equal element was updated.
+ */
+int          gt_hashtable_add_or_update(GtHashtable*, const void *elem,
+                                        GtHashtableUpdateFunc update,
+                                        void *data);
 int          gt_hashtable_remove(GtHashtable*, const void *elem);
 /**
  * @brief iterate over the hashtable in key order given by compare
@@ -0,0 +1,317 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef INTHASHMAP_GENERIC_H
+#define INTHASHMAP_GENERIC_H
+
+#include <string.h>
+
+#include "core/assert_api.h"
+#include "core/hashtable.h"
+#include "core/ma.h"
+#include "core/qsort_r_api.h"
+#include "core/types_api.h"
+#include "core/unused_api.h"
+
+/**
+ * @file inthashmap-generic.h
+ * @brief Describes macros to define hashmaps with integer keys which are
+ * specialised for the key and value type. Contrary to the maps defined by
+ * hashmap-generic.h, hashing and key comparison are inlined, entries are
+ * copied by assignment, and no lock is involved. The table uses linear
+ * probing on a power of two sized array of entries, which is doubled
+ * when it is filled to three quarters.
+ */
+
+/*
+ * Where keytag and valuetag represent the strings passed to the macros,
+ * DECLARE_INTHASHMAP declares
+ *
+ * keytag_valuetag_inthashmap: the table type
+ * keytag_valuetag_gt_inthashmap_iteratorfunc: the visitor type for the
+ *                            foreach functions
+ *
+ * and DEFINE_INTHASHMAP defines the functions _new, _new_with_start_size,
+ * _delete, _get, _add, _add_and_return_storage, _remove, _fill, _reset,
+ * _foreach, _foreach_ordered and _foreach_in_default_order, prefixed by
+ * keytag_valuetag_gt_inthashmap. They behave like the functions of the same
+ * name defined by DEFINE_HASHMAP, but take a keytag_valuetag_inthashmap
+ * instead of a GtHashtable. The visitor functions must return
+ * CONTINUE_ITERATION or STOP_ITERATION.
+ */
+
+#define GT_INTHASHMAP_MIN_SIZE_LOG 4U
+
+/* multiplicative (Fibonacci) hashing, uses the upper <size_log> bits of the
+   product */
+/*@unused@*/ static inline GtUword
+gt_inthashmap_idx(GtUint64 key, unsigned int size_log)
+{
+  return (GtUword) ((key * (GtUint64) 0x9E3779B97F4A7C15ULL)
+                    >> (64U - size_log));
+}
+
+#define DECLARE_INTHASHMAP(keytype, keytag, valuetype, valuetag)           \
+  typedef struct {                                                        \
+    keytype key;                                                          \
+    valuetype value;                                                      \
+  } keytag##_##valuetag##_inthashmap_entry;                               \
+                                                                          \
+  typedef struct {                                                        \
+    keytag##_##valuetag##_inthashmap_entry *entries;                      \
+    unsigned char *occupied;                                              \
+    GtUword mask, fill, high_fill;                                        \
+    unsigned int size_log;                                                \
+  } keytag##_##valuetag##_inthashmap;                                     \
+                                                                          \
+  typedef enum iterator_op                                                \
+  (*keytag##_##valuetag##_gt_inthashmap_iteratorfunc)(                    \
+    keytype key, valuetype value, void *data, GtError *err);              \
+                                                                          \
+  typedef int (*keytag##_##valuetag##_gt_inthashmap_KeyCmp)(              \
+    const keytype a, const keytype b);
+
+#define DEFINE_INTHASHMAP(keytype, keytag, valuetype, valuetag)            \
+                                                                          \
+  GT_UNUSED static void                                                   \
+  keytag##_##valuetag##_gt_inthashmap_init(                               \
+    keytag##_##valuetag##_inthashmap *map, unsigned int size_log)         \
+  {                                                                       \
+    GtUword size = (GtUword) 1 << size_log;                               \
+    map->size_log = size_log;                                             \
+    map->mask = size - 1;                                                 \
+    map->high_fill = size - (size >> 2);                                  \
+    map->fill = 0;                                                        \
+    map->entries = gt_malloc(sizeof (*map->entries) * size);              \
+    map->occupied = gt_calloc((size_t) size, sizeof (*map->occupied));    \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static inline keytag##_##valuetag##_inthashmap *              \
+  keytag##_##valuetag##_gt_inthashmap_new_with_start_size(                \
+    unsigned short size_log)                                              \
+  {                                                                       \
+    keytag##_##valuetag##_inthashmap *map = gt_malloc(sizeof (*map));     \
+    keytag##_##valuetag##_gt_inthashmap_init(map,                         \
+      size_log < GT_INTHASHMAP_MIN_SIZE_LOG ? GT_INTHASHMAP_MIN_SIZE_LOG  \
+                                            : (unsigned int) size_log);   \
+    return map;                                                           \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static inline keytag##_##valuetag##_inthashmap *              \
+  keytag##_##valuetag##_gt_inthashmap_new(void)                           \
+  {                                                                       \
+    return keytag##_##valuetag##_gt_inthashmap_new_with_start_size(       \
+             (unsigned short) GT_INTHASHMAP_MIN_SIZE_LOG);                \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static inline void                                            \
+  keytag##_##valuetag##_gt_inthashmap_delete(                             \
+    keytag##_##valuetag##_inthashmap *map)                                \
+  {                                                                       \
+    if (!map) return;                                                     \
+    gt_free(map->entries);                                                \
+    gt_free(map->occupied);                                               \
+    gt_free(map);                                                         \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static inline GtUword                                         \
+  keytag##_##valuetag##_gt_inthashmap_fill(                               \
+    const keytag##_##valuetag##_inthashmap *map)                          \
+  {                                                                       \
+    return map->fill;                                                     \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static inline void                                            \
+  keytag##_##valuetag##_gt_inthashmap_reset(                              \
+    keytag##_##valuetag##_inthashmap *map)                                \
+  {                                                                       \
+    gt_free(map->entries);                                                \
+    gt_free(map->occupied);                                               \
+    keytag##_##valuetag##_gt_inthashmap_init(map,                         \
+                                             GT_INTHASHMAP_MIN_SIZE_LOG); \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static inline valuetype *                                     \
+  keytag##_##valuetag##_gt_inthashmap_get(                                \
+    const keytag##_##valuetag##_inthashmap *map, const keytype key)       \
+  {                                                                       \
+    GtUword idx = gt_inthashmap_idx((GtUint64) key, map->size_log);       \
+    while (map->occupied[idx]) {                                          \
+      if (map->entries[idx].key == key)                                   \
+        return &map->entries[idx].value;                                  \
+      idx = (idx + 1) & map->mask;                                        \
+    }                                                                     \
+    return NULL;                                                          \
+  }                                                                       \
+                                                                          \
+  /* returns the slot of <key>, which is free if <key> is not stored */   \
+  GT_UNUSED static inline GtUword                                         \
+  keytag##_##valuetag##_gt_inthashmap_slot(                               \
+    const keytag##_##valuetag##_inthashmap *map, const keytype key)       \
+  {                                                                       \
+    GtUword idx = gt_inthashmap_idx((GtUint64) key, map->size_log);       \
+    while (map->occupied[idx] && map->entries[idx].key != key)            \
+      idx = (idx + 1) & map->mask;                                        \
+    return idx;                                                           \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static void                                                   \
+  keytag##_##valuetag##_gt_inthashmap_grow(                               \
+    keytag##_##valuetag##_inthashmap *map)                                \
+  {                                                                       \
+    keytag##_##valuetag##_inthashmap old = *map;                          \
+    GtUword idx, slot;                                                    \
+    keytag##_##valuetag##_gt_inthashmap_init(map, old.size_log + 1);      \
+    for (idx = 0; idx <= old.mask; idx++) {                               \
+      if (old.occupied[idx]) {                                            \
+        slot = keytag##_##valuetag##_gt_inthashmap_slot(                  \
+                 map, old.entries[idx].key);                              \
+        map->entries[slot] = old.entries[idx];                            \
+        map->occupied[slot] = 1;                                          \
+      }                                                                   \
+    }                                                                     \
+    map->fill = old.fill;                                                 \
+    gt_free(old.entries);                                                 \
+    gt_free(old.occupied);                                                \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static inline valuetype *                                     \
+  keytag##_##valuetag##_gt_inthashmap_add_and_return_storage(             \
+    keytag##_##valuetag##_inthashmap *map, const keytype key,             \
+    valuetype value)                                                      \
+  {                                                                       \
+    GtUword slot = keytag##_##valuetag##_gt_inthashmap_slot(map, key);    \
+    if (!map->occupied[slot]) {                                           \
+      if (map->fill + 1 > map->high_fill) {                               \
+        keytag##_##valuetag##_gt_inthashmap_grow(map);                    \
+        slot = keytag##_##valuetag##_gt_inthashmap_slot(map, key);        \
+      }                                                                   \
+      map->entries[slot].key = key;                                       \
+      map->occupied[slot] = 1;                                            \
+      map->fill++;                                                        \
+    }                                                                     \
+    map->entries[slot].value = value;                                     \
+    return &map->entries[slot].value;                                     \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static inline void                                            \
+  keytag##_##valuetag##_gt_inthashmap_add(                                \
+    keytag##_##valuetag##_inthashmap *map, const keytype key,             \
+    valuetype value)                                                      \
+  {                                                                       \
+    (void) keytag##_##valuetag##_gt_inthashmap_add_and_return_storage(    \
+             map, key, value);                                            \
+  }                                                                       \
+                                                                          \
+  /* backward shift deletion, keeps the probe sequences free of holes */  \
+  GT_UNUSED static inline int                                             \
+  keytag##_##valuetag##_gt_inthashmap_remove(                             \
+    keytag##_##valuetag##_inthashmap *map, const keytype key)             \
+  {                                                                       \
+    GtUword hole, idx, home;                                              \
+    hole = keytag##_##valuetag##_gt_inthashmap_slot(map, key);            \
+    if (!map->occupied[hole])                                             \
+      return 0;                                                           \
+    idx = hole;                                                           \
+    while (true) {                                                        \
+      idx = (idx + 1) & map->mask;                                        \
+      if (!map->occupied[idx])                                            \
+        break;                                                            \
+      home = gt_inthashmap_idx((GtUint64) map->entries[idx].key,          \
+                               map->size_log);                            \
+      /* move the entry into the hole unless its home lies cyclically     \
+         between the hole and its current position */                     \
+      if (((idx - home) & map->mask) >= ((idx - hole) & map->mask)) {     \
+        map->entries[hole] = map->entries[idx];                           \
+        hole = idx;                                                       \
+      }                                                                   \
+    }                                                                     \
+    map->occupied[hole] = 0;                                              \
+    map->fill--;                                                          \
+    return 1;                                                             \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static int                                                    \
+  keytag##_##valuetag##_gt_inthashmap_foreach(                            \
+    keytag##_##valuetag##_inthashmap *map,                                \
+    keytag##_##valuetag##_gt_inthashmap_iteratorfunc iter,                \
+    void *data, GtError *err)                                             \
+  {                                                                       \
+    GtUword idx;                                                          \
+    for (idx = 0; idx <= map->mask; idx++) {                              \
+      if (map->occupied[idx]) {                                           \
+        enum iterator_op op = iter(map->entries[idx].key,                 \
+                                   map->entries[idx].value, data, err);   \
+        gt_assert(op == CONTINUE_ITERATION || op == STOP_ITERATION);      \
+        if (op == STOP_ITERATION)                                         \
+          return -1;                                                      \
+      }                                                                   \
+    }                                                                     \
+    return 0;                                                             \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static int                                                    \
+  keytag##_##valuetag##_gt_inthashmap_entry_cmp(                          \
+    const void *a, const void *b, void *data)                             \
+  {                                                                       \
+    const keytag##_##valuetag##_inthashmap_entry *ea = a, *eb = b;        \
+    keytag##_##valuetag##_gt_inthashmap_KeyCmp *cmp = data;               \
+    if (*cmp != NULL)                                                     \
+      return (*cmp)(ea->key, eb->key);                                    \
+    return (int) (ea->key > eb->key) - (int) (ea->key < eb->key);         \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static int                                                    \
+  keytag##_##valuetag##_gt_inthashmap_foreach_ordered(                    \
+    keytag##_##valuetag##_inthashmap *map,                                \
+    keytag##_##valuetag##_gt_inthashmap_iteratorfunc iter,                \
+    void *data, keytag##_##valuetag##_gt_inthashmap_KeyCmp cmp,           \
+    GtError *err)                                                         \
+  {                                                                       \
+    keytag##_##valuetag##_inthashmap_entry *sorted;                       \
+    GtUword idx, num = 0;                                                 \
+    int had_err = 0;                                                      \
+    sorted = gt_malloc(sizeof (*sorted) * (map->fill + 1));               \
+    for (idx = 0; idx <= map->mask; idx++) {                              \
+      if (map->occupied[idx])                                             \
+        sorted[num++] = map->entries[idx];                                \
+    }                                                                     \
+    gt_assert(num == map->fill);                                          \
+    gt_qsort_r(sorted, (size_t) num, sizeof (*sorted), &cmp,              \
+               keytag##_##valuetag##_gt_inthashmap_entry_cmp);            \
+    for (idx = 0; !had_err && idx < num; idx++) {                         \
+      enum iterator_op op = iter(sorted[idx].key, sorted[idx].value,      \
+                                 data, err);                              \
+      gt_assert(op == CONTINUE_ITERATION || op == STOP_ITERATION);        \
+      if (op == STOP_ITERATION)                                           \
+        had_err = -1;                                                     \
+    }                                                                     \
+    gt_free(sorted);                                                      \
+    return had_err;                                                       \
+  }                                                                       \
+                                                                          \
+  GT_UNUSED static inline int                                             \
+  keytag##_##valuetag##_gt_inthashmap_foreach_in_default_order(           \
+    keytag##_##valuetag##_inthashmap *map,                                \
+    keytag##_##valuetag##_gt_inthashmap_iteratorfunc iter,                \
+    void *data, GtError *err)                                             \
+  {                                                                       \
+    return keytag##_##valuetag##_gt_inthashmap_foreach_ordered(           \
+             map, iter, data, NULL, err);                                 \
+  }
+
+#endif
@@ -28,7 +28,7 @@
 
 #include "core/assert_api.h"
 #include "core/ma.h"
-#include "core/md5_encoder_api.h"
+#include "core/md5_encoder.h"
 
 #define GT_MD5_WORD 32
 #define GT_MD5_MASK 0xFFFFFFFF
@@ -261,3 +261,128 @@ void gt_md5_encoder_delete(GtMD5Encoder *enc)
   if (!enc) return;
   gt_free(enc);
 }
+
+/* One step in all lanes. The lanes are independent of each other, so the
+   loop can be vectorized. */
+#define LANES_STEP(FUNC, A, B, C, D, K, S, STEP)\
+        for (l = 0; l < GT_MD5_ENCODER_LANES; l++) {\
+          WORD32 v = A[l] + FUNC(B[l], C[l], D[l]) + m[K][l] + T[STEP];\
+          A[l] = B[l] + ((v << (S)) | (v >> (GT_MD5_WORD - (S))));\
+        }
+
+/* Four steps with constant message indices and rotations, which the
+   vectorizer needs, as it does not look through an enclosing loop. */
+#define LANES_ROUND1(J)\
+        LANES_STEP(F, a, b, c, d, (J), 7, (J));\
+        LANES_STEP(F, d, a, b, c, (J) + 1, 12, (J) + 1);\
+        LANES_STEP(F, c, d, a, b, (J) + 2, 17, (J) + 2);\
+        LANES_STEP(F, b, c, d, a, (J) + 3, 22, (J) + 3)
+#define LANES_ROUND2(J)\
+        LANES_STEP(G, a, b, c, d, (5 * (J) + 1) & 0x0f, 5, (J) + 16);\
+        LANES_STEP(G, d, a, b, c, (5 * ((J) + 1) + 1) & 0x0f, 9, (J) + 17);\
+        LANES_STEP(G, c, d, a, b, (5 * ((J) + 2) + 1) & 0x0f, 14, (J) + 18);\
+        LANES_STEP(G, b, c, d, a, (5 * ((J) + 3) + 1) & 0x0f, 20, (J) + 19)
+#define LANES_ROUND3(J)\
+        LANES_STEP(H, a, b, c, d, (3 * (J) + 5) & 0x0f, 4, (J) + 32);\
+        LANES_STEP(H, d, a, b, c, (3 * ((J) + 1) + 5) & 0x0f, 11, (J) + 33);\
+        LANES_STEP(H, c, d, a, b, (3 * ((J) + 2) + 5) & 0x0f, 16, (J) + 34);\
+        LANES_STEP(H, b, c, d, a, (3 * ((J) + 3) + 5) & 0x0f, 23, (J) + 35)
+#define LANES_ROUND4(J)\
+        LANES_STEP(I, a, b, c, d, (7 * (J)) & 0x0f, 6, (J) + 48);\
+        LANES_STEP(I, d, a, b, c, (7 * ((J) + 1)) & 0x0f, 10, (J) + 49);\
+        LANES_STEP(I, c, d, a, b, (7 * ((J) + 2)) & 0x0f, 15, (J) + 50);\
+        LANES_STEP(I, b, c, d, a, (7 * ((J) + 3)) & 0x0f, 21, (J) + 51)
+
+/* Digests one block of each lane, the new registers are stored in <st>. */
+static void digest_lanes(WORD32 m[16][GT_MD5_ENCODER_LANES],
+                         WORD32 st[4][GT_MD5_ENCODER_LANES])
+{
+  WORD32 a[GT_MD5_ENCODER_LANES], b[GT_MD5_ENCODER_LANES],
+         c[GT_MD5_ENCODER_LANES], d[GT_MD5_ENCODER_LANES];
+  int l;
+  memcpy(a, st[0], sizeof (a));
+  memcpy(b, st[1], sizeof (b));
+  memcpy(c, st[2], sizeof (c));
+  memcpy(d, st[3], sizeof (d));
+  LANES_ROUND1(0); LANES_ROUND1(4); LANES_ROUND1(8); LANES_ROUND1(12);
+  LANES_ROUND2(0); LANES_ROUND2(4); LANES_ROUND2(8); LANES_ROUND2(12);
+  LANES_ROUND3(0); LANES_ROUND3(4); LANES_ROUND3(8); LANES_ROUND3(12);
+  LANES_ROUND4(0); LANES_ROUND4(4); LANES_ROUND4(8); LANES_ROUND4(12);
+  memcpy(st[0], a, sizeof (a));
+  memcpy(st[1], b, sizeof (b));
+  memcpy(st[2], c, sizeof (c));
+  memcpy(st[3], d, sizeof (d));
+}
+
+void gt_md5_encoder_multi(const char **messages, const GtUword *lengths,
+                          GtUword num, char **outstr)
+{
+  WORD32 m[16][GT_MD5_ENCODER_LANES],
+         st[4][GT_MD5_ENCODER_LANES],
+         old[4][GT_MD5_ENCODER_LANES],
+         out[4];
+  GtUword numblocks[GT_MD5_ENCODER_LANES], maxblocks = 0, block, l;
+  unsigned char output[16];
+  char buf[64];
+  int i;
+
+  gt_assert(messages && lengths && outstr && num <= GT_MD5_ENCODER_LANES);
+  for (l = 0; l < GT_MD5_ENCODER_LANES; l++) {
+    st[0][l] = 0x67452301;
+    st[1][l] = 0xEFCDAB89;
+    st[2][l] = 0x98BADCFE;
+    st[3][l] = 0x10325476;
+    /* message, 0x80 and the 8 byte length, padded to full blocks */
+    numblocks[l] = l < num ? (lengths[l] + 8) / 64 + 1 : 0;
+    if (numblocks[l] > maxblocks)
+      maxblocks = numblocks[l];
+  }
+  for (block = 0; block < maxblocks; block++) {
+    for (l = 0; l < GT_MD5_ENCODER_LANES; l++) {
+      GtUword offset = block * 64;
+      WORD32 x[16];
+      if (l < num && offset + 64 <= lengths[l]) {
+        /* full block, no padding needed */
+        const unsigned char *pt = (const unsigned char*) messages[l] + offset;
+        for (i = 0; i < 16; i++) {
+          m[i][l] = (WORD32) pt[4 * i] | (WORD32) pt[4 * i + 1] << 8 |
+                    (WORD32) pt[4 * i + 2] << 16 | (WORD32) pt[4 * i + 3] << 24;
+        }
+        continue;
+      }
+      memset(buf, 0, sizeof (buf));
+      if (block < numblocks[l]) {
+        if (offset < lengths[l]) {
+          memcpy(buf, messages[l] + offset,
+                 (size_t) (lengths[l] - offset < 64 ? lengths[l] - offset
+                                                    : 64));
+        }
+        if (offset <= lengths[l] && lengths[l] < offset + 64)
+          buf[lengths[l] - offset] = '\200';
+      }
+      bytestoword32(x, buf);
+      if (block + 1 == numblocks[l])
+        put_length(x, (long) lengths[l]);
+      for (i = 0; i < 16; i++)
+        m[i][l] = x[i];
+    }
+    memcpy(old, st, sizeof (st));
+    digest_lanes(m, st);
+    for (i = 0; i < 4; i++) {
+      for (l = 0; l < GT_MD5_ENCODER_LANES; l++) {
+        /* finished lanes keep their state */
+        st[i][l] = block < numblocks[l] ? st[i][l] + old[i][l] : old[i][l];
+      }
+    }
+  }
+  for (l = 0; l < num; l++) {
+    for (i = 0; i < 4; i++)
+      out[i] = st[i][l];
+    word32tobytes(out, (char*) output);
+    for (i = 0; i < 16; i++) {
+      outstr[l][2 * i] = "0123456789abcdef"[output[i] >> 4];
+      outstr[l][2 * i + 1] = "0123456789abcdef"[output[i] & 0x0f];
+    }
+    outstr[l][32] = '\0';
+  }
+}
@@ -0,0 +1,35 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef MD5_ENCODER_H
+#define MD5_ENCODER_H
+
+#include "core/md5_encoder_api.h"
+#include "core/types_api.h"
+
+/* Number of messages hashed together by <gt_md5_encoder_multi()>. */
+#define GT_MD5_ENCODER_LANES 8
+
+/* Computes the MD5 hashes of the <num> messages <messages> with the given
+   <lengths>, <num> must not exceed <GT_MD5_ENCODER_LANES>. The
+   \0-terminated string representation of the hash of message i is written to
+   the 33-byte buffer <outstr>[i]. The blocks of all messages are digested in
+   lockstep, which lets the compiler use SIMD instructions. Hence this pays off
+   for short messages of similar length. */
+void gt_md5_encoder_multi(const char **messages, const GtUword *lengths,
+                          GtUword num, char **outstr);
+
+#endif
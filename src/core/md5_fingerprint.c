@@ -18,9 +18,11 @@
 #include <ctype.h>
 #include <string.h>
 #include "md5.h"
+#include "core/ensure.h"
 #include "core/ma.h"
-#include "core/md5_encoder_api.h"
-#include "core/md5_fingerprint_api.h"
+#include "core/mathsupport.h"
+#include "core/md5_encoder.h"
+#include "core/md5_fingerprint.h"
 #include "core/safearith.h"
 
 char* gt_md5_fingerprint(const char *sequence, GtUword seqlen)
@@ -46,3 +48,70 @@ char* gt_md5_fingerprint(const char *sequence, GtUword seqlen)
   gt_md5_encoder_delete(enc);
   return fingerprint;
 }
+
+void gt_md5_fingerprint_multi(const char **sequences, const GtUword *seqlens,
+                              GtUword num, char **fingerprints)
+{
+  char upper[GT_MD5_ENCODER_LANES][GT_MD5_FINGERPRINT_MULTI_MAXLEN],
+       *outstr[GT_MD5_ENCODER_LANES];
+  const char *messages[GT_MD5_ENCODER_LANES];
+  GtUword lengths[GT_MD5_ENCODER_LANES], i, j, numoflanes = 0;
+
+  gt_assert(sequences && seqlens && fingerprints);
+  for (i = 0; i < num; i++) {
+    if (seqlens[i] >= GT_MD5_FINGERPRINT_MULTI_MAXLEN) {
+      fingerprints[i] = gt_md5_fingerprint(sequences[i], seqlens[i]);
+      continue;
+    }
+    for (j = 0; j < seqlens[i]; j++)
+      upper[numoflanes][j] = toupper(sequences[i][j]);
+    messages[numoflanes] = upper[numoflanes];
+    lengths[numoflanes] = seqlens[i];
+    outstr[numoflanes] = fingerprints[i] = gt_calloc(33, sizeof (char));
+    if (++numoflanes == GT_MD5_ENCODER_LANES) {
+      gt_md5_encoder_multi(messages, lengths, numoflanes, outstr);
+      numoflanes = 0;
+    }
+  }
+  if (numoflanes > 0)
+    gt_md5_encoder_multi(messages, lengths, numoflanes, outstr);
+}
+
+int gt_md5_fingerprint_unit_test(GtError *err)
+{
+  const GtUword num = 100;
+  const char *sequences[100];
+  char *seqs[100], *fingerprints[100], *single;
+  GtUword seqlens[100], i, j;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* include empty, block boundary and long sequences */
+  for (i = 0; i < num; i++) {
+    if (i < 70)
+      seqlens[i] = i;
+    else if (i < 95)
+      seqlens[i] = gt_rand_max(GT_MD5_FINGERPRINT_MULTI_MAXLEN - 1);
+    else
+      seqlens[i] = GT_MD5_FINGERPRINT_MULTI_MAXLEN + gt_rand_max(200);
+    seqs[i] = gt_malloc(sizeof (char) * (seqlens[i] + 1));
+    for (j = 0; j < seqlens[i]; j++)
+      seqs[i][j] = "acgtnACGTN"[gt_rand_max(9)];
+    seqs[i][seqlens[i]] = '\0';
+    sequences[i] = seqs[i];
+  }
+  gt_md5_fingerprint_multi(sequences, seqlens, num, fingerprints);
+  for (i = 0; !had_err && i < num; i++) {
+    single = gt_md5_fingerprint(sequences[i], seqlens[i]);
+    gt_ensure(strcmp(single, fingerprints[i]) == 0);
+    gt_free(single);
+  }
+  single = gt_md5_fingerprint("", 0);
+  gt_ensure(strcmp(single, "d41d8cd98f00b204e9800998ecf8427e") == 0);
+  gt_free(single);
+  for (i = 0; i < num; i++) {
+    gt_free(seqs[i]);
+    gt_free(fingerprints[i]);
+  }
+  return had_err;
+}
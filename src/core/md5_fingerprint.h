@@ -0,0 +1,35 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef MD5_FINGERPRINT_H
+#define MD5_FINGERPRINT_H
+
+#include "core/error_api.h"
+#include "core/md5_fingerprint_api.h"
+
+/* Sequences shorter than this are hashed several at a time by
+   <gt_md5_fingerprint_multi()>. */
+#define GT_MD5_FINGERPRINT_MULTI_MAXLEN 1024
+
+/* Stores the MD5 fingerprints of the <num> <sequences> with lengths <seqlens>
+   in <fingerprints>, as <gt_md5_fingerprint()> would return them. It is the
+   responsibility of the caller to free the fingerprints. */
+void gt_md5_fingerprint_multi(const char **sequences, const GtUword *seqlens,
+                              GtUword num, char **fingerprints);
+
+int  gt_md5_fingerprint_unit_test(GtError *err);
+
+#endif
@@ -15,12 +15,17 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
+#include "core/ensure.h"
 #include "core/fa.h"
 #include "core/fileutils_api.h"
 #include "core/hashmap_api.h"
 #include "core/ma.h"
-#include "core/md5_fingerprint_api.h"
+#include "core/mathsupport.h"
+#include "core/md5_fingerprint.h"
 #include "core/md5_tab.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/xansi_api.h"
 
@@ -59,16 +64,84 @@ static bool read_fingerprints(GtMD5Tab *md5_tab,
   return reading_succeeded;
 }
 
+typedef struct {
+  const char **sequences;
+  const GtUword *seqlens;
+  char **md5_fingerprints;
+  GtUword num_of_seqs;
+} GtMD5TabPartition;
+
+static void *add_fingerprints_partition(void *data)
+{
+  GtMD5TabPartition *part = data;
+  gt_assert(part);
+  gt_md5_fingerprint_multi(part->sequences, part->seqlens, part->num_of_seqs,
+                           part->md5_fingerprints);
+  return NULL;
+}
+
 static void add_fingerprints(char **md5_fingerprints, void *seqs,
                              GtGetSeqFunc get_seq, GtGetSeqLenFunc get_seq_len,
                              GtUword num_of_seqs)
 {
-  GtUword i;
+  const char **sequences;
+  GtUword i, *seqlens, totallength = 0;
+  GtMD5TabPartition *parts;
+  unsigned int p, num_of_parts = 1;
   gt_assert(md5_fingerprints && seqs && get_seq && get_seq_len);
+  sequences = gt_malloc(sizeof (*sequences) * num_of_seqs);
+  seqlens = gt_malloc(sizeof (*seqlens) * num_of_seqs);
+  /* <get_seq> may load the sequences on demand, so it is called sequentially
+     before the fingerprints are computed in parallel */
   for (i = 0; i < num_of_seqs; i++) {
-    md5_fingerprints[i] = gt_md5_fingerprint(get_seq(seqs, i),
-                                             get_seq_len(seqs, i));
+    sequences[i] = get_seq(seqs, i);
+    seqlens[i] = get_seq_len(seqs, i);
+    totallength += seqlens[i];
   }
+#ifdef GT_THREADS_ENABLED
+  if (num_of_seqs > 1UL)
+    num_of_parts = (unsigned int) MIN((GtUword) gt_jobs, num_of_seqs);
+#endif
+  /* partition the sequences into parts of about the same total length, each
+     part gets at least one sequence */
+  parts = gt_calloc(num_of_parts, sizeof (*parts));
+  for (i = 0, p = 0; p < num_of_parts; p++) {
+    GtUword length = 0,
+            target = totallength / (num_of_parts - p);
+    parts[p].sequences = sequences + i;
+    parts[p].seqlens = seqlens + i;
+    parts[p].md5_fingerprints = md5_fingerprints + i;
+    while (i < num_of_seqs &&
+           (p + 1 == num_of_parts ||
+            (parts[p].num_of_seqs == 0 ||
+             (length < target && num_of_seqs - i > num_of_parts - p - 1)))) {
+      length += seqlens[i++];
+      parts[p].num_of_seqs++;
+    }
+    totallength -= length;
+  }
+#ifdef GT_THREADS_ENABLED
+  if (num_of_parts > 1U) {
+    GtThread **threads = gt_calloc(num_of_parts, sizeof (*threads));
+    for (p = 1; p < num_of_parts; p++) {
+      threads[p] = gt_thread_new(add_fingerprints_partition, parts + p, NULL);
+      if (threads[p] == NULL)
+        (void) add_fingerprints_partition(parts + p);
+    }
+    (void) add_fingerprints_partition(parts);
+    for (p = 1; p < num_of_parts; p++) {
+      if (threads[p] != NULL) {
+        gt_thread_join(threads[p]);
+        gt_thread_delete(threads[p]);
+      }
+    }
+    gt_free(threads);
+  } else
+#endif
+    (void) add_fingerprints_partition(parts);
+  gt_free(parts);
+  gt_free(sequences);
+  gt_free(seqlens);
 }
 
 static void dump_md5_fingerprints(char **md5_fingerprints,
@@ -224,3 +297,42 @@ GtUword gt_md5_tab_size(const GtMD5Tab *md5_tab)
   gt_assert(md5_tab);
   return md5_tab->num_of_md5s;
 }
+
+static const char* unit_test_get_seq(void *seqs, GtUword idx)
+{
+  return ((char**) seqs)[idx];
+}
+
+static GtUword unit_test_get_seq_len(void *seqs, GtUword idx)
+{
+  return (GtUword) strlen(((char**) seqs)[idx]);
+}
+
+int gt_md5_tab_unit_test(GtError *err)
+{
+  char *seqs[50], *fingerprint;
+  GtMD5Tab *md5_tab;
+  GtUword i, j, len;
+  int had_err = 0;
+  gt_error_check(err);
+
+  for (i = 0; i < 50UL; i++) {
+    len = i % 5 == 0 ? 2000 + gt_rand_max(1000) : gt_rand_max(300);
+    seqs[i] = gt_malloc(sizeof (char) * (len + 1));
+    for (j = 0; j < len; j++)
+      seqs[i][j] = "acgtACGT"[gt_rand_max(7)];
+    seqs[i][len] = '\0';
+  }
+  md5_tab = gt_md5_tab_new("unused", seqs, unit_test_get_seq,
+                           unit_test_get_seq_len, 50, false, false);
+  gt_ensure(gt_md5_tab_size(md5_tab) == 50UL);
+  for (i = 0; !had_err && i < 50UL; i++) {
+    fingerprint = gt_md5_fingerprint(seqs[i], strlen(seqs[i]));
+    gt_ensure(strcmp(gt_md5_tab_get(md5_tab, i), fingerprint) == 0);
+    gt_free(fingerprint);
+  }
+  gt_md5_tab_delete(md5_tab);
+  for (i = 0; i < 50UL; i++)
+    gt_free(seqs[i]);
+  return had_err;
+}
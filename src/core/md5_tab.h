@@ -36,7 +36,9 @@ typedef GtUword     (*GtGetSeqLenFunc)(void *seqs, GtUword index);
    "<sequence_file><GT_MD5TAB_FILE_SUFFIX>"), if it exists or written to it, if
    it doesn't exist. If <use_cache_file> is <false>, no cache file is read or
    written. If <use_file_locking> is <true>, file locking is used to access the
-   cache file (recommended). */
+   cache file (recommended). The fingerprints are computed by <gt_jobs>
+   threads, <get_seq> and <get_seq_len> are only called by the calling
+   thread. */
 GtMD5Tab*     gt_md5_tab_new(const char *sequence_file, void *seqs,
                              GtGetSeqFunc get_seq, GtGetSeqLenFunc get_seq_len,
                              GtUword num_of_seqs, bool use_cache_file,
@@ -60,4 +62,6 @@ GtUword       gt_md5_tab_map(GtMD5Tab*, const char *md5);
 GtUword       gt_md5_tab_size(const GtMD5Tab*);
 void          gt_md5_tab_delete(GtMD5Tab *md5_tab);
 
+int           gt_md5_tab_unit_test(GtError *err);
+
 #endif
@@ -34,8 +34,12 @@ int gt_multithread(GtThreadFunc function, void *data, GtError *err)
   /* start all other threads and store them */
   for (i = 1; i < gt_jobs; i++) {
     if (!(thread = gt_thread_new(function, data, err))) {
-      for (j = 0; j < gt_array_size(threads); j++)
-        gt_thread_delete(*(GtThread**) gt_array_get(threads, j));
+      /* the started threads use <data>, wait for them before returning */
+      for (j = 0; j < gt_array_size(threads); j++) {
+        thread = *(GtThread**) gt_array_get(threads, j);
+        gt_thread_join(thread);
+        gt_thread_delete(thread);
+      }
       gt_array_delete(threads);
       return -1;
     }
@@ -0,0 +1,187 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include <sys/stat.h>
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/resource_cache.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+
+typedef struct {
+  void *resource;
+  GtResourceCacheRefFunc ref_func;
+  GtFree free_func;
+  time_t mtime;
+  off_t size;
+} GtResourceCacheEntry;
+
+static GtHashmap *resource_cache = NULL;
+static GtMutex *resource_cache_mutex = NULL;
+
+static void resource_cache_entry_delete(void *data)
+{
+  GtResourceCacheEntry *entry = data;
+  if (!entry) return;
+  entry->free_func(entry->resource);
+  gt_free(entry);
+}
+
+static void resource_cache_file_stat(const char *filename, time_t *mtime,
+                                     off_t *size)
+{
+  struct stat sb;
+  *mtime = 0;
+  *size = 0;
+  if (filename && stat(filename, &sb) == 0) {
+    *mtime = sb.st_mtime;
+    *size = sb.st_size;
+  }
+}
+
+void gt_resource_cache_enable(void)
+{
+  if (resource_cache) return;
+  resource_cache = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                                  resource_cache_entry_delete);
+  resource_cache_mutex = gt_mutex_new();
+}
+
+void gt_resource_cache_disable(void)
+{
+  if (!resource_cache) return;
+  gt_hashmap_delete(resource_cache);
+  gt_mutex_delete(resource_cache_mutex);
+  resource_cache = NULL;
+  resource_cache_mutex = NULL;
+}
+
+bool gt_resource_cache_enabled(void)
+{
+  return resource_cache != NULL;
+}
+
+void* gt_resource_cache_get(const char *key, const char *filename)
+{
+  GtResourceCacheEntry *entry;
+  void *resource = NULL;
+  gt_assert(key);
+  if (!resource_cache) return NULL;
+  gt_mutex_lock(resource_cache_mutex);
+  if ((entry = gt_hashmap_get(resource_cache, key))) {
+    time_t mtime;
+    off_t size;
+    resource_cache_file_stat(filename, &mtime, &size);
+    if (mtime == entry->mtime && size == entry->size)
+      resource = entry->ref_func(entry->resource);
+    else /* the file has changed, the resource is stale */
+      gt_hashmap_remove(resource_cache, key);
+  }
+  gt_mutex_unlock(resource_cache_mutex);
+  return resource;
+}
+
+void gt_resource_cache_add(const char *key, const char *filename,
+                           void *resource, GtResourceCacheRefFunc ref_func,
+                           GtFree free_func)
+{
+  GtResourceCacheEntry *entry;
+  gt_assert(key && resource && ref_func && free_func);
+  if (!resource_cache) return;
+  entry = gt_malloc(sizeof *entry);
+  entry->resource = ref_func(resource);
+  entry->ref_func = ref_func;
+  entry->free_func = free_func;
+  resource_cache_file_stat(filename, &entry->mtime, &entry->size);
+  gt_mutex_lock(resource_cache_mutex);
+  gt_hashmap_remove(resource_cache, key);
+  gt_hashmap_add(resource_cache, gt_cstr_dup(key), entry);
+  gt_mutex_unlock(resource_cache_mutex);
+}
+
+void gt_resource_cache_remove(const char *key)
+{
+  gt_assert(key);
+  if (!resource_cache) return;
+  gt_mutex_lock(resource_cache_mutex);
+  gt_hashmap_remove(resource_cache, key);
+  gt_mutex_unlock(resource_cache_mutex);
+}
+
+static void* resource_cache_str_ref(void *str)
+{
+  return gt_str_ref(str);
+}
+
+static void resource_cache_str_delete(void *str)
+{
+  gt_str_delete(str);
+}
+
+int gt_resource_cache_unit_test(GtError *err)
+{
+  GtStr *str, *cached;
+  bool was_enabled = gt_resource_cache_enabled();
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (was_enabled)
+    gt_resource_cache_disable();
+  str = gt_str_new_cstr("resource");
+
+  /* disabled cache */
+  gt_resource_cache_add("str", NULL, str, resource_cache_str_ref,
+                        resource_cache_str_delete);
+  gt_ensure(gt_resource_cache_get("str", NULL) == NULL);
+
+  /* enabled cache */
+  gt_resource_cache_enable();
+  gt_ensure(gt_resource_cache_enabled());
+  gt_ensure(gt_resource_cache_get("str", NULL) == NULL);
+  gt_resource_cache_add("str", NULL, str, resource_cache_str_ref,
+                        resource_cache_str_delete);
+  cached = gt_resource_cache_get("str", NULL);
+  gt_ensure(cached == str);
+  gt_str_delete(cached);
+  gt_ensure(gt_resource_cache_get("other", NULL) == NULL);
+
+  /* a resource whose file has appeared is stale */
+  cached = gt_resource_cache_get("str", "/");
+  gt_ensure(cached == NULL);
+  gt_ensure(gt_resource_cache_get("str", NULL) == NULL);
+
+  /* removal */
+  gt_resource_cache_add("str", NULL, str, resource_cache_str_ref,
+                        resource_cache_str_delete);
+  gt_resource_cache_remove("str");
+  gt_ensure(gt_resource_cache_get("str", NULL) == NULL);
+
+  /* disabling releases all resources */
+  gt_resource_cache_add("str", NULL, str, resource_cache_str_ref,
+                        resource_cache_str_delete);
+  gt_resource_cache_disable();
+  gt_ensure(!gt_resource_cache_enabled());
+  gt_ensure(strcmp(gt_str_get(str), "resource") == 0);
+  gt_str_delete(str);
+
+  if (was_enabled)
+    gt_resource_cache_enable();
+  return had_err;
+}
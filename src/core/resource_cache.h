@@ -0,0 +1,60 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef RESOURCE_CACHE_H
+#define RESOURCE_CACHE_H
+
+#include <stdbool.h>
+#include "core/error_api.h"
+#include "core/fptr_api.h"
+
+/* The ResourceCache module keeps objects which are expensive to create from
+   files (e.g. encoded sequences or type checkers) alive between the commands
+   run by a single long-lived process, such as the one of `gt batch`. The cache
+   is disabled by default, in which case all lookups fail. */
+
+/* Function returning a new reference to <resource>. */
+typedef void* (*GtResourceCacheRefFunc)(void *resource);
+
+/* Enable the resource cache. */
+void  gt_resource_cache_enable(void);
+
+/* Disable the resource cache and release all cached resources. */
+void  gt_resource_cache_disable(void);
+
+/* Returns true if the resource cache is enabled, false otherwise. */
+bool  gt_resource_cache_enabled(void);
+
+/* Return a new reference to the resource stored under <key>, or NULL if the
+   cache is disabled, if there is no such resource, or if the file <filename>
+   the resource was created from has changed since it was added. */
+void* gt_resource_cache_get(const char *key, const char *filename);
+
+/* Store <resource> under <key>, replacing a resource previously stored under
+   this key. <filename> is the file the resource was created from. The cache
+   takes a reference to <resource> using <ref_func> and releases it with
+   <free_func>. Nothing happens if the cache is disabled. */
+void  gt_resource_cache_add(const char *key, const char *filename,
+                            void *resource, GtResourceCacheRefFunc ref_func,
+                            GtFree free_func);
+
+/* Release the resource stored under <key>, if any. */
+void  gt_resource_cache_remove(const char *key);
+
+int   gt_resource_cache_unit_test(GtError *err);
+
+#endif
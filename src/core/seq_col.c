@@ -40,7 +40,11 @@ const GtSeqColClass* gt_seq_col_class_new(size_t size,
                                           GtSeqColGetMD5Func get_md5,
                                           GtSeqColGetSeqFunc get_seq,
                                           GtSeqColGetDescFunc get_desc,
-                                          GtSeqColGetSeqlenFunc get_seqlen)
+                                          GtSeqColGetSeqlenFunc get_seqlen,
+                                          GtSeqColGrepDescIndexFunc
+                                                                grep_desc_index,
+                                          GtSeqColMD5ToIndexFunc md5_to_index,
+                                          GtSeqColExtractSeqFunc extract_seq)
 {
   GtSeqColClass *c_class = gt_class_alloc(sizeof *c_class);
   c_class->size = size;
@@ -59,6 +63,9 @@ const GtSeqColClass* gt_seq_col_class_new(size_t size,
   c_class->get_seq = get_seq;
   c_class->get_desc = get_desc;
   c_class->get_seqlen = get_seqlen;
+  c_class->grep_desc_index = grep_desc_index;
+  c_class->md5_to_index = md5_to_index;
+  c_class->extract_seq = extract_seq;
   return c_class;
 }
 
@@ -211,3 +218,29 @@ GtUword gt_seq_col_get_sequence_length(const GtSeqCol *sc,
     return sc->c_class->get_seqlen(sc, filenum, seqnum);
   return 0;
 }
+
+int gt_seq_col_grep_desc_index(GtSeqCol *sc, GtUword *filenum, GtUword *seqnum,
+                               GtStr *seqid, GtError *err)
+{
+  gt_assert(sc && filenum && seqnum && seqid);
+  if (sc->c_class->grep_desc_index)
+    return sc->c_class->grep_desc_index(sc, filenum, seqnum, seqid, err);
+  return 0;
+}
+
+int gt_seq_col_md5_to_index(GtSeqCol *sc, GtUword *filenum, GtUword *seqnum,
+                            GtStr *md5_seqid, GtError *err)
+{
+  gt_assert(sc && filenum && seqnum && md5_seqid);
+  if (sc->c_class->md5_to_index)
+    return sc->c_class->md5_to_index(sc, filenum, seqnum, md5_seqid, err);
+  return 0;
+}
+
+void gt_seq_col_extract_sequence(GtSeqCol *sc, char *buffer, GtUword filenum,
+                                 GtUword seqnum, GtUword start, GtUword end)
+{
+  gt_assert(sc && buffer && start <= end);
+  if (sc->c_class->extract_seq)
+    sc->c_class->extract_seq(sc, buffer, filenum, seqnum, start, end);
+}
@@ -59,5 +59,23 @@ char*       gt_seq_col_get_description(const GtSeqCol*,
 GtUword     gt_seq_col_get_sequence_length(const GtSeqCol*,
                                            GtUword filenum,
                                            GtUword seqnum);
+/* Store the file and sequence number of the sequence whose description
+   matches <seqid> in <filenum> and <seqnum>. */
+int         gt_seq_col_grep_desc_index(GtSeqCol*, GtUword *filenum,
+                                       GtUword *seqnum, GtStr *seqid,
+                                       GtError*);
+/* Store the file and sequence number of the sequence with the MD5 sequence ID
+   <md5_seqid> in <filenum> and <seqnum>. */
+int         gt_seq_col_md5_to_index(GtSeqCol*, GtUword *filenum,
+                                    GtUword *seqnum, GtStr *md5_seqid,
+                                    GtError*);
+/* Write the characters from <start> to <end> of the given sequence to
+   <buffer>, which must have space for <end> - <start> + 1 characters. In
+   contrast to <gt_seq_col_get_sequence()> no memory is allocated, apart from
+   a reader which is kept in the <GtSeqCol> for subsequent calls. Hence
+   a <GtSeqCol> must not be shared between threads using this function. */
+void        gt_seq_col_extract_sequence(GtSeqCol*, char *buffer,
+                                        GtUword filenum, GtUword seqnum,
+                                        GtUword start, GtUword end);
 
 #endif
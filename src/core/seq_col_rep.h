@@ -61,6 +61,17 @@ typedef       char* (*GtSeqColGetDescFunc)(const GtSeqCol*,
 typedef GtUword     (*GtSeqColGetSeqlenFunc)(const GtSeqCol*,
                                              GtUword filenum,
                                              GtUword seqnum);
+typedef int         (*GtSeqColGrepDescIndexFunc)(GtSeqCol*, GtUword *filenum,
+                                                 GtUword *seqnum, GtStr *seqid,
+                                                 GtError*);
+typedef int         (*GtSeqColMD5ToIndexFunc)(GtSeqCol*, GtUword *filenum,
+                                              GtUword *seqnum,
+                                              GtStr *md5_seqid, GtError*);
+typedef void        (*GtSeqColExtractSeqFunc)(GtSeqCol*, char *buffer,
+                                              GtUword filenum,
+                                              GtUword seqnum,
+                                              GtUword start,
+                                              GtUword end);
 
 struct GtSeqColClass {
   size_t size;
@@ -79,6 +90,9 @@ struct GtSeqColClass {
   GtSeqColGetSeqFunc get_seq;
   GtSeqColGetDescFunc get_desc;
   GtSeqColGetSeqlenFunc get_seqlen;
+  GtSeqColGrepDescIndexFunc grep_desc_index;
+  GtSeqColMD5ToIndexFunc md5_to_index;
+  GtSeqColExtractSeqFunc extract_seq;
 };
 
 struct GtSeqCol {
@@ -103,7 +117,11 @@ const GtSeqColClass* gt_seq_col_class_new(size_t size,
                                           GtSeqColGetMD5Func get_md5,
                                           GtSeqColGetSeqFunc get_seq,
                                           GtSeqColGetDescFunc get_desc,
-                                          GtSeqColGetSeqlenFunc get_seqlen);
+                                          GtSeqColGetSeqlenFunc get_seqlen,
+                                          GtSeqColGrepDescIndexFunc
+                                                                grep_desc_index,
+                                          GtSeqColMD5ToIndexFunc md5_to_index,
+                                          GtSeqColExtractSeqFunc extract_seq);
 GtSeqCol*      gt_seq_col_create(const GtSeqColClass*);
 void*          gt_seq_col_cast(const GtSeqColClass*, const GtSeqCol*);
 
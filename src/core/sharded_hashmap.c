@@ -0,0 +1,342 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "core/array.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/hashmap.h"
+#include "core/hashtable.h"
+#include "core/ma.h"
+#include "core/multithread_api.h"
+#include "core/qsort_r_api.h"
+#include "core/sharded_hashmap.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
+
+#define SHARDED_HASHMAP_MIN_SHARD_LOG 4U
+
+struct GtShardedHashmap {
+  GtHashmap **shards;
+  GtHashType keyhashtype;
+  unsigned int shard_log;
+  GtUword reference_count;
+  GtMutex *mutex;
+};
+
+typedef struct {
+  void *key,
+       *value;
+} ShardedHashmapEntry;
+
+GtShardedHashmap* gt_sharded_hashmap_new(GtHashType keyhashtype,
+                                         GtFree keyfree, GtFree valuefree,
+                                         unsigned int shard_log)
+{
+  GtShardedHashmap *shm;
+  GtUword i;
+  gt_assert(shard_log < 16U);
+  if (shard_log == 0) {
+    /* at least four shards per thread */
+    shard_log = SHARDED_HASHMAP_MIN_SHARD_LOG;
+    while (((GtUword) 1 << shard_log) < 4UL * gt_jobs && shard_log < 12U)
+      shard_log++;
+  }
+  shm = gt_malloc(sizeof *shm);
+  shm->keyhashtype = keyhashtype;
+  shm->shard_log = shard_log;
+  shm->shards = gt_malloc(sizeof (*shm->shards) * ((size_t) 1 << shard_log));
+  for (i = 0; i < ((GtUword) 1 << shard_log); i++)
+    shm->shards[i] = gt_hashmap_new(keyhashtype, keyfree, valuefree);
+  shm->reference_count = 0;
+  shm->mutex = gt_mutex_new();
+  return shm;
+}
+
+GtShardedHashmap* gt_sharded_hashmap_ref(GtShardedHashmap *shm)
+{
+  gt_assert(shm);
+  gt_mutex_lock(shm->mutex);
+  shm->reference_count++;
+  gt_mutex_unlock(shm->mutex);
+  return shm;
+}
+
+/* The shards are selected by the upper bits of the hash value, the tables of
+   the shards use the lower bits. */
+static GtHashmap* sharded_hashmap_shard(const GtShardedHashmap *shm,
+                                        const void *key)
+{
+  uint32_t hash;
+  if (shm->keyhashtype == GT_HASH_STRING)
+    hash = gt_ht_cstr_elem_hash(&key);
+  else
+    hash = gt_ht_ptr_elem_hash(&key);
+  return shm->shards[hash >> (32U - shm->shard_log)];
+}
+
+void* gt_sharded_hashmap_get(GtShardedHashmap *shm, const void *key)
+{
+  gt_assert(shm);
+  return gt_hashmap_get(sharded_hashmap_shard(shm, key), key);
+}
+
+void gt_sharded_hashmap_add(GtShardedHashmap *shm, void *key, void *value)
+{
+  gt_assert(shm);
+  gt_hashmap_add(sharded_hashmap_shard(shm, key), key, value);
+}
+
+void* gt_sharded_hashmap_get_or_add(GtShardedHashmap *shm, void *key,
+                                    void *value)
+{
+  gt_assert(shm);
+  return gt_hashmap_get_or_add(sharded_hashmap_shard(shm, key), key, value);
+}
+
+void gt_sharded_hashmap_remove(GtShardedHashmap *shm, const void *key)
+{
+  gt_assert(shm);
+  gt_hashmap_remove(sharded_hashmap_shard(shm, key), key);
+}
+
+GtUword gt_sharded_hashmap_size(GtShardedHashmap *shm)
+{
+  GtUword i, size = 0;
+  gt_assert(shm);
+  for (i = 0; i < ((GtUword) 1 << shm->shard_log); i++)
+    size += gt_hashmap_size(shm->shards[i]);
+  return size;
+}
+
+int gt_sharded_hashmap_foreach(GtShardedHashmap *shm, GtHashmapVisitFunc func,
+                               void *data, GtError *err)
+{
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(shm && func);
+  for (i = 0; !had_err && i < ((GtUword) 1 << shm->shard_log); i++)
+    had_err = gt_hashmap_foreach(shm->shards[i], func, data, err);
+  return had_err;
+}
+
+static int sharded_hashmap_collect(void *key, void *value, void *data,
+                                   GT_UNUSED GtError *err)
+{
+  ShardedHashmapEntry entry;
+  entry.key = key;
+  entry.value = value;
+  gt_array_add((GtArray*) data, entry);
+  return 0;
+}
+
+typedef struct {
+  GtCompare cmp;
+  GtHashType keyhashtype;
+  void *data;
+} ShardedHashmapSortInfo;
+
+static int sharded_hashmap_entry_cmp(const void *a, const void *b, void *data)
+{
+  const ShardedHashmapEntry *entry_a = a, *entry_b = b;
+  ShardedHashmapSortInfo *info = data;
+  if (info->cmp != NULL) {
+    return ((GtCompareWithData) info->cmp)(entry_a->key, entry_b->key,
+                                           info->data);
+  }
+  if (info->keyhashtype == GT_HASH_STRING)
+    return strcmp(entry_a->key, entry_b->key);
+  return gt_ht_ptr_cmp(entry_a->key, entry_b->key);
+}
+
+static int sharded_hashmap_foreach_sorted(GtShardedHashmap *shm,
+                                          GtHashmapVisitFunc func, void *data,
+                                          GtCompare cmp, GtError *err)
+{
+  ShardedHashmapSortInfo info;
+  ShardedHashmapEntry *entry;
+  GtArray *entries;
+  GtUword i;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(shm && func);
+  entries = gt_array_new(sizeof (ShardedHashmapEntry));
+  had_err = gt_sharded_hashmap_foreach(shm, sharded_hashmap_collect, entries,
+                                       err);
+  if (!had_err) {
+    info.cmp = cmp;
+    info.keyhashtype = shm->keyhashtype;
+    info.data = data;
+    gt_qsort_r(gt_array_get_space(entries), gt_array_size(entries),
+               sizeof (ShardedHashmapEntry), &info,
+               sharded_hashmap_entry_cmp);
+    for (i = 0; !had_err && i < gt_array_size(entries); i++) {
+      entry = gt_array_get(entries, i);
+      if (func(entry->key, entry->value, data, err))
+        had_err = -1;
+    }
+  }
+  gt_array_delete(entries);
+  return had_err;
+}
+
+int gt_sharded_hashmap_foreach_ordered(GtShardedHashmap *shm,
+                                       GtHashmapVisitFunc func, void *data,
+                                       GtCompare cmp, GtError *err)
+{
+  gt_assert(cmp);
+  return sharded_hashmap_foreach_sorted(shm, func, data, cmp, err);
+}
+
+int gt_sharded_hashmap_foreach_in_key_order(GtShardedHashmap *shm,
+                                            GtHashmapVisitFunc func,
+                                            void *data, GtError *err)
+{
+  return sharded_hashmap_foreach_sorted(shm, func, data, NULL, err);
+}
+
+void gt_sharded_hashmap_reset(GtShardedHashmap *shm)
+{
+  GtUword i;
+  gt_assert(shm);
+  for (i = 0; i < ((GtUword) 1 << shm->shard_log); i++)
+    gt_hashmap_reset(shm->shards[i]);
+}
+
+void gt_sharded_hashmap_delete(GtShardedHashmap *shm)
+{
+  GtUword i;
+  if (!shm) return;
+  gt_mutex_lock(shm->mutex);
+  if (shm->reference_count) {
+    shm->reference_count--;
+    gt_mutex_unlock(shm->mutex);
+    return;
+  }
+  gt_mutex_unlock(shm->mutex);
+  for (i = 0; i < ((GtUword) 1 << shm->shard_log); i++)
+    gt_hashmap_delete(shm->shards[i]);
+  gt_free(shm->shards);
+  gt_mutex_delete(shm->mutex);
+  gt_free(shm);
+}
+
+#define SHARDED_HASHMAP_TEST_PERTHREAD 5000UL
+
+typedef struct {
+  GtShardedHashmap *shm;
+  GtMutex *mutex;
+  GtUword next_thread_num;
+  bool failed;
+} ShardedHashmapTestInfo;
+
+/* Each thread adds its own keys and competes with all others for a set of
+   shared keys, of which the first value added must win. */
+static void* sharded_hashmap_test_thread(void *data)
+{
+  ShardedHashmapTestInfo *info = data;
+  GtUword i, key, value, thread_num;
+  bool failed = false;
+  gt_mutex_lock(info->mutex);
+  thread_num = info->next_thread_num++;
+  gt_mutex_unlock(info->mutex);
+  for (i = 0; i < SHARDED_HASHMAP_TEST_PERTHREAD; i++) {
+    key = (thread_num + 1) * SHARDED_HASHMAP_TEST_PERTHREAD * 4 + i;
+    gt_sharded_hashmap_add(info->shm, (void*) key, (void*) (key + 1));
+    key = i + 1;
+    value = (GtUword) gt_sharded_hashmap_get_or_add(info->shm, (void*) key,
+                                                    (void*) (thread_num + 1));
+    if (value < 1 || value > gt_jobs ||
+        gt_sharded_hashmap_get(info->shm, (void*) key) != (void*) value) {
+      failed = true;
+    }
+  }
+  if (failed) {
+    gt_mutex_lock(info->mutex);
+    info->failed = true;
+    gt_mutex_unlock(info->mutex);
+  }
+  return NULL;
+}
+
+static int sharded_hashmap_test_visit(void *key, void *value, void *data,
+                                      GT_UNUSED GtError *err)
+{
+  GtUword *last = data;
+  if (value != key || (GtUword) key <= *last)
+    return 1;
+  *last = (GtUword) key;
+  return 0;
+}
+
+int gt_sharded_hashmap_unit_test(GtError *err)
+{
+  ShardedHashmapTestInfo info;
+  GtShardedHashmap *shm;
+  char *s1 = "foo", *s2 = "bar";
+  GtUword i, last = 0;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* string keys with free functions */
+  shm = gt_sharded_hashmap_new(GT_HASH_STRING, gt_free_func, gt_free_func, 2);
+  gt_sharded_hashmap_add(shm, gt_cstr_dup(s1), gt_cstr_dup(s2));
+  gt_sharded_hashmap_add(shm, gt_cstr_dup(s2), gt_cstr_dup(s1));
+  gt_ensure(!strcmp(gt_sharded_hashmap_get(shm, s1), s2));
+  gt_ensure(!strcmp(gt_sharded_hashmap_get(shm, s2), s1));
+  gt_ensure(gt_sharded_hashmap_size(shm) == 2UL);
+  gt_sharded_hashmap_remove(shm, s1);
+  gt_ensure(!gt_sharded_hashmap_get(shm, s1));
+  gt_ensure(gt_sharded_hashmap_size(shm) == 1UL);
+  gt_sharded_hashmap_reset(shm);
+  gt_ensure(!gt_sharded_hashmap_get(shm, s2));
+  gt_sharded_hashmap_delete(shm);
+
+  /* direct keys, iteration in key order */
+  if (!had_err) {
+    shm = gt_sharded_hashmap_new(GT_HASH_DIRECT, NULL, NULL, 0);
+    for (i = 1000; i > 0; i--)
+      gt_sharded_hashmap_add(shm, (void*) i, (void*) (i + 1));
+    for (i = 1; i <= 1000; i++)
+      gt_sharded_hashmap_add(shm, (void*) i, (void*) i);
+    gt_ensure(gt_sharded_hashmap_get_or_add(shm, (void*) 1, (void*) 7)
+              == (void*) 1);
+    gt_ensure(gt_sharded_hashmap_size(shm) == 1000UL);
+    gt_ensure(!gt_sharded_hashmap_foreach_in_key_order(shm,
+                                                   sharded_hashmap_test_visit,
+                                                   &last, err));
+    gt_ensure(last == 1000UL);
+    gt_sharded_hashmap_delete(shm);
+  }
+
+  /* concurrent insertion */
+  if (!had_err) {
+    shm = gt_sharded_hashmap_new(GT_HASH_DIRECT, NULL, NULL, 3);
+    info.shm = shm;
+    info.mutex = gt_mutex_new();
+    info.next_thread_num = 0;
+    info.failed = false;
+    had_err = gt_multithread(sharded_hashmap_test_thread, &info, err);
+    gt_ensure(!info.failed);
+    gt_ensure(gt_sharded_hashmap_size(shm) ==
+              (info.next_thread_num + 1) * SHARDED_HASHMAP_TEST_PERTHREAD);
+    gt_mutex_delete(info.mutex);
+    gt_sharded_hashmap_delete(shm);
+  }
+  return had_err;
+}
@@ -0,0 +1,84 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef SHARDED_HASHMAP_H
+#define SHARDED_HASHMAP_H
+
+#include "core/hashmap_api.h"
+
+/* A <GtShardedHashmap> offers the interface of a <GtHashmap>, but splits its
+   members over a number of independent hash tables (shards), each with its
+   own lock. The shard of a key is determined by the upper bits of its hash
+   value. Threads working on keys in different shards therefore do not
+   contend for the same lock, which makes the map suitable for tables which
+   are filled or queried by several threads at once. Iteration visits the
+   shards one after another. */
+typedef struct GtShardedHashmap GtShardedHashmap;
+
+/* Creates a new <GtShardedHashmap> with 2^<shard_log> shards (a default
+   depending on the number of threads is used if <shard_log> is 0). The other
+   arguments are the same as for <gt_hashmap_new()>. */
+GtShardedHashmap* gt_sharded_hashmap_new(GtHashType keyhashtype,
+                                         GtFree keyfree, GtFree valuefree,
+                                         unsigned int shard_log);
+/* Increase the reference count of <shm>. */
+GtShardedHashmap* gt_sharded_hashmap_ref(GtShardedHashmap *shm);
+/* Return the value stored in <shm> for <key> or NULL if no such key exists. */
+void*             gt_sharded_hashmap_get(GtShardedHashmap *shm,
+                                         const void *key);
+/* Set the value stored in <shm> for <key> to <value>, overwriting the prior
+   value for that key if present. */
+void              gt_sharded_hashmap_add(GtShardedHashmap *shm, void *key,
+                                         void *value);
+/* Return the value stored in <shm> for <key>. If there is no such key, <key>
+   is added with <value>, which is returned. Lookup and insertion happen
+   atomically, such that concurrent callers with equal keys agree on the
+   value. */
+void*             gt_sharded_hashmap_get_or_add(GtShardedHashmap *shm,
+                                                void *key, void *value);
+/* Remove the member with key <key> from <shm>. */
+void              gt_sharded_hashmap_remove(GtShardedHashmap *shm,
+                                            const void *key);
+/* Return the number of members of <shm>. */
+GtUword           gt_sharded_hashmap_size(GtShardedHashmap *shm);
+/* Iterate over <shm> in arbitrary order, see <gt_hashmap_foreach()>. */
+int               gt_sharded_hashmap_foreach(GtShardedHashmap *shm,
+                                             GtHashmapVisitFunc func,
+                                             void *data, GtError *err);
+/* Iterate over <shm> in the order given by <cmp>, see
+   <gt_hashmap_foreach_ordered()>. */
+int               gt_sharded_hashmap_foreach_ordered(GtShardedHashmap *shm,
+                                                     GtHashmapVisitFunc func,
+                                                     void *data,
+                                                     GtCompare cmp,
+                                                     GtError *err);
+/* Iterate over <shm> in key order, see
+   <gt_hashmap_foreach_in_key_order()>. */
+int               gt_sharded_hashmap_foreach_in_key_order(
+                                                       GtShardedHashmap *shm,
+                                                       GtHashmapVisitFunc func,
+                                                       void *data,
+                                                       GtError *err);
+/* Reset <shm> by unsetting values for all keys, calling the free functions
+   if necessary. */
+void              gt_sharded_hashmap_reset(GtShardedHashmap *shm);
+/* Delete <shm>, calling the free functions if necessary. */
+void              gt_sharded_hashmap_delete(GtShardedHashmap *shm);
+
+int               gt_sharded_hashmap_unit_test(GtError *err);
+
+#endif
@@ -16,41 +16,46 @@
 */
 
 #include <string.h>
-#include "core/cstr_table.h"
+#include "core/cstr_api.h"
+#include "core/ma.h"
 #include "core/mathsupport.h"
 #include "core/multithread_api.h"
+#include "core/sharded_hashmap.h"
+#include "core/str_api.h"
 #include "core/symbol.h"
 #include "core/unused_api.h"
 
-static GtCstrTable *symbols = NULL;
-static GtMutex *symbol_mutex = NULL;
+/* the symbols are spread over the shards of the table, such that concurrent
+   lookups of different symbols rarely wait for each other */
+#define SYMBOL_SHARD_LOG 4U
+
+static GtShardedHashmap *symbols = NULL;
 
 void gt_symbol_init(void)
 {
-  if (!symbols)
-    symbols = gt_cstr_table_new();
-  if (!symbol_mutex)
-    symbol_mutex = gt_mutex_new();
+  if (!symbols) {
+    symbols = gt_sharded_hashmap_new(GT_HASH_STRING, gt_free_func, NULL,
+                                     SYMBOL_SHARD_LOG);
+  }
 }
 
 const char* gt_symbol(const char *cstr)
 {
-  const char *symbol;
+  char *symbol, *dup;
   if (!cstr)
     return NULL;
-  gt_mutex_lock(symbol_mutex);
-  if (!(symbol = gt_cstr_table_get(symbols, cstr))) {
-    gt_cstr_table_add(symbols, cstr);
-    symbol = gt_cstr_table_get(symbols, cstr);
+  if (!(symbol = gt_sharded_hashmap_get(symbols, cstr))) {
+    dup = gt_cstr_dup(cstr);
+    symbol = gt_sharded_hashmap_get_or_add(symbols, dup, dup);
+    if (symbol != dup) /* added by another thread in the meantime */
+      gt_free(dup);
   }
-  gt_mutex_unlock(symbol_mutex);
   return symbol;
 }
 
 void gt_symbol_clean(void)
 {
-  gt_cstr_table_delete(symbols);
-  gt_mutex_delete(symbol_mutex);
+  gt_sharded_hashmap_delete(symbols);
 }
 
 /* we use randomly generated numbers to test the symbol mechanism */
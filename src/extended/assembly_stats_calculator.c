@@ -72,6 +72,29 @@ void gt_assembly_stats_calculator_add(GtAssemblyStatsCalculator *asc,
     asc->maxlength = length;
 }
 
+static void gt_assembly_stats_calculator_add_lengths(GtUword key,
+    GtUint64 value, void *data)
+{
+  GtAssemblyStatsCalculator *asc = data;
+  gt_disc_distri_add_multi(asc->lengths, key, value);
+}
+
+void gt_assembly_stats_calculator_merge(GtAssemblyStatsCalculator *asc,
+    const GtAssemblyStatsCalculator *other)
+{
+  gt_assert(asc != NULL && other != NULL);
+  if (other->numofseq == 0)
+    return;
+  gt_disc_distri_foreach(other->lengths,
+      gt_assembly_stats_calculator_add_lengths, asc);
+  asc->numofseq += other->numofseq;
+  asc->sumlength += other->sumlength;
+  if (asc->minlength == 0 || other->minlength < asc->minlength)
+    asc->minlength = other->minlength;
+  if (other->maxlength > asc->maxlength)
+    asc->maxlength = other->maxlength;
+}
+
 void gt_assembly_stats_calculator_set_genome_length(
     GtAssemblyStatsCalculator *asc, GtUword genome_length)
 {
@@ -40,6 +40,12 @@ void                       gt_assembly_stats_calculator_add(
                                                 GtAssemblyStatsCalculator *asc,
                                                 GtUword length);
 
+/* Add to the GtAssemblyStatsCalculator <asc> all sequence lengths added to
+   the GtAssemblyStatsCalculator <other> */
+void                       gt_assembly_stats_calculator_merge(
+                                          GtAssemblyStatsCalculator *asc,
+                                          const GtAssemblyStatsCalculator *other);
+
 /* Compute the N statistics <n> for the GtAssemblyStatsCalculator <asc>;
    <n> is an integer between 0 and 100 (extremes excluded);
    e.g. for N50 use n = 50 */
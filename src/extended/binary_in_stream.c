@@ -0,0 +1,694 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include "core/class_alloc_lock.h"
+#include "core/file_api.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/str_array_api.h"
+#include "extended/binary_in_stream.h"
+#include "extended/binary_stream_format.h"
+#include "extended/comment_node_api.h"
+#include "extended/eof_node_api.h"
+#include "extended/feature_node.h"
+#include "extended/genome_node.h"
+#include "extended/meta_node_api.h"
+#include "extended/node_stream_api.h"
+#include "extended/region_node_api.h"
+#include "extended/sequence_node_api.h"
+
+#define BINARY_IN_STREAM_BUFSIZE  (1UL << 16)
+
+typedef struct {
+  GtUword parent,
+          child;
+  bool is_reference; /* <child> has been added to another parent before */
+} BinaryInStreamEdge;
+
+struct GtBinaryInStream {
+  const GtNodeStream parent_instance;
+  GtStrArray *files;
+  GtUword next_file;
+  GtFile *fp;
+  const char *filename;
+  bool file_is_open;
+  unsigned char *buf;
+  GtUword pos,
+          len;
+  GtArray *strings;  /* the string table of the current file (GtStr*) */
+  GtStr *value,
+        *data;
+  GtArray *nodes,    /* feature nodes of the current tree (GtFeatureNode*) */
+          *edges;    /* BinaryInStreamEdge */
+};
+
+#define binary_in_stream_cast(NS)\
+        gt_node_stream_cast(gt_binary_in_stream_class(), NS)
+
+static void binary_in_stream_error_corrupt(GtBinaryInStream *bis,
+                                           GtError *err)
+{
+  gt_assert(bis);
+  gt_error_set(err, "file \"%s\": corrupt binary node stream", bis->filename);
+}
+
+/* Returns the number of bytes which can be read from <bis->buf>, 0 at the end
+   of the file. */
+static GtUword binary_in_stream_fill(GtBinaryInStream *bis)
+{
+  int rval;
+  gt_assert(bis);
+  if (bis->pos == bis->len) {
+    rval = gt_file_xread(bis->fp, bis->buf, BINARY_IN_STREAM_BUFSIZE);
+    bis->pos = 0;
+    bis->len = rval > 0 ? (GtUword) rval : 0;
+  }
+  return bis->len - bis->pos;
+}
+
+static int binary_in_stream_read_byte(GtBinaryInStream *bis,
+                                      unsigned char *byte, GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(bis && byte);
+  if (bis->pos == bis->len && !binary_in_stream_fill(bis)) {
+    gt_error_set(err, "file \"%s\": unexpected end of binary node stream",
+                 bis->filename);
+    return -1;
+  }
+  *byte = bis->buf[bis->pos++];
+  return 0;
+}
+
+static int binary_in_stream_read_uword(GtBinaryInStream *bis, GtUword *value,
+                                       GtError *err)
+{
+  unsigned char byte;
+  unsigned int shift = 0;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(bis && value);
+  *value = 0;
+  do {
+    if (bis->pos < bis->len)
+      byte = bis->buf[bis->pos++];
+    else if ((had_err = binary_in_stream_read_byte(bis, &byte, err)))
+      break;
+    if (shift >= sizeof (GtUword) * CHAR_BIT) {
+      binary_in_stream_error_corrupt(bis, err);
+      had_err = -1;
+      break;
+    }
+    *value |= ((GtUword) (byte & 127)) << shift;
+    shift += 7;
+  } while (byte & 128);
+  return had_err;
+}
+
+static int binary_in_stream_read_float(GtBinaryInStream *bis, float *value,
+                                       GtError *err)
+{
+  unsigned char byte;
+  uint32_t bits = 0;
+  int i, had_err = 0;
+  gt_error_check(err);
+  gt_assert(bis && value);
+  for (i = 0; !had_err && i < 4; i++) {
+    had_err = binary_in_stream_read_byte(bis, &byte, err);
+    bits |= ((uint32_t) byte) << (8 * i);
+  }
+  memcpy(value, &bits, sizeof *value);
+  return had_err;
+}
+
+static int binary_in_stream_read_bytes(GtBinaryInStream *bis, GtStr *str,
+                                       GtUword length, GtError *err)
+{
+  GtUword available;
+  gt_error_check(err);
+  gt_assert(bis && str);
+  gt_str_reset(str);
+  while (length) {
+    if (!(available = binary_in_stream_fill(bis))) {
+      gt_error_set(err, "file \"%s\": unexpected end of binary node stream",
+                   bis->filename);
+      return -1;
+    }
+    available = MIN(available, length);
+    gt_str_append_cstr_nt(str, (const char*) bis->buf + bis->pos, available);
+    bis->pos += available;
+    length -= available;
+  }
+  return 0;
+}
+
+static int binary_in_stream_read_string(GtBinaryInStream *bis, GtStr *str,
+                                        GtError *err)
+{
+  GtUword length;
+  int had_err;
+  gt_error_check(err);
+  had_err = binary_in_stream_read_uword(bis, &length, err);
+  if (!had_err)
+    had_err = binary_in_stream_read_bytes(bis, str, length, err);
+  return had_err;
+}
+
+/* Reads the index of an interned string and stores the string in <str>. */
+static int binary_in_stream_read_string_id(GtBinaryInStream *bis, GtStr **str,
+                                           GtError *err)
+{
+  GtUword id;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(bis && str);
+  had_err = binary_in_stream_read_uword(bis, &id, err);
+  if (!had_err && id >= gt_array_size(bis->strings)) {
+    binary_in_stream_error_corrupt(bis, err);
+    had_err = -1;
+  }
+  if (!had_err)
+    *str = *(GtStr**) gt_array_get(bis->strings, id);
+  return had_err;
+}
+
+static int binary_in_stream_read_range(GtBinaryInStream *bis, GtRange *range,
+                                       GtError *err)
+{
+  GtUword length;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(bis && range);
+  had_err = binary_in_stream_read_uword(bis, &range->start, err);
+  if (!had_err)
+    had_err = binary_in_stream_read_uword(bis, &length, err);
+  if (!had_err && range->start + length < range->start) {
+    binary_in_stream_error_corrupt(bis, err);
+    had_err = -1;
+  }
+  if (!had_err)
+    range->end = range->start + length;
+  return had_err;
+}
+
+static int binary_in_stream_read_origin(GtBinaryInStream *bis, GtGenomeNode *gn,
+                                        GtError *err)
+{
+  GtUword id, line_number = 0;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(bis && gn);
+  had_err = binary_in_stream_read_uword(bis, &id, err);
+  if (!had_err && id) {
+    had_err = binary_in_stream_read_uword(bis, &line_number, err);
+    if (!had_err && (id > gt_array_size(bis->strings) || !line_number ||
+                     line_number > UINT_MAX)) {
+      binary_in_stream_error_corrupt(bis, err);
+      had_err = -1;
+    }
+    if (!had_err) {
+      gt_genome_node_set_origin(gn, *(GtStr**) gt_array_get(bis->strings,
+                                                            id - 1),
+                                (unsigned int) line_number);
+    }
+  }
+  return had_err;
+}
+
+static int binary_in_stream_read_feature_node(GtBinaryInStream *bis,
+                                              GtFeatureNode **fn,
+                                              GtStr *seqid, bool top_level,
+                                              GtError *err)
+{
+  GtGenomeNode *gn = NULL;
+  GtStr *type = NULL, *source = NULL, *tag;
+  GtRange range;
+  GtUword i, num_of_attributes = 0;
+  unsigned char flags = 0, strand_and_phase = 0;
+  float score = 0.0;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(bis && fn && seqid);
+
+  had_err = binary_in_stream_read_byte(bis, &flags, err);
+  if (!had_err && (flags & GT_BINARY_STREAM_PSEUDO) && !top_level) {
+    binary_in_stream_error_corrupt(bis, err);
+    had_err = -1;
+  }
+  if (!had_err && !(flags & GT_BINARY_STREAM_PSEUDO))
+    had_err = binary_in_stream_read_string_id(bis, &type, err);
+  if (!had_err)
+    had_err = binary_in_stream_read_range(bis, &range, err);
+  if (!had_err)
+    had_err = binary_in_stream_read_byte(bis, &strand_and_phase, err);
+  if (!had_err && (strand_and_phase >> 4)) {
+    binary_in_stream_error_corrupt(bis, err);
+    had_err = -1;
+  }
+  if (!had_err && (flags & GT_BINARY_STREAM_SCORE))
+    had_err = binary_in_stream_read_float(bis, &score, err);
+  if (!had_err && (flags & GT_BINARY_STREAM_SOURCE))
+    had_err = binary_in_stream_read_string_id(bis, &source, err);
+
+  if (!had_err) {
+    if (flags & GT_BINARY_STREAM_PSEUDO) {
+      gn = gt_feature_node_new_pseudo(seqid, range.start, range.end,
+                                      strand_and_phase & 3);
+    }
+    else {
+      gn = gt_feature_node_new(seqid, gt_str_get(type), range.start,
+                               range.end, strand_and_phase & 3);
+      gt_feature_node_set_phase((GtFeatureNode*) gn, strand_and_phase >> 2);
+    }
+    if (flags & GT_BINARY_STREAM_SCORE)
+      gt_feature_node_set_score((GtFeatureNode*) gn, score);
+    if (source)
+      gt_feature_node_set_source((GtFeatureNode*) gn, source);
+    had_err = binary_in_stream_read_origin(bis, gn, err);
+  }
+
+  if (!had_err)
+    had_err = binary_in_stream_read_uword(bis, &num_of_attributes, err);
+  for (i = 0; !had_err && i < num_of_attributes; i++) {
+    had_err = binary_in_stream_read_string_id(bis, &tag, err);
+    if (!had_err)
+      had_err = binary_in_stream_read_string(bis, bis->value, err);
+    if (!had_err && (!*gt_str_get(tag) || !*gt_str_get(bis->value) ||
+                     gt_feature_node_get_attribute((GtFeatureNode*) gn,
+                                                   gt_str_get(tag)))) {
+      binary_in_stream_error_corrupt(bis, err);
+      had_err = -1;
+    }
+    if (!had_err) {
+      gt_feature_node_add_attribute((GtFeatureNode*) gn, gt_str_get(tag),
+                                    gt_str_get(bis->value));
+    }
+  }
+
+  if (had_err) {
+    gt_genome_node_delete(gn);
+    gn = NULL;
+  }
+  *fn = (GtFeatureNode*) gn;
+  return had_err;
+}
+
+#define BINARY_IN_STREAM_UNVISITED 0
+#define BINARY_IN_STREAM_ON_STACK  1
+#define BINARY_IN_STREAM_FINISHED  2
+
+/* Returns true if the edges read into <bis> contain a cycle. The nodes are
+   visited depth-first from the top-level node, which reaches all of them. An
+   edge to a node which is still on the stack closes a cycle. */
+static bool binary_in_stream_has_cycle(GtBinaryInStream *bis,
+                                       GtUword num_of_nodes)
+{
+  BinaryInStreamEdge *edges = gt_array_get_space(bis->edges);
+  GtUword num_of_edges = gt_array_size(bis->edges), *next_edge, *stack,
+          stack_size = 0, node, child, i;
+  unsigned char *state;
+  bool has_cycle = false;
+
+  /* the edges are ordered by their parents, <next_edge> of a node points to
+     its first edge not followed yet */
+  next_edge = gt_malloc(sizeof (*next_edge) * num_of_nodes);
+  for (i = 0; i < num_of_nodes; i++)
+    next_edge[i] = num_of_edges;
+  for (i = num_of_edges; i > 0; i--)
+    next_edge[edges[i-1].parent] = i - 1;
+  state = gt_calloc((size_t) num_of_nodes, sizeof (*state));
+  stack = gt_malloc(sizeof (*stack) * num_of_nodes);
+
+  stack[stack_size++] = 0;
+  state[0] = BINARY_IN_STREAM_ON_STACK;
+  while (!has_cycle && stack_size > 0) {
+    node = stack[stack_size-1];
+    i = next_edge[node];
+    if (i < num_of_edges && edges[i].parent == node) {
+      next_edge[node]++;
+      child = edges[i].child;
+      if (state[child] == BINARY_IN_STREAM_ON_STACK)
+        has_cycle = true;
+      else if (state[child] == BINARY_IN_STREAM_UNVISITED) {
+        state[child] = BINARY_IN_STREAM_ON_STACK;
+        stack[stack_size++] = child;
+      }
+    }
+    else {
+      state[node] = BINARY_IN_STREAM_FINISHED;
+      stack_size--;
+    }
+  }
+
+  gt_free(stack);
+  gt_free(state);
+  gt_free(next_edge);
+  return has_cycle;
+}
+
+static int binary_in_stream_read_feature(GtBinaryInStream *bis,
+                                         GtGenomeNode **gn, GtError *err)
+{
+  GtFeatureNode *fn, *parent, *child;
+  GtStr *seqid = NULL;
+  BinaryInStreamEdge edge;
+  GtUword i, j, num_of_nodes = 1, num_of_children, num_of_multi_nodes = 0,
+          idx, rep_idx;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(bis && gn);
+
+  had_err = binary_in_stream_read_string_id(bis, &seqid, err);
+
+  /* read the nodes and their edges, <num_of_nodes> grows while reading */
+  for (i = 0; !had_err && i < num_of_nodes; i++) {
+    had_err = binary_in_stream_read_feature_node(bis, &fn, seqid, !i, err);
+    if (!had_err) {
+      gt_array_add(bis->nodes, fn);
+      had_err = binary_in_stream_read_uword(bis, &num_of_children, err);
+    }
+    for (j = 0; !had_err && j < num_of_children; j++) {
+      had_err = binary_in_stream_read_uword(bis, &edge.child, err);
+      if (!had_err) {
+        edge.parent = i;
+        if (!edge.child) {
+          edge.child = num_of_nodes++;
+          edge.is_reference = false;
+        }
+        else if (--edge.child && edge.child < num_of_nodes)
+          edge.is_reference = true;
+        else {
+          /* the top-level node cannot be a child */
+          binary_in_stream_error_corrupt(bis, err);
+          had_err = -1;
+        }
+      }
+      if (!had_err)
+        gt_array_add(bis->edges, edge);
+    }
+  }
+
+  /* references to earlier nodes must not close a cycle */
+  if (!had_err && binary_in_stream_has_cycle(bis, num_of_nodes)) {
+    binary_in_stream_error_corrupt(bis, err);
+    had_err = -1;
+  }
+
+  /* read the multi-features and their representatives */
+  if (!had_err)
+    had_err = binary_in_stream_read_uword(bis, &num_of_multi_nodes, err);
+  for (i = 0; !had_err && i < num_of_multi_nodes; i++) {
+    had_err = binary_in_stream_read_uword(bis, &idx, err);
+    if (!had_err)
+      had_err = binary_in_stream_read_uword(bis, &rep_idx, err);
+    if (!had_err &&
+        (idx >= num_of_nodes || rep_idx >= num_of_nodes ||
+         gt_feature_node_is_pseudo(*(GtFeatureNode**)
+                                   gt_array_get(bis->nodes, idx)) ||
+         gt_feature_node_is_pseudo(*(GtFeatureNode**)
+                                   gt_array_get(bis->nodes, rep_idx)))) {
+      binary_in_stream_error_corrupt(bis, err);
+      had_err = -1;
+    }
+    if (!had_err) {
+      fn = *(GtFeatureNode**) gt_array_get(bis->nodes, idx);
+      parent = *(GtFeatureNode**) gt_array_get(bis->nodes, rep_idx);
+      if (!gt_feature_node_is_multi(parent))
+        gt_feature_node_make_multi_representative(parent);
+      if (fn != parent)
+        gt_feature_node_set_multi_representative(fn, parent);
+    }
+  }
+
+  if (!had_err) {
+    /* build the tree (or DAG) */
+    for (i = 0; i < gt_array_size(bis->edges); i++) {
+      BinaryInStreamEdge *e = gt_array_get(bis->edges, i);
+      parent = *(GtFeatureNode**) gt_array_get(bis->nodes, e->parent);
+      child = *(GtFeatureNode**) gt_array_get(bis->nodes, e->child);
+      if (e->is_reference)
+        gt_genome_node_ref((GtGenomeNode*) child);
+      gt_feature_node_add_child(parent, child);
+    }
+    *gn = *(GtGenomeNode**) gt_array_get(bis->nodes, 0);
+  }
+  else {
+    /* the nodes have not been connected yet */
+    for (i = 0; i < gt_array_size(bis->nodes); i++)
+      gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(bis->nodes, i));
+  }
+  gt_array_reset(bis->nodes);
+  gt_array_reset(bis->edges);
+  return had_err;
+}
+
+static int binary_in_stream_read_region(GtBinaryInStream *bis,
+                                        GtGenomeNode **gn, GtError *err)
+{
+  GtStr *seqid = NULL;
+  GtRange range;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(bis && gn);
+  had_err = binary_in_stream_read_string_id(bis, &seqid, err);
+  if (!had_err)
+    had_err = binary_in_stream_read_range(bis, &range, err);
+  if (!had_err) {
+    *gn = gt_region_node_new(seqid, range.start, range.end);
+    had_err = binary_in_stream_read_origin(bis, *gn, err);
+  }
+  return had_err;
+}
+
+static int binary_in_stream_read_sequence(GtBinaryInStream *bis,
+                                          GtGenomeNode **gn, GtError *err)
+{
+  GtStr *sequence;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(bis && gn);
+  sequence = gt_str_new();
+  had_err = binary_in_stream_read_string(bis, bis->value, err);
+  if (!had_err)
+    had_err = binary_in_stream_read_string(bis, sequence, err);
+  if (!had_err) {
+    *gn = gt_sequence_node_new(gt_str_get(bis->value), sequence);
+    had_err = binary_in_stream_read_origin(bis, *gn, err);
+  }
+  gt_str_delete(sequence);
+  return had_err;
+}
+
+static int binary_in_stream_read_comment(GtBinaryInStream *bis,
+                                         GtGenomeNode **gn, GtError *err)
+{
+  int had_err;
+  gt_error_check(err);
+  gt_assert(bis && gn);
+  had_err = binary_in_stream_read_string(bis, bis->value, err);
+  if (!had_err) {
+    *gn = gt_comment_node_new(gt_str_get(bis->value));
+    had_err = binary_in_stream_read_origin(bis, *gn, err);
+  }
+  return had_err;
+}
+
+static int binary_in_stream_read_meta(GtBinaryInStream *bis, GtGenomeNode **gn,
+                                      GtError *err)
+{
+  GtUword length = 0;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(bis && gn);
+  had_err = binary_in_stream_read_string(bis, bis->value, err);
+  if (!had_err)
+    had_err = binary_in_stream_read_uword(bis, &length, err);
+  /* the length of the data is stored plus one, 0 denotes missing data */
+  if (!had_err && length)
+    had_err = binary_in_stream_read_bytes(bis, bis->data, length - 1, err);
+  if (!had_err) {
+    *gn = gt_meta_node_new(gt_str_get(bis->value),
+                           length ? gt_str_get(bis->data) : NULL);
+    had_err = binary_in_stream_read_origin(bis, *gn, err);
+  }
+  return had_err;
+}
+
+static void binary_in_stream_close_file(GtBinaryInStream *bis)
+{
+  GtUword i;
+  gt_assert(bis);
+  gt_file_delete(bis->fp);
+  bis->fp = NULL;
+  bis->file_is_open = false;
+  for (i = 0; i < gt_array_size(bis->strings); i++)
+    gt_str_delete(*(GtStr**) gt_array_get(bis->strings, i));
+  gt_array_reset(bis->strings);
+}
+
+static int binary_in_stream_open_next_file(GtBinaryInStream *bis, GtError *err)
+{
+  GtStr *magic;
+  unsigned char version = 0;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(bis && !bis->file_is_open);
+  if (gt_str_array_size(bis->files) &&
+      strcmp(gt_str_array_get(bis->files, bis->next_file), "-")) {
+    bis->filename = gt_str_array_get(bis->files, bis->next_file);
+    if (!(bis->fp = gt_file_new(bis->filename, "r", err)))
+      had_err = -1;
+  }
+  else
+    bis->filename = "stdin"; /* <bis->fp> is NULL */
+  bis->next_file++;
+  bis->pos = bis->len = 0;
+  if (!had_err) {
+    bis->file_is_open = true;
+    magic = gt_str_new();
+    if (binary_in_stream_read_bytes(bis, magic, GT_BINARY_STREAM_MAGIC_LENGTH,
+                                    err) ||
+        strcmp(gt_str_get(magic), GT_BINARY_STREAM_MAGIC) ||
+        binary_in_stream_read_byte(bis, &version, err)) {
+      gt_error_unset(err);
+      gt_error_set(err, "file \"%s\" is not a binary node stream",
+                   bis->filename);
+      had_err = -1;
+    }
+    else if (version != GT_BINARY_STREAM_VERSION) {
+      gt_error_set(err, "file \"%s\": unsupported binary node stream version "
+                   "%u (expected %u)", bis->filename, (unsigned int) version,
+                   (unsigned int) GT_BINARY_STREAM_VERSION);
+      had_err = -1;
+    }
+    gt_str_delete(magic);
+  }
+  return had_err;
+}
+
+static int binary_in_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                 GtError *err)
+{
+  GtBinaryInStream *bis;
+  GtStr *string;
+  unsigned char tag;
+  int had_err = 0;
+  gt_error_check(err);
+  bis = binary_in_stream_cast(ns);
+  *gn = NULL;
+
+  while (!had_err && !*gn) {
+    if (!bis->file_is_open) {
+      if (bis->next_file == MAX(gt_str_array_size(bis->files), 1))
+        break; /* all files have been read */
+      had_err = binary_in_stream_open_next_file(bis, err);
+      continue;
+    }
+    if (!binary_in_stream_fill(bis)) {
+      binary_in_stream_close_file(bis);
+      continue;
+    }
+    tag = bis->buf[bis->pos++];
+    switch (tag) {
+      case GT_BINARY_STREAM_STRING:
+        string = gt_str_new();
+        had_err = binary_in_stream_read_string(bis, string, err);
+        gt_array_add(bis->strings, string);
+        break;
+      case GT_BINARY_STREAM_FEATURE:
+        had_err = binary_in_stream_read_feature(bis, gn, err);
+        break;
+      case GT_BINARY_STREAM_REGION:
+        had_err = binary_in_stream_read_region(bis, gn, err);
+        break;
+      case GT_BINARY_STREAM_SEQUENCE:
+        had_err = binary_in_stream_read_sequence(bis, gn, err);
+        break;
+      case GT_BINARY_STREAM_COMMENT:
+        had_err = binary_in_stream_read_comment(bis, gn, err);
+        break;
+      case GT_BINARY_STREAM_META:
+        had_err = binary_in_stream_read_meta(bis, gn, err);
+        break;
+      case GT_BINARY_STREAM_EOF:
+        *gn = gt_eof_node_new();
+        break;
+      default:
+        binary_in_stream_error_corrupt(bis, err);
+        had_err = -1;
+    }
+  }
+
+  if (had_err) {
+    gt_genome_node_delete(*gn);
+    *gn = NULL;
+  }
+  return had_err;
+}
+
+static void binary_in_stream_free(GtNodeStream *ns)
+{
+  GtBinaryInStream *bis = binary_in_stream_cast(ns);
+  binary_in_stream_close_file(bis);
+  gt_str_array_delete(bis->files);
+  gt_free(bis->buf);
+  gt_array_delete(bis->strings);
+  gt_str_delete(bis->value);
+  gt_str_delete(bis->data);
+  gt_array_delete(bis->nodes);
+  gt_array_delete(bis->edges);
+}
+
+const GtNodeStreamClass* gt_binary_in_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtBinaryInStream),
+                                   binary_in_stream_free,
+                                   binary_in_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_binary_in_stream_new(int num_of_files,
+                                      const char **filenames)
+{
+  GtNodeStream *ns = gt_node_stream_create(gt_binary_in_stream_class(), false);
+  GtBinaryInStream *bis = binary_in_stream_cast(ns);
+  int i;
+  gt_assert(num_of_files >= 0);
+  bis->files = gt_str_array_new();
+  for (i = 0; i < num_of_files; i++)
+    gt_str_array_add_cstr(bis->files, filenames[i]);
+  bis->next_file = 0;
+  bis->fp = NULL;
+  bis->filename = NULL;
+  bis->file_is_open = false;
+  bis->buf = gt_malloc(BINARY_IN_STREAM_BUFSIZE);
+  bis->pos = bis->len = 0;
+  bis->strings = gt_array_new(sizeof (GtStr*));
+  bis->value = gt_str_new();
+  bis->data = gt_str_new();
+  bis->nodes = gt_array_new(sizeof (GtFeatureNode*));
+  bis->edges = gt_array_new(sizeof (BinaryInStreamEdge));
+  return ns;
+}
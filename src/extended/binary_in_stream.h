@@ -0,0 +1,35 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef BINARY_IN_STREAM_H
+#define BINARY_IN_STREAM_H
+
+#include "extended/node_stream_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtBinaryInStream> reads the
+   nodes written by a <GtBinaryOutStream>. The nodes are neither parsed nor
+   checked again, in particular the types of the features are not checked. */
+typedef struct GtBinaryInStream GtBinaryInStream;
+
+const GtNodeStreamClass* gt_binary_in_stream_class(void);
+/* Create a <GtBinaryInStream*> which reads the <num_of_files> binary node
+   stream files given in <filenames> one after another. If <num_of_files> is 0
+   or a filename is "-", stdin is read. The resulting stream is not considered to be sorted. */
+GtNodeStream* gt_binary_in_stream_new(int num_of_files,
+                                      const char **filenames);
+
+#endif
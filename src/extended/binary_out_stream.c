@@ -0,0 +1,398 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <stdint.h>
+#include <string.h>
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/hashmap.h"
+#include "core/ma.h"
+#include "core/str.h"
+#include "extended/binary_out_stream.h"
+#include "extended/binary_stream_format.h"
+#include "extended/comment_node_api.h"
+#include "extended/eof_node_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/genome_node.h"
+#include "extended/meta_node_api.h"
+#include "extended/node_stream_api.h"
+#include "extended/region_node_api.h"
+#include "extended/sequence_node_api.h"
+
+#define BINARY_OUT_STREAM_BUFSIZE  (1UL << 16)
+
+struct GtBinaryOutStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+  GtFile *outfp;
+  GtHashmap *string_ids; /* string -> index in the string table plus one */
+  GtUword num_of_strings;
+  GtStr *outbuf,         /* records not written to <outfp> yet */
+        *strings,        /* string records for the current record */
+        *record,         /* the current record */
+        *attributes;     /* attributes of the current feature node */
+  GtUword num_of_attributes;
+  GtArray *nodes,        /* feature nodes in breadth-first order */
+          *multi_nodes;  /* multi-features of the current tree */
+  GtHashmap *node_ids;   /* feature node -> index in <nodes> plus one */
+};
+
+#define binary_out_stream_cast(NS)\
+        gt_node_stream_cast(gt_binary_out_stream_class(), NS)
+
+static void append_uword(GtStr *buf, GtUword value)
+{
+  while (value >= 128) {
+    gt_str_append_char(buf, (char) ((value & 127) | 128));
+    value >>= 7;
+  }
+  gt_str_append_char(buf, (char) value);
+}
+
+static void append_string(GtStr *buf, const char *string, GtUword length)
+{
+  append_uword(buf, length);
+  gt_str_append_cstr_nt(buf, string, length);
+}
+
+static void append_float(GtStr *buf, float value)
+{
+  uint32_t bits;
+  int i;
+  gt_assert(sizeof bits == sizeof value);
+  memcpy(&bits, &value, sizeof bits);
+  for (i = 0; i < 4; i++) {
+    gt_str_append_char(buf, (char) (bits & 255));
+    bits >>= 8;
+  }
+}
+
+/* Returns the index of <string> in the string table. A string record is added
+   to <bos->strings> if <string> is not in the table yet. */
+static GtUword binary_out_stream_string_id(GtBinaryOutStream *bos,
+                                           const char *string)
+{
+  GtUword id;
+  gt_assert(bos && string);
+  if (!(id = (GtUword) gt_hashmap_get(bos->string_ids, string))) {
+    id = ++bos->num_of_strings;
+    gt_hashmap_add(bos->string_ids, gt_cstr_dup(string), (void*) id);
+    gt_str_append_char(bos->strings, GT_BINARY_STREAM_STRING);
+    append_string(bos->strings, string, strlen(string));
+  }
+  return id - 1;
+}
+
+static void binary_out_stream_append_origin(GtBinaryOutStream *bos,
+                                            GtGenomeNode *gn)
+{
+  unsigned int line_number;
+  gt_assert(bos && gn);
+  if ((line_number = gt_genome_node_get_line_number(gn))) {
+    append_uword(bos->record, binary_out_stream_string_id(bos,
+                                            gt_genome_node_get_filename(gn))
+                              + 1);
+    append_uword(bos->record, line_number);
+  }
+  else
+    append_uword(bos->record, 0);
+}
+
+/* Moves the current record and the strings it needs to the output buffer and
+   writes the output buffer if it is full (or if <force> is true). */
+static void binary_out_stream_finish_record(GtBinaryOutStream *bos, bool force)
+{
+  gt_assert(bos);
+  gt_str_append_str(bos->outbuf, bos->strings);
+  gt_str_append_str(bos->outbuf, bos->record);
+  gt_str_reset(bos->strings);
+  gt_str_reset(bos->record);
+  if (gt_str_length(bos->outbuf) &&
+      (force || gt_str_length(bos->outbuf) >= BINARY_OUT_STREAM_BUFSIZE)) {
+    gt_file_xwrite(bos->outfp, gt_str_get_mem(bos->outbuf),
+                   gt_str_length(bos->outbuf));
+    gt_str_reset(bos->outbuf);
+  }
+}
+
+static void append_attribute(const char *attr_name, const char *attr_value,
+                             void *data)
+{
+  GtBinaryOutStream *bos = data;
+  gt_assert(attr_name && attr_value && bos);
+  append_uword(bos->attributes, binary_out_stream_string_id(bos, attr_name));
+  append_string(bos->attributes, attr_value, strlen(attr_value));
+  bos->num_of_attributes++;
+}
+
+static void binary_out_stream_append_feature(GtBinaryOutStream *bos,
+                                             GtFeatureNode *fn)
+{
+  GtRange range;
+  unsigned char flags = 0;
+  gt_assert(bos && fn);
+  if (gt_feature_node_is_pseudo(fn))
+    flags |= GT_BINARY_STREAM_PSEUDO;
+  if (gt_feature_node_score_is_defined(fn))
+    flags |= GT_BINARY_STREAM_SCORE;
+  if (gt_feature_node_has_source(fn))
+    flags |= GT_BINARY_STREAM_SOURCE;
+  gt_str_append_char(bos->record, (char) flags);
+  if (!(flags & GT_BINARY_STREAM_PSEUDO)) {
+    append_uword(bos->record,
+                 binary_out_stream_string_id(bos,
+                                             gt_feature_node_get_type(fn)));
+  }
+  range = gt_genome_node_get_range((GtGenomeNode*) fn);
+  append_uword(bos->record, range.start);
+  append_uword(bos->record, range.end - range.start);
+  gt_str_append_char(bos->record,
+                     (char) (gt_feature_node_get_strand(fn) |
+                             (gt_feature_node_get_phase(fn) << 2)));
+  if (flags & GT_BINARY_STREAM_SCORE)
+    append_float(bos->record, gt_feature_node_get_score(fn));
+  if (flags & GT_BINARY_STREAM_SOURCE) {
+    append_uword(bos->record,
+                 binary_out_stream_string_id(bos,
+                                             gt_feature_node_get_source(fn)));
+  }
+  binary_out_stream_append_origin(bos, (GtGenomeNode*) fn);
+  gt_str_reset(bos->attributes);
+  bos->num_of_attributes = 0;
+  gt_feature_node_foreach_attribute(fn, append_attribute, bos);
+  append_uword(bos->record, bos->num_of_attributes);
+  gt_str_append_str(bos->record, bos->attributes);
+}
+
+static GtUword binary_out_stream_node_id(GtBinaryOutStream *bos,
+                                         GtFeatureNode *fn)
+{
+  GtUword i;
+  gt_assert(bos && fn);
+  if (bos->node_ids)
+    return (GtUword) gt_hashmap_get(bos->node_ids, fn);
+  for (i = 0; i < gt_array_size(bos->nodes); i++) {
+    if (*(GtFeatureNode**) gt_array_get(bos->nodes, i) == fn)
+      return i + 1;
+  }
+  return 0;
+}
+
+static void binary_out_stream_feature_node(GtBinaryOutStream *bos,
+                                           GtFeatureNode *fn)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *node, *child;
+  GtUword i, num_of_children, id;
+  gt_assert(bos && fn);
+
+  gt_str_append_char(bos->record, GT_BINARY_STREAM_FEATURE);
+  append_uword(bos->record,
+               binary_out_stream_string_id(bos,
+                                           gt_str_get(gt_genome_node_get_seqid(
+                                                       (GtGenomeNode*) fn))));
+
+  /* in a DAG a node can be reached more than once, it is written only once */
+  if (!gt_feature_node_determine_is_tree(fn)) {
+    bos->node_ids = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+    gt_hashmap_add(bos->node_ids, fn, (void*) 1);
+  }
+
+  /* breadth-first traversal, <nodes> grows while it is traversed */
+  gt_array_add(bos->nodes, fn);
+  for (i = 0; i < gt_array_size(bos->nodes); i++) {
+    node = *(GtFeatureNode**) gt_array_get(bos->nodes, i);
+    binary_out_stream_append_feature(bos, node);
+    if (gt_feature_node_is_multi(node))
+      gt_array_add(bos->multi_nodes, i);
+    num_of_children = gt_feature_node_number_of_children(node);
+    append_uword(bos->record, num_of_children);
+    if (!num_of_children)
+      continue;
+    fni = gt_feature_node_iterator_new_direct(node);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      if (bos->node_ids && (id = (GtUword) gt_hashmap_get(bos->node_ids,
+                                                          child))) {
+        append_uword(bos->record, id);
+        continue;
+      }
+      gt_array_add(bos->nodes, child);
+      if (bos->node_ids) {
+        gt_hashmap_add(bos->node_ids, child,
+                       (void*) gt_array_size(bos->nodes));
+      }
+      append_uword(bos->record, 0);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+
+  /* multi-features and their representatives */
+  append_uword(bos->record, gt_array_size(bos->multi_nodes));
+  for (i = 0; i < gt_array_size(bos->multi_nodes); i++) {
+    GtUword idx = *(GtUword*) gt_array_get(bos->multi_nodes, i);
+    node = *(GtFeatureNode**) gt_array_get(bos->nodes, idx);
+    id = binary_out_stream_node_id(bos,
+                                   gt_feature_node_get_multi_representative(
+                                                                        node));
+    append_uword(bos->record, idx);
+    /* a representative outside of the tree is not kept */
+    append_uword(bos->record, id ? id - 1 : idx);
+  }
+
+  gt_array_reset(bos->nodes);
+  gt_array_reset(bos->multi_nodes);
+  gt_hashmap_delete(bos->node_ids);
+  bos->node_ids = NULL;
+}
+
+static int binary_out_stream_write(GtBinaryOutStream *bos, GtGenomeNode *gn,
+                                   GtError *err)
+{
+  GtFeatureNode *fn;
+  GtRegionNode *rn;
+  GtSequenceNode *sn;
+  GtCommentNode *cn;
+  GtMetaNode *mn;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(bos && gn);
+
+  if ((fn = gt_feature_node_try_cast(gn)))
+    binary_out_stream_feature_node(bos, fn);
+  else if ((rn = gt_region_node_try_cast(gn))) {
+    GtRange range = gt_genome_node_get_range(gn);
+    gt_str_append_char(bos->record, GT_BINARY_STREAM_REGION);
+    append_uword(bos->record,
+                 binary_out_stream_string_id(bos,
+                                      gt_str_get(gt_genome_node_get_seqid(gn))));
+    append_uword(bos->record, range.start);
+    append_uword(bos->record, range.end - range.start);
+    binary_out_stream_append_origin(bos, gn);
+  }
+  else if ((sn = gt_sequence_node_try_cast(gn))) {
+    const char *description = gt_sequence_node_get_description(sn);
+    gt_str_append_char(bos->record, GT_BINARY_STREAM_SEQUENCE);
+    append_string(bos->record, description, strlen(description));
+    append_string(bos->record, gt_sequence_node_get_sequence(sn),
+                  gt_sequence_node_get_sequence_length(sn));
+    binary_out_stream_append_origin(bos, gn);
+  }
+  else if ((cn = gt_comment_node_try_cast(gn))) {
+    const char *comment = gt_comment_node_get_comment(cn);
+    gt_str_append_char(bos->record, GT_BINARY_STREAM_COMMENT);
+    append_string(bos->record, comment, strlen(comment));
+    binary_out_stream_append_origin(bos, gn);
+  }
+  else if ((mn = gt_meta_node_try_cast(gn))) {
+    const char *directive = gt_meta_node_get_directive(mn),
+               *data = gt_meta_node_get_data(mn);
+    gt_str_append_char(bos->record, GT_BINARY_STREAM_META);
+    append_string(bos->record, directive, strlen(directive));
+    /* the length of the data is stored plus one, 0 denotes missing data */
+    if (data) {
+      append_uword(bos->record, strlen(data) + 1);
+      gt_str_append_cstr(bos->record, data);
+    }
+    else
+      append_uword(bos->record, 0);
+    binary_out_stream_append_origin(bos, gn);
+  }
+  else if (gt_eof_node_try_cast(gn))
+    gt_str_append_char(bos->record, GT_BINARY_STREAM_EOF);
+  else {
+    gt_error_set(err, "cannot write node from file \"%s\", line %u in binary "
+                 "format (unknown node type)", gt_genome_node_get_filename(gn),
+                 gt_genome_node_get_line_number(gn));
+    had_err = -1;
+  }
+
+  if (!had_err)
+    binary_out_stream_finish_record(bos, false);
+  return had_err;
+}
+
+static int binary_out_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                  GtError *err)
+{
+  GtBinaryOutStream *bos;
+  int had_err;
+  gt_error_check(err);
+  bos = binary_out_stream_cast(ns);
+  had_err = gt_node_stream_next(bos->in_stream, gn, err);
+  if (!had_err) {
+    if (*gn)
+      had_err = binary_out_stream_write(bos, *gn, err);
+    else
+      binary_out_stream_finish_record(bos, true);
+  }
+  return had_err;
+}
+
+static void binary_out_stream_free(GtNodeStream *ns)
+{
+  GtBinaryOutStream *bos = binary_out_stream_cast(ns);
+  gt_str_reset(bos->strings);
+  gt_str_reset(bos->record);
+  binary_out_stream_finish_record(bos, true);
+  gt_node_stream_delete(bos->in_stream);
+  gt_file_delete(bos->outfp);
+  gt_hashmap_delete(bos->string_ids);
+  gt_str_delete(bos->outbuf);
+  gt_str_delete(bos->strings);
+  gt_str_delete(bos->record);
+  gt_str_delete(bos->attributes);
+  gt_array_delete(bos->nodes);
+  gt_array_delete(bos->multi_nodes);
+}
+
+const GtNodeStreamClass* gt_binary_out_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtBinaryOutStream),
+                                   binary_out_stream_free,
+                                   binary_out_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_binary_out_stream_new(GtNodeStream *in_stream, GtFile *outfp)
+{
+  GtNodeStream *ns = gt_node_stream_create(gt_binary_out_stream_class(),
+                                           gt_node_stream_is_sorted(in_stream));
+  GtBinaryOutStream *bos = binary_out_stream_cast(ns);
+  bos->in_stream = gt_node_stream_ref(in_stream);
+  bos->outfp = gt_file_ref(outfp);
+  bos->string_ids = gt_hashmap_new(GT_HASH_STRING, gt_free_func, NULL);
+  bos->num_of_strings = 0;
+  bos->outbuf = gt_str_new();
+  bos->strings = gt_str_new();
+  bos->record = gt_str_new();
+  bos->attributes = gt_str_new();
+  bos->num_of_attributes = 0;
+  bos->nodes = gt_array_new(sizeof (GtFeatureNode*));
+  bos->multi_nodes = gt_array_new(sizeof (GtUword));
+  bos->node_ids = NULL;
+  /* the header is written together with the first records */
+  gt_str_append_cstr_nt(bos->outbuf, GT_BINARY_STREAM_MAGIC,
+                        GT_BINARY_STREAM_MAGIC_LENGTH);
+  gt_str_append_char(bos->outbuf, GT_BINARY_STREAM_VERSION);
+  return ns;
+}
@@ -0,0 +1,37 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef BINARY_OUT_STREAM_H
+#define BINARY_OUT_STREAM_H
+
+#include "core/file_api.h"
+#include "extended/node_stream_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtBinaryOutStream> writes the
+   nodes passed through it in a compact binary format (see
+   binary_stream_format.h), which can be read by a <GtBinaryInStream> without
+   parsing and checking the nodes again. */
+typedef struct GtBinaryOutStream GtBinaryOutStream;
+
+const GtNodeStreamClass* gt_binary_out_stream_class(void);
+/* Create a <GtBinaryOutStream*> which uses <in_stream> as input and writes the
+   nodes passed through it to <outfp> (stdout, if <outfp> is NULL).
+   Node types other than feature, region, sequence, comment, meta, and EOF
+   nodes cannot be written and lead to an error. */
+GtNodeStream* gt_binary_out_stream_new(GtNodeStream *in_stream, GtFile *outfp);
+
+#endif
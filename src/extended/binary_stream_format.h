@@ -0,0 +1,69 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef BINARY_STREAM_FORMAT_H
+#define BINARY_STREAM_FORMAT_H
+
+/* Layout of the binary node stream format shared by <GtBinaryOutStream> and
+   <GtBinaryInStream>.
+
+   A file starts with the magic bytes and the format version, followed by a
+   sequence of records. Every record starts with one of the record tags below.
+   Unsigned integers are stored as little endian base-128 varints, strings as
+   their length (varint) followed by their bytes (not terminated), floats as
+   their IEEE 754 bit pattern in four little endian bytes.
+
+   Strings which recur often (sequence IDs, sources, types, attribute tags, and
+   filenames) are interned: A string record defines the next entry of the
+   string table of the file, which is referred to by its index afterwards.
+   String records always precede the first record referring to them.
+
+   A feature record stores a whole feature node tree (or DAG). It consists of
+   the sequence ID followed by the nodes in breadth-first order, the top-level
+   node first. Each node is followed by the number and the list of its
+   children, a child is either 0 (the next new node in breadth-first order) or
+   the index of an already listed node plus one (a child with more than one
+   parent). The record ends with the number of multi-features in the tree and
+   the pairs of indices of each multi-feature and its representative.
+   A single node consists of its flags (one byte), its type (unless it is a
+   pseudo-feature), its start and length minus one, its strand and phase (one
+   byte, the phase in the upper bits), its score and source (if the
+   corresponding flag is set), its origin, and the number of its attributes
+   followed by the interned tag and the value of each attribute.
+
+   The origin of a node is stored as the index of its filename plus one
+   followed by its line number, or as 0 if the node has no origin. */
+
+#define GT_BINARY_STREAM_MAGIC          "GTBNS"
+#define GT_BINARY_STREAM_MAGIC_LENGTH   5
+#define GT_BINARY_STREAM_VERSION        1
+
+/* record tags */
+#define GT_BINARY_STREAM_STRING         'S'
+#define GT_BINARY_STREAM_FEATURE        'F'
+#define GT_BINARY_STREAM_REGION         'R'
+#define GT_BINARY_STREAM_SEQUENCE       'Q'
+#define GT_BINARY_STREAM_COMMENT        'C'
+#define GT_BINARY_STREAM_META           'M'
+#define GT_BINARY_STREAM_EOF            'E'
+
+/* flags of a feature node */
+#define GT_BINARY_STREAM_PSEUDO         1U
+#define GT_BINARY_STREAM_SCORE          2U
+#define GT_BINARY_STREAM_SOURCE         4U
+
+#endif
@@ -63,9 +63,6 @@ GtBitInStream *gt_bitinstream_new(const char* path,
   bitstream->read_bits = 0;
   gt_bitinstream_reinit(bitstream,
                         offset);
-
-  bitstream->bufferlength = (bitstream->pages_to_map * bitstream->pagesize) /
-                            sizeof (*bitstream->bitseqbuffer);
   return bitstream;
 }
 
@@ -81,12 +78,14 @@ void gt_bitinstream_reinit(GtBitInStream *bitstream,
 
   gt_fa_xmunmap(bitstream->bitseqbuffer);
 
+  /* a previous call might have mapped the last chunk */
+  bitstream->last_chunk = false;
   if (bitstream->cur_filepos + mapsize > bitstream->filesize) {
     mapsize = bitstream->filesize - bitstream->cur_filepos;
-    bitstream->bufferlength = (GtUword)  mapsize /
-                                sizeof (*bitstream->bitseqbuffer);
     bitstream->last_chunk = true;
   }
+  bitstream->bufferlength = (GtUword) mapsize /
+                            sizeof (*bitstream->bitseqbuffer);
   bitstream->bitseqbuffer =
     gt_fa_xmmap_read_range(bitstream->path,
                            mapsize,
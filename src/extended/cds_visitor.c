@@ -58,7 +58,7 @@ static int extract_cds_if_necessary(GtFeatureNode *fn, void *data,
 {
   GtCDSVisitor *v = (GtCDSVisitor*) data;
   GtRange range;
-  char *outsequence;
+  const char *outsequence;
   int had_err = 0;
 
   gt_error_check(err);
@@ -69,13 +69,13 @@ static int extract_cds_if_necessary(GtFeatureNode *fn, void *data,
        gt_feature_node_get_strand(fn) == GT_STRAND_REVERSE)) {
     range = gt_genome_node_get_range((GtGenomeNode*) fn);
     gt_assert(v->region_mapping);
-    had_err = gt_region_mapping_get_sequence(v->region_mapping, &outsequence,
+    had_err = gt_region_mapping_get_sequence_view(v->region_mapping,
+                                   &outsequence,
                                    gt_genome_node_get_seqid((GtGenomeNode*) fn),
                                    range.start, range.end, err);
     if (!had_err) {
       gt_assert(range.start && range.end); /* 1-based coordinates */
       gt_splicedseq_add(v->splicedseq, range.start, range.end, outsequence);
-      gt_free(outsequence);
     }
   }
   return had_err;
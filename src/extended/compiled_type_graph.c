@@ -0,0 +1,313 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/ma.h"
+#include "core/str_api.h"
+#include "extended/compiled_type_graph.h"
+
+#define GT_COMPILED_TYPE_GRAPH_MAGIC    0x6774746367UL /* "gttcg" */
+#define GT_COMPILED_TYPE_GRAPH_VERSION  (1UL | (sizeof (GtUword) << 8))
+
+/* header fields, each stored in one word */
+typedef enum {
+  CTG_MAGIC,
+  CTG_VERSION,
+  CTG_SOURCE_SIZE,
+  CTG_SOURCE_MTIME,
+  CTG_NUMOFNODES,
+  CTG_NUMOFKEYS,
+  CTG_WORDSPERROW,
+  CTG_STRINGS_LENGTH,
+  CTG_HEADER_SIZE
+} GtCompiledTypeGraphHeader;
+
+/* The memory block consists of the header, the key table with pairs
+   (offset of string, node number) sorted by string, the is_a and the
+   part_of closure matrices and the zero terminated strings. */
+struct GtCompiledTypeGraph {
+  GtUword *image,
+          numofwords,
+          numofnodes,
+          numofkeys,
+          wordsperrow;
+  const GtUword *keys;
+  const GtBitsequence *is_a,
+                      *part_of;
+  const char *strings;
+  bool mapped;
+};
+
+typedef struct {
+  const char *str;
+  GtUword num;
+} GtCompiledTypeGraphKey;
+
+static int compiled_type_graph_key_cmp(const void *a, const void *b)
+{
+  const GtCompiledTypeGraphKey *ka = a, *kb = b;
+  int rval = strcmp(ka->str, kb->str);
+  if (rval)
+    return rval;
+  if (ka->num < kb->num)
+    return -1;
+  return ka->num > kb->num ? 1 : 0;
+}
+
+static void compiled_type_graph_source_stamp(const char *source_path,
+                                             GtUword *size, GtUword *mtime)
+{
+  struct stat sb;
+  *size = *mtime = 0;
+  if (source_path && stat(source_path, &sb) == 0) {
+    *size = (GtUword) sb.st_size;
+    *mtime = (GtUword) sb.st_mtime;
+  }
+}
+
+static GtUword compiled_type_graph_num_of_words(GtUword numofnodes,
+                                                GtUword numofkeys,
+                                                GtUword wordsperrow,
+                                                GtUword stringslength)
+{
+  return CTG_HEADER_SIZE + 2 * numofkeys + 2 * numofnodes * wordsperrow
+         + (stringslength + sizeof (GtUword) - 1) / sizeof (GtUword);
+}
+
+static void compiled_type_graph_setup(GtCompiledTypeGraph *ctg)
+{
+  ctg->numofnodes = ctg->image[CTG_NUMOFNODES];
+  ctg->numofkeys = ctg->image[CTG_NUMOFKEYS];
+  ctg->wordsperrow = ctg->image[CTG_WORDSPERROW];
+  ctg->keys = ctg->image + CTG_HEADER_SIZE;
+  ctg->is_a = ctg->keys + 2 * ctg->numofkeys;
+  ctg->part_of = ctg->is_a + ctg->numofnodes * ctg->wordsperrow;
+  ctg->strings = (const char*) (ctg->part_of
+                                + ctg->numofnodes * ctg->wordsperrow);
+}
+
+GtCompiledTypeGraph* gt_compiled_type_graph_new(GtTypeGraph *type_graph,
+                                                const char *source_path)
+{
+  GtCompiledTypeGraph *ctg;
+  GtCompiledTypeGraphKey *keys;
+  GtUword i, numofnodes, numofkeys = 0, wordsperrow, stringslength = 0,
+          *keytab;
+  char *strings;
+  gt_assert(type_graph);
+
+  numofnodes = gt_type_graph_num_of_nodes(type_graph);
+  wordsperrow = GT_NUMOFINTSFORBITS(numofnodes);
+  keys = gt_malloc(sizeof (*keys) * 2 * (numofnodes + 1));
+  for (i = 0; i < numofnodes; i++) {
+    keys[numofkeys].str = gt_type_graph_get_id(type_graph, i);
+    keys[numofkeys++].num = i;
+    keys[numofkeys].str = gt_type_graph_get_name(type_graph, i);
+    keys[numofkeys++].num = i;
+  }
+  qsort(keys, (size_t) numofkeys, sizeof (*keys), compiled_type_graph_key_cmp);
+  /* a string used for several nodes refers to the first of them */
+  if (numofkeys > 0) {
+    GtUword j = 0;
+    for (i = 1; i < numofkeys; i++) {
+      if (strcmp(keys[i].str, keys[j].str) != 0)
+        keys[++j] = keys[i];
+    }
+    numofkeys = j + 1;
+  }
+  for (i = 0; i < numofkeys; i++)
+    stringslength += strlen(keys[i].str) + 1;
+
+  ctg = gt_calloc((size_t) 1, sizeof (*ctg));
+  ctg->numofwords = compiled_type_graph_num_of_words(numofnodes, numofkeys,
+                                                     wordsperrow,
+                                                     stringslength);
+  ctg->image = gt_calloc((size_t) ctg->numofwords, sizeof (GtUword));
+  ctg->image[CTG_MAGIC] = GT_COMPILED_TYPE_GRAPH_MAGIC;
+  ctg->image[CTG_VERSION] = GT_COMPILED_TYPE_GRAPH_VERSION;
+  compiled_type_graph_source_stamp(source_path, ctg->image + CTG_SOURCE_SIZE,
+                                   ctg->image + CTG_SOURCE_MTIME);
+  ctg->image[CTG_NUMOFNODES] = numofnodes;
+  ctg->image[CTG_NUMOFKEYS] = numofkeys;
+  ctg->image[CTG_WORDSPERROW] = wordsperrow;
+  ctg->image[CTG_STRINGS_LENGTH] = stringslength;
+  compiled_type_graph_setup(ctg);
+
+  keytab = ctg->image + CTG_HEADER_SIZE;
+  strings = (char*) ctg->strings;
+  stringslength = 0;
+  for (i = 0; i < numofkeys; i++) {
+    size_t len = strlen(keys[i].str) + 1;
+    keytab[2 * i] = stringslength;
+    keytab[2 * i + 1] = keys[i].num;
+    memcpy(strings + stringslength, keys[i].str, len);
+    stringslength += (GtUword) len;
+  }
+  gt_free(keys);
+  gt_type_graph_compute_closures(type_graph, (GtBitsequence*) ctg->is_a,
+                                 (GtBitsequence*) ctg->part_of, wordsperrow);
+  return ctg;
+}
+
+GtCompiledTypeGraph* gt_compiled_type_graph_map(const char *path,
+                                                const char *source_path,
+                                                GtError *err)
+{
+  GtCompiledTypeGraph *ctg;
+  GtUword *image, size, mtime;
+  size_t len;
+  bool valid;
+  gt_error_check(err);
+  gt_assert(path);
+
+  if (!gt_file_exists(path))
+    return NULL;
+  /* an empty or unreadable file is treated like a stale one */
+  if (!(image = gt_fa_mmap_read(path, &len, err))) {
+    gt_error_unset(err);
+    return NULL;
+  }
+  compiled_type_graph_source_stamp(source_path, &size, &mtime);
+  valid = len >= sizeof (GtUword) * CTG_HEADER_SIZE
+          && image[CTG_MAGIC] == GT_COMPILED_TYPE_GRAPH_MAGIC
+          && image[CTG_VERSION] == GT_COMPILED_TYPE_GRAPH_VERSION
+          && image[CTG_SOURCE_SIZE] == size
+          && image[CTG_SOURCE_MTIME] == mtime
+          && image[CTG_WORDSPERROW]
+             == GT_NUMOFINTSFORBITS(image[CTG_NUMOFNODES])
+          && len == sizeof (GtUword)
+                    * compiled_type_graph_num_of_words(image[CTG_NUMOFNODES],
+                                                     image[CTG_NUMOFKEYS],
+                                                     image[CTG_WORDSPERROW],
+                                                     image[CTG_STRINGS_LENGTH]);
+  if (!valid) {
+    gt_fa_xmunmap(image);
+    return NULL;
+  }
+  ctg = gt_calloc((size_t) 1, sizeof (*ctg));
+  ctg->image = image;
+  ctg->numofwords = (GtUword) (len / sizeof (GtUword));
+  ctg->mapped = true;
+  compiled_type_graph_setup(ctg);
+  return ctg;
+}
+
+int gt_compiled_type_graph_write(const GtCompiledTypeGraph *ctg,
+                                 const char *path, GtError *err)
+{
+  GtStr *tmppath;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(ctg && path);
+
+  tmppath = gt_str_new_cstr(path);
+  gt_str_append_char(tmppath, '.');
+  gt_str_append_uword(tmppath, (GtUword) getpid());
+  if (!(fp = gt_fa_fopen(gt_str_get(tmppath), "wb", err)))
+    had_err = -1;
+  if (!had_err) {
+    if (fwrite(ctg->image, sizeof (GtUword), (size_t) ctg->numofwords, fp)
+        != (size_t) ctg->numofwords) {
+      gt_error_set(err, "cannot write file \"%s\": %s", gt_str_get(tmppath),
+                   strerror(errno));
+      had_err = -1;
+    }
+    gt_fa_fclose(fp);
+    if (!had_err && rename(gt_str_get(tmppath), path) != 0) {
+      gt_error_set(err, "cannot rename file \"%s\" to \"%s\": %s",
+                   gt_str_get(tmppath), path, strerror(errno));
+      had_err = -1;
+    }
+    if (had_err)
+      (void) unlink(gt_str_get(tmppath));
+  }
+  gt_str_delete(tmppath);
+  return had_err;
+}
+
+void gt_compiled_type_graph_delete(GtCompiledTypeGraph *ctg)
+{
+  if (!ctg) return;
+  if (ctg->mapped)
+    gt_fa_xmunmap(ctg->image);
+  else
+    gt_free(ctg->image);
+  gt_free(ctg);
+}
+
+/* Returns the number of the node with name or ID <type> or <numofnodes> if
+   there is no such node. */
+static GtUword compiled_type_graph_lookup(const GtCompiledTypeGraph *ctg,
+                                          const char *type)
+{
+  GtUword left = 0, right = ctg->numofkeys;
+  while (left < right) {
+    GtUword mid = left + (right - left) / 2;
+    int cmp = strcmp(type, ctg->strings + ctg->keys[2 * mid]);
+    if (cmp == 0)
+      return ctg->keys[2 * mid + 1];
+    if (cmp < 0)
+      right = mid;
+    else
+      left = mid + 1;
+  }
+  return ctg->numofnodes;
+}
+
+bool gt_compiled_type_graph_has_type(const GtCompiledTypeGraph *ctg,
+                                     const char *type)
+{
+  gt_assert(ctg && type);
+  return compiled_type_graph_lookup(ctg, type) < ctg->numofnodes;
+}
+
+bool gt_compiled_type_graph_is_a(const GtCompiledTypeGraph *ctg,
+                                 const char *parent_type,
+                                 const char *child_type)
+{
+  GtUword parent, child;
+  gt_assert(ctg && parent_type && child_type);
+  parent = compiled_type_graph_lookup(ctg, parent_type);
+  child = compiled_type_graph_lookup(ctg, child_type);
+  gt_assert(child < ctg->numofnodes);
+  if (parent == ctg->numofnodes)
+    return false;
+  return GT_ISIBITSET(ctg->is_a + child * ctg->wordsperrow, parent) ? true
+                                                                    : false;
+}
+
+bool gt_compiled_type_graph_is_partof(const GtCompiledTypeGraph *ctg,
+                                      const char *parent_type,
+                                      const char *child_type)
+{
+  GtUword parent, child;
+  gt_assert(ctg && parent_type && child_type);
+  parent = compiled_type_graph_lookup(ctg, parent_type);
+  child = compiled_type_graph_lookup(ctg, child_type);
+  gt_assert(parent < ctg->numofnodes && child < ctg->numofnodes);
+  return GT_ISIBITSET(ctg->part_of + child * ctg->wordsperrow, parent) ? true
+                                                                      : false;
+}
@@ -0,0 +1,62 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef COMPILED_TYPE_GRAPH_H
+#define COMPILED_TYPE_GRAPH_H
+
+#include "core/error_api.h"
+#include "extended/type_graph.h"
+
+/* A <GtCompiledTypeGraph> is a read-only form of a <GtTypeGraph> in which
+   all type names and IDs are interned as node numbers and the is_a and
+   part_of relations are stored as precomputed closure bit matrices. It is
+   kept in a single memory block, which can be written to a file and memory
+   mapped again later. */
+typedef struct GtCompiledTypeGraph GtCompiledTypeGraph;
+
+/* Returns a new compiled form of <type_graph>, stamped with size and
+   modification time of <source_path>, the OBO file the graph was read
+   from. */
+GtCompiledTypeGraph* gt_compiled_type_graph_new(GtTypeGraph *type_graph,
+                                                const char *source_path);
+/* Maps the compiled type graph stored in file <path>. Returns NULL without
+   setting <err> if the file does not exist, is empty or cannot be mapped,
+   was written by an incompatible version, or does not match the current
+   state of <source_path>. */
+GtCompiledTypeGraph* gt_compiled_type_graph_map(const char *path,
+                                                const char *source_path,
+                                                GtError *err);
+/* Writes <ctg> to file <path>. The file is first written under a temporary
+   name and then renamed, such that concurrent readers never see a partially
+   written file. Returns 0 on success and -1 on error. */
+int                  gt_compiled_type_graph_write(
+                                               const GtCompiledTypeGraph *ctg,
+                                               const char *path, GtError *err);
+void                 gt_compiled_type_graph_delete(GtCompiledTypeGraph *ctg);
+/* Returns true if <type> is the name or ID of a node in <ctg>. */
+bool                 gt_compiled_type_graph_has_type(
+                                               const GtCompiledTypeGraph *ctg,
+                                               const char *type);
+bool                 gt_compiled_type_graph_is_a(const GtCompiledTypeGraph *ctg,
+                                                 const char *parent_type,
+                                                 const char *child_type);
+bool                 gt_compiled_type_graph_is_partof(
+                                               const GtCompiledTypeGraph *ctg,
+                                               const char *parent_type,
+                                               const char *child_type);
+
+#endif
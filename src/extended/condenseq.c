@@ -1226,6 +1226,11 @@ GtAlphabet *gt_condenseq_alphabet(const GtCondenseq *condenseq)
   return gt_alphabet_ref(condenseq->alphabet);
 }
 
+GtEncseq *gt_condenseq_unique_encseq(const GtCondenseq *condenseq)
+{
+  return gt_encseq_ref(condenseq->unique_es);
+}
+
 GtUword gt_condenseq_count_relevant_uniques(const GtCondenseq *condenseq,
                                             unsigned int min_align_len)
 {
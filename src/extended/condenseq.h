@@ -194,6 +194,9 @@ const GtEditscript* gt_condenseq_link_editscript(const GtCondenseq *condenseq,
 /* Returns a reference to the <GtAlphabet> on which the sequences within
    <condenseq> are based. */
 GtAlphabet*         gt_condenseq_alphabet(const GtCondenseq *condenseq);
+/* Returns a reference to the <GtEncseq> containing the unique elements of
+   <condenseq>, the sequence number of each unique equals its id. */
+GtEncseq*           gt_condenseq_unique_encseq(const GtCondenseq *condenseq);
 
 /* Free space for <condenseq> */
 void                gt_condenseq_delete(GtCondenseq *condenseq);
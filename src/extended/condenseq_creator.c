@@ -29,6 +29,7 @@
 #include "core/safearith.h"
 #include "core/showtime.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/kmer_database.h"
@@ -49,8 +50,6 @@
 /* outputs the diagonals data structure after every update */
 /* #define GT_CONDENSEQ_CREATOR_DIAGS_DEBUG */
 
-static GtUword ces_c_xdrops = 0;
-
 #define GT_CES_C_SPARSE_DIAGS_RESIZE(A, MINELEMS) \
   if (A->nextfree + MINELEMS >= A->allocated) { \
     A->allocated *= 1.2; \
@@ -289,6 +288,17 @@ typedef struct {
                count;
 } GtCondenseqCreatorWindow;
 
+/* uniques and links found for one sequence while processing a batch, in the
+   order they have to be added to the <GtCondenseq>. For uniques the editscript
+   is NULL and <add_kmers> tells if the kmers have to be added to the
+   kmer_db. */
+typedef struct {
+  GtCondenseqLink link;
+  bool            add_kmers;
+} CesCBatchElem;
+
+GT_DECLAREARRAYSTRUCT(CesCBatchElem);
+
 typedef int
 (*gt_condenseq_creator_extend_fkt)(GtCondenseqCreator *condenseq_creator,
                                    GtCondenseqLink *best_link,
@@ -307,7 +317,10 @@ struct GtCondenseqCreator {
   gt_condenseq_creator_extend_fkt extend;
   GtCondenseqCreatorXdrop         xdrop;
   GtCondenseqCreatorWindow        window;
-  GtUword                         current_orig_start,
+  const GtXdropArbitraryscores   *scores;
+  GtArrayCesCBatchElem           *batch_elems;
+  GtUword                         batch_length,
+                                  current_orig_start,
                                   current_seq_len,
                                   current_seq_pos,
                                   current_seq_start,
@@ -320,7 +333,9 @@ struct GtCondenseqCreator {
                                   mean_fraction,
                                   min_d,
                                   max_d,
-                                  min_nu_kmers;
+                                  min_nu_kmers,
+                                  seqnum_end,
+                                  xdrops;
   unsigned int                    kmersize,
                                   windowsize,
                                   cleanup_percent;
@@ -423,7 +438,7 @@ static void ces_c_sparse_diags_mark(CesCSparseDiags *diags,
   }
 }
 
-static void ces_c_xdrop_init(GtXdropArbitraryscores *scores,
+static void ces_c_xdrop_init(const GtXdropArbitraryscores *scores,
                              GtWord xdropscore,
                              GtCondenseqCreatorXdrop *xdrop)
 {
@@ -440,6 +455,20 @@ static void ces_c_xdrop_init(GtXdropArbitraryscores *scores,
   xdrop->xdropscore = xdropscore;
 }
 
+static void ces_c_xdrop_delete(GtCondenseqCreatorXdrop *xdrop)
+{
+  gt_seqabstract_delete(xdrop->current_seq_bwd);
+  gt_seqabstract_delete(xdrop->current_seq_fwd);
+  gt_seqabstract_delete(xdrop->unique_seq_bwd);
+  gt_seqabstract_delete(xdrop->unique_seq_fwd);
+  gt_xdrop_resources_delete(xdrop->best_left_res);
+  gt_xdrop_resources_delete(xdrop->best_right_res);
+  gt_xdrop_resources_delete(xdrop->left_xdrop_res);
+  gt_xdrop_resources_delete(xdrop->right_xdrop_res);
+  gt_free(xdrop->left);
+  gt_free(xdrop->right);
+}
+
 #define GT_CES_LENCHECK(TO_STORE)                                           \
   do {                                                                      \
     if ((TO_STORE) > CES_UNSIGNED_MAX) {                                    \
@@ -481,7 +510,7 @@ static int ces_c_xdrop(GtCondenseqCreator *ces_c,
                                  ces_c->input_es,
                                  i - subject_bounds.start,
                                  subject_bounds.start);
-    ces_c_xdrops++;
+    ces_c->xdrops++;
     gt_evalxdroparbitscoresextend(!forward,
                                   &left_xdrop,
                                   xdrop->left_xdrop_res,
@@ -497,7 +526,7 @@ static int ces_c_xdrop(GtCondenseqCreator *ces_c,
                                  ces_c->input_es,
                                  subject_bounds.end - i,
                                  i);
-    ces_c_xdrops++;
+    ces_c->xdrops++;
     gt_evalxdroparbitscoresextend(forward,
                                   &right_xdrop,
                                   xdrop->right_xdrop_res,
@@ -610,7 +639,7 @@ static int ces_c_extend_seeds_window(GtCondenseqCreator *ces_c,
                  querypos,
                  query_bounds.end,
                  ces_c->windowsize,
-                 ces_c_xdrops);
+                 ces_c->xdrops);
     had_err = -1;
   }
 
@@ -981,6 +1010,8 @@ GtCondenseqCreator *gt_condenseq_creator_new(GtUword initsize,
     return NULL;
   }
   ces_c->adding_iter = NULL;
+  ces_c->batch_elems = NULL;
+  ces_c->batch_length = 0;
   ces_c->ces = NULL;
   ces_c->current_orig_start = 0;
   ces_c->cleanup_percent = GT_DIAGS_CLEAN_LIMIT;
@@ -1001,6 +1032,8 @@ GtCondenseqCreator *gt_condenseq_creator_new(GtUword initsize,
   ces_c->mean_fraction = (GtUword) 2;
   ces_c->min_d = GT_UNDEF_UWORD;
   ces_c->min_align_len = minalignlength;
+  ces_c->scores = scores;
+  ces_c->seqnum_end = 0;
   ces_c->use_diagonals = true;
   ces_c->use_full_diags = false;
   ces_c->use_cutoff = false;
@@ -1009,6 +1042,7 @@ GtCondenseqCreator *gt_condenseq_creator_new(GtUword initsize,
   ces_c->window.count = 0;
   ces_c->window.next = 0;
   ces_c->windowsize = windowsize;
+  ces_c->xdrops = 0;
 
   ces_c->extend = ces_c_extend_seeds_diags;
 
@@ -1136,6 +1170,14 @@ void gt_condenseq_creator_set_mean_fraction(
   condenseq_creator->mean_fraction = fraction;
 }
 
+void gt_condenseq_creator_set_batch_length(
+                                          GtCondenseqCreator *condenseq_creator,
+                                          GtUword batch_length)
+{
+  gt_assert(condenseq_creator != NULL);
+  condenseq_creator->batch_length = batch_length;
+}
+
 void gt_condenseq_creator_delete(GtCondenseqCreator *condenseq_creator)
 {
   if (condenseq_creator != NULL) {
@@ -1147,16 +1189,7 @@ void gt_condenseq_creator_delete(GtCondenseqCreator *condenseq_creator)
     gt_free(condenseq_creator->window.idxs);
     gt_free(condenseq_creator->window.pos_arrs);
     gt_kmer_database_delete(condenseq_creator->kmer_db);
-    gt_seqabstract_delete(condenseq_creator->xdrop.current_seq_bwd);
-    gt_seqabstract_delete(condenseq_creator->xdrop.current_seq_fwd);
-    gt_seqabstract_delete(condenseq_creator->xdrop.unique_seq_bwd);
-    gt_seqabstract_delete(condenseq_creator->xdrop.unique_seq_fwd);
-    gt_xdrop_resources_delete(condenseq_creator->xdrop.best_left_res);
-    gt_xdrop_resources_delete(condenseq_creator->xdrop.best_right_res);
-    gt_xdrop_resources_delete(condenseq_creator->xdrop.left_xdrop_res);
-    gt_xdrop_resources_delete(condenseq_creator->xdrop.right_xdrop_res);
-    gt_free(condenseq_creator->xdrop.left);
-    gt_free(condenseq_creator->xdrop.right);
+    ces_c_xdrop_delete(&condenseq_creator->xdrop);
 
     gt_free(condenseq_creator);
   }
@@ -1193,7 +1226,7 @@ static CesCState ces_c_reset_pos_and_iter(GtCondenseqCreator *ces_c,
 static CesCState
 ces_c_reset_pos_and_iter_to_current_seq(GtCondenseqCreator *ces_c)
 {
-  if (ces_c->main_seqnum >= ces_c->ces->orig_num_seq) {
+  if (ces_c->main_seqnum >= ces_c->seqnum_end) {
     return GT_CONDENSEQ_CREATOR_EOD;
   }
   ces_c->current_seq_start =
@@ -1214,10 +1247,41 @@ ces_c_reset_pos_and_iter_to_current_seq(GtCondenseqCreator *ces_c)
   }                                                                         \
   while (false)
 
+/* While processing a batch, uniques and links are collected in
+   <ces_c->batch_elems> and added to the <GtCondenseq> after the batch. */
+static void ces_c_add_unique(GtCondenseqCreator *ces_c,
+                             GtUword orig_startpos,
+                             ces_unsigned len)
+{
+  if (ces_c->batch_elems != NULL) {
+    CesCBatchElem *elem;
+    GT_GETNEXTFREEINARRAY(elem, ces_c->batch_elems, CesCBatchElem, 32);
+    elem->link.editscript = NULL;
+    elem->link.orig_startpos = orig_startpos;
+    elem->link.len = len;
+    elem->add_kmers = false;
+  }
+  else
+    gt_condenseq_add_unique_to_db(ces_c->ces, orig_startpos, len);
+}
+
+static void ces_c_add_link(GtCondenseqCreator *ces_c,
+                           GtCondenseqLink link)
+{
+  if (ces_c->batch_elems != NULL) {
+    CesCBatchElem *elem;
+    GT_GETNEXTFREEINARRAY(elem, ces_c->batch_elems, CesCBatchElem, 32);
+    elem->link = link;
+    elem->add_kmers = false;
+  }
+  else
+    gt_condenseq_add_link_to_db(ces_c->ces, link);
+}
+
 static CesCState ces_c_skip_short_seqs(GtCondenseqCreator *ces_c)
 {
 
-  while (ces_c->main_seqnum < ces_c->ces->orig_num_seq) {
+  while (ces_c->main_seqnum < ces_c->seqnum_end) {
     ces_c->current_seq_len = gt_condenseq_seqlength(ces_c->ces,
                                                     ces_c->main_seqnum);
     if (ces_c->current_seq_len < ces_c->min_align_len) {
@@ -1225,24 +1289,33 @@ static CesCState ces_c_skip_short_seqs(GtCondenseqCreator *ces_c)
                                                ces_c->main_seqnum);
       /* no check for overflow of length necessary, as minalignlength was
          checked not to overflow */
-      gt_condenseq_add_unique_to_db(ces_c->ces, start,
-                                    ces_c->current_seq_len);
+      ces_c_add_unique(ces_c, start, ces_c->current_seq_len);
       ces_c->main_seqnum++;
     }
     else
       break;
   }
-  return ces_c->main_seqnum >= ces_c->ces->orig_num_seq ?
+  return ces_c->main_seqnum >= ces_c->seqnum_end ?
     GT_CONDENSEQ_CREATOR_EOD : GT_CONDENSEQ_CREATOR_CONT;
 }
 
-/* exclusive range [x..y[ */
+/* exclusive range [x..y[, has to be the range of the last added unique */
 static void ces_c_add_kmers(GtCondenseqCreator *ces_c,
                             GtUword start,
                             GtUword end)
 {
   gt_assert(start < end);
-  if (start + ces_c->min_align_len <= end)
+  if (ces_c->batch_elems != NULL) {
+    CesCBatchElem *last;
+    gt_assert(ces_c->batch_elems->nextfreeCesCBatchElem > 0);
+    last = ces_c->batch_elems->spaceCesCBatchElem +
+           ces_c->batch_elems->nextfreeCesCBatchElem - 1;
+    gt_assert(last->link.editscript == NULL &&
+              last->link.orig_startpos == start &&
+              last->link.orig_startpos + last->link.len == end);
+    last->add_kmers = true;
+  }
+  else if (start + ces_c->min_align_len <= end)
     gt_kmer_database_add_interval(ces_c->kmer_db, start, end - 1,
                                   ces_c->ces->uds_nelems - 1);
 }
@@ -1258,9 +1331,7 @@ static CesCState ces_c_handle_seqend(GtCondenseqCreator *ces_c,
   if (length != 0) {
     GT_CES_LENCHECK_STATE(length);
     if (state != GT_CONDENSEQ_CREATOR_ERROR) {
-      gt_condenseq_add_unique_to_db(ces_c->ces,
-                                    ces_c->current_orig_start,
-                                    length);
+      ces_c_add_unique(ces_c, ces_c->current_orig_start, length);
       if (length >= ces_c->min_align_len)
         ces_c_add_kmers(ces_c, ces_c->current_orig_start,
                         ces_c->current_orig_start + length);
@@ -1325,9 +1396,8 @@ static CesCState ces_c_extend_seed_kmer(GtCondenseqCreator *ces_c,
       else {
         GT_CES_LENCHECK_STATE(leading_unique_len);
         if (state != GT_CONDENSEQ_CREATOR_ERROR) {
-          gt_condenseq_add_unique_to_db(ces_c->ces,
-                                        ces_c->current_orig_start,
-                                        leading_unique_len);
+          ces_c_add_unique(ces_c, ces_c->current_orig_start,
+                           leading_unique_len);
           ces_c_add_kmers(ces_c, ces_c->current_orig_start, link.orig_startpos);
         }
       }
@@ -1363,7 +1433,7 @@ static CesCState ces_c_extend_seed_kmer(GtCondenseqCreator *ces_c,
                                                          link.orig_startpos,
                                                          GT_READMODE_FORWARD);
       gt_multieoplist_delete(linkops);
-      gt_condenseq_add_link_to_db(ces_c->ces, link);
+      ces_c_add_link(ces_c, link);
 
       if (state != GT_CONDENSEQ_CREATOR_EOD &&
           remaining < ces_c->min_align_len) {
@@ -1528,12 +1598,334 @@ static int ces_c_init_kmer_db(GtCondenseqCreator *ces_c, GtError *err)
   return had_err;
 }
 
+/* process kmers until the end of sequence <ces_c->seqnum_end> - 1 */
+static int ces_c_scan(GtCondenseqCreator *ces_c, GtTimer *timer,
+                      GtError *err)
+{
+  const GtKmercode *main_kmercode = NULL;
+  CesCState state = GT_CONDENSEQ_CREATOR_CONT;
+  int had_err = 0;
+  /* progress is only reported by the main creator */
+  const bool report = ces_c->batch_elems == NULL;
+  const GtUword percent = ces_c->ces->orig_len / 100;
+  GtUword percentile = ces_c->main_pos / percent;
+
+  /* we are now within one sequence, and the rest of it is long enough, or we
+     are at the beginning of a sequence that is long enough */
+  if (report && gt_showtime_enabled())
+    gt_timer_show_progress_formatted(timer, stderr,
+                                     "analyse data, search hits, at least "
+                                     GT_WU "%% processed", percentile+1);
+  while (state == GT_CONDENSEQ_CREATOR_CONT &&
+         (main_kmercode =
+          gt_kmercodeiterator_encseq_next(ces_c->main_kmer_iter)) != NULL) {
+    state = ces_c_process_kmer(ces_c, main_kmercode, err);
+    /* handle first kmer after reset of position, state will either be CONT or
+       EOD afterwards. */
+    while (state == GT_CONDENSEQ_CREATOR_RESET &&
+           (main_kmercode =
+            gt_kmercodeiterator_encseq_next(ces_c->main_kmer_iter)) != NULL) {
+      state = ces_c_process_kmer(ces_c, main_kmercode, err);
+    }
+    if (!had_err && state == GT_CONDENSEQ_CREATOR_ERROR)
+      had_err = -1;
+    if (!had_err) {
+      ces_c->main_pos++;
+      ces_c->current_seq_pos++;
+      if (report && percentile < ces_c->main_pos / percent) {
+        percentile = ces_c->main_pos / percent;
+        gt_log_log(GT_WU "%% processed.", percentile);
+        gt_log_log(GT_WU " kmer positions in unique (kmer_db)",
+                   gt_kmer_database_get_kmer_count(ces_c->kmer_db));
+        gt_log_log(GT_WU " times xdrop was called", ces_c->xdrops);
+        gt_log_log(GT_WU " uniques", ces_c->ces->uds_nelems);
+        gt_log_log(GT_WU " links", ces_c->ces->lds_nelems);
+        if (gt_showtime_enabled()) {
+          if (percentile + 1 <= 100)
+            gt_timer_show_progress_formatted(timer, stderr,
+                                             "analyse data, search hits, at "
+                                             "least " GT_WU "%% processed",
+                                             percentile+1);
+        }
+      }
+    }
+  }
+  if (!had_err && state == GT_CONDENSEQ_CREATOR_ERROR)
+    had_err = -1;
+  if (!had_err && state != GT_CONDENSEQ_CREATOR_EOD) {
+    had_err = -1;
+    gt_error_set(err, "Processing of kmers stopped, but end of data not "
+                 "reached");
+  }
+  return had_err;
+}
+
+static CesCDiags *ces_c_diags_new(const GtCondenseqCreator *ces_c)
+{
+  CesCDiags *diags = NULL;
+  if (ces_c->use_diagonals || ces_c->use_full_diags) {
+    diags = gt_malloc(sizeof (*diags));
+    if (ces_c->use_full_diags) {
+      diags->full =
+        ces_c_diagonals_full_new((size_t)
+                                 gt_encseq_total_length(ces_c->input_es));
+    }
+    else
+      diags->full = NULL;
+    if (ces_c->use_diagonals) {
+      diags->sparse = ces_c_sparse_diags_new((size_t) ces_c->initsize);
+    }
+    else
+      diags->sparse = NULL;
+  }
+  return diags;
+}
+
+/* A worker is a copy of the creator with its own search state, sharing the
+   kmer_db and the <GtCondenseq> which are only read while a batch is
+   processed. */
+static GtCondenseqCreator *ces_c_worker_new(const GtCondenseqCreator *ces_c)
+{
+  GtCondenseqCreator *worker = gt_malloc(sizeof (*worker));
+
+  *worker = *ces_c;
+  ces_c_xdrop_init(ces_c->scores, ces_c->xdrop.xdropscore, &worker->xdrop);
+  worker->window.count = 0;
+  worker->window.next = 0;
+  worker->window.idxs = gt_calloc((size_t) ces_c->windowsize,
+                                  sizeof (*worker->window.idxs));
+  worker->window.pos_arrs = gt_calloc((size_t) ces_c->windowsize,
+                                      sizeof (*worker->window.pos_arrs));
+  worker->diagonals = ces_c_diags_new(ces_c);
+  worker->adding_iter = NULL;
+  worker->main_kmer_iter = gt_kmercodeiterator_encseq_new(ces_c->input_es,
+                                                          GT_READMODE_FORWARD,
+                                                          ces_c->kmersize,
+                                                          0);
+  worker->min_d = GT_UNDEF_UWORD;
+  worker->max_d = 0;
+  worker->xdrops = 0;
+#ifdef GT_CONDENSEQ_CREATOR_DIST_DEBUG
+  if (gt_log_enabled()) {
+    worker->add = gt_disc_distri_new();
+    worker->replace = gt_disc_distri_new();
+    worker->delete = gt_disc_distri_new();
+  }
+#endif
+  return worker;
+}
+
+static void ces_c_worker_delete(GtCondenseqCreator *worker)
+{
+  if (worker != NULL) {
+#ifdef GT_CONDENSEQ_CREATOR_DIST_DEBUG
+    gt_disc_distri_delete(worker->add);
+    gt_disc_distri_delete(worker->replace);
+    gt_disc_distri_delete(worker->delete);
+#endif
+    gt_free(worker->window.idxs);
+    gt_free(worker->window.pos_arrs);
+    ces_c_xdrop_delete(&worker->xdrop);
+    ces_c_diags_delete(worker->diagonals);
+    gt_kmercodeiterator_delete(worker->main_kmer_iter);
+    gt_free(worker);
+  }
+}
+
+typedef struct {
+  GtArrayCesCBatchElem *seq_elems;
+  GtMutex              *mutex;
+  GtUword               first_seqnum,
+                        next_seqnum,
+                        seqnum_end;
+} CesCBatch;
+
+typedef struct {
+  CesCBatch          *batch;
+  GtCondenseqCreator *ces_c;
+  GtError            *err;
+  GtThread           *thread;
+  int                 had_err;
+} CesCBatchWorker;
+
+/* each sequence of the batch is processed on its own, so the result does not
+   depend on the number of workers */
+static void *ces_c_batch_worker_run(void *data)
+{
+  CesCBatchWorker *worker = data;
+  CesCBatch *batch = worker->batch;
+  GtCondenseqCreator *ces_c = worker->ces_c;
+
+  while (worker->had_err == 0) {
+    CesCState state;
+    GtUword seqnum;
+
+    gt_mutex_lock(batch->mutex);
+    seqnum = batch->next_seqnum++;
+    gt_mutex_unlock(batch->mutex);
+    if (seqnum >= batch->seqnum_end)
+      break;
+    ces_c->batch_elems = batch->seq_elems + (seqnum - batch->first_seqnum);
+    ces_c->main_seqnum = seqnum;
+    ces_c->seqnum_end = seqnum + 1;
+    state = ces_c_skip_short_seqs(ces_c);
+    if (state == GT_CONDENSEQ_CREATOR_CONT)
+      state = ces_c_reset_pos_and_iter_to_current_seq(ces_c);
+    if (state != GT_CONDENSEQ_CREATOR_EOD)
+      worker->had_err = ces_c_scan(ces_c, NULL, worker->err);
+  }
+  return NULL;
+}
+
+static void ces_c_batch_merge(GtCondenseqCreator *ces_c,
+                              GtArrayCesCBatchElem *elems)
+{
+  GtUword idx;
+  for (idx = 0; idx < elems->nextfreeCesCBatchElem; idx++) {
+    CesCBatchElem *elem = elems->spaceCesCBatchElem + idx;
+    if (elem->link.editscript == NULL) {
+      gt_condenseq_add_unique_to_db(ces_c->ces, elem->link.orig_startpos,
+                                    elem->link.len);
+      if (elem->add_kmers)
+        ces_c_add_kmers(ces_c, elem->link.orig_startpos,
+                        elem->link.orig_startpos + elem->link.len);
+    }
+    else
+      gt_condenseq_add_link_to_db(ces_c->ces, elem->link);
+  }
+  elems->nextfreeCesCBatchElem = 0;
+}
+
+static void ces_c_batch_elems_clear(GtArrayCesCBatchElem *elems)
+{
+  GtUword idx;
+  for (idx = 0; idx < elems->nextfreeCesCBatchElem; idx++)
+    gt_editscript_delete(elems->spaceCesCBatchElem[idx].link.editscript);
+  elems->nextfreeCesCBatchElem = 0;
+}
+
+/* The sequences following the current one are processed in batches of at
+   least <ces_c->batch_length> residues. All sequences of a batch are compared
+   concurrently to the uniques found before the batch, the uniques found in the
+   batch are added to the kmer_db afterwards. */
+static int ces_c_analyse_batches(GtCondenseqCreator *ces_c, GtTimer *timer,
+                                 GtError *err)
+{
+  CesCBatch batch;
+  CesCBatchWorker *workers;
+  GtUword allocated = 0,
+          idx,
+          numofbatches = 0;
+#ifdef GT_THREADS_ENABLED
+  const unsigned int numofworkers = gt_jobs;
+#else
+  const unsigned int numofworkers = 1U;
+#endif
+  unsigned int w;
+  int had_err = 0;
+
+  gt_assert(ces_c->batch_length > 0);
+  batch.mutex = gt_mutex_new();
+  batch.seq_elems = NULL;
+  batch.first_seqnum = ces_c->main_seqnum;
+  workers = gt_calloc((size_t) numofworkers, sizeof (*workers));
+  for (w = 0; w < numofworkers; w++) {
+    workers[w].batch = &batch;
+    workers[w].ces_c = ces_c_worker_new(ces_c);
+    workers[w].err = gt_error_new();
+  }
+  while (!had_err && batch.first_seqnum < ces_c->ces->orig_num_seq) {
+    GtUword length = 0;
+
+    batch.seqnum_end = batch.first_seqnum;
+    while (batch.seqnum_end < ces_c->ces->orig_num_seq &&
+           length < ces_c->batch_length) {
+      length += gt_condenseq_seqlength(ces_c->ces, batch.seqnum_end);
+      batch.seqnum_end++;
+    }
+    if (batch.seqnum_end - batch.first_seqnum > allocated) {
+      GtUword newsize = batch.seqnum_end - batch.first_seqnum;
+      batch.seq_elems = gt_realloc(batch.seq_elems,
+                                   (size_t) newsize *
+                                   sizeof (*batch.seq_elems));
+      for (idx = allocated; idx < newsize; idx++)
+        GT_INITARRAY(batch.seq_elems + idx, CesCBatchElem);
+      allocated = newsize;
+    }
+    batch.next_seqnum = batch.first_seqnum;
+#ifdef GT_THREADS_ENABLED
+    for (w = 1U; w < numofworkers; w++) {
+      workers[w].thread = gt_thread_new(ces_c_batch_worker_run, workers + w,
+                                        NULL);
+      if (workers[w].thread == NULL)
+        (void) ces_c_batch_worker_run(workers + w);
+    }
+    (void) ces_c_batch_worker_run(workers);
+    for (w = 1U; w < numofworkers; w++) {
+      if (workers[w].thread != NULL) {
+        gt_thread_join(workers[w].thread);
+        gt_thread_delete(workers[w].thread);
+        workers[w].thread = NULL;
+      }
+    }
+#else
+    (void) ces_c_batch_worker_run(workers);
+#endif
+    for (w = 0; !had_err && w < numofworkers; w++) {
+      if (workers[w].had_err != 0) {
+        gt_error_set(err, "%s", gt_error_get(workers[w].err));
+        had_err = -1;
+      }
+    }
+    for (idx = 0; idx < batch.seqnum_end - batch.first_seqnum; idx++) {
+      if (!had_err)
+        ces_c_batch_merge(ces_c, batch.seq_elems + idx);
+      else
+        ces_c_batch_elems_clear(batch.seq_elems + idx);
+    }
+    if (!had_err) {
+      gt_kmer_database_flush(ces_c->kmer_db);
+      numofbatches++;
+      gt_log_log("batch " GT_WU ": sequences " GT_WU "-" GT_WU ", " GT_WU
+                 " uniques, " GT_WU " links", numofbatches,
+                 batch.first_seqnum, batch.seqnum_end - 1,
+                 ces_c->ces->uds_nelems, ces_c->ces->lds_nelems);
+      if (gt_showtime_enabled())
+        gt_timer_show_progress_formatted(timer, stderr,
+                                         "analyse data, batch " GT_WU
+                                         ", " GT_WU " of " GT_WU " sequences "
+                                         "processed", numofbatches,
+                                         batch.seqnum_end,
+                                         ces_c->ces->orig_num_seq);
+    }
+    batch.first_seqnum = batch.seqnum_end;
+  }
+  ces_c->main_seqnum = batch.first_seqnum;
+  for (w = 0; w < numofworkers; w++) {
+    ces_c->xdrops += workers[w].ces_c->xdrops;
+    if (workers[w].ces_c->min_d < ces_c->min_d)
+      ces_c->min_d = workers[w].ces_c->min_d;
+    if (workers[w].ces_c->max_d > ces_c->max_d)
+      ces_c->max_d = workers[w].ces_c->max_d;
+    ces_c_worker_delete(workers[w].ces_c);
+    gt_error_delete(workers[w].err);
+  }
+  gt_free(workers);
+  for (idx = 0; idx < allocated; idx++)
+    GT_FREEARRAY(batch.seq_elems + idx, CesCBatchElem);
+  gt_free(batch.seq_elems);
+  gt_mutex_delete(batch.mutex);
+  if (!had_err)
+    gt_logger_log(ces_c->logger, "processed " GT_WU " batches of at least "
+                  GT_WU " residues with %u threads", numofbatches,
+                  ces_c->batch_length, numofworkers);
+  return had_err;
+}
+
 /* scan the seq and fill tables */
 static int ces_c_analyse(GtCondenseqCreator *ces_c, GtTimer *timer,
                          GtError *err)
 {
-  const GtKmercode *main_kmercode = NULL;
-  CesCState state = GT_CONDENSEQ_CREATOR_CONT;
   int had_err = 0;
 
   ces_c->main_kmer_iter = gt_kmercodeiterator_encseq_new(ces_c->input_es,
@@ -1545,61 +1937,21 @@ static int ces_c_analyse(GtCondenseqCreator *ces_c, GtTimer *timer,
   had_err = ces_c_init_kmer_db(ces_c, err);
   if (!had_err &&
       !gt_kmercodeiterator_inputexhausted(ces_c->main_kmer_iter)) {
-    GtUword percentile;
-    const GtUword percent = ces_c->ces->orig_len / 100;
     gt_log_log(GT_WU " initial kmer positions in kmer_db",
                gt_kmer_database_get_kmer_count(ces_c->kmer_db));
     gt_log_log(GT_WU " initial bytes for kmer_db",
                gt_kmer_database_get_used_size(ces_c->kmer_db));
     gt_log_log(GT_WU " initial bytes allocated size of kmer_db",
                gt_kmer_database_get_byte_size(ces_c->kmer_db));
-    percentile = ces_c->main_pos / percent;
-    /* we are now within one sequence, and the rest of it is long enough, or we
-       are at the beginning of a sequence that is long enough */
-    if (gt_showtime_enabled())
-      gt_timer_show_progress_formatted(timer, stderr,
-                                       "analyse data, search hits, at least "
-                                       GT_WU "%% processed", percentile+1);
-    while (state == GT_CONDENSEQ_CREATOR_CONT &&
-           (main_kmercode =
-            gt_kmercodeiterator_encseq_next(ces_c->main_kmer_iter)) != NULL) {
-      state = ces_c_process_kmer(ces_c, main_kmercode, err);
-      /* handle first kmer after reset of position, state will either be CONT or
-         EOD afterwards. */
-      while (state == GT_CONDENSEQ_CREATOR_RESET &&
-             (main_kmercode =
-              gt_kmercodeiterator_encseq_next(ces_c->main_kmer_iter)) != NULL) {
-        state = ces_c_process_kmer(ces_c, main_kmercode, err);
-      }
-      if (!had_err && state == GT_CONDENSEQ_CREATOR_ERROR)
-        had_err = -1;
-      if (!had_err) {
-        ces_c->main_pos++;
-        ces_c->current_seq_pos++;
-        if (percentile < ces_c->main_pos / percent) {
-          percentile = ces_c->main_pos / percent;
-          gt_log_log(GT_WU "%% processed.", percentile);
-          gt_log_log(GT_WU " kmer positions in unique (kmer_db)",
-                     gt_kmer_database_get_kmer_count(ces_c->kmer_db));
-          gt_log_log(GT_WU " times xdrop was called", ces_c_xdrops);
-          gt_log_log(GT_WU " uniques", ces_c->ces->uds_nelems);
-          gt_log_log(GT_WU " links", ces_c->ces->lds_nelems);
-          if (gt_showtime_enabled()) {
-            if (percentile + 1 <= 100)
-              gt_timer_show_progress_formatted(timer, stderr,
-                                               "analyse data, search hits, at "
-                                               "least " GT_WU "%% processed",
-                                               percentile+1);
-          }
-        }
-      }
-    }
-    if (!had_err && state == GT_CONDENSEQ_CREATOR_ERROR)
-      had_err = -1;
-    if (!had_err && state != GT_CONDENSEQ_CREATOR_EOD) {
-      had_err = -1;
-      gt_error_set(err, "Processing of kmers stopped, but end of data not "
-                   "reached");
+    if (ces_c->batch_length == 0)
+      had_err = ces_c_scan(ces_c, timer, err);
+    else {
+      /* finish the sequence the initial uniques end in */
+      ces_c->seqnum_end = ces_c->main_seqnum + 1;
+      had_err = ces_c_scan(ces_c, timer, err);
+      ces_c->seqnum_end = ces_c->ces->orig_num_seq;
+      if (!had_err)
+        had_err = ces_c_analyse_batches(ces_c, timer, err);
     }
   }
   gt_kmercodeiterator_delete(ces_c->main_kmer_iter);
@@ -1704,36 +2056,32 @@ int gt_condenseq_creator_create(GtCondenseqCreator *condenseq_creator,
       gt_kmer_database_set_prune(condenseq_creator->kmer_db);
   }
   condenseq_creator->ces = ces;
-  if (condenseq_creator->use_diagonals || condenseq_creator->use_full_diags) {
-    if (gt_showtime_enabled())
-      gt_timer_show_progress(timer, "create diagonals", stderr);
-    condenseq_creator->diagonals =
-      gt_malloc(sizeof (*condenseq_creator->diagonals));
-    if (condenseq_creator->use_full_diags) {
-      condenseq_creator->diagonals->full =
-        ces_c_diagonals_full_new((size_t) gt_encseq_total_length(encseq));
-    }
-    else
-      condenseq_creator->diagonals->full = NULL;
-    if (condenseq_creator->use_diagonals) {
-      condenseq_creator->diagonals->sparse =
-        ces_c_sparse_diags_new((size_t) condenseq_creator->initsize);
-    }
-    else
-      condenseq_creator->diagonals->sparse = NULL;
-  }
-  else
-    condenseq_creator->diagonals = NULL;
+  condenseq_creator->seqnum_end = ces->orig_num_seq;
+  if (gt_showtime_enabled() &&
+      (condenseq_creator->use_diagonals || condenseq_creator->use_full_diags))
+    gt_timer_show_progress(timer, "create diagonals", stderr);
+  condenseq_creator->diagonals = ces_c_diags_new(condenseq_creator);
 
-  ces_c_xdrops = 0;
+  condenseq_creator->xdrops = 0;
   had_err = ces_c_analyse(condenseq_creator, timer, err);
 
   if (!had_err) {
+    GtUword idx, unique_len = 0;
+    for (idx = 0; idx < condenseq_creator->ces->uds_nelems; idx++)
+      unique_len += condenseq_creator->ces->uniques[idx].len;
+    /* allows to compare the compression achieved with and without batches */
+    gt_logger_log(logger, GT_WU " uniques and " GT_WU " links, uniques "
+                  "contain " GT_WU " of " GT_WU " residues (%.2f%%)",
+                  condenseq_creator->ces->uds_nelems,
+                  condenseq_creator->ces->lds_nelems, unique_len,
+                  condenseq_creator->ces->orig_len,
+                  condenseq_creator->ces->orig_len == 0 ? 0.0 :
+                  100.0 * unique_len / condenseq_creator->ces->orig_len);
     if (gt_showtime_enabled())
       gt_timer_show_progress(timer, "write data, alphabet", stderr);
     gt_log_log(GT_WU " kmer positions in final kmer_db",
                gt_kmer_database_get_kmer_count(condenseq_creator->kmer_db));
-    gt_log_log(GT_WU " xdrop calls.", ces_c_xdrops);
+    gt_log_log(GT_WU " xdrop calls.", condenseq_creator->xdrops);
     gt_log_log(GT_WU " uniques", condenseq_creator->ces->uds_nelems);
     gt_log_log(GT_WU " links", condenseq_creator->ces->lds_nelems);
     gt_log_log(GT_WU " bytes in final kmer_db",
@@ -106,6 +106,16 @@ void                gt_condenseq_creator_disable_prune(
 void                gt_condenseq_creator_set_mean_fraction(
                                           GtCondenseqCreator *condenseq_creator,
                                           GtUword fraction);
+/* If <batch_length> is larger than 0, the sequences following the initial
+   unique database are processed in batches of consecutive sequences with at
+   least <batch_length> residues. The sequences of a batch are compressed
+   concurrently (using <gt_jobs> threads) against the uniques found before the
+   batch, uniques found within a batch are only available to later batches.
+   This trades compression ratio for speed, the result does not depend on the
+   number of threads. */
+void                gt_condenseq_creator_set_batch_length(
+                                          GtCondenseqCreator *condenseq_creator,
+                                          GtUword batch_length);
 /* Percentage of sparse diagonals that is allowed to be outside of used ranges
    and marked for deletion. 0 <= <percent> < 100. */
 void gt_condenseq_creator_set_diags_clean_limit(
@@ -29,7 +29,10 @@ typedef struct GtCSAStream GtCSAStream;
 
 /* Create a <GtCSAStream*> which takes spliced alignments from its <in_stream>
    (which are at most <join_length> many bases apart), transforms them into
-   consensus spliced alignments, and returns them. */
+   consensus spliced alignments, and returns them.
+   If <gt_jobs> is larger than one, the consensus spliced alignments of
+   completed clusters are computed in parallel. The output order is the same
+   as in the serial case. */
 GtNodeStream* gt_csa_stream_new(GtNodeStream *in_stream,
                                 GtUword join_length);
 
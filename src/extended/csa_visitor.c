@@ -18,7 +18,10 @@
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
 #include "core/log.h"
+#include "core/ma.h"
+#include "core/multithread_api.h"
 #include "core/queue_api.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/csa_variable_strands.h"
@@ -30,11 +33,21 @@
 
 #define GT_CSA_SOURCE_TAG "gt csa"
 
+/* number of completed clusters per job which are collected before they are
+   processed in parallel */
+#define GT_CSA_CLUSTERS_PER_JOB 64
+
+typedef struct {
+  GtArray *cluster,   /* the spliced alignments of the cluster */
+          *csa_genes; /* the resulting consensus genes */
+} CSACluster;
+
 struct CSAVisitor {
   const GtNodeVisitor parent_instance;
   GtQueue *gt_genome_node_buffer;
   GtUword join_length;
-  GtArray *cluster;
+  GtArray *cluster,
+          *completed_clusters; /* of type CSACluster, only used if gt_jobs > 1 */
   GtFeatureNode *buffered_feature;
   GtRange first_range,
           second_range;
@@ -51,6 +64,8 @@ static void csa_visitor_free(GtNodeVisitor *nv)
   CSAVisitor *csa_visitor = csa_visitor_cast(nv);
   gt_queue_delete(csa_visitor->gt_genome_node_buffer);
   gt_array_delete(csa_visitor->cluster);
+  gt_assert(!gt_array_size(csa_visitor->completed_clusters));
+  gt_array_delete(csa_visitor->completed_clusters);
   gt_str_delete(csa_visitor->gt_csa_source_str);
 }
 
@@ -104,12 +119,16 @@ static int csa_visitor_feature_node(GtNodeVisitor *nv, GtFeatureNode *fn,
   return 0;
 }
 
+static void process_completed_clusters(CSAVisitor *csa_visitor);
+
 static int csa_visitor_default_func(GtNodeVisitor *nv, GtGenomeNode *gn,
                                     GT_UNUSED GtError *err)
 {
   CSAVisitor *csa_visitor;
   gt_error_check(err);
   csa_visitor = csa_visitor_cast(nv);
+  /* the consensus genes of all completed clusters precede this node */
+  process_completed_clusters(csa_visitor);
   gt_queue_add(csa_visitor->gt_genome_node_buffer, gn);
   return 0;
 }
@@ -171,6 +190,7 @@ GtNodeVisitor* gt_csa_visitor_new(GtUword join_length)
   csa_visitor->gt_genome_node_buffer = gt_queue_new();
   csa_visitor->join_length = join_length;
   csa_visitor->cluster = gt_array_new(sizeof (GtFeatureNode*));
+  csa_visitor->completed_clusters = gt_array_new(sizeof (CSACluster));
   csa_visitor->buffered_feature = NULL;
   csa_visitor->gt_csa_source_str = gt_str_new_cstr(GT_CSA_SOURCE_TAG);
   return nv;
@@ -469,12 +489,97 @@ static void process_csa_genes(GtQueue *gt_genome_node_buffer,
   }
 }
 
+static GtArray* compute_csa_genes(GtArray *cluster)
+{
+  gt_assert(cluster && gt_array_size(cluster));
+  return gt_csa_variable_strands(gt_array_get_space(cluster),
+                                 gt_array_size(cluster),
+                                 sizeof (GtFeatureNode*), get_genomic_range,
+                                 get_strand, get_exons);
+}
+
+static void output_csa_genes(CSAVisitor *csa_visitor, GtArray *csa_genes,
+                             GtArray *cluster)
+{
+  GtUword i;
+  gt_assert(csa_visitor && csa_genes && cluster);
+
+  process_csa_genes(csa_visitor->gt_genome_node_buffer, csa_genes,
+                    csa_visitor->gt_csa_source_str);
+
+  for (i = 0; i < gt_array_size(csa_genes); i++)
+    gt_csa_gene_delete(*(GtCSAGene**) gt_array_get(csa_genes, i));
+  gt_array_delete(csa_genes);
+
+  /* remove the cluster genome nodes */
+  for (i = 0; i < gt_array_size(cluster); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(cluster, i));
+}
+
+typedef struct {
+  GtArray *clusters;
+  GtUword next_cluster;
+  GtMutex *mutex;
+} ComputeCSAGenesInfo;
+
+static void* compute_csa_genes_thread(void *data)
+{
+  ComputeCSAGenesInfo *info = data;
+  CSACluster *csa_cluster;
+  GtUword clusternum;
+  gt_assert(info);
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    clusternum = info->next_cluster++;
+    gt_mutex_unlock(info->mutex);
+    if (clusternum >= gt_array_size(info->clusters))
+      break;
+    csa_cluster = gt_array_get(info->clusters, clusternum);
+    csa_cluster->csa_genes = compute_csa_genes(csa_cluster->cluster);
+  }
+  return NULL;
+}
+
+/* The consensus spliced alignments of the completed clusters are computed in
+   parallel. The resulting genome nodes are created (and the clusters are
+   deleted) in input order afterwards, because genome nodes share reference
+   counted strings (e.g., the sequence ids) across clusters. */
+static void process_completed_clusters(CSAVisitor *csa_visitor)
+{
+  ComputeCSAGenesInfo info;
+  CSACluster *csa_cluster;
+  GtError *err;
+  GtUword i;
+  gt_assert(csa_visitor);
+
+  if (!gt_array_size(csa_visitor->completed_clusters))
+    return;
+
+  info.clusters = csa_visitor->completed_clusters;
+  info.next_cluster = 0;
+  info.mutex = gt_mutex_new();
+  err = gt_error_new();
+  if (gt_multithread(compute_csa_genes_thread, &info, err)) {
+    /* not all threads could be started, compute the remaining clusters here */
+    (void) compute_csa_genes_thread(&info);
+  }
+  gt_error_delete(err);
+  gt_mutex_delete(info.mutex);
+
+  for (i = 0; i < gt_array_size(csa_visitor->completed_clusters); i++) {
+    csa_cluster = gt_array_get(csa_visitor->completed_clusters, i);
+    output_csa_genes(csa_visitor, csa_cluster->csa_genes,
+                     csa_cluster->cluster);
+    gt_array_delete(csa_cluster->cluster);
+  }
+  gt_array_reset(csa_visitor->completed_clusters);
+}
+
 void gt_csa_visitor_process_cluster(GtNodeVisitor *nv, bool final_cluster)
 {
   CSAVisitor *csa_visitor = csa_visitor_cast(nv);
   GT_UNUSED GtFeatureNode *first_feature;
   GtArray *csa_genes;
-  GtUword i;
 
   if (final_cluster) {
     gt_assert(!gt_array_size(csa_visitor->cluster) ||
@@ -487,29 +592,31 @@ void gt_csa_visitor_process_cluster(GtNodeVisitor *nv, bool final_cluster)
 
   if (!gt_array_size(csa_visitor->cluster)) {
     gt_assert(final_cluster);
+    process_completed_clusters(csa_visitor);
+    return;
+  }
+
+  /* the debug output of the consensus computation is kept in order by
+     processing the clusters serially */
+  if (gt_jobs > 1 && !gt_log_enabled()) {
+    CSACluster csa_cluster;
+    /* defer the cluster until enough clusters for all jobs are collected */
+    csa_cluster.cluster = csa_visitor->cluster;
+    csa_cluster.csa_genes = NULL;
+    gt_array_add(csa_visitor->completed_clusters, csa_cluster);
+    csa_visitor->cluster = gt_array_new(sizeof (GtFeatureNode*));
+    if (final_cluster ||
+        gt_array_size(csa_visitor->completed_clusters) >=
+        gt_jobs * GT_CSA_CLUSTERS_PER_JOB) {
+      process_completed_clusters(csa_visitor);
+    }
     return;
   }
 
   /* compute the consensus spliced alignments */
   first_feature = *(GtFeatureNode**)
                   gt_array_get_first(csa_visitor->cluster);
-  csa_genes = gt_csa_variable_strands(gt_array_get_space(csa_visitor->cluster),
-                                      gt_array_size(csa_visitor->cluster),
-                                      sizeof (GtFeatureNode*),
-                                      get_genomic_range,
-                                      get_strand, get_exons);
-
-  process_csa_genes(csa_visitor->gt_genome_node_buffer, csa_genes,
-                    csa_visitor->gt_csa_source_str);
-
-  for (i = 0; i < gt_array_size(csa_genes); i++)
-    gt_csa_gene_delete(*(GtCSAGene**) gt_array_get(csa_genes, i));
-  gt_array_delete(csa_genes);
-
-  /* remove the cluster genome nodes */
-  for (i = 0; i < gt_array_size(csa_visitor->cluster); i++) {
-    gt_genome_node_delete(*(GtGenomeNode**)
-                              gt_array_get(csa_visitor->cluster, i));
-  }
+  csa_genes = compute_csa_genes(csa_visitor->cluster);
+  output_csa_genes(csa_visitor, csa_genes, csa_visitor->cluster);
   gt_array_reset(csa_visitor->cluster);
 }
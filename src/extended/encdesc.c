@@ -1209,7 +1209,12 @@ static int encdesc_next_desc(GtEncdesc *encdesc, GtStr *desc, GtError *err)
     return -1;
   }
 
-  if (encdesc->sampling != NULL &&
+  /* the decoder was reset to the current sample */
+  if (encdesc->sampling != NULL && encdesc->cur_desc != 0 &&
+      encdesc->cur_desc ==
+      gt_sampling_get_current_elementnum(encdesc->sampling))
+    sampled = true;
+  else if (encdesc->sampling != NULL &&
       encdesc->cur_desc == gt_sampling_get_next_elementnum(encdesc->sampling)) {
     int sample_status;
     size_t startofnearestsample;
@@ -1443,8 +1448,8 @@ int gt_encdesc_decode(GtEncdesc *encdesc,
                                 num,
                                 &nearestsample,
                                 &startofnearestsample);
-    /* nearestsample <= cur_read < readnum: current sample is the right one */
-    if (nearestsample <= encdesc->cur_desc && encdesc->cur_desc <= num)
+    /* nearestsample < cur_read < readnum: current sample is the right one */
+    if (nearestsample < encdesc->cur_desc && encdesc->cur_desc <= num)
       descs2read = num - encdesc->cur_desc;
     else { /* reset decoder to new sample */
       gt_bitinstream_reinit(encdesc->bitinstream,
@@ -94,6 +94,14 @@ void gt_evaluator_reset(GtEvaluator *evaluator)
   memset(evaluator, 0, sizeof *evaluator);
 }
 
+void gt_evaluator_add(GtEvaluator *dest, const GtEvaluator *src)
+{
+  gt_assert(dest && src);
+  dest->T += src->T;
+  dest->A += src->A;
+  dest->P += src->P;
+}
+
 int gt_evaluator_unit_test(GtError *err)
 {
   GtEvaluator *evaluator = gt_evaluator_new();
@@ -154,6 +162,19 @@ int gt_evaluator_unit_test(GtError *err)
   gt_ensure(gt_evaluator_get_sensitivity(evaluator) == 1.0);
   gt_ensure(gt_evaluator_get_specificity(evaluator) == 1.0);
 
+  if (!had_err) {
+    GtEvaluator *sum = gt_evaluator_new();
+    gt_evaluator_reset(evaluator);
+    gt_evaluator_add_actual(evaluator, 2);
+    gt_evaluator_add_predicted(evaluator, 4);
+    gt_evaluator_add_true(evaluator);
+    gt_evaluator_add(sum, evaluator);
+    gt_evaluator_add(sum, evaluator);
+    gt_ensure(gt_evaluator_get_sensitivity(sum) == 0.5);
+    gt_ensure(gt_evaluator_get_specificity(sum) == 0.25);
+    gt_evaluator_delete(sum);
+  }
+
   gt_evaluator_delete(evaluator);
 
   return had_err;
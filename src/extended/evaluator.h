@@ -32,6 +32,8 @@ double       gt_evaluator_get_specificity(const GtEvaluator*);
 void         gt_evaluator_show_sensitivity(const GtEvaluator*, GtFile*);
 void         gt_evaluator_show_specificity(const GtEvaluator*, GtFile*);
 void         gt_evaluator_reset(GtEvaluator*);
+/* add the counts of <src> to <dest> */
+void         gt_evaluator_add(GtEvaluator *dest, const GtEvaluator *src);
 int          gt_evaluator_unit_test(GtError*);
 void         gt_evaluator_delete(GtEvaluator*);
 
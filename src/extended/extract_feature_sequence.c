@@ -34,7 +34,7 @@ static int extract_join_feature(GtGenomeNode *gn, const char *type,
                                 bool *first_child_of_type_seen, GtPhase *phase,
                                 GtError *err)
 {
-  char *outsequence;
+  const char *outsequence;
   GtFeatureNode *fn;
   GtRange range;
   int had_err = 0;
@@ -54,13 +54,12 @@ static int extract_join_feature(GtGenomeNode *gn, const char *type,
       } else *phase = GT_PHASE_UNDEFINED;
     }
     range = gt_genome_node_get_range(gn);
-    had_err = gt_region_mapping_get_sequence(region_mapping, &outsequence,
-                                             gt_genome_node_get_seqid(gn),
-                                             range.start, range.end, err);
-    if (!had_err) {
+    had_err = gt_region_mapping_get_sequence_view(region_mapping,
+                                                  &outsequence,
+                                                  gt_genome_node_get_seqid(gn),
+                                                  range.start, range.end, err);
+    if (!had_err)
       gt_str_append_cstr_nt(sequence, outsequence, gt_range_length(&range));
-      gt_free(outsequence);
-    }
   }
   return had_err;
 }
@@ -76,7 +75,7 @@ static int extract_feature_sequence_generic(GtStr *sequence, GtGenomeNode *gn,
   GtFeatureNode *fn;
   GtRange range;
   unsigned int phase_offset = 0;
-  char *outsequence;
+  const char *outsequence;
   const char *target;
   int had_err = 0;
 
@@ -144,12 +143,14 @@ static int extract_feature_sequence_generic(GtStr *sequence, GtGenomeNode *gn,
       /* otherwise we only have to look at this feature */
       range = gt_genome_node_get_range(gn);
       gt_assert(range.start); /* 1-based coordinates */
-      had_err = gt_region_mapping_get_sequence(region_mapping, &outsequence,
-                                               gt_genome_node_get_seqid(gn),
-                                               range.start, range.end, err);
+      had_err = gt_region_mapping_get_sequence_view(region_mapping,
+                                                    &outsequence,
+                                                    gt_genome_node_get_seqid(
+                                                                           gn),
+                                                    range.start, range.end,
+                                                    err);
       if (!had_err) {
         gt_str_append_cstr_nt(sequence, outsequence, gt_range_length(&range));
-        gt_free(outsequence);
         if (gt_feature_node_get_strand(fn) == GT_STRAND_REVERSE) {
           had_err = gt_reverse_complement(gt_str_get(sequence),
                                           gt_str_length(sequence), err);
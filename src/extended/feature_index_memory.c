@@ -24,7 +24,6 @@
 #include "core/cstr_api.h"
 #include "core/ensure.h"
 #include "core/hashmap.h"
-#include "core/interval_tree.h"
 #include "core/ma.h"
 #include "core/minmax.h"
 #include "core/range.h"
@@ -34,12 +33,14 @@
 #include "extended/feature_index_rep.h"
 #include "extended/feature_index.h"
 #include "extended/feature_node.h"
+#include "extended/feature_store.h"
 #include "extended/genome_node.h"
 
 struct GtFeatureIndexMemory {
   const GtFeatureIndex parent_instance;
   GtHashmap *regions;
   GtHashmap *nodes_in_index;
+  GtFeatureStore *store;
   GtArray *ids;
   char *firstseqid;
   GtUword nof_region_nodes,
@@ -50,15 +51,30 @@ struct GtFeatureIndexMemory {
 #define gt_feature_index_memory_cast(FI)\
         gt_feature_index_cast(gt_feature_index_memory_class(), FI)
 
+/* The ranges of the features are kept in a <GtFeatureStore>, the feature with
+   index i in its columns of a sequence id is stored at position i of
+   <features> (or NULL if it was removed). */
 typedef struct {
-  GtIntervalTree *features;
+  GtArray *features;
   GtRegionNode *region;
   GtRange dyn_range;
 } RegionInfo;
 
+static RegionInfo* region_info_new(void)
+{
+  RegionInfo *info = gt_calloc(1, sizeof (RegionInfo));
+  info->features = gt_array_new(sizeof (GtGenomeNode*));
+  info->dyn_range.start = ~0UL;
+  info->dyn_range.end   = 0;
+  return info;
+}
+
 static void region_info_delete(RegionInfo *info)
 {
-  gt_interval_tree_delete(info->features);
+  GtUword i;
+  for (i = 0; i < gt_array_size(info->features); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(info->features, i));
+  gt_array_delete(info->features);
   if (info->region)
     gt_genome_node_delete((GtGenomeNode*)info->region);
   gt_free(info);
@@ -75,12 +91,8 @@ int gt_feature_index_memory_add_region_node(GtFeatureIndex *gfi,
   gt_assert(fi && rn);
   seqid = gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) rn));
   if (!gt_hashmap_get(fi->regions, seqid)) {
-    info = gt_calloc(1, sizeof (RegionInfo));
+    info = region_info_new();
     info->region = (GtRegionNode*) gt_genome_node_ref((GtGenomeNode*) rn);
-    info->features = gt_interval_tree_new((GtFree)
-                                          gt_genome_node_delete);
-    info->dyn_range.start = ~0UL;
-    info->dyn_range.end   = 0;
     gt_hashmap_add(fi->regions, seqid, info);
     if (fi->nof_region_nodes++ == 0)
       fi->firstseqid = seqid;
@@ -97,7 +109,7 @@ int gt_feature_index_memory_add_feature_node(GtFeatureIndex *gfi,
   GtFeatureIndexMemory *fi;
   GtRange node_range;
   RegionInfo *info;
-  GtIntervalTreeNode *new_node;
+  GT_UNUSED GtUword idx;
   gt_assert(gfi && fn);
 
   fi = gt_feature_index_memory_cast(gfi);
@@ -114,42 +126,22 @@ int gt_feature_index_memory_add_feature_node(GtFeatureIndex *gfi,
      index entry and maintain our own GtRange. */
   if (!info)
   {
-    info = gt_calloc(1, sizeof (RegionInfo));
-    info->region = NULL;
-    info->features = gt_interval_tree_new((GtFree)
-                                          gt_genome_node_delete);
-    info->dyn_range.start = ~0UL;
-    info->dyn_range.end   = 0;
+    info = region_info_new();
     gt_hashmap_add(fi->regions, seqid, info);
     if (fi->nof_region_nodes++ == 0)
       fi->firstseqid = seqid;
   }
 
-  /* add node to the appropriate array in the hashtable */
-  new_node = gt_interval_tree_node_new(gn, node_range.start, node_range.end);
-  gt_interval_tree_insert(info->features, new_node);
+  /* add node to the feature store and the appropriate array */
+  idx = gt_feature_store_add_top_level_feature(fi->store, fn);
+  gt_assert(idx == gt_array_size(info->features));
+  gt_array_add(info->features, gn);
   /* update dynamic range */
   info->dyn_range.start = MIN(info->dyn_range.start, node_range.start);
   info->dyn_range.end = MAX(info->dyn_range.end, node_range.end);
   return 0;
 }
 
-typedef struct {
-  GtIntervalTreeNode *node;
-  GtGenomeNode *genome_node;
-} GtFeatureIndexMemoryByPtrExtractInfo;
-
-static int gt_feature_index_memory_get_itreenode_by_ptr(GtIntervalTreeNode *n,
-                                                        void *data)
-{
-  GtFeatureIndexMemoryByPtrExtractInfo *i =
-                                   (GtFeatureIndexMemoryByPtrExtractInfo*) data;
-  if (i->genome_node == gt_interval_tree_node_get_data(n)) {
-    i->node = n;
-  }
-  return 0;
-}
-
 int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
                                         GtFeatureNode *gn,
                                         GT_UNUSED GtError *err)
@@ -157,8 +149,10 @@ int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
   char* seqid;
   GtFeatureIndexMemory *fi;
   GtRange node_range;
-  GtFeatureIndexMemoryByPtrExtractInfo info;
+  GtArray *indices;
+  GtGenomeNode **features;
   RegionInfo *rinfo;
+  GtUword i;
   gt_assert(gfi && gn);
 
   fi = gt_feature_index_memory_cast(gfi);
@@ -169,26 +163,29 @@ int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
   rinfo = (RegionInfo*) gt_hashmap_get(fi->regions, seqid);
   if (!rinfo)
     return 0;
-  info.genome_node = (GtGenomeNode*) gn;
-  info.node = NULL;
-
-  gt_interval_tree_iterate_overlapping(rinfo->features,
-                                   gt_feature_index_memory_get_itreenode_by_ptr,
-                                   node_range.start,
-                                   node_range.end,
-                                   &info);
 
-  if (info.node)
-    gt_interval_tree_remove(rinfo->features, info.node);
+  indices = gt_array_new(sizeof (GtUword));
+  gt_feature_store_get_range_features(fi->store, indices, seqid, &node_range);
+  features = gt_array_get_space(rinfo->features);
+  for (i = 0; i < gt_array_size(indices); i++) {
+    GtUword idx = *(GtUword*) gt_array_get(indices, i);
+    if (features[idx] == (GtGenomeNode*) gn) {
+      gt_hashmap_remove(fi->nodes_in_index, gn);
+      gt_genome_node_delete(features[idx]);
+      features[idx] = NULL;
+      break;
+    }
+  }
+  gt_array_delete(indices);
   return 0;
 }
 
-static int collect_features_from_itree(GtIntervalTreeNode *node, void *data)
+static int gt_genome_node_cmp_range_start(const void *v1, const void *v2)
 {
-  GtArray *a = (GtArray*) data;
-  GtGenomeNode *gn = (GtGenomeNode*) gt_interval_tree_node_get_data(node);
-  gt_array_add(a, gn);
-  return 0;
+  GtGenomeNode *n1, *n2;
+  n1 = *(GtGenomeNode**) v1;
+  n2 = *(GtGenomeNode**) v2;
+  return gt_genome_node_compare(&n1, &n2);
 }
 
 GtArray* gt_feature_index_memory_get_features_for_seqid(GtFeatureIndex *gfi,
@@ -196,30 +193,24 @@ GtArray* gt_feature_index_memory_get_features_for_seqid(GtFeatureIndex *gfi,
                                                         GT_UNUSED GtError *err)
 {
   RegionInfo *ri;
-  GT_UNUSED int had_err = 0;
   GtArray *a;
   GtFeatureIndexMemory *fi;
+  GtUword i;
   gt_assert(gfi && seqid);
   fi = gt_feature_index_memory_cast(gfi);
   a = gt_array_new(sizeof (GtFeatureNode*));
   ri = (RegionInfo*) gt_hashmap_get(fi->regions, seqid);
   if (ri) {
-    had_err = gt_interval_tree_traverse(ri->features,
-                                        collect_features_from_itree,
-                                        a);
+    for (i = 0; i < gt_array_size(ri->features); i++) {
+      GtGenomeNode *gn = *(GtGenomeNode**) gt_array_get(ri->features, i);
+      if (gn)
+        gt_array_add(a, gn);
+    }
+    gt_array_sort(a, gt_genome_node_cmp_range_start);
   }
-  gt_assert(!had_err);   /* collect_features_from_itree() is sane */
   return a;
 }
 
-static int gt_genome_node_cmp_range_start(const void *v1, const void *v2)
-{
-  GtGenomeNode *n1, *n2;
-  n1 = *(GtGenomeNode**) v1;
-  n2 = *(GtGenomeNode**) v2;
-  return gt_genome_node_compare(&n1, &n2);
-}
-
 int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
                                                    GtArray *results,
                                                    const char *seqid,
@@ -228,6 +219,8 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
 {
   RegionInfo *ri;
   GtFeatureIndexMemory *fi;
+  GtArray *indices;
+  GtUword i;
   gt_error_check(err);
   gt_assert(gfi && results);
 
@@ -237,8 +230,16 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
     gt_error_set(err, "feature index does not contain the given sequence id");
     return -1;
   }
-  gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
-                                        qry_range->end, results);
+  indices = gt_array_new(sizeof (GtUword));
+  gt_feature_store_get_range_features(fi->store, indices, seqid, qry_range);
+  for (i = 0; i < gt_array_size(indices); i++) {
+    GtGenomeNode *gn = *(GtGenomeNode**)
+                       gt_array_get(ri->features,
+                                    *(GtUword*) gt_array_get(indices, i));
+    if (gn)
+      gt_array_add(results, gn);
+  }
+  gt_array_delete(indices);
   gt_array_sort(results, gt_genome_node_cmp_range_start);
   return 0;
 }
@@ -358,6 +359,7 @@ void gt_feature_index_memory_delete(GtFeatureIndex *gfi)
   fi = gt_feature_index_memory_cast(gfi);
   gt_hashmap_delete(fi->regions);
   gt_hashmap_delete(fi->nodes_in_index);
+  gt_feature_store_delete(fi->store);
 }
 
 const GtFeatureIndexClass* gt_feature_index_memory_class(void)
@@ -393,6 +395,7 @@ GtFeatureIndex* gt_feature_index_memory_new(void)
   fim->regions = gt_hashmap_new(GT_HASH_STRING, NULL,
                                 (GtFree) region_info_delete);
   fim->nodes_in_index = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  fim->store = gt_feature_store_new();
   return fi;
 }
 
@@ -1284,6 +1284,17 @@ bool gt_feature_node_is_tree(GtFeatureNode *fn)
   return status;
 }
 
+bool gt_feature_node_determine_is_tree(GtFeatureNode *fn)
+{
+  GT_UNUSED int had_err;
+  gt_assert(fn);
+  if (get_tree_status(fn->bit_field) == TREE_STATUS_UNDETERMINED) {
+    had_err = gt_feature_node_traverse_children(fn, NULL, NULL, true, NULL);
+    gt_assert(!had_err); /* cannot happen, no traverse function is given */
+  }
+  return gt_feature_node_is_tree(fn);
+}
+
 bool gt_feature_node_overlaps_nodes(GtFeatureNode *fn, GtArray *nodes)
 {
   return gt_feature_node_overlaps_nodes_mark(fn, nodes, NULL);
@@ -75,6 +75,10 @@ bool           gt_feature_node_direct_children_do_not_overlap_st(GtFeatureNode
                                                                  GtFeatureNode
                                                                  *child);
 bool           gt_feature_node_is_tree(GtFeatureNode*);
+/* Like <gt_feature_node_is_tree()>, but if the tree status of <fn> has not
+   been determined yet (e.g., because children were added after the last
+   traversal), it is determined by traversing <fn>. */
+bool           gt_feature_node_determine_is_tree(GtFeatureNode *fn);
 /* Returns <true> if the <feature_node> overlaps at least one of the nodes given
    in the <array>. O(<gt_array_size(array)>). */
 bool           gt_feature_node_overlaps_nodes(GtFeatureNode *feature_node,
@@ -0,0 +1,527 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/hashmap.h"
+#include "core/ma.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/feature_store.h"
+#include "extended/feature_type.h"
+
+typedef struct {
+  GtArray *type,
+          *start,
+          *end,
+          *parent,
+          *strand,
+          *score,
+          *roots,         /* indices of the top-level features */
+          *roots_max_end; /* maximum end of the first i + 1 roots */
+  bool roots_sorted;      /* roots are sorted by their start position */
+} FeatureColumns;
+
+struct GtFeatureStore {
+  GtHashmap *columns,  /* seqid -> FeatureColumns */
+            *type_ids; /* type -> unsigned int */
+  GtStrArray *types;
+  GtUword num_of_features;
+};
+
+static FeatureColumns* feature_columns_new(void)
+{
+  FeatureColumns *fc = gt_malloc(sizeof *fc);
+  fc->type = gt_array_new(sizeof (unsigned int));
+  fc->start = gt_array_new(sizeof (GtUword));
+  fc->end = gt_array_new(sizeof (GtUword));
+  fc->parent = gt_array_new(sizeof (GtUword));
+  fc->strand = gt_array_new(sizeof (unsigned char));
+  fc->score = gt_array_new(sizeof (float));
+  fc->roots = gt_array_new(sizeof (GtUword));
+  fc->roots_max_end = gt_array_new(sizeof (GtUword));
+  fc->roots_sorted = true;
+  return fc;
+}
+
+static void feature_columns_delete(FeatureColumns *fc)
+{
+  if (!fc) return;
+  gt_array_delete(fc->type);
+  gt_array_delete(fc->start);
+  gt_array_delete(fc->end);
+  gt_array_delete(fc->parent);
+  gt_array_delete(fc->strand);
+  gt_array_delete(fc->score);
+  gt_array_delete(fc->roots);
+  gt_array_delete(fc->roots_max_end);
+  gt_free(fc);
+}
+
+GtFeatureStore* gt_feature_store_new(void)
+{
+  GtFeatureStore *fs = gt_malloc(sizeof *fs);
+  fs->columns = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                               (GtFree) feature_columns_delete);
+  fs->type_ids = gt_hashmap_new(GT_HASH_STRING, gt_free_func, gt_free_func);
+  fs->types = gt_str_array_new();
+  fs->num_of_features = 0;
+  return fs;
+}
+
+static unsigned int feature_store_type_id(GtFeatureStore *fs, const char *type)
+{
+  unsigned int *type_id;
+  gt_assert(fs && type);
+  if (!(type_id = gt_hashmap_get(fs->type_ids, type))) {
+    type_id = gt_malloc(sizeof *type_id);
+    *type_id = (unsigned int) gt_str_array_size(fs->types);
+    gt_str_array_add_cstr(fs->types, type);
+    gt_hashmap_add(fs->type_ids, gt_cstr_dup(type), type_id);
+  }
+  return *type_id;
+}
+
+static GtUword feature_columns_add(FeatureColumns *fc, GtFeatureStore *fs,
+                                   GtFeatureNode *fn, GtUword parent)
+{
+  GtUword idx, max_end;
+  GtRange range;
+  unsigned int type_id;
+  unsigned char strand;
+  float score;
+  gt_assert(fc && fs && fn);
+  idx = gt_array_size(fc->start);
+  range = gt_genome_node_get_range((GtGenomeNode*) fn);
+  type_id = feature_store_type_id(fs, gt_feature_node_is_pseudo(fn)
+                                      ? "" : gt_feature_node_get_type(fn));
+  strand = (unsigned char) gt_feature_node_get_strand(fn);
+  score = gt_feature_node_score_is_defined(fn)
+          ? gt_feature_node_get_score(fn)
+          : GT_UNDEF_FLOAT;
+  gt_array_add(fc->type, type_id);
+  gt_array_add(fc->start, range.start);
+  gt_array_add(fc->end, range.end);
+  gt_array_add(fc->parent, parent);
+  gt_array_add(fc->strand, strand);
+  gt_array_add(fc->score, score);
+  if (parent == GT_UNDEF_UWORD) {
+    max_end = range.end;
+    if (gt_array_size(fc->roots)) {
+      GtUword last_root = *(GtUword*) gt_array_get_last(fc->roots),
+              last_max_end = *(GtUword*) gt_array_get_last(fc->roots_max_end);
+      if (range.start < *(GtUword*) gt_array_get(fc->start, last_root))
+        fc->roots_sorted = false;
+      if (last_max_end > max_end)
+        max_end = last_max_end;
+    }
+    gt_array_add(fc->roots, idx);
+    gt_array_add(fc->roots_max_end, max_end);
+  }
+  fs->num_of_features++;
+  return idx;
+}
+
+static FeatureColumns* feature_store_seqid_columns(GtFeatureStore *fs,
+                                                   GtFeatureNode *fn)
+{
+  FeatureColumns *fc;
+  const char *seqid;
+  gt_assert(fs && fn);
+  seqid = gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) fn));
+  if (!(fc = gt_hashmap_get(fs->columns, seqid))) {
+    fc = feature_columns_new();
+    gt_hashmap_add(fs->columns, gt_cstr_dup(seqid), fc);
+  }
+  return fc;
+}
+
+void gt_feature_store_add_feature_node(GtFeatureStore *fs, GtFeatureNode *fn)
+{
+  FeatureColumns *fc;
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *node, *child;
+  GtArray *nodes, *indices;
+  GtHashmap *added = NULL;
+  GtUword i, idx;
+  gt_assert(fs && fn);
+
+  fc = feature_store_seqid_columns(fs, fn);
+
+  /* in a DAG a node can be reached more than once, it is stored only once */
+  if (!gt_feature_node_determine_is_tree(fn))
+    added = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+
+  /* breadth-first traversal, parents are added before their children */
+  nodes = gt_array_new(sizeof (GtFeatureNode*));
+  indices = gt_array_new(sizeof (GtUword));
+  if (gt_feature_node_is_pseudo(fn)) {
+    fni = gt_feature_node_iterator_new_direct(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      if (added) {
+        if (gt_hashmap_get(added, child))
+          continue;
+        gt_hashmap_add(added, child, child);
+      }
+      idx = feature_columns_add(fc, fs, child, GT_UNDEF_UWORD);
+      gt_array_add(nodes, child);
+      gt_array_add(indices, idx);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  else {
+    if (added)
+      gt_hashmap_add(added, fn, fn);
+    idx = feature_columns_add(fc, fs, fn, GT_UNDEF_UWORD);
+    gt_array_add(nodes, fn);
+    gt_array_add(indices, idx);
+  }
+  for (i = 0; i < gt_array_size(nodes); i++) {
+    node = *(GtFeatureNode**) gt_array_get(nodes, i);
+    idx = *(GtUword*) gt_array_get(indices, i);
+    fni = gt_feature_node_iterator_new_direct(node);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      GtUword child_idx;
+      if (added) {
+        if (gt_hashmap_get(added, child))
+          continue;
+        gt_hashmap_add(added, child, child);
+      }
+      child_idx = feature_columns_add(fc, fs, child, idx);
+      gt_array_add(nodes, child);
+      gt_array_add(indices, child_idx);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  gt_array_delete(indices);
+  gt_array_delete(nodes);
+  gt_hashmap_delete(added);
+}
+
+GtUword gt_feature_store_add_top_level_feature(GtFeatureStore *fs,
+                                               GtFeatureNode *fn)
+{
+  gt_assert(fs && fn);
+  return feature_columns_add(feature_store_seqid_columns(fs, fn), fs, fn,
+                             GT_UNDEF_UWORD);
+}
+
+int gt_feature_store_add_stream(GtFeatureStore *fs, GtNodeStream *in_stream,
+                                GtError *err)
+{
+  GtGenomeNode *gn;
+  GtFeatureNode *fn;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(fs && in_stream);
+  while (!(had_err = gt_node_stream_next(in_stream, &gn, err)) && gn) {
+    if ((fn = gt_feature_node_try_cast(gn)))
+      gt_feature_store_add_feature_node(fs, fn);
+    gt_genome_node_delete(gn);
+  }
+  return had_err;
+}
+
+GtUword gt_feature_store_size(const GtFeatureStore *fs)
+{
+  gt_assert(fs);
+  return fs->num_of_features;
+}
+
+static int store_seqid(void *key, GT_UNUSED void *value, void *data,
+                       GT_UNUSED GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(key && data);
+  gt_str_array_add_cstr((GtStrArray*) data, (const char*) key);
+  return 0;
+}
+
+GtStrArray* gt_feature_store_get_seqids(const GtFeatureStore *fs)
+{
+  GtStrArray *seqids;
+  GT_UNUSED int had_err;
+  gt_assert(fs);
+  seqids = gt_str_array_new();
+  had_err = gt_hashmap_foreach_in_key_order(fs->columns, store_seqid, seqids,
+                                            NULL);
+  gt_assert(!had_err); /* store_seqid() is sane */
+  return seqids;
+}
+
+bool gt_feature_store_get_columns(const GtFeatureStore *fs,
+                                  GtFeatureColumns *columns, const char *seqid)
+{
+  FeatureColumns *fc;
+  gt_assert(fs && columns && seqid);
+  if (!(fc = gt_hashmap_get(fs->columns, seqid)))
+    return false;
+  columns->num_of_features = gt_array_size(fc->start);
+  columns->type = gt_array_get_space(fc->type);
+  columns->start = gt_array_get_space(fc->start);
+  columns->end = gt_array_get_space(fc->end);
+  columns->parent = gt_array_get_space(fc->parent);
+  columns->strand = gt_array_get_space(fc->strand);
+  columns->score = gt_array_get_space(fc->score);
+  return true;
+}
+
+const char* gt_feature_store_get_type(const GtFeatureStore *fs,
+                                      unsigned int type_id)
+{
+  gt_assert(fs && type_id < gt_str_array_size(fs->types));
+  return gt_str_array_get(fs->types, type_id);
+}
+
+bool gt_feature_store_get_type_id(const GtFeatureStore *fs,
+                                  unsigned int *type_id, const char *type)
+{
+  unsigned int *stored_type_id;
+  gt_assert(fs && type_id && type);
+  if (!(stored_type_id = gt_hashmap_get(fs->type_ids, type)))
+    return false;
+  *type_id = *stored_type_id;
+  return true;
+}
+
+GtUword gt_feature_store_count_type(const GtFeatureStore *fs,
+                                    const char *seqid, const char *type)
+{
+  GtFeatureColumns columns;
+  GtUword i, count = 0;
+  unsigned int type_id;
+  gt_assert(fs && seqid && type);
+  if (!gt_feature_store_get_type_id(fs, &type_id, type) ||
+      !gt_feature_store_get_columns(fs, &columns, seqid)) {
+    return 0;
+  }
+  for (i = 0; i < columns.num_of_features; i++)
+    count += columns.type[i] == type_id;
+  return count;
+}
+
+void gt_feature_store_get_range_features(const GtFeatureStore *fs,
+                                         GtArray *results, const char *seqid,
+                                         const GtRange *range)
+{
+  FeatureColumns *fc;
+  const GtUword *roots, *roots_max_end, *start, *end;
+  GtUword i, lb, ub, mid;
+  gt_assert(fs && results && seqid && range);
+  gt_assert(range->start <= range->end);
+  if (!(fc = gt_hashmap_get(fs->columns, seqid)))
+    return;
+  roots = gt_array_get_space(fc->roots);
+  roots_max_end = gt_array_get_space(fc->roots_max_end);
+  start = gt_array_get_space(fc->start);
+  end = gt_array_get_space(fc->end);
+  lb = 0;
+  ub = gt_array_size(fc->roots);
+  if (fc->roots_sorted) {
+    /* skip the roots which start after the range */
+    GtUword lo = 0, hi = ub;
+    while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if (start[roots[mid]] <= range->end)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    ub = lo;
+    /* skip the roots which (like all roots before them) end before the
+       range */
+    lo = 0;
+    hi = ub;
+    while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if (roots_max_end[mid] < range->start)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    lb = lo;
+  }
+  for (i = lb; i < ub; i++) {
+    GtUword idx = roots[i];
+    if (start[idx] <= range->end && end[idx] >= range->start)
+      gt_array_add(results, idx);
+  }
+}
+
+void gt_feature_store_delete(GtFeatureStore *fs)
+{
+  if (!fs) return;
+  gt_hashmap_delete(fs->columns);
+  gt_hashmap_delete(fs->type_ids);
+  gt_str_array_delete(fs->types);
+  gt_free(fs);
+}
+
+int gt_feature_store_unit_test(GtError *err)
+{
+  GtFeatureStore *fs;
+  GtGenomeNode *gene, *mRNA_1, *mRNA_2, *exon, *cds, *other, *pseudo;
+  GtFeatureColumns columns;
+  GtStrArray *seqids;
+  GtArray *results;
+  GtStr *chr1, *chr2;
+  GtRange range;
+  unsigned int type_id;
+  int had_err = 0;
+  gt_error_check(err);
+
+  chr1 = gt_str_new_cstr("chr1");
+  chr2 = gt_str_new_cstr("chr2");
+  fs = gt_feature_store_new();
+  results = gt_array_new(sizeof (GtUword));
+
+  /* gene with two mRNAs sharing an exon (a DAG) */
+  gene = gt_feature_node_new(chr1, gt_ft_gene, 100, 500, GT_STRAND_FORWARD);
+  gt_feature_node_set_score((GtFeatureNode*) gene, 0.5);
+  mRNA_1 = gt_feature_node_new(chr1, gt_ft_mRNA, 100, 500, GT_STRAND_FORWARD);
+  mRNA_2 = gt_feature_node_new(chr1, gt_ft_mRNA, 100, 300, GT_STRAND_FORWARD);
+  exon = gt_feature_node_new(chr1, gt_ft_exon, 100, 300, GT_STRAND_FORWARD);
+  cds = gt_feature_node_new(chr1, gt_ft_CDS, 400, 500, GT_STRAND_FORWARD);
+  gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) mRNA_1);
+  gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) mRNA_2);
+  gt_feature_node_add_child((GtFeatureNode*) mRNA_1, (GtFeatureNode*) exon);
+  gt_feature_node_add_child((GtFeatureNode*) mRNA_2,
+                            (GtFeatureNode*)
+                            gt_genome_node_ref(exon));
+  gt_feature_node_add_child((GtFeatureNode*) mRNA_1, (GtFeatureNode*) cds);
+  gt_feature_store_add_feature_node(fs, (GtFeatureNode*) gene);
+  gt_ensure(gt_feature_store_size(fs) == 5);
+
+  /* a long top-level feature which starts later */
+  other = gt_feature_node_new(chr1, gt_ft_repeat_region, 200, 2000,
+                              GT_STRAND_REVERSE);
+  gt_feature_store_add_feature_node(fs, (GtFeatureNode*) other);
+
+  /* two top-level features in a pseudo-feature on another sequence */
+  pseudo = gt_feature_node_new_pseudo(chr2, 10, 80, GT_STRAND_FORWARD);
+  gt_feature_node_add_child((GtFeatureNode*) pseudo, (GtFeatureNode*)
+                            gt_feature_node_new(chr2, gt_ft_gene, 10, 50,
+                                                GT_STRAND_FORWARD));
+  gt_feature_node_add_child((GtFeatureNode*) pseudo, (GtFeatureNode*)
+                            gt_feature_node_new(chr2, gt_ft_gene, 60, 80,
+                                                GT_STRAND_FORWARD));
+  gt_feature_store_add_feature_node(fs, (GtFeatureNode*) pseudo);
+  gt_ensure(gt_feature_store_size(fs) == 8);
+
+  /* sequence ids */
+  seqids = gt_feature_store_get_seqids(fs);
+  gt_ensure(gt_str_array_size(seqids) == 2);
+  if (!had_err) {
+    gt_ensure(!strcmp(gt_str_array_get(seqids, 0), "chr1"));
+    gt_ensure(!strcmp(gt_str_array_get(seqids, 1), "chr2"));
+  }
+  gt_str_array_delete(seqids);
+
+  /* columns */
+  gt_ensure(!gt_feature_store_get_columns(fs, &columns, "chr3"));
+  gt_ensure(gt_feature_store_get_columns(fs, &columns, "chr1"));
+  if (!had_err) {
+    gt_ensure(columns.num_of_features == 6);
+    gt_ensure(!strcmp(gt_feature_store_get_type(fs, columns.type[0]),
+                      gt_ft_gene));
+    gt_ensure(columns.start[0] == 100 && columns.end[0] == 500);
+    gt_ensure(columns.score[0] == 0.5);
+    gt_ensure(columns.parent[0] == GT_UNDEF_UWORD);
+    gt_ensure(columns.parent[1] == 0 && columns.parent[2] == 0);
+    /* the children are sorted, the shorter mRNA comes first */
+    gt_ensure(columns.end[1] == 300 && columns.end[2] == 500);
+    /* the shared exon is stored once, below its first parent */
+    gt_ensure(columns.parent[3] == 1 && columns.parent[4] == 2);
+    gt_ensure(!strcmp(gt_feature_store_get_type(fs, columns.type[3]),
+                      gt_ft_exon));
+    gt_ensure(columns.score[3] == GT_UNDEF_FLOAT);
+    gt_ensure(columns.strand[5] == GT_STRAND_REVERSE);
+    gt_ensure(columns.parent[5] == GT_UNDEF_UWORD);
+  }
+  gt_ensure(gt_feature_store_get_columns(fs, &columns, "chr2"));
+  if (!had_err) {
+    gt_ensure(columns.num_of_features == 2);
+    gt_ensure(columns.parent[0] == GT_UNDEF_UWORD);
+    gt_ensure(columns.parent[1] == GT_UNDEF_UWORD);
+  }
+
+  /* types */
+  gt_ensure(gt_feature_store_get_type_id(fs, &type_id, gt_ft_mRNA));
+  gt_ensure(!gt_feature_store_get_type_id(fs, &type_id, gt_ft_intron));
+  gt_ensure(gt_feature_store_count_type(fs, "chr1", gt_ft_mRNA) == 2);
+  gt_ensure(gt_feature_store_count_type(fs, "chr1", gt_ft_gene) == 1);
+  gt_ensure(gt_feature_store_count_type(fs, "chr2", gt_ft_gene) == 2);
+  gt_ensure(gt_feature_store_count_type(fs, "chr2", gt_ft_intron) == 0);
+
+  /* range queries */
+  range.start = 1;
+  range.end = 99;
+  gt_feature_store_get_range_features(fs, results, "chr1", &range);
+  gt_ensure(gt_array_size(results) == 0);
+  range.start = 150;
+  range.end = 250;
+  gt_feature_store_get_range_features(fs, results, "chr1", &range);
+  gt_ensure(gt_array_size(results) == 2);
+  if (!had_err) {
+    gt_ensure(*(GtUword*) gt_array_get(results, 0) == 0);
+    gt_ensure(*(GtUword*) gt_array_get(results, 1) == 5);
+  }
+  gt_array_reset(results);
+  range.start = 1000;
+  range.end = 3000;
+  gt_feature_store_get_range_features(fs, results, "chr1", &range);
+  gt_ensure(gt_array_size(results) == 1);
+  gt_array_reset(results);
+  range.start = 55;
+  range.end = 58;
+  gt_feature_store_get_range_features(fs, results, "chr2", &range);
+  gt_ensure(gt_array_size(results) == 0);
+  range.end = 60;
+  gt_feature_store_get_range_features(fs, results, "chr2", &range);
+  gt_ensure(gt_array_size(results) == 1);
+  if (!had_err)
+    gt_ensure(*(GtUword*) gt_array_get(results, 0) == 1);
+
+  /* a single top-level feature, the pseudo-feature itself is stored */
+  gt_ensure(gt_feature_store_add_top_level_feature(fs, (GtFeatureNode*)
+                                                   pseudo) == 2);
+  gt_ensure(gt_feature_store_size(fs) == 9);
+  gt_ensure(gt_feature_store_get_columns(fs, &columns, "chr2"));
+  if (!had_err) {
+    gt_ensure(columns.num_of_features == 3);
+    gt_ensure(!strcmp(gt_feature_store_get_type(fs, columns.type[2]), ""));
+    gt_ensure(columns.start[2] == 10 && columns.end[2] == 80);
+  }
+  gt_array_reset(results);
+  gt_feature_store_get_range_features(fs, results, "chr2", &range);
+  gt_ensure(gt_array_size(results) == 2);
+  if (!had_err)
+    gt_ensure(*(GtUword*) gt_array_get(results, 1) == 2);
+
+  gt_genome_node_delete(gene);
+  gt_genome_node_delete(other);
+  gt_genome_node_delete(pseudo);
+  gt_array_delete(results);
+  gt_feature_store_delete(fs);
+  gt_str_delete(chr1);
+  gt_str_delete(chr2);
+  return had_err;
+}
@@ -0,0 +1,100 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef FEATURE_STORE_H
+#define FEATURE_STORE_H
+
+#include "core/array_api.h"
+#include "core/range_api.h"
+#include "core/str_array_api.h"
+#include "extended/feature_node_api.h"
+#include "extended/node_stream_api.h"
+
+/* The <GtFeatureStore> class keeps features in a columnar representation:
+   For each sequence id there is one array per field (type id, start, end,
+   strand, score, and parent index), instead of one <GtFeatureNode> object
+   graph per feature. The attributes and the source are not stored. Scans over
+   single fields (and range queries over the top-level features) only touch the
+   columns they need. */
+typedef struct GtFeatureStore GtFeatureStore;
+
+/* A read-only view of the columns of one sequence id. Feature i has the type
+   with id <type[i]>, the range <start[i]>..<end[i]>, the strand <strand[i]>
+   (a <GtStrand> value), and the score <score[i]> (<GT_UNDEF_FLOAT> if it is
+   undefined). <parent[i]> is the index of the first parent of feature i, or
+   <GT_UNDEF_UWORD> for top-level features. Parents always precede their
+   children. The arrays are valid until the next feature is added. */
+typedef struct {
+  GtUword num_of_features;
+  const unsigned int *type;
+  const GtUword *start,
+                *end,
+                *parent;
+  const unsigned char *strand;
+  const float *score;
+} GtFeatureColumns;
+
+/* Return a new empty <GtFeatureStore>. */
+GtFeatureStore* gt_feature_store_new(void);
+/* Add the feature tree (or DAG) rooted at <fn> to <fs>. Pseudo-features are not
+   stored, their children become top-level features. */
+void            gt_feature_store_add_feature_node(GtFeatureStore *fs,
+                                                  GtFeatureNode *fn);
+/* Add <fn> without its children to <fs> as a top-level feature and return its
+   index in the columns of its sequence id. Unlike in
+   <gt_feature_store_add_feature_node()>, a pseudo-feature is stored itself,
+   with the empty type. */
+GtUword         gt_feature_store_add_top_level_feature(GtFeatureStore *fs,
+                                                       GtFeatureNode *fn);
+/* Pull all nodes from <in_stream>, add the feature nodes to <fs>, and delete
+   the nodes right away. That is, at most one feature tree of the stream is
+   kept as an object graph at a time. */
+int             gt_feature_store_add_stream(GtFeatureStore *fs,
+                                            GtNodeStream *in_stream,
+                                            GtError *err);
+/* Return the number of features stored in <fs>. */
+GtUword         gt_feature_store_size(const GtFeatureStore *fs);
+/* Return the sorted sequence ids of <fs>. The caller is responsible to free
+   it. */
+GtStrArray*     gt_feature_store_get_seqids(const GtFeatureStore *fs);
+/* Set <columns> to the columns of <seqid> and return true, or return false if
+   <fs> contains no features for <seqid>. */
+bool            gt_feature_store_get_columns(const GtFeatureStore *fs,
+                                             GtFeatureColumns *columns,
+                                             const char *seqid);
+/* Return the type with the given <type_id>. */
+const char*     gt_feature_store_get_type(const GtFeatureStore *fs,
+                                          unsigned int type_id);
+/* Set <type_id> to the id of <type> and return true, or return false if no
+   feature in <fs> has <type>. */
+bool            gt_feature_store_get_type_id(const GtFeatureStore *fs,
+                                             unsigned int *type_id,
+                                             const char *type);
+/* Return the number of features of <type> on <seqid>. */
+GtUword         gt_feature_store_count_type(const GtFeatureStore *fs,
+                                            const char *seqid,
+                                            const char *type);
+/* Add the indices (of type <GtUword>) of all top-level features on <seqid>
+   which overlap <range> to <results>, in the order they were added. */
+void            gt_feature_store_get_range_features(const GtFeatureStore *fs,
+                                                   GtArray *results,
+                                                   const char *seqid,
+                                                   const GtRange *range);
+void            gt_feature_store_delete(GtFeatureStore *fs);
+int             gt_feature_store_unit_test(GtError *err);
+
+#endif
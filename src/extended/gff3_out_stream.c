@@ -19,7 +19,7 @@
 #include "core/cstr_table.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_out_stream_api.h"
-#include "extended/gff3_visitor_api.h"
+#include "extended/gff3_visitor.h"
 #include "extended/node_stream_api.h"
 
 struct GtGFF3OutStream {
@@ -88,3 +88,11 @@ void gt_gff3_out_stream_retain_id_attributes(GtGFF3OutStream *gff3_out_stream)
   gt_gff3_visitor_retain_id_attributes((GtGFF3Visitor*)
                                        gff3_out_stream->gff3_visitor);
 }
+
+void gt_gff3_out_stream_enable_background_writing(GtGFF3OutStream
+                                                  *gff3_out_stream)
+{
+  gt_assert(gff3_out_stream);
+  gt_gff3_visitor_enable_background_writing((GtGFF3Visitor*)
+                                            gff3_out_stream->gff3_visitor);
+}
@@ -43,5 +43,11 @@ void          gt_gff3_out_stream_set_fasta_width(GtGFF3OutStream
    avoid ID collisions. */
 void          gt_gff3_out_stream_retain_id_attributes(GtGFF3OutStream
                                                       *gff3_out_stream);
+/* Write (and compress) the output of <gff3_out_stream> in a separate thread
+   while the next part of the output is formatted. The output is written in
+   large chunks, therefore <gff3_out_stream> must be the only writer to its
+   <outfp> until it is deleted. */
+void          gt_gff3_out_stream_enable_background_writing(GtGFF3OutStream
+                                                           *gff3_out_stream);
 
 #endif
@@ -18,6 +18,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include "core/array.h"
 #include "core/assert_api.h"
 #include "core/fasta.h"
 #include "core/file.h"
@@ -27,25 +28,35 @@
 #include "core/string_distri.h"
 #include "core/cstr_table.h"
 #include "core/str_api.h"
+#include "core/thread_api.h"
 #include "core/warning_api.h"
+#include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_defines.h"
 #include "extended/gff3_output.h"
 #include "extended/gff3_visitor.h"
 #include "extended/node_visitor_api.h"
 
+/* number of bytes collected before they are handed to the writer thread */
+#define GFF3_VISITOR_BACKGROUND_CHUNK  (1UL << 20)
+
 struct GtGFF3Visitor {
   const GtNodeVisitor parent_instance;
   bool version_string_shown,
        retain_ids,
        fasta_directive_shown,
-       allow_nonunique_ids;
+       allow_nonunique_ids,
+       background_writing;
   GtStringDistri *id_counter;
   GtHashmap *feature_node_to_id_array,
             *feature_node_to_unique_id_str;
   GtUword fasta_width;
   GtFile *outfp;
-  GtStr *outstr;
+  GtStr *outstr,
+        *buffer,
+        *writebuffer;
+  GtThread *writer;
+  GtArray *id_slots;
   GtCstrTable *used_ids;
 };
 
@@ -56,27 +67,95 @@ typedef struct {
 
 typedef struct {
   bool *attribute_shown;
-  GtFile *outfp;
   GtStr *outstr;
 } ShowAttributeInfo;
 
 #define gff3_visitor_cast(GV)\
         gt_node_visitor_cast(gt_gff3_visitor_class(), GV)
 
+/* Returns the string the output is appended to. If the visitor writes to a
+   file, this is a buffer which is written by <gff3_visitor_flush()>. */
+static GtStr* gff3_visitor_out(GtGFF3Visitor *gff3_visitor)
+{
+  return gff3_visitor->outstr ? gff3_visitor->outstr : gff3_visitor->buffer;
+}
+
+static void* gff3_visitor_write_thread(void *data)
+{
+  GtGFF3Visitor *gff3_visitor = data;
+  gt_file_xwrite(gff3_visitor->outfp,
+                 gt_str_get_mem(gff3_visitor->writebuffer),
+                 (size_t) gt_str_length(gff3_visitor->writebuffer));
+  return NULL;
+}
+
+static void gff3_visitor_join_writer(GtGFF3Visitor *gff3_visitor)
+{
+#ifdef GT_THREADS_ENABLED
+  if (gff3_visitor->writer) {
+    gt_thread_join(gff3_visitor->writer);
+    gt_thread_delete(gff3_visitor->writer);
+    gff3_visitor->writer = NULL;
+  }
+#else
+  gt_assert(!gff3_visitor->writer);
+#endif
+}
+
+/* Writes the buffered output. Without background writing, this happens after
+   every visited node, such that the output is never reordered with respect to
+   other writes to the same file. With background writing, the output is
+   collected in chunks which are written (and compressed) by a separate thread
+   while the next chunk is formatted. Without thread support, the chunks are
+   written directly. */
+static void gff3_visitor_flush(GtGFF3Visitor *gff3_visitor, bool final)
+{
+  GtStr *tmp;
+  if (gff3_visitor->outstr)
+    return;
+  if (!gff3_visitor->background_writing) {
+    if (gt_str_length(gff3_visitor->buffer)) {
+      gt_file_xwrite(gff3_visitor->outfp, gt_str_get_mem(gff3_visitor->buffer),
+                     (size_t) gt_str_length(gff3_visitor->buffer));
+      gt_str_reset(gff3_visitor->buffer);
+    }
+    return;
+  }
+  if (gt_str_length(gff3_visitor->buffer) >= GFF3_VISITOR_BACKGROUND_CHUNK ||
+      (final && gt_str_length(gff3_visitor->buffer))) {
+    gff3_visitor_join_writer(gff3_visitor);
+    tmp = gff3_visitor->writebuffer;
+    gff3_visitor->writebuffer = gff3_visitor->buffer;
+    gff3_visitor->buffer = tmp;
+    gt_str_reset(gff3_visitor->buffer);
+#ifdef GT_THREADS_ENABLED
+    {
+      GtError *err = gt_error_new();
+      if (!(gff3_visitor->writer = gt_thread_new(gff3_visitor_write_thread,
+                                                 gff3_visitor, err))) {
+        /* write in this thread instead */
+        (void) gff3_visitor_write_thread(gff3_visitor);
+      }
+      gt_error_delete(err);
+    }
+#else
+    (void) gff3_visitor_write_thread(gff3_visitor);
+#endif
+  }
+  if (final)
+    gff3_visitor_join_writer(gff3_visitor);
+}
+
 static void gff3_version_string(GtNodeVisitor *nv)
 {
   GtGFF3Visitor *gff3_visitor = gff3_visitor_cast(nv);
   gt_assert(gff3_visitor);
   if (!gff3_visitor->version_string_shown) {
-    if (!gff3_visitor->outstr) {
-      gt_file_xprintf(gff3_visitor->outfp, "%s %u\n", GT_GFF_VERSION_PREFIX,
-                      GT_GFF_VERSION);
-    } else {
-      gt_str_append_cstr(gff3_visitor->outstr, GT_GFF_VERSION_PREFIX);
-      gt_str_append_cstr(gff3_visitor->outstr, " ");
-      gt_str_append_uint(gff3_visitor->outstr, GT_GFF_VERSION);
-      gt_str_append_char(gff3_visitor->outstr, '\n');
-    }
+    GtStr *out = gff3_visitor_out(gff3_visitor);
+    gt_str_append_cstr(out, GT_GFF_VERSION_PREFIX);
+    gt_str_append_char(out, ' ');
+    gt_str_append_uint(out, GT_GFF_VERSION);
+    gt_str_append_char(out, '\n');
     gff3_visitor->version_string_shown = true;
   }
 }
@@ -84,11 +163,18 @@ static void gff3_version_string(GtNodeVisitor *nv)
 static void gff3_visitor_free(GtNodeVisitor *nv)
 {
   GtGFF3Visitor *gff3_visitor = gff3_visitor_cast(nv);
+  GtUword i;
   gt_assert(gff3_visitor);
+  gff3_visitor_flush(gff3_visitor, true);
   gt_string_distri_delete(gff3_visitor->id_counter);
   gt_hashmap_delete(gff3_visitor->feature_node_to_id_array);
   gt_hashmap_delete(gff3_visitor->feature_node_to_unique_id_str);
   gt_cstr_table_delete(gff3_visitor->used_ids);
+  for (i = 0; i < gt_array_size(gff3_visitor->id_slots); i++)
+    gt_str_delete(*(GtStr**) gt_array_get(gff3_visitor->id_slots, i));
+  gt_array_delete(gff3_visitor->id_slots);
+  gt_str_delete(gff3_visitor->writebuffer);
+  gt_str_delete(gff3_visitor->buffer);
   gt_str_delete(gff3_visitor->outstr);
   gt_file_delete(gff3_visitor->outfp);
 }
@@ -97,18 +183,16 @@ static int gff3_visitor_comment_node(GtNodeVisitor *nv, GtCommentNode *cn,
                                      GT_UNUSED GtError *err)
 {
   GtGFF3Visitor *gff3_visitor;
+  GtStr *out;
   gt_error_check(err);
   gff3_visitor = gff3_visitor_cast(nv);
   gt_assert(nv && cn);
   gff3_version_string(nv);
-  if (!gff3_visitor->outstr) {
-    gt_file_xprintf(gff3_visitor->outfp, "#%s\n",
-                    gt_comment_node_get_comment(cn));
-  } else  {
-    gt_str_append_char(gff3_visitor->outstr, '#');
-    gt_str_append_cstr(gff3_visitor->outstr, gt_comment_node_get_comment(cn));
-    gt_str_append_char(gff3_visitor->outstr, '\n');
-  }
+  out = gff3_visitor_out(gff3_visitor);
+  gt_str_append_char(out, '#');
+  gt_str_append_cstr(out, gt_comment_node_get_comment(cn));
+  gt_str_append_char(out, '\n');
+  gff3_visitor_flush(gff3_visitor, false);
   return 0;
 }
 
@@ -133,129 +217,98 @@ static void show_attribute(const char *attr_name, const char *attr_value,
   ShowAttributeInfo *info = (ShowAttributeInfo*) data;
   gt_assert(attr_name && attr_value && info);
   if (strcmp(attr_name, GT_GFF_ID) && strcmp(attr_name, GT_GFF_PARENT)) {
-    if (*info->attribute_shown) {
-      if (!info->outstr)
-        gt_file_xfputc(';', info->outfp);
-      else
-        gt_str_append_char(info->outstr, ';');
-    } else
+    if (*info->attribute_shown)
+      gt_str_append_char(info->outstr, ';');
+    else
       *info->attribute_shown = true;
-    if (!info->outstr)
-      gt_file_xprintf(info->outfp, "%s=%s", attr_name, attr_value);
-    else {
-      gt_str_append_cstr(info->outstr, attr_name);
-      gt_str_append_char(info->outstr, '=');
-      gt_str_append_cstr(info->outstr, attr_value);
-    }
+    gt_str_append_cstr(info->outstr, attr_name);
+    gt_str_append_char(info->outstr, '=');
+    gt_str_append_cstr(info->outstr, attr_value);
   }
 }
 
-static int gff3_show_feature_node(GtFeatureNode *fn, void *data,
-                                  GT_UNUSED GtError *err)
+/* Shows the line for <fn> with ID <id> and the 'Parent' attribute made of the
+   <num_of_parents> IDs in <parent_ids>. <id> may be NULL. */
+static void gff3_show_feature_line(GtGFF3Visitor *gff3_visitor,
+                                   GtFeatureNode *fn, const GtStr *id,
+                                   const char **parent_ids,
+                                   GtUword num_of_parents)
 {
   bool part_shown = false;
-  GtGFF3Visitor *gff3_visitor = (GtGFF3Visitor*) data;
-  GtArray *parent_features = NULL;
+  GtStr *out = gff3_visitor_out(gff3_visitor);
   ShowAttributeInfo info;
   GtUword i;
-  GtStr *id;
-
-  gt_error_check(err);
-  gt_assert(fn && gff3_visitor);
 
   /* output leading part */
-  if (!gff3_visitor->outstr) {
-    gt_gff3_output_leading(fn, gff3_visitor->outfp);
-  } else {
-    gt_gff3_output_leading_str(fn, gff3_visitor->outstr);
-  }
+  gt_gff3_output_leading_str(fn, out);
 
   /* show unique id part of attributes */
-  if ((id = gt_hashmap_get(gff3_visitor->feature_node_to_unique_id_str, fn))) {
-    if (!gff3_visitor->outstr)
-      gt_file_xprintf(gff3_visitor->outfp, "%s=%s", GT_GFF_ID, gt_str_get(id));
-    else {
-      gt_str_append_cstr(gff3_visitor->outstr, GT_GFF_ID);
-      gt_str_append_char(gff3_visitor->outstr, '=');
-      gt_str_append_cstr(gff3_visitor->outstr, gt_str_get(id));
-    }
+  if (id) {
+    gt_str_append_cstr(out, GT_GFF_ID);
+    gt_str_append_char(out, '=');
+    gt_str_append_str(out, id);
     part_shown = true;
   }
 
   /* show parent part of attributes */
-  parent_features = gt_hashmap_get(gff3_visitor->feature_node_to_id_array, fn);
-  if (gt_array_size(parent_features)) {
-    if (part_shown) {
-      if (!gff3_visitor->outstr)
-        gt_file_xfputc(';', gff3_visitor->outfp);
-      else
-        gt_str_append_char(gff3_visitor->outstr, ';');
-    }
-    if (!gff3_visitor->outstr)
-      gt_file_xprintf(gff3_visitor->outfp, "%s=", GT_GFF_PARENT);
-    else {
-      gt_str_append_cstr(gff3_visitor->outstr, GT_GFF_PARENT);
-      gt_str_append_char(gff3_visitor->outstr, '=');
-    }
-    for (i = 0; i < gt_array_size(parent_features); i++) {
-      if (i) {
-        if (!gff3_visitor->outstr)
-          gt_file_xfputc(',', gff3_visitor->outfp);
-        else
-          gt_str_append_char(gff3_visitor->outstr, ',');
-      }
-      if (!gff3_visitor->outstr) {
-        gt_file_xprintf(gff3_visitor->outfp, "%s",
-                        *(char**) gt_array_get(parent_features, i));
-      } else {
-        gt_str_append_cstr(gff3_visitor->outstr,
-                           *(char**) gt_array_get(parent_features, i));
-      }
+  if (num_of_parents) {
+    if (part_shown)
+      gt_str_append_char(out, ';');
+    gt_str_append_cstr(out, GT_GFF_PARENT);
+    gt_str_append_char(out, '=');
+    for (i = 0; i < num_of_parents; i++) {
+      if (i)
+        gt_str_append_char(out, ',');
+      gt_str_append_cstr(out, parent_ids[i]);
     }
     part_shown = true;
   }
 
   /* show missing part of attributes */
   info.attribute_shown = &part_shown;
-  info.outfp = gff3_visitor->outfp;
-  info.outstr = gff3_visitor->outstr;
+  info.outstr = out;
   gt_feature_node_foreach_attribute(fn, show_attribute, &info);
 
   /* show dot if no attributes have been shown */
-  if (!part_shown) {
-    if (!gff3_visitor->outstr)
-      gt_file_xfputc('.', gff3_visitor->outfp);
-    else
-      gt_str_append_char(gff3_visitor->outstr, '.');
-  }
+  if (!part_shown)
+    gt_str_append_char(out, '.');
 
   /* show terminal newline */
-  if (!gff3_visitor->outstr)
-    gt_file_xfputc('\n', gff3_visitor->outfp);
-  else
-    gt_str_append_char(gff3_visitor->outstr, '\n');
+  gt_str_append_char(out, '\n');
+}
 
+static int gff3_show_feature_node(GtFeatureNode *fn, void *data,
+                                  GT_UNUSED GtError *err)
+{
+  GtGFF3Visitor *gff3_visitor = (GtGFF3Visitor*) data;
+  GtArray *parent_features;
+
+  gt_error_check(err);
+  gt_assert(fn && gff3_visitor);
+
+  parent_features = gt_hashmap_get(gff3_visitor->feature_node_to_id_array, fn);
+  gff3_show_feature_line(gff3_visitor, fn,
+                         gt_hashmap_get(gff3_visitor
+                                        ->feature_node_to_unique_id_str, fn),
+                         parent_features
+                         ? gt_array_get_space(parent_features) : NULL,
+                         parent_features ? gt_array_size(parent_features) : 0);
   return 0;
 }
 
-static GtStr* create_unique_id(GtGFF3Visitor *gff3_visitor, GtFeatureNode *fn)
+static void create_unique_id(GtGFF3Visitor *gff3_visitor, GtFeatureNode *fn,
+                             GtStr *id)
 {
   const char *type;
-  GtStr *id;
-  gt_assert(gff3_visitor && fn);
+  gt_assert(gff3_visitor && fn && id);
   type = gt_feature_node_get_type(fn);
 
   /* increase id counter */
   gt_string_distri_add(gff3_visitor->id_counter, type);
 
   /* build id string */
-  id = gt_str_new_cstr(type);
+  gt_str_set(id, type);
   gt_str_append_uword(id, gt_string_distri_get(gff3_visitor->id_counter, type));
-
-  /* store (unique) id */
-  gt_hashmap_add(gff3_visitor->feature_node_to_unique_id_str, fn, id);
-
-  return id;
 }
 
 static void make_unique_id_string(GtStr *current_id, GtUword counter)
@@ -274,10 +327,11 @@ static bool id_string_is_unique(GtStr *id, GtStr *buf, GtCstrTable *tab,
   return !gt_cstr_table_get(tab, gt_str_get(buf));
 }
 
-static GtStr* make_id_unique(GtGFF3Visitor *gff3_visitor, GtFeatureNode *fn)
+static void make_id_unique(GtGFF3Visitor *gff3_visitor, GtFeatureNode *fn,
+                           GtStr *id)
 {
   GtUword i = 1;
-  GtStr *id = gt_str_new_cstr(gt_feature_node_get_attribute(fn, "ID"));
+  gt_str_set(id, gt_feature_node_get_attribute(fn, "ID"));
 
   if (!gff3_visitor->allow_nonunique_ids) {
     if (gt_cstr_table_get(gff3_visitor->used_ids, gt_str_get(id))) {
@@ -291,10 +345,41 @@ static GtStr* make_id_unique(GtGFF3Visitor *gff3_visitor, GtFeatureNode *fn)
     /* update table with the new id */
     gt_cstr_table_add(gff3_visitor->used_ids, gt_str_get(id));
   }
+}
 
-  /* store (unique) id */
-  gt_hashmap_add(gff3_visitor->feature_node_to_unique_id_str, fn, id);
+/* Returns true if <fn> is shown with an ID attribute. */
+static bool gff3_visitor_needs_id(const GtGFF3Visitor *gff3_visitor,
+                                  GtFeatureNode *fn)
+{
+  return gt_feature_node_has_children(fn) || gt_feature_node_is_multi(fn) ||
+         (gff3_visitor->retain_ids && gt_feature_node_get_attribute(fn, "ID"));
+}
 
+/* Returns the ID of feature <fn>, which must need one. The IDs of
+   multi-features are stored for their representative, all other IDs are
+   stored in <id>. */
+static GtStr* gff3_visitor_get_id(GtGFF3Visitor *gff3_visitor,
+                                  GtFeatureNode *fn, GtStr *id)
+{
+  if (gt_feature_node_is_multi(fn)) {
+    GtFeatureNode *rep = gt_feature_node_get_multi_representative(fn);
+    GtStr *rep_id = gt_hashmap_get(gff3_visitor->feature_node_to_unique_id_str,
+                                   rep);
+    if (!rep_id) {
+      /* the representative does not have its own id yet -> create it */
+      rep_id = gt_str_new();
+      if (gff3_visitor->retain_ids)
+        make_id_unique(gff3_visitor, rep, rep_id);
+      else
+        create_unique_id(gff3_visitor, rep, rep_id);
+      gt_hashmap_add(gff3_visitor->feature_node_to_unique_id_str, rep, rep_id);
+    }
+    return rep_id;
+  }
+  if (gff3_visitor->retain_ids)
+    make_id_unique(gff3_visitor, fn, id);
+  else
+    create_unique_id(gff3_visitor, fn, id);
   return id;
 }
 
@@ -308,22 +393,9 @@ static int store_ids(GtFeatureNode *fn, void *data, GtError *err)
   gt_error_check(err);
   gt_assert(fn && gff3_visitor);
 
-  if (gt_feature_node_has_children(fn) || gt_feature_node_is_multi(fn) ||
-      (gff3_visitor->retain_ids && gt_feature_node_get_attribute(fn, "ID"))) {
+  if (gff3_visitor_needs_id(gff3_visitor, fn)) {
     if (gt_feature_node_is_multi(fn)) {
-      id = gt_hashmap_get(gff3_visitor->feature_node_to_unique_id_str,
-                          gt_feature_node_get_multi_representative(fn));
-      if (!id) {
-        /* the representative does not have its own id yet -> create it */
-        if (gff3_visitor->retain_ids) {
-          id = make_id_unique(gff3_visitor,
-                              gt_feature_node_get_multi_representative(fn));
-        }
-        else {
-          id = create_unique_id(gff3_visitor,
-                                gt_feature_node_get_multi_representative(fn));
-        }
-      }
+      id = gff3_visitor_get_id(gff3_visitor, fn, NULL);
       /* store id for feature, if the feature was not the representative */
       if (gt_feature_node_get_multi_representative(fn) != fn) {
         gt_hashmap_add(gff3_visitor->feature_node_to_unique_id_str, fn,
@@ -331,10 +403,8 @@ static int store_ids(GtFeatureNode *fn, void *data, GtError *err)
       }
     }
     else {
-      if (gff3_visitor->retain_ids)
-        id = make_id_unique(gff3_visitor, fn);
-      else
-        id = create_unique_id(gff3_visitor, fn);
+      id = gff3_visitor_get_id(gff3_visitor, fn, gt_str_new());
+      gt_hashmap_add(gff3_visitor->feature_node_to_unique_id_str, fn, id);
     }
     /* for each child -> store the parent feature in the hash map */
     add_id_info.gt_feature_node_to_id_array =
@@ -346,48 +416,79 @@ static int store_ids(GtFeatureNode *fn, void *data, GtError *err)
   return had_err;
 }
 
+/* Shows the tree rooted in <fn> at nesting level <depth> in depth first order,
+   which is the order of <gt_feature_node_traverse_children()>. In a tree every
+   feature has at most one parent, hence the ID of the parent is passed down
+   in <parent_id> and the IDs are kept in one slot per level instead of being
+   stored per feature. */
+static void gff3_show_tree(GtGFF3Visitor *gff3_visitor, GtFeatureNode *fn,
+                           const char *parent_id, GtUword depth)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *child;
+  GtStr *id = NULL;
+
+  if (!gt_feature_node_is_pseudo(fn)) {
+    if (depth == gt_array_size(gff3_visitor->id_slots)) {
+      GtStr *slot = gt_str_new();
+      gt_array_add(gff3_visitor->id_slots, slot);
+    }
+    if (gff3_visitor_needs_id(gff3_visitor, fn)) {
+      id = gff3_visitor_get_id(gff3_visitor, fn,
+                               *(GtStr**) gt_array_get(gff3_visitor->id_slots,
+                                                       depth));
+    }
+    gff3_show_feature_line(gff3_visitor, fn, id, &parent_id,
+                           parent_id ? 1UL : 0);
+    depth++;
+  }
+  if (gt_feature_node_has_children(fn)) {
+    fni = gt_feature_node_iterator_new_direct(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      gff3_show_tree(gff3_visitor, child, id ? gt_str_get(id) : NULL,
+                     depth);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+}
+
 static int gff3_visitor_feature_node(GtNodeVisitor *nv, GtFeatureNode *fn,
                                      GtError *err)
 {
   GtGFF3Visitor *gff3_visitor;
-  int had_err;
+  int had_err = 0;
   gt_error_check(err);
   gff3_visitor = gff3_visitor_cast(nv);
 
   gff3_version_string(nv);
 
-  had_err = gt_feature_node_traverse_children(fn, gff3_visitor, store_ids, true,
-                                              err);
-  if (!had_err) {
-    if (gt_feature_node_is_tree(fn)) {
-      had_err = gt_feature_node_traverse_children(fn, gff3_visitor,
-                                                  gff3_show_feature_node, true,
-                                                  err);
-    }
-    else {
+  if (gt_feature_node_determine_is_tree(fn))
+    gff3_show_tree(gff3_visitor, fn, NULL, 0);
+  else {
+    had_err = gt_feature_node_traverse_children(fn, gff3_visitor, store_ids,
+                                                true, err);
+    if (!had_err) {
       /* got a DAG -> traverse in topologically sorted depth first fashion to
          make sure that the 'Parent' attributes are shown in correct order */
       had_err =
         gt_feature_node_traverse_children_top(fn, gff3_visitor,
                                               gff3_show_feature_node, err);
     }
+    gt_hashmap_reset(gff3_visitor->feature_node_to_id_array);
   }
 
-  /* reset hashmaps */
-  gt_hashmap_reset(gff3_visitor->feature_node_to_id_array);
+  /* reset hashmap */
   gt_hashmap_reset(gff3_visitor->feature_node_to_unique_id_str);
 
   /* show terminator, if the feature has children (otherwise it is clear that
      the feature is complete, because no ID attribute has been shown) */
   if (gt_feature_node_has_children(fn) ||
       (gff3_visitor->retain_ids && gt_feature_node_get_attribute(fn, "ID"))) {
-    if (!gff3_visitor->outstr)
-      gt_file_xprintf(gff3_visitor->outfp, "%s\n", GT_GFF_TERMINATOR);
-    else {
-      gt_str_append_cstr(gff3_visitor->outstr, GT_GFF_TERMINATOR);
-      gt_str_append_char(gff3_visitor->outstr, '\n');
-    }
+    GtStr *out = gff3_visitor_out(gff3_visitor);
+    gt_str_append_cstr(out, GT_GFF_TERMINATOR);
+    gt_str_append_char(out, '\n');
   }
+  gff3_visitor_flush(gff3_visitor, false);
 
   return had_err;
 }
@@ -397,6 +498,7 @@ static int gff3_visitor_meta_node(GtNodeVisitor *nv, GtMetaNode *mn,
 {
   GtGFF3Visitor *gff3_visitor;
   const char *data;
+  GtStr *out;
   gt_error_check(err);
   gff3_visitor = gff3_visitor_cast(nv);
   gt_assert(nv && mn);
@@ -411,23 +513,15 @@ static int gff3_visitor_meta_node(GtNodeVisitor *nv, GtMetaNode *mn,
     }
   }
   data = gt_meta_node_get_data(mn);
-  if (!gff3_visitor->outstr) {
-    if (data) {
-      gt_file_xprintf(gff3_visitor->outfp, "##%s %s\n",
-                      gt_meta_node_get_directive(mn), data);
-    } else {
-      gt_file_xprintf(gff3_visitor->outfp, "##%s\n",
-                      gt_meta_node_get_directive(mn));
-    }
-  } else {
-    gt_str_append_cstr(gff3_visitor->outstr, "##");
-    gt_str_append_cstr(gff3_visitor->outstr, gt_meta_node_get_directive(mn));
-    if (data) {
-      gt_str_append_char(gff3_visitor->outstr, ' ');
-      gt_str_append_cstr(gff3_visitor->outstr, data);
-    }
-    gt_str_append_char(gff3_visitor->outstr, '\n');
+  out = gff3_visitor_out(gff3_visitor);
+  gt_str_append_cstr(out, "##");
+  gt_str_append_cstr(out, gt_meta_node_get_directive(mn));
+  if (data) {
+    gt_str_append_char(out, ' ');
+    gt_str_append_cstr(out, data);
   }
+  gt_str_append_char(out, '\n');
+  gff3_visitor_flush(gff3_visitor, false);
   return 0;
 }
 
@@ -435,29 +529,21 @@ static int gff3_visitor_region_node(GtNodeVisitor *nv, GtRegionNode *rn,
                                     GT_UNUSED GtError *err)
 {
   GtGFF3Visitor *gff3_visitor;
+  GtStr *out;
   gt_error_check(err);
   gff3_visitor = gff3_visitor_cast(nv);
   gt_assert(nv && rn);
   gff3_version_string(nv);
-  if (!gff3_visitor->outstr) {
-    gt_file_xprintf(gff3_visitor->outfp, "%s   %s "GT_WU" "GT_WU"\n",
-                    GT_GFF_SEQUENCE_REGION,
-                    gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) rn)),
-                    gt_genome_node_get_start((GtGenomeNode*) rn),
-                    gt_genome_node_get_end((GtGenomeNode*) rn));
-  } else {
-    gt_str_append_cstr(gff3_visitor->outstr, GT_GFF_SEQUENCE_REGION);
-    gt_str_append_cstr(gff3_visitor->outstr, "   ");
-    gt_str_append_cstr(gff3_visitor->outstr,
-                      gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) rn)));
-    gt_str_append_char(gff3_visitor->outstr, ' ');
-    gt_str_append_uword(gff3_visitor->outstr,
-                                  gt_genome_node_get_start((GtGenomeNode*) rn));
-    gt_str_append_char(gff3_visitor->outstr, ' ');
-    gt_str_append_uword(gff3_visitor->outstr,
-                                  gt_genome_node_get_end((GtGenomeNode*) rn));
-    gt_str_append_char(gff3_visitor->outstr, '\n');
-  }
+  out = gff3_visitor_out(gff3_visitor);
+  gt_str_append_cstr(out, GT_GFF_SEQUENCE_REGION);
+  gt_str_append_cstr(out, "   ");
+  gt_str_append_str(out, gt_genome_node_get_seqid((GtGenomeNode*) rn));
+  gt_str_append_char(out, ' ');
+  gt_str_append_uword(out, gt_genome_node_get_start((GtGenomeNode*) rn));
+  gt_str_append_char(out, ' ');
+  gt_str_append_uword(out, gt_genome_node_get_end((GtGenomeNode*) rn));
+  gt_str_append_char(out, '\n');
+  gff3_visitor_flush(gff3_visitor, false);
   return 0;
 }
 
@@ -465,30 +551,22 @@ static int gff3_visitor_sequence_node(GtNodeVisitor *nv, GtSequenceNode *sn,
                                       GT_UNUSED GtError *err)
 {
   GtGFF3Visitor *gff3_visitor;
+  GtStr *out;
   gt_error_check(err);
   gff3_visitor = gff3_visitor_cast(nv);
   gt_assert(nv && sn);
   gff3_version_string(nv);
+  out = gff3_visitor_out(gff3_visitor);
   if (!gff3_visitor->fasta_directive_shown) {
-    if (!gff3_visitor->outstr)
-      gt_file_xprintf(gff3_visitor->outfp, "%s\n", GT_GFF_FASTA_DIRECTIVE);
-    else {
-      gt_str_append_cstr(gff3_visitor->outstr, GT_GFF_FASTA_DIRECTIVE);
-      gt_str_append_char(gff3_visitor->outstr, '\n');
-    }
+    gt_str_append_cstr(out, GT_GFF_FASTA_DIRECTIVE);
+    gt_str_append_char(out, '\n');
     gff3_visitor->fasta_directive_shown = true;
   }
-  if (!gff3_visitor->outstr) {
-    gt_fasta_show_entry(gt_sequence_node_get_description(sn),
-                        gt_sequence_node_get_sequence(sn),
-                        gt_sequence_node_get_sequence_length(sn),
-                        gff3_visitor->fasta_width, gff3_visitor->outfp);
-  } else {
-    gt_fasta_show_entry_str(gt_sequence_node_get_description(sn),
-                            gt_sequence_node_get_sequence(sn),
-                            gt_sequence_node_get_sequence_length(sn),
-                            gff3_visitor->fasta_width, gff3_visitor->outstr);
-  }
+  gt_fasta_show_entry_str(gt_sequence_node_get_description(sn),
+                          gt_sequence_node_get_sequence(sn),
+                          gt_sequence_node_get_sequence_length(sn),
+                          gff3_visitor->fasta_width, out);
+  gff3_visitor_flush(gff3_visitor, false);
   return 0;
 }
 
@@ -498,9 +576,9 @@ static int gff3_visitor_eof_node(GtNodeVisitor *nv, GT_UNUSED GtEOFNode *en,
   gt_error_check(err);
   gt_assert(nv && en);
   gff3_version_string(nv);
+  gff3_visitor_flush(gff3_visitor_cast(nv), false);
   return 0;
 }
-
 const GtNodeVisitorClass* gt_gff3_visitor_class()
 {
   static GtNodeVisitorClass *nvc = NULL;
@@ -528,6 +606,11 @@ static void gt_gff3_visitor_init(GtGFF3Visitor *gff3_visitor)
     gt_hashmap_new(GT_HASH_DIRECT, NULL, (GtFree) gt_str_delete);
   gff3_visitor->fasta_width = 0;
   gff3_visitor->used_ids = gt_cstr_table_new();
+  gff3_visitor->id_slots = gt_array_new(sizeof (GtStr*));
+  gff3_visitor->buffer = NULL;
+  gff3_visitor->writebuffer = NULL;
+  gff3_visitor->writer = NULL;
+  gff3_visitor->background_writing = false;
   /* XXX */
   gff3_visitor->retain_ids = getenv("GT_RETAINIDS") ? true : false;
   gff3_visitor->allow_nonunique_ids = false;
@@ -540,6 +623,7 @@ GtNodeVisitor* gt_gff3_visitor_new(GtFile *outfp)
   gt_gff3_visitor_init(gff3_visitor);
   gff3_visitor->outfp = gt_file_ref(outfp);
   gff3_visitor->outstr = NULL;
+  gff3_visitor->buffer = gt_str_new();
   return nv;
 }
 
@@ -571,3 +655,11 @@ void gt_gff3_visitor_set_fasta_width(GtGFF3Visitor *gff3_visitor,
   gt_assert(gff3_visitor);
   gff3_visitor->fasta_width = fasta_width;
 }
+
+void gt_gff3_visitor_enable_background_writing(GtGFF3Visitor *gff3_visitor)
+{
+  gt_assert(gff3_visitor && !gff3_visitor->outstr);
+  gff3_visitor->background_writing = true;
+  if (!gff3_visitor->writebuffer)
+    gff3_visitor->writebuffer = gt_str_new();
+}
@@ -26,5 +26,11 @@ const GtNodeVisitorClass* gt_gff3_visitor_class(void);
 
 GtNodeVisitor*            gt_gff3_visitor_new_to_str(GtStr *outstr);
 void                      gt_gff3_visitor_allow_nonunique_ids(GtGFF3Visitor*);
+/* Collect the output of <gff3_visitor> in large chunks, which are written by
+   a separate thread (or directly, if <gt> was compiled without thread
+   support). <gff3_visitor> must write to a file and it must be the only writer
+   to it until it is deleted. */
+void                      gt_gff3_visitor_enable_background_writing(
+                                                 GtGFF3Visitor *gff3_visitor);
 
 #endif
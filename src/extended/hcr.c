@@ -35,9 +35,11 @@
 #include "core/intbits.h"
 #include "core/log_api.h"
 #include "core/ma_api.h"
+#include "core/minmax.h"
 #include "core/safearith.h"
 #include "core/seq_iterator_fastq_api.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
@@ -135,6 +137,7 @@ typedef struct GtHcrSeqDecoder {
 struct GtHcrDecoder {
   GtEncdesc       *encdesc;
   GtHcrSeqDecoder *seq_dec;
+  GtStr           *name;
 };
 
 typedef struct WriteNodeInfo {
@@ -833,6 +836,7 @@ GtHcrDecoder *gt_hcr_decoder_new(const char *name, GtAlphabet *alpha,
 
   hcr_dec = gt_malloc(sizeof (GtHcrDecoder));
   hcr_dec->seq_dec = NULL;
+  hcr_dec->name = gt_str_new_cstr(name);
 
   if (descs) {
     hcr_dec->encdesc = gt_encdesc_load(name, err);
@@ -981,8 +985,8 @@ int gt_hcr_decoder_decode(GtHcrDecoder *hcr_dec, GtUword readnum,
                            readnum,
                            &nearestsample,
                            &startofnearestsample);
-      /* nearestsample <= cur_read < readnum: current sample is the right one */
-      if (nearestsample <= current_read && current_read <= readnum)
+      /* nearestsample < cur_read < readnum: current sample is the right one */
+      if (nearestsample < current_read && current_read <= readnum)
         reads_to_read = readnum - current_read;
       else { /* reset decoder to new sample */
         reset_data_iterator_to_pos(data_iter, startofnearestsample);
@@ -1024,30 +1028,36 @@ int gt_hcr_decoder_decode(GtHcrDecoder *hcr_dec, GtUword readnum,
   return had_err;
 }
 
-int gt_hcr_decoder_decode_range(GtHcrDecoder *hcr_dec, const char *name,
-                                GtUword start, GtUword end, GtUword width,
-                                GtTimer *timer, GtError *err)
+static void hcr_write_line_with_width(const char *line, GtUword width,
+                                      FILE *output)
+{
+  size_t len = strlen(line),
+         pos = 0,
+         linewidth;
+
+  if (width == 0)
+    gt_xfwrite(line, sizeof (char), len, output);
+  else {
+    while (pos < len) {
+      if (pos > 0)
+        gt_xfputc('\n', output);
+      linewidth = MIN((size_t) width, len - pos);
+      gt_xfwrite(line + pos, sizeof (char), linewidth, output);
+      pos += linewidth;
+    }
+  }
+  gt_xfputc('\n', output);
+}
+
+static int hcr_decoder_write_range(GtHcrDecoder *hcr_dec, FILE *output,
+                                   GtUword start, GtUword end, GtUword width,
+                                   GtError *err)
 {
   char qual[BUFSIZ] = {0},
        seq[BUFSIZ] = {0};
   GtStr *desc = gt_str_new();
   int had_err = 0;
-  GtUword cur_width,
-                cur_read;
-  size_t i;
-  FILE *output;
-  GT_UNUSED GtHcrSeqDecoder *seq_dec;
-
-  gt_error_check(err);
-  gt_assert(hcr_dec && name);
-  seq_dec = hcr_dec->seq_dec;
-  gt_assert(start <= end);
-  gt_assert(start < seq_dec->num_of_reads && end < seq_dec->num_of_reads);
-  if (timer != NULL)
-    gt_timer_show_progress(timer, "decode hcr", stdout);
-  output = gt_fa_fopen_with_suffix(name, HCRFILEDECODEDSUFFIX, "w", err);
-  if (output == NULL)
-    had_err = -1;
+  GtUword cur_read;
 
   for (cur_read = start; had_err == 0 && cur_read <= end; cur_read++) {
     if (gt_hcr_decoder_decode(hcr_dec, cur_read, seq, qual, desc, err) != 0)
@@ -1059,28 +1069,151 @@ int gt_hcr_decoder_decode_range(GtHcrDecoder *hcr_dec, const char *name,
       else
         fprintf(output, ""GT_WU"", cur_read);
       gt_xfputc('\n', output);
-      for (i = 0, cur_width = 0; i < strlen(seq); i++, cur_width++) {
-        if (width != 0 && cur_width == width) {
-          cur_width = 0;
-          gt_xfputc('\n', output);
-        }
-        gt_xfputc(seq[i], output);
-      }
-      gt_xfputc('\n', output);
+      hcr_write_line_with_width(seq, width, output);
       gt_xfputc(HCR_DESCSEPQUAL, output);
       gt_xfputc('\n', output);
-      for (i = 0, cur_width = 0; i < strlen(qual); i++, cur_width++) {
-        if (width != 0 && cur_width == width) {
-          cur_width = 0;
-          gt_xfputc('\n', output);
-        }
-        gt_xfputc(qual[i], output);
+      hcr_write_line_with_width(qual, width, output);
+    }
+  }
+  gt_str_delete(desc);
+  return had_err;
+}
+
+typedef struct HcrDecodeRangePart {
+  GtHcrDecoder *hcr_dec;
+  FILE         *output;
+  GtError      *err;
+  GtThread     *thread;
+  GtUword       start,
+                end,
+                width;
+  int           had_err;
+} HcrDecodeRangePart;
+
+static void *hcr_decode_range_part(void *data)
+{
+  HcrDecodeRangePart *part = (HcrDecodeRangePart *) data;
+
+  part->had_err = hcr_decoder_write_range(part->hcr_dec, part->output,
+                                          part->start, part->end, part->width,
+                                          part->err);
+  return NULL;
+}
+
+static void hcr_append_tmpfile(FILE *output, FILE *tmpfp)
+{
+  char buffer[BUFSIZ];
+  size_t len;
+
+  rewind(tmpfp);
+  while ((len = fread(buffer, sizeof *buffer, sizeof buffer, tmpfp)) > 0)
+    gt_xfwrite(buffer, sizeof *buffer, len, output);
+}
+
+/* The range is split into <numofparts> parts, each decoded by its own decoder
+   starting from the nearest sample. All parts but the first are written to
+   temporary files which are appended in order. */
+static int hcr_decoder_write_range_in_parts(GtHcrDecoder *hcr_dec,
+                                            FILE *output, GtUword start,
+                                            GtUword end, GtUword width,
+                                            unsigned int numofparts,
+                                            GtError *err)
+{
+  HcrDecodeRangePart *parts;
+  GtUword numofreads = end - start + 1;
+  unsigned int p;
+  int had_err = 0;
+
+  parts = gt_calloc((size_t) numofparts, sizeof (*parts));
+  for (p = 0; p < numofparts; p++) {
+    parts[p].start = start + (GtUword) p * numofreads / numofparts;
+    parts[p].end = start + (GtUword) (p + 1) * numofreads / numofparts - 1;
+    parts[p].width = width;
+    parts[p].err = gt_error_new();
+    if (p == 0) {
+      parts[p].hcr_dec = hcr_dec;
+      parts[p].output = output;
+    }
+    else if (!had_err) {
+      parts[p].hcr_dec = gt_hcr_decoder_new(gt_str_get(hcr_dec->name),
+                                            hcr_dec->seq_dec->alpha,
+                                            hcr_dec->encdesc != NULL, NULL,
+                                            err);
+      if (parts[p].hcr_dec == NULL)
+        had_err = -1;
+      else
+        parts[p].output = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY |
+                                                  TMPFP_AUTOREMOVE);
+    }
+  }
+  if (!had_err) {
+#ifdef GT_THREADS_ENABLED
+    for (p = 1U; p < numofparts; p++) {
+      parts[p].thread = gt_thread_new(hcr_decode_range_part, parts + p, NULL);
+      if (parts[p].thread == NULL)
+        (void) hcr_decode_range_part(parts + p);
+    }
+    (void) hcr_decode_range_part(parts);
+    for (p = 1U; p < numofparts; p++) {
+      if (parts[p].thread != NULL) {
+        gt_thread_join(parts[p].thread);
+        gt_thread_delete(parts[p].thread);
       }
-      gt_xfputc('\n', output);
     }
+#else
+    for (p = 0; p < numofparts; p++)
+      (void) hcr_decode_range_part(parts + p);
+#endif
+  }
+  for (p = 0; p < numofparts; p++) {
+    if (!had_err && parts[p].had_err != 0) {
+      gt_error_set(err, "%s", gt_error_get(parts[p].err));
+      had_err = -1;
+    }
+    if (p > 0) {
+      if (!had_err)
+        hcr_append_tmpfile(output, parts[p].output);
+      gt_fa_xfclose(parts[p].output);
+      gt_hcr_decoder_delete(parts[p].hcr_dec);
+    }
+    gt_error_delete(parts[p].err);
+  }
+  gt_free(parts);
+  return had_err;
+}
+
+int gt_hcr_decoder_decode_range(GtHcrDecoder *hcr_dec, const char *name,
+                                GtUword start, GtUword end, GtUword width,
+                                GtTimer *timer, GtError *err)
+{
+  int had_err = 0;
+  unsigned int numofparts = gt_jobs;
+  FILE *output;
+  GT_UNUSED GtHcrSeqDecoder *seq_dec;
+
+  gt_error_check(err);
+  gt_assert(hcr_dec && name);
+  seq_dec = hcr_dec->seq_dec;
+  gt_assert(start <= end);
+  gt_assert(start < seq_dec->num_of_reads && end < seq_dec->num_of_reads);
+  if (timer != NULL)
+    gt_timer_show_progress(timer, "decode hcr", stdout);
+  output = gt_fa_fopen_with_suffix(name, HCRFILEDECODEDSUFFIX, "w", err);
+  if (output == NULL)
+    had_err = -1;
+
+  /* without sampling every part would have to decode from the start */
+  if (seq_dec->sampling == NULL || end - start + 1 < (GtUword) numofparts)
+    numofparts = 1U;
+  if (!had_err) {
+    if (numofparts > 1U)
+      had_err = hcr_decoder_write_range_in_parts(hcr_dec, output, start, end,
+                                                 width, numofparts, err);
+    else
+      had_err = hcr_decoder_write_range(hcr_dec, output, start, end, width,
+                                        err);
   }
   gt_fa_xfclose(output);
-  gt_str_delete(desc);
   return had_err;
 }
 
@@ -1338,6 +1471,7 @@ void gt_hcr_decoder_delete(GtHcrDecoder *hcr_dec)
   if (hcr_dec != NULL) {
     hcr_seq_decoder_delete(hcr_dec->seq_dec);
     gt_encdesc_delete(hcr_dec->encdesc);
+    gt_str_delete(hcr_dec->name);
     gt_free(hcr_dec);
   }
 }
@@ -24,12 +24,18 @@
 #include "core/log_api.h"
 #include "core/ma_api.h"
 #include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "core/safearith.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/huffcode.h"
 #include "extended/rbtree.h"
 
+/* number of bits used to index the decoding table and maximal number of
+   symbols decoded by one table lookup */
+#define GT_HUFFMAN_TABBITS    10U
+#define GT_HUFFMAN_TABSYMBOLS 3U
+
 typedef struct GtHuffmanSymbol {
   GtUint64 freq;
   GtUword      symbol;
@@ -48,6 +54,16 @@ typedef struct GtHuffmanTree {
   unsigned int          reference_count;
 } GtHuffmanTree;
 
+/* Entry of the decoding table for the next <GT_HUFFMAN_TABBITS> bits.
+   <bits[i]> is the number of bits consumed by the first i+1 symbols. If no
+   code is complete within these bits, <node> is the inner node reached. */
+typedef struct GtHuffmanDecodeEntry {
+  GtUword        symbols[GT_HUFFMAN_TABSYMBOLS];
+  GtHuffmanTree *node;
+  unsigned char  bits[GT_HUFFMAN_TABSYMBOLS],
+                 numofsymbols;
+} GtHuffmanDecodeEntry;
+
 struct GtHuffman {
   uint64_t       num_of_text_bits,    /* total bits needed to represent the text
                                        */
@@ -55,6 +71,8 @@ struct GtHuffman {
   GtHuffmanTree *root_huffman_tree;   /* stores the final huffmantree */
   GtRBTree      *rbt_root;            /* red black tree */
   GtHuffmanCode *code_tab;            /* table for encoding */
+  GtHuffmanDecodeEntry *decode_tab;   /* table for decoding, NULL if the
+                                         tree has less than two leaves */
   GtUword  num_of_coded_symbols, /* number of nodes in red black tree, */
                                       /* e.g. symbols with frequency > 0*/
                  num_of_symbols;      /* symbols with frequency >= 0 */
@@ -301,6 +319,40 @@ static void huffman_tree_set_codes_rec(GtHuffmanTree *h_tree)
   }
 }
 
+static void huffman_decode_tab_init(GtHuffman *huffman)
+{
+  GtUword idx, numofentries = 1UL << GT_HUFFMAN_TABBITS;
+
+  huffman->decode_tab = NULL;
+  if (huffman->root_huffman_tree == NULL ||
+      huffman->root_huffman_tree->leftchild == NULL)
+    return;
+  huffman->decode_tab = gt_malloc(sizeof (*huffman->decode_tab) *
+                                  numofentries);
+  for (idx = 0; idx < numofentries; idx++) {
+    GtHuffmanDecodeEntry *entry = huffman->decode_tab + idx;
+    GtHuffmanTree *node = huffman->root_huffman_tree;
+    unsigned int bitnum;
+
+    entry->numofsymbols = 0;
+    for (bitnum = 0;
+         bitnum < GT_HUFFMAN_TABBITS &&
+         entry->numofsymbols < (unsigned char) GT_HUFFMAN_TABSYMBOLS;
+         bitnum++) {
+      if ((idx >> (GT_HUFFMAN_TABBITS - 1 - bitnum)) & 1UL)
+        node = node->rightchild;
+      else
+        node = node->leftchild;
+      if (node->leftchild == NULL) {
+        entry->symbols[entry->numofsymbols] = node->symbol.symbol;
+        entry->bits[entry->numofsymbols++] = (unsigned char) (bitnum + 1);
+        node = huffman->root_huffman_tree;
+      }
+    }
+    entry->node = entry->numofsymbols == 0 ? node : NULL;
+  }
+}
+
 static inline int huffman_leaf_call_actfunc(GtHuffmanTree *h_tree,
                                             void *actinfo,
                                             GtHuffmanActFunc actfun) {
@@ -356,6 +408,7 @@ GtHuffman *gt_huffman_new(const void *distribution,
   huffman_tree_set_codes_rec(huff->root_huffman_tree);
   (void) gt_huffman_iterate(huff, calc_size, huff);
   (void) gt_huffman_iterate(huff, store_codes, huff);
+  huffman_decode_tab_init(huff);
 
   return huff;
 }
@@ -365,6 +418,7 @@ void gt_huffman_delete(GtHuffman *huffman)
   if (huffman != NULL) {
     gt_rbtree_delete(huffman->rbt_root);
     gt_free(huffman->code_tab);
+    gt_free(huffman->decode_tab);
   }
   gt_free(huffman);
 }
@@ -529,6 +583,47 @@ int gt_huffman_decoder_next(GtHuffmanDecoder *huff_decoder,
     /* huffman was initialized with empty dist */
     gt_assert(huff_decoder->cur_node != NULL);
 
+    /* decode up to GT_HUFFMAN_TABSYMBOLS symbols with one table lookup if the
+       current chunk contains enough bits */
+    if (huff_decoder->cur_node == huff_decoder->huffman->root_huffman_tree &&
+        huff_decoder->huffman->decode_tab != NULL &&
+        huff_decoder->cur_bit < (GtUword) GT_INTWORDSIZE &&
+        (huff_decoder->length - huff_decoder->cur_bitseq) * GT_INTWORDSIZE -
+        huff_decoder->cur_bit - huff_decoder->pad_length >=
+        (GtUword) GT_HUFFMAN_TABBITS) {
+      GtHuffmanDecodeEntry *entry;
+      GtBitsequence window = huff_decoder->bitsequence[huff_decoder->cur_bitseq]
+                             << huff_decoder->cur_bit;
+      GtUword idx, numofsymbols, consumed;
+
+      if (huff_decoder->cur_bit + GT_HUFFMAN_TABBITS > (GtUword) GT_INTWORDSIZE)
+        window |= huff_decoder->bitsequence[huff_decoder->cur_bitseq + 1] >>
+                  (GT_INTWORDSIZE - huff_decoder->cur_bit);
+      entry = huff_decoder->huffman->decode_tab +
+              (window >> (GT_INTWORDSIZE - GT_HUFFMAN_TABBITS));
+      if (entry->numofsymbols == 0) {
+        huff_decoder->cur_node = entry->node;
+        consumed = (GtUword) GT_HUFFMAN_TABBITS;
+      }
+      else {
+        numofsymbols = MIN((GtUword) entry->numofsymbols,
+                           symbols_to_read - read_symbols);
+        for (idx = 0; idx < numofsymbols; idx++)
+          gt_array_add(symbols, entry->symbols[idx]);
+        read_symbols += numofsymbols;
+        consumed = (GtUword) entry->bits[numofsymbols - 1];
+      }
+      huff_decoder->cur_bit += consumed;
+      if (huff_decoder->cur_bit > (GtUword) GT_INTWORDSIZE) {
+        huff_decoder->cur_bitseq++;
+        huff_decoder->cur_bit -= GT_INTWORDSIZE;
+        if (huff_decoder->cur_bitseq == huff_decoder->length - 1)
+          gt_safe_assign(bits_to_read,
+                         (GT_INTWORDSIZE - huff_decoder->pad_length));
+      }
+      continue;
+    }
+
     if (!had_err && huff_decoder->cur_bit == (GtUword) bits_to_read) {
       huff_decoder->cur_bitseq++;
 
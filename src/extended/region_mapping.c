@@ -16,6 +16,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "lua.h"
 #include "lauxlib.h"
 #include "lualib.h"
@@ -23,6 +24,7 @@
 #include "core/bioseq.h"
 #include "core/bioseq_col.h"
 #include "core/encseq_col.h"
+#include "core/fasta_index_col.h"
 #include "core/ma.h"
 #include "core/md5_seqid.h"
 #include "core/seq_col.h"
@@ -40,7 +42,8 @@ struct GtRegionMapping {
        usedesc,
        matchdescstart,
        userawseq,
-       useseqno;
+       useseqno,
+       usefastaindex;
   GtMapping *mapping;
   GtBioseq *bioseq; /* the current bioseq */
   GtEncseq *encseq;
@@ -49,6 +52,8 @@ struct GtRegionMapping {
   const char *rawseq;
   GtUword rawlength,
                 rawoffset;
+  char *seqbuf; /* decode buffer for sequence views */
+  GtUword seqbuf_size;
   unsigned int reference_count;
 };
 
@@ -125,6 +130,12 @@ void gt_region_mapping_enable_match_desc_start(GtRegionMapping *rm)
   rm->matchdescstart = true;
 }
 
+void gt_region_mapping_enable_fasta_index(GtRegionMapping *rm)
+{
+  gt_assert(rm && !rm->encseq && !rm->userawseq);
+  rm->usefastaindex = true;
+}
+
 GtRegionMapping* gt_region_mapping_ref(GtRegionMapping *rm)
 {
   gt_assert(rm);
@@ -143,6 +154,16 @@ static GtStr* region_mapping_map(GtRegionMapping *rm,
     return gt_mapping_map_string(rm->mapping, sequence_region, err);
 }
 
+static GtSeqCol* region_mapping_seq_col_new(GtRegionMapping *rm,
+                                            GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(rm && rm->sequence_filenames);
+  if (rm->usefastaindex)
+    return gt_fasta_index_col_new(rm->sequence_filenames, err);
+  return gt_bioseq_col_new(rm->sequence_filenames, err);
+}
+
 static int update_seq_col_if_necessary(GtRegionMapping *rm, GtStr *seqid,
                                        GtError *err)
 {
@@ -176,7 +197,7 @@ static int update_seq_col_if_necessary(GtRegionMapping *rm, GtStr *seqid,
           gt_str_reset(rm->sequence_name);
         gt_str_append_str(rm->sequence_name, seqid);
         gt_seq_col_delete(rm->seq_col);
-        rm->seq_col = gt_bioseq_col_new(rm->sequence_filenames, err);
+        rm->seq_col = region_mapping_seq_col_new(rm, err);
         if (!rm->seq_col)
           had_err = -1;
       }
@@ -188,17 +209,15 @@ static int update_seq_col_if_necessary(GtRegionMapping *rm, GtStr *seqid,
         if (!(rm->seq_col = gt_encseq_col_new(rm->encseq, err)))
           had_err = -1;
       } else {
-        gt_assert(rm->sequence_filenames);
-        if (!(rm->seq_col = gt_bioseq_col_new(rm->sequence_filenames, err)))
+        if (!(rm->seq_col = region_mapping_seq_col_new(rm, err)))
           had_err = -1;
       }
       /* handle -matchdescstart, i.e. load seqids into cache */
       if (!had_err && rm->seq_col && rm->matchdescstart)
           gt_seq_col_enable_match_desc_start(rm->seq_col);
     }
-    if (!had_err && rm->usedesc) {
-      if (rm->seqid2seqnum_mapping)
-        gt_seqid2seqnum_mapping_delete(rm->seqid2seqnum_mapping);
+    /* the seqcol does not change, build the mapping only once */
+    if (!had_err && rm->usedesc && !rm->seqid2seqnum_mapping) {
       rm->seqid2seqnum_mapping =
                            gt_seqid2seqnum_mapping_new_seqcol(rm->seq_col, err);
       if (!rm->seqid2seqnum_mapping) {
@@ -210,21 +229,22 @@ static int update_seq_col_if_necessary(GtRegionMapping *rm, GtStr *seqid,
   return had_err;
 }
 
-int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
-                                   GtStr *seqid, GtUword start,
-                                   GtUword end, GtError *err)
+int gt_region_mapping_get_sequence_view(GtRegionMapping *rm,
+                                        const char **seq, GtStr *seqid,
+                                        GtUword start, GtUword end,
+                                        GtError *err)
 {
   int had_err = 0;
-  GtUword offset = 1;
+  GtUword offset = 1, filenum = 0, seqnum = 0;
   GtRange range = {GT_UNDEF_UWORD, GT_UNDEF_UWORD};
   gt_error_check(err);
   gt_assert(rm && seq && seqid && gt_str_length(seqid) > 0);
+  gt_assert(start <= end);
 
   /* handle rawseq access first  */
   if (rm->userawseq) {
     gt_assert(!rm->seqid2seqnum_mapping);
-    *seq = gt_calloc(end - start + 1, sizeof (char));
-    strncpy(*seq, rm->rawseq + start - 1, (end - start + 1) * sizeof (char));
+    *seq = rm->rawseq + start - 1;
     return 0;
   }
 
@@ -232,20 +252,15 @@ int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
   had_err = update_seq_col_if_necessary(rm, seqid, err);
 
   /* MD5 sequence id */
-  if (!had_err) {
-    if (gt_md5_seqid_has_prefix(gt_str_get(seqid))) {
-      had_err = gt_seq_col_md5_to_seq(rm->seq_col, seq, start - offset,
-                                      end - offset, seqid, err);
-      return had_err;
-    }
+  if (!had_err && gt_md5_seqid_has_prefix(gt_str_get(seqid))) {
+    had_err = gt_seq_col_md5_to_index(rm->seq_col, &filenum, &seqnum, seqid,
+                                      err);
   }
-
   /* ``regular'' sequence ID */
-  if (!had_err) {
+  else if (!had_err) {
     gt_assert(!rm->usedesc || rm->seqid2seqnum_mapping);
     gt_assert(rm->mapping || rm->seq_col);
     if (rm->usedesc) {
-      GtUword seqnum, filenum;
       gt_assert(rm->seqid2seqnum_mapping);
       range.start = start;
       range.end = end;
@@ -268,16 +283,23 @@ int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
           had_err = -1;
         }
       }
-      if (!had_err) {
-        *seq = gt_seq_col_get_sequence(rm->seq_col, filenum, seqnum,
-                                       start - offset, end - offset);
-      }
     } else if (rm->matchdesc) {
       gt_assert(!rm->seqid2seqnum_mapping);
       gt_assert(rm->seq_col);
+      had_err = gt_seq_col_grep_desc_index(rm->seq_col, &filenum, &seqnum,
+                                           seqid, err);
       if (!had_err) {
-        had_err = gt_seq_col_grep_desc(rm->seq_col, seq, start - 1, end - 1,
-                                       seqid, err);
+        GtUword seqlength = gt_seq_col_get_sequence_length(rm->seq_col,
+                                                           filenum, seqnum);
+        if (start - 1 > seqlength - 1 || end - 1 > seqlength - 1) {
+          gt_error_set(err, "trying to extract range "GT_WU"-"GT_WU" on "
+                       "sequence ``%s'' which is not covered by that sequence "
+                       "(only "GT_WU" characters in size). Has the "
+                       "sequence-region to sequence mapping been defined "
+                       "correctly?",
+                       start - 1, end - 1, gt_str_get(seqid), seqlength);
+          had_err = -1;
+        }
       }
     } else if (rm->useseqno) {
       GtUword seqno = GT_UNDEF_UWORD;
@@ -308,33 +330,20 @@ int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
         }
       }
       if (!had_err) {
-        GtUword seqstartpos;
-        *seq = gt_calloc(end - start + 1, sizeof (char));
-        seqstartpos = gt_encseq_seqstartpos(rm->encseq, seqno);
-        gt_encseq_extract_decoded(rm->encseq, *seq, seqstartpos + start - 1,
-                                  seqstartpos + end - 1);
+        filenum = gt_encseq_filenum(rm->encseq,
+                                    gt_encseq_seqstartpos(rm->encseq, seqno));
+        seqnum = seqno - gt_encseq_filenum_first_seqnum(rm->encseq, filenum);
       }
-    } else if (rm->userawseq) {
-      gt_assert(!rm->seqid2seqnum_mapping);
-      *seq = gt_calloc(end - start + 1, sizeof (char));
-      strncpy(*seq, rm->rawseq + start - 1, (end - start + 1) * sizeof (char));
     } else if (rm->mapping) {
-      if (!had_err) {
-        GtUword seqlength = gt_seq_col_get_sequence_length(rm->seq_col,
-                                                                 0, 0);
-        if (start > seqlength || end > seqlength) {
-          had_err = -1;
-          gt_error_set(err, "trying to extract range " GT_WU "-" GT_WU " on "
-                       "sequence ``%s'' which is not covered by that sequence "
-                       "(only " GT_WU " characters in size). Has the "
-                       "sequence-region to sequence mapping been defined "
-                       "correctly?",
-                       start, end, gt_str_get(seqid), seqlength);
-        }
-        if (!had_err) {
-          *seq = gt_seq_col_get_sequence(rm->seq_col, 0, 0, start - offset,
-                                         end - offset);
-        }
+      GtUword seqlength = gt_seq_col_get_sequence_length(rm->seq_col, 0, 0);
+      if (start > seqlength || end > seqlength) {
+        had_err = -1;
+        gt_error_set(err, "trying to extract range " GT_WU "-" GT_WU " on "
+                     "sequence ``%s'' which is not covered by that sequence "
+                     "(only " GT_WU " characters in size). Has the "
+                     "sequence-region to sequence mapping been defined "
+                     "correctly?",
+                     start, end, gt_str_get(seqid), seqlength);
       }
     } else {
       gt_assert(!rm->usedesc && !rm->matchdesc);
@@ -344,6 +353,35 @@ int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
       had_err = -1;
     }
   }
+
+  /* decode into the buffer reused for all calls */
+  if (!had_err) {
+    if (end - start + 2 > rm->seqbuf_size) {
+      rm->seqbuf_size = end - start + 2;
+      rm->seqbuf = gt_realloc(rm->seqbuf, rm->seqbuf_size * sizeof (char));
+    }
+    gt_seq_col_extract_sequence(rm->seq_col, rm->seqbuf, filenum, seqnum,
+                                start - offset, end - offset);
+    rm->seqbuf[end - start + 1] = '\0';
+    *seq = rm->seqbuf;
+  }
+  return had_err;
+}
+
+int gt_region_mapping_get_sequence(GtRegionMapping *rm, char **seq,
+                                   GtStr *seqid, GtUword start,
+                                   GtUword end, GtError *err)
+{
+  const char *view;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(rm && seq && seqid && gt_str_length(seqid) > 0);
+  had_err = gt_region_mapping_get_sequence_view(rm, &view, seqid, start, end,
+                                                err);
+  if (!had_err) {
+    *seq = gt_calloc(end - start + 1, sizeof (char));
+    memcpy(*seq, view, (end - start + 1) * sizeof (char));
+  }
   return had_err;
 }
 
@@ -510,7 +548,7 @@ const char* gt_region_mapping_get_md5_fingerprint(GtRegionMapping *rm,
           if (!(rm->seq_col = gt_encseq_col_new(rm->encseq, err)))
             had_err = -1;
         } else {
-          if (!(rm->seq_col = gt_bioseq_col_new(rm->sequence_filenames, err)))
+          if (!(rm->seq_col = region_mapping_seq_col_new(rm, err)))
             had_err = -1;
         }
       }
@@ -577,5 +615,6 @@ void gt_region_mapping_delete(GtRegionMapping *rm)
   gt_encseq_delete(rm->encseq);
   gt_seq_col_delete(rm->seq_col);
   gt_seqid2seqnum_mapping_delete(rm->seqid2seqnum_mapping);
+  gt_free(rm->seqbuf);
   gt_free(rm);
 }
@@ -27,5 +27,9 @@ GtRegionMapping* gt_region_mapping_new_encseq_seqno(GtEncseq *encseq);
 /* Enables matching only at the beginning of sequence descriptions up to the
    first whitespace */
 void             gt_region_mapping_enable_match_desc_start(GtRegionMapping *rm);
+/* Enables access to the sequence files through a FASTA index ('.fai') instead
+   of encoding them, see <GtFastaIndex>. Not applicable to region mappings
+   based on an encoded or raw sequence. */
+void             gt_region_mapping_enable_fasta_index(GtRegionMapping *rm);
 
 #endif
@@ -71,6 +71,22 @@ int              gt_region_mapping_get_sequence(GtRegionMapping *region_mapping,
                                                 GtUword end,
                                                 GtError *err);
 
+/* Like <gt_region_mapping_get_sequence()>, but <seq> is set to a view of the
+   <end> - <start> + 1 characters which is owned by <region_mapping>. It points
+   directly into the sequence given to <gt_region_mapping_new_rawseq()> or
+   into a decode buffer which is reused by subsequent calls, so no memory is
+   allocated per call. The view is valid until the next call of this function
+   or <gt_region_mapping_get_sequence()> for <region_mapping>, hence each
+   thread must use its own <GtRegionMapping>.
+   In the case of an error, -1 is returned and <err> is set accordingly. */
+int              gt_region_mapping_get_sequence_view(GtRegionMapping
+                                                     *region_mapping,
+                                                     const char **seq,
+                                                     GtStr *seqid,
+                                                     GtUword start,
+                                                     GtUword end,
+                                                     GtError *err);
+
 /* Use <region_mapping> to retrieve the sequence length of the given
    sequence ID <seqid> and store the result in <length>.
    In the case of an error, -1 is returned and <err> is set accordingly. */
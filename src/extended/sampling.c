@@ -219,26 +219,24 @@ static void get_pagewise_page(GtSampling *sampling,
                               GtUword *sampled_element,
                               size_t *position)
 {
-  GtWord start = (GtWord) -1,
+  GtWord start = 0,
          end, middle;
 
   gt_assert(sampling->numofsamples != 0);
   /* should not overflow, because this is a small table indexing into a larger
      one. */
   gt_safe_assign(end, sampling->numofsamples);
-  middle = GT_DIV2(end);
+  /* find the last sample with page_sampling[start] <= element_num */
   while (end - start > (GtWord) 1) {
+    middle = start + GT_DIV2(end - start);
     if (element_num < sampling->page_sampling[middle]) {
-      start = middle;
+      end = middle;
     }
     else {
-      end = middle;
+      start = middle;
     }
-    middle = start + GT_DIV2(end - start);
-  }
-  if (middle < 0) {
-    middle = 0;
   }
+  middle = start;
   *sampled_element =
     sampling->current_sample_elementnum =
     sampling->page_sampling[middle];
@@ -24,7 +24,8 @@ struct GtSeqid2FileInfo {
   GtStrArray *seqfiles;
   bool matchdesc,
        usedesc,
-       matchdescstart;
+       matchdescstart,
+       fastaindex;
   GtStr *seqfile,
         *encseq,
         *region_mapping;
@@ -67,7 +68,8 @@ void gt_seqid2file_register_options_ext(GtOptionParser *op,
                                         bool mandatory, bool debug)
 {
   GtOption *seqfile_option, *encseq_option, *seqfiles_option, *matchdesc_option,
-           *matchdescstart_option, *usedesc_option, *region_mapping_option;
+           *matchdescstart_option, *usedesc_option, *region_mapping_option,
+           *fastaindex_option;
   gt_assert(op && s2fi);
 
   /* -seqfile */
@@ -142,6 +144,19 @@ void gt_seqid2file_register_options_ext(GtOptionParser *op,
     gt_option_is_development_option(region_mapping_option);
   gt_option_parser_add_option(op, region_mapping_option);
 
+  /* -fastaindex */
+  fastaindex_option = gt_option_new_bool("fastaindex", "access the sequence "
+                                         "files through a FASTA index (.fai, "
+                                         "created if necessary) instead of "
+                                         "encoding them.\nSupports "
+                                         "uncompressed and BGZF compressed "
+                                         "FASTA files whose sequences have "
+                                         "lines of equal length",
+                                         &s2fi->fastaindex, false);
+  if (debug)
+    gt_option_is_development_option(fastaindex_option);
+  gt_option_parser_add_option(op, fastaindex_option);
+
   /* either option -seqfile, -seqfiles or -regionmapping is mandatory */
   if (mandatory) {
     gt_option_is_mandatory_either_4(seqfile_option, encseq_option,
@@ -177,6 +192,11 @@ void gt_seqid2file_register_options_ext(GtOptionParser *op,
   gt_option_imply_either_3(usedesc_option, seqfile_option, seqfiles_option,
                            encseq_option);
 
+  /* option -fastaindex implies option -seqfile, -seqfiles or
+     -regionmapping */
+  gt_option_imply_either_3(fastaindex_option, seqfile_option, seqfiles_option,
+                           region_mapping_option);
+
   /* set hook function */
   gt_option_parser_register_hook(op, seqid2file_check, s2fi);
 }
@@ -228,6 +248,8 @@ GtRegionMapping* gt_seqid2file_region_mapping_new(GtSeqid2FileInfo *s2fi,
   }
   if (rm && s2fi->matchdescstart)
     gt_region_mapping_enable_match_desc_start(rm);
+  if (rm && s2fi->fastaindex)
+    gt_region_mapping_enable_fasta_index(rm);
   gt_assert(rm || gt_error_is_set(err));
   return rm;
 }
@@ -26,8 +26,8 @@ typedef struct GtSeqid2FileInfo GtSeqid2FileInfo;
 GtSeqid2FileInfo* gt_seqid2file_info_new(void);
 void              gt_seqid2file_info_delete(GtSeqid2FileInfo*);
 
-/* Add the options -seqfile, -seqfiles, -matchdesc, -usedesc  and
-   -regionmapping to the given <option_parser>. */
+/* Add the options -seqfile, -seqfiles, -matchdesc, -usedesc, -regionmapping
+   and -fastaindex to the given <option_parser>. */
 void              gt_seqid2file_register_options(GtOptionParser *option_parser,
                                                  GtSeqid2FileInfo*);
 
@@ -327,14 +327,13 @@ static int gt_snp_annotator_visitor_prepare_gene(GtSNPAnnotatorVisitor *sav,
         while (!had_err && (curnode2 =
                                       gt_feature_node_iterator_next(mrnafni))) {
           if (gt_feature_node_get_type(curnode2) == sav->CDS_type) {
-            char *tmp;
+            const char *tmp;
             GtRange rng = gt_genome_node_get_range((GtGenomeNode*) curnode2);
-            had_err = gt_region_mapping_get_sequence(sav->rmap, &tmp, seqid,
-                                                     rng.start, rng.end, err);
-            if (!had_err) {
+            had_err = gt_region_mapping_get_sequence_view(sav->rmap, &tmp,
+                                                          seqid, rng.start,
+                                                          rng.end, err);
+            if (!had_err)
               gt_str_append_cstr_nt(mrnaseq, tmp, gt_range_length(&rng));
-              gt_free(tmp);
-            }
           }
         }
         gt_feature_node_iterator_delete(mrnafni);
@@ -58,7 +58,7 @@ static void splice_site_info_visitor_free(GtNodeVisitor *nv)
 static int process_intron(GtSpliceSiteInfoVisitor *ssiv, GtGenomeNode *intron,
                           GtError *err)
 {
-  char *sequence = NULL;
+  const char *sequence = NULL;
   GtStrand strand;
   GtRange range;
   char site[5];
@@ -71,9 +71,9 @@ static int process_intron(GtSpliceSiteInfoVisitor *ssiv, GtGenomeNode *intron,
   gt_assert(range.start); /* 1-based coordinates */
   if (gt_range_length(&range) >= 4) {
     seqid = gt_genome_node_get_seqid(intron);
-    had_err = gt_region_mapping_get_sequence(ssiv->region_mapping, &sequence,
-                                             seqid, range.start, range.end,
-                                             err);
+    had_err = gt_region_mapping_get_sequence_view(ssiv->region_mapping,
+                                                  &sequence, seqid,
+                                                  range.start, range.end, err);
     if (!had_err) {
       strand = gt_feature_node_get_strand((GtFeatureNode*) intron);
       if (strand == GT_STRAND_FORWARD || strand == GT_STRAND_REVERSE) {
@@ -99,7 +99,6 @@ static int process_intron(GtSpliceSiteInfoVisitor *ssiv, GtGenomeNode *intron,
                    "(file '%s', line %u)", gt_genome_node_get_filename(intron),
                    gt_genome_node_get_line_number(intron));
       }
-      gt_free(sequence);
     }
   }
   return had_err;
@@ -15,12 +15,14 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/assert_api.h"
 #include "core/bsearch.h"
 #include "core/cstr_api.h"
 #include "core/hashmap.h"
 #include "core/log.h"
 #include "core/ma.h"
+#include "core/multithread_api.h"
 #include "core/unused_api.h"
 #include "core/warning_api.h"
 #include "core/xansi_api.h"
@@ -109,6 +111,27 @@ typedef struct {
                         *used_mRNA_exons_reverse,
                         *used_CDS_exons_forward,
                         *used_CDS_exons_reverse;
+  /* the counts of this slot, they are added to the ones of the stream
+     evaluator after all slots have been evaluated */
+  GtEvaluator *mRNA_gene_evaluator,
+              *CDS_gene_evaluator,
+              *mRNA_mRNA_evaluator,
+              *CDS_mRNA_evaluator,
+              *LTR_evaluator;
+  GtTranscriptEvaluators *mRNA_exon_evaluators,
+                         *mRNA_exon_evaluators_collapsed,
+                         *CDS_exon_evaluators,
+                         *CDS_exon_evaluators_collapsed;
+  GtUword missing_genes,
+          wrong_genes,
+          missing_mRNAs,
+          wrong_mRNAs,
+          missing_LTRs,
+          wrong_LTRs;
+  NucEval mRNA_nucleotides,
+          CDS_nucleotides;
+  /* predicted features buffered for the parallel evaluation */
+  GtArray *predicted_features;
 } Slot;
 
 typedef struct
@@ -168,6 +191,16 @@ static Slot* slot_new(bool nuceval, GtRange range)
   s->used_mRNA_exons_reverse = gt_transcript_used_exons_new();
   s->used_CDS_exons_forward = gt_transcript_used_exons_new();
   s->used_CDS_exons_reverse = gt_transcript_used_exons_new();
+  s->mRNA_gene_evaluator = gt_evaluator_new();
+  s->CDS_gene_evaluator = gt_evaluator_new();
+  s->mRNA_mRNA_evaluator = gt_evaluator_new();
+  s->CDS_mRNA_evaluator = gt_evaluator_new();
+  s->LTR_evaluator = gt_evaluator_new();
+  s->mRNA_exon_evaluators = gt_transcript_evaluators_new();
+  s->mRNA_exon_evaluators_collapsed = gt_transcript_evaluators_new();
+  s->CDS_exon_evaluators = gt_transcript_evaluators_new();
+  s->CDS_exon_evaluators_collapsed = gt_transcript_evaluators_new();
+  s->predicted_features = gt_array_new(sizeof (GtGenomeNode*));
   return s;
 }
 
@@ -228,6 +261,20 @@ static void slot_delete(Slot *s)
   gt_transcript_used_exons_delete(s->used_mRNA_exons_reverse);
   gt_transcript_used_exons_delete(s->used_CDS_exons_forward);
   gt_transcript_used_exons_delete(s->used_CDS_exons_reverse);
+  gt_evaluator_delete(s->mRNA_gene_evaluator);
+  gt_evaluator_delete(s->CDS_gene_evaluator);
+  gt_evaluator_delete(s->mRNA_mRNA_evaluator);
+  gt_evaluator_delete(s->CDS_mRNA_evaluator);
+  gt_evaluator_delete(s->LTR_evaluator);
+  gt_transcript_evaluators_delete(s->mRNA_exon_evaluators);
+  gt_transcript_evaluators_delete(s->mRNA_exon_evaluators_collapsed);
+  gt_transcript_evaluators_delete(s->CDS_exon_evaluators);
+  gt_transcript_evaluators_delete(s->CDS_exon_evaluators_collapsed);
+  for (i = 0; i < gt_array_size(s->predicted_features); i++) {
+    gt_genome_node_delete(*(GtGenomeNode**)
+                          gt_array_get(s->predicted_features, i));
+  }
+  gt_array_delete(s->predicted_features);
   gt_free(s);
 }
 
@@ -256,46 +303,41 @@ GtStreamEvaluator* gt_stream_evaluator_new(GtNodeStream *reference,
   return evaluator;
 }
 
-static int set_actuals_and_sort_them(GT_UNUSED void *key, void *value,
-                                     void *data, GT_UNUSED GtError *err)
+static void set_actuals_and_sort_them(Slot *s)
 {
-  GtStreamEvaluator *se = (GtStreamEvaluator*) data;
-  Slot *s = (Slot*) value;
-
-  gt_error_check(err);
-  gt_assert(key && value && data);
+  gt_assert(s);
 
   /* set actual genes */
-  gt_evaluator_add_actual(se->mRNA_gene_evaluator,
+  gt_evaluator_add_actual(s->mRNA_gene_evaluator,
                           gt_array_size(s->genes_forward));
-  gt_evaluator_add_actual(se->mRNA_gene_evaluator,
+  gt_evaluator_add_actual(s->mRNA_gene_evaluator,
                           gt_array_size(s->genes_reverse));
-  gt_evaluator_add_actual(se->CDS_gene_evaluator,
+  gt_evaluator_add_actual(s->CDS_gene_evaluator,
                           gt_array_size(s->genes_forward));
-  gt_evaluator_add_actual(se->CDS_gene_evaluator,
+  gt_evaluator_add_actual(s->CDS_gene_evaluator,
                           gt_array_size(s->genes_reverse));
 
   /* set actual mRNAs */
-  gt_evaluator_add_actual(se->mRNA_mRNA_evaluator,
+  gt_evaluator_add_actual(s->mRNA_mRNA_evaluator,
                           gt_array_size(s->mRNAs_forward));
-  gt_evaluator_add_actual(se->mRNA_mRNA_evaluator,
+  gt_evaluator_add_actual(s->mRNA_mRNA_evaluator,
                           gt_array_size(s->mRNAs_reverse));
-  gt_evaluator_add_actual(se->CDS_mRNA_evaluator,
+  gt_evaluator_add_actual(s->CDS_mRNA_evaluator,
                           gt_array_size(s->mRNAs_forward));
-  gt_evaluator_add_actual(se->CDS_mRNA_evaluator,
+  gt_evaluator_add_actual(s->CDS_mRNA_evaluator,
                           gt_array_size(s->mRNAs_reverse));
 
   /* set actual LTRs */
-  gt_evaluator_add_actual(se->LTR_evaluator, gt_array_size(s->LTRs));
+  gt_evaluator_add_actual(s->LTR_evaluator, gt_array_size(s->LTRs));
 
   /* set actual exons (before uniq!) */
-  gt_transcript_evaluators_add_actuals(se->mRNA_exon_evaluators,
+  gt_transcript_evaluators_add_actuals(s->mRNA_exon_evaluators,
                                        s->mRNA_exons_forward);
-  gt_transcript_evaluators_add_actuals(se->mRNA_exon_evaluators,
+  gt_transcript_evaluators_add_actuals(s->mRNA_exon_evaluators,
                                        s->mRNA_exons_reverse);
-  gt_transcript_evaluators_add_actuals(se->CDS_exon_evaluators,
+  gt_transcript_evaluators_add_actuals(s->CDS_exon_evaluators,
                                        s->CDS_exons_forward);
-  gt_transcript_evaluators_add_actuals(se->CDS_exon_evaluators,
+  gt_transcript_evaluators_add_actuals(s->CDS_exon_evaluators,
                                        s->CDS_exons_reverse);
 
   /* sort genes */
@@ -326,13 +368,13 @@ static int set_actuals_and_sort_them(GT_UNUSED void *key, void *value,
     gt_transcript_exons_uniq_in_place_count(s->CDS_exons_reverse);
 
   /* set actual exons for the collapsed case (after uniq!) */
-  gt_transcript_evaluators_add_actuals(se->mRNA_exon_evaluators_collapsed,
+  gt_transcript_evaluators_add_actuals(s->mRNA_exon_evaluators_collapsed,
                                        s->mRNA_exons_forward);
-  gt_transcript_evaluators_add_actuals(se->mRNA_exon_evaluators_collapsed,
+  gt_transcript_evaluators_add_actuals(s->mRNA_exon_evaluators_collapsed,
                                        s->mRNA_exons_reverse);
-  gt_transcript_evaluators_add_actuals(se->CDS_exon_evaluators_collapsed,
+  gt_transcript_evaluators_add_actuals(s->CDS_exon_evaluators_collapsed,
                                        s->CDS_exons_forward);
-  gt_transcript_evaluators_add_actuals(se->CDS_exon_evaluators_collapsed,
+  gt_transcript_evaluators_add_actuals(s->CDS_exon_evaluators_collapsed,
                                        s->CDS_exons_reverse);
 
   /* make sure that the genes are sorted */
@@ -407,8 +449,6 @@ static int set_actuals_and_sort_them(GT_UNUSED void *key, void *value,
     gt_transcript_exons_create_bittabs(s->CDS_exons_forward);
   s->CDS_exon_bittabs_reverse =
     gt_transcript_exons_create_bittabs(s->CDS_exons_reverse);
-
-  return 0;
 }
 
 static void add_real_exon(GtTranscriptExons *te, GtRange range,
@@ -734,13 +774,31 @@ static void store_predicted_exon(GtTranscriptEvaluators *te, GtFeatureNode *fn)
   }
 }
 
+/* The list of used exons is sorted and the predicted exons usually arrive in
+   ascending order. Therefore, the list is searched from its end and the search
+   stops at the first smaller exon. */
+static bool used_exon_exists(GtDlist *used_exons, GtRange *predicted_range)
+{
+  GtDlistelem *dlistelem;
+  int cmp;
+  for (dlistelem = gt_dlist_last(used_exons); dlistelem != NULL;
+       dlistelem = gt_dlistelem_previous(dlistelem)) {
+    cmp = gt_range_compare(gt_dlistelem_get_data(dlistelem), predicted_range);
+    if (!cmp)
+      return true;
+    if (cmp < 0)
+      return false;
+  }
+  return false;
+}
+
 /* adds exon only if necessary */
 static void add_predicted_collapsed(GtDlist *used_exons,
                                     GtRange *predicted_range,
                                     GtEvaluator *exon_evaluator_collapsed)
 {
   GtRange *used_range;
-  if (!gt_dlist_find(used_exons, predicted_range)) {
+  if (!used_exon_exists(used_exons, predicted_range)) {
     used_range = gt_malloc(sizeof (GtRange));
     used_range->start = predicted_range->start;
     used_range->end = predicted_range->end;
@@ -1248,38 +1306,33 @@ static int process_predicted_feature(GtFeatureNode *fn, void *data,
   return 0;
 }
 
-static int determine_missing_features(GT_UNUSED void *key, void *value,
-                                      void *data, GT_UNUSED GtError *err)
+static void determine_missing_features(Slot *slot)
 {
-  GtStreamEvaluator *se = (GtStreamEvaluator*) data;
-  Slot *slot = (Slot*) value;
-  gt_error_check(err);
-  gt_assert(key && value && data);
+  gt_assert(slot);
   if (slot->overlapped_genes_forward) {
-    se->missing_genes +=
+    slot->missing_genes +=
       gt_bittab_size(slot->overlapped_genes_forward) -
       gt_bittab_count_set_bits(slot->overlapped_genes_forward);
   }
   if (slot->overlapped_genes_reverse) {
-    se->missing_genes +=
+    slot->missing_genes +=
       gt_bittab_size(slot->overlapped_genes_reverse) -
       gt_bittab_count_set_bits(slot->overlapped_genes_reverse);
   }
   if (slot->overlapped_mRNAs_forward) {
-    se->missing_mRNAs +=
+    slot->missing_mRNAs +=
       gt_bittab_size(slot->overlapped_mRNAs_forward) -
       gt_bittab_count_set_bits(slot->overlapped_mRNAs_forward);
   }
   if (slot->overlapped_mRNAs_reverse) {
-    se->missing_mRNAs +=
+    slot->missing_mRNAs +=
       gt_bittab_size(slot->overlapped_mRNAs_reverse) -
       gt_bittab_count_set_bits(slot->overlapped_mRNAs_reverse);
   }
   if (slot->overlapped_LTRs) {
-    se->missing_LTRs  += gt_bittab_size(slot->overlapped_LTRs) -
+    slot->missing_LTRs  += gt_bittab_size(slot->overlapped_LTRs) -
                          gt_bittab_count_set_bits(slot->overlapped_LTRs);
   }
-  return 0;
 }
 
 static void add_nucleotide_values(NucEval *nucleotides, GtBittab *real,
@@ -1307,50 +1360,178 @@ static void add_nucleotide_values(NucEval *nucleotides, GtBittab *real,
   nucleotides->FN += gt_bittab_count_set_bits(tmp);
 }
 
-static int compute_nucleotides_values(GT_UNUSED void *key, void *value,
-                                      void *data, GT_UNUSED GtError *err)
+static void compute_nucleotides_values(Slot *slot)
 {
-  GtStreamEvaluator *se = (GtStreamEvaluator*) data;
-  Slot *slot = (Slot*) value;
   GtBittab *tmp;
-  gt_error_check(err);
-  gt_assert(key && value && data);
+  gt_assert(slot);
   /* add ``out of range'' FPs */
-  se->mRNA_nucleotides.FP += slot->FP_mRNA_nucleotides_forward;
-  se->mRNA_nucleotides.FP += slot->FP_mRNA_nucleotides_reverse;
-  se->CDS_nucleotides.FP  += slot->FP_CDS_nucleotides_forward;
-  se->CDS_nucleotides.FP  += slot->FP_CDS_nucleotides_reverse;
+  slot->mRNA_nucleotides.FP += slot->FP_mRNA_nucleotides_forward;
+  slot->mRNA_nucleotides.FP += slot->FP_mRNA_nucleotides_reverse;
+  slot->CDS_nucleotides.FP  += slot->FP_CDS_nucleotides_forward;
+  slot->CDS_nucleotides.FP  += slot->FP_CDS_nucleotides_reverse;
   /* add other values */
   tmp = gt_bittab_new(gt_range_length(&slot->real_range));
-  add_nucleotide_values(&se->mRNA_nucleotides,
+  add_nucleotide_values(&slot->mRNA_nucleotides,
                         slot->real_mRNA_nucleotides_forward,
                         slot->pred_mRNA_nucleotides_forward, tmp,
                         "mRNA forward");
-  add_nucleotide_values(&se->mRNA_nucleotides,
+  add_nucleotide_values(&slot->mRNA_nucleotides,
                         slot->real_mRNA_nucleotides_reverse,
                         slot->pred_mRNA_nucleotides_reverse, tmp,
                         "mRNA reverse");
-  add_nucleotide_values(&se->CDS_nucleotides,
+  add_nucleotide_values(&slot->CDS_nucleotides,
                         slot->real_CDS_nucleotides_forward,
                         slot->pred_CDS_nucleotides_forward, tmp,
                         "CDS forward");
-  add_nucleotide_values(&se->CDS_nucleotides,
+  add_nucleotide_values(&slot->CDS_nucleotides,
                         slot->real_CDS_nucleotides_reverse,
                         slot->pred_CDS_nucleotides_reverse, tmp,
                         "CDS reverse");
   gt_bittab_delete(tmp);
+}
+
+static void predicted_info_set_slot(ProcessPredictedFeatureInfo *info,
+                                    Slot *slot)
+{
+  gt_assert(info && slot);
+  info->slot = slot;
+  info->mRNA_gene_evaluator = slot->mRNA_gene_evaluator;
+  info->CDS_gene_evaluator = slot->CDS_gene_evaluator;
+  info->mRNA_mRNA_evaluator = slot->mRNA_mRNA_evaluator;
+  info->CDS_mRNA_evaluator = slot->CDS_mRNA_evaluator;
+  info->LTR_evaluator  = slot->LTR_evaluator;
+  info->mRNA_exon_evaluators = slot->mRNA_exon_evaluators;
+  info->mRNA_exon_evaluators_collapsed = slot->mRNA_exon_evaluators_collapsed;
+  info->CDS_exon_evaluators = slot->CDS_exon_evaluators;
+  info->CDS_exon_evaluators_collapsed = slot->CDS_exon_evaluators_collapsed;
+  info->wrong_genes = &slot->wrong_genes;
+  info->wrong_mRNAs = &slot->wrong_mRNAs;
+  info->wrong_LTRs  = &slot->wrong_LTRs;
+}
+
+static void process_predicted_feature_node(GtFeatureNode *fn,
+                                           ProcessPredictedFeatureInfo *info)
+{
+  GT_UNUSED int had_err;
+  gt_assert(fn && info);
+  had_err = gt_feature_node_traverse_children(fn, info,
+                                              process_predicted_feature, false,
+                                              NULL);
+  gt_assert(!had_err); /* cannot happen, process_predicted_feature() is sane */
+}
+
+static int collect_slot(GT_UNUSED void *key, void *value, void *data,
+                        GT_UNUSED GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(key && value && data);
+  gt_array_add((GtArray*) data, value);
   return 0;
 }
 
+typedef struct {
+  GtArray *slots;
+  GtUword next_slot;
+  GtMutex *mutex;
+  bool evaluate_predictions; /* otherwise the actuals are set */
+  const ProcessPredictedFeatureInfo *predicted_info;
+} EvaluateSlotsInfo;
+
+/* Each thread takes the next unprocessed slot until all slots are done. The
+   slots are independent of each other and only the counts of the slot itself
+   are changed. The buffered genome nodes are not deleted here, because they
+   share reference counted objects (like the file name) across slots. */
+static void* evaluate_slots_thread(void *data)
+{
+  EvaluateSlotsInfo *info = (EvaluateSlotsInfo*) data;
+  ProcessPredictedFeatureInfo predicted_info;
+  GtUword i, slotnum;
+  Slot *slot;
+  gt_assert(info);
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    slotnum = info->next_slot++;
+    gt_mutex_unlock(info->mutex);
+    if (slotnum >= gt_array_size(info->slots))
+      break;
+    slot = *(Slot**) gt_array_get(info->slots, slotnum);
+    if (!info->evaluate_predictions) {
+      set_actuals_and_sort_them(slot);
+      continue;
+    }
+    predicted_info = *info->predicted_info;
+    predicted_info_set_slot(&predicted_info, slot);
+    for (i = 0; i < gt_array_size(slot->predicted_features); i++) {
+      process_predicted_feature_node(*(GtFeatureNode**)
+                                     gt_array_get(slot->predicted_features, i),
+                                     &predicted_info);
+    }
+    determine_missing_features(slot);
+    if (predicted_info.nuceval)
+      compute_nucleotides_values(slot);
+  }
+  return NULL;
+}
+
+static int evaluate_slots(GtArray *slots, bool evaluate_predictions,
+                          const ProcessPredictedFeatureInfo *predicted_info,
+                          GtError *err)
+{
+  EvaluateSlotsInfo info;
+  int had_err;
+  gt_error_check(err);
+  info.slots = slots;
+  info.next_slot = 0;
+  info.mutex = gt_mutex_new();
+  info.evaluate_predictions = evaluate_predictions;
+  info.predicted_info = predicted_info;
+  had_err = gt_multithread(evaluate_slots_thread, &info, err);
+  gt_mutex_delete(info.mutex);
+  return had_err;
+}
+
+static void add_slot_counts(GtStreamEvaluator *se, const Slot *slot)
+{
+  gt_assert(se && slot);
+  gt_evaluator_add(se->mRNA_gene_evaluator, slot->mRNA_gene_evaluator);
+  gt_evaluator_add(se->CDS_gene_evaluator, slot->CDS_gene_evaluator);
+  gt_evaluator_add(se->mRNA_mRNA_evaluator, slot->mRNA_mRNA_evaluator);
+  gt_evaluator_add(se->CDS_mRNA_evaluator, slot->CDS_mRNA_evaluator);
+  gt_evaluator_add(se->LTR_evaluator, slot->LTR_evaluator);
+  gt_transcript_evaluators_add(se->mRNA_exon_evaluators,
+                               slot->mRNA_exon_evaluators);
+  gt_transcript_evaluators_add(se->mRNA_exon_evaluators_collapsed,
+                               slot->mRNA_exon_evaluators_collapsed);
+  gt_transcript_evaluators_add(se->CDS_exon_evaluators,
+                               slot->CDS_exon_evaluators);
+  gt_transcript_evaluators_add(se->CDS_exon_evaluators_collapsed,
+                               slot->CDS_exon_evaluators_collapsed);
+  se->missing_genes += slot->missing_genes;
+  se->wrong_genes += slot->wrong_genes;
+  se->missing_mRNAs += slot->missing_mRNAs;
+  se->wrong_mRNAs += slot->wrong_mRNAs;
+  se->missing_LTRs += slot->missing_LTRs;
+  se->wrong_LTRs += slot->wrong_LTRs;
+  se->mRNA_nucleotides.TP += slot->mRNA_nucleotides.TP;
+  se->mRNA_nucleotides.FP += slot->mRNA_nucleotides.FP;
+  se->mRNA_nucleotides.FN += slot->mRNA_nucleotides.FN;
+  se->CDS_nucleotides.TP += slot->CDS_nucleotides.TP;
+  se->CDS_nucleotides.FP += slot->CDS_nucleotides.FP;
+  se->CDS_nucleotides.FN += slot->CDS_nucleotides.FN;
+}
+
 int gt_stream_evaluator_evaluate(GtStreamEvaluator *se, bool verbose,
                                  bool exondiff, bool exondiffcollapsed,
                                  GtNodeVisitor *nv, GtError *err)
 {
   GtGenomeNode *gn;
   GtFeatureNode *fn;
+  GtArray *slots;
   Slot *slot;
   ProcessRealFeatureInfo real_info;
   ProcessPredictedFeatureInfo predicted_info;
+  GtUword i;
+  bool parallel;
   int had_err;
 
   gt_error_check(err);
@@ -1359,25 +1540,16 @@ int gt_stream_evaluator_evaluate(GtStreamEvaluator *se, bool verbose,
   /* init */
   real_info.nuceval = se->nuceval;
   real_info.verbose = verbose;
+  memset(&predicted_info, 0, sizeof predicted_info);
   predicted_info.nuceval = se->nuceval;
   predicted_info.verbose = verbose;
   predicted_info.exondiff = exondiff;
   predicted_info.exondiffcollapsed = exondiffcollapsed;
   predicted_info.LTRdelta = se->LTRdelta;
-  predicted_info.mRNA_gene_evaluator = se->mRNA_gene_evaluator;
-  predicted_info.CDS_gene_evaluator = se->CDS_gene_evaluator;
-  predicted_info.mRNA_mRNA_evaluator = se->mRNA_mRNA_evaluator;
-  predicted_info.CDS_mRNA_evaluator = se->CDS_mRNA_evaluator;
-  predicted_info.LTR_evaluator  = se->LTR_evaluator;
-  predicted_info.mRNA_exon_evaluators = se->mRNA_exon_evaluators;
-  predicted_info.mRNA_exon_evaluators_collapsed =
-    se->mRNA_exon_evaluators_collapsed;
-  predicted_info.CDS_exon_evaluators = se->CDS_exon_evaluators;
-  predicted_info.CDS_exon_evaluators_collapsed =
-    se->CDS_exon_evaluators_collapsed;
-  predicted_info.wrong_genes = &se->wrong_genes;
-  predicted_info.wrong_mRNAs = &se->wrong_mRNAs;
-  predicted_info.wrong_LTRs  = &se->wrong_LTRs;
+  slots = gt_array_new(sizeof (Slot*));
+  /* the sequence regions are evaluated in parallel, unless the order of the
+     output produced during the evaluation matters */
+  parallel = gt_jobs > 1 && !exondiff && !exondiffcollapsed && !nv;
 
   /* process the reference stream completely */
   while (!(had_err = gt_node_stream_next(se->reference, &gn, err)) && gn) {
@@ -1411,11 +1583,19 @@ int gt_stream_evaluator_evaluate(GtStreamEvaluator *se, bool verbose,
     gt_genome_node_delete(gn);
   }
 
+  if (!had_err) {
+    had_err = gt_hashmap_foreach(se->slots, collect_slot, slots, NULL);
+    gt_assert(!had_err); /* collect_slot() is sane */
+  }
+
   /* set the actuals and sort them */
   if (!had_err) {
-    had_err = gt_hashmap_foreach(se->slots, set_actuals_and_sort_them, se,
-                                 NULL);
-    gt_assert(!had_err); /* set_actuals_and_sort_them() is sane */
+    if (parallel)
+      had_err = evaluate_slots(slots, false, NULL, err);
+    else {
+      for (i = 0; i < gt_array_size(slots); i++)
+        set_actuals_and_sort_them(*(Slot**) gt_array_get(slots, i));
+    }
   }
 
   /* process the prediction stream */
@@ -1429,13 +1609,14 @@ int gt_stream_evaluator_evaluate(GtStreamEvaluator *se, bool verbose,
         slot = gt_hashmap_get(se->slots,
                               gt_str_get(gt_genome_node_get_seqid(gn)));
         if (slot) {
-          predicted_info.slot = slot;
           gt_feature_node_determine_transcripttypes(fn);
-          had_err = gt_feature_node_traverse_children(fn, &predicted_info,
-                                                      process_predicted_feature,
-                                                      false, NULL);
-          gt_assert(!had_err); /* cannot happen, process_predicted_feature() is
-                               sane */
+          if (parallel) {
+            /* keep the node for the parallel evaluation of its slot */
+            gt_array_add(slot->predicted_features, gn);
+            continue;
+          }
+          predicted_info_set_slot(&predicted_info, slot);
+          process_predicted_feature_node(fn, &predicted_info);
         }
         else {
           /* we got no (real) slot */
@@ -1449,20 +1630,28 @@ int gt_stream_evaluator_evaluate(GtStreamEvaluator *se, bool verbose,
     }
   }
 
-  /* determine the missing mRNAs */
+  /* evaluate the buffered predictions, determine the missing features, and
+     compute the nucleotides values */
   if (!had_err) {
-    had_err = gt_hashmap_foreach(se->slots, determine_missing_features, se,
-                                 NULL);
-    gt_assert(!had_err); /* determine_missing_features() is sane */
+    if (parallel)
+      had_err = evaluate_slots(slots, true, &predicted_info, err);
+    else {
+      for (i = 0; i < gt_array_size(slots); i++) {
+        slot = *(Slot**) gt_array_get(slots, i);
+        determine_missing_features(slot);
+        if (se->nuceval)
+          compute_nucleotides_values(slot);
+      }
+    }
   }
 
-  /* compute the nucleotides values */
-  if (!had_err && se->nuceval) {
-    had_err = gt_hashmap_foreach(se->slots, compute_nucleotides_values, se,
-                                 NULL);
-    gt_assert(!had_err); /* compute_nucleotides_values() is sane */
+  /* add up the counts of all slots */
+  if (!had_err) {
+    for (i = 0; i < gt_array_size(slots); i++)
+      add_slot_counts(se, *(Slot**) gt_array_get(slots, i));
   }
 
+  gt_array_delete(slots);
   return had_err;
 }
 
@@ -88,6 +88,19 @@ void gt_transcript_evaluators_add_actuals(const GtTranscriptEvaluators
                        gt_array_size(gt_transcript_exons_get_terminal(exons)));
 }
 
+void gt_transcript_evaluators_add(GtTranscriptEvaluators *dest,
+                                  const GtTranscriptEvaluators *src)
+{
+  gt_assert(dest && src);
+  gt_evaluator_add(dest->exon_evaluator_all, src->exon_evaluator_all);
+  gt_evaluator_add(dest->exon_evaluator_single, src->exon_evaluator_single);
+  gt_evaluator_add(dest->exon_evaluator_initial, src->exon_evaluator_initial);
+  gt_evaluator_add(dest->exon_evaluator_internal,
+                   src->exon_evaluator_internal);
+  gt_evaluator_add(dest->exon_evaluator_terminal,
+                   src->exon_evaluator_terminal);
+}
+
 void gt_transcript_evaluators_delete(GtTranscriptEvaluators *te)
 {
   if (!te) return;
@@ -15,20 +15,33 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <stdlib.h>
 #include <string.h>
-#include "core/cstr_api.h"
-#include "core/cstr_table.h"
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+#include "core/compat.h"
+#include "core/fileutils.h"
 #include "core/ma.h"
+#include "core/md5_fingerprint_api.h"
+#include "core/str_api.h"
+#include "extended/compiled_type_graph.h"
 #include "extended/obo_parse_tree.h"
 #include "extended/type_checker_obo.h"
 #include "extended/type_checker_rep.h"
 #include "extended/type_graph.h"
 
+/* suffix of the file the compiled type graph of an OBO file is stored in */
+#define GT_TYPE_CHECKER_OBO_CACHE_SUFFIX  ".gttc"
+/* subdirectory of the user cache directory used for compiled type graphs */
+#define GT_TYPE_CHECKER_OBO_CACHE_DIR     "genometools"
+
 struct GtTypeCheckerOBO {
   const GtTypeChecker parent_instance;
   GtStr *description;
-  GtCstrTable *feature_node_types;
-  GtTypeGraph *type_graph;
+  GtCompiledTypeGraph *compiled_type_graph;
 };
 
 #define gt_type_checker_obo_cast(FTF)\
@@ -37,8 +50,7 @@ struct GtTypeCheckerOBO {
 static void gt_type_checker_obo_free(GtTypeChecker *tc)
 {
   GtTypeCheckerOBO *tco = gt_type_checker_obo_cast(tc);
-  gt_type_graph_delete(tco->type_graph);
-  gt_cstr_table_delete(tco->feature_node_types);
+  gt_compiled_type_graph_delete(tco->compiled_type_graph);
   gt_str_delete(tco->description);
 }
 
@@ -55,7 +67,7 @@ static bool gt_type_checker_obo_is_valid(GtTypeChecker *tc, const char *type)
   GtTypeCheckerOBO *tco;
   gt_assert(tc && type);
   tco = gt_type_checker_obo_cast(tc);
-  return gt_cstr_table_get(tco->feature_node_types, type) ? true : false;
+  return gt_compiled_type_graph_has_type(tco->compiled_type_graph, type);
 }
 
 static bool gt_type_checker_obo_is_partof(GtTypeChecker *tc,
@@ -65,7 +77,8 @@ static bool gt_type_checker_obo_is_partof(GtTypeChecker *tc,
   GtTypeCheckerOBO *tco;
   gt_assert(tc && parent_type && child_type);
   tco = gt_type_checker_obo_cast(tc);
-  return gt_type_graph_is_partof(tco->type_graph, parent_type, child_type);
+  return gt_compiled_type_graph_is_partof(tco->compiled_type_graph,
+                                          parent_type, child_type);
 }
 
 static bool gt_type_checker_obo_is_a(GtTypeChecker *tc,
@@ -75,7 +88,8 @@ static bool gt_type_checker_obo_is_a(GtTypeChecker *tc,
   GtTypeCheckerOBO *tco;
   gt_assert(tc && parent_type && child_type);
   tco = gt_type_checker_obo_cast(tc);
-  return gt_type_graph_is_a(tco->type_graph, parent_type, child_type);
+  return gt_compiled_type_graph_is_a(tco->compiled_type_graph, parent_type,
+                                     child_type);
 }
 
 const GtTypeCheckerClass* gt_type_checker_obo_class(void)
@@ -90,49 +104,128 @@ const GtTypeCheckerClass* gt_type_checker_obo_class(void)
   return &gt_type_checker_class;
 }
 
-static void add_feature_node_from_tree(GtTypeCheckerOBO *tco,
-                                       GtOBOParseTree *obo_parse_tree,
-                                       GtUword stanza_num,
-                                       const char *stanza_key)
-{
-  const char *value;
-  gt_assert(tco && obo_parse_tree && stanza_key);
-  value = gt_obo_parse_tree_get_stanza_value(obo_parse_tree, stanza_num,
-                                             stanza_key);
-  /* do not add values multiple times (possible for "name" values) */
-  if (!gt_cstr_table_get(tco->feature_node_types, value))
-    gt_cstr_table_add(tco->feature_node_types, value);
-  else
-    puts(value);
-}
-
-static int create_feature_nodes(GtTypeCheckerOBO *tco,
-                                const char *obo_file_path, GtError *err)
+static GtTypeGraph* create_type_graph(const char *obo_file_path, GtError *err)
 {
   GtOBOParseTree *obo_parse_tree;
+  GtTypeGraph *type_graph;
   GtUword i;
   gt_error_check(err);
-  gt_assert(tco && obo_file_path);
-  if ((obo_parse_tree = gt_obo_parse_tree_new(obo_file_path, err))) {
-    for (i = 0; i < gt_obo_parse_tree_num_of_stanzas(obo_parse_tree); i++) {
-      if (!strcmp(gt_obo_parse_tree_get_stanza_type(obo_parse_tree, i),
-                  "Term")) {
-        const char *is_obsolete =
-          gt_obo_parse_tree_get_stanza_value(obo_parse_tree, i, "is_obsolete");
-        /* do not add obsolete types */
-        if (!is_obsolete || strcmp(is_obsolete, "true")) {
-          const GtOBOStanza *stanza;
-          add_feature_node_from_tree(tco, obo_parse_tree, i, "id");
-          add_feature_node_from_tree(tco, obo_parse_tree, i, "name");
-          stanza = gt_obo_parse_tree_get_stanza(obo_parse_tree, i);
-          gt_type_graph_add_stanza(tco->type_graph, stanza);
-        }
+  gt_assert(obo_file_path);
+  if (!(obo_parse_tree = gt_obo_parse_tree_new(obo_file_path, err)))
+    return NULL;
+  type_graph = gt_type_graph_new();
+  for (i = 0; i < gt_obo_parse_tree_num_of_stanzas(obo_parse_tree); i++) {
+    if (!strcmp(gt_obo_parse_tree_get_stanza_type(obo_parse_tree, i),
+                "Term")) {
+      const char *is_obsolete =
+        gt_obo_parse_tree_get_stanza_value(obo_parse_tree, i, "is_obsolete");
+      /* do not add obsolete types */
+      if (!is_obsolete || strcmp(is_obsolete, "true")) {
+        gt_type_graph_add_stanza(type_graph,
+                                 gt_obo_parse_tree_get_stanza(obo_parse_tree,
+                                                              i));
       }
     }
-    gt_obo_parse_tree_delete(obo_parse_tree);
-    return 0;
   }
-  return -1;
+  gt_obo_parse_tree_delete(obo_parse_tree);
+  return type_graph;
+}
+
+static bool type_checker_obo_make_dir(const char *path)
+{
+  if (gt_file_exists_and_is_dir(path))
+    return true;
+#ifndef _WIN32
+  return mkdir(path, S_IRWXU | S_IRWXG | S_IRWXO) == 0;
+#else
+  return _mkdir(path) == 0;
+#endif
+}
+
+/* Sets <cache_path> to the file the compiled type graph of <obo_file_path> is
+   cached in. The cache directory is $GT_CACHE_DIR, or the subdirectory
+   'genometools' of $XDG_CACHE_HOME or of $HOME/.cache, which is created if
+   necessary. The file name consists of the name of the OBO file and the MD5
+   sum of its absolute path, such that equally named OBO files from different
+   directories do not share a cache file. Returns false if there is no usable
+   cache directory. */
+static bool type_checker_obo_cache_path(GtStr *cache_path,
+                                        const char *obo_file_path)
+{
+  const char *env, *basename;
+  char *abspath, *md5;
+  gt_str_reset(cache_path);
+  if ((env = getenv("GT_CACHE_DIR")) != NULL && *env != '\0') {
+    gt_str_append_cstr(cache_path, env);
+    if (!gt_file_exists_and_is_dir(env))
+      return false;
+  }
+  else {
+    if ((env = getenv("XDG_CACHE_HOME")) != NULL && *env != '\0')
+      gt_str_append_cstr(cache_path, env);
+    else if ((env = getenv("HOME")) != NULL && *env != '\0') {
+      gt_str_append_cstr(cache_path, env);
+      gt_str_append_char(cache_path, GT_PATH_SEPARATOR);
+      gt_str_append_cstr(cache_path, ".cache");
+    }
+    else
+      return false;
+    if (!type_checker_obo_make_dir(gt_str_get(cache_path)))
+      return false;
+    gt_str_append_char(cache_path, GT_PATH_SEPARATOR);
+    gt_str_append_cstr(cache_path, GT_TYPE_CHECKER_OBO_CACHE_DIR);
+    if (!type_checker_obo_make_dir(gt_str_get(cache_path)))
+      return false;
+  }
+#ifndef _WIN32
+  abspath = realpath(obo_file_path, NULL);
+#else
+  abspath = _fullpath(NULL, obo_file_path, 0);
+#endif
+  md5 = abspath != NULL
+        ? gt_md5_fingerprint(abspath, (GtUword) strlen(abspath))
+        : gt_md5_fingerprint(obo_file_path, (GtUword) strlen(obo_file_path));
+  free(abspath);
+  if ((basename = strrchr(obo_file_path, GT_PATH_SEPARATOR)) != NULL)
+    basename++;
+  else
+    basename = obo_file_path;
+  gt_str_append_char(cache_path, GT_PATH_SEPARATOR);
+  gt_str_append_cstr(cache_path, basename);
+  gt_str_append_char(cache_path, '.');
+  gt_str_append_cstr(cache_path, md5);
+  gt_str_append_cstr(cache_path, GT_TYPE_CHECKER_OBO_CACHE_SUFFIX);
+  gt_free(md5);
+  return true;
+}
+
+/* Maps the compiled type graph of <obo_file_path> from its cache file in the
+   user cache directory, if it is up to date. Otherwise the OBO file is parsed
+   and compiled, and the cache file is (re)written. Failing to read or write
+   the cache file is not an error, the graph is then only kept in memory. */
+static GtCompiledTypeGraph* create_compiled_type_graph(const char
+                                                       *obo_file_path,
+                                                       GtError *err)
+{
+  GtCompiledTypeGraph *ctg = NULL;
+  GtTypeGraph *type_graph;
+  GtStr *cache_path;
+  bool cached;
+  gt_error_check(err);
+  cache_path = gt_str_new();
+  cached = type_checker_obo_cache_path(cache_path, obo_file_path);
+  if (cached)
+    ctg = gt_compiled_type_graph_map(gt_str_get(cache_path), obo_file_path,
+                                     err);
+  if (!ctg && (type_graph = create_type_graph(obo_file_path, err))) {
+    ctg = gt_compiled_type_graph_new(type_graph, obo_file_path);
+    gt_type_graph_delete(type_graph);
+    if (cached && gt_compiled_type_graph_write(ctg, gt_str_get(cache_path),
+                                               err))
+      gt_error_unset(err);
+  }
+  gt_str_delete(cache_path);
+  return ctg;
 }
 
 GtTypeChecker* gt_type_checker_obo_new(const char *obo_file_path, GtError *err)
@@ -145,9 +238,8 @@ GtTypeChecker* gt_type_checker_obo_new(const char *obo_file_path, GtError *err)
   tco = gt_type_checker_obo_cast(tc);
   tco->description= gt_str_new_cstr("OBO file ");
   gt_str_append_cstr(tco->description, obo_file_path);
-  tco->feature_node_types = gt_cstr_table_new();
-  tco->type_graph = gt_type_graph_new();
-  if (create_feature_nodes(tco, obo_file_path, err)) {
+  if (!(tco->compiled_type_graph = create_compiled_type_graph(obo_file_path,
+                                                               err))) {
     gt_type_checker_delete(tc);
     return NULL;
   }
@@ -19,6 +19,7 @@
 #include "core/bool_matrix.h"
 #include "core/cstr_api.h"
 #include "core/hashmap_api.h"
+#include "core/intbits.h"
 #include "core/ma_api.h"
 #include "core/symbol_api.h"
 #include "extended/type_graph.h"
@@ -209,3 +210,209 @@ bool gt_type_graph_is_a(GtTypeGraph *type_graph, const char *parent_type,
   /* check for parent */
   return gt_type_node_is_a(child_node, parent_id);
 }
+
+GtUword gt_type_graph_num_of_nodes(const GtTypeGraph *type_graph)
+{
+  gt_assert(type_graph);
+  return gt_array_size(type_graph->nodes);
+}
+
+const char* gt_type_graph_get_id(const GtTypeGraph *type_graph, GtUword num)
+{
+  gt_assert(type_graph && num < gt_array_size(type_graph->nodes));
+  return gt_type_node_id(*(GtTypeNode**) gt_array_get(type_graph->nodes,
+                                                      num));
+}
+
+const char* gt_type_graph_get_name(const GtTypeGraph *type_graph, GtUword num)
+{
+  gt_assert(type_graph);
+  return gt_hashmap_get(type_graph->id2name,
+                        gt_type_graph_get_id(type_graph, num));
+}
+
+static void closure_postorder(GtUword node, const GtUword *edgestart,
+                              const GtUword *edgetarget, GtBitsequence *visited,
+                              GtUword *order, GtUword *nextorder)
+{
+  GtUword e;
+  GT_SETIBIT(visited, node);
+  for (e = edgestart[node]; e < edgestart[node+1]; e++) {
+    if (!GT_ISIBITSET(visited, edgetarget[e]))
+      closure_postorder(edgetarget[e], edgestart, edgetarget, visited, order,
+                        nextorder);
+  }
+  order[(*nextorder)++] = node;
+}
+
+/* Computes the reflexive transitive closure of the graph with <numofnodes>
+   nodes whose edges are given in compressed row format by <edgestart> and
+   <edgetarget>. Row <i> of <rows> has <wordsperrow> words and receives the
+   set of nodes reachable from node <i>. The nodes are processed in DFS
+   postorder, such that for an acyclic graph the second pass only confirms the
+   result of the first one. */
+static void closure_compute(GtBitsequence *rows, GtUword wordsperrow,
+                            GtUword numofnodes, const GtUword *edgestart,
+                            const GtUword *edgetarget)
+{
+  GtBitsequence *visited;
+  GtUword i, k, e, w, *order, nextorder = 0;
+  bool changed;
+
+  GT_INITBITTAB(visited, numofnodes);
+  order = gt_malloc(sizeof (*order) * numofnodes);
+  for (i = 0; i < numofnodes; i++) {
+    if (!GT_ISIBITSET(visited, i))
+      closure_postorder(i, edgestart, edgetarget, visited, order, &nextorder);
+  }
+  gt_assert(nextorder == numofnodes);
+  memset(rows, 0, sizeof (*rows) * wordsperrow * numofnodes);
+  for (i = 0; i < numofnodes; i++)
+    GT_SETIBIT(rows + i * wordsperrow, i);
+  do {
+    changed = false;
+    for (k = 0; k < numofnodes; k++) {
+      GtBitsequence *row = rows + order[k] * wordsperrow;
+      for (e = edgestart[order[k]]; e < edgestart[order[k]+1]; e++) {
+        const GtBitsequence *parentrow = rows + edgetarget[e] * wordsperrow;
+        for (w = 0; w < wordsperrow; w++) {
+          if ((row[w] | parentrow[w]) != row[w]) {
+            row[w] |= parentrow[w];
+            changed = true;
+          }
+        }
+      }
+    }
+  } while (changed);
+  gt_free(order);
+  gt_free(visited);
+}
+
+/* Stores the direct is_a edges (if <part_of> is false) or the direct is_a and
+   part_of edges (if <part_of> is true) in compressed row format. If
+   <reverse> is true, the edges are stored at their target node. References to
+   undefined or obsolete terms are skipped. */
+static void closure_edges(const GtTypeGraph *type_graph, bool part_of,
+                          bool reverse, GtUword *edgestart, GtUword **edges)
+{
+  GtUword i, j, pass, numofnodes = gt_array_size(type_graph->nodes),
+          *edgetarget = NULL, *fill = NULL;
+  /* the first pass counts the edges per node, the second stores them */
+  memset(edgestart, 0, sizeof (*edgestart) * (numofnodes + 1));
+  for (pass = 0; pass < 2UL; pass++) {
+    if (pass == 1UL) {
+      for (i = 0; i < numofnodes; i++)
+        edgestart[i+1] += edgestart[i];
+      edgetarget = gt_malloc(sizeof (*edgetarget) *
+                             (edgestart[numofnodes] + 1));
+      fill = gt_malloc(sizeof (*fill) * (numofnodes + 1));
+      memcpy(fill, edgestart, sizeof (*fill) * (numofnodes + 1));
+    }
+    for (i = 0; i < numofnodes; i++) {
+      GtTypeNode *node = *(GtTypeNode**) gt_array_get(type_graph->nodes, i);
+      GtUword isasize = gt_type_node_is_a_size(node),
+              size = isasize + (part_of ? gt_type_node_part_of_size(node) : 0);
+      for (j = 0; j < size; j++) {
+        const char *id = j < isasize
+                         ? gt_type_node_is_a_get(node, j)
+                         : gt_type_node_part_of_get(node, j - isasize);
+        GtTypeNode *parent = gt_hashmap_get(type_graph->nodemap, id);
+        GtUword src, dst;
+        if (!parent)
+          continue;
+        src = reverse ? gt_type_node_num(parent) : i;
+        dst = reverse ? i : gt_type_node_num(parent);
+        if (pass == 0)
+          edgestart[src + 1]++;
+        else
+          edgetarget[fill[src]++] = dst;
+      }
+    }
+  }
+  gt_free(fill);
+  *edges = edgetarget;
+}
+
+void gt_type_graph_compute_closures(GtTypeGraph *type_graph,
+                                    GtBitsequence *is_a,
+                                    GtBitsequence *part_of,
+                                    GtUword wordsperrow)
+{
+  GtBitsequence *part_of_in, *transitive_in, *visited;
+  GtUword i, j, p, w, *edgestart, *edgetarget, *queue,
+          numofnodes = gt_array_size(type_graph->nodes);
+  gt_assert(type_graph && is_a && part_of);
+  gt_assert(wordsperrow >= GT_NUMOFINTSFORBITS(numofnodes));
+  edgestart = gt_malloc(sizeof (*edgestart) * (numofnodes + 1));
+  /* is_a closure */
+  closure_edges(type_graph, false, false, edgestart, &edgetarget);
+  closure_compute(is_a, wordsperrow, numofnodes, edgestart, edgetarget);
+  gt_free(edgetarget);
+  /* direct part_of edges, stored by parent */
+  part_of_in = gt_calloc((size_t) (numofnodes * wordsperrow),
+                         sizeof (*part_of_in));
+  for (i = 0; i < numofnodes; i++) {
+    GtTypeNode *node = *(GtTypeNode**) gt_array_get(type_graph->nodes, i);
+    for (j = 0; j < gt_type_node_part_of_size(node); j++) {
+      GtTypeNode *parent = gt_hashmap_get(type_graph->nodemap,
+                                          gt_type_node_part_of_get(node, j));
+      if (parent)
+        GT_SETIBIT(part_of_in + gt_type_node_num(parent) * wordsperrow, i);
+    }
+  }
+  /* transitive part_of edges: if W is_a Y and Z part_of Y, then Z part_of W.
+     Row W of <transitive_in> collects all such Z. */
+  transitive_in = gt_calloc((size_t) (numofnodes * wordsperrow),
+                            sizeof (*transitive_in));
+  for (i = 0; i < numofnodes; i++) {
+    for (j = 0; j < numofnodes; j++) {
+      if (j != i && GT_ISIBITSET(is_a + i * wordsperrow, j)) {
+        for (w = 0; w < wordsperrow; w++)
+          transitive_in[i * wordsperrow + w] |= part_of_in[j * wordsperrow + w];
+      }
+    }
+  }
+  gt_free(part_of_in);
+  /* gt_type_node_has_parent() creates the transitive part_of edges only for
+     the parent P in question, i.e. only edges into P and the nodes P is_a.
+     Hence the nodes having parent P are collected separately for each P by a
+     backward search from P. */
+  memset(part_of, 0, sizeof (*part_of) * wordsperrow * numofnodes);
+  closure_edges(type_graph, true, true, edgestart, &edgetarget);
+  GT_INITBITTAB(visited, numofnodes);
+  queue = gt_malloc(sizeof (*queue) * numofnodes);
+  for (p = 0; p < numofnodes; p++) {
+    GtUword head = 0, tail = 0;
+    GT_CLEARBITTAB(visited, numofnodes);
+    GT_SETIBIT(visited, p);
+    queue[tail++] = p;
+    while (head < tail) {
+      GtUword v = queue[head++], e;
+      GT_SETIBIT(part_of + v * wordsperrow, p);
+      for (e = edgestart[v]; e < edgestart[v+1]; e++) {
+        if (!GT_ISIBITSET(visited, edgetarget[e])) {
+          GT_SETIBIT(visited, edgetarget[e]);
+          queue[tail++] = edgetarget[e];
+        }
+      }
+      if (GT_ISIBITSET(is_a + p * wordsperrow, v)) {
+        for (w = 0; w < wordsperrow; w++) {
+          GtBitsequence bits = transitive_in[v * wordsperrow + w] & ~visited[w];
+          GtUword b;
+          for (b = 0; bits != 0 && b < (GtUword) GT_INTWORDSIZE; b++) {
+            if (bits & GT_ITHBIT(b)) {
+              GT_SETIBIT(visited, GT_MULWORDSIZE(w) + b);
+              queue[tail++] = GT_MULWORDSIZE(w) + b;
+              bits &= ~GT_ITHBIT(b);
+            }
+          }
+        }
+      }
+    }
+  }
+  gt_free(queue);
+  gt_free(visited);
+  gt_free(edgetarget);
+  gt_free(transitive_in);
+  gt_free(edgestart);
+}
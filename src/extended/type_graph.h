@@ -17,6 +17,7 @@
 #ifndef TYPE_GRAPH_H
 #define TYPE_GRAPH_H
 
+#include "core/intbits.h"
 #include "extended/obo_stanza.h"
 
 typedef struct GtTypeGraph GtTypeGraph;
@@ -31,5 +32,20 @@ bool         gt_type_graph_is_partof(GtTypeGraph *type_graph,
 bool         gt_type_graph_is_a(GtTypeGraph *type_graph,
                                 const char *parent_type,
                                 const char *child_type);
+GtUword      gt_type_graph_num_of_nodes(const GtTypeGraph *type_graph);
+/* Returns the ID of the node with number <num>. Nodes are numbered in the
+   order their stanzas were added. */
+const char*  gt_type_graph_get_id(const GtTypeGraph *type_graph, GtUword num);
+const char*  gt_type_graph_get_name(const GtTypeGraph *type_graph,
+                                    GtUword num);
+/* Stores the reflexive transitive closures of the is_a and the part_of
+   relation in the bit matrices <is_a> and <part_of>, which have one row of
+   <wordsperrow> words per node. Bit <j> in row <i> of <is_a> is set if node <i>
+   is_a node <j>. Bit <j> in row <i> of <part_of> is set if
+   <gt_type_graph_is_partof()> reports node <j> as a parent of node <i>. */
+void         gt_type_graph_compute_closures(GtTypeGraph *type_graph,
+                                            GtBitsequence *is_a,
+                                            GtBitsequence *part_of,
+                                            GtUword wordsperrow);
 
 #endif
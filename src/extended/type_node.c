@@ -55,6 +55,12 @@ GtUword gt_type_node_num(const GtTypeNode *type_node)
   return type_node->num;
 }
 
+const char* gt_type_node_id(const GtTypeNode *type_node)
+{
+  gt_assert(type_node);
+  return type_node->id;
+}
+
 void gt_type_node_is_a_add(GtTypeNode *type_node, const char *id)
 {
   gt_assert(type_node && id);
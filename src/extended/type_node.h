@@ -24,6 +24,7 @@ typedef struct GtTypeNode GtTypeNode;
 GtTypeNode*   gt_type_node_new(GtUword num, const char *id);
 void          gt_type_node_delete(GtTypeNode*);
 GtUword       gt_type_node_num(const GtTypeNode*);
+const char*   gt_type_node_id(const GtTypeNode*);
 void          gt_type_node_is_a_add(GtTypeNode*, const char*);
 const char*   gt_type_node_is_a_get(const GtTypeNode*, GtUword);
 GtUword       gt_type_node_is_a_size(const GtTypeNode*);
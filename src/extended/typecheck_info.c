@@ -19,6 +19,7 @@
 #include "core/fileutils.h"
 #include "core/gtdatapath.h"
 #include "core/ma_api.h"
+#include "core/resource_cache.h"
 #include "extended/typecheck_info.h"
 #include "extended/type_checker_builtin_api.h"
 #include "extended/type_checker_obo.h"
@@ -108,6 +109,16 @@ static GtStr* get_obo_path(GtError *err)
   return obo_path;
 }
 
+static void* type_checker_resource_cache_ref(void *type_checker)
+{
+  return gt_type_checker_ref(type_checker);
+}
+
+static void type_checker_resource_cache_delete(void *type_checker)
+{
+  gt_type_checker_delete(type_checker);
+}
+
 GtTypeChecker* gt_typecheck_info_create_type_checker(const GtTypecheckInfo *tci,
                                                      GtError *err)
 {
@@ -141,8 +152,21 @@ GtTypeChecker* gt_typecheck_info_create_type_checker(const GtTypecheckInfo *tci,
       }
     }
 
-    if (!had_err)
-      type_checker = gt_type_checker_obo_new(gt_str_get(obo_file), err);
+    if (!had_err) {
+      GtStr *cachekey = gt_str_new_cstr("type_checker_obo ");
+      gt_str_append_str(cachekey, obo_file);
+      type_checker = gt_resource_cache_get(gt_str_get(cachekey),
+                                           gt_str_get(obo_file));
+      if (!type_checker) {
+        type_checker = gt_type_checker_obo_new(gt_str_get(obo_file), err);
+        if (type_checker) {
+          gt_resource_cache_add(gt_str_get(cachekey), gt_str_get(obo_file),
+                                type_checker, type_checker_resource_cache_ref,
+                                type_checker_resource_cache_delete);
+        }
+      }
+      gt_str_delete(cachekey);
+    }
 
     gt_str_delete(obo_file);
   }
@@ -54,15 +54,16 @@ static int get_seq(GtStr *seq, bool *process, const GtRange *range,
                    GtError *err)
 {
   GtUword sequence_length;
-  char *sequence = NULL;
+  const char *sequence = NULL;
   int had_err;
   gt_error_check(err);
   gt_assert(seq && process && range && seqid && region_mapping);
   had_err = gt_region_mapping_get_sequence_length(region_mapping,
                                                   &sequence_length, seqid, err);
   if (!had_err) {
-    had_err = gt_region_mapping_get_sequence(region_mapping, &sequence, seqid,
-                                             range->start, range->end, err);
+    had_err = gt_region_mapping_get_sequence_view(region_mapping, &sequence,
+                                                  seqid, range->start,
+                                                  range->end, err);
   }
   if (!had_err) {
     gt_assert(range->start && range->end); /* 1-based coordinates */
@@ -80,7 +81,6 @@ static int get_seq(GtStr *seq, bool *process, const GtRange *range,
     else
       *process = false;
   }
-  gt_free(sequence);
   return had_err;
 }
 
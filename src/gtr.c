@@ -84,9 +84,6 @@ GtR* gtr_new(GtError *err)
   GtR *gtr;
   char *seedstr = NULL;
   int had_err = 0;
-#ifndef WITHOUT_CAIRO
-  GtStr *style_file = NULL;
-#endif
   gtr = gt_calloc(1, sizeof (GtR));
   if ((seedstr = getenv("GT_SEED"))) {
     if (gt_parse_uint(&gtr->seed, seedstr) != 0) {
@@ -100,11 +97,31 @@ GtR* gtr_new(GtError *err)
     gtr->testspacepeak = gt_str_new();
     gtr->test_only = gt_str_new();
     gtr->manoutdir = gt_str_new();
-    gtr->L = luaL_newstate();
-    if (!gtr->L) {
-      gt_error_set(err, "out of memory (cannot create new lua state)");
-      had_err = -1;
-    }
+  }
+  if (had_err) {
+    gt_free(gtr);
+    return NULL;
+  }
+  return gtr;
+}
+
+/* The Lua state with all libraries and the default style is only needed to
+   run scripts and for the interactive mode. It is therefore created on first
+   use, which keeps the startup of compiled tools cheap. */
+static int gtr_init_lua(GtR *gtr, GtError *err)
+{
+  int had_err = 0;
+#ifndef WITHOUT_CAIRO
+  GtStr *style_file = NULL;
+#endif
+  gt_error_check(err);
+  gt_assert(gtr);
+  if (gtr->L)
+    return 0;
+  gtr->L = luaL_newstate();
+  if (!gtr->L) {
+    gt_error_set(err, "out of memory (cannot create new lua state)");
+    had_err = -1;
   }
   if (!had_err) {
     luaL_openlibs(gtr->L);    /* open the standard libraries */
@@ -146,11 +163,7 @@ GtR* gtr_new(GtError *err)
   }
   gt_str_delete(style_file);
 #endif
-  if (had_err) {
-    gt_free(gtr);
-    return NULL;
-  }
-  return gtr;
+  return had_err;
 }
 
 static int show_gtr_help(const char *progname, void *data, GtError *err)
@@ -251,9 +264,9 @@ void gtr_register_components(GtR *gtr)
   /* add tools */
   gt_toolbox_delete(gtr->tools);
   gtr->tools = gtt_tools();
-  /* add unit tests */
+  /* unit tests are added on demand in run_tests() */
   gt_hashmap_delete(gtr->unit_tests);
-  gtr->unit_tests = gtt_unit_tests();
+  gtr->unit_tests = NULL;
 }
 
 static int list_tools(GtR *gtr)
@@ -386,6 +399,8 @@ static int run_tests(GtR *gtr, GtError *err)
 
   /* show seed */
   printf("seed=%u\n", gtr->seed);
+  if (!gtr->unit_tests)
+    gtr->unit_tests = gtt_unit_tests();
   gt_hashmap_unit_test(err);
   if (gtr->unit_tests) {
     if (gt_str_length(gtr->test_only) > 0) {
@@ -463,18 +478,22 @@ int gtr_run(GtR *gtr, int argc, const char **argv, GtError *err)
     if (!gtr->tools || !gt_toolbox_has_tool(gtr->tools, argv[0])) {
       /* no tool found -> try to open script */
       if (gt_file_exists(argv[0])) {
-        /* export script */
-        gt_lua_set_script_dir(gtr->L, argv[0]);
-        /* run script */
-        nargv = gt_cstr_array_prefix_first(argv, gt_error_get_progname(err));
-        gt_lua_set_arg(gtr->L, nargv[0], (const char**) nargv+1);
-        if (luaL_dofile(gtr->L, argv[0])) {
-          /* error */
-          gt_assert(lua_isstring(gtr->L, -1)); /* error message on top */
-          gt_error_set(err, "could not execute script %s",
-                       lua_tostring(gtr->L, -1));
-          had_err = -1;
-          lua_pop(gtr->L, 1); /* pop error message */
+        had_err = gtr_init_lua(gtr, err);
+        if (!had_err) {
+          /* export script */
+          gt_lua_set_script_dir(gtr->L, argv[0]);
+          /* run script */
+          nargv = gt_cstr_array_prefix_first(argv,
+                                             gt_error_get_progname(err));
+          gt_lua_set_arg(gtr->L, nargv[0], (const char**) nargv+1);
+          if (luaL_dofile(gtr->L, argv[0])) {
+            /* error */
+            gt_assert(lua_isstring(gtr->L, -1)); /* error message on top */
+            gt_error_set(err, "could not execute script %s",
+                         lua_tostring(gtr->L, -1));
+            had_err = -1;
+            lua_pop(gtr->L, 1); /* pop error message */
+          }
         }
       }
       else {
@@ -521,6 +540,8 @@ int gtr_run(GtR *gtr, int argc, const char **argv, GtError *err)
     }
   }
   gt_cstr_array_delete(nargv);
+  if (!had_err && gtr->interactive)
+    had_err = gtr_init_lua(gtr, err);
   if (!had_err && gtr->interactive) {
     gt_showshortversion(gt_error_get_progname(err));
     gt_lua_set_arg(gtr->L, gt_error_get_progname(err), argv);
@@ -39,15 +39,20 @@
 #include "core/dlist.h"
 #include "core/dyn_bittab.h"
 #include "core/encseq.h"
+#include "core/fasta_index.h"
 #include "core/grep_api.h"
 #include "core/hashmap.h"
 #include "core/hashtable.h"
 #include "core/interval_tree.h"
 #include "core/mathsupport.h"
+#include "core/md5_fingerprint.h"
 #include "core/md5_seqid.h"
+#include "core/md5_tab.h"
 #include "core/quality.h"
 #include "core/queue.h"
+#include "core/resource_cache.h"
 #include "core/sequence_buffer.h"
+#include "core/sharded_hashmap.h"
 #include "core/splitter.h"
 #include "core/symbol.h"
 #include "core/tokenizer.h"
@@ -65,6 +70,7 @@
 #include "extended/feature_index_memory.h"
 #include "extended/feature_node.h"
 #include "extended/feature_node_iterator_api.h"
+#include "extended/feature_store.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_escaping.h"
 #include "extended/golomb.h"
@@ -92,6 +98,7 @@
 #include "match/rdj-strgraph.h"
 #include "match/shu-encseq-gc.h"
 #include "match/xdrop.h"
+#include "tools/gt_batch.h"
 #include "tools/gt_bed_to_gff3.h"
 #include "tools/gt_cds.h"
 #include "tools/gt_chain2dim.h"
@@ -192,6 +199,7 @@ GtToolbox* gtt_tools(void)
      compatibility */
   gt_toolbox_add_hidden_tool(tools, "mutate", gt_seqmutate());
   gt_toolbox_add_hidden_tool(tools, "template", gt_template());
+  gt_toolbox_add_tool(tools, "batch", gt_batch());
   gt_toolbox_add_tool(tools, "bed_to_gff3", gt_bed_to_gff3());
   gt_toolbox_add_tool(tools, "cds", gt_cds());
   gt_toolbox_add_tool(tools, "chain2dim", gt_chain2dim());
@@ -322,11 +330,13 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "encseq gc module", gt_encseq_gc_unit_test);
   gt_hashmap_add(unit_tests, "evaluator class", gt_evaluator_unit_test);
   gt_hashmap_add(unit_tests, "evalue module", gt_evalue_unit_test);
+  gt_hashmap_add(unit_tests, "FASTA index class", gt_fasta_index_unit_test);
   gt_hashmap_add(unit_tests, "feature node iterator example",
                                              gt_feature_node_iterator_example);
   gt_hashmap_add(unit_tests, "feature node class", gt_feature_node_unit_test);
   gt_hashmap_add(unit_tests, "feature in stream class",
                                                 gt_feature_in_stream_unit_test);
+  gt_hashmap_add(unit_tests, "feature store class", gt_feature_store_unit_test);
   gt_hashmap_add(unit_tests, "genome node class", gt_genome_node_unit_test);
   gt_hashmap_add(unit_tests, "gff3 escaping module",
                                                     gt_gff3_escaping_unit_test);
@@ -346,7 +356,10 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "mathsupport module", gt_mathsupport_unit_test);
   gt_hashmap_add(unit_tests, "memory allocator module", gt_ma_unit_test);
   gt_hashmap_add(unit_tests, "multieoplist", gt_multieoplist_unit_test);
+  gt_hashmap_add(unit_tests, "MD5 fingerprint module",
+                                                  gt_md5_fingerprint_unit_test);
   gt_hashmap_add(unit_tests, "MD5 seqid module", gt_md5_seqid_unit_test);
+  gt_hashmap_add(unit_tests, "MD5 table class", gt_md5_tab_unit_test);
   gt_hashmap_add(unit_tests, "rdj: suffix-prefix matches list module",
                                                           gt_spmlist_unit_test);
   gt_hashmap_add(unit_tests, "PBS finder module",
@@ -357,12 +370,16 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "range class", gt_range_unit_test);
   gt_hashmap_add(unit_tests, "ranked list class", gt_ranked_list_unit_test);
   gt_hashmap_add(unit_tests, "red-black tree class", gt_rbtree_unit_test);
+  gt_hashmap_add(unit_tests, "resource cache module",
+                 gt_resource_cache_unit_test);
   gt_hashmap_add(unit_tests, "range minimum query class", gt_rmq_unit_test);
   gt_hashmap_add(unit_tests, "rdj: string graph class", gt_strgraph_unit_test);
   gt_hashmap_add(unit_tests, "priority queue class",
                              gt_priority_queue_unit_test);
   gt_hashmap_add(unit_tests, "safearith example", gt_safearith_example);
   gt_hashmap_add(unit_tests, "safearith module", gt_safearith_unit_test);
+  gt_hashmap_add(unit_tests, "sharded hashmap class",
+                 gt_sharded_hashmap_unit_test);
   gt_hashmap_add(unit_tests, "sequence buffer class",
                                                   gt_sequence_buffer_unit_test);
   gt_hashmap_add(unit_tests, "splicedseq class", gt_splicedseq_unit_test);
@@ -123,7 +123,8 @@ struct GtDiagbandseedInfo
           memlimit,
           maxmat;
   unsigned int spacedseedweight,
-               seedlength;
+               seedlength,
+               minimizer_window;
   GtSpacedSeedSpec *spaced_seed_spec;
   GtDiagbandseedBaseListType splt,
                              kmplt;
@@ -165,9 +166,21 @@ struct GtDiagbandseedExtendParams
        cam_generic;
 };
 
+/* The hash values of the last <width> k-mers of the current range, used to
+   select (w,k)-minimizers. */
+typedef struct
+{
+  GtDiagbandseedKmerPos *kmers;
+  GtCodetype *hashes;
+  unsigned int width;
+  GtUword numofkmers, /* number of k-mers in the current range so far */
+          nextselect; /* index of first k-mer which may still be selected */
+} GtDiagbandseedMinimizerWindow;
+
 typedef struct
 {
   GtKmerPosList *kmerpos_list_ref;
+  GtDiagbandseedMinimizerWindow *minimizer_window;
   GtDiagbandseedSeqnum current_seqnum;
   GtDiagbandseedPosition current_endpos;
   const GtEncseq *encseq;
@@ -246,6 +259,7 @@ GtDiagbandseedInfo *gt_diagbandseed_info_new(const GtEncseq *aencseq,
                                              GtUword memlimit,
                                              unsigned int spacedseedweight,
                                              unsigned int seedlength,
+                                             unsigned int minimizer_window,
                                              bool norev,
                                              bool nofwd,
                                              const GtRange *seedpairdistance,
@@ -283,6 +297,7 @@ GtDiagbandseedInfo *gt_diagbandseed_info_new(const GtEncseq *aencseq,
     info->spaced_seed_spec = NULL;
   }
   info->seedlength = seedlength;
+  info->minimizer_window = minimizer_window;
   info->norev = norev;
   info->nofwd = nofwd;
   info->seedpairdistance = seedpairdistance;
@@ -585,6 +600,90 @@ static GtUword gt_diagbandseed_update_separatorpos(GtRange *specialrange,
   return totallength;
 }
 
+static GtCodetype gt_diagbandseed_minimizer_hash(GtCodetype code)
+{
+  /* invertible integer hash function by Thomas Wang, which avoids that
+     low complexity k-mers like poly-A are preferred as minimizers */
+  code = (~code) + (code << 21);
+  code ^= code >> 24;
+  code = (code + (code << 3)) + (code << 8);
+  code ^= code >> 14;
+  code = (code + (code << 2)) + (code << 4);
+  code ^= code >> 28;
+  code += code << 31;
+  return code;
+}
+
+static GtDiagbandseedMinimizerWindow *gt_diagbandseed_minimizer_window_new(
+                                                    unsigned int width)
+{
+  GtDiagbandseedMinimizerWindow *mw = gt_malloc(sizeof *mw);
+
+  gt_assert(width > 1);
+  mw->kmers = gt_malloc(sizeof *mw->kmers * width);
+  mw->hashes = gt_malloc(sizeof *mw->hashes * width);
+  mw->width = width;
+  mw->numofkmers = 0;
+  mw->nextselect = 0;
+  return mw;
+}
+
+static void gt_diagbandseed_minimizer_window_delete(
+                                  GtDiagbandseedMinimizerWindow *mw)
+{
+  if (mw != NULL)
+  {
+    gt_free(mw->kmers);
+    gt_free(mw->hashes);
+    gt_free(mw);
+  }
+}
+
+/* Append the k-mers of the current window whose hash value is minimal to
+   <kmerpos_list>, unless they were already selected for a previous window.
+   As all k-mers with the minimal hash value are selected, the selection does
+   not depend on the direction in which a sequence is scanned. */
+static void gt_diagbandseed_minimizer_add(GtDiagbandseedMinimizerWindow *mw,
+                                          GtKmerPosList *kmerpos_list,
+                                          const GtDiagbandseedKmerPos
+                                            *kmerpos_entry,
+                                          bool firstinrange)
+{
+  GtUword idx, first;
+  GtCodetype minhash;
+
+  if (firstinrange)
+  {
+    mw->numofkmers = 0;
+    mw->nextselect = 0;
+  }
+  mw->kmers[mw->numofkmers % mw->width] = *kmerpos_entry;
+  mw->hashes[mw->numofkmers % mw->width]
+    = gt_diagbandseed_minimizer_hash(kmerpos_entry->code);
+  mw->numofkmers++;
+  if (mw->numofkmers < mw->width)
+  {
+    return;
+  }
+  first = mw->numofkmers - mw->width;
+  minhash = mw->hashes[first % mw->width];
+  for (idx = first + 1; idx < mw->numofkmers; idx++)
+  {
+    if (mw->hashes[idx % mw->width] < minhash)
+    {
+      minhash = mw->hashes[idx % mw->width];
+    }
+  }
+  for (idx = MAX(first, mw->nextselect); idx < mw->numofkmers; idx++)
+  {
+    if (mw->hashes[idx % mw->width] == minhash)
+    {
+      gt_kmerpos_list_add(kmerpos_list,mw->kmers + idx % mw->width);
+      mw->nextselect = idx + 1;
+    }
+  }
+}
+
 /* Add given code and its seqnum and position to a kmer list. */
 static void gt_diagbandseed_processkmercode(void *prockmerinfo,
                                             bool firstinrange,
@@ -643,7 +742,16 @@ static void gt_diagbandseed_processkmercode(void *prockmerinfo,
                              ? pkinfo->current_endpos + 1
                              : pkinfo->current_endpos - 1;
   kmerpos_entry.seqnum = pkinfo->current_seqnum;
-  gt_kmerpos_list_add(pkinfo->kmerpos_list_ref,&kmerpos_entry);
+  if (pkinfo->minimizer_window != NULL)
+  {
+    gt_diagbandseed_minimizer_add(pkinfo->minimizer_window,
+                                  pkinfo->kmerpos_list_ref,
+                                  &kmerpos_entry,
+                                  firstinrange);
+  } else
+  {
+    gt_kmerpos_list_add(pkinfo->kmerpos_list_ref,&kmerpos_entry);
+  }
 }
 
 /* Uses GtKmercodeiterator for fetching the kmers. */
@@ -812,13 +920,16 @@ static GtUword gt_diagbandseed_longest_code_run(const GtKmerPosList
 }
 
 /* Return a sorted list of k-mers of given seedlength from specified encseq.
- * Only sequences in seqrange will be taken into account.
+ * Only sequences in seqrange will be taken into account. If minimizer_window
+ * is larger than 1, only the (minimizer_window,seedlength)-minimizers are
+ * taken.
  * The caller is responsible for freeing the result. */
 static GtKmerPosList *gt_diagbandseed_get_kmers(
                                    const GtEncseq *encseq,
                                    unsigned int spacedseedweight,
                                    unsigned int seedlength,
                                    const GtSpacedSeedSpec *spaced_seed_spec,
+                                   unsigned int minimizer_window,
                                    GtReadmode readmode,
                                    GtUword seqrange_start,
                                    GtUword seqrange_end,
@@ -844,6 +955,11 @@ static GtKmerPosList *gt_diagbandseed_get_kmers(
     kmerpos_list_len = gt_seed_extend_numofkmers(encseq, seedlength,
                                                  seqrange_start, seqrange_end);
     gt_assert(kmerpos_list_len > 0);
+    if (minimizer_window > 1)
+    {
+      /* expected density of minimizers, the list grows if necessary */
+      kmerpos_list_len = 2 * kmerpos_list_len / (minimizer_window + 1) + 1;
+    }
   }
   kmerpos_list = gt_kmerpos_list_new(kmerpos_list_len,encode_info);
   if (verbose) {
@@ -868,6 +984,10 @@ static GtKmerPosList *gt_diagbandseed_get_kmers(
     gt_timer_start(timer);
   }
   pkinfo.kmerpos_list_ref = kmerpos_list;
+  pkinfo.minimizer_window
+    = minimizer_window > 1
+        ? gt_diagbandseed_minimizer_window_new(minimizer_window)
+        : NULL;
   pkinfo.current_seqnum = seqrange_start;
   pkinfo.current_endpos = 0;
   pkinfo.encseq = encseq;
@@ -904,9 +1024,10 @@ static GtKmerPosList *gt_diagbandseed_get_kmers(
     pkinfo.next_separator = pkinfo.last_specialpos;
   }
 
-  if (gt_encseq_has_twobitencoding(encseq) && gt_encseq_wildcards(encseq) == 0)
+  if (gt_encseq_has_twobitencoding(encseq))
   {
-    /* Use fast access to encseq, requires 2bit-enc and absence of wildcards. */
+    /* Use fast access to encseq, the kmers containing wildcards or separators
+       are skipped with the special ranges. */
     gt_getencseqkmers_twobitencoding_slice(encseq,
                                            readmode,
                                            seedlength,
@@ -925,6 +1046,7 @@ static GtKmerPosList *gt_diagbandseed_get_kmers(
   if (gt_encseq_has_specialranges(encseq)) {
     gt_specialrangeiterator_delete(pkinfo.sri);
   }
+  gt_diagbandseed_minimizer_window_delete(pkinfo.minimizer_window);
   /* reduce size of array to number of entries */
   gt_kmerpos_list_reduce_size(kmerpos_list);
   if (debug_kmer)
@@ -3959,6 +4081,7 @@ static void gt_diagbandseed_process_seeds(GtSeedpairlist *seedpairlist,
 static char *gt_diagbandseed_kmer_filename(const GtEncseq *encseq,
                                            unsigned int spacedseedweight,
                                            unsigned int seedlength,
+                                           unsigned int minimizer_window,
                                            bool forward,
                                            unsigned int numparts,
                                            unsigned int partindex,
@@ -3973,6 +4096,11 @@ static char *gt_diagbandseed_kmer_filename(const GtEncseq *encseq,
   }
   gt_str_append_char(str, '.');
   gt_str_append_uint(str, seedlength);
+  if (minimizer_window > 1)
+  {
+    gt_str_append_char(str, 'w');
+    gt_str_append_uint(str, minimizer_window);
+  }
   gt_str_append_char(str, forward ? 'f' : 'r');
   gt_str_append_uint(str, numparts);
   gt_str_append_char(str, '-');
@@ -4104,6 +4232,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
       = gt_diagbandseed_kmer_filename(arg->aencseq,
                                       arg->spacedseedweight,
                                       arg->seedlength,
+                                      arg->minimizer_window,
                                       true,
                                       anumseqranges,
                                       aidx,
@@ -4134,6 +4263,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
       = gt_diagbandseed_kmer_filename(arg->bencseq,
                                       arg->spacedseedweight,
                                       arg->seedlength,
+                                      arg->minimizer_window,
                                       !arg->nofwd,
                                       bnumseqranges,
                                       bidx,
@@ -4168,6 +4298,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                               arg->spacedseedweight,
                               arg->seedlength,
                               arg->spaced_seed_spec,
+                              arg->minimizer_window,
                               readmode_kmerscan,
                               gt_sequence_parts_info_start_get(bseqranges,bidx),
                               gt_sequence_parts_info_end_get(bseqranges,bidx),
@@ -4370,6 +4501,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
           = gt_diagbandseed_kmer_filename(arg->bencseq,
                                           arg->spacedseedweight,
                                           arg->seedlength,
+                                          arg->minimizer_window,
                                           false,
                                           bnumseqranges,
                                           bidx,
@@ -4394,6 +4526,7 @@ static int gt_diagbandseed_algorithm(const GtDiagbandseedInfo *arg,
                               arg->spacedseedweight,
                               arg->seedlength,
                               arg->spaced_seed_spec,
+                              arg->minimizer_window,
                               readmode_kmerscan,
                               gt_sequence_parts_info_start_get(bseqranges,bidx),
                               gt_sequence_parts_info_end_get(bseqranges,bidx),
@@ -4678,12 +4811,101 @@ static void gt_diagbandseed_out_sequences_with_matches(
   gt_free(string_buffer);
 }
 
-/* Run the algorithm by iterating over all combinations of sequence ranges. */
-int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
-                        const GtSequencePartsInfo *aseqranges,
-                        const GtSequencePartsInfo *bseqranges,
-                        const GtUwordPair *pick,
-                        GtError *err)
+struct GtDiagbandseedKmerIndex
+{
+  const GtEncseq *aencseq;
+  GtKmerPosListEncodeInfo **encode_info_tab;
+  GtKmerPosList **kmerpos_list_tab;
+  GtUword numofparts;
+  unsigned int spacedseedweight,
+               seedlength,
+               minimizer_window;
+  GtDiagbandseedBaseListType kmplt;
+};
+
+GtDiagbandseedKmerIndex *gt_diagbandseed_kmer_index_new(
+                                        const GtDiagbandseedInfo *arg,
+                                        const GtSequencePartsInfo *aseqranges,
+                                        const GtUwordPair *pick)
+{
+  GtDiagbandseedKmerIndex *kmer_index;
+  GtUword aidx;
+
+  gt_assert(arg != NULL && !arg->use_kmerfile && pick != NULL);
+  kmer_index = gt_malloc(sizeof *kmer_index);
+  kmer_index->aencseq = arg->aencseq;
+  kmer_index->numofparts = gt_sequence_parts_info_number(aseqranges);
+  kmer_index->spacedseedweight = arg->spacedseedweight;
+  kmer_index->seedlength = arg->seedlength;
+  kmer_index->minimizer_window = arg->minimizer_window;
+  kmer_index->kmplt = arg->kmplt;
+  kmer_index->encode_info_tab
+    = gt_calloc((size_t) kmer_index->numofparts,
+                sizeof *kmer_index->encode_info_tab);
+  kmer_index->kmerpos_list_tab
+    = gt_calloc((size_t) kmer_index->numofparts,
+                sizeof *kmer_index->kmerpos_list_tab);
+  for (aidx = 0; aidx < kmer_index->numofparts; aidx++)
+  {
+    if (pick->a != GT_UWORD_MAX && pick->a != aidx)
+    {
+      continue;
+    }
+    kmer_index->encode_info_tab[aidx]
+      = gt_kmerpos_encode_info_new(arg->kmplt,
+                                   arg->aencseq,
+                                   arg->spacedseedweight,
+                                   aseqranges,
+                                   aidx);
+    kmer_index->kmerpos_list_tab[aidx]
+      = gt_diagbandseed_get_kmers(
+                              arg->aencseq,
+                              arg->spacedseedweight,
+                              arg->seedlength,
+                              arg->spaced_seed_spec,
+                              arg->minimizer_window,
+                              GT_READMODE_FORWARD,
+                              gt_sequence_parts_info_start_get(aseqranges,aidx),
+                              gt_sequence_parts_info_end_get(aseqranges,aidx),
+                              kmer_index->encode_info_tab[aidx],
+                              arg->debug_kmer,
+                              arg->verbose,
+                              0,
+                              stdout);
+  }
+  return kmer_index;
+}
+
+void gt_diagbandseed_kmer_index_delete(GtDiagbandseedKmerIndex *kmer_index)
+{
+  if (kmer_index != NULL)
+  {
+    GtUword aidx;
+
+    for (aidx = 0; aidx < kmer_index->numofparts; aidx++)
+    {
+      if (kmer_index->kmerpos_list_tab[aidx] != NULL)
+      {
+        gt_kmerpos_list_delete(kmer_index->kmerpos_list_tab[aidx]);
+      }
+      gt_kmerpos_encode_info_delete(kmer_index->encode_info_tab[aidx]);
+    }
+    gt_free(kmer_index->kmerpos_list_tab);
+    gt_free(kmer_index->encode_info_tab);
+    gt_free(kmer_index);
+  }
+}
+
+/* Run the algorithm by iterating over all combinations of sequence ranges.
+   If <kmer_index> is not <NULL>, the k-mer lists of <aseqranges> are taken
+   from it instead of being computed. */
+static int gt_diagbandseed_run_generic(const GtDiagbandseedInfo *arg,
+                                       const GtDiagbandseedKmerIndex
+                                         *kmer_index,
+                                       const GtSequencePartsInfo *aseqranges,
+                                       const GtSequencePartsInfo *bseqranges,
+                                       const GtUwordPair *pick,
+                                       GtError *err)
 {
   const bool self = arg->aencseq == arg->bencseq ? true : false;
   const bool apick = pick->a != GT_UWORD_MAX ? true : false;
@@ -4752,6 +4974,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
         path = gt_diagbandseed_kmer_filename(arg->bencseq,
                                              arg->spacedseedweight,
                                              arg->seedlength,
+                                             arg->minimizer_window,
                                              fwd,
                                              bnumseqranges,
                                              bidx,
@@ -4767,6 +4990,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                               arg->spacedseedweight,
                               arg->seedlength,
                               arg->spaced_seed_spec,
+                              arg->minimizer_window,
                               readmode_kmerscan,
                               gt_sequence_parts_info_start_get(bseqranges,bidx),
                               gt_sequence_parts_info_end_get(bseqranges,bidx),
@@ -4823,22 +5047,34 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
     {
       continue;
     }
-    aencode_info = gt_kmerpos_encode_info_new(arg->kmplt,
-                                              arg->aencseq,
-                                              arg->spacedseedweight,
-                                              aseqranges,
-                                              aidx);
+    if (kmer_index != NULL)
+    {
+      gt_assert(aidx < kmer_index->numofparts &&
+                kmer_index->kmerpos_list_tab[aidx] != NULL);
+      aencode_info = NULL;
+      alist = kmer_index->kmerpos_list_tab[aidx];
+      use_alist = true;
+    } else
+    {
+      aencode_info = gt_kmerpos_encode_info_new(arg->kmplt,
+                                                arg->aencseq,
+                                                arg->spacedseedweight,
+                                                aseqranges,
+                                                aidx);
+    }
     if (arg->use_kmerfile) {
       path = gt_diagbandseed_kmer_filename(arg->aencseq,
                                            arg->spacedseedweight,
                                            arg->seedlength,
+                                           arg->minimizer_window,
                                            true,
                                            anumseqranges,
                                            aidx,
                                            gt_diagbandseed_kmplt(
                                               aencode_info));
     }
-    if (!arg->use_kmerfile || gt_create_or_update_file(path,arg->aencseq))
+    if (kmer_index == NULL &&
+        (!arg->use_kmerfile || gt_create_or_update_file(path,arg->aencseq)))
     {
       use_alist = true;
       alist = gt_diagbandseed_get_kmers(
@@ -4846,6 +5082,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                               arg->spacedseedweight,
                               arg->seedlength,
                               arg->spaced_seed_spec,
+                              arg->minimizer_window,
                               GT_READMODE_FORWARD,
                               gt_sequence_parts_info_start_get(aseqranges,aidx),
                               gt_sequence_parts_info_end_get(aseqranges,aidx),
@@ -4970,7 +5207,7 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
       gt_array_delete(combinations);
     }
 #endif
-    if (use_alist) {
+    if (use_alist && kmer_index == NULL) {
       gt_kmerpos_list_delete(alist);
     }
     gt_kmerpos_encode_info_delete(aencode_info);
@@ -5096,3 +5333,32 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
   gt_ft_trimstat_delete(trimstat);
   return had_err;
 }
+
+int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
+                        const GtSequencePartsInfo *aseqranges,
+                        const GtSequencePartsInfo *bseqranges,
+                        const GtUwordPair *pick,
+                        GtError *err)
+{
+  return gt_diagbandseed_run_generic(arg,NULL,aseqranges,bseqranges,pick,err);
+}
+
+int gt_diagbandseed_run_with_kmer_index(const GtDiagbandseedInfo *arg,
+                                        const GtDiagbandseedKmerIndex
+                                          *kmer_index,
+                                        const GtSequencePartsInfo *aseqranges,
+                                        const GtSequencePartsInfo *bseqranges,
+                                        const GtUwordPair *pick,
+                                        GtError *err)
+{
+  gt_assert(arg != NULL && kmer_index != NULL && !arg->use_kmerfile);
+  gt_assert(kmer_index->aencseq == arg->aencseq &&
+            kmer_index->numofparts ==
+              gt_sequence_parts_info_number(aseqranges) &&
+            kmer_index->spacedseedweight == arg->spacedseedweight &&
+            kmer_index->seedlength == arg->seedlength &&
+            kmer_index->minimizer_window == arg->minimizer_window &&
+            kmer_index->kmplt == arg->kmplt);
+  return gt_diagbandseed_run_generic(arg,kmer_index,aseqranges,bseqranges,
+                                     pick,err);
+}
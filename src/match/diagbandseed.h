@@ -30,6 +30,10 @@
 
 typedef struct GtDiagbandseedInfo GtDiagbandseedInfo;
 typedef struct GtDiagbandseedExtendParams GtDiagbandseedExtendParams;
+/* A <GtDiagbandseedKmerIndex> keeps the sorted k-mer lists of the parts of
+   the first sequence set in memory, so that several second sequence sets can
+   be compared to it without computing these lists again. */
+typedef struct GtDiagbandseedKmerIndex GtDiagbandseedKmerIndex;
 
 typedef enum
 { /* keep the order consistent with gt_base_list_arguments */
@@ -46,6 +50,29 @@ int gt_diagbandseed_run(const GtDiagbandseedInfo *arg,
                         const GtUwordPair *pick,
                         GtError *err);
 
+/* Compute the k-mer lists of all parts in <aseqranges> of the first sequence
+   set of <arg>, or only of part <pick->a> if this is not <GT_UWORD_MAX>.
+   The option -kmerfile is not supported, i.e. <arg> must not use k-mer
+   files. */
+GtDiagbandseedKmerIndex *gt_diagbandseed_kmer_index_new(
+                                        const GtDiagbandseedInfo *arg,
+                                        const GtSequencePartsInfo *aseqranges,
+                                        const GtUwordPair *pick);
+
+void gt_diagbandseed_kmer_index_delete(GtDiagbandseedKmerIndex *kmer_index);
+
+/* Like <gt_diagbandseed_run()>, but take the k-mer lists of the first
+   sequence set from <kmer_index>, which must have been created for the same
+   first sequence set, parts and seed parameters. The results are identical
+   to those of <gt_diagbandseed_run()>. */
+int gt_diagbandseed_run_with_kmer_index(const GtDiagbandseedInfo *arg,
+                                        const GtDiagbandseedKmerIndex
+                                          *kmer_index,
+                                        const GtSequencePartsInfo *aseqranges,
+                                        const GtSequencePartsInfo *bseqranges,
+                                        const GtUwordPair *pick,
+                                        GtError *err);
+
 /* The constructor for GtDiagbandseedInfo*/
 GtDiagbandseedInfo *gt_diagbandseed_info_new(const GtEncseq *aencseq,
                                              const GtEncseq *bencseq,
@@ -53,6 +80,7 @@ GtDiagbandseedInfo *gt_diagbandseed_info_new(const GtEncseq *aencseq,
                                              GtUword memlimit,
                                              unsigned int spacedseedweight,
                                              unsigned int seedlength,
+                                             unsigned int minimizer_window,
                                              bool norev,
                                              bool nofwd,
                                              const GtRange *seedpairdistance,
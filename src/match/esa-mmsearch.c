@@ -15,13 +15,18 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
+#include "core/arraydef.h"
 #include "core/chardef.h"
 #include "core/divmodmul.h"
+#include "core/ma_api.h"
 #include "core/minmax.h"
+#include "core/qsort_r_api.h"
 #include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/types_api.h"
 #include "core/timer_api.h"
 #include "core/format64.h"
+#include "core/thread_api.h"
 #include "revcompl.h"
 #include "lcpinterval.h"
 #include "esa-map.h"
@@ -29,6 +34,7 @@
 #include "sfx-apfxlen.h"
 #include "sfx-suffixer.h"
 #include "esa-minunique.h"
+#include "qgram2code.h"
 #include "esa-mmsearch.h"
 
 typedef struct
@@ -344,6 +350,438 @@ void gt_mmsearchiterator_delete(GtMMsearchiterator *mmsi)
   }
 }
 
+/* The following implements the batched search of many patterns against the
+   same suffix array. The patterns are sorted lexicographically and
+   duplicates are removed. For each pattern the intervals of some of its
+   prefixes are maintained on a stack, so that a pattern only has to be
+   searched in the interval of the longest prefix it shares with the
+   previous pattern. If a bucket table is available, the bucket of the first
+   prefixlength characters is used instead of a search from the root. */
+
+typedef struct
+{
+  GtUword start, length;
+} GtMMsearchbatchpattern;
+
+struct GtMMsearchbatch
+{
+  const GtEncseq *dbencseq;
+  const ESASuffixptr *suftab;
+  GtReadmode readmode;
+  GtUword totallength;
+  const GtBcktab *bcktab;
+  const GtCodetype **multimappower;
+  unsigned int prefixlength;
+  GtUchar *patternspace;
+  GtUword patternspace_nextfree, patternspace_allocated;
+  GtMMsearchbatchpattern *patterns;
+  GtUword numofpatterns, allocatedpatterns;
+  GtUword *order; /* pattern numbers in lexicographic order */
+  Lcpinterval *results; /* indexed by pattern number */
+  GtUword numofunique;
+};
+
+GtMMsearchbatch *gt_mmsearchbatch_new(const GtEncseq *dbencseq,
+                                      const void *voidsuftab, /* XXX */
+                                      GtReadmode readmode,
+                                      const GtBcktab *bcktab,
+                                      unsigned int prefixlength)
+{
+  GtMMsearchbatch *mmsb = gt_malloc(sizeof *mmsb);
+
+  mmsb->dbencseq = dbencseq;
+  mmsb->suftab = (const ESASuffixptr *) voidsuftab; /* XXX */
+  mmsb->readmode = readmode;
+  mmsb->totallength = gt_encseq_total_length(dbencseq);
+  mmsb->bcktab = bcktab;
+  mmsb->prefixlength = bcktab != NULL ? prefixlength : 0;
+  mmsb->multimappower = bcktab != NULL ? gt_bcktab_multimappower(bcktab)
+                                       : NULL;
+  mmsb->patternspace = NULL;
+  mmsb->patternspace_nextfree = mmsb->patternspace_allocated = 0;
+  mmsb->patterns = NULL;
+  mmsb->numofpatterns = mmsb->allocatedpatterns = 0;
+  mmsb->order = NULL;
+  mmsb->results = NULL;
+  mmsb->numofunique = 0;
+  return mmsb;
+}
+
+void gt_mmsearchbatch_add(GtMMsearchbatch *mmsb,
+                          const GtUchar *pattern,
+                          GtUword patternlength)
+{
+  gt_assert(mmsb != NULL && mmsb->results == NULL);
+  if (mmsb->numofpatterns >= mmsb->allocatedpatterns)
+  {
+    mmsb->allocatedpatterns = mmsb->allocatedpatterns * 1.2 + 1024UL;
+    mmsb->patterns = gt_realloc(mmsb->patterns,sizeof *mmsb->patterns *
+                                               mmsb->allocatedpatterns);
+  }
+  if (mmsb->patternspace_nextfree + patternlength >
+      mmsb->patternspace_allocated)
+  {
+    mmsb->patternspace_allocated = mmsb->patternspace_allocated * 1.2 +
+                                   patternlength + 4096UL;
+    mmsb->patternspace = gt_realloc(mmsb->patternspace,
+                                    sizeof *mmsb->patternspace *
+                                    mmsb->patternspace_allocated);
+  }
+  memcpy(mmsb->patternspace + mmsb->patternspace_nextfree,pattern,
+         sizeof *pattern * patternlength);
+  mmsb->patterns[mmsb->numofpatterns].start = mmsb->patternspace_nextfree;
+  mmsb->patterns[mmsb->numofpatterns++].length = patternlength;
+  mmsb->patternspace_nextfree += patternlength;
+}
+
+GtUword gt_mmsearchbatch_size(const GtMMsearchbatch *mmsb)
+{
+  gt_assert(mmsb != NULL);
+  return mmsb->numofpatterns;
+}
+
+GtUword gt_mmsearchbatch_unique(const GtMMsearchbatch *mmsb)
+{
+  gt_assert(mmsb != NULL && mmsb->results != NULL);
+  return mmsb->numofunique;
+}
+
+const GtUchar *gt_mmsearchbatch_pattern(GtUword *patternlength,
+                                        const GtMMsearchbatch *mmsb,
+                                        GtUword patternnum)
+{
+  gt_assert(mmsb != NULL && patternnum < mmsb->numofpatterns);
+  *patternlength = mmsb->patterns[patternnum].length;
+  return mmsb->patternspace + mmsb->patterns[patternnum].start;
+}
+
+/* returns the length of the longest common prefix of the patterns in
+   <lcp> and their order in the return value */
+static int gt_mmsearchbatch_cmp_lcp(GtUword *lcp,
+                                    const GtMMsearchbatch *mmsb,
+                                    GtUword pnum1,GtUword pnum2)
+{
+  const GtUchar *p1 = mmsb->patternspace + mmsb->patterns[pnum1].start,
+                *p2 = mmsb->patternspace + mmsb->patterns[pnum2].start;
+  GtUword idx, minlen = MIN(mmsb->patterns[pnum1].length,
+                            mmsb->patterns[pnum2].length);
+
+  for (idx = 0; idx < minlen; idx++)
+  {
+    if (p1[idx] != p2[idx])
+    {
+      *lcp = idx;
+      return p1[idx] < p2[idx] ? -1 : 1;
+    }
+  }
+  *lcp = minlen;
+  if (mmsb->patterns[pnum1].length == mmsb->patterns[pnum2].length)
+  {
+    return 0;
+  }
+  return mmsb->patterns[pnum1].length < mmsb->patterns[pnum2].length ? -1 : 1;
+}
+
+static int gt_mmsearchbatch_compare(const void *a,const void *b,void *data)
+{
+  GtUword lcp;
+  int cmp = gt_mmsearchbatch_cmp_lcp(&lcp,(const GtMMsearchbatch *) data,
+                                     *(const GtUword *) a,
+                                     *(const GtUword *) b);
+
+  if (cmp == 0) /* stable with respect to the pattern number */
+  {
+    return *(const GtUword *) a < *(const GtUword *) b ? -1 : 1;
+  }
+  return cmp;
+}
+
+typedef struct
+{
+  const GtMMsearchbatch *mmsb;
+  GtUword firstunique, lastunique; /* indexes into order */
+  GtThread *thread;
+} GtMMsearchbatchthreadinfo;
+
+GT_DECLAREARRAYSTRUCT(Lcpinterval);
+
+#define GT_MMSEARCHBATCH_EMPTY(ITV) ((ITV)->left > (ITV)->right)
+
+#define GT_MMSEARCHBATCH_PUSH(OFFSET,LEFT,RIGHT)\
+        GT_GETNEXTFREEINARRAY(itvptr,&stack,Lcpinterval,32);\
+        itvptr->offset = OFFSET;\
+        itvptr->left = LEFT;\
+        itvptr->right = RIGHT
+
+static void gt_mmsearchbatch_searchinterval(const GtMMsearchbatch *mmsb,
+                                            GtEncseqReader *esr,
+                                            Lcpinterval *result,
+                                            const Lcpinterval *parent,
+                                            const GtQuerysubstring
+                                              *querysubstring,
+                                            GtUword matchlength)
+{
+  *result = *parent;
+  if (!gt_mmsearch(mmsb->dbencseq,esr,mmsb->suftab,mmsb->readmode,result,
+                   querysubstring,matchlength))
+  {
+    result->left = 1UL;
+    result->right = 0;
+  }
+  result->offset = matchlength;
+}
+
+static void gt_mmsearchbatch_range(const GtMMsearchbatch *mmsb,
+                                   Lcpinterval *results,
+                                   GtUword firstunique,
+                                   GtUword lastunique)
+{
+  GtArrayLcpinterval stack;
+  Lcpinterval *itvptr, *top, newitv;
+  GtEncseqReader *esr;
+  GtQueryrepresentation queryrep;
+  GtQuerysubstring querysubstring;
+  GtUword idx, pnum, previous = 0, lcp;
+
+  esr = gt_encseq_create_reader_with_readmode(mmsb->dbencseq,
+                                              mmsb->readmode,0);
+  GT_INITARRAY(&stack,Lcpinterval);
+  GT_MMSEARCHBATCH_PUSH(0,0,mmsb->totallength);
+  queryrep.encseq = NULL;
+  queryrep.readmode = GT_READMODE_FORWARD;
+  queryrep.startpos = 0;
+  querysubstring.queryrep = &queryrep;
+  querysubstring.currentoffset = 0;
+  for (idx = firstunique; idx <= lastunique; idx++)
+  {
+    pnum = mmsb->order[idx];
+    if (idx > firstunique)
+    {
+      (void) gt_mmsearchbatch_cmp_lcp(&lcp,mmsb,previous,pnum);
+    } else
+    {
+      lcp = 0;
+    }
+    previous = pnum;
+    queryrep.sequence = mmsb->patternspace + mmsb->patterns[pnum].start;
+    queryrep.seqlen = mmsb->patterns[pnum].length;
+    while (stack.spaceLcpinterval[stack.nextfreeLcpinterval-1].offset > lcp)
+    {
+      stack.nextfreeLcpinterval--;
+    }
+    top = stack.spaceLcpinterval + stack.nextfreeLcpinterval - 1;
+    if (!GT_MMSEARCHBATCH_EMPTY(top) && lcp > top->offset &&
+        lcp < queryrep.seqlen &&
+        (mmsb->bcktab == NULL || lcp > (GtUword) mmsb->prefixlength ||
+         queryrep.seqlen < (GtUword) mmsb->prefixlength))
+    {
+      /* narrow the interval to the prefix shared with the previous pattern,
+         as the following patterns are likely to share it as well */
+      gt_mmsearchbatch_searchinterval(mmsb,esr,&newitv,top,&querysubstring,
+                                      lcp);
+      GT_MMSEARCHBATCH_PUSH(newitv.offset,newitv.left,newitv.right);
+      top = stack.spaceLcpinterval + stack.nextfreeLcpinterval - 1;
+    }
+    if (!GT_MMSEARCHBATCH_EMPTY(top) &&
+        top->offset < (GtUword) mmsb->prefixlength &&
+        queryrep.seqlen >= (GtUword) mmsb->prefixlength)
+    {
+      GtCodetype code = 0;
+
+      if (qgram2code(&code,mmsb->multimappower,mmsb->prefixlength,
+                     queryrep.sequence) == mmsb->prefixlength)
+      {
+        GtBucketspecification bucketspec;
+
+        gt_bcktab_calcboundaries(&bucketspec,mmsb->bcktab,code);
+        if (bucketspec.nonspecialsinbucket == 0)
+        {
+          GT_MMSEARCHBATCH_PUSH((GtUword) mmsb->prefixlength,1UL,0);
+        } else
+        {
+          GT_MMSEARCHBATCH_PUSH((GtUword) mmsb->prefixlength,
+                                bucketspec.left,
+                                bucketspec.left +
+                                bucketspec.nonspecialsinbucket - 1);
+        }
+        top = stack.spaceLcpinterval + stack.nextfreeLcpinterval - 1;
+      }
+    }
+    if (GT_MMSEARCHBATCH_EMPTY(top))
+    {
+      results[pnum] = *top;
+    } else
+    {
+      if (top->offset < queryrep.seqlen)
+      {
+        gt_mmsearchbatch_searchinterval(mmsb,esr,&newitv,top,&querysubstring,
+                                        queryrep.seqlen);
+        GT_MMSEARCHBATCH_PUSH(newitv.offset,newitv.left,newitv.right);
+        top = stack.spaceLcpinterval + stack.nextfreeLcpinterval - 1;
+      }
+      results[pnum] = *top;
+    }
+  }
+  GT_FREEARRAY(&stack,Lcpinterval);
+  gt_encseq_reader_delete(esr);
+}
+
+static void *gt_mmsearchbatch_thread_caller(void *data)
+{
+  GtMMsearchbatchthreadinfo *threadinfo = (GtMMsearchbatchthreadinfo *) data;
+
+  gt_mmsearchbatch_range(threadinfo->mmsb,threadinfo->mmsb->results,
+                         threadinfo->firstunique,threadinfo->lastunique);
+  return NULL;
+}
+
+int gt_mmsearchbatch_run(GtMMsearchbatch *mmsb,unsigned int numofparts,
+                         GtError *err)
+{
+  GtUword idx, *uniqueorder, *tmporder, widthofpart;
+  GtMMsearchbatchthreadinfo *th_tab;
+  unsigned int part;
+  bool haserr = false;
+
+  gt_error_check(err);
+  gt_assert(mmsb != NULL && mmsb->results == NULL && numofparts > 0);
+  mmsb->results = gt_malloc(sizeof *mmsb->results *
+                            (mmsb->numofpatterns + 1));
+  if (mmsb->numofpatterns == 0)
+  {
+    return 0;
+  }
+  mmsb->order = gt_malloc(sizeof *mmsb->order * mmsb->numofpatterns);
+  for (idx = 0; idx < mmsb->numofpatterns; idx++)
+  {
+    mmsb->order[idx] = idx;
+  }
+  gt_qsort_r(mmsb->order,(size_t) mmsb->numofpatterns,sizeof *mmsb->order,
+             mmsb,gt_mmsearchbatch_compare);
+  /* only the first of a run of identical patterns is searched, the others
+     copy its result afterwards */
+  uniqueorder = gt_malloc(sizeof *uniqueorder * mmsb->numofpatterns);
+  mmsb->numofunique = 0;
+  for (idx = 0; idx < mmsb->numofpatterns; idx++)
+  {
+    GtUword lcp;
+
+    if (idx == 0 || gt_mmsearchbatch_cmp_lcp(&lcp,mmsb,mmsb->order[idx-1],
+                                             mmsb->order[idx]) != 0)
+    {
+      uniqueorder[mmsb->numofunique++] = mmsb->order[idx];
+    }
+  }
+  if ((GtUword) numofparts > mmsb->numofunique)
+  {
+    numofparts = (unsigned int) mmsb->numofunique;
+  }
+  widthofpart = mmsb->numofunique/numofparts;
+  th_tab = gt_malloc(sizeof *th_tab * numofparts);
+  /* the runs use the sorted unique patterns, so temporarily exchange the
+     order */
+  tmporder = mmsb->order;
+  mmsb->order = uniqueorder;
+  for (part = 0; part < numofparts; part++)
+  {
+    th_tab[part].mmsb = mmsb;
+    th_tab[part].firstunique = part * widthofpart;
+    th_tab[part].lastunique = part == numofparts - 1
+                                ? mmsb->numofunique - 1
+                                : (part + 1) * widthofpart - 1;
+    th_tab[part].thread = NULL;
+  }
+#ifdef GT_THREADS_ENABLED
+  for (part = 1; !haserr && part < numofparts; part++)
+  {
+    th_tab[part].thread = gt_thread_new(gt_mmsearchbatch_thread_caller,
+                                        th_tab + part,err);
+    if (th_tab[part].thread == NULL)
+    {
+      haserr = true;
+    }
+  }
+  if (!haserr)
+  {
+    (void) gt_mmsearchbatch_thread_caller(th_tab);
+  }
+  for (part = 1; part < numofparts; part++)
+  {
+    if (th_tab[part].thread != NULL)
+    {
+      gt_thread_join(th_tab[part].thread);
+      gt_thread_delete(th_tab[part].thread);
+    }
+  }
+#else
+  for (part = 0; part < numofparts; part++)
+  {
+    (void) gt_mmsearchbatch_thread_caller(th_tab + part);
+  }
+#endif
+  mmsb->order = tmporder;
+  gt_free(uniqueorder);
+  gt_free(th_tab);
+  for (idx = 1; idx < mmsb->numofpatterns; idx++)
+  {
+    GtUword lcp;
+
+    if (gt_mmsearchbatch_cmp_lcp(&lcp,mmsb,mmsb->order[idx-1],
+                                 mmsb->order[idx]) == 0)
+    {
+      mmsb->results[mmsb->order[idx]] = mmsb->results[mmsb->order[idx-1]];
+    }
+  }
+  return haserr ? -1 : 0;
+}
+
+GtUword gt_mmsearchbatch_count(const GtMMsearchbatch *mmsb,GtUword patternnum)
+{
+  const Lcpinterval *itv;
+
+  gt_assert(mmsb != NULL && mmsb->results != NULL &&
+            patternnum < mmsb->numofpatterns);
+  itv = mmsb->results + patternnum;
+  return GT_MMSEARCHBATCH_EMPTY(itv) ? 0 : itv->right - itv->left + 1;
+}
+
+GtMMsearchiterator *gt_mmsearchbatch_iterator(const GtMMsearchbatch *mmsb,
+                                              GtUword patternnum)
+{
+  GtMMsearchiterator *mmsi;
+
+  gt_assert(mmsb != NULL && mmsb->results != NULL &&
+            patternnum < mmsb->numofpatterns);
+  mmsi = gt_mmsearchiterator_new_empty();
+  mmsi->suftab = mmsb->suftab;
+  mmsi->lcpitv = mmsb->results[patternnum];
+  mmsi->sufindex = mmsi->lcpitv.left;
+  return mmsi;
+}
+
+void gt_mmsearchbatch_reset(GtMMsearchbatch *mmsb)
+{
+  gt_assert(mmsb != NULL);
+  gt_free(mmsb->order);
+  mmsb->order = NULL;
+  gt_free(mmsb->results);
+  mmsb->results = NULL;
+  mmsb->numofpatterns = mmsb->patternspace_nextfree = 0;
+  mmsb->numofunique = 0;
+}
+
+void gt_mmsearchbatch_delete(GtMMsearchbatch *mmsb)
+{
+  if (mmsb != NULL)
+  {
+    gt_free(mmsb->patternspace);
+    gt_free(mmsb->patterns);
+    gt_free(mmsb->order);
+    gt_free(mmsb->results);
+    gt_free(mmsb);
+  }
+}
+
 static bool gt_mmsearch_isleftmaximal(const GtEncseq *dbencseq,
                                       GtReadmode readmode,
                                       GtUword dbstart,
@@ -47,6 +47,51 @@ void gt_mmsearchiterator_delete(GtMMsearchiterator *mmsi);
 
 GtUword gt_mmsearchiterator_count(const GtMMsearchiterator *mmsi);
 
+/* A <GtMMsearchbatch> collects many patterns and searches them together in
+   the suffix array. The patterns are sorted and deduplicated, so that the
+   interval of a pattern is searched within the interval of the prefix it
+   shares with the previous pattern. If <bcktab> is not NULL, the buckets of
+   length <prefixlength> are used as initial intervals. */
+typedef struct GtMMsearchbatch GtMMsearchbatch;
+
+GtMMsearchbatch *gt_mmsearchbatch_new(const GtEncseq *dbencseq,
+                                      const void *voidsuftab, /* XXX */
+                                      GtReadmode readmode,
+                                      const GtBcktab *bcktab,
+                                      unsigned int prefixlength);
+
+/* Adds a copy of <pattern> of length <patternlength> to <mmsb>. The patterns
+   are numbered consecutively from 0 in the order they are added. */
+void gt_mmsearchbatch_add(GtMMsearchbatch *mmsb,
+                          const GtUchar *pattern,
+                          GtUword patternlength);
+
+/* Searches all patterns added so far, splitting the sorted unique patterns
+   into <numofparts> parts which are processed by separate threads. */
+int gt_mmsearchbatch_run(GtMMsearchbatch *mmsb,unsigned int numofparts,
+                         GtError *err);
+
+GtUword gt_mmsearchbatch_size(const GtMMsearchbatch *mmsb);
+
+/* Returns the number of different patterns, only valid after running. */
+GtUword gt_mmsearchbatch_unique(const GtMMsearchbatch *mmsb);
+
+const GtUchar *gt_mmsearchbatch_pattern(GtUword *patternlength,
+                                        const GtMMsearchbatch *mmsb,
+                                        GtUword patternnum);
+
+GtUword gt_mmsearchbatch_count(const GtMMsearchbatch *mmsb,GtUword patternnum);
+
+/* Returns an iterator over the matches of pattern <patternnum>, to be
+   deleted with <gt_mmsearchiterator_delete>. */
+GtMMsearchiterator *gt_mmsearchbatch_iterator(const GtMMsearchbatch *mmsb,
+                                              GtUword patternnum);
+
+/* Removes all patterns and results so that <mmsb> can be reused. */
+void gt_mmsearchbatch_reset(GtMMsearchbatch *mmsb);
+
+void gt_mmsearchbatch_delete(GtMMsearchbatch *mmsb);
+
 int gt_sarrquerysubstringmatch(const GtUchar *dbseq,
                                GtUword dblen,
                                const GtUchar *query,
@@ -16,6 +16,7 @@
 */
 
 #include <limits.h>
+#include "core/divmodmul.h"
 #include "core/unused_api.h"
 #include "core/ma_api.h"
 #include "sarr-def.h"
@@ -48,6 +49,7 @@ Sequentialsuffixarrayreader *gt_newSequentialsuffixarrayreaderfromfile(
   ssar->nextlcptabindex = 1UL;
   ssar->largelcpindex = 0;
   ssar->scanfile = scanfile;
+  ssar->ownsuffixarray = true;
   ssar->suftab = NULL;
   gt_assert(ssar->suffixarray != NULL);
   ssar->encseq = ssar->suffixarray->encseq;
@@ -59,9 +61,82 @@ Sequentialsuffixarrayreader *gt_newSequentialsuffixarrayreaderfromfile(
   return ssar;
 }
 
+Sequentialsuffixarrayreader *gt_newSequentialsuffixarrayreaderpart(
+                                        const Sequentialsuffixarrayreader *ssar,
+                                        GtUword start,
+                                        GtUword end)
+{
+  Sequentialsuffixarrayreader *ssarpart;
+  const Suffixarray *suffixarray = ssar->suffixarray;
+
+  gt_assert(!ssar->scanfile && start <= end && end <= ssar->nonspecials);
+  ssarpart = gt_malloc(sizeof *ssarpart);
+  *ssarpart = *ssar;
+  ssarpart->ownsuffixarray = false;
+  ssarpart->nextsuftabindex = start;
+  ssarpart->nextlcptabindex = start + 1;
+  ssarpart->nonspecials = end - start;
+  /* find the first large lcp value at an index >= start + 1 */
+  ssarpart->largelcpindex = 0;
+  if (suffixarray->numoflargelcpvalues.defined)
+  {
+    GtUword left = 0,
+            right = suffixarray->numoflargelcpvalues.valueunsignedlong;
+
+    while (left < right)
+    {
+      GtUword mid = left + GT_DIV2(right - left);
+
+      if (suffixarray->llvtab[mid].position < start + 1)
+      {
+        left = mid + 1;
+      } else
+      {
+        right = mid;
+      }
+    }
+    ssarpart->largelcpindex = left;
+  }
+  return ssarpart;
+}
+
+unsigned int gt_Sequentialsuffixarrayreader_splitparts(
+                                        GtUword *partstart,
+                                        const Sequentialsuffixarrayreader *ssar,
+                                        unsigned int numofparts,
+                                        GtUword minlcp)
+{
+  unsigned int part, numofsplits = 0;
+  GtUword widthofpart, boundary;
+
+  gt_assert(!ssar->scanfile && numofparts > 0);
+  widthofpart = ssar->nonspecials/numofparts;
+  partstart[0] = 0;
+  for (part = 1; part < numofparts && widthofpart > 0; part++)
+  {
+    boundary = part * widthofpart;
+    if (boundary <= partstart[numofsplits])
+    {
+      continue;
+    }
+    while (boundary < ssar->nonspecials &&
+           lcptable_get(ssar->suffixarray,boundary) >= minlcp)
+    {
+      boundary++;
+    }
+    if (boundary == ssar->nonspecials)
+    {
+      break;
+    }
+    partstart[++numofsplits] = boundary;
+  }
+  partstart[numofsplits+1] = ssar->nonspecials;
+  return numofsplits + 1;
+}
+
 void gt_freeSequentialsuffixarrayreader(Sequentialsuffixarrayreader **ssar)
 {
-  if ((*ssar)->suffixarray != NULL)
+  if ((*ssar)->suffixarray != NULL && (*ssar)->ownsuffixarray)
   {
     gt_freesuffixarray((*ssar)->suffixarray);
     gt_free((*ssar)->suffixarray);
@@ -34,7 +34,8 @@ struct Sequentialsuffixarrayreader
          largelcpindex;   /* for !scanfile */
   const ESASuffixptr *suftab;
   const GtEncseq *encseq;
-  bool scanfile;
+  bool scanfile,
+       ownsuffixarray;
   void *extrainfo;
   GtReadmode readmode;
 };
@@ -222,6 +223,26 @@ Sequentialsuffixarrayreader *gt_newSequentialsuffixarrayreaderfromfile(
                                         GtLogger *logger,
                                         GtError *err);
 
+/* Returns a reader for the suffixes with index <start> to <end>-1 of the
+   mapped suffix array of <ssar>. The suffix array is shared with <ssar>,
+   which must therefore not be freed before the returned reader. */
+Sequentialsuffixarrayreader *gt_newSequentialsuffixarrayreaderpart(
+                                        const Sequentialsuffixarrayreader *ssar,
+                                        GtUword start,
+                                        GtUword end);
+
+/* Splits the suffixes not starting with a special character into at most
+   <numofparts> parts of about the same size, such that no lcp-interval of
+   depth at least <minlcp> crosses the border of two parts. The start of
+   part <i> is stored in <partstart[i]>, <partstart> must have space for
+   <numofparts>+1 values, the last one being the end of the last part.
+   Returns the number of parts. <ssar> must not be read from file. */
+unsigned int gt_Sequentialsuffixarrayreader_splitparts(
+                                        GtUword *partstart,
+                                        const Sequentialsuffixarrayreader *ssar,
+                                        unsigned int numofparts,
+                                        GtUword minlcp);
+
 void gt_freeSequentialsuffixarrayreader(Sequentialsuffixarrayreader **ssar);
 
 const GtEncseq *gt_encseqSequentialsuffixarrayreader(
@@ -48,7 +48,7 @@ static void gt_firstcodes_countocc_new(GtFirstcodesspacelog *fcsl,
   {
     fct->countocc_small = NULL;
   }
-  fct->countocc_exceptions = ul_u32_gt_hashmap_new();
+  fct->countocc_exceptions = ul_u32_gt_inthashmap_new();
   gt_assert(fct->countocc_exceptions != NULL);
   fct->outfilenameleftborder = NULL;
   fct->leftborder_samples = NULL;
@@ -71,8 +71,8 @@ static void gt_firstcodes_countocc_set(GtFirstcodestab *fct,
     } else
     {
       differences[idx] &= fct->differencemask;
-      ul_u32_gt_hashmap_add(fct->countocc_exceptions,idx,
-                            (uint32_t) (value - fct->countmax));
+      ul_u32_gt_inthashmap_add(fct->countocc_exceptions,idx,
+                               (uint32_t) (value - fct->countmax));
       fct->hashmap_addcount++;
     }
   } else
@@ -83,8 +83,8 @@ static void gt_firstcodes_countocc_set(GtFirstcodestab *fct,
     } else
     {
       fct->countocc_small[idx] = 0;
-      ul_u32_gt_hashmap_add(fct->countocc_exceptions,idx,
-                            value - GT_FIRSTCODES_MAXSMALL);
+      ul_u32_gt_inthashmap_add(fct->countocc_exceptions,idx,
+                               value - GT_FIRSTCODES_MAXSMALL);
       fct->hashmap_addcount++;
     }
   }
@@ -107,13 +107,14 @@ static void gt_firstcodes_countocc_increment(GtFirstcodestab *fct,
         differences[idx] |= ((inc + count) << fct->shiftforcounts);
       } else
       {
-        ul_u32_gt_hashmap_add(fct->countocc_exceptions,idx,
-                              (uint32_t) (inc + count - fct->countmax));
+        ul_u32_gt_inthashmap_add(fct->countocc_exceptions,idx,
+                                 (uint32_t) (inc + count - fct->countmax));
         fct->hashmap_addcount++;
       }
     } else
     {
-      uint32_t *valueptr = ul_u32_gt_hashmap_get(fct->countocc_exceptions,idx);
+      uint32_t *valueptr
+        = ul_u32_gt_inthashmap_get(fct->countocc_exceptions,idx);
 
       gt_assert(valueptr != NULL && *valueptr + inc <= UINT32_MAX);
       (*valueptr) += inc;
@@ -128,14 +129,15 @@ static void gt_firstcodes_countocc_increment(GtFirstcodestab *fct,
         fct->countocc_small[idx] += inc;
       } else
       {
-        ul_u32_gt_hashmap_add(fct->countocc_exceptions,idx,
-                              inc + count - GT_FIRSTCODES_MAXSMALL);
+        ul_u32_gt_inthashmap_add(fct->countocc_exceptions,idx,
+                                 inc + count - GT_FIRSTCODES_MAXSMALL);
         fct->countocc_small[idx] = 0;
         fct->hashmap_addcount++;
       }
     } else
     {
-      uint32_t *valueptr = ul_u32_gt_hashmap_get(fct->countocc_exceptions,idx);
+      uint32_t *valueptr
+        = ul_u32_gt_inthashmap_get(fct->countocc_exceptions,idx);
 
       gt_assert(valueptr != NULL && *valueptr + inc <= UINT32_MAX);
       (*valueptr) += inc;
@@ -417,7 +419,8 @@ static uint32_t gt_firstcodes_countocc_get(const GtFirstcodestab *fct,
       return (uint32_t) count;
     } else
     {
-      uint32_t *valueptr = ul_u32_gt_hashmap_get(fct->countocc_exceptions,idx);
+      uint32_t *valueptr
+        = ul_u32_gt_inthashmap_get(fct->countocc_exceptions,idx);
 
       gt_assert(valueptr != NULL);
       return *valueptr + (uint32_t) fct->countmax;
@@ -429,7 +432,8 @@ static uint32_t gt_firstcodes_countocc_get(const GtFirstcodestab *fct,
       return (uint32_t) fct->countocc_small[idx];
     } else
     {
-      uint32_t *valueptr = ul_u32_gt_hashmap_get(fct->countocc_exceptions,idx);
+      uint32_t *valueptr
+        = ul_u32_gt_inthashmap_get(fct->countocc_exceptions,idx);
 
       gt_assert(valueptr != NULL);
       return *valueptr + (uint32_t) GT_FIRSTCODES_MAXSMALL;
@@ -575,7 +579,7 @@ GtUword gt_firstcodes_partialsums(GtFirstcodesspacelog *fcsl,
   {
     spacewithhashmap = gt_ma_get_space_current() + gt_fa_get_space_current();
   }
-  gt_hashtable_delete(fct->countocc_exceptions);
+  ul_u32_gt_inthashmap_delete(fct->countocc_exceptions);
   if (fct->hashmap_addcount > 0 && gt_ma_bookkeeping_enabled())
   {
     GtUword hashmapspace;
@@ -678,7 +682,7 @@ void gt_firstcodes_countocc_delete(GtFirstcodesspacelog *fcsl,
     gt_free(fct->countocc_small);
     fct->countocc_small = NULL;
   }
-  gt_hashtable_delete(fct->countocc_exceptions);
+  ul_u32_gt_inthashmap_delete(fct->countocc_exceptions);
   fct->countocc_exceptions = NULL;
 }
 
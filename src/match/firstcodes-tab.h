@@ -21,13 +21,16 @@
 #include <inttypes.h>
 #include "core/unused_api.h"
 #include "core/str_api.h"
-#include "core/hashmap-generic.h"
+#include "core/inthashmap-generic.h"
 #include "core/logger_api.h"
 #include "core/arraydef.h"
 #include "marksubstring.h"
 #include "firstcodes-spacelog.h"
 #include "firstcodes-cache.h"
 
+DECLARE_INTHASHMAP(GtUword, ul, uint32_t, u32)
+DEFINE_INTHASHMAP(GtUword, ul, uint32_t, u32)
+
 typedef uint8_t GtCountAFCtype;
 #define GT_FIRSTCODES_MAXSMALL UINT8_MAX
 
@@ -41,7 +44,7 @@ typedef struct
   unsigned int sampleshift;
   uint32_t *leftborder;
   GtCountAFCtype *countocc_small;
-  GtHashtable *countocc_exceptions;
+  ul_u32_inthashmap *countocc_exceptions;
   GtUword *leftborder_samples;
   GtStr *outfilenameleftborder;
   GtUword differencemask, /* for extracting the difference */
@@ -52,10 +55,6 @@ typedef struct
 #endif
 } GtFirstcodestab;
 
-DECLARE_HASHMAP(GtUword, ul, uint32_t, u32, static, inline)
-DEFINE_HASHMAP(GtUword, ul, uint32_t, u32, gt_ht_ul_elem_hash,
-               gt_ht_ul_elem_cmp, NULL_DESTRUCTOR, NULL_DESTRUCTOR, static,
-               inline)
 
 #if defined (_LP64) || defined (_WIN64)
 #define GT_CHANGEPOINT_GET(CP)\
@@ -0,0 +1,44 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include "match/kmercodes.h"
+
+#ifdef GT_KMERCODES_BLOCKWISE
+
+bool gt_kmercodes_blockwise(void)
+{
+#ifdef __AVX2__
+  return true;
+#else
+  return __builtin_cpu_supports("avx2") ? true : false;
+#endif
+}
+
+/* the inlined loop of <gt_kmercodes_twobit_block()> is vectorized with the
+   AVX2 instruction set, independent of the flags of the whole build */
+#ifndef __AVX2__
+__attribute__((target("avx2")))
+#endif
+void gt_kmercodes_twobit_block_avx2(GtCodetype *codes,
+                                    GtTwobitencoding current,
+                                    GtTwobitencoding next,
+                                    unsigned int kmersize)
+{
+  gt_kmercodes_twobit_block(codes, current, next, kmersize);
+}
+
+#endif
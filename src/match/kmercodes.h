@@ -17,6 +17,8 @@
 
 #ifndef KMERCODES_H
 #define KMERCODES_H
+#include <stdbool.h>
+#include "core/assert_api.h"
 #include "core/intbits.h"
 #include "core/codetype.h"
 #include "core/divmodmul.h"
@@ -46,6 +48,95 @@ static inline GtCodetype gt_kmercode_at_position(
   }
 }
 
+/* The blockwise extraction of kmer codes only pays off if the compiler can
+   vectorize <gt_kmercodes_twobit_block()>. This requires shifts by a
+   different amount for each vector element, as provided by AVX2. On x86
+   processors, <gt_kmercodes_twobit_block_avx2()> is compiled for AVX2 in any
+   case and <gt_kmercodes_blockwise()> tells at runtime whether the processor
+   supports it. Otherwise the rolling update of a single code is faster. */
+#if defined (__AVX2__) ||\
+    ((defined (__x86_64__) || defined (__i386__)) &&\
+     (defined (__clang__) || __GNUC__ > 4 ||\
+      (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)))
+#define GT_KMERCODES_BLOCKWISE
+#endif
+
+/* The mask selecting all positions of a unit */
+#define GT_KMERCODES_FULLMASK\
+        (~0UL >> (GT_INTWORDSIZE - GT_UNITSIN2BITENC))
+
+/* Store in <codes>[j] the code of the <kmersize>-mer beginning at the j-th
+   character of the unit <current>, for all j in [0,GT_UNITSIN2BITENC-1].
+   <next> is the unit following <current> and delivers the characters of the
+   kmers crossing the unit boundary. The iterations do not depend on each
+   other. The shift of <next> is split into two steps to avoid a shift by the
+   full word size for j=0. */
+static inline void gt_kmercodes_twobit_block(GtCodetype *codes,
+                                             GtTwobitencoding current,
+                                             GtTwobitencoding next,
+                                             unsigned int kmersize)
+{
+  const unsigned int shiftright = GT_MULT2(GT_UNITSIN2BITENC - kmersize);
+  const GtTwobitencoding nexthalf = next >> 1;
+  unsigned int j;
+
+  for (j = 0; j < (unsigned int) GT_UNITSIN2BITENC; j++)
+  {
+    const GtTwobitencoding window
+      = (current << GT_MULT2(j)) |
+        (nexthalf >> (GT_INTWORDSIZE - 1 - GT_MULT2(j)));
+    codes[j] = (GtCodetype) (window >> shiftright);
+  }
+}
+
+#ifdef GT_KMERCODES_BLOCKWISE
+/* Return true if the processor supports the AVX2 instructions used by
+   <gt_kmercodes_twobit_block_avx2()>. */
+bool gt_kmercodes_blockwise(void);
+
+/* Same as <gt_kmercodes_twobit_block()>, but vectorized with AVX2. Must only
+   be called if <gt_kmercodes_blockwise()> returns true. */
+void gt_kmercodes_twobit_block_avx2(GtCodetype *codes,
+                                    GtTwobitencoding current,
+                                    GtTwobitencoding next,
+                                    unsigned int kmersize);
+#endif
+
+/* Return a mask in which bit j is set if and only if <blockstart>+j lies in
+   the range [<firstpos>,<lastpos>], where <blockstart> is the first position
+   of a unit. The range must not contain the start position of a kmer with a
+   special character. */
+static inline GtUword gt_kmercodes_block_mask(GtUword blockstart,
+                                              GtUword firstpos,
+                                              GtUword lastpos)
+{
+  const unsigned int lo = firstpos > blockstart
+                            ? (unsigned int) (firstpos - blockstart) : 0,
+                     hi = lastpos - blockstart < (GtUword) GT_UNITSIN2BITENC
+                            ? (unsigned int) (lastpos - blockstart)
+                            : (unsigned int) GT_UNITSIN2BITENC - 1;
+
+  gt_assert(firstpos <= lastpos && lastpos >= blockstart);
+  return (~0UL >> (GT_INTWORDSIZE - 1 - hi)) & (~0UL << lo);
+}
+
+/* Return the index of the lowest bit set in <mask>, which must not be 0. */
+static inline unsigned int gt_kmercodes_mask_first(GtUword mask)
+{
+#ifdef __GNUC__
+  return (unsigned int) __builtin_ctzl(mask);
+#else
+  unsigned int idx = 0;
+
+  while ((mask & 1UL) == 0)
+  {
+    mask >>= 1;
+    idx++;
+  }
+  return idx;
+#endif
+}
+
 static inline GtCodetype gt_kmercode_complement(GtCodetype kmer,
                                                 GtCodetype maskright)
 {
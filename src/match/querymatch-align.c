@@ -612,6 +612,17 @@ void gt_querymatchoutoptions_cigar_show(const GtQuerymatchoutoptions
                         distinguish_mismatch_match,fp);
 }
 
+GtEoplistReader *gt_querymatchoutoptions_cigar_reader(
+                                     const GtQuerymatchoutoptions
+                                       *querymatchoutoptions)
+{
+  gt_assert(querymatchoutoptions != NULL &&
+            querymatchoutoptions->eoplist != NULL);
+  gt_eoplist_reader_reset(querymatchoutoptions->eoplist_reader,
+                          querymatchoutoptions->eoplist,true);
+  return querymatchoutoptions->eoplist_reader;
+}
+
 void gt_querymatchoutoptions_trace_show(const GtQuerymatchoutoptions
                                               *querymatchoutoptions,
                                         bool dtrace,
@@ -81,6 +81,12 @@ void gt_querymatchoutoptions_cigar_show(const GtQuerymatchoutoptions
                                         bool distinguish_mismatch_match,
                                         FILE *fp);
 
+/* Returns the reader of the current alignment, reset to its first cigar
+   operation. */
+GtEoplistReader *gt_querymatchoutoptions_cigar_reader(
+                                     const GtQuerymatchoutoptions
+                                       *querymatchoutoptions);
+
 void gt_querymatchoutoptions_trace_show(const GtQuerymatchoutoptions
                                               *querymatchoutoptions,
                                         bool dtrace,
@@ -207,7 +207,19 @@ static int gt_querymatch_display_flag_set(char *copyspace,
                                 "gfa2","alignment",
                                 "gfa2","custom",
                                 "gfa2","failed_seed",
-                                "gfa2","seed_in_algn"};
+                                "gfa2","seed_in_algn",
+                                "paf","blast",
+                                "paf","gfa2",
+                                "paf","custom",
+                                "paf","alignment",
+                                "paf","sam",
+                                "sam","blast",
+                                "sam","gfa2",
+                                "sam","custom",
+                                "sam","alignment",
+                                "sam","trace",
+                                "sam","dtrace",
+                                "sam","failed_seed"};
   size_t ex_idx, numexcl = sizeof exclude_list/sizeof exclude_list[0];
   const GtSEdisplayStruct *dstruct;
   const char *ptr;
@@ -383,7 +395,19 @@ GtSeedExtendDisplayFlag *gt_querymatch_display_flag_new(
                                            sizeof blast_flags[0]);
     } else
     {
-      if (gt_querymatch_display_args_contain(display_args,"gfa2"))
+      if (gt_querymatch_display_args_contain(display_args,"paf") ||
+          gt_querymatch_display_args_contain(display_args,"sam"))
+      {
+        /* the columns are fixed by the format, the flags only make sure
+           that the sequence descriptions and the alignment are available */
+        gt_querymatch_display_flag_add(display_flag,Gt_Queryid_display);
+        gt_querymatch_display_flag_add(display_flag,Gt_Subjectid_display);
+        if (gt_querymatch_display_args_contain(display_args,"sam") &&
+            !gt_querymatch_display_args_contain(display_args,"cigarX"))
+        {
+          gt_querymatch_display_flag_add(display_flag,Gt_Cigar_display);
+        }
+      } else if (gt_querymatch_display_args_contain(display_args,"gfa2"))
       {
         GtSeedExtendDisplay_enum gfa2_flags[] =
         {
@@ -571,6 +595,11 @@ void gt_querymatch_Fields_output(FILE *stream,
   GtUword numcolumns, idx;
 
   gt_assert(display_flag != NULL);
+  if (gt_querymatch_paf_display(display_flag) ||
+      gt_querymatch_sam_display(display_flag))
+  {
+    return; /* formats with fixed columns */
+  }
   column_order = gt_querymatch_display_order(&numcolumns,display_flag);
   gt_assert(numcolumns > 0);
   fprintf(stream,"# Fields: ");
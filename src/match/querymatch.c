@@ -17,6 +17,7 @@
 
 #include <ctype.h>
 #include <float.h>
+#include <string.h>
 #include "core/ma_api.h"
 #include "core/types_api.h"
 #include "core/readmode.h"
@@ -408,6 +409,279 @@ static void gt_querymatch_exact_match_trace_show(FILE *fp,
   }
 }
 
+/* PAF and SAM records are formatted into a line buffer on the stack without
+   parsing format strings and are written by a single call of fwrite, unless
+   they are longer than the buffer. */
+
+#define GT_QUERYMATCH_LINEBUFFER_SIZE 1024
+
+typedef struct
+{
+  char space[GT_QUERYMATCH_LINEBUFFER_SIZE];
+  size_t nextfree;
+  FILE *fp;
+} GtQuerymatchLinebuffer;
+
+static void gt_querymatch_linebuffer_flush(GtQuerymatchLinebuffer *linebuffer)
+{
+  if (linebuffer->nextfree > 0)
+  {
+    fwrite(linebuffer->space,sizeof *linebuffer->space,linebuffer->nextfree,
+           linebuffer->fp);
+    linebuffer->nextfree = 0;
+  }
+}
+
+static void gt_querymatch_linebuffer_char(GtQuerymatchLinebuffer *linebuffer,
+                                          char cc)
+{
+  if (linebuffer->nextfree == (size_t) GT_QUERYMATCH_LINEBUFFER_SIZE)
+  {
+    gt_querymatch_linebuffer_flush(linebuffer);
+  }
+  linebuffer->space[linebuffer->nextfree++] = cc;
+}
+
+static void gt_querymatch_linebuffer_string(GtQuerymatchLinebuffer *linebuffer,
+                                            const char *string,size_t len)
+{
+  if (linebuffer->nextfree + len > (size_t) GT_QUERYMATCH_LINEBUFFER_SIZE)
+  {
+    gt_querymatch_linebuffer_flush(linebuffer);
+    if (len > (size_t) GT_QUERYMATCH_LINEBUFFER_SIZE)
+    {
+      fwrite(string,sizeof *string,len,linebuffer->fp);
+      return;
+    }
+  }
+  memcpy(linebuffer->space + linebuffer->nextfree,string,len);
+  linebuffer->nextfree += len;
+}
+
+static void gt_querymatch_linebuffer_uword(GtQuerymatchLinebuffer *linebuffer,
+                                           GtUword value)
+{
+  char digits[3 * sizeof value], *dptr = digits + sizeof digits;
+
+  do
+  {
+    *--dptr = (char) ('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  gt_querymatch_linebuffer_string(linebuffer,dptr,
+                                  (size_t) (digits + sizeof digits - dptr));
+}
+
+/* appends the sequence id, i.e. the first word of the description or the
+   sequence number if there is no description */
+static void gt_querymatch_linebuffer_seqid(GtQuerymatchLinebuffer *linebuffer,
+                                           const char *description,
+                                           GtUword seqnum)
+{
+  if (description != NULL && *description != '\0' && !isspace(*description))
+  {
+    gt_querymatch_linebuffer_string(linebuffer,description,
+                       (size_t) gt_non_white_space_prefix_length(description));
+  } else
+  {
+    gt_querymatch_linebuffer_uword(linebuffer,seqnum);
+  }
+}
+
+static void gt_querymatch_linebuffer_cigar(GtQuerymatchLinebuffer *linebuffer,
+                                           const GtQuerymatch *querymatch,
+                                           bool distinguish_mismatch_match)
+{
+  if (querymatch->distance > 0)
+  {
+    GtCigarOp co;
+    GtEoplistReader *eoplist_reader
+      = gt_querymatchoutoptions_cigar_reader(
+                                  querymatch->ref_querymatchoutoptions);
+
+    while (gt_eoplist_reader_next_cigar(&co,eoplist_reader,
+                                        distinguish_mismatch_match))
+    {
+      gt_querymatch_linebuffer_uword(linebuffer,co.iteration);
+      gt_querymatch_linebuffer_char(linebuffer,
+                                    gt_eoplist_pretty_print(co.eoptype,
+                                                 distinguish_mismatch_match));
+    }
+  } else
+  {
+    gt_querymatch_linebuffer_uword(linebuffer,querymatch->dblen);
+    gt_querymatch_linebuffer_char(linebuffer,
+                                  distinguish_mismatch_match ? '=' : 'M');
+  }
+}
+
+static void gt_querymatch_linebuffer_tags(GtQuerymatchLinebuffer *linebuffer,
+                                          const GtQuerymatch *querymatch)
+{
+  gt_querymatch_linebuffer_string(linebuffer,"\tNM:i:",6);
+  gt_querymatch_linebuffer_uword(linebuffer,querymatch->distance);
+  if (querymatch->score > 0) /* exact matches are not scored */
+  {
+    gt_querymatch_linebuffer_string(linebuffer,"\tAS:i:",6);
+    gt_querymatch_linebuffer_uword(linebuffer,(GtUword) querymatch->score);
+  }
+}
+
+static void gt_querymatch_paf_output(
+                           const GtSeedExtendDisplayFlag *out_display_flag,
+                           const GtQuerymatch *querymatch)
+{
+  GtQuerymatchLinebuffer linebuffer;
+
+  linebuffer.nextfree = 0;
+  linebuffer.fp = querymatch->fp;
+  gt_querymatch_linebuffer_seqid(&linebuffer,querymatch->query_desc,
+                                 querymatch->queryseqnum);
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_uword(&linebuffer,querymatch->query_seqlen);
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_uword(&linebuffer,querymatch->querystart_fwdstrand);
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_uword(&linebuffer,querymatch->querystart_fwdstrand +
+                                             querymatch->querylen);
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_char(&linebuffer,
+                      GT_ISDIRREVERSE(querymatch->query_readmode) ? '-' : '+');
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_seqid(&linebuffer,querymatch->db_desc,
+                                 querymatch->dbseqnum);
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_uword(&linebuffer,querymatch->db_seqlen);
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_uword(&linebuffer,querymatch->dbstart_relative);
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_uword(&linebuffer,querymatch->dbstart_relative +
+                                             querymatch->dblen);
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_uword(&linebuffer,
+                                 gt_querymatch_matches(querymatch));
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_uword(&linebuffer,
+                                 gt_querymatch_alignment_length(querymatch));
+  gt_querymatch_linebuffer_string(&linebuffer,"\t255",4);
+  gt_querymatch_linebuffer_tags(&linebuffer,querymatch);
+  if (gt_querymatch_cigar_display(out_display_flag) ||
+      gt_querymatch_cigarX_display(out_display_flag))
+  {
+    gt_querymatch_linebuffer_string(&linebuffer,"\tcg:Z:",6);
+    gt_querymatch_linebuffer_cigar(&linebuffer,querymatch,
+                                   gt_querymatch_cigarX_display(
+                                                      out_display_flag));
+  }
+  gt_querymatch_linebuffer_char(&linebuffer,'\n');
+  gt_querymatch_linebuffer_flush(&linebuffer);
+}
+
+static void gt_querymatch_hardclip(GtQuerymatchLinebuffer *linebuffer,
+                                   GtUword cliplength)
+{
+  if (cliplength > 0)
+  {
+    gt_querymatch_linebuffer_uword(linebuffer,cliplength);
+    gt_querymatch_linebuffer_char(linebuffer,'H');
+  }
+}
+
+/* The subject is the reference, the query is the read. If the query
+   matches on the reverse strand, the cigar string describes the alignment
+   of the reverse complemented query, hence the clipped lengths are swapped.
+   As sequences are not output, unaligned query ends are hard clipped. */
+static void gt_querymatch_sam_output(
+                           const GtSeedExtendDisplayFlag *out_display_flag,
+                           const GtQuerymatch *querymatch)
+{
+  GtQuerymatchLinebuffer linebuffer;
+  GtUword leftclip, rightclip;
+  const bool reverse = GT_ISDIRREVERSE(querymatch->query_readmode)
+                         ? true : false;
+
+  gt_assert(querymatch->query_seqlen >= querymatch->querystart_fwdstrand +
+                                        querymatch->querylen);
+  leftclip = querymatch->querystart_fwdstrand;
+  rightclip = querymatch->query_seqlen - querymatch->querystart_fwdstrand -
+              querymatch->querylen;
+  if (reverse)
+  {
+    GtUword tmp = leftclip;
+
+    leftclip = rightclip;
+    rightclip = tmp;
+  }
+  linebuffer.nextfree = 0;
+  linebuffer.fp = querymatch->fp;
+  gt_querymatch_linebuffer_seqid(&linebuffer,querymatch->query_desc,
+                                 querymatch->queryseqnum);
+  gt_querymatch_linebuffer_string(&linebuffer,reverse ? "\t16\t" : "\t0\t",
+                                  reverse ? 4 : 3);
+  gt_querymatch_linebuffer_seqid(&linebuffer,querymatch->db_desc,
+                                 querymatch->dbseqnum);
+  gt_querymatch_linebuffer_char(&linebuffer,'\t');
+  gt_querymatch_linebuffer_uword(&linebuffer,querymatch->dbstart_relative + 1);
+  gt_querymatch_linebuffer_string(&linebuffer,"\t255\t",5);
+  gt_querymatch_hardclip(&linebuffer,leftclip);
+  gt_querymatch_linebuffer_cigar(&linebuffer,querymatch,
+                                 gt_querymatch_cigarX_display(
+                                                    out_display_flag));
+  gt_querymatch_hardclip(&linebuffer,rightclip);
+  gt_querymatch_linebuffer_string(&linebuffer,"\t*\t0\t0\t*\t*",10);
+  gt_querymatch_linebuffer_tags(&linebuffer,querymatch);
+  gt_querymatch_linebuffer_char(&linebuffer,'\n');
+  gt_querymatch_linebuffer_flush(&linebuffer);
+}
+
+static void gt_querymatch_sam_header_seqid(FILE *fp,
+                                           const GtEncseq *encseq,
+                                           GtUword seqnum)
+{
+  if (encseq != NULL && gt_encseq_has_description_support(encseq))
+  {
+    GtUword desclen;
+    const char *desc = gt_encseq_description(encseq,&desclen,seqnum);
+    GtUword idx;
+
+    for (idx = 0; idx < desclen && !isspace(desc[idx]); idx++)
+    {
+      /* Nothing */ ;
+    }
+    if (idx > 0)
+    {
+      fwrite(desc,sizeof *desc,(size_t) idx,fp);
+      return;
+    }
+  }
+  fprintf(fp,GT_WU,seqnum);
+}
+
+void gt_querymatch_sam_header_output(FILE *fp,const GtEncseq *encseq,
+                                     int argc,const char **argv)
+{
+  int arg;
+
+  fprintf(fp,"@HD\tVN:1.6\tSO:unsorted\n");
+  if (encseq != NULL)
+  {
+    GtUword seqnum, numofsequences = gt_encseq_num_of_sequences(encseq);
+
+    for (seqnum = 0; seqnum < numofsequences; seqnum++)
+    {
+      fprintf(fp,"@SQ\tSN:");
+      gt_querymatch_sam_header_seqid(fp,encseq,seqnum);
+      fprintf(fp,"\tLN:" GT_WU "\n",gt_encseq_seqlength(encseq,seqnum));
+    }
+  }
+  fprintf(fp,"@PG\tID:gt\tPN:gt\tCL:");
+  for (arg = 0; arg < argc; arg++)
+  {
+    fprintf(fp,"%s%s",arg > 0 ? " " : "",argv[arg]);
+  }
+  fputc('\n',fp);
+}
+
 void gt_querymatch_gfa2_edge(const GtQuerymatch *querymatch,GtUword edgenum)
 {
   fprintf(querymatch->fp,"E\t" GT_WU "\t",edgenum);
@@ -424,6 +698,16 @@ void gt_querymatch_prettyprint(double evalue,double bit_score,
 
   gt_assert(querymatch != NULL && querymatch->fp != NULL &&
             out_display_flag != NULL);
+  if (gt_querymatch_paf_display(out_display_flag))
+  {
+    gt_querymatch_paf_output(out_display_flag,querymatch);
+    return;
+  }
+  if (gt_querymatch_sam_display(out_display_flag))
+  {
+    gt_querymatch_sam_output(out_display_flag,querymatch);
+    return;
+  }
   gfa2_display = gt_querymatch_gfa2_display(out_display_flag);
   column_order = gt_querymatch_display_order(&numcolumns,out_display_flag);
   gt_assert(numcolumns > 0);
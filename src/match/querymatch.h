@@ -119,6 +119,12 @@ GtUword gt_querymatch_distance(const GtQuerymatch *querymatch);
 
 void gt_querymatch_gfa2_edge(const GtQuerymatch *querymatch,GtUword edgenum);
 
+/* Outputs the header of a SAM file to <fp>. If <encseq> is not <NULL>, a
+   reference sequence line is output for each of its sequences. The
+   <argc> arguments in <argv> make up the command line. */
+void gt_querymatch_sam_header_output(FILE *fp,const GtEncseq *encseq,
+                                     int argc,const char **argv);
+
 void gt_querymatch_prettyprint(double evalue,double bit_score,
                                const GtSeedExtendDisplayFlag *out_display_flag,
                                const GtQuerymatch *querymatch);
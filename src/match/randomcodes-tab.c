@@ -40,7 +40,7 @@ void gt_randomcodes_countocc_new(GtFirstcodesspacelog *fcsl,
   GT_FCI_ADDWORKSPACE(fcsl,"countocc_small",
                       sizeof (*rct->countocc_small) *
                       (numofsequences+1));
-  rct->countocc_exceptions = ul_u32_gt_hashmap_new();
+  rct->countocc_exceptions = ul_u32_gt_inthashmap_new();
   gt_assert(rct->countocc_exceptions != NULL);
   rct->outfilenameleftborder = NULL;
   rct->leftborder_samples = NULL;
@@ -191,7 +191,7 @@ static uint32_t gt_randomcodes_countocc_get(const GtRandomcodestab *rct,
     return (uint32_t) rct->countocc_small[idx];
   } else
   {
-    uint32_t *valueptr = ul_u32_gt_hashmap_get(rct->countocc_exceptions,idx);
+    uint32_t *valueptr = ul_u32_gt_inthashmap_get(rct->countocc_exceptions,idx);
 
     gt_assert(valueptr != NULL);
     return *valueptr + (uint32_t) GT_RANDOMCODES_MAXSMALL;
@@ -347,7 +347,7 @@ GtUword gt_randomcodes_partialsums(GtFirstcodesspacelog *fcsl,
   {
     spacewithhashmap = gt_ma_get_space_current() + gt_fa_get_space_current();
   }
-  gt_hashtable_delete(rct->countocc_exceptions);
+  ul_u32_gt_inthashmap_delete(rct->countocc_exceptions);
   if (rct->hashmap_addcount > 0 && gt_ma_bookkeeping_enabled())
   {
     GtUword hashmapspace;
@@ -450,7 +450,7 @@ void gt_randomcodes_countocc_delete(GtFirstcodesspacelog *fcsl,
     gt_free(rct->countocc_small);
     rct->countocc_small = NULL;
   }
-  gt_hashtable_delete(rct->countocc_exceptions);
+  ul_u32_gt_inthashmap_delete(rct->countocc_exceptions);
   rct->countocc_exceptions = NULL;
 }
 
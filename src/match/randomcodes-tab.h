@@ -21,7 +21,7 @@
 #include <inttypes.h>
 #include "core/unused_api.h"
 #include "core/str_api.h"
-#include "core/hashmap-generic.h"
+#include "core/inthashmap-generic.h"
 #include "core/logger_api.h"
 #include "core/arraydef.h"
 #include "firstcodes-tab.h"
@@ -42,7 +42,7 @@ typedef struct
   unsigned int sampleshift;
   uint32_t *leftborder;
   uint8_t *countocc_small;
-  GtHashtable *countocc_exceptions;
+  ul_u32_inthashmap *countocc_exceptions;
   GtUword *leftborder_samples;
   GtStr *outfilenameleftborder;
   GtUword lastincremented_idx;
@@ -69,7 +69,7 @@ static inline void gt_randomcodes_countocc_increment(GtRandomcodestab *rct,
       gt_assert (rct->countocc_small[idx] == GT_RANDOMCODES_MAXSMALL);
       rct->countocc_small[idx] = GT_RANDOMCODES_COUNTOCC_OVERFLOW;
       rct->lastincremented_valueptr
-        = ul_u32_gt_hashmap_add_and_return_storage(rct->countocc_exceptions,
+        = ul_u32_gt_inthashmap_add_and_return_storage(rct->countocc_exceptions,
             idx, (uint32_t) 1);
       rct->lastincremented_idx = idx;
       rct->hashmap_addcount++;
@@ -86,7 +86,7 @@ static inline void gt_randomcodes_countocc_increment(GtRandomcodestab *rct,
     } else
     {
       uint32_t *valueptr
-        = ul_u32_gt_hashmap_get(rct->countocc_exceptions,idx);
+        = ul_u32_gt_inthashmap_get(rct->countocc_exceptions,idx);
 
       rct->hashmap_getcount++;
       gt_assert(valueptr != NULL && *valueptr < UINT32_MAX);
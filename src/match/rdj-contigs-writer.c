@@ -97,6 +97,22 @@ void gt_contigs_writer_enable_astat_calculation(GtContigsWriter *contigs_writer,
   contigs_writer->depthinfo_fp = depthinfo_fp;
 }
 
+void gt_contigs_writer_set_contignum(GtContigsWriter *contigs_writer,
+    GtUword contignum)
+{
+  gt_assert(contigs_writer != NULL);
+  contigs_writer->contignum = contignum;
+}
+
+void gt_contigs_writer_merge(GtContigsWriter *contigs_writer,
+    const GtContigsWriter *other)
+{
+  gt_assert(contigs_writer != NULL && other != NULL);
+  gt_assembly_stats_calculator_merge(contigs_writer->asc, other->asc);
+  if (other->contignum > contigs_writer->contignum)
+    contigs_writer->contignum = other->contignum;
+}
+
 void gt_contigs_writer_delete(GtContigsWriter *contigs_writer)
 {
   if (contigs_writer == NULL)
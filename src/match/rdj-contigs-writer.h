@@ -38,6 +38,16 @@ void             gt_contigs_writer_enable_astat_calculation(
                                              unsigned char *rcn,
                                              FILE *depthinfo_fp);
 
+/* The next contig written by <contigs_writer> gets number <contignum>. */
+void             gt_contigs_writer_set_contignum(
+                                             GtContigsWriter *contigs_writer,
+                                             GtUword contignum);
+
+/* Adds the statistics of the contigs written by <other> to those of
+   <contigs_writer>, which continues with the contig numbers of <other>. */
+void             gt_contigs_writer_merge(GtContigsWriter *contigs_writer,
+                                         const GtContigsWriter *other);
+
 void             gt_contigs_writer_start(GtContigsWriter *contigs_writer,
                                          GtUword seqnum);
 
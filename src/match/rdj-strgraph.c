@@ -21,16 +21,19 @@
 #include "core/arraydef.h"
 #include "core/disc_distri_api.h"
 #include "core/ensure.h"
+#include "core/fa.h"
 #include "core/fasta.h"
 #include "core/fileutils.h"
 #include "core/format64.h"
 #include "core/hashmap-generic.h"
+#include "core/intbits.h"
 #include "core/log.h"
 #include "core/ma.h"
 #include "core/progressbar.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/spacecalc.h"
+#include "core/thread_api.h"
 #include "extended/assembly_stats_calculator.h"
 #include "match/asqg_writer.h"
 #include "match/gfa_writer.h"
@@ -863,7 +866,45 @@ static void gt_strgraph_check_outdegs(GtStrgraph *strgraph)
 }
 #endif
 
-static GtUword gt_strgraph_reduce_marked_edges(GtStrgraph *strgraph)
+/* --- Parallel Reduction --- */
+
+/* The transitive, dead path and p-bubble reductions only mark edges and
+   remove the marked edges afterwards, so the result does not depend on the
+   order in which the vertices are processed. The vertices are therefore
+   split into parts which are processed by different threads. Edges are
+   marked in a bitmap, which is shared by the threads, as a dead path or a
+   p-bubble starting from a vertex of one part may run through vertices of
+   other parts. */
+
+#ifdef GT_THREADS_ENABLED
+#define GT_STRGRAPH_EDGEMARKS_SET(TAB, NUM)\
+  (void) __sync_fetch_and_or((TAB) + GT_DIVWORDSIZE(NUM),\
+                             GT_ITHBIT(GT_MODWORDSIZE(NUM)))
+#else
+#define GT_STRGRAPH_EDGEMARKS_SET(TAB, NUM)\
+  GT_SETIBIT(TAB, NUM)
+#endif
+
+#define GT_STRGRAPH_EDGE_SET_MARK_IN(STRGRAPH, EDGEMARKS, V, EDGENUM)\
+  GT_STRGRAPH_EDGEMARKS_SET(EDGEMARKS,\
+      GT_STRGRAPH_V_NTH_EDGE_OFFSET(STRGRAPH, V, EDGENUM))
+
+#define GT_STRGRAPH_EDGE_HAS_MARK_IN(STRGRAPH, EDGEMARKS, V, EDGENUM)\
+  (GT_ISIBITSET(EDGEMARKS,\
+      GT_STRGRAPH_V_NTH_EDGE_OFFSET(STRGRAPH, V, EDGENUM)) ? true : false)
+
+typedef struct {
+  GtStrgraph        *strgraph;
+  GtStrgraphVnum    firstvertex, endvertex;
+  GtBitsequence     *edgemarks;
+  GtUint64          *progress;
+  unsigned int      progressstep;
+  GtUword           maxdepth, maxwidth, maxdiff, maxoutdeg, count;
+  GtThread          *thread;
+} GtStrgraphReductionPart;
+
+static GtUword gt_strgraph_reduce_edgemarks(GtStrgraph *strgraph,
+    const GtBitsequence *edgemarks)
 {
   GtStrgraphVnum i;
   GtUword counter = 0;
@@ -877,8 +918,10 @@ static GtUword gt_strgraph_reduce_marked_edges(GtStrgraph *strgraph)
     {
       if (GT_STRGRAPH_EDGE_IS_REDUCED(strgraph, i, j))
         continue;
-      if (GT_STRGRAPH_EDGE_HAS_MARK(strgraph, i, j))
+      if (GT_STRGRAPH_EDGE_HAS_MARK_IN(strgraph, edgemarks, i, j) ||
+          GT_STRGRAPH_EDGE_HAS_MARK(strgraph, i, j))
       {
+        GT_STRGRAPH_EDGE_SET_MARK(strgraph, i, j);
         GT_STRGRAPH_EDGE_REDUCE(strgraph, i, j);
         GT_STRGRAPH_V_DEC_OUTDEG(strgraph, i);
         counter++;
@@ -888,6 +931,66 @@ static GtUword gt_strgraph_reduce_marked_edges(GtStrgraph *strgraph)
   return counter;
 }
 
+/* runs <reducepart> on <gt_jobs> parts of the vertices, each initialized
+   with the parameters of <template>, and reduces the marked edges; returns
+   the number of reduced edges and stores the sum of the counts of the parts
+   in <count> */
+static GtUword gt_strgraph_reduce_in_parts(GtStrgraph *strgraph,
+    GtThreadFunc reducepart, const GtStrgraphReductionPart *template,
+    GtUword *count, GtUint64 *progress)
+{
+  GtStrgraphReductionPart *parts;
+  GtBitsequence *edgemarks;
+  GtStrgraphVnum nofvertices, width;
+  GtUword counter;
+  unsigned int numofparts = gt_jobs, p;
+
+  nofvertices = GT_STRGRAPH_NOFVERTICES(strgraph);
+  if (numofparts == 0 || (GtStrgraphVnum)numofparts > nofvertices)
+    numofparts = nofvertices > 0 ? (unsigned int)nofvertices : 1U;
+  width = nofvertices / numofparts;
+  GT_INITBITTAB(edgemarks, GT_STRGRAPH_NOFEDGES(strgraph));
+  parts = gt_malloc(sizeof (*parts) * numofparts);
+  for (p = 0; p < numofparts; p++)
+  {
+    parts[p] = *template;
+    parts[p].strgraph = strgraph;
+    parts[p].firstvertex = p * width;
+    parts[p].endvertex = (p == numofparts - 1) ? nofvertices : (p + 1) * width;
+    parts[p].edgemarks = edgemarks;
+    /* the first part runs in the main thread and estimates the progress */
+    parts[p].progress = (p == 0) ? progress : NULL;
+    parts[p].progressstep = numofparts;
+    parts[p].count = 0;
+    parts[p].thread = NULL;
+  }
+#ifdef GT_THREADS_ENABLED
+  for (p = 1U; p < numofparts; p++)
+    parts[p].thread = gt_thread_new(reducepart, parts + p, NULL);
+  (void) reducepart(parts);
+  for (p = 1U; p < numofparts; p++)
+  {
+    if (parts[p].thread != NULL)
+    {
+      gt_thread_join(parts[p].thread);
+      gt_thread_delete(parts[p].thread);
+    }
+    else
+      (void) reducepart(parts + p);
+  }
+#else
+  for (p = 0; p < numofparts; p++)
+    (void) reducepart(parts + p);
+#endif
+  *count = 0;
+  for (p = 0; p < numofparts; p++)
+    *count += parts[p].count;
+  counter = gt_strgraph_reduce_edgemarks(strgraph, edgemarks);
+  gt_free(parts);
+  gt_free(edgemarks);
+  return counter;
+}
+
 /* return value: number of self edges */
 GtUword gt_strgraph_redself(GtStrgraph *strgraph, bool show_progressbar)
 {
@@ -983,32 +1086,24 @@ GtUword gt_strgraph_redwithrc(GtStrgraph *strgraph, bool show_progressbar)
   return (counter >> 1);
 }
 
-/* return value: number of transitive edges */
-GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
+static void *gt_strgraph_redtrans_part(void *data)
 {
+  GtStrgraphReductionPart *part = data;
+  GtStrgraph *strgraph = part->strgraph;
   GtStrgraphLength jlen, klen, longest;
   GtStrgraphVEdgenum j, k, l;
   GtStrgraphVnum i, jdest, kdest;
-  GtUword counter;
-  GtUint64 progress = 0;
-
-  gt_assert(strgraph != NULL);
-  gt_assert(strgraph->state == GT_STRGRAPH_SORTED_BY_L);
+  GtBitsequence *inplay;
 
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
-    GT_STRGRAPH_V_SET_MARK(strgraph, i, GT_STRGRAPH_V_VACANT);
-
-  if (show_progressbar)
-    gt_progressbar_start(&progress,
-        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  /* the vertices adjacent to i are marked in a bitmap local to the part */
+  GT_INITBITTAB(inplay, GT_STRGRAPH_NOFVERTICES(strgraph));
+  for (i = part->firstvertex; i < part->endvertex; i++)
   {
     if (GT_STRGRAPH_V_OUTDEG(strgraph, i) > 0)
     {
       for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
       {
-        GT_STRGRAPH_V_SET_MARK(strgraph, GT_STRGRAPH_EDGE_DEST(strgraph, i, j),
-            GT_STRGRAPH_V_INPLAY);
+        GT_SETIBIT(inplay, GT_STRGRAPH_EDGE_DEST(strgraph, i, j));
       }
       GT_STRGRAPH_FIND_LONGEST_EDGE(strgraph, i, longest);
       for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
@@ -1020,14 +1115,14 @@ GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
         {
           kdest = GT_STRGRAPH_EDGE_DEST(strgraph, jdest, k);
           klen = GT_STRGRAPH_EDGE_LEN(strgraph, jdest, k);
-          if (GT_STRGRAPH_V_MARK(strgraph, kdest) == GT_STRGRAPH_V_INPLAY)
+          if (GT_ISIBITSET(inplay, kdest))
           {
             for (l = 0; l < GT_STRGRAPH_V_NOFEDGES(strgraph, i); l++)
             {
               if (GT_STRGRAPH_EDGE_DEST(strgraph, i, l) == kdest &&
                   GT_STRGRAPH_EDGE_LEN(strgraph, i, l) == jlen + klen)
               {
-                GT_STRGRAPH_EDGE_SET_MARK(strgraph, i, l);
+                GT_STRGRAPH_EDGE_SET_MARK_IN(strgraph, part->edgemarks, i, l);
               }
             }
           }
@@ -1035,17 +1130,40 @@ GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
       }
       for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
       {
-        GT_STRGRAPH_V_SET_MARK(strgraph, GT_STRGRAPH_EDGE_DEST(strgraph, i, j),
-            GT_STRGRAPH_V_VACANT);
+        GT_UNSETIBIT(inplay, GT_STRGRAPH_EDGE_DEST(strgraph, i, j));
       }
     }
-    if (show_progressbar)
-      progress++;
+    if (part->progress != NULL)
+      (*part->progress) += part->progressstep;
   }
+  gt_free(inplay);
+  return NULL;
+}
+
+/* return value: number of transitive edges */
+GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
+{
+  GtStrgraphReductionPart template;
+  GtStrgraphVnum i;
+  GtUword counter, count;
+  GtUint64 progress = 0;
+
+  gt_assert(strgraph != NULL);
+  gt_assert(strgraph->state == GT_STRGRAPH_SORTED_BY_L);
+
+  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+    GT_STRGRAPH_V_SET_MARK(strgraph, i, GT_STRGRAPH_V_VACANT);
+
+  if (show_progressbar)
+    gt_progressbar_start(&progress,
+        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
+  template.maxdepth = template.maxwidth = template.maxdiff =
+    template.maxoutdeg = 0;
+  counter = gt_strgraph_reduce_in_parts(strgraph, gt_strgraph_redtrans_part,
+      &template, &count, &progress);
   if (show_progressbar)
     gt_progressbar_stop();
 
-  counter = gt_strgraph_reduce_marked_edges(strgraph);
   gt_log_log("transitive counter: "GT_WU"", counter);
   /* trans spm should be found twice, check number is even */
   /*gt_assert((counter & 1) == 0);*/
@@ -1128,26 +1246,18 @@ typedef struct {
   GtStrgraphVEdgenum edgenum;
 } GtStrgraphEdgeID;
 
-GtUword gt_strgraph_reddepaths(GtStrgraph *strgraph,
-    GtUword maxdepth, bool show_progressbar)
+static void *gt_strgraph_reddepaths_part(void *data)
 {
+  GtStrgraphReductionPart *part = data;
+  GtStrgraph *strgraph = part->strgraph;
   GtStrgraphVnum i, from, to;
   GtStrgraphVEdgenum j, from_to;
-  GtUword depth, d;
-  GtUword counter = 0, nofdepaths = 0;
-  GtUint64 progress = 0;
+  GtUword depth, d, maxdepth = part->maxdepth;
   bool i_branching;
   GtStrgraphEdgeID *edges;
 
-  gt_assert(strgraph != NULL);
-
   edges = gt_malloc(sizeof (GtStrgraphEdgeID) * (maxdepth + 1));
-
-  if (show_progressbar)
-    gt_progressbar_start(&progress,
-        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
-
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  for (i = part->firstvertex; i < part->endvertex; i++)
   {
     if (GT_STRGRAPH_V_OUTDEG(strgraph, i) > 0)
     {
@@ -1160,8 +1270,11 @@ GtUword gt_strgraph_reddepaths(GtStrgraph *strgraph,
          GT_STRGRAPH_V_INDEG(strgraph, i) > (GtStrgraphVEdgenum)1);
       for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
       {
+        /* the edges of a non-internal vertex are only marked by the part
+           containing the vertex */
         if (!GT_STRGRAPH_EDGE_IS_REDUCED(strgraph, i, j) &&
-            !GT_STRGRAPH_EDGE_HAS_MARK(strgraph, i, j))
+            !GT_STRGRAPH_EDGE_HAS_MARK(strgraph, i, j) &&
+            !GT_STRGRAPH_EDGE_HAS_MARK_IN(strgraph, part->edgemarks, i, j))
         {
           from = i;
           from_to = j;
@@ -1184,21 +1297,40 @@ GtUword gt_strgraph_reddepaths(GtStrgraph *strgraph,
           if (depth <= maxdepth &&
               (!i_branching || GT_STRGRAPH_V_OUTDEG(strgraph, to) == 0))
           {
-            nofdepaths++;
+            part->count++;
             for (d = 0; d < depth; d++)
             {
-              GT_STRGRAPH_EDGE_SET_MARK(strgraph, edges[d].vnum,
-                  edges[d].edgenum);
+              GT_STRGRAPH_EDGE_SET_MARK_IN(strgraph, part->edgemarks,
+                  edges[d].vnum, edges[d].edgenum);
             }
           }
         }
       }
     }
-    if (show_progressbar)
-      progress++;
+    if (part->progress != NULL)
+      (*part->progress) += part->progressstep;
   }
   gt_free(edges);
-  counter = gt_strgraph_reduce_marked_edges(strgraph);
+  return NULL;
+}
+
+GtUword gt_strgraph_reddepaths(GtStrgraph *strgraph,
+    GtUword maxdepth, bool show_progressbar)
+{
+  GtStrgraphReductionPart template;
+  GtUword counter = 0, nofdepaths = 0;
+  GtUint64 progress = 0;
+
+  gt_assert(strgraph != NULL);
+
+  if (show_progressbar)
+    gt_progressbar_start(&progress,
+        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
+
+  template.maxdepth = maxdepth;
+  template.maxwidth = template.maxdiff = template.maxoutdeg = 0;
+  counter = gt_strgraph_reduce_in_parts(strgraph, gt_strgraph_reddepaths_part,
+      &template, &nofdepaths, &progress);
   if (show_progressbar)
     gt_progressbar_stop();
   gt_log_log("dead-paths = "GT_WU"", nofdepaths);
@@ -1227,43 +1359,18 @@ static int gt_strgraph_path_info_compare(const void *pi_a, const void *pi_b)
   return retv;
 }
 
-GtUword gt_strgraph_redpbubbles(GtStrgraph *strgraph,
-    GtUword maxwidth, const GtUword maxdiff,
-    bool show_progressbar)
+static void *gt_strgraph_redpbubbles_part(void *data)
 {
+  GtStrgraphReductionPart *part = data;
+  GtStrgraph *strgraph = part->strgraph;
   GtStrgraphVnum i, from, to;
   GtStrgraphVEdgenum j, from_to, p, nofpaths;
   GtStrgraphLength len;
-  GtUword depth, width, counter = 0, nofpbubbles = 0;
-  GtUint64 progress = 0;
+  GtUword depth, width, maxwidth = part->maxwidth;
   GtStrgraphPathInfo *info, *prev;
 
-  gt_assert(strgraph != NULL);
-
-  if (maxwidth == 0)
-    maxwidth = (GtUword)(gt_strgraph_longest_read(strgraph) << 2) -
-        (strgraph->minmatchlen << 1) - 1;
-  gt_log_log("redpbubbles(maxwidth="GT_WU", maxdiff="GT_WU")", maxwidth,
-             maxdiff);
-
-  /* allocate info and set all marks to VACANT */
-  {
-    GtUword maxoutdeg = 0;
-    for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
-    {
-      GT_STRGRAPH_V_SET_MARK(strgraph, i, GT_STRGRAPH_V_VACANT);
-      if (GT_STRGRAPH_V_OUTDEG(strgraph, i) > (GtStrgraphVEdgenum)maxoutdeg)
-        maxoutdeg = (GtUword)GT_STRGRAPH_V_OUTDEG(strgraph, i);
-    }
-    gt_log_log("maxoutdeg = "GT_WU"", maxoutdeg);
-    info = gt_malloc(sizeof (GtStrgraphPathInfo) * maxoutdeg);
-  }
-
-  if (show_progressbar)
-    gt_progressbar_start(&progress,
-        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
-
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  info = gt_malloc(sizeof (GtStrgraphPathInfo) * part->maxoutdeg);
+  for (i = part->firstvertex; i < part->endvertex; i++)
   {
     if (GT_STRGRAPH_V_OUTDEG(strgraph, i) > 0)
     {
@@ -1310,9 +1417,9 @@ GtUword gt_strgraph_redpbubbles(GtStrgraph *strgraph,
         for (p = (GtStrgraphVEdgenum)1; p < nofpaths; p++)
         {
           if (info[p].dest == prev->dest &&
-              (info[p].width - prev->width <= maxdiff))
+              (info[p].width - prev->width <= part->maxdiff))
           {
-            nofpbubbles++;
+            part->count++;
             if (info[p].depth <= prev->depth)
             {
               from_to = info[p].edgenum;
@@ -1322,13 +1429,15 @@ GtUword gt_strgraph_redpbubbles(GtStrgraph *strgraph,
               from_to = prev->edgenum;
               prev = info + p;
             }
-            GT_STRGRAPH_EDGE_SET_MARK(strgraph, i, from_to);
+            GT_STRGRAPH_EDGE_SET_MARK_IN(strgraph, part->edgemarks, i,
+                from_to);
             to = GT_STRGRAPH_EDGE_DEST(strgraph, i, from_to);
             while (GT_STRGRAPH_V_IS_INTERNAL(strgraph, to))
             {
               from = to;
               from_to = gt_strgraph_find_only_edge(strgraph, from);
-              GT_STRGRAPH_EDGE_SET_MARK(strgraph, from, from_to);
+              GT_STRGRAPH_EDGE_SET_MARK_IN(strgraph, part->edgemarks, from,
+                  from_to);
               to = GT_STRGRAPH_EDGE_DEST(strgraph, from, from_to);
             }
           }
@@ -1339,14 +1448,53 @@ GtUword gt_strgraph_redpbubbles(GtStrgraph *strgraph,
         }
       }
     }
-    if (show_progressbar)
-      progress++;
+    if (part->progress != NULL)
+      (*part->progress) += part->progressstep;
+  }
+  gt_free(info);
+  return NULL;
+}
+
+GtUword gt_strgraph_redpbubbles(GtStrgraph *strgraph,
+    GtUword maxwidth, const GtUword maxdiff,
+    bool show_progressbar)
+{
+  GtStrgraphReductionPart template;
+  GtStrgraphVnum i;
+  GtUword counter = 0, nofpbubbles = 0;
+  GtUint64 progress = 0;
+
+  gt_assert(strgraph != NULL);
+
+  if (maxwidth == 0)
+    maxwidth = (GtUword)(gt_strgraph_longest_read(strgraph) << 2) -
+        (strgraph->minmatchlen << 1) - 1;
+  gt_log_log("redpbubbles(maxwidth="GT_WU", maxdiff="GT_WU")", maxwidth,
+             maxdiff);
+
+  /* determine size of info and set all marks to VACANT */
+  template.maxoutdeg = 0;
+  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  {
+    GT_STRGRAPH_V_SET_MARK(strgraph, i, GT_STRGRAPH_V_VACANT);
+    if (GT_STRGRAPH_V_OUTDEG(strgraph, i) >
+        (GtStrgraphVEdgenum)template.maxoutdeg)
+      template.maxoutdeg = (GtUword)GT_STRGRAPH_V_OUTDEG(strgraph, i);
   }
-  counter = gt_strgraph_reduce_marked_edges(strgraph);
+  gt_log_log("maxoutdeg = "GT_WU"", template.maxoutdeg);
+
+  if (show_progressbar)
+    gt_progressbar_start(&progress,
+        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
+
+  template.maxwidth = maxwidth;
+  template.maxdiff = maxdiff;
+  template.maxdepth = 0;
+  counter = gt_strgraph_reduce_in_parts(strgraph,
+      gt_strgraph_redpbubbles_part, &template, &nofpbubbles, &progress);
 
   if (show_progressbar)
     gt_progressbar_stop();
-  gt_free(info);
   gt_log_log("p-bubbles = "GT_WU"", nofpbubbles);
   gt_log_log("removed p-bubble edges = "GT_WU"", counter);
 #ifndef NDEBUG
@@ -2717,6 +2865,219 @@ static void gt_strgraph_spell_vertex(GtStrgraphVnum firstvertex, void *data)
   sdata->current_depth = 1UL;
 }
 
+/* --- Parallel Direct Contig Output --- */
+
+/* The traversal decides which paths are spelled and is cheap compared to
+   spelling the contigs. So the contig paths are first recorded by a
+   sequential traversal; then the recorded contigs are split into parts,
+   which are spelled by different threads into temporary files. These are
+   appended to the output in the order of the parts. */
+
+typedef struct {
+  GtUword total_depth, current_depth, min_depth,
+          current_length, min_length, contignum, current_start;
+  GtStrgraph *strgraph;
+  /* for each contig the seqnum of the first read, followed by pairs of
+     seqnum and length of the appended reads */
+  GtArrayGtUword elems;
+  /* the start of each recorded contig in <elems> */
+  GtArrayGtUword contigstart;
+  GtArrayGtUword contiglength;
+} GtStrgraphSpellRecord;
+
+static void gt_strgraph_record_spell_edge(GtStrgraphVnum v,
+    GtStrgraphLength len, void *data)
+{
+  GtStrgraphSpellRecord *rdata = data;
+
+  GT_STOREINARRAY(&rdata->elems, GtUword, GT_STRGRAPH_CONTIG_INC,
+      GT_STRGRAPH_V_MIRROR_SEQNUM(GT_STRGRAPH_NOFVERTICES(rdata->strgraph),
+        v));
+  GT_STOREINARRAY(&rdata->elems, GtUword, GT_STRGRAPH_CONTIG_INC,
+      (GtUword)len);
+  (rdata->current_depth)++;
+  rdata->current_length += len;
+}
+
+static void gt_strgraph_record_spell_end(GtStrgraphSpellRecord *rdata)
+{
+  if ((rdata->current_depth >= rdata->min_depth) &&
+      (rdata->current_length >= rdata->min_length))
+  {
+    if (rdata->elems.nextfreeGtUword > rdata->current_start)
+    {
+      GT_STOREINARRAY(&rdata->contigstart, GtUword, 256UL,
+          rdata->current_start);
+      GT_STOREINARRAY(&rdata->contiglength, GtUword, 256UL,
+          rdata->current_length);
+    }
+  }
+  else
+    rdata->elems.nextfreeGtUword = rdata->current_start;
+}
+
+static void gt_strgraph_record_spell_vertex(GtStrgraphVnum firstvertex,
+    void *data)
+{
+  GtStrgraphSpellRecord *rdata = data;
+
+  if ((rdata->current_depth >= rdata->min_depth) &&
+      (rdata->current_length >= rdata->min_length))
+  {
+    rdata->total_depth += rdata->current_depth;
+    (rdata->contignum)++;
+  }
+  gt_strgraph_record_spell_end(rdata);
+  rdata->current_start = rdata->elems.nextfreeGtUword;
+  GT_STOREINARRAY(&rdata->elems, GtUword, GT_STRGRAPH_CONTIG_INC,
+      GT_STRGRAPH_V_MIRROR_SEQNUM(GT_STRGRAPH_NOFVERTICES(rdata->strgraph),
+        firstvertex));
+  rdata->current_length = (GtUword)GT_STRGRAPH_SEQLEN(rdata->strgraph,
+      firstvertex);
+  rdata->current_depth = 1UL;
+}
+
+typedef struct {
+  const GtStrgraphSpellRecord *rdata;
+  GtUword firstcontig, endcontig;
+  GtContigsWriter *cw;
+  GtFile *outfp;
+  FILE *tmpfp;
+  GtThread *thread;
+} GtStrgraphSpellPart;
+
+static void *gt_strgraph_spell_part(void *data)
+{
+  GtStrgraphSpellPart *part = data;
+  const GtStrgraphSpellRecord *rdata = part->rdata;
+  const GtUword *elems = rdata->elems.spaceGtUword;
+  GtUword c, i, end;
+
+  gt_contigs_writer_set_contignum(part->cw, part->firstcontig);
+  for (c = part->firstcontig; c < part->endcontig; c++)
+  {
+    i = rdata->contigstart.spaceGtUword[c];
+    end = (c + 1 < rdata->contigstart.nextfreeGtUword)
+      ? rdata->contigstart.spaceGtUword[c + 1]
+      : rdata->elems.nextfreeGtUword;
+    gt_contigs_writer_start(part->cw, elems[i]);
+    for (i++; i < end; i += 2)
+      gt_contigs_writer_append(part->cw, elems[i], elems[i + 1]);
+    gt_contigs_writer_write(part->cw);
+  }
+  return NULL;
+}
+
+static void gt_strgraph_show_contigs_in_parts(GtStrgraph *strgraph,
+    GtUword min_path_depth, GtUword min_contig_length,
+    bool showpaths, GtFile *outfp, const GtEncseq *encseq,
+    bool show_progressbar, GtLogger *logger)
+{
+  GtStrgraphSpellRecord rdata;
+  GtStrgraphSpellPart *parts;
+  GtUword c, nofcontigs, totallength = 0, partlength, sumlength;
+  unsigned int numofparts = gt_jobs, p;
+
+  gt_strgraph_set_encseq(strgraph, encseq);
+  rdata.strgraph = strgraph;
+  rdata.total_depth = 1UL;
+  rdata.current_depth = 1UL;
+  rdata.current_length = 0;
+  rdata.current_start = 0;
+  rdata.contignum = 0;
+  rdata.min_depth = min_path_depth;
+  rdata.min_length = min_contig_length;
+  GT_INITARRAY(&rdata.elems, GtUword);
+  GT_INITARRAY(&rdata.contigstart, GtUword);
+  GT_INITARRAY(&rdata.contiglength, GtUword);
+
+  gt_strgraph_traverse(strgraph, gt_strgraph_record_spell_vertex,
+      gt_strgraph_record_spell_edge, &rdata, show_progressbar);
+
+  /* record last contig */
+  gt_strgraph_record_spell_end(&rdata);
+
+  gt_log_log("traversed edges = "GT_WU"", rdata.total_depth);
+  gt_log_log("numofcontigs = "GT_WU"", rdata.contignum);
+
+  /* split the contigs into parts of about the same total length */
+  nofcontigs = rdata.contigstart.nextfreeGtUword;
+  for (c = 0; c < nofcontigs; c++)
+    totallength += rdata.contiglength.spaceGtUword[c];
+  if (numofparts == 0)
+    numofparts = 1U;
+  partlength = totallength / numofparts + 1;
+  parts = gt_malloc(sizeof (*parts) * numofparts);
+  c = 0;
+  for (p = 0; p < numofparts; p++)
+  {
+    parts[p].rdata = &rdata;
+    parts[p].firstcontig = c;
+    for (sumlength = 0; c < nofcontigs &&
+        (sumlength < partlength || p == numofparts - 1); c++)
+      sumlength += rdata.contiglength.spaceGtUword[c];
+    parts[p].endcontig = c;
+    if (p == 0)
+    {
+      parts[p].tmpfp = NULL;
+      parts[p].outfp = outfp;
+    }
+    else
+    {
+      parts[p].tmpfp = gt_xtmpfp_generic(NULL,
+          TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+      parts[p].outfp = gt_file_new_from_fileptr(parts[p].tmpfp);
+    }
+    parts[p].cw = gt_contigs_writer_new(encseq, parts[p].outfp);
+    if (showpaths)
+      gt_contigs_writer_enable_complete_path_output(parts[p].cw);
+    parts[p].thread = NULL;
+  }
+#ifdef GT_THREADS_ENABLED
+  for (p = 1U; p < numofparts; p++)
+    parts[p].thread = gt_thread_new(gt_strgraph_spell_part, parts + p, NULL);
+  (void) gt_strgraph_spell_part(parts);
+  for (p = 1U; p < numofparts; p++)
+  {
+    if (parts[p].thread != NULL)
+    {
+      gt_thread_join(parts[p].thread);
+      gt_thread_delete(parts[p].thread);
+    }
+    else
+      (void) gt_strgraph_spell_part(parts + p);
+  }
+#else
+  for (p = 0; p < numofparts; p++)
+    (void) gt_strgraph_spell_part(parts + p);
+#endif
+  for (p = 1U; p < numofparts; p++)
+  {
+    char buffer[BUFSIZ];
+    size_t len;
+
+    rewind(parts[p].tmpfp);
+    while ((len = fread(buffer, sizeof (*buffer), sizeof (buffer),
+            parts[p].tmpfp)) > 0)
+      gt_file_xwrite(outfp, buffer, len);
+    gt_contigs_writer_merge(parts[0].cw, parts[p].cw);
+    gt_contigs_writer_delete(parts[p].cw);
+    gt_file_delete_without_handle(parts[p].outfp);
+    gt_fa_xfclose(parts[p].tmpfp);
+  }
+
+  if (rdata.contignum > 0)
+    gt_contigs_writer_show_stats(parts[0].cw, logger);
+  else
+    gt_logger_log(logger, "no contigs respect the given cutoff parameters");
+
+  gt_contigs_writer_delete(parts[0].cw);
+  gt_free(parts);
+  GT_FREEARRAY(&rdata.elems, GtUword);
+  GT_FREEARRAY(&rdata.contigstart, GtUword);
+  GT_FREEARRAY(&rdata.contiglength, GtUword);
+}
+
 static void gt_strgraph_show_contigs(GtStrgraph *strgraph,
     GtUword min_path_depth, GtUword min_contig_length,
     bool showpaths, GtFile *outfp, const GtEncseq *encseq,
@@ -2774,8 +3135,13 @@ void gt_strgraph_spell(GtStrgraph *strgraph, GtUword min_path_depth,
   if (!delay_reads_mapping)
   {
     GtFile *gt_outfp = gt_file_new_from_fileptr(main_file);
-    gt_strgraph_show_contigs(strgraph, min_path_depth, min_contig_length,
-        showpaths, gt_outfp, encseq, show_progressbar, logger);
+    if (gt_jobs > 1U)
+      gt_strgraph_show_contigs_in_parts(strgraph, min_path_depth,
+          min_contig_length, showpaths, gt_outfp, encseq, show_progressbar,
+          logger);
+    else
+      gt_strgraph_show_contigs(strgraph, min_path_depth, min_contig_length,
+          showpaths, gt_outfp, encseq, show_progressbar, logger);
     gt_file_delete_without_handle(gt_outfp);
   }
   else if (show_contigs_info)
@@ -722,6 +722,7 @@ static GtCodetype getencseqkmers_nospecialtwobitencoding(
                                                            GtCodetype),
                                     void *processkmercodeinfo,
                                     bool onlyfirst,
+                                    GT_UNUSED bool blockwise,
                                     GtUword startpos,
                                     GtUword endpos)
 {
@@ -791,7 +792,6 @@ static GtCodetype getencseqkmers_nospecialtwobitencoding(
     GtUword maxunitindex = gt_unitsoftwobitencoding(totallength) - 1;
 
     pos = startpos;
-    unitindex = GT_DIVBYUNITSIN2BITENC(startpos+kmersize);
     code = gt_kmercode_at_position(twobitencoding,pos,kmersize);
     if (processkmercode != NULL)
     {
@@ -804,6 +804,56 @@ static GtCodetype getencseqkmers_nospecialtwobitencoding(
     {
       return code;
     }
+#ifdef GT_KMERCODES_BLOCKWISE
+    if (blockwise && gt_kmercodes_blockwise())
+    {
+      const GtUword lastpos = endpos - (GtUword) upperkmersize;
+      GtCodetype codes[GT_UNITSIN2BITENC];
+
+      if (processkmercode == NULL)
+      {
+        return gt_kmercode_at_position(twobitencoding,lastpos,kmersize);
+      }
+      /* extract the codes for all positions of a unit at once and deliver
+         those selected by the mask */
+      for (unitindex = GT_DIVBYUNITSIN2BITENC(pos+1); pos < lastpos;
+           unitindex++)
+      {
+        const GtUword blockstart = unitindex * GT_UNITSIN2BITENC;
+        GtUword mask = gt_kmercodes_block_mask(blockstart,pos+1,lastpos);
+        unsigned int idx;
+
+        gt_assert(unitindex < maxunitindex);
+        gt_kmercodes_twobit_block_avx2(codes,twobitencoding[unitindex],
+                                       twobitencoding[unitindex+1],kmersize);
+        if (mask == GT_KMERCODES_FULLMASK)
+        {
+          for (idx = 0; idx < (unsigned int) GT_UNITSIN2BITENC; idx++)
+          {
+            processkmercode(processkmercodeinfo,false,blockstart + idx,
+                            (readmode == GT_READMODE_COMPL)
+                              ? gt_kmercode_complement(codes[idx],maskright)
+                              : codes[idx]);
+          }
+          pos = blockstart + GT_UNITSIN2BITENC - 1;
+        } else
+        {
+          for (/* Nothing */; mask != 0; mask &= mask - 1)
+          {
+            idx = gt_kmercodes_mask_first(mask);
+            pos = blockstart + idx;
+            processkmercode(processkmercodeinfo,false,pos,
+                            (readmode == GT_READMODE_COMPL)
+                              ? gt_kmercode_complement(codes[idx],maskright)
+                              : codes[idx]);
+          }
+        }
+        code = codes[pos - blockstart];
+      }
+      return code;
+    }
+#endif
+    unitindex = GT_DIVBYUNITSIN2BITENC(startpos+kmersize);
     currentencoding = twobitencoding[unitindex];
     shiftright = (unsigned int)
                  GT_MULT2(GT_UNITSIN2BITENC - 1 -
@@ -854,6 +904,7 @@ void getencseqkmers_rangetwobitencoding(const GtEncseq *encseq,
                                                                   unsigned int,
                                                                   GtUword),
                                         void *processkmerspecialinfo,
+                                        bool blockwise,
                                         GtUword startpos,
                                         GtUword endpos)
 {
@@ -896,6 +947,7 @@ void getencseqkmers_rangetwobitencoding(const GtEncseq *encseq,
                                                       processkmercode,
                                                       processkmercodeinfo,
                                                       onlyfirst,
+                                                      blockwise,
                                                       startpos,
                                                       endpos);
     if (processkmerspecial != NULL)
@@ -942,7 +994,7 @@ void getencseqkmers_rangetwobitencoding(const GtEncseq *encseq,
   }
 }
 
-void gt_getencseqkmers_twobitencoding_slice(const GtEncseq *encseq,
+static void getencseqkmers_twobitencoding_slice(const GtEncseq *encseq,
                                          GtReadmode readmode,
                                          unsigned int kmersize,
                                          unsigned int upperkmersize,
@@ -957,6 +1009,7 @@ void gt_getencseqkmers_twobitencoding_slice(const GtEncseq *encseq,
                                                                    unsigned int,
                                                                    GtUword),
                                          void *processkmerspecialinfo,
+                                         bool blockwise,
                                          GtUword slice_startpos,
                                          GtUword slice_endpos)
 {
@@ -984,6 +1037,7 @@ void gt_getencseqkmers_twobitencoding_slice(const GtEncseq *encseq,
                                              processkmercodeinfo,
                                              processkmerspecial,
                                              processkmerspecialinfo,
+                                             blockwise,
                                              range.end,
                                              lastend);
           lastend = range.start;
@@ -1007,6 +1061,7 @@ void gt_getencseqkmers_twobitencoding_slice(const GtEncseq *encseq,
                                              processkmercodeinfo,
                                              processkmerspecial,
                                              processkmerspecialinfo,
+                                             blockwise,
                                              laststart,
                                              range.start);
           laststart = range.end;
@@ -1033,11 +1088,44 @@ void gt_getencseqkmers_twobitencoding_slice(const GtEncseq *encseq,
                                        processkmercodeinfo,
                                        processkmerspecial,
                                        processkmerspecialinfo,
+                                       blockwise,
                                        startpos,
                                        endpos);
   }
 }
 
+void gt_getencseqkmers_twobitencoding_slice(const GtEncseq *encseq,
+                                         GtReadmode readmode,
+                                         unsigned int kmersize,
+                                         unsigned int upperkmersize,
+                                         bool onlyfirst,
+                                         void(*processkmercode)(void *,
+                                                                bool,
+                                                                GtUword,
+                                                                GtCodetype),
+                                         void *processkmercodeinfo,
+                                         void(*processkmerspecial)(void *,
+                                                                   unsigned int,
+                                                                   unsigned int,
+                                                                   GtUword),
+                                         void *processkmerspecialinfo,
+                                         GtUword slice_startpos,
+                                         GtUword slice_endpos)
+{
+  getencseqkmers_twobitencoding_slice(encseq,
+                                      readmode,
+                                      kmersize,
+                                      upperkmersize,
+                                      onlyfirst,
+                                      processkmercode,
+                                      processkmercodeinfo,
+                                      processkmerspecial,
+                                      processkmerspecialinfo,
+                                      true,
+                                      slice_startpos,
+                                      slice_endpos);
+}
+
 void getencseqkmers_twobitencoding(const GtEncseq *encseq,
                                    GtReadmode readmode,
                                    unsigned int kmersize,
@@ -1054,17 +1142,41 @@ void getencseqkmers_twobitencoding(const GtEncseq *encseq,
                                                              GtUword),
                                    void *processkmerspecialinfo)
 {
-  gt_getencseqkmers_twobitencoding_slice(encseq,
-                                         readmode,
-                                         kmersize,
-                                         upperkmersize,
-                                         onlyfirst,
-                                         processkmercode,
-                                         processkmercodeinfo,
-                                         processkmerspecial,
-                                         processkmerspecialinfo,
-                                         0,
-                                         gt_encseq_total_length(encseq));
+  getencseqkmers_twobitencoding_slice(encseq,
+                                      readmode,
+                                      kmersize,
+                                      upperkmersize,
+                                      onlyfirst,
+                                      processkmercode,
+                                      processkmercodeinfo,
+                                      processkmerspecial,
+                                      processkmerspecialinfo,
+                                      true,
+                                      0,
+                                      gt_encseq_total_length(encseq));
+}
+
+void gt_getencseqkmers_twobitencoding_rolling(const GtEncseq *encseq,
+                                              GtReadmode readmode,
+                                              unsigned int kmersize,
+                                              void(*processkmercode)(void *,
+                                                                bool,
+                                                                GtUword,
+                                                                GtCodetype),
+                                              void *processkmercodeinfo)
+{
+  getencseqkmers_twobitencoding_slice(encseq,
+                                      readmode,
+                                      kmersize,
+                                      kmersize,
+                                      false,
+                                      processkmercode,
+                                      processkmercodeinfo,
+                                      NULL,
+                                      NULL,
+                                      false,
+                                      0,
+                                      gt_encseq_total_length(encseq));
 }
 
 static void gt_updateleftborderforkmer(Sfxiterator *sfi,
@@ -1117,7 +1229,7 @@ typedef struct
                 numofsequences;
   GtCodetype maskright;
   unsigned int kmersize, upperkmersize;
-  bool mirrored;
+  bool mirrored, blockwise;
   const GtEncseq *encseq; /* XXX remove later */
 } GtSfxmapped4constinfo;
 
@@ -90,6 +90,20 @@ void getencseqkmers_twobitencoding(const GtEncseq *encseq,
                                                              GtUword),
                                    void *processkmerspecialinfo);
 
+/* Like <getencseqkmers_twobitencoding()> with <upperkmersize> = <kmersize>
+   and without the processing of special kmers, but the code of each kmer is
+   always obtained from the code of its predecessor, also if the blockwise
+   extraction of kmer codes is enabled (see kmercodes.h). This allows to
+   compare both methods. */
+void gt_getencseqkmers_twobitencoding_rolling(const GtEncseq *encseq,
+                                              GtReadmode readmode,
+                                              unsigned int kmersize,
+                                              void(*processkmercode)(void *,
+                                                                bool,
+                                                                GtUword,
+                                                                GtCodetype),
+                                              void *processkmercodeinfo);
+
 void gt_getencseqkmers_twobitencoding_slice(const GtEncseq *encseq,
                                          GtReadmode readmode,
                                          unsigned int kmersize,
@@ -24,6 +24,7 @@
 #include "core/intbits.h"
 #include "core/unused_api.h"
 #include "hashfirstcodes.h"
+#include "kmercodes.h"
 #include "sfx-mappedstr.h"
 #include "sfx-suffixer.h"
 #include "twobits2kmers.h"
@@ -203,7 +204,8 @@ static void gt_encseq_faststream_kmers(const GtEncseq *encseq,
   }
   twobitencoding = gt_encseq_twobitencoding_export(encseq);
   if (bsrsmode == BSRS_reader_multi ||
-      bsrsmode == BSRS_stream_reader_multi)
+      bsrsmode == BSRS_stream_reader_multi ||
+      bsrsmode == BSRS_stream_reader_block)
   {
     kmercodeiterator = gt_kmercodeiterator_encseq_new(encseq,
                                                       GT_READMODE_FORWARD,
@@ -232,6 +234,29 @@ static void gt_encseq_faststream_kmers(const GtEncseq *encseq,
         READNEXTCODEANDCHECKIGNORESPECIAL(pos);
       }
       break;
+    case BSRS_stream_reader_block:
+      {
+        GtCodetype codes[GT_UNITSIN2BITENC];
+        const GtUword lastpos = totallength - (GtUword) kmersize;
+        GtUword unitindex;
+
+        for (unitindex = 0, pos = 0; pos <= lastpos; unitindex++)
+        {
+          const GtUword blockstart = unitindex * GT_UNITSIN2BITENC;
+          GtUword mask = gt_kmercodes_block_mask(blockstart,pos,lastpos);
+
+          gt_kmercodes_twobit_block(codes,twobitencoding[unitindex],
+                                    twobitencoding[unitindex+1],kmersize);
+          for (/* Nothing */; mask != 0; mask &= mask - 1)
+          {
+            pos = blockstart + gt_kmercodes_mask_first(mask);
+            kmer = codes[pos - blockstart];
+            READNEXTCODEANDCHECKIGNORESPECIAL(pos);
+          }
+          pos++;
+        }
+        break;
+      }
     case BSRS_stream_reader_multi3:
       multireadmode_getencseqkmers_twobitencoding(encseq,kmersize);
       break;
@@ -312,6 +337,7 @@ void gt_encseq_faststream(const GtEncseq *encseq,
       case BSRS_reader_multi:
       case BSRS_stream_reader_multi:
       case BSRS_stream_reader_multi3:
+      case BSRS_stream_reader_block:
       case BSRS_hashfirstcodes:
         gt_encseq_faststream_kmers(encseq,bsrsmode,multiarg);
         break;
@@ -29,6 +29,7 @@ typedef enum
   BSRS_reader_multi,
   BSRS_stream_reader_multi,
   BSRS_stream_reader_multi3,
+  BSRS_stream_reader_block,
   BSRS_hashfirstcodes
 } Bitstreamreadmode;
 
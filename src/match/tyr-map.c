@@ -162,6 +162,11 @@ GtUword gt_tyrindex_mersize(const Tyrindex *tyrindex)
   return tyrindex->mersize;
 }
 
+GtUword gt_tyrindex_numofmers(const Tyrindex *tyrindex)
+{
+  return (GtUword) tyrindex->numofmers;
+}
+
 unsigned int gt_tyrindex_alphasize(const Tyrindex *tyrindex)
 {
   return tyrindex->alphasize;
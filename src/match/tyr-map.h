@@ -31,6 +31,7 @@ const GtUchar *gt_tyrindex_lastmer(const Tyrindex *tyrindex);
 GtUword gt_tyrindex_merbytes(const Tyrindex *tyrindex);
 unsigned int gt_tyrindex_alphasize(const Tyrindex *tyrindex);
 GtUword gt_tyrindex_mersize(const Tyrindex *tyrindex);
+GtUword gt_tyrindex_numofmers(const Tyrindex *tyrindex);
 bool gt_tyrindex_isempty(const Tyrindex *tyrindex);
 void gt_tyrindex_show(const Tyrindex *tyrindex);
 void gt_tyrindex_delete(Tyrindex **tyrindexptr);
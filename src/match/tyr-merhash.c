@@ -0,0 +1,321 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <inttypes.h>
+#include <limits.h>
+#include <string.h>
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/str_api.h"
+#include "core/types_api.h"
+#include "core/xansi_api.h"
+#include "tyr-merhash.h"
+
+#define MERHASHSUFFIX      ".mhs"
+#define MERHASHHEADERWORDS 5
+#define MERHASHSTAMPMERS   64UL
+
+/* The file consists of five integers, the logarithm of the number of slots,
+   the number of bytes per slot and the stamp of the index the table was
+   built from (its number of mers, its number of bytes per mer and a
+   fingerprint of some of its mers), followed by the slots. A slot stores
+   the number of a mer plus one, 0 marks an empty slot. If the number of
+   mers allows it, the slots are 32 bit integers. */
+
+struct Tyrhashinfo
+{
+  void *mappedmhsfileptr;
+  unsigned int logsize;
+  GtUword mask;
+  const uint32_t *slots32;
+  const GtUword *slots64;
+};
+
+static GtUword gt_merhash_function(const GtUchar *bytecode,
+                                   GtUword merbytes,
+                                   unsigned int logsize)
+{
+  uint64_t hashvalue = (uint64_t) 14695981039346656037ULL;
+  GtUword idx;
+
+  for (idx = 0; idx < merbytes; idx++)
+  {
+    hashvalue = (hashvalue ^ bytecode[idx]) * (uint64_t) 1099511628211ULL;
+  }
+  hashvalue *= (uint64_t) 11400714819323198485ULL;
+  return (GtUword) (hashvalue >> (64 - logsize));
+}
+
+/* the fingerprint covers the first, the last and evenly spaced mers in
+   between, so that it can be checked without reading the whole mertable */
+static GtUword gt_merhash_fingerprint(const Tyrindex *tyrindex)
+{
+  const GtUchar *mertable = gt_tyrindex_mertable(tyrindex);
+  GtUword idx, mernumber, step,
+          merbytes = gt_tyrindex_merbytes(tyrindex),
+          numofmers = gt_tyrindex_numofmers(tyrindex);
+  uint64_t hashvalue = (uint64_t) 14695981039346656037ULL;
+
+  step = numofmers > MERHASHSTAMPMERS ? numofmers/MERHASHSTAMPMERS : 1UL;
+  for (mernumber = 0; mernumber < numofmers; mernumber += step)
+  {
+    for (idx = 0; idx < merbytes; idx++)
+    {
+      hashvalue = (hashvalue ^ mertable[mernumber * merbytes + idx])
+                  * (uint64_t) 1099511628211ULL;
+    }
+  }
+  if (numofmers > 0)
+  {
+    for (idx = 0; idx < merbytes; idx++)
+    {
+      hashvalue = (hashvalue ^ mertable[(numofmers - 1) * merbytes + idx])
+                  * (uint64_t) 1099511628211ULL;
+    }
+  }
+  return (GtUword) hashvalue;
+}
+
+static unsigned int gt_merhash_logsize(GtUword numofmers)
+{
+  unsigned int logsize = 1U;
+
+  while (((GtUword) 1 << logsize) < 2 * numofmers)
+  {
+    logsize++;
+  }
+  return logsize;
+}
+
+void gt_removemerhash(const char *inputindex)
+{
+  if (gt_file_exists_with_suffix(inputindex,MERHASHSUFFIX))
+  {
+    GtStr *filename = gt_str_new_cstr(inputindex);
+
+    gt_str_append_cstr(filename,MERHASHSUFFIX);
+    gt_xremove(gt_str_get(filename));
+    gt_str_delete(filename);
+  }
+}
+
+int gt_constructmerhash(const char *inputindex,GtLogger *logger,
+                        GtError *err)
+{
+  Tyrindex *tyrindex;
+  FILE *hashfp = NULL;
+  bool haserr = false;
+
+  gt_error_check(err);
+  tyrindex = gt_tyrindex_new(inputindex,err);
+  if (tyrindex == NULL)
+  {
+    haserr = true;
+  }
+  if (!haserr && gt_tyrindex_isempty(tyrindex))
+  {
+    /* a table of an earlier index must not survive */
+    gt_removemerhash(inputindex);
+  }
+  if (!haserr && !gt_tyrindex_isempty(tyrindex))
+  {
+    hashfp = gt_fa_fopen_with_suffix(inputindex,MERHASHSUFFIX,"wb",err);
+    if (hashfp == NULL)
+    {
+      haserr = true;
+    }
+  }
+  if (!haserr && !gt_tyrindex_isempty(tyrindex))
+  {
+    const GtUchar *mertable = gt_tyrindex_mertable(tyrindex);
+    GtUword mernumber, slot, mask, slotbytes,
+            merbytes = gt_tyrindex_merbytes(tyrindex),
+            numofmers = gt_tyrindex_numofmers(tyrindex),
+            header[MERHASHHEADERWORDS];
+    unsigned int logsize = gt_merhash_logsize(numofmers);
+    uint32_t *slots32 = NULL;
+    GtUword *slots64 = NULL;
+
+    mask = ((GtUword) 1 << logsize) - 1;
+    if (numofmers < (GtUword) UINT32_MAX)
+    {
+      slots32 = gt_calloc((size_t) (mask+1),sizeof *slots32);
+      slotbytes = (GtUword) sizeof *slots32;
+    } else
+    {
+      slots64 = gt_calloc((size_t) (mask+1),sizeof *slots64);
+      slotbytes = (GtUword) sizeof *slots64;
+    }
+    gt_logger_log(logger,"construct mer hash with 2^%u slots",logsize);
+    for (mernumber = 0; mernumber < numofmers; mernumber++)
+    {
+      slot = gt_merhash_function(mertable + mernumber * merbytes,merbytes,
+                                 logsize);
+      if (slots32 != NULL)
+      {
+        while (slots32[slot] != 0)
+        {
+          slot = (slot + 1) & mask;
+        }
+        slots32[slot] = (uint32_t) (mernumber + 1);
+      } else
+      {
+        while (slots64[slot] != 0)
+        {
+          slot = (slot + 1) & mask;
+        }
+        slots64[slot] = mernumber + 1;
+      }
+    }
+    header[0] = (GtUword) logsize;
+    header[1] = slotbytes;
+    header[2] = numofmers;
+    header[3] = merbytes;
+    header[4] = gt_merhash_fingerprint(tyrindex);
+    gt_xfwrite(header,sizeof *header,(size_t) MERHASHHEADERWORDS,hashfp);
+    if (slots32 != NULL)
+    {
+      gt_xfwrite(slots32,sizeof *slots32,(size_t) (mask+1),hashfp);
+    } else
+    {
+      gt_xfwrite(slots64,sizeof *slots64,(size_t) (mask+1),hashfp);
+    }
+    gt_free(slots32);
+    gt_free(slots64);
+  }
+  gt_fa_xfclose(hashfp);
+  if (tyrindex != NULL)
+  {
+    gt_tyrindex_delete(&tyrindex);
+  }
+  return haserr ? -1 : 0;
+}
+
+bool gt_tyrhashinfo_exists(const char *tyrindexname)
+{
+  return gt_file_exists_with_suffix(tyrindexname,MERHASHSUFFIX);
+}
+
+Tyrhashinfo *gt_tyrhashinfo_new(const char *tyrindexname,
+                                const Tyrindex *tyrindex,
+                                GtError *err)
+{
+  size_t numofbytes;
+  Tyrhashinfo *tyrhashinfo;
+  bool haserr = false;
+
+  gt_error_check(err);
+  tyrhashinfo = gt_malloc(sizeof *tyrhashinfo);
+  tyrhashinfo->slots32 = NULL;
+  tyrhashinfo->slots64 = NULL;
+  tyrhashinfo->mappedmhsfileptr
+    = gt_fa_mmap_read_with_suffix(tyrindexname,MERHASHSUFFIX,&numofbytes,err);
+  if (tyrhashinfo->mappedmhsfileptr == NULL)
+  {
+    haserr = true;
+  }
+  if (!haserr && numofbytes < MERHASHHEADERWORDS * sizeof (GtUword))
+  {
+    gt_error_set(err,"file \"%s%s\" must contain at least "GT_WU" bytes",
+                 tyrindexname,MERHASHSUFFIX,
+                 (GtUword) (MERHASHHEADERWORDS * sizeof (GtUword)));
+    haserr = true;
+  }
+  if (!haserr)
+  {
+    const GtUword *header = (const GtUword *) tyrhashinfo->mappedmhsfileptr;
+    GtUword slotbytes = header[1];
+
+    tyrhashinfo->logsize = (unsigned int) header[0];
+    tyrhashinfo->mask = ((GtUword) 1 << tyrhashinfo->logsize) - 1;
+    if ((slotbytes != (GtUword) sizeof (uint32_t) &&
+         slotbytes != (GtUword) sizeof (GtUword)) ||
+        tyrhashinfo->logsize >= (unsigned int) (sizeof (GtUword) * CHAR_BIT)
+        || numofbytes != MERHASHHEADERWORDS * sizeof (GtUword) +
+                         slotbytes * (tyrhashinfo->mask + 1))
+    {
+      gt_error_set(err,"file \"%s%s\" is corrupt",tyrindexname,
+                   MERHASHSUFFIX);
+      haserr = true;
+    } else
+    {
+      if (header[2] != gt_tyrindex_numofmers(tyrindex) ||
+          tyrhashinfo->mask + 1 <= header[2] ||
+          header[3] != gt_tyrindex_merbytes(tyrindex) ||
+          header[4] != gt_merhash_fingerprint(tyrindex))
+      {
+        gt_error_set(err,"file \"%s%s\" was not built from the current "
+                         "index, rebuild it with option -hash",
+                     tyrindexname,MERHASHSUFFIX);
+        haserr = true;
+      } else
+      {
+        if (slotbytes == (GtUword) sizeof (uint32_t))
+        {
+          tyrhashinfo->slots32
+            = (const uint32_t *) (header + MERHASHHEADERWORDS);
+        } else
+        {
+          tyrhashinfo->slots64 = header + MERHASHHEADERWORDS;
+        }
+      }
+    }
+  }
+  if (haserr)
+  {
+    gt_fa_xmunmap(tyrhashinfo->mappedmhsfileptr);
+    gt_free(tyrhashinfo);
+    return NULL;
+  }
+  return tyrhashinfo;
+}
+
+void gt_tyrhashinfo_delete(Tyrhashinfo **tyrhashinfoptr)
+{
+  Tyrhashinfo *tyrhashinfo = *tyrhashinfoptr;
+
+  gt_fa_xmunmap(tyrhashinfo->mappedmhsfileptr);
+  tyrhashinfo->mappedmhsfileptr = NULL;
+  gt_free(tyrhashinfo);
+  *tyrhashinfoptr = NULL;
+}
+
+const GtUchar *gt_searchinmerhash(const Tyrindex *tyrindex,
+                                  const Tyrhashinfo *tyrhashinfo,
+                                  const GtUchar *bytecode)
+{
+  const GtUchar *mertable = gt_tyrindex_mertable(tyrindex), *merptr;
+  GtUword entry, merbytes = gt_tyrindex_merbytes(tyrindex),
+          slot = gt_merhash_function(bytecode,merbytes,tyrhashinfo->logsize);
+
+  while (true)
+  {
+    entry = tyrhashinfo->slots32 != NULL
+              ? (GtUword) tyrhashinfo->slots32[slot]
+              : tyrhashinfo->slots64[slot];
+    if (entry == 0)
+    {
+      return NULL;
+    }
+    merptr = mertable + (entry - 1) * merbytes;
+    if (memcmp(merptr,bytecode,(size_t) merbytes) == 0)
+    {
+      return merptr;
+    }
+    slot = (slot + 1) & tyrhashinfo->mask;
+  }
+}
@@ -0,0 +1,49 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef TYR_MERHASH_H
+#define TYR_MERHASH_H
+
+#include "core/error_api.h"
+#include "core/logger.h"
+#include "tyr-map.h"
+
+/* A <Tyrhashinfo> is an open addressing hash table over the mers of a
+   tallymer index, stored in a file with suffix .mhs. Each slot stores the
+   number of a mer in the mertable, so that a lookup only touches one or
+   two slots and the mer itself. The file is stamped with the index it was
+   built from, a table which does not match its index is rejected. */
+typedef struct Tyrhashinfo Tyrhashinfo;
+
+int gt_constructmerhash(const char *inputindex,GtLogger *logger,
+                        GtError *err);
+
+/* Removes the hash table of <inputindex>, if there is one. */
+void gt_removemerhash(const char *inputindex);
+
+bool gt_tyrhashinfo_exists(const char *tyrindexname);
+
+Tyrhashinfo *gt_tyrhashinfo_new(const char *tyrindexname,
+                                const Tyrindex *tyrindex,
+                                GtError *err);
+
+void gt_tyrhashinfo_delete(Tyrhashinfo **tyrhashinfoptr);
+
+/*@null@*/ const GtUchar *gt_searchinmerhash(const Tyrindex *tyrindex,
+                                             const Tyrhashinfo *tyrhashinfo,
+                                             const GtUchar *bytecode);
+
+#endif
@@ -23,6 +23,7 @@
 #include "core/logger.h"
 #include "core/spacecalc.h"
 #include "core/str.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 #include "core/ma_api.h"
@@ -511,6 +512,242 @@ static void outputbytewiseUlongvalue(FILE *fpout,GtUword value)
   }
 }
 
+typedef struct
+{
+  Sequentialsuffixarrayreader *ssar;
+  TyrDfsstate *state;
+  GtLogger *logger;
+  GtError *err;
+  int retval;
+  GtThread *thread;
+} TyrDfsthreadinfo;
+
+static void *tyr_dfsthread_caller(void *data)
+{
+  TyrDfsthreadinfo *threadinfo = (TyrDfsthreadinfo *) data;
+
+  threadinfo->retval = gt_depthfirstesa(threadinfo->ssar,
+                                        tyr_allocateDfsinfo,
+                                        tyr_freeDfsinfo,
+                                        tyr_processleafedge,
+                                        NULL,
+                                        tyr_processcompletenode,
+                                        tyr_assignleftmostleaf,
+                                        tyr_assignrightmostleaf,
+                                        (Dfsstate*) threadinfo->state,
+                                        threadinfo->logger,
+                                        threadinfo->err);
+  return NULL;
+}
+
+/* The state of a part shares the global information with <state>. The
+   first part writes to the output files of <state>, all other parts write
+   to temporary files which are appended in the order of the parts. */
+static TyrDfsstate *tyr_partstate_new(const TyrDfsstate *state,bool firstpart)
+{
+  TyrDfsstate *partstate = gt_malloc(sizeof *partstate);
+
+  *partstate = *state;
+  GT_INITARRAY(&partstate->occdistribution,Countwithpositions);
+  GT_INITARRAY(&partstate->largecounts,Largecount);
+  partstate->countoutputmers = 0;
+  partstate->esrspace = gt_encseq_create_reader_with_readmode(state->encseq,
+                                                              state->readmode,
+                                                              0);
+  if (state->bytebuffer != NULL)
+  {
+    partstate->bytebuffer = gt_malloc(sizeof *partstate->bytebuffer
+                                      * state->sizeofbuffer);
+  }
+  if (state->currentmer != NULL)
+  {
+    partstate->currentmer = gt_malloc(sizeof *partstate->currentmer
+                                      * state->mersize);
+  }
+  if (!firstpart && state->merindexfpout != NULL)
+  {
+    partstate->merindexfpout
+      = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+  }
+  if (!firstpart && state->countsfilefpout != NULL)
+  {
+    partstate->countsfilefpout
+      = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+  }
+  return partstate;
+}
+
+static void tyr_appendtmpfile(FILE *outfp,FILE *tmpfp)
+{
+  char buffer[BUFSIZ];
+  size_t len;
+
+  rewind(tmpfp);
+  while ((len = fread(buffer,sizeof *buffer,sizeof buffer,tmpfp)) > 0)
+  {
+    gt_xfwrite(buffer,sizeof *buffer,len,outfp);
+  }
+}
+
+/* the lists of later parts must come first, as in a sequential run the
+   positions are prepended to the lists */
+static void tyr_mergedistribution(GtArrayCountwithpositions *occdistribution,
+                                  GtArrayCountwithpositions *partdistribution)
+{
+  GtUword countocc;
+
+  for (countocc = 0; countocc < partdistribution->nextfreeCountwithpositions;
+       countocc++)
+  {
+    Countwithpositions *partcwp
+      = partdistribution->spaceCountwithpositions + countocc;
+
+    if (partcwp->occcount > 0)
+    {
+      incrementdistribcounts(occdistribution,countocc,partcwp->occcount);
+      if (partcwp->positionlist != NULL)
+      {
+        ListUlong *last;
+
+        for (last = partcwp->positionlist; last->nextptr != NULL;
+             last = last->nextptr)
+          /* Nothing */ ;
+        last->nextptr = occdistribution->spaceCountwithpositions[countocc].
+                                         positionlist;
+        occdistribution->spaceCountwithpositions[countocc].positionlist
+          = partcwp->positionlist;
+      }
+    }
+  }
+}
+
+static void tyr_mergepartstate(TyrDfsstate *state,TyrDfsstate *partstate,
+                               bool firstpart)
+{
+  GtUword idx;
+
+  if (!firstpart && partstate->merindexfpout != NULL)
+  {
+    tyr_appendtmpfile(state->merindexfpout,partstate->merindexfpout);
+    gt_fa_xfclose(partstate->merindexfpout);
+  }
+  if (!firstpart && partstate->countsfilefpout != NULL)
+  {
+    tyr_appendtmpfile(state->countsfilefpout,partstate->countsfilefpout);
+    gt_fa_xfclose(partstate->countsfilefpout);
+  }
+  for (idx = 0; idx < partstate->largecounts.nextfreeLargecount; idx++)
+  {
+    Largecount *lc;
+
+    GT_GETNEXTFREEINARRAY(lc,&state->largecounts,Largecount,32);
+    lc->idx = state->countoutputmers +
+              partstate->largecounts.spaceLargecount[idx].idx;
+    lc->value = partstate->largecounts.spaceLargecount[idx].value;
+  }
+  state->countoutputmers += partstate->countoutputmers;
+  tyr_mergedistribution(&state->occdistribution,&partstate->occdistribution);
+}
+
+static void tyr_partstate_delete(TyrDfsstate *partstate)
+{
+  GT_FREEARRAY(&partstate->occdistribution,Countwithpositions);
+  GT_FREEARRAY(&partstate->largecounts,Largecount);
+  gt_free(partstate->currentmer);
+  gt_free(partstate->bytebuffer);
+  gt_encseq_reader_delete(partstate->esrspace);
+  gt_free(partstate);
+}
+
+/* A mer corresponds to an lcp-interval of depth at least mersize whose
+   parent has depth smaller than mersize. Such an interval never crosses an
+   index with an lcp value smaller than mersize. So the suffix array is split
+   at these indexes and the parts are traversed independently. As the parts
+   are processed from left to right, the mers are output in the same order
+   as in a single traversal. */
+static int tyr_depthfirstesaparts(const Sequentialsuffixarrayreader *ssar,
+                                  TyrDfsstate *state,
+                                  unsigned int numofparts,
+                                  GtLogger *logger,
+                                  GtError *err)
+{
+  TyrDfsthreadinfo *th_tab;
+  GtUword *partstart;
+  unsigned int part;
+  bool haserr = false;
+
+  partstart = gt_malloc(sizeof *partstart * (numofparts + 1));
+  numofparts = gt_Sequentialsuffixarrayreader_splitparts(partstart,ssar,
+                                                         numofparts,
+                                                         state->mersize);
+  gt_logger_log(logger,"traverse suffix array in %u parts",numofparts);
+  th_tab = gt_malloc(sizeof *th_tab * numofparts);
+  for (part = 0; part < numofparts; part++)
+  {
+    th_tab[part].ssar = gt_newSequentialsuffixarrayreaderpart(ssar,
+                                                        partstart[part],
+                                                        partstart[part+1]);
+    th_tab[part].state = tyr_partstate_new(state,part == 0 ? true : false);
+    th_tab[part].logger = logger;
+    th_tab[part].err = gt_error_new();
+    th_tab[part].retval = 0;
+    th_tab[part].thread = NULL;
+  }
+#ifdef GT_THREADS_ENABLED
+  for (part = 1U; !haserr && part < numofparts; part++)
+  {
+    th_tab[part].thread = gt_thread_new(tyr_dfsthread_caller,th_tab + part,
+                                        err);
+    if (th_tab[part].thread == NULL)
+    {
+      haserr = true;
+    }
+  }
+  if (!haserr)
+  {
+    (void) tyr_dfsthread_caller(th_tab);
+  }
+  for (part = 1U; part < numofparts; part++)
+  {
+    if (th_tab[part].thread != NULL)
+    {
+      gt_thread_join(th_tab[part].thread);
+      gt_thread_delete(th_tab[part].thread);
+    }
+  }
+#else
+  for (part = 0; part < numofparts; part++)
+  {
+    (void) tyr_dfsthread_caller(th_tab + part);
+  }
+#endif
+  for (part = 0; part < numofparts; part++)
+  {
+    if (!haserr && th_tab[part].retval != 0)
+    {
+      gt_error_set(err,"%s",gt_error_get(th_tab[part].err));
+      haserr = true;
+    }
+    if (!haserr)
+    {
+      tyr_mergepartstate(state,th_tab[part].state,part == 0 ? true : false);
+    } else
+    {
+      if (part > 0)
+      {
+        gt_fa_xfclose(th_tab[part].state->merindexfpout);
+        gt_fa_xfclose(th_tab[part].state->countsfilefpout);
+      }
+    }
+    tyr_partstate_delete(th_tab[part].state);
+    gt_freeSequentialsuffixarrayreader(&th_tab[part].ssar);
+    gt_error_delete(th_tab[part].err);
+  }
+  gt_free(th_tab);
+  gt_free(partstart);
+  return haserr ? -1 : 0;
+}
+
 static int enumeratelcpintervals(const char *inputindex,
                                  Sequentialsuffixarrayreader *ssar,
                                  const char *storeindex,
@@ -598,23 +835,33 @@ static int enumeratelcpintervals(const char *inputindex,
       }
       state->processoccurrencecount = outputsortedstring2index;
     }
-    if (!haserr)
+    if (!haserr && !ssar->scanfile && gt_jobs > 1U)
+    {
+      if (tyr_depthfirstesaparts(ssar,state,gt_jobs,logger,err) != 0)
+      {
+        haserr = true;
+      }
+      if (!haserr && strlen(storeindex) == 0)
+      {
+        showfinalstatistics(state,inputindex,logger);
+      }
+    } else
     {
-      if (gt_depthfirstesa(ssar,
-                          tyr_allocateDfsinfo,
-                          tyr_freeDfsinfo,
-                          tyr_processleafedge,
-                          NULL,
-                          tyr_processcompletenode,
-                          tyr_assignleftmostleaf,
-                          tyr_assignrightmostleaf,
-                          (Dfsstate*) state,
-                          logger,
-                          err) != 0)
+      if (!haserr && gt_depthfirstesa(ssar,
+                                      tyr_allocateDfsinfo,
+                                      tyr_freeDfsinfo,
+                                      tyr_processleafedge,
+                                      NULL,
+                                      tyr_processcompletenode,
+                                      tyr_assignleftmostleaf,
+                                      tyr_assignrightmostleaf,
+                                      (Dfsstate*) state,
+                                      logger,
+                                      err) != 0)
       {
         haserr = true;
       }
-      if (strlen(storeindex) == 0)
+      if (!haserr && strlen(storeindex) == 0)
       {
         showfinalstatistics(state,inputindex,logger);
       }
@@ -19,6 +19,7 @@
 #include "core/unused_api.h"
 #include "core/logger.h"
 #include "core/ma_api.h"
+#include "core/thread_api.h"
 #include "esa-seqread.h"
 #include "tyr-occratio.h"
 
@@ -194,6 +195,145 @@ static void occ_assignrightmostleaf(Dfsinfo *adfsinfo,
   dfsinfo->lcptabrightmostleafplus1 = currentlcp;
 }
 
+typedef struct
+{
+  Sequentialsuffixarrayreader *ssar;
+  OccDfsstate state;
+  GtArrayuint64_t uniquedistribution,
+                  nonuniquedistribution,
+                  nonuniquemultidistribution;
+  GtLogger *logger;
+  GtError *err;
+  int retval;
+  GtThread *thread;
+} OccDfsthreadinfo;
+
+static void *occ_dfsthread_caller(void *data)
+{
+  OccDfsthreadinfo *threadinfo = (OccDfsthreadinfo *) data;
+
+  threadinfo->retval = gt_depthfirstesa(threadinfo->ssar,
+                                        occ_allocateDfsinfo,
+                                        occ_freeDfsinfo,
+                                        occ_processleafedge,
+                                        NULL,
+                                        occ_processcompletenode,
+                                        occ_assignleftmostleaf,
+                                        occ_assignrightmostleaf,
+                                        (Dfsstate*) &threadinfo->state,
+                                        threadinfo->logger,
+                                        threadinfo->err);
+  return NULL;
+}
+
+static void occ_adddistribution(GtArrayuint64_t *distribution,
+                                const GtArrayuint64_t *partdistribution)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < partdistribution->nextfreeuint64_t; idx++)
+  {
+    if (partdistribution->spaceuint64_t[idx] > 0)
+    {
+      adddistributionuint64_t(distribution,idx,
+                              (GtUword) partdistribution->spaceuint64_t[idx]);
+    }
+  }
+}
+
+/* Only lcp-intervals of depth at least minmersize contribute to the
+   distributions, so the suffix array is split at indexes with an lcp value
+   smaller than minmersize and the parts are traversed independently. */
+static int occ_depthfirstesaparts(const Sequentialsuffixarrayreader *ssar,
+                                  const OccDfsstate *state,
+                                  unsigned int numofparts,
+                                  GtLogger *logger,
+                                  GtError *err)
+{
+  OccDfsthreadinfo *th_tab;
+  GtUword *partstart;
+  unsigned int part;
+  bool haserr = false;
+
+  partstart = gt_malloc(sizeof *partstart * (numofparts + 1));
+  numofparts = gt_Sequentialsuffixarrayreader_splitparts(partstart,ssar,
+                                                         numofparts,
+                                                         state->minmersize);
+  th_tab = gt_malloc(sizeof *th_tab * numofparts);
+  for (part = 0; part < numofparts; part++)
+  {
+    th_tab[part].ssar = gt_newSequentialsuffixarrayreaderpart(ssar,
+                                                        partstart[part],
+                                                        partstart[part+1]);
+    th_tab[part].state = *state;
+    GT_INITARRAY(&th_tab[part].uniquedistribution,uint64_t);
+    GT_INITARRAY(&th_tab[part].nonuniquedistribution,uint64_t);
+    GT_INITARRAY(&th_tab[part].nonuniquemultidistribution,uint64_t);
+    th_tab[part].state.uniquedistribution = &th_tab[part].uniquedistribution;
+    th_tab[part].state.nonuniquedistribution
+      = &th_tab[part].nonuniquedistribution;
+    th_tab[part].state.nonuniquemultidistribution
+      = &th_tab[part].nonuniquemultidistribution;
+    th_tab[part].logger = logger;
+    th_tab[part].err = gt_error_new();
+    th_tab[part].retval = 0;
+    th_tab[part].thread = NULL;
+  }
+#ifdef GT_THREADS_ENABLED
+  for (part = 1U; !haserr && part < numofparts; part++)
+  {
+    th_tab[part].thread = gt_thread_new(occ_dfsthread_caller,th_tab + part,
+                                        err);
+    if (th_tab[part].thread == NULL)
+    {
+      haserr = true;
+    }
+  }
+  if (!haserr)
+  {
+    (void) occ_dfsthread_caller(th_tab);
+  }
+  for (part = 1U; part < numofparts; part++)
+  {
+    if (th_tab[part].thread != NULL)
+    {
+      gt_thread_join(th_tab[part].thread);
+      gt_thread_delete(th_tab[part].thread);
+    }
+  }
+#else
+  for (part = 0; part < numofparts; part++)
+  {
+    (void) occ_dfsthread_caller(th_tab + part);
+  }
+#endif
+  for (part = 0; part < numofparts; part++)
+  {
+    if (!haserr && th_tab[part].retval != 0)
+    {
+      gt_error_set(err,"%s",gt_error_get(th_tab[part].err));
+      haserr = true;
+    }
+    if (!haserr)
+    {
+      occ_adddistribution(state->uniquedistribution,
+                          &th_tab[part].uniquedistribution);
+      occ_adddistribution(state->nonuniquedistribution,
+                          &th_tab[part].nonuniquedistribution);
+      occ_adddistribution(state->nonuniquemultidistribution,
+                          &th_tab[part].nonuniquemultidistribution);
+    }
+    GT_FREEARRAY(&th_tab[part].uniquedistribution,uint64_t);
+    GT_FREEARRAY(&th_tab[part].nonuniquedistribution,uint64_t);
+    GT_FREEARRAY(&th_tab[part].nonuniquemultidistribution,uint64_t);
+    gt_freeSequentialsuffixarrayreader(&th_tab[part].ssar);
+    gt_error_delete(th_tab[part].err);
+  }
+  gt_free(th_tab);
+  gt_free(partstart);
+  return haserr ? -1 : 0;
+}
+
 static int computeoccurrenceratio(Sequentialsuffixarrayreader *ssar,
                                   GtUword minmersize,
                                   GtUword maxmersize,
@@ -216,19 +356,28 @@ static int computeoccurrenceratio(Sequentialsuffixarrayreader *ssar,
   state->uniquedistribution = uniquedistribution;
   state->nonuniquedistribution = nonuniquedistribution;
   state->nonuniquemultidistribution = nonuniquemultidistribution;
-  if (gt_depthfirstesa(ssar,
-                    occ_allocateDfsinfo,
-                    occ_freeDfsinfo,
-                    occ_processleafedge,
-                    NULL,
-                    occ_processcompletenode,
-                    occ_assignleftmostleaf,
-                    occ_assignrightmostleaf,
-                    (Dfsstate*) state,
-                    logger,
-                    err) != 0)
+  if (!ssar->scanfile && gt_jobs > 1U)
   {
-    haserr = true;
+    if (occ_depthfirstesaparts(ssar,state,gt_jobs,logger,err) != 0)
+    {
+      haserr = true;
+    }
+  } else
+  {
+    if (gt_depthfirstesa(ssar,
+                      occ_allocateDfsinfo,
+                      occ_freeDfsinfo,
+                      occ_processleafedge,
+                      NULL,
+                      occ_processcompletenode,
+                      occ_assignleftmostleaf,
+                      occ_assignrightmostleaf,
+                      (Dfsstate*) state,
+                      logger,
+                      err) != 0)
+    {
+      haserr = true;
+    }
   }
   gt_free(state);
   return haserr ? -1 : 0;
@@ -15,6 +15,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/alphabet.h"
 #include "core/fa.h"
 #include "core/unused_api.h"
@@ -22,9 +23,14 @@
 #include "core/chardef.h"
 #include "core/format64.h"
 #include "core/encseq.h"
+#include "core/xansi_api.h"
 #include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
 #include "revcompl.h"
 #include "tyr-map.h"
+#include "tyr-merhash.h"
 #include "tyr-search.h"
 #include "tyr-show.h"
 #include "tyr-mersplit.h"
@@ -33,11 +39,13 @@ typedef struct
 {
   GtUchar *bytecode,  /* buffer for encoded word to be searched */
         *rcbuf;
+  char *decodebuf;
   const GtUchar *mertable, *lastmer;
   GtUword mersize;
   unsigned int showmode,
                searchstrand;
   GtAlphabet *dnaalpha;
+  GtStr *outbuf; /* output is collected here and shown in input order */
 } Tyrsearchinfo;
 
 static void gt_tyrsearchinfo_init(Tyrsearchinfo *tyrsearchinfo,
@@ -58,6 +66,9 @@ static void gt_tyrsearchinfo_init(Tyrsearchinfo *tyrsearchinfo,
                                       * merbytes);
   tyrsearchinfo->rcbuf = gt_malloc(sizeof *tyrsearchinfo->rcbuf
                                    * tyrsearchinfo->mersize);
+  tyrsearchinfo->decodebuf = gt_malloc(sizeof *tyrsearchinfo->decodebuf
+                                       * (tyrsearchinfo->mersize + 1));
+  tyrsearchinfo->outbuf = gt_str_new();
 }
 
 static void gt_tyrsearchinfo_delete(Tyrsearchinfo *tyrsearchinfo)
@@ -67,26 +78,36 @@ static void gt_tyrsearchinfo_delete(Tyrsearchinfo *tyrsearchinfo)
     gt_alphabet_delete(tyrsearchinfo->dnaalpha);
     gt_free(tyrsearchinfo->bytecode);
     gt_free(tyrsearchinfo->rcbuf);
+    gt_free(tyrsearchinfo->decodebuf);
+    gt_str_delete(tyrsearchinfo->outbuf);
   }
 }
 
 /*@null@*/ const GtUchar *gt_searchsinglemer(const GtUchar *qptr,
                                         const Tyrindex *tyrindex,
                                         const Tyrsearchinfo *tyrsearchinfo,
-                                        const Tyrbckinfo *tyrbckinfo)
+                                        const Tyrbckinfo *tyrbckinfo,
+                                        const Tyrhashinfo *tyrhashinfo)
 {
   const GtUchar *result;
 
   gt_encseq_plainseq2bytecode(tyrsearchinfo->bytecode,qptr,
                                        tyrsearchinfo->mersize);
-  if (tyrbckinfo == NULL)
+  if (tyrhashinfo != NULL)
   {
-    result = gt_tyrindex_binmersearch(tyrindex,0,tyrsearchinfo->bytecode,
-                                   tyrsearchinfo->mertable,
-                                   tyrsearchinfo->lastmer);
+    result = gt_searchinmerhash(tyrindex,tyrhashinfo,tyrsearchinfo->bytecode);
   } else
   {
-    result = gt_searchinbuckets(tyrindex,tyrbckinfo,tyrsearchinfo->bytecode);
+    if (tyrbckinfo == NULL)
+    {
+      result = gt_tyrindex_binmersearch(tyrindex,0,tyrsearchinfo->bytecode,
+                                     tyrsearchinfo->mertable,
+                                     tyrsearchinfo->lastmer);
+    } else
+    {
+      result = gt_searchinbuckets(tyrindex,tyrbckinfo,
+                                  tyrsearchinfo->bytecode);
+    }
   }
   return result;
 }
@@ -97,7 +118,7 @@ static void gt_tyrsearchinfo_delete(Tyrsearchinfo *tyrsearchinfo)
           firstitem = false;\
         } else\
         {\
-          (void) putchar('\t');\
+          gt_str_append_char(tyrsearchinfo->outbuf,'\t');\
         }
 
 static void mermatchoutput(const Tyrindex *tyrindex,
@@ -115,31 +136,39 @@ static void mermatchoutput(const Tyrindex *tyrindex,
   queryposition = (GtUword) (qptr-query);
   if (tyrsearchinfo->showmode & SHOWQSEQNUM)
   {
-    printf(Formatuint64_t,PRINTuint64_tcast(unitnum));
+    char numbuf[32];
+
+    (void) snprintf(numbuf,sizeof numbuf,Formatuint64_t,
+                    PRINTuint64_tcast(unitnum));
+    gt_str_append_cstr(tyrsearchinfo->outbuf,numbuf);
     firstitem = false;
   }
   if (tyrsearchinfo->showmode & SHOWQPOS)
   {
     ADDTABULATOR;
-    printf("%c"GT_WU"",forward ? '+' : '-',queryposition);
+    gt_str_append_char(tyrsearchinfo->outbuf,forward ? '+' : '-');
+    gt_str_append_uword(tyrsearchinfo->outbuf,queryposition);
   }
   if (tyrsearchinfo->showmode & SHOWCOUNTS)
   {
     GtUword mernumber = gt_tyrindex_ptr2number(tyrindex,result);
     ADDTABULATOR;
-    printf(""GT_WU"",gt_tyrcountinfo_get(tyrcountinfo,mernumber));
+    gt_str_append_uword(tyrsearchinfo->outbuf,
+                        gt_tyrcountinfo_get(tyrcountinfo,mernumber));
   }
   if (tyrsearchinfo->showmode & SHOWSEQUENCE)
   {
     ADDTABULATOR;
-    gt_alphabet_decode_seq_to_fp(tyrsearchinfo->dnaalpha,
-                                 stdout,
-                                 qptr,
-                                 tyrsearchinfo->mersize);
+    gt_alphabet_decode_seq_to_cstr(tyrsearchinfo->dnaalpha,
+                                   tyrsearchinfo->decodebuf,
+                                   qptr,
+                                   tyrsearchinfo->mersize);
+    gt_str_append_cstr_nt(tyrsearchinfo->outbuf,tyrsearchinfo->decodebuf,
+                          tyrsearchinfo->mersize);
   }
   if (tyrsearchinfo->showmode & (SHOWSEQUENCE | SHOWQPOS | SHOWCOUNTS))
   {
-    (void) putchar('\n');
+    gt_str_append_char(tyrsearchinfo->outbuf,'\n');
   }
 }
 
@@ -147,10 +176,10 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
                                const Tyrcountinfo *tyrcountinfo,
                                const Tyrsearchinfo *tyrsearchinfo,
                                const Tyrbckinfo *tyrbckinfo,
+                               const Tyrhashinfo *tyrhashinfo,
                                uint64_t unitnum,
                                const GtUchar *query,
-                               GtUword querylen,
-                               GT_UNUSED const char *desc)
+                               GtUword querylen)
 {
   const GtUchar *qptr, *result;
   GtUword offset, skipvalue;
@@ -169,7 +198,8 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
       offset = tyrsearchinfo->mersize-1;
       if (tyrsearchinfo->searchstrand & STRAND_FORWARD)
       {
-        result = gt_searchsinglemer(qptr,tyrindex,tyrsearchinfo,tyrbckinfo);
+        result = gt_searchsinglemer(qptr,tyrindex,tyrsearchinfo,tyrbckinfo,
+                                    tyrhashinfo);
         if (result != NULL)
         {
           mermatchoutput(tyrindex,
@@ -188,7 +218,7 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
         gt_copy_reverse_complement(tyrsearchinfo->rcbuf,qptr,
                                    tyrsearchinfo->mersize);
         result = gt_searchsinglemer(tyrsearchinfo->rcbuf,tyrindex,
-                                    tyrsearchinfo,tyrbckinfo);
+                                    tyrsearchinfo,tyrbckinfo,tyrhashinfo);
         if (result != NULL)
         {
           mermatchoutput(tyrindex,
@@ -210,6 +240,153 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
   }
 }
 
+/* The query sequences are read in chunks of about the following number of
+   symbols. The sequences of a chunk are split into gt_jobs parts of similar
+   total length, which are searched in parallel. The output of the parts is
+   then shown in the order of the parts. */
+#define TYRSEARCHCHUNKSIZE (GtUword) (1 << 22)
+
+typedef struct
+{
+  GtUchar *sequences;
+  GtUword *startpos, *seqlen, numofsequences, allocatedsequences,
+          totallength, allocatedlength;
+  uint64_t firstunitnum;
+} Tyrquerychunk;
+
+typedef struct
+{
+  const Tyrindex *tyrindex;
+  const Tyrcountinfo *tyrcountinfo;
+  const Tyrbckinfo *tyrbckinfo;
+  const Tyrhashinfo *tyrhashinfo;
+  const Tyrquerychunk *querychunk;
+  Tyrsearchinfo tyrsearchinfo;
+  GtUword firstseq, lastseq;
+  GtThread *thread;
+} Tyrsearchthreadinfo;
+
+static void gt_tyrquerychunk_add(Tyrquerychunk *querychunk,
+                                 const GtUchar *query,
+                                 GtUword querylen)
+{
+  if (querychunk->numofsequences >= querychunk->allocatedsequences)
+  {
+    querychunk->allocatedsequences = querychunk->allocatedsequences * 1.2 +
+                                     128UL;
+    querychunk->startpos = gt_realloc(querychunk->startpos,
+                                      sizeof *querychunk->startpos *
+                                      querychunk->allocatedsequences);
+    querychunk->seqlen = gt_realloc(querychunk->seqlen,
+                                    sizeof *querychunk->seqlen *
+                                    querychunk->allocatedsequences);
+  }
+  if (querychunk->totallength + querylen > querychunk->allocatedlength)
+  {
+    querychunk->allocatedlength = querychunk->allocatedlength * 1.2 +
+                                  querylen;
+    querychunk->sequences = gt_realloc(querychunk->sequences,
+                                       sizeof *querychunk->sequences *
+                                       querychunk->allocatedlength);
+  }
+  memcpy(querychunk->sequences + querychunk->totallength,query,
+         sizeof *query * querylen);
+  querychunk->startpos[querychunk->numofsequences] = querychunk->totallength;
+  querychunk->seqlen[querychunk->numofsequences++] = querylen;
+  querychunk->totallength += querylen;
+}
+
+static void *gt_tyrsearch_thread_caller(void *data)
+{
+  Tyrsearchthreadinfo *threadinfo = (Tyrsearchthreadinfo *) data;
+  const Tyrquerychunk *querychunk = threadinfo->querychunk;
+  GtUword seqnum;
+
+  for (seqnum = threadinfo->firstseq; seqnum <= threadinfo->lastseq; seqnum++)
+  {
+    singleseqtyrsearch(threadinfo->tyrindex,
+                       threadinfo->tyrcountinfo,
+                       &threadinfo->tyrsearchinfo,
+                       threadinfo->tyrbckinfo,
+                       threadinfo->tyrhashinfo,
+                       querychunk->firstunitnum + seqnum,
+                       querychunk->sequences + querychunk->startpos[seqnum],
+                       querychunk->seqlen[seqnum]);
+  }
+  return NULL;
+}
+
+static int gt_tyrsearch_querychunk(Tyrsearchthreadinfo *th_tab,
+                                   unsigned int numofthreads,
+                                   const Tyrquerychunk *querychunk,
+                                   GT_UNUSED GtError *err)
+{
+  GtUword seqnum = 0, widthofpart, sumoflength;
+  unsigned int tp, parts = 0;
+  bool haserr = false;
+
+  if (querychunk->numofsequences == 0)
+  {
+    return 0;
+  }
+  widthofpart = querychunk->totallength/numofthreads + 1;
+  for (tp = 0; tp < numofthreads && seqnum < querychunk->numofsequences;
+       tp++)
+  {
+    th_tab[tp].firstseq = seqnum;
+    for (sumoflength = 0; seqnum < querychunk->numofsequences &&
+                          (sumoflength < widthofpart ||
+                           tp == numofthreads - 1); seqnum++)
+    {
+      sumoflength += querychunk->seqlen[seqnum];
+    }
+    th_tab[tp].lastseq = seqnum - 1;
+    th_tab[tp].querychunk = querychunk;
+    th_tab[tp].thread = NULL;
+    parts++;
+  }
+#ifdef GT_THREADS_ENABLED
+  for (tp = 1U; !haserr && tp < parts; tp++)
+  {
+    th_tab[tp].thread = gt_thread_new(gt_tyrsearch_thread_caller,
+                                      th_tab + tp,err);
+    if (th_tab[tp].thread == NULL)
+    {
+      haserr = true;
+    }
+  }
+  if (!haserr)
+  {
+    (void) gt_tyrsearch_thread_caller(th_tab);
+  }
+  for (tp = 1U; tp < parts; tp++)
+  {
+    if (th_tab[tp].thread != NULL)
+    {
+      gt_thread_join(th_tab[tp].thread);
+      gt_thread_delete(th_tab[tp].thread);
+    }
+  }
+#else
+  for (tp = 0; tp < parts; tp++)
+  {
+    (void) gt_tyrsearch_thread_caller(th_tab + tp);
+  }
+#endif
+  for (tp = 0; tp < parts; tp++)
+  {
+    GtStr *outbuf = th_tab[tp].tyrsearchinfo.outbuf;
+
+    if (!haserr)
+    {
+      gt_xfwrite(gt_str_get(outbuf),sizeof (char),
+                 (size_t) gt_str_length(outbuf),stdout);
+    }
+    gt_str_reset(outbuf);
+  }
+  return haserr ? -1 : 0;
+}
+
 int gt_tyrsearch(const char *tyrindexname,
                  const GtStrArray *queryfilenames,
                  unsigned int showmode,
@@ -221,6 +398,7 @@ int gt_tyrsearch(const char *tyrindexname,
   Tyrindex *tyrindex;
   Tyrcountinfo *tyrcountinfo = NULL;
   Tyrbckinfo *tyrbckinfo = NULL;
+  Tyrhashinfo *tyrhashinfo = NULL;
   bool haserr = false;
 
   gt_error_check(err);
@@ -256,12 +434,22 @@ int gt_tyrsearch(const char *tyrindexname,
     gt_assert(tyrindex != NULL);
     if (!gt_tyrindex_isempty(tyrindex))
     {
-      tyrbckinfo = gt_tyrbckinfo_new(tyrindexname,
-                                     gt_tyrindex_alphasize(tyrindex),
-                                     err);
-      if (tyrbckinfo == NULL)
+      if (gt_tyrhashinfo_exists(tyrindexname))
       {
-        haserr = true;
+        tyrhashinfo = gt_tyrhashinfo_new(tyrindexname,tyrindex,err);
+        if (tyrhashinfo == NULL)
+        {
+          haserr = true;
+        }
+      } else
+      {
+        tyrbckinfo = gt_tyrbckinfo_new(tyrindexname,
+                                       gt_tyrindex_alphasize(tyrindex),
+                                       err);
+        if (tyrbckinfo == NULL)
+        {
+          haserr = true;
+        }
       }
     }
   }
@@ -272,18 +460,34 @@ int gt_tyrsearch(const char *tyrindexname,
     char *desc = NULL;
     uint64_t unitnum;
     int retval;
-    Tyrsearchinfo tyrsearchinfo;
+    unsigned int tp, numofthreads = MAX(gt_jobs,1U);
+    Tyrsearchthreadinfo *th_tab;
+    Tyrquerychunk querychunk;
     GtSeqIterator *seqit;
 
     gt_assert(tyrindex != NULL);
-    gt_tyrsearchinfo_init(&tyrsearchinfo,tyrindex,showmode,searchstrand);
+    th_tab = gt_malloc(sizeof *th_tab * numofthreads);
+    for (tp = 0; tp < numofthreads; tp++)
+    {
+      th_tab[tp].tyrindex = tyrindex;
+      th_tab[tp].tyrcountinfo = tyrcountinfo;
+      th_tab[tp].tyrbckinfo = tyrbckinfo;
+      th_tab[tp].tyrhashinfo = tyrhashinfo;
+      gt_tyrsearchinfo_init(&th_tab[tp].tyrsearchinfo,tyrindex,showmode,
+                            searchstrand);
+    }
+    querychunk.sequences = NULL;
+    querychunk.startpos = querychunk.seqlen = NULL;
+    querychunk.numofsequences = querychunk.allocatedsequences = 0;
+    querychunk.totallength = querychunk.allocatedlength = 0;
+    querychunk.firstunitnum = 0;
     seqit = gt_seq_iterator_sequence_buffer_new(queryfilenames, err);
     if (!seqit)
       haserr = true;
     if (!haserr)
     {
       gt_seq_iterator_set_symbolmap(seqit,
-                                 gt_alphabet_symbolmap(tyrsearchinfo.dnaalpha));
+                     gt_alphabet_symbolmap(th_tab[0].tyrsearchinfo.dnaalpha));
       for (unitnum = 0; /* Nothing */; unitnum++)
       {
         retval = gt_seq_iterator_next(seqit,
@@ -300,18 +504,38 @@ int gt_tyrsearch(const char *tyrindexname,
         {
           break;
         }
-        singleseqtyrsearch(tyrindex,
-                           tyrcountinfo,
-                           &tyrsearchinfo,
-                           tyrbckinfo,
-                           unitnum,
-                           query,
-                           querylen,
-                           desc);
+        gt_tyrquerychunk_add(&querychunk,query,querylen);
+        if (querychunk.totallength >= TYRSEARCHCHUNKSIZE)
+        {
+          if (gt_tyrsearch_querychunk(th_tab,numofthreads,&querychunk,
+                                      err) != 0)
+          {
+            haserr = true;
+            break;
+          }
+          querychunk.numofsequences = querychunk.totallength = 0;
+          querychunk.firstunitnum = unitnum + 1;
+        }
+      }
+      if (!haserr &&
+          gt_tyrsearch_querychunk(th_tab,numofthreads,&querychunk,err) != 0)
+      {
+        haserr = true;
       }
       gt_seq_iterator_delete(seqit);
     }
-    gt_tyrsearchinfo_delete(&tyrsearchinfo);
+    for (tp = 0; tp < numofthreads; tp++)
+    {
+      gt_tyrsearchinfo_delete(&th_tab[tp].tyrsearchinfo);
+    }
+    gt_free(th_tab);
+    gt_free(querychunk.sequences);
+    gt_free(querychunk.startpos);
+    gt_free(querychunk.seqlen);
+  }
+  if (tyrhashinfo != NULL)
+  {
+    gt_tyrhashinfo_delete(&tyrhashinfo);
   }
   if (tyrbckinfo != NULL)
   {
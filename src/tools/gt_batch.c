@@ -0,0 +1,507 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+#include "core/cstr_api.h"
+#include "core/cstr_array.h"
+#include "core/fa.h"
+#include "core/ma.h"
+#include "core/resource_cache.h"
+#include "core/str.h"
+#include "core/str_array_api.h"
+#include "core/tool.h"
+#include "core/toolbox.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "gtt.h"
+#include "tools/gt_batch.h"
+
+typedef struct {
+  GtStr *capture,
+        *socket;
+  bool nocache;
+} GtBatchArguments;
+
+typedef struct {
+  GtStr *progname;
+  GtUword cmdnum;
+} GtBatchState;
+
+static void* gt_batch_arguments_new(void)
+{
+  GtBatchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  arguments->capture = gt_str_new();
+  arguments->socket = gt_str_new();
+  return arguments;
+}
+
+static void gt_batch_arguments_delete(void *tool_arguments)
+{
+  GtBatchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->capture);
+  gt_str_delete(arguments->socket);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_batch_option_parser_new(void *tool_arguments)
+{
+  GtBatchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option, *capture_option, *socket_option;
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...] [command_file]",
+                            "Run a stream of gt tool command lines inside a "
+                            "single process.\nEach line of command_file "
+                            "(default: stdin) is a tool invocation without "
+                            "the leading 'gt',\ne.g. 'seqstat foo.fas'. Empty "
+                            "lines and lines starting with '#' are ignored.");
+
+  capture_option = gt_option_new_string("capture", "write stdout and stderr of "
+                                        "the n-th command to files "
+                                        "<prefix>n.out and <prefix>n.err",
+                                        arguments->capture, NULL);
+  gt_option_parser_add_option(op, capture_option);
+
+  socket_option = gt_option_new_string("socket", "read commands from "
+                                       "connections to the local UNIX socket "
+                                       "with the given path and reply with "
+                                       "the output of each command; the "
+                                       "command 'shutdown' stops the server",
+                                       arguments->socket, NULL);
+  gt_option_parser_add_option(op, socket_option);
+  gt_option_exclude(capture_option, socket_option);
+
+  option = gt_option_new_bool("nocache", "do not keep encoded sequences and "
+                              "type checkers loaded between commands",
+                              &arguments->nocache, false);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 1U);
+  return op;
+}
+
+/* Split <line> into whitespace separated words. Words may be enclosed in
+   single or double quotes to protect whitespace. */
+static int gt_batch_split_line(GtStrArray *words, const char *line,
+                               GtError *err)
+{
+  GtStr *word = gt_str_new();
+  const char *cptr;
+  char quote = '\0';
+  bool inword = false;
+  int had_err = 0;
+
+  for (cptr = line; *cptr != '\0'; cptr++) {
+    if (quote != '\0') {
+      if (*cptr == quote)
+        quote = '\0';
+      else
+        gt_str_append_char(word, *cptr);
+    } else if (*cptr == '\'' || *cptr == '"') {
+      quote = *cptr;
+      inword = true;
+    } else if (*cptr == ' ' || *cptr == '\t' || *cptr == '\r') {
+      if (inword) {
+        gt_str_array_add(words, word);
+        gt_str_reset(word);
+        inword = false;
+      }
+    } else {
+      gt_str_append_char(word, *cptr);
+      inword = true;
+    }
+  }
+  if (quote != '\0') {
+    gt_error_set(err, "unterminated quote in command line \"%s\"", line);
+    had_err = -1;
+  } else if (inword)
+    gt_str_array_add(words, word);
+  gt_str_delete(word);
+  return had_err;
+}
+
+/* Run the tool invocation given in <words> and report errors on stderr.
+   Tools keep their parsed options and arguments, therefore every command
+   gets a fresh toolbox. */
+static int gt_batch_run_command(GtBatchState *state, GtStrArray *words)
+{
+  GtToolfunc toolfunc;
+  GtToolbox *tools = gtt_tools();
+  GtTool *tool = NULL;
+  GtError *err = gt_error_new();
+  const char **argv;
+  char **nargv = NULL;
+  const char *toolname = gt_str_array_get(words, 0);
+  GtUword idx, argc = gt_str_array_size(words);
+  int had_err = 0;
+
+  gt_error_set_progname(err, gt_str_get(state->progname));
+  if (strcmp(toolname, "batch") == 0) {
+    gt_error_set(err, "tool 'batch' cannot be run from a batch");
+    had_err = -1;
+  } else if (!gt_toolbox_has_tool(tools, toolname)) {
+    gt_error_set(err, "tool '%s' not found; option -help lists possible "
+                      "tools", toolname);
+    had_err = -1;
+  }
+  if (!had_err) {
+    argv = gt_malloc(sizeof (*argv) * (argc + 1));
+    for (idx = 0; idx < argc; idx++)
+      argv[idx] = gt_str_array_get(words, idx);
+    argv[argc] = NULL;
+    if (!(toolfunc = gt_toolbox_get(tools, toolname))) {
+      tool = gt_toolbox_get_tool(tools, toolname);
+      gt_assert(tool);
+    }
+    nargv = gt_cstr_array_prefix_first(argv, gt_str_get(state->progname));
+    gt_error_set_progname(err, nargv[0]);
+    if (toolfunc)
+      had_err = toolfunc((int) argc, (const char**) nargv, err);
+    else
+      had_err = gt_tool_run(tool, (int) argc, (const char**) nargv, err);
+    gt_cstr_array_delete(nargv);
+    gt_free(argv);
+  }
+  if (gt_error_is_set(err)) {
+    fprintf(stderr, "%s: error: %s\n", gt_error_get_progname(err),
+            gt_error_get(err));
+    had_err = -1;
+  }
+  gt_error_delete(err);
+  gt_toolbox_delete(tools);
+  return had_err;
+}
+
+/* Run the command in <words> with stdout and stderr redirected to the files
+   <outfile> and <errfile>. */
+static int gt_batch_run_captured(GtBatchState *state, GtStrArray *words,
+                                 const char *outfile, const char *errfile,
+                                 GtError *err)
+{
+  int savedout, savederr, outfd, errfd, had_err = 0, cmd_err;
+
+  gt_error_check(err);
+  if ((outfd = open(outfile, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == -1) {
+    gt_error_set(err, "cannot open file \"%s\": %s", outfile, strerror(errno));
+    return -1;
+  }
+  if ((errfd = open(errfile, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == -1) {
+    gt_error_set(err, "cannot open file \"%s\": %s", errfile, strerror(errno));
+    (void) close(outfd);
+    return -1;
+  }
+  (void) fflush(stdout);
+  (void) fflush(stderr);
+  savedout = dup(STDOUT_FILENO);
+  savederr = dup(STDERR_FILENO);
+  if (savedout == -1 || savederr == -1 ||
+      dup2(outfd, STDOUT_FILENO) == -1 || dup2(errfd, STDERR_FILENO) == -1) {
+    gt_error_set(err, "cannot redirect output: %s", strerror(errno));
+    had_err = -1;
+  }
+  (void) close(outfd);
+  (void) close(errfd);
+  if (!had_err) {
+    cmd_err = gt_batch_run_command(state, words);
+    (void) fflush(stdout);
+    (void) fflush(stderr);
+    (void) dup2(savedout, STDOUT_FILENO);
+    (void) dup2(savederr, STDERR_FILENO);
+    had_err = cmd_err ? 1 : 0;
+  }
+  if (savedout != -1)
+    (void) close(savedout);
+  if (savederr != -1)
+    (void) close(savederr);
+  return had_err;
+}
+
+/* Process a single line of input. Returns -1 on an error of the batch
+   itself, 1 if the command failed, and 0 otherwise. */
+static int gt_batch_process_line(GtBatchState *state, const char *line,
+                                 const GtBatchArguments *arguments,
+                                 GtError *err)
+{
+  GtStrArray *words = gt_str_array_new();
+  int had_err = 0;
+
+  gt_error_check(err);
+  while (*line == ' ' || *line == '\t')
+    line++;
+  if (*line == '\0' || *line == '#') {
+    gt_str_array_delete(words);
+    return 0;
+  }
+  state->cmdnum++;
+  if (gt_batch_split_line(words, line, err) != 0) {
+    fprintf(stderr, "%s: error: %s\n", gt_str_get(state->progname),
+            gt_error_get(err));
+    gt_error_unset(err);
+    had_err = 1;
+  } else if (gt_str_length(arguments->capture) > 0) {
+    GtStr *outfile = gt_str_clone(arguments->capture),
+          *errfile = gt_str_clone(arguments->capture);
+    gt_str_append_uword(outfile, state->cmdnum);
+    gt_str_append_cstr(outfile, ".out");
+    gt_str_append_uword(errfile, state->cmdnum);
+    gt_str_append_cstr(errfile, ".err");
+    had_err = gt_batch_run_captured(state, words, gt_str_get(outfile),
+                                    gt_str_get(errfile), err);
+    gt_str_delete(outfile);
+    gt_str_delete(errfile);
+  } else if (gt_batch_run_command(state, words) != 0)
+    had_err = 1;
+  gt_str_array_delete(words);
+  return had_err;
+}
+
+#ifndef _WIN32
+/* Send the content of file <filename> preceded by a header line
+   '<tag> <length>' to <fp>. */
+static int gt_batch_send_file(FILE *fp, const char *tag, const char *filename,
+                              GtError *err)
+{
+  GtStr *content = gt_str_new();
+  FILE *infp;
+  char buf[BUFSIZ];
+  size_t len;
+  int had_err = 0;
+
+  gt_error_check(err);
+  if (!(infp = gt_fa_fopen(filename, "rb", err)))
+    had_err = -1;
+  else {
+    while ((len = fread(buf, 1, sizeof buf, infp)) > 0)
+      gt_str_append_cstr_nt(content, buf, (GtUword) len);
+    gt_fa_fclose(infp);
+    fprintf(fp, "%s "GT_WU"\n", tag, gt_str_length(content));
+    (void) fwrite(gt_str_get_mem(content), 1, (size_t) gt_str_length(content),
+                  fp);
+  }
+  gt_str_delete(content);
+  return had_err;
+}
+
+/* Serve the commands sent over connection <connfd>. For each command the
+   reply consists of the captured stdout and stderr, each preceded by a
+   header line 'stdout <length>' and 'stderr <length>', and a final line
+   'exit <status>'. Sets <shutdown> if the client requested it. */
+static int gt_batch_serve_connection(GtBatchState *state, int connfd,
+                                     const char *tmpprefix, bool *shutdown,
+                                     GtError *err)
+{
+  GtStr *line = gt_str_new(),
+        *outfile = gt_str_new_cstr(tmpprefix),
+        *errfile = gt_str_new_cstr(tmpprefix);
+  FILE *infp, *outfp;
+  int had_err = 0, wfd;
+
+  gt_error_check(err);
+  gt_str_append_cstr(outfile, "out");
+  gt_str_append_cstr(errfile, "err");
+  wfd = dup(connfd);
+  infp = fdopen(connfd, "r");
+  outfp = wfd != -1 ? fdopen(wfd, "w") : NULL;
+  if (!infp || !outfp) {
+    gt_error_set(err, "cannot open connection: %s", strerror(errno));
+    had_err = -1;
+  }
+  while (!had_err && gt_str_read_next_line(line, infp) != EOF) {
+    const char *cmd = gt_str_get(line);
+    int status;
+
+    if (strcmp(cmd, "shutdown") == 0) {
+      *shutdown = true;
+      break;
+    }
+    {
+      GtStrArray *words = gt_str_array_new();
+      while (*cmd == ' ' || *cmd == '\t')
+        cmd++;
+      if (*cmd == '\0' || *cmd == '#')
+        status = -2;
+      else if (gt_batch_split_line(words, cmd, err) != 0) {
+        fprintf(outfp, "stdout 0\nstderr "GT_WU"\n%s\n",
+                (GtUword) strlen(gt_error_get(err)) + 1, gt_error_get(err));
+        gt_error_unset(err);
+        status = 1;
+      } else {
+        state->cmdnum++;
+        status = gt_batch_run_captured(state, words, gt_str_get(outfile),
+                                       gt_str_get(errfile), err);
+        if (status >= 0) {
+          had_err = gt_batch_send_file(outfp, "stdout", gt_str_get(outfile),
+                                       err);
+          if (!had_err)
+            had_err = gt_batch_send_file(outfp, "stderr", gt_str_get(errfile),
+                                         err);
+        } else
+          had_err = -1;
+      }
+      gt_str_array_delete(words);
+    }
+    if (!had_err && status != -2) {
+      fprintf(outfp, "exit %d\n", status);
+      (void) fflush(outfp);
+    }
+    gt_str_reset(line);
+  }
+  if (infp)
+    (void) fclose(infp);
+  else
+    (void) close(connfd);
+  if (outfp)
+    (void) fclose(outfp);
+  else if (wfd != -1)
+    (void) close(wfd);
+  (void) unlink(gt_str_get(outfile));
+  (void) unlink(gt_str_get(errfile));
+  gt_str_delete(line);
+  gt_str_delete(outfile);
+  gt_str_delete(errfile);
+  return had_err;
+}
+
+static int gt_batch_serve(GtBatchState *state, const char *socketpath,
+                          GtError *err)
+{
+  struct sockaddr_un addr;
+  GtStr *tmpprefix = gt_str_new_cstr(socketpath);
+  bool shutdown = false;
+  int listenfd, had_err = 0;
+
+  gt_error_check(err);
+  if (strlen(socketpath) >= sizeof (addr.sun_path)) {
+    gt_error_set(err, "socket path \"%s\" is too long", socketpath);
+    gt_str_delete(tmpprefix);
+    return -1;
+  }
+  gt_str_append_cstr(tmpprefix, ".capture.");
+  memset(&addr, 0, sizeof addr);
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, socketpath);
+  if ((listenfd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1) {
+    gt_error_set(err, "cannot create socket: %s", strerror(errno));
+    had_err = -1;
+  }
+  if (!had_err) {
+    (void) unlink(socketpath);
+    if (bind(listenfd, (struct sockaddr*) &addr, sizeof addr) == -1 ||
+        listen(listenfd, 8) == -1) {
+      gt_error_set(err, "cannot listen on socket \"%s\": %s", socketpath,
+                   strerror(errno));
+      had_err = -1;
+    }
+  }
+  while (!had_err && !shutdown) {
+    int connfd = accept(listenfd, NULL, NULL);
+    if (connfd == -1) {
+      if (errno == EINTR)
+        continue;
+      gt_error_set(err, "cannot accept connection: %s", strerror(errno));
+      had_err = -1;
+    } else
+      had_err = gt_batch_serve_connection(state, connfd,
+                                          gt_str_get(tmpprefix), &shutdown,
+                                          err);
+  }
+  if (listenfd != -1) {
+    (void) close(listenfd);
+    (void) unlink(socketpath);
+  }
+  gt_str_delete(tmpprefix);
+  return had_err;
+}
+#endif
+
+static int gt_batch_runner(int argc, const char **argv, int parsed_args,
+                           void *tool_arguments, GtError *err)
+{
+  GtBatchArguments *arguments = tool_arguments;
+  GtBatchState state;
+  bool cache_enabled = gt_resource_cache_enabled();
+  int had_err = 0, failed = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+  state.progname = gt_str_new();
+  gt_str_append_cstr_nt(state.progname, argv[0],
+                        gt_cstr_length_up_to_char(argv[0], ' '));
+  state.cmdnum = 0;
+  if (!arguments->nocache)
+    gt_resource_cache_enable();
+
+  if (gt_str_length(arguments->socket) > 0) {
+#ifndef _WIN32
+    if (parsed_args < argc) {
+      gt_error_set(err, "option -socket excludes a command file");
+      had_err = -1;
+    } else
+      had_err = gt_batch_serve(&state, gt_str_get(arguments->socket), err);
+#else
+    gt_error_set(err, "option -socket is not supported on this platform");
+    had_err = -1;
+#endif
+  } else {
+    GtStr *line = gt_str_new();
+    FILE *infp = stdin;
+
+    if (parsed_args < argc && strcmp(argv[parsed_args], "-") != 0) {
+      if (!(infp = gt_fa_fopen(argv[parsed_args], "r", err)))
+        had_err = -1;
+    }
+    while (!had_err && gt_str_read_next_line(line, infp) != EOF) {
+      int rval = gt_batch_process_line(&state, gt_str_get(line), arguments,
+                                       err);
+      if (rval < 0)
+        had_err = -1;
+      else if (rval > 0)
+        failed++;
+      gt_str_reset(line);
+    }
+    if (infp != stdin)
+      gt_fa_fclose(infp);
+    gt_str_delete(line);
+    if (!had_err && failed > 0) {
+      gt_error_set(err, "%d of "GT_WU" commands failed", failed,
+                   state.cmdnum);
+      had_err = -1;
+    }
+  }
+
+  if (!cache_enabled)
+    gt_resource_cache_disable();
+  gt_str_delete(state.progname);
+  return had_err;
+}
+
+GtTool* gt_batch(void)
+{
+  return gt_tool_new(gt_batch_arguments_new,
+                     gt_batch_arguments_delete,
+                     gt_batch_option_parser_new,
+                     NULL,
+                     gt_batch_runner);
+}
@@ -18,7 +18,7 @@
 #include "core/ma.h"
 #include "core/option_api.h"
 #include "core/output_file_api.h"
-#include "core/unused_api.h"
+#include "extended/binary_in_stream.h"
 #include "extended/cds_stream_api.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_in_stream.h"
@@ -34,6 +34,7 @@ typedef struct {
   bool start_codon,
        final_stop_codon,
        generic_start_codons,
+       binaryin,
        verbose;
   GtSeqid2FileInfo *s2fi;
   GtOutputFileInfo *ofi;
@@ -94,6 +95,12 @@ static GtOptionParser* gt_cds_option_parser_new(void *tool_arguments)
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
+  /* -binaryin */
+  option = gt_option_new_bool("binaryin", "read a binary node stream (as "
+                              "written by gt gff3 -binaryout) instead of a "
+                              "GFF3 file", &arguments->binaryin, false);
+  gt_option_parser_add_option(op, option);
+
   /* -seqfile, -matchdesc, -usedesc and -regionmapping */
   gt_seqid2file_register_options(op, arguments->s2fi);
 
@@ -110,7 +117,7 @@ static GtOptionParser* gt_cds_option_parser_new(void *tool_arguments)
   return op;
 }
 
-static int gt_cds_runner(GT_UNUSED int argc, const char **argv, int parsed_args,
+static int gt_cds_runner(int argc, const char **argv, int parsed_args,
                          void *tool_arguments, GtError *err)
 {
   GtNodeStream *gff3_in_stream, *cds_stream = NULL, *gff3_out_stream = NULL;
@@ -121,10 +128,16 @@ static int gt_cds_runner(GT_UNUSED int argc, const char **argv, int parsed_args,
   gt_error_check(err);
   gt_assert(arguments);
 
-  /* create gff3 input stream */
-  gff3_in_stream = gt_gff3_in_stream_new_sorted(argv[parsed_args]);
-  if (arguments->verbose && arguments->outfp)
-    gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
+  /* create input stream */
+  if (arguments->binaryin) {
+    gff3_in_stream = gt_binary_in_stream_new(argc - parsed_args,
+                                             argv + parsed_args);
+  }
+  else {
+    gff3_in_stream = gt_gff3_in_stream_new_sorted(argv[parsed_args]);
+    if (arguments->verbose && arguments->outfp)
+      gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
+  }
 
   /* create region mapping */
   region_mapping = gt_seqid2file_region_mapping_new(arguments->s2fi, err);
@@ -36,6 +36,7 @@ typedef struct {
   GtStr                 *indexname;
   GtXdropArbitraryscores scores;
   GtUword                minalignlength,
+                         batch_length,
                          cutoff_value,
                          fraction,
                          initsize;
@@ -151,6 +152,17 @@ gt_condenseq_compress_option_parser_new(void *tool_arguments)
   gt_option_is_extended_option(option);
   gt_option_parser_add_option(op, option);
 
+  /* -batchlength */
+  option = gt_option_new_uword("batchlength",
+                               "compress the sequences in batches of at least "
+                               "this many residues, the sequences of a batch "
+                               "are compressed in parallel (see option -j of "
+                               "gt) against the uniques found before the "
+                               "batch, which can reduce the compression. "
+                               "0 processes one sequence after the other.",
+                               &arguments->batch_length, 0);
+  gt_option_parser_add_option(op, option);
+
   /* -mat */
   option = gt_option_new_int("mat",
                              "matchscore for extension-alignment, "
@@ -395,6 +407,7 @@ static int gt_condenseq_compress_runner(GT_UNUSED int argc, const char **argv,
       if (arguments->clean_percent != GT_UNDEF_UINT)
         gt_condenseq_creator_set_diags_clean_limit(ces_c,
                                                    arguments->clean_percent);
+      gt_condenseq_creator_set_batch_length(ces_c, arguments->batch_length);
 
       had_err = gt_condenseq_creator_create(ces_c,
                                             arguments->indexname,
@@ -0,0 +1,934 @@
+/*
+  Copyright (c) 2017 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/alphabet_api.h"
+#include "core/arraydef.h"
+#include "core/codetype.h"
+#include "core/divmodmul.h"
+#include "core/encseq_api.h"
+#include "core/logger.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/output_file_api.h"
+#include "core/range.h"
+#include "core/safearith.h"
+#include "core/seq_iterator_sequence_buffer_api.h"
+#include "core/showtime.h"
+#include "core/str_array_api.h"
+#include "core/timer_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "extended/condenseq.h"
+#include "extended/kmer_database.h"
+#include "extended/multieoplist.h"
+#include "extended/rbtree.h"
+#include "match/seqabstract.h"
+#include "match/xdrop.h"
+
+#include "extended/condenseq_search_arguments.h"
+#include "tools/gt_condenseq_kmersearch.h"
+
+/* Karlin-Altschul parameter K is not derived from the scores but fixed to a
+   value typical for nucleotide scoring schemes, so e-values are estimates. */
+#define GT_CES_KMER_K 0.1
+
+/* the coarse search uses the default scores of condenseq compress, to find the
+   uniques the links were aligned to */
+static const GtXdropArbitraryscores gt_ces_kmer_coarse_scores = {2, -1, -2, -2};
+#define GT_CES_KMER_COARSE_XDROP ((GtXdropscore) 3)
+
+typedef struct {
+  GtFile                     *outfp;
+  GtOutputFileInfo           *ofi;
+  GtCondenseqSearchArguments *csa;
+  GtStr                      *querypath;
+  GtXdropArbitraryscores      scores;
+  GtWord                      xdrop;
+  GtUword                     alignlength,
+                              cutoff;
+  double                      evalue;
+  unsigned int                kmersize;
+} GtCondenseqKmersearchArguments;
+
+typedef struct {
+  GtCodetype code;
+  GtUword    pos;
+} GtCesKmer;
+
+GT_DECLAREARRAYSTRUCT(GtCesKmer);
+
+/* <spos> is the start of the kmer in the subject, <sid> the unique id for the
+   coarse search */
+typedef struct {
+  GtUword spos,
+          qpos,
+          sid;
+} GtCesKmerSeed;
+
+GT_DECLAREARRAYSTRUCT(GtCesKmerSeed);
+
+/* ranges are inclusive */
+typedef struct {
+  GtRange      srange,
+               qrange;
+  GtUword      sid,
+               matches,
+               columns;
+  GtXdropscore score;
+} GtCesKmerHit;
+
+GT_DECLAREARRAYSTRUCT(GtCesKmerHit);
+
+typedef struct {
+  GtRange range;
+  GtUword seqid;
+} GtCesKmerRange;
+
+GT_DECLAREARRAYSTRUCT(GtCesKmerRange);
+
+typedef struct {
+  GtCondenseqKmersearchArguments *args;
+  GtCondenseq                    *ces;
+  GtEncseq                       *unique_es;
+  GtKmerDatabase                 *kdb;
+  GtLogger                       *logger;
+  GtXdropresources               *left_res,
+                                 *right_res,
+                                 *coarse_left_res,
+                                 *coarse_right_res,
+                                 *fine_left_res,
+                                 *fine_right_res;
+  GtSeqabstract                  *s_fwd,
+                                 *s_bwd,
+                                 *q_fwd,
+                                 *q_bwd;
+  GtRBTree                       *to_extract_rbt;
+  const GtUchar                  *subject;
+  GtUchar                        *revcompl;
+  GtArrayGtCesKmer                qkmers,
+                                  skmers;
+  GtArrayGtCesKmerSeed            seeds;
+  GtArrayGtCesKmerHit             hits;
+  GtArrayGtCesKmerRange           sorted;
+  GtStr                          *qseqid;
+  GtCodetype                      maxcode;
+  GtXdropscore                    xdrop;
+  GtUword                         dblen,
+                                  numofhits,
+                                  revcompl_size;
+  double                          lambda;
+  unsigned int                    numofchars;
+  bool                            coarse,
+                                  dna;
+} GtCesKmerInfo;
+
+static void* gt_condenseq_kmersearch_arguments_new(void)
+{
+  GtCondenseqKmersearchArguments *arguments =
+    gt_calloc((size_t) 1, sizeof *arguments);
+  arguments->csa = gt_condenseq_search_arguments_new();
+  arguments->ofi = gt_output_file_info_new();
+  arguments->querypath = gt_str_new();
+  return arguments;
+}
+
+static void gt_condenseq_kmersearch_arguments_delete(void *tool_arguments)
+{
+  GtCondenseqKmersearchArguments *arguments = tool_arguments;
+  if (arguments != NULL) {
+    gt_condenseq_search_arguments_delete(arguments->csa);
+    gt_file_delete(arguments->outfp);
+    gt_output_file_info_delete(arguments->ofi);
+    gt_str_delete(arguments->querypath);
+    gt_free(arguments);
+  }
+}
+
+static GtOptionParser*
+gt_condenseq_kmersearch_option_parser_new(void *tool_arguments)
+{
+  GtCondenseqKmersearchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...] -db <archive> -query <query>",
+                            "Search the given compressed database without "
+                            "external tools, using kmer seeds and xdrop "
+                            "extensions. Output similar to blast -outfmt 6.");
+
+  gt_condenseq_search_register_options(arguments->csa, op);
+
+  /* -query */
+  option = gt_option_new_filename("query", "path of fasta query file",
+                                  arguments->querypath);
+  gt_option_is_mandatory(option);
+  gt_option_parser_add_option(op, option);
+
+  /* -kmersize */
+  option = gt_option_new_uint_min("kmersize",
+                                  "kmer-size used for the seeds, default "
+                                  "depends on alphabet size",
+                                  &arguments->kmersize, GT_UNDEF_UINT, 2U);
+  gt_option_parser_add_option(op, option);
+
+  /* -alignlength */
+  option = gt_option_new_uword_min("alignlength",
+                                   "required minimal length of an "
+                                   "xdrop-alignment on the query",
+                                   &arguments->alignlength, (GtUword) 30,
+                                   (GtUword) 1);
+  gt_option_parser_add_option(op, option);
+
+  /* -evalue */
+  option = gt_option_new_double("evalue", "e-value threshold for the hits "
+                                "reported by the fine search",
+                                &arguments->evalue, 10.0);
+  gt_option_parser_add_option(op, option);
+
+  /* -cutoff */
+  option = gt_option_new_uword("cutoff",
+                               "if a kmer is found more often than this value "
+                               "in the uniques it will be ignored for the "
+                               "coarse search, 0 disables the cutoff",
+                               &arguments->cutoff, 0);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
+  /* -mat */
+  option = gt_option_new_int("mat",
+                             "matchscore for extension-alignment, "
+                             "requirements: mat > mis, mat > 2ins, mat > 2del",
+                             &arguments->scores.mat, 1);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
+  /* -mis */
+  option = gt_option_new_int("mis",
+                             "mismatchscore for extension-alignment, ",
+                             &arguments->scores.mis, -2);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
+  /* -ins */
+  option = gt_option_new_int("ins",
+                             "insertionscore for extension-alignment",
+                             &arguments->scores.ins, -3);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
+  /* -del */
+  option = gt_option_new_int("del",
+                             "deletionscore for extension-alignment",
+                             &arguments->scores.del, -3);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
+  /* -xdrop */
+  option = gt_option_new_word("xdrop",
+                              "xdrop score for extension-alignment",
+                              &arguments->xdrop, (GtWord) 10);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
+  gt_output_file_info_register_options(arguments->ofi, op, &arguments->outfp);
+
+  return op;
+}
+
+static int gt_condenseq_kmersearch_arguments_check(GT_UNUSED int rest_argc,
+                                                   void *tool_arguments,
+                                                   GtError *err)
+{
+  GtCondenseqKmersearchArguments *arguments = tool_arguments;
+  GtXdropArbitraryscores *scores;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  scores = &arguments->scores;
+  if (scores->mat <= 0 || scores->mat < scores->mis ||
+      scores->mat < 2 * scores->ins || scores->mat < 2 * scores->del) {
+    gt_error_set(err, "scores have to satisfy mat > 0, mat >= mis, "
+                 "mat >= 2ins and mat >= 2del");
+    had_err = -1;
+  }
+  /* the xdrop extension does not handle mismatches costing more than an
+     insertion or deletion */
+  if (!had_err &&
+      (2 * (scores->mat - scores->mis) > scores->mat - 2 * scores->ins ||
+       2 * (scores->mat - scores->mis) > scores->mat - 2 * scores->del)) {
+    gt_error_set(err, "scores have to satisfy mat - mis <= mat/2 - ins and "
+                 "mat - mis <= mat/2 - del");
+    had_err = -1;
+  }
+  return had_err;
+}
+
+/* solves p e^(lambda mat) + (1 - p) e^(lambda mis) = 1 for lambda > 0, with
+   p = 1/<numofchars> being the probability of a match for uniformly distributed
+   characters. */
+static double gt_ces_kmer_lambda(const GtXdropArbitraryscores *scores,
+                                 unsigned int numofchars)
+{
+  const double p = 1.0 / numofchars;
+  double low, high;
+  int iter;
+
+#define GT_CES_KMER_F(L) \
+  (p * exp((L) * scores->mat) + (1.0 - p) * exp((L) * scores->mis) - 1.0)
+
+  high = 1.0;
+  while (GT_CES_KMER_F(high) <= 0.0)
+    high *= 2.0;
+  low = high / 2.0;
+  /* f is convex with f(0) = 0 and f'(0) < 0, so the root is in (0, high] */
+  while (low > 1e-6 && GT_CES_KMER_F(low) > 0.0)
+    low /= 2.0;
+  for (iter = 0; iter < 60; iter++) {
+    double mid = (low + high) / 2.0;
+    if (GT_CES_KMER_F(mid) > 0.0)
+      high = mid;
+    else
+      low = mid;
+  }
+#undef GT_CES_KMER_F
+  return (low + high) / 2.0;
+}
+
+static inline double gt_ces_kmer_bitscore(const GtCesKmerInfo *info,
+                                          GtXdropscore score)
+{
+  return (info->lambda * score - log(GT_CES_KMER_K)) / M_LN2;
+}
+
+static inline double gt_ces_kmer_evalue(const GtCesKmerInfo *info,
+                                        GtUword qlen, double bitscore)
+{
+  return (double) info->dblen * qlen * pow(2.0, -bitscore);
+}
+
+/* appends all kmers of <seq> not containing wildcards to <kmers> */
+static void gt_ces_kmer_collect(const GtCesKmerInfo *info,
+                                const GtUchar *seq, GtUword len,
+                                GtArrayGtCesKmer *kmers)
+{
+  GtCodetype code = 0;
+  GtUword idx, valid = 0;
+  const GtUword kmersize = (GtUword) info->args->kmersize;
+
+  kmers->nextfreeGtCesKmer = 0;
+  for (idx = 0; idx < len; idx++) {
+    if (seq[idx] >= (GtUchar) info->numofchars) {
+      valid = 0;
+      code = 0;
+      continue;
+    }
+    code = (code * info->numofchars + seq[idx]) % info->maxcode;
+    if (++valid >= kmersize) {
+      GtCesKmer kmer;
+      kmer.code = code;
+      kmer.pos = idx + 1 - kmersize;
+      GT_STOREINARRAY(kmers, GtCesKmer, 256, kmer);
+    }
+  }
+}
+
+static int gt_ces_kmer_compare(const void *a, const void *b)
+{
+  const GtCesKmer *ka = a, *kb = b;
+  if (ka->code != kb->code)
+    return ka->code < kb->code ? -1 : 1;
+  if (ka->pos != kb->pos)
+    return ka->pos < kb->pos ? -1 : 1;
+  return 0;
+}
+
+static int gt_ces_kmer_seed_compare(const void *a, const void *b)
+{
+  const GtCesKmerSeed *sa = a, *sb = b;
+  /* diagonals are compared as spos - qpos */
+  if (sa->sid != sb->sid)
+    return sa->sid < sb->sid ? -1 : 1;
+  if (sa->spos + sb->qpos != sb->spos + sa->qpos)
+    return sa->spos + sb->qpos < sb->spos + sa->qpos ? -1 : 1;
+  if (sa->qpos != sb->qpos)
+    return sa->qpos < sb->qpos ? -1 : 1;
+  return 0;
+}
+
+static int gt_ces_kmer_hit_score_compare(const void *a, const void *b)
+{
+  const GtCesKmerHit *ha = a, *hb = b;
+  if (ha->score != hb->score)
+    return ha->score > hb->score ? -1 : 1;
+  if (ha->srange.start != hb->srange.start)
+    return ha->srange.start < hb->srange.start ? -1 : 1;
+  if (ha->qrange.start != hb->qrange.start)
+    return ha->qrange.start < hb->qrange.start ? -1 : 1;
+  return 0;
+}
+
+static int gt_ces_kmer_hit_pos_compare(const void *a, const void *b)
+{
+  const GtCesKmerHit *ha = a, *hb = b;
+  if (ha->srange.start != hb->srange.start)
+    return ha->srange.start < hb->srange.start ? -1 : 1;
+  if (ha->qrange.start != hb->qrange.start)
+    return ha->qrange.start < hb->qrange.start ? -1 : 1;
+  return 0;
+}
+
+static void gt_ces_kmer_count_matches(const GtXdropresources *res,
+                                      const GtXdropbest *best,
+                                      GtCesKmerHit *hit)
+{
+  GtMultieoplist *eops = gt_xdrop_backtrack(res, best);
+  GtUword idx;
+  for (idx = 0; idx < gt_multieoplist_get_num_entries(eops); idx++) {
+    GtMultieop eop = gt_multieoplist_get_entry(eops, idx);
+    if (eop.type == Match || eop.type == Replacement)
+      hit->matches += eop.steps;
+    hit->columns += eop.steps;
+  }
+  gt_multieoplist_delete(eops);
+}
+
+/* extends <seed> within the subject range <sbounds> (end exclusive) and the
+   query <qseq> */
+static void gt_ces_kmer_xdrop(GtCesKmerInfo *info,
+                              const GtCesKmerSeed *seed,
+                              GtRange sbounds,
+                              const GtUchar *qseq,
+                              GtUword qlen,
+                              GtXdropbest *left,
+                              GtXdropbest *right)
+{
+  const bool forward = true;
+  GtXdropbest empty = {0,0,0,0,0};
+
+  *left = *right = empty;
+  if (seed->qpos > 0 && seed->spos > sbounds.start) {
+    if (info->subject == NULL)
+      gt_seqabstract_reinit_encseq(!forward, GT_READMODE_FORWARD, info->s_bwd,
+                                   info->unique_es,
+                                   seed->spos - sbounds.start, sbounds.start);
+    else
+      gt_seqabstract_reinit_gtuchar(!forward, GT_READMODE_FORWARD, info->s_bwd,
+                                    info->subject,
+                                    seed->spos - sbounds.start, sbounds.start,
+                                    sbounds.end);
+    gt_seqabstract_reinit_gtuchar(!forward, GT_READMODE_FORWARD, info->q_bwd,
+                                  qseq, seed->qpos, 0, qlen);
+    gt_evalxdroparbitscoresextend(!forward, left, info->left_res,
+                                  info->s_bwd, info->q_bwd, info->xdrop);
+  }
+  if (info->subject == NULL)
+    gt_seqabstract_reinit_encseq(forward, GT_READMODE_FORWARD, info->s_fwd,
+                                 info->unique_es,
+                                 sbounds.end - seed->spos, seed->spos);
+  else
+    gt_seqabstract_reinit_gtuchar(forward, GT_READMODE_FORWARD, info->s_fwd,
+                                  info->subject,
+                                  sbounds.end - seed->spos, seed->spos,
+                                  sbounds.end);
+  gt_seqabstract_reinit_gtuchar(forward, GT_READMODE_FORWARD, info->q_fwd,
+                                qseq, qlen - seed->qpos, seed->qpos, qlen);
+  gt_evalxdroparbitscoresextend(forward, right, info->right_res,
+                                info->s_fwd, info->q_fwd, info->xdrop);
+}
+
+/* extends all seeds, seeds on the same diagonal covered by a previous
+   extension are skipped. Accepted alignments are stored in <info->hits> */
+static void gt_ces_kmer_extend_seeds(GtCesKmerInfo *info,
+                                     const GtUchar *qseq,
+                                     GtUword qlen,
+                                     GtUword subjectlen)
+{
+  GtUword idx;
+  const GtCesKmerSeed *last = NULL;
+  GtUword last_qend = 0;
+
+  info->hits.nextfreeGtCesKmerHit = 0;
+  qsort(info->seeds.spaceGtCesKmerSeed, info->seeds.nextfreeGtCesKmerSeed,
+        sizeof (GtCesKmerSeed), gt_ces_kmer_seed_compare);
+  for (idx = 0; idx < info->seeds.nextfreeGtCesKmerSeed; idx++) {
+    const GtCesKmerSeed *seed = info->seeds.spaceGtCesKmerSeed + idx;
+    GtXdropbest left, right;
+    GtRange sbounds;
+    GtCesKmerHit hit;
+
+    if (last != NULL && last->sid == seed->sid &&
+        last->spos + seed->qpos == seed->spos + last->qpos &&
+        seed->qpos + info->args->kmersize - 1 <= last_qend)
+      continue;
+    if (info->coarse) {
+      sbounds.start = gt_encseq_seqstartpos(info->unique_es, seed->sid);
+      sbounds.end = sbounds.start + gt_encseq_seqlength(info->unique_es,
+                                                        seed->sid);
+    }
+    else {
+      sbounds.start = 0;
+      sbounds.end = subjectlen;
+    }
+    gt_ces_kmer_xdrop(info, seed, sbounds, qseq, qlen, &left, &right);
+    last = seed;
+    last_qend = seed->qpos + right.jvalue - 1;
+    if (left.jvalue + right.jvalue < info->args->alignlength ||
+        left.score + right.score <= 0)
+      continue;
+
+    hit.srange.start = seed->spos - left.ivalue - sbounds.start;
+    hit.srange.end = seed->spos + right.ivalue - 1 - sbounds.start;
+    hit.qrange.start = seed->qpos - left.jvalue;
+    hit.qrange.end = last_qend;
+    hit.sid = seed->sid;
+    hit.score = left.score + right.score;
+    hit.matches = hit.columns = 0;
+    if (!info->coarse) {
+      double bits = gt_ces_kmer_bitscore(info, hit.score);
+      if (gt_ces_kmer_evalue(info, qlen, bits) > info->args->evalue)
+        continue;
+      if (left.ivalue > 0 || left.jvalue > 0)
+        gt_ces_kmer_count_matches(info->left_res, &left, &hit);
+      gt_ces_kmer_count_matches(info->right_res, &right, &hit);
+    }
+    GT_STOREINARRAY(&info->hits, GtCesKmerHit, 64, hit);
+  }
+}
+
+static int gt_ces_kmer_range_compare(const void *a, const void *b,
+                                     GT_UNUSED void *data)
+{
+  const GtCesKmerRange *rangeA = a,
+        *rangeB = b;
+
+  if (rangeA->seqid != rangeB->seqid)
+    return rangeA->seqid < rangeB->seqid ? -1 : 1;
+  if (rangeA->range.start != rangeB->range.start)
+    return rangeA->range.start < rangeB->range.start ? -1 : 1;
+  if (rangeA->range.end != rangeB->range.end)
+    return rangeA->range.end < rangeB->range.end ? -1 : 1;
+  return 0;
+}
+
+static void gt_ces_kmer_range_free(void *range)
+{
+  gt_free(range);
+}
+
+static int gt_ces_kmer_process_range(void *data,
+                                     GtUword seqid,
+                                     GtRange seqrange,
+                                     GT_UNUSED GtError *err)
+{
+  GtCesKmerInfo *info = data;
+  bool nodecreated;
+  GtCesKmerRange *key = gt_malloc(sizeof (*key));
+
+  key->range = seqrange;
+  key->seqid = seqid;
+  key = gt_rbtree_search(info->to_extract_rbt, key, &nodecreated);
+  if (!nodecreated)
+    gt_free(key);
+  return 0;
+}
+
+/* find alignments of <qseq> in the uniques and collect the corresponding
+   redundant ranges joined by overlap in <info->sorted> */
+static int gt_ces_kmer_coarse(GtCesKmerInfo *info,
+                              const GtUchar *qseq,
+                              GtUword qlen,
+                              GtError *err)
+{
+  int had_err = 0;
+  GtUword idx;
+  GtRBTreeIter *iter;
+  GtCesKmerRange *key;
+
+  info->seeds.nextfreeGtCesKmerSeed = 0;
+  for (idx = 0; idx < info->qkmers.nextfreeGtCesKmer; idx++) {
+    const GtCesKmer *kmer = info->qkmers.spaceGtCesKmer + idx;
+    GtKmerStartpos positions = gt_kmer_database_get_startpos(info->kdb,
+                                                             kmer->code);
+    GtUword pidx;
+    for (pidx = 0; pidx < positions.no_positions; pidx++) {
+      GtCesKmerSeed seed;
+      seed.spos = positions.startpos[pidx];
+      seed.qpos = kmer->pos;
+      seed.sid = positions.unique_ids[pidx];
+      GT_STOREINARRAY(&info->seeds, GtCesKmerSeed, 256, seed);
+    }
+  }
+  info->coarse = true;
+  info->subject = NULL;
+  info->left_res = info->coarse_left_res;
+  info->right_res = info->coarse_right_res;
+  info->xdrop = GT_CES_KMER_COARSE_XDROP;
+  gt_ces_kmer_extend_seeds(info, qseq, qlen, 0);
+
+  for (idx = 0; !had_err && idx < info->hits.nextfreeGtCesKmerHit; idx++) {
+    const GtCesKmerHit *hit = info->hits.spaceGtCesKmerHit + idx;
+    /* the unaligned ends of the query and some slack for indels */
+    GtUword left_ex = hit->qrange.start + GT_DIV2(qlen),
+            right_ex = qlen - 1 - hit->qrange.end + GT_DIV2(qlen);
+    if (gt_condenseq_each_redundant_range(info->ces, hit->sid, hit->srange,
+                                          left_ex, right_ex,
+                                          gt_ces_kmer_process_range, info,
+                                          err) == 0)
+      had_err = -1;
+  }
+
+  info->sorted.nextfreeGtCesKmerRange = 0;
+  iter = gt_rbtree_iter_new_from_first(info->to_extract_rbt);
+  key = gt_rbtree_iter_data(iter);
+  while (key != NULL) {
+    GtArrayGtCesKmerRange *sorted = &info->sorted;
+    GtCesKmerRange *last = sorted->nextfreeGtCesKmerRange != 0 ?
+      sorted->spaceGtCesKmerRange + sorted->nextfreeGtCesKmerRange - 1 :
+      NULL;
+    if (last != NULL && key->seqid == last->seqid &&
+        gt_range_overlap(&key->range, &last->range))
+      last->range = gt_range_join(&last->range, &key->range);
+    else
+      GT_STOREINARRAY(sorted, GtCesKmerRange, 128, *key);
+    key = gt_rbtree_iter_next(iter);
+  }
+  gt_rbtree_iter_delete(iter);
+  gt_rbtree_clear(info->to_extract_rbt);
+  return had_err;
+}
+
+/* align <qseq> to the extracted ranges in <info->sorted> and print the hits,
+   <reverse> denotes that <qseq> is the reverse complement of the query */
+static void gt_ces_kmer_fine(GtCesKmerInfo *info,
+                             const GtUchar *qseq,
+                             GtUword qlen,
+                             bool reverse)
+{
+  GtUword ridx;
+
+  qsort(info->qkmers.spaceGtCesKmer, info->qkmers.nextfreeGtCesKmer,
+        sizeof (GtCesKmer), gt_ces_kmer_compare);
+  info->coarse = false;
+  info->left_res = info->fine_left_res;
+  info->right_res = info->fine_right_res;
+  info->xdrop = (GtXdropscore) info->args->xdrop;
+  for (ridx = 0; ridx < info->sorted.nextfreeGtCesKmerRange; ridx++) {
+    const GtCesKmerRange *range = info->sorted.spaceGtCesKmerRange + ridx;
+    GtUword subjectlen = gt_range_length(&range->range),
+            qidx = 0, sidx, hidx, kept = 0, seqstart, desclen;
+    const GtCesKmer *qkmers = info->qkmers.spaceGtCesKmer,
+                    *skmers;
+    const char *desc;
+
+    info->subject = gt_condenseq_extract_encoded_range(info->ces,
+                                                       range->range);
+    gt_ces_kmer_collect(info, info->subject, subjectlen, &info->skmers);
+    skmers = info->skmers.spaceGtCesKmer;
+    qsort(info->skmers.spaceGtCesKmer, info->skmers.nextfreeGtCesKmer,
+          sizeof (GtCesKmer), gt_ces_kmer_compare);
+
+    /* merge join of the sorted kmers of query and subject */
+    info->seeds.nextfreeGtCesKmerSeed = 0;
+    for (sidx = 0; sidx < info->skmers.nextfreeGtCesKmer; sidx++) {
+      GtUword qrun;
+      while (qidx < info->qkmers.nextfreeGtCesKmer &&
+             qkmers[qidx].code < skmers[sidx].code)
+        qidx++;
+      for (qrun = qidx;
+           qrun < info->qkmers.nextfreeGtCesKmer &&
+           qkmers[qrun].code == skmers[sidx].code;
+           qrun++) {
+        GtCesKmerSeed seed;
+        seed.spos = skmers[sidx].pos;
+        seed.qpos = qkmers[qrun].pos;
+        seed.sid = 0;
+        GT_STOREINARRAY(&info->seeds, GtCesKmerSeed, 256, seed);
+      }
+    }
+    gt_ces_kmer_extend_seeds(info, qseq, qlen, subjectlen);
+
+    /* keep only the best of alignments overlapping in query and subject */
+    qsort(info->hits.spaceGtCesKmerHit, info->hits.nextfreeGtCesKmerHit,
+          sizeof (GtCesKmerHit), gt_ces_kmer_hit_score_compare);
+    for (hidx = 0; hidx < info->hits.nextfreeGtCesKmerHit; hidx++) {
+      GtCesKmerHit *hit = info->hits.spaceGtCesKmerHit + hidx;
+      GtUword kidx;
+      bool redundant = false;
+      for (kidx = 0; !redundant && kidx < kept; kidx++) {
+        const GtCesKmerHit *other = info->hits.spaceGtCesKmerHit + kidx;
+        redundant = gt_range_overlap(&hit->srange, &other->srange) &&
+                    gt_range_overlap(&hit->qrange, &other->qrange);
+      }
+      if (!redundant)
+        info->hits.spaceGtCesKmerHit[kept++] = *hit;
+    }
+    qsort(info->hits.spaceGtCesKmerHit, kept,
+          sizeof (GtCesKmerHit), gt_ces_kmer_hit_pos_compare);
+
+    seqstart = gt_condenseq_seqstartpos(info->ces, range->seqid);
+    desc = gt_condenseq_description(info->ces, &desclen, range->seqid);
+    for (hidx = 0; hidx < kept; hidx++) {
+      const GtCesKmerHit *hit = info->hits.spaceGtCesKmerHit + hidx;
+      GtUword sstart = range->range.start - seqstart + hit->srange.start + 1,
+              send = range->range.start - seqstart + hit->srange.end + 1,
+              qstart = hit->qrange.start + 1,
+              qend = hit->qrange.end + 1;
+      double bits = gt_ces_kmer_bitscore(info, hit->score);
+      if (reverse) {
+        GtUword tmp = sstart;
+        sstart = send;
+        send = tmp;
+        qstart = qlen - hit->qrange.end;
+        qend = qlen - hit->qrange.start;
+      }
+      /* output like
+         blast -outfmt 6 'qseqid sseqid pident length qstart qend sstart send
+         evalue bitscore'
+         */
+      gt_file_xprintf(info->args->outfp,
+                      "%s\t%.*s\t%.2f\t" GT_WU "\t" GT_WU "\t" GT_WU "\t"
+                      GT_WU "\t" GT_WU "\t%g\t%.3f\n",
+                      gt_str_get(info->qseqid),
+                      (int) desclen, desc,
+                      100.0 * hit->matches / hit->columns,
+                      hit->columns,
+                      qstart, qend, sstart, send,
+                      gt_ces_kmer_evalue(info, qlen, bits), bits);
+      info->numofhits++;
+    }
+  }
+  info->subject = NULL;
+}
+
+static int gt_ces_kmer_search_query(GtCesKmerInfo *info,
+                                    const GtUchar *qseq,
+                                    GtUword qlen,
+                                    GtError *err)
+{
+  int had_err = 0;
+  bool reverse = false;
+
+  if (qlen < (GtUword) info->args->kmersize)
+    return had_err;
+  do {
+    if (reverse) {
+      GtUword idx;
+      if (info->revcompl_size < qlen) {
+        info->revcompl = gt_realloc(info->revcompl,
+                                    sizeof (*info->revcompl) * qlen);
+        info->revcompl_size = qlen;
+      }
+      for (idx = 0; idx < qlen; idx++) {
+        GtUchar cc = qseq[qlen - 1 - idx];
+        info->revcompl[idx] = cc < (GtUchar) 4 ? (GtUchar) 3 - cc : cc;
+      }
+      qseq = info->revcompl;
+    }
+    gt_ces_kmer_collect(info, qseq, qlen, &info->qkmers);
+    had_err = gt_ces_kmer_coarse(info, qseq, qlen, err);
+    if (!had_err)
+      gt_ces_kmer_fine(info, qseq, qlen, reverse);
+    reverse = !reverse;
+  } while (!had_err && reverse && info->dna);
+  return had_err;
+}
+
+static int gt_ces_kmer_build_db(GtCesKmerInfo *info)
+{
+  GtUword uid, numofuniques = gt_encseq_num_of_sequences(info->unique_es);
+
+  info->kdb = gt_kmer_database_new(info->numofchars, info->args->kmersize,
+                                   (GtUword) 100000, info->unique_es);
+  if (info->args->cutoff != 0) {
+    gt_kmer_database_set_cutoff(info->kdb, info->args->cutoff);
+    gt_kmer_database_set_prune(info->kdb);
+  }
+  for (uid = 0; uid < numofuniques; uid++) {
+    GtUword start = gt_encseq_seqstartpos(info->unique_es, uid),
+            len = gt_encseq_seqlength(info->unique_es, uid);
+    if (len >= (GtUword) info->args->kmersize)
+      gt_kmer_database_add_interval(info->kdb, start, start + len - 1, uid);
+  }
+  gt_kmer_database_flush(info->kdb);
+  gt_logger_log(info->logger, "kmer db contains " GT_WU " kmers",
+                gt_kmer_database_get_kmer_count(info->kdb));
+  return 0;
+}
+
+static int gt_condenseq_kmersearch_runner(GT_UNUSED int argc,
+                                          GT_UNUSED const char **argv,
+                                          GT_UNUSED int parsed_args,
+                                          void *tool_arguments,
+                                          GtError *err)
+{
+  int had_err = 0;
+  GtCondenseqKmersearchArguments *arguments = tool_arguments;
+  GtCesKmerInfo info;
+  GtAlphabet *alphabet = NULL;
+  GtSeqIterator *seqit = NULL;
+  GtStrArray *queryfiles = NULL;
+  GtTimer *timer = NULL;
+
+  gt_error_check(err);
+  gt_assert(arguments != NULL);
+
+  memset(&info, 0, sizeof (info));
+  info.args = arguments;
+  info.logger =
+    gt_logger_new(gt_condenseq_search_arguments_verbose(arguments->csa),
+                  GT_LOGGER_DEFLT_PREFIX, stderr);
+
+  if (gt_showtime_enabled()) {
+    timer = gt_timer_new_with_progress_description("initialization");
+    gt_timer_start(timer);
+  }
+
+  info.ces = gt_condenseq_search_arguments_read_condenseq(arguments->csa,
+                                                          info.logger, err);
+  if (info.ces == NULL)
+    had_err = -1;
+
+  if (!had_err) {
+    alphabet = gt_condenseq_alphabet(info.ces);
+    info.unique_es = gt_condenseq_unique_encseq(info.ces);
+    info.numofchars = gt_alphabet_num_of_chars(alphabet);
+    info.dna = gt_alphabet_is_dna(alphabet);
+    info.dblen = gt_condenseq_total_length(info.ces);
+    if (arguments->kmersize == GT_UNDEF_UINT) {
+      /* size^k ~= 100000 like condenseq compress */
+      gt_safe_assign(arguments->kmersize,
+                     gt_round_to_long(gt_log_base(100000.0,
+                                                  (double) info.numofchars)));
+    }
+    gt_logger_log(info.logger, "|A|: %u, k: %u",
+                  info.numofchars, arguments->kmersize);
+    if (arguments->scores.mat + (GtWord) (info.numofchars - 1) *
+        arguments->scores.mis >= 0) {
+      gt_error_set(err, "expected score of -mat and -mis for random sequences "
+                   "has to be negative");
+      had_err = -1;
+    }
+  }
+
+  if (!had_err) {
+    unsigned int idx;
+    info.maxcode = 1;
+    for (idx = 0; idx < arguments->kmersize; idx++)
+      info.maxcode *= info.numofchars;
+    info.lambda = gt_ces_kmer_lambda(&arguments->scores, info.numofchars);
+    gt_logger_log(info.logger, "lambda: %.4f", info.lambda);
+    info.coarse_left_res = gt_xdrop_resources_new(&gt_ces_kmer_coarse_scores);
+    info.coarse_right_res =
+      gt_xdrop_resources_new(&gt_ces_kmer_coarse_scores);
+    info.fine_left_res = gt_xdrop_resources_new(&arguments->scores);
+    info.fine_right_res = gt_xdrop_resources_new(&arguments->scores);
+    info.s_fwd = gt_seqabstract_new_empty();
+    info.s_bwd = gt_seqabstract_new_empty();
+    info.q_fwd = gt_seqabstract_new_empty();
+    info.q_bwd = gt_seqabstract_new_empty();
+    info.to_extract_rbt = gt_rbtree_new(gt_ces_kmer_range_compare,
+                                        gt_ces_kmer_range_free, NULL);
+    info.qseqid = gt_str_new();
+    GT_INITARRAY(&info.qkmers, GtCesKmer);
+    GT_INITARRAY(&info.skmers, GtCesKmer);
+    GT_INITARRAY(&info.seeds, GtCesKmerSeed);
+    GT_INITARRAY(&info.hits, GtCesKmerHit);
+    GT_INITARRAY(&info.sorted, GtCesKmerRange);
+
+    if (timer != NULL)
+      gt_timer_show_progress(timer, "create kmer db of uniques", stderr);
+    had_err = gt_ces_kmer_build_db(&info);
+  }
+
+  if (!had_err) {
+    queryfiles = gt_str_array_new();
+    gt_str_array_add(queryfiles, arguments->querypath);
+    seqit = gt_seq_iterator_sequence_buffer_new(queryfiles, err);
+    if (seqit == NULL)
+      had_err = -1;
+  }
+
+  if (!had_err) {
+    const GtUchar *qseq;
+    GtUword qlen, numofqueries = 0;
+    char *desc;
+    int status;
+
+    if (timer != NULL)
+      gt_timer_show_progress(timer, "search queries", stderr);
+    gt_seq_iterator_set_symbolmap(seqit, gt_alphabet_symbolmap(alphabet));
+    while (!had_err &&
+           (status = gt_seq_iterator_next(seqit, &qseq, &qlen, &desc,
+                                          err)) == 1) {
+      size_t idlen = strcspn(desc, " \t");
+      gt_str_reset(info.qseqid);
+      gt_str_append_cstr_nt(info.qseqid, desc, (GtUword) idlen);
+      had_err = gt_ces_kmer_search_query(&info, qseq, qlen, err);
+      numofqueries++;
+    }
+    if (!had_err && status == -1)
+      had_err = -1;
+    gt_logger_log(info.logger, GT_WU " queries, " GT_WU " hits found",
+                  numofqueries, info.numofhits);
+  }
+
+  if (!had_err && timer != NULL)
+    gt_timer_show_progress_final(timer, stderr);
+  gt_timer_delete(timer);
+
+  gt_seq_iterator_delete(seqit);
+  gt_str_array_delete(queryfiles);
+  if (info.to_extract_rbt != NULL) {
+    GT_FREEARRAY(&info.qkmers, GtCesKmer);
+    GT_FREEARRAY(&info.skmers, GtCesKmer);
+    GT_FREEARRAY(&info.seeds, GtCesKmerSeed);
+    GT_FREEARRAY(&info.hits, GtCesKmerHit);
+    GT_FREEARRAY(&info.sorted, GtCesKmerRange);
+    gt_rbtree_delete(info.to_extract_rbt);
+  }
+  gt_str_delete(info.qseqid);
+  gt_free(info.revcompl);
+  gt_seqabstract_delete(info.s_fwd);
+  gt_seqabstract_delete(info.s_bwd);
+  gt_seqabstract_delete(info.q_fwd);
+  gt_seqabstract_delete(info.q_bwd);
+  gt_xdrop_resources_delete(info.coarse_left_res);
+  gt_xdrop_resources_delete(info.coarse_right_res);
+  gt_xdrop_resources_delete(info.fine_left_res);
+  gt_xdrop_resources_delete(info.fine_right_res);
+  gt_kmer_database_delete(info.kdb);
+  gt_encseq_delete(info.unique_es);
+  gt_alphabet_delete(alphabet);
+  gt_condenseq_delete(info.ces);
+  gt_logger_delete(info.logger);
+  return had_err;
+}
+
+GtTool* gt_condenseq_kmersearch(void)
+{
+  return gt_tool_new(gt_condenseq_kmersearch_arguments_new,
+                     gt_condenseq_kmersearch_arguments_delete,
+                     gt_condenseq_kmersearch_option_parser_new,
+                     gt_condenseq_kmersearch_arguments_check,
+                     gt_condenseq_kmersearch_runner);
+}
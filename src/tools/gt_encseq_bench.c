@@ -20,14 +20,20 @@
 #include "core/unused_api.h"
 #include "core/encseq.h"
 #include "core/encseq_metadata.h"
+#include "core/format64.h"
 #include "core/mathsupport.h"
 #include "core/showtime.h"
 #include "core/logger.h"
+#include "core/timer_api.h"
+#include "match/kmercodes.h"
+#include "match/sfx-mappedstr.h"
+#include "match/sfx-suffixer.h"
 #include "tools/gt_encseq_bench.h"
 
 typedef struct
 {
   GtUword ccext;
+  unsigned int kmersize;
   bool sortlenprepare, verbose;
 } GtEncseqBenchArguments;
 
@@ -64,6 +70,14 @@ static GtOptionParser* gt_encseq_bench_option_parser_new(void *tool_arguments)
                                &arguments->ccext, 0UL);
   gt_option_parser_add_option(op, option);
 
+  option = gt_option_new_uint_min_max("kmers", "specify kmer size for "
+                                       "extracting all kmer codes from the "
+                                       "twobit encoding and from a kmer code "
+                                       "iterator",
+                                       &arguments->kmersize, 0, 2U,
+                                       (unsigned int) GT_UNITSIN2BITENC);
+  gt_option_parser_add_option(op, option);
+
   option = gt_option_new_bool("solepr", "prepare data structure for sequences "
                                          "ordered by their length",
                                &arguments->sortlenprepare, false);
@@ -102,6 +116,107 @@ static void gt_bench_character_extractions(const GtEncseq *encseq,
   }
 }
 
+static void gt_bench_sumkmercode(void *processinfo,
+                                GT_UNUSED bool firstinrange,
+                                GT_UNUSED GtUword pos,
+                                GtCodetype code)
+{
+  uint64_t *kmersum = (uint64_t *) processinfo;
+
+  *kmersum += (uint64_t) code;
+}
+
+static void gt_bench_kmer_extraction_show(const char *method,
+                                          uint64_t kmersum,
+                                          GtTimer *timer)
+{
+  GtWord usec = gt_timer_elapsed_usec(timer);
+
+  printf("%-20s kmersum=" Formatuint64_t ", time " GT_WD ".%06ld s\n",
+         method,PRINTuint64_tcast(kmersum),usec / 1000000,
+         (long) (usec % 1000000));
+}
+
+/* Compare the rolling update of the kmer codes (the old method) against the
+   blockwise extraction (the new method, if supported) and the kmer code
+   iterator. All of them must deliver the same kmer codes. */
+static int gt_bench_kmer_extractions(const GtEncseq *encseq,
+                                     unsigned int kmersize,
+                                     GtError *err)
+{
+  uint64_t kmersum_rolling = 0, kmersum_blockwise = 0, kmersum_iterator = 0;
+  bool blockwise = false;
+  GtKmercodeiterator *kmercodeiterator;
+  const GtKmercode *kmercodeptr;
+  GtTimer *timer;
+
+  if (gt_encseq_twobitencoding_export(encseq) == NULL)
+  {
+    gt_error_set(err,"option -kmers requires an encoded sequence with a "
+                     "twobit encoding");
+    return -1;
+  }
+  if (gt_encseq_total_length(encseq) < (GtUword) kmersize)
+  {
+    return 0;
+  }
+  timer = gt_timer_new();
+  gt_timer_start(timer);
+  gt_getencseqkmers_twobitencoding_rolling(encseq,
+                                           GT_READMODE_FORWARD,
+                                           kmersize,
+                                           gt_bench_sumkmercode,
+                                           &kmersum_rolling);
+  gt_bench_kmer_extraction_show("rolling update",kmersum_rolling,timer);
+#ifdef GT_KMERCODES_BLOCKWISE
+  blockwise = gt_kmercodes_blockwise();
+#endif
+  if (blockwise)
+  {
+    gt_timer_start(timer);
+    getencseqkmers_twobitencoding(encseq,
+                                  GT_READMODE_FORWARD,
+                                  kmersize,
+                                  kmersize,
+                                  false,
+                                  gt_bench_sumkmercode,
+                                  &kmersum_blockwise,
+                                  NULL,
+                                  NULL);
+    gt_bench_kmer_extraction_show("blockwise",kmersum_blockwise,timer);
+  } else
+  {
+    printf("%-20s not supported by this processor\n","blockwise");
+    kmersum_blockwise = kmersum_rolling;
+  }
+  gt_timer_start(timer);
+  kmercodeiterator = gt_kmercodeiterator_encseq_new(encseq,
+                                                    GT_READMODE_FORWARD,
+                                                    kmersize,0);
+  while ((kmercodeptr
+           = gt_kmercodeiterator_encseq_nonspecial_next(kmercodeiterator))
+         != NULL)
+  {
+    kmersum_iterator += (uint64_t) kmercodeptr->code;
+  }
+  gt_kmercodeiterator_delete(kmercodeiterator);
+  gt_bench_kmer_extraction_show("kmer code iterator",kmersum_iterator,timer);
+  gt_timer_delete(timer);
+  if (kmersum_blockwise != kmersum_rolling ||
+      kmersum_iterator != kmersum_rolling)
+  {
+    gt_error_set(err,"kmer codes of size %u differ: kmersum=" Formatuint64_t
+                     " (rolling update), " Formatuint64_t " (blockwise), "
+                     Formatuint64_t " (kmer code iterator)",
+                 kmersize,
+                 PRINTuint64_tcast(kmersum_rolling),
+                 PRINTuint64_tcast(kmersum_blockwise),
+                 PRINTuint64_tcast(kmersum_iterator));
+    return -1;
+  }
+  return 0;
+}
+
 typedef struct
 {
   GtUword minlength, maxlength, numofdifferentseqlen, *seqlenseppos,
@@ -327,6 +442,11 @@ static int gt_encseq_bench_runner(GT_UNUSED int argc, const char **argv,
       gt_logger_log(logger,"perform character extractions");
       gt_bench_character_extractions(encseq,arguments->ccext);
     }
+    if (!had_err && arguments->kmersize > 0)
+    {
+      gt_logger_log(logger,"perform kmer extractions");
+      had_err = gt_bench_kmer_extractions(encseq,arguments->kmersize,err);
+    }
   }
   gt_encseq_delete(encseq);
   gt_encseq_loader_delete(encseq_loader);
@@ -31,6 +31,8 @@ typedef struct {
   GtEncseqOptions *eopts;
   bool showstats,
        no_esq_header,
+       spool,
+       append,
        verbose;
   GtStr *indexname;
 } GtEncseqEncodeArguments;
@@ -79,6 +81,25 @@ static GtOptionParser* gt_encseq_encode_option_parser_new(void *tool_arguments)
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
 
+  /* -spool */
+  option = gt_option_new_bool("spool",
+                              "parse the input only once and keep it in a "
+                              "compact temporary file for the second pass\n"
+                              "(only for alphabets with at most 4 characters)",
+                              &arguments->spool,
+                              false);
+  gt_option_parser_add_option(op, option);
+
+  /* -append */
+  option = gt_option_new_bool("append",
+                              "append the sequence files to the existing "
+                              "index given by -indexname, only the new files "
+                              "are parsed, but the sequence tables are "
+                              "rewritten",
+                              &arguments->append,
+                              false);
+  gt_option_parser_add_option(op, option);
+
   /* encoded sequence options */
   arguments->eopts = gt_encseq_options_register_encoding(op,
                                                          arguments->indexname,
@@ -96,6 +117,8 @@ static GtOptionParser* gt_encseq_encode_option_parser_new(void *tool_arguments)
 static int encode_sequence_files(GtStrArray *infiles, GtEncseqOptions *opts,
                                  const char *indexname, bool verbose,
                                  bool esq_no_header,
+                                 bool spool,
+                                 bool append,
                                  GtError *err)
 {
   GtEncseqEncoder *encseq_encoder;
@@ -113,7 +136,14 @@ static int encode_sequence_files(GtStrArray *infiles, GtEncseqOptions *opts,
     {
       gt_encseq_encoder_disable_esq_header(encseq_encoder);
     }
-    had_err = gt_encseq_encoder_encode(encseq_encoder, infiles, indexname, err);
+    if (spool)
+      gt_encseq_encoder_enable_spooling(encseq_encoder);
+    if (append)
+      had_err = gt_encseq_encoder_append(encseq_encoder, infiles, indexname,
+                                         err);
+    else
+      had_err = gt_encseq_encoder_encode(encseq_encoder, infiles, indexname,
+                                         err);
   }
   gt_encseq_encoder_delete(encseq_encoder);
   gt_logger_delete(logger);
@@ -169,7 +199,10 @@ static int gt_encseq_encode_runner(GT_UNUSED int argc, const char **argv,
   }
 
   if (gt_str_length(arguments->indexname) == 0UL) {
-    if (gt_str_array_size(infiles) > 1UL) {
+    if (arguments->append) {
+      gt_error_set(err, "option -append requires option -indexname");
+      had_err = -1;
+    } else if (gt_str_array_size(infiles) > 1UL) {
       gt_error_set(err,"if more than one input file is given, then "
                        "option -indexname is mandatory");
       had_err = -1;
@@ -188,6 +221,8 @@ static int gt_encseq_encode_runner(GT_UNUSED int argc, const char **argv,
                                     gt_str_get(arguments->indexname),
                                     arguments->verbose,
                                     arguments->no_esq_header,
+                                    arguments->spool,
+                                    arguments->append,
                                     err);
   }
 
@@ -20,7 +20,7 @@
 #include "core/output_file_api.h"
 #include "core/str_array_api.h"
 #include "core/trans_table_api.h"
-#include "core/unused_api.h"
+#include "extended/binary_in_stream.h"
 #include "extended/extract_feature_stream_api.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_in_stream.h"
@@ -35,7 +35,8 @@ typedef struct {
        target,
        verbose,
        showcoords,
-       retainids;
+       retainids,
+       binaryin;
   unsigned int gcode;
   GtStr *type;
   GtSeqid2FileInfo *s2fi;
@@ -136,6 +137,12 @@ static GtOptionParser* gt_extractfeat_option_parser_new(void *tool_arguments)
                                   GT_STANDARD_TRANSLATION_SCHEME, 1U);
   gt_option_parser_add_option(op, option);
 
+  /* -binaryin */
+  option = gt_option_new_bool("binaryin", "read a binary node stream (as "
+                              "written by gt gff3 -binaryout) instead of a "
+                              "GFF3 file", &arguments->binaryin, false);
+  gt_option_parser_add_option(op, option);
+
   /* -seqfile, -matchdesc, -usedesc and -regionmapping */
   gt_seqid2file_register_options(op, arguments->s2fi);
 
@@ -156,7 +163,7 @@ static GtOptionParser* gt_extractfeat_option_parser_new(void *tool_arguments)
   return op;
 }
 
-static int gt_extractfeat_runner(GT_UNUSED int argc, const char **argv,
+static int gt_extractfeat_runner(int argc, const char **argv,
                                  int parsed_args, void *tool_arguments,
                                  GtError *err)
 {
@@ -170,10 +177,16 @@ static int gt_extractfeat_runner(GT_UNUSED int argc, const char **argv,
   gt_assert(arguments);
 
   if (!had_err) {
-    /* create gff3 input stream */
-    gff3_in_stream = gt_gff3_in_stream_new_sorted(argv[parsed_args]);
-    if (arguments->verbose)
-      gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
+    /* create input stream */
+    if (arguments->binaryin) {
+      gff3_in_stream = gt_binary_in_stream_new(argc - parsed_args,
+                                               argv + parsed_args);
+    }
+    else {
+      gff3_in_stream = gt_gff3_in_stream_new_sorted(argv[parsed_args]);
+      if (arguments->verbose)
+        gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
+    }
 
     /* create region mapping */
     region_mapping = gt_seqid2file_region_mapping_new(arguments->s2fi, err);
@@ -22,6 +22,8 @@
 #include "core/undef_api.h"
 #include "core/versionfunc.h"
 #include "extended/add_introns_stream_api.h"
+#include "extended/binary_in_stream.h"
+#include "extended/binary_out_stream.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_defines.h"
 #include "extended/gff3_in_stream.h"
@@ -53,6 +55,9 @@ typedef struct {
        strict,
        tidy,
        show,
+       writethread,
+       binaryin,
+       binaryout,
        fixboundaries;
   GtWord offset;
   GtStr *offsetfile, *newsource;
@@ -94,7 +99,8 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   GtOption *sort_option, *load_option, *strict_option, *tidy_option,
            *mergefeat_option, *addintrons_option, *offset_option,
            *offsetfile_option, *setsource_option, *sortlines_option,
-           *sortnum_option, *option;
+           *sortnum_option, *checkids_option, *fixboundaries_option,
+           *writethread_option, *binaryin_option, *option;
   gt_assert(arguments);
 
   /* init */
@@ -146,19 +152,22 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, option);
 
   /* -checkids */
-  option = gt_option_new_bool("checkids",
-                              "make sure the ID attributes are unique "
-                              "within the scope of each GFF3_file, as required "
-                              "by GFF3 specification\n"
-                              "(memory consumption is proportional to the "
-                              "input file size(s)).\n"
-                              "If features with the same "GT_GFF_PARENT" "
-                              "attribute are not separated by a '"
-                              GT_GFF_TERMINATOR"' line the GFF3 parser tries "
-                              "to treat them as a multi-line feature. This "
-                              "requires at least matching sequence IDs and "
-                              "types.", &arguments->checkids, false);
-  gt_option_parser_add_option(op, option);
+  checkids_option = gt_option_new_bool("checkids",
+                                       "make sure the ID attributes are "
+                                       "unique within the scope of each "
+                                       "GFF3_file, as required by GFF3 "
+                                       "specification\n"
+                                       "(memory consumption is proportional "
+                                       "to the input file size(s)).\n"
+                                       "If features with the same "
+                                       GT_GFF_PARENT" attribute are not "
+                                       "separated by a '"GT_GFF_TERMINATOR"' "
+                                       "line the GFF3 parser tries to treat "
+                                       "them as a multi-line feature. This "
+                                       "requires at least matching sequence "
+                                       "IDs and types.", &arguments->checkids,
+                                       false);
+  gt_option_parser_add_option(op, checkids_option);
 
   /* -addids */
   option = gt_option_new_bool("addids", "add missing \""
@@ -167,12 +176,15 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, option);
 
   /* -fixregionboundaries */
-  option = gt_option_new_bool("fixregionboundaries", "automatically adjust \""
-                              GT_GFF_SEQUENCE_REGION"\" lines to contain all "
-                              "their features (memory consumption is "
-                              "proportional to the input file size(s))",
-                              &arguments->fixboundaries, false);
-  gt_option_parser_add_option(op, option);
+  fixboundaries_option = gt_option_new_bool("fixregionboundaries",
+                                            "automatically adjust \""
+                                            GT_GFF_SEQUENCE_REGION"\" lines "
+                                            "to contain all their features "
+                                            "(memory consumption is "
+                                            "proportional to the input file "
+                                            "size(s))",
+                                            &arguments->fixboundaries, false);
+  gt_option_parser_add_option(op, fixboundaries_option);
 
   /* -mergefeat */
   mergefeat_option = gt_option_new_bool("mergefeat",
@@ -226,6 +238,40 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
                               true);
   gt_option_parser_add_option(op, option);
 
+  /* -writethread */
+  writethread_option = gt_option_new_bool("writethread", "write (and "
+                                          "compress) the GFF3 output in a "
+                                          "separate thread (no effect without "
+                                          "thread support)",
+                                          &arguments->writethread, false);
+  gt_option_exclude(writethread_option, sortlines_option);
+  gt_option_exclude(writethread_option, sortnum_option);
+  gt_option_parser_add_option(op, writethread_option);
+
+  /* -binaryin */
+  binaryin_option = gt_option_new_bool("binaryin", "read binary node streams "
+                                       "(as written with -binaryout) instead "
+                                       "of GFF3 files, without parsing and "
+                                       "type checking them again",
+                                       &arguments->binaryin, false);
+  gt_option_exclude(binaryin_option, strict_option);
+  gt_option_exclude(binaryin_option, tidy_option);
+  gt_option_exclude(binaryin_option, checkids_option);
+  gt_option_exclude(binaryin_option, fixboundaries_option);
+  gt_option_exclude(binaryin_option, offset_option);
+  gt_option_exclude(binaryin_option, offsetfile_option);
+  gt_option_parser_add_option(op, binaryin_option);
+
+  /* -binaryout */
+  option = gt_option_new_bool("binaryout", "write the output as binary node "
+                              "stream instead of GFF3, which can be read "
+                              "quickly by tools with a -binaryin option",
+                              &arguments->binaryout, false);
+  gt_option_exclude(option, sortlines_option);
+  gt_option_exclude(option, sortnum_option);
+  gt_option_exclude(option, writethread_option);
+  gt_option_parser_add_option(op, option);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -262,55 +308,71 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   gt_error_check(err);
   gt_assert(arguments);
 
-  /* create a gff3 input stream */
-  gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
-                                                  argv + parsed_args);
-  if (arguments->verbose && arguments->outfp)
-    gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
-  if (arguments->checkids)
-    gt_gff3_in_stream_check_id_attributes((GtGFF3InStream*) gff3_in_stream);
-  if (!arguments->addids)
-    gt_gff3_in_stream_disable_add_ids(gff3_in_stream);
+  if (arguments->binaryin) {
+    /* create a binary input stream */
+    if (gt_typecheck_info_option_used(arguments->tci) ||
+        gt_xrfcheck_info_option_used(arguments->xci)) {
+      gt_error_set(err, "option -binaryin cannot be combined with type or "
+                   "xrf checking options");
+      return -1;
+    }
+    gff3_in_stream = gt_binary_in_stream_new(argc - parsed_args,
+                                             argv + parsed_args);
+  }
+  else {
+    /* create a gff3 input stream */
+    gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
+                                                    argv + parsed_args);
+    if (arguments->verbose && arguments->outfp)
+      gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
+    if (arguments->checkids)
+      gt_gff3_in_stream_check_id_attributes((GtGFF3InStream*)
+                                            gff3_in_stream);
+    if (!arguments->addids)
+      gt_gff3_in_stream_disable_add_ids(gff3_in_stream);
+
+    /* set different type checker if necessary */
+    if (gt_typecheck_info_option_used(arguments->tci)) {
+      type_checker = gt_typecheck_info_create_type_checker(arguments->tci,
+                                                           err);
+      if (!type_checker)
+        had_err = -1;
+      if (!had_err)
+        gt_gff3_in_stream_set_type_checker(gff3_in_stream, type_checker);
+    }
 
-  last_stream = gff3_in_stream;
+    /* set XRF checker if necessary */
+    if (gt_xrfcheck_info_option_used(arguments->xci)) {
+      xrf_checker = gt_xrfcheck_info_create_xrf_checker(arguments->xci, err);
+      if (!xrf_checker)
+        had_err = -1;
+      if (!had_err)
+        gt_gff3_in_stream_set_xrf_checker(gff3_in_stream, xrf_checker);
+    }
 
-  /* set different type checker if necessary */
-  if (gt_typecheck_info_option_used(arguments->tci)) {
-    type_checker = gt_typecheck_info_create_type_checker(arguments->tci, err);
-    if (!type_checker)
-      had_err = -1;
-    if (!had_err)
-      gt_gff3_in_stream_set_type_checker(gff3_in_stream, type_checker);
-  }
+    /* set offset (if necessary) */
+    if (!had_err && arguments->offset != GT_UNDEF_WORD)
+      gt_gff3_in_stream_set_offset(gff3_in_stream, arguments->offset);
 
-  /* set XRF checker if necessary */
-  if (gt_xrfcheck_info_option_used(arguments->xci)) {
-    xrf_checker = gt_xrfcheck_info_create_xrf_checker(arguments->xci, err);
-    if (!xrf_checker)
-      had_err = -1;
-    if (!had_err)
-      gt_gff3_in_stream_set_xrf_checker(gff3_in_stream, xrf_checker);
-  }
+    /* set offsetfile (if necessary) */
+    if (!had_err && gt_str_length(arguments->offsetfile)) {
+      had_err = gt_gff3_in_stream_set_offsetfile(gff3_in_stream,
+                                                 arguments->offsetfile, err);
+    }
 
-  /* set offset (if necessary) */
-  if (!had_err && arguments->offset != GT_UNDEF_WORD)
-    gt_gff3_in_stream_set_offset(gff3_in_stream, arguments->offset);
+    /* enable strict mode (if necessary) */
+    if (!had_err && arguments->strict)
+      gt_gff3_in_stream_enable_strict_mode((GtGFF3InStream*) gff3_in_stream);
+    /* enable tidy mode (if necessary) */
+    if (!had_err && arguments->tidy)
+      gt_gff3_in_stream_enable_tidy_mode((GtGFF3InStream*) gff3_in_stream);
 
-  /* set offsetfile (if necessary) */
-  if (!had_err && gt_str_length(arguments->offsetfile)) {
-    had_err = gt_gff3_in_stream_set_offsetfile(gff3_in_stream,
-                                               arguments->offsetfile, err);
+    if (!had_err && arguments->fixboundaries)
+      gt_gff3_in_stream_fix_region_boundaries((GtGFF3InStream*)
+                                              gff3_in_stream);
   }
 
-  /* enable strict mode (if necessary) */
-  if (!had_err && arguments->strict)
-    gt_gff3_in_stream_enable_strict_mode((GtGFF3InStream*) gff3_in_stream);
-  /* enable tidy mode (if necessary) */
-  if (!had_err && arguments->tidy)
-    gt_gff3_in_stream_enable_tidy_mode((GtGFF3InStream*) gff3_in_stream);
-
-  if (!had_err && arguments->fixboundaries)
-    gt_gff3_in_stream_fix_region_boundaries((GtGFF3InStream*) gff3_in_stream);
+  last_stream = gff3_in_stream;
 
   /* create load stream (if necessary) */
   if (!had_err && arguments->load) {
@@ -349,7 +411,9 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
 
   /* create gff3 output stream */
   if (!had_err && arguments->show) {
-    if (arguments->sortlines) {
+    if (arguments->binaryout)
+      gff3_out_stream = gt_binary_out_stream_new(last_stream, arguments->outfp);
+    else if (arguments->sortlines) {
       gff3_out_stream = gt_gff3_linesorted_out_stream_new(last_stream,
                                                           arguments->outfp);
       gt_gff3_linesorted_out_stream_set_fasta_width(
@@ -374,6 +438,9 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
       if (arguments->retainids)
         gt_gff3_out_stream_retain_id_attributes((GtGFF3OutStream*)
                                                                gff3_out_stream);
+      if (arguments->writethread)
+        gt_gff3_out_stream_enable_background_writing((GtGFF3OutStream*)
+                                                               gff3_out_stream);
     }
     gt_assert(gff3_out_stream);
     last_stream = gff3_out_stream;
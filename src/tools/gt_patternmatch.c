@@ -20,6 +20,7 @@
 #include "core/error.h"
 #include "core/option_api.h"
 #include "core/str.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/versionfunc.h"
 #include "match/cutendpfx.h"
@@ -33,7 +34,7 @@
 typedef struct
 {
   GtUword minpatternlen, maxpatternlen, numofsamples;
-  bool showpatt, usebcktab, immediate;
+  bool showpatt, usebcktab, immediate, batch;
   GtStr *indexname;
 } Pmatchoptions;
 
@@ -64,6 +65,66 @@ static void comparemmsis(const GtMMsearchiterator *mmsi1,
 
 #define UNDEFREFSTART totallength
 
+static int batchpatternmatcher(const Pmatchoptions *pmopt,
+                               const Suffixarray *suffixarray,
+                               Enumpatterniterator *epi,
+                               GtError *err)
+{
+  GtMMsearchbatch *mmsb;
+  GtMMsearchiterator *mmsibatch, *mmsiimm;
+  GtUword trial, patternlen, dbstart,
+          totallength = gt_encseq_total_length(suffixarray->encseq);
+  const GtUchar *pptr;
+  const GtAlphabet *alpha = gt_encseq_alphabet(suffixarray->encseq);
+  bool haserr = false;
+
+  mmsb = gt_mmsearchbatch_new(suffixarray->encseq,
+                              suffixarray->suftab,
+                              suffixarray->readmode,
+                              pmopt->usebcktab ? suffixarray->bcktab : NULL,
+                              suffixarray->prefixlength);
+  for (trial = 0; trial < pmopt->numofsamples; trial++)
+  {
+    pptr = gt_nextEnumpatterniterator(&patternlen,epi);
+    if (pmopt->showpatt)
+    {
+      gt_alphabet_decode_seq_to_fp(alpha,stdout,pptr,patternlen);
+      printf("\n");
+    }
+    gt_mmsearchbatch_add(mmsb,pptr,patternlen);
+  }
+  if (gt_mmsearchbatch_run(mmsb,gt_jobs,err) != 0)
+  {
+    haserr = true;
+  }
+  for (trial = 0; !haserr && trial < gt_mmsearchbatch_size(mmsb); trial++)
+  {
+    mmsibatch = gt_mmsearchbatch_iterator(mmsb,trial);
+    if (pmopt->immediate)
+    {
+      pptr = gt_mmsearchbatch_pattern(&patternlen,mmsb,trial);
+      mmsiimm = gt_mmsearchiterator_new_complete_plain(
+                                          suffixarray->encseq,
+                                          suffixarray->suftab,
+                                          0,  /* leftbound */
+                                          totallength, /* rightbound */
+                                          0, /* offset */
+                                          suffixarray->readmode,
+                                          pptr,
+                                          patternlen);
+      comparemmsis(mmsibatch,mmsiimm);
+      gt_mmsearchiterator_delete(mmsiimm);
+    }
+    while (gt_mmsearchiterator_next(&dbstart,mmsibatch))
+    {
+      /* Nothing */;
+    }
+    gt_mmsearchiterator_delete(mmsibatch);
+  }
+  gt_mmsearchbatch_delete(mmsb);
+  return haserr ? -1 : 0;
+}
+
 static int callpatternmatcher(const Pmatchoptions *pmopt, GtError *err)
 {
   Suffixarray suffixarray;
@@ -122,7 +183,14 @@ static int callpatternmatcher(const Pmatchoptions *pmopt, GtError *err)
     esr2 = gt_encseq_create_reader_with_readmode(suffixarray.encseq,
                                                  suffixarray.readmode, 0);
     alpha = gt_encseq_alphabet(suffixarray.encseq);
-    for (trial = 0; trial < pmopt->numofsamples; trial++)
+    if (pmopt->batch)
+    {
+      if (batchpatternmatcher(pmopt,&suffixarray,epi,err) != 0)
+      {
+        haserr = true;
+      }
+    }
+    for (trial = 0; !pmopt->batch && trial < pmopt->numofsamples; trial++)
     {
       pptr = gt_nextEnumpatterniterator(&patternlen,epi);
       if (pmopt->showpatt)
@@ -247,7 +315,7 @@ static GtOPrval parse_options(Pmatchoptions *pmopt,
                               int argc, const char **argv, GtError *err)
 {
   GtOptionParser *op;
-  GtOption *option, *optionimm, *optionbck;
+  GtOption *option, *optionimm, *optionbck, *optionbatch;
   GtOPrval oprval;
 
   gt_error_check(err);
@@ -284,6 +352,13 @@ static GtOPrval parse_options(Pmatchoptions *pmopt,
                               false);
   gt_option_parser_add_option(op, optionimm);
 
+  optionbatch = gt_option_new_bool("batch","Search all patterns together, "
+                                   "sorted and split over the threads given "
+                                   "by -j; with -imm compare the results",
+                                   &pmopt->batch,
+                                   false);
+  gt_option_parser_add_option(op, optionbatch);
+
   option = gt_option_new_string("ii",
                              "Specify input index",
                              pmopt->indexname, NULL);
@@ -15,8 +15,11 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/minmax.h"
 #include "core/option_api.h"
+#include "core/undef_api.h"
 #include "core/versionfunc.h"
+#include "extended/feature_store.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/regioncov_visitor.h"
@@ -24,7 +27,8 @@
 
 typedef struct {
   GtUword max_feature_dist;
-  bool verbose;
+  bool store,
+       verbose;
 } RegionCovArguments;
 
 static GtOPrval parse_options(int *parsed_args, RegionCovArguments *arguments,
@@ -42,6 +46,11 @@ static GtOPrval parse_options(int *parsed_args, RegionCovArguments *arguments,
                        "features can have while still being in the same "
                        "``cluster''", &arguments->max_feature_dist, 0);
   gt_option_parser_add_option(op, o);
+  /* -store */
+  o = gt_option_new_bool("store", "keep the top-level features in a columnar "
+                         "feature store and compute the coverage from its "
+                         "start and end columns", &arguments->store, false);
+  gt_option_parser_add_option(op, o);
   /* -v */
   o = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, o);
@@ -53,10 +62,46 @@ static GtOPrval parse_options(int *parsed_args, RegionCovArguments *arguments,
   return oprval;
 }
 
+/* Same output as <gt_regioncov_visitor_show_coverage()>, computed from the
+   top-level features in <fs>. */
+static void show_feature_store_coverage(const GtFeatureStore *fs,
+                                        GtUword max_feature_dist)
+{
+  GtFeatureColumns columns;
+  GtStrArray *seqids;
+  GtUword i, j, cov_start = 0, cov_end = 0;
+  bool covered;
+  seqids = gt_feature_store_get_seqids(fs);
+  for (i = 0; i < gt_str_array_size(seqids); i++) {
+    (void) gt_feature_store_get_columns(fs, &columns,
+                                        gt_str_array_get(seqids, i));
+    printf("%s:\n", gt_str_array_get(seqids, i));
+    covered = false;
+    for (j = 0; j < columns.num_of_features; j++) {
+      if (columns.parent[j] != GT_UNDEF_UWORD)
+        continue;
+      if (covered && columns.start[j] <= cov_end + max_feature_dist)
+        cov_end = MAX(cov_end, columns.end[j]);
+      else {
+        if (covered)
+          printf(""GT_WU", "GT_WU"\n", cov_start, cov_end);
+        cov_start = columns.start[j];
+        cov_end = columns.end[j];
+        covered = true;
+      }
+    }
+    if (covered)
+      printf(""GT_WU", "GT_WU"\n", cov_start, cov_end);
+  }
+  gt_str_array_delete(seqids);
+}
+
 int gt_regioncov(int argc, const char **argv, GtError *err)
 {
   GtNodeVisitor *regioncov_visitor;
   GtNodeStream *gff3_in_stream;
+  GtFeatureStore *feature_store;
+  GtFeatureNode *fn;
   GtGenomeNode *gn;
   RegionCovArguments arguments;
   int parsed_args, had_err = 0;
@@ -77,6 +122,21 @@ int gt_regioncov(int argc, const char **argv, GtError *err)
   if (arguments.verbose)
     gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
 
+  if (arguments.store) {
+    /* collect the top-level features and free the nodes right away */
+    feature_store = gt_feature_store_new();
+    while (!(had_err = gt_node_stream_next(gff3_in_stream, &gn, err)) && gn) {
+      if ((fn = gt_feature_node_try_cast(gn)))
+        (void) gt_feature_store_add_top_level_feature(feature_store, fn);
+      gt_genome_node_delete(gn);
+    }
+    if (!had_err)
+      show_feature_store_coverage(feature_store, arguments.max_feature_dist);
+    gt_feature_store_delete(feature_store);
+    gt_node_stream_delete(gff3_in_stream);
+    return had_err;
+  }
+
   /* create region coverage visitor */
   regioncov_visitor = gt_regioncov_visitor_new(arguments.max_feature_dist);
 
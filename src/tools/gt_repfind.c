@@ -813,9 +813,14 @@ static int gt_repfind_runner(int argc,const char **argv, int parsed_args,
       haserr = true;
     } else
     {
-      gt_querymatch_Options_output(stdout,argc,argv,true,arguments->minidentity,
-                                   arguments->historysize);
-      gt_querymatch_Fields_output(stdout,out_display_flag);
+      if (!gt_querymatch_paf_display(out_display_flag) &&
+          !gt_querymatch_sam_display(out_display_flag))
+      {
+        gt_querymatch_Options_output(stdout,argc,argv,true,
+                                     arguments->minidentity,
+                                     arguments->historysize);
+        gt_querymatch_Fields_output(stdout,out_display_flag);
+      }
     }
   }
   if (!haserr)
@@ -988,6 +993,10 @@ static int gt_repfind_runner(int argc,const char **argv, int parsed_args,
         }
       }
     }
+    if (!haserr && gt_querymatch_sam_display(out_display_flag))
+    {
+      gt_querymatch_sam_header_output(stdout,encseq_for_desc,argc,argv);
+    }
     if (!haserr && gt_str_array_size(arguments->query_files) == 0 &&
         gt_str_length(arguments->query_indexname) == 0)
     {
@@ -25,12 +25,14 @@
 #include "core/encseq.h"
 #include "core/encseq_api.h"
 #include "core/error_api.h"
+#include "core/fa.h"
 #include "core/ma_api.h"
 #include "core/mathsupport.h"
 #include "core/minmax.h"
 #include "core/parseutils_api.h"
 #include "core/range_api.h"
 #include "core/showtime.h"
+#include "core/str.h"
 #include "core/str_api.h"
 #include "match/diagbandseed.h"
 #include "match/seed-extend.h"
@@ -48,8 +50,10 @@ typedef struct {
   /* diagbandseed options */
   GtStr *dbs_indexname;
   GtStr *dbs_queryname;
+  GtStr *server_path;
   unsigned int dbs_spacedseedweight;
   unsigned int dbs_seedlength;
+  unsigned int dbs_minimizer_window;
   GtUword dbs_logdiagbandwidth;
   GtUword dbs_mincoverage;
   GtUword dbs_maxfreq;
@@ -108,6 +112,7 @@ static void* gt_seed_extend_arguments_new(void)
   GtSeedExtendArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
   arguments->dbs_indexname = gt_str_new();
   arguments->dbs_queryname = gt_str_new();
+  arguments->server_path = gt_str_new();
   arguments->dbs_pick_str = gt_str_new();
   arguments->chainarguments = gt_str_new();
   arguments->diagband_statistics_arg = gt_str_new();
@@ -125,6 +130,7 @@ static void gt_seed_extend_arguments_delete(void *tool_arguments)
   if (arguments != NULL) {
     gt_str_delete(arguments->dbs_indexname);
     gt_str_delete(arguments->dbs_queryname);
+    gt_str_delete(arguments->server_path);
     gt_str_delete(arguments->dbs_pick_str);
     gt_str_delete(arguments->chainarguments);
     gt_str_delete(arguments->diagband_statistics_arg);
@@ -156,7 +162,7 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
     *op_norev, *op_nofwd, *op_part, *op_pick, *op_overl, *op_trimstat,
     *op_cam_generic, *op_diagbandwidth, *op_mincoverage, *op_maxmat,
     *op_use_apos, *op_use_apos_track_all, *op_chain, *op_diagband_statistics,
-    *op_ani, *op_benchmark;
+    *op_ani, *op_benchmark, *op_qii, *op_kmerfile, *op_server, *op_minimizer;
 
   static GtRange seedpairdistance_defaults = {1UL, GT_UWORD_MAX};
   /* When extending the following array, do not forget to update
@@ -181,12 +187,12 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, option);
 
   /* -qii */
-  option = gt_option_new_string("qii",
+  op_qii = gt_option_new_string("qii",
                                 "Query input index (encseq)",
                                 arguments->dbs_queryname,
                                 "");
-  gt_option_hide_default(option);
-  gt_option_parser_add_option(op, option);
+  gt_option_hide_default(op_qii);
+  gt_option_parser_add_option(op, op_qii);
 
   /* -seedlength */
   op_seedlength = gt_option_new_uint_min_max("seedlength",
@@ -211,6 +217,18 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, op_spacedseed);
   arguments->se_ref_op_spacedseed = gt_option_ref(op_spacedseed);
 
+  /* -minimizer */
+  op_minimizer = gt_option_new_uint_min("minimizer",
+                                        "only use the k-mers with the "
+                                        "smallest hash value in each window "
+                                        "of the given number of consecutive "
+                                        "k-mers as seeds; the window size "
+                                        "must not exceed the seedlength",
+                                        &arguments->dbs_minimizer_window,
+                                        1U,
+                                        1U);
+  gt_option_parser_add_option(op, op_minimizer);
+
   /* -diagbandwidth */
   op_diagbandwidth = gt_option_new_uword_min_max("diagbandwidth",
                                "Logarithm of diagonal band width in the "
@@ -631,11 +649,29 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, option);
 
   /* -kmerfile */
-  option = gt_option_new_bool("kmerfile",
-                              "Use pre-calculated k-mers from file (if exist)",
-                              &arguments->use_kmerfile,
-                              true);
-  gt_option_parser_add_option(op, option);
+  op_kmerfile = gt_option_new_bool("kmerfile",
+                                   "Use pre-calculated k-mers from file "
+                                   "(if exist)",
+                                   &arguments->use_kmerfile,
+                                   true);
+  gt_option_parser_add_option(op, op_kmerfile);
+
+  /* -server */
+  op_server = gt_option_new_string("server",
+                                   "Read query index names line by line "
+                                   "from the given file or named pipe and "
+                                   "compare each query to the index given "
+                                   "by -ii, whose k-mers are computed only "
+                                   "once and kept in memory until the end "
+                                   "of the input",
+                                   arguments->server_path,
+                                   "");
+  gt_option_hide_default(op_server);
+  gt_option_imply(op_server, op_seedlength);
+  gt_option_exclude(op_server, op_qii);
+  gt_option_exclude(op_server, op_kmerfile);
+  gt_option_exclude(op_server, op_ani);
+  gt_option_parser_add_option(op, op_server);
 
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
@@ -651,6 +687,7 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
   gt_option_exclude(op_diagband_statistics, op_cam);
   gt_option_exclude(op_diagband_statistics, op_trimstat);
   gt_option_exclude(op_diagband_statistics, op_maxmat);
+  gt_option_exclude(op_minimizer, op_maxmat);
   gt_option_exclude(op_diagband_statistics, op_use_apos);
   gt_option_exclude(op_diagband_statistics, op_use_apos_track_all);
   gt_option_exclude(op_diagband_statistics, op_minlen);
@@ -706,6 +743,11 @@ static int gt_seed_extend_arguments_check(int rest_argc, void *tool_arguments,
   }
 #endif
 
+  /* the k-mers of the server index are kept in memory instead */
+  if (gt_str_length(arguments->server_path) > 0) {
+    arguments->use_kmerfile = false;
+  }
+
   /* minimum maxfreq value for 1 input file */
   if (!had_err && arguments->dbs_maxfreq == 1 &&
       strcmp(gt_str_get(arguments->dbs_queryname), "") == 0) {
@@ -748,173 +790,52 @@ static double gt_seed_extend_ani_evaluate(GtUword sum_of_aligned_len,
              : 0.0;
 }
 
-static int gt_seed_extend_runner(int argc,
-                                 const char **argv,
-                                 GT_UNUSED int parsed_args,
-                                 void *tool_arguments,
-                                 GtError *err)
+/* Compare the sequences of <aencseq> to those of the index <queryname>, or
+   to themselves if <queryname> is <NULL>. If <kmer_index> is not <NULL>, the
+   k-mer lists of <aencseq> are taken from <*kmer_index>, which is created at
+   the first call. */
+static int gt_seed_extend_compare(GtSeedExtendArguments *arguments,
+                                  GtEncseq *aencseq,
+                                  const char *queryname,
+                                  GtDiagbandseedKmerIndex **kmer_index,
+                                  GtDiagbandseedBaseListType splt,
+                                  GtDiagbandseedBaseListType kmplt,
+                                  GtExtendCharAccess cam_a,
+                                  GtExtendCharAccess cam_b,
+                                  bool extendgreedy,
+                                  bool extendxdrop,
+                                  GtUword errorpercentage,
+                                  const GtSeedExtendDisplayFlag
+                                    *out_display_flag,
+                                  GtAniAccumulate *ani_accumulate,
+                                  GtError *err)
 {
-  GtSeedExtendArguments *arguments = tool_arguments;
-  GtEncseq *aencseq = NULL, *bencseq = NULL;
-  GtTimer *seedextendtimer = NULL;
-  GtExtendCharAccess cam_a = GT_EXTEND_CHAR_ACCESS_ANY,
-                     cam_b = GT_EXTEND_CHAR_ACCESS_ANY;
-  GtDiagbandseedBaseListType splt = GT_DIAGBANDSEED_BASE_LIST_UNDEFINED,
-                             kmplt = GT_DIAGBANDSEED_BASE_LIST_UNDEFINED;
-  GtUword errorpercentage = 0UL;
+  GtEncseq *bencseq = NULL;
   double matchscore_bias = GT_DEFAULT_MATCHSCORE_BIAS;
-  bool extendxdrop, extendgreedy = true;
   unsigned int maxseedlength = 0, nchars = 0;
   GtUwordPair pick = {GT_UWORD_MAX, GT_UWORD_MAX};
   GtUword maxseqlength = 0, a_numofsequences, b_numofsequences;
-  GtSeedExtendDisplayFlag *out_display_flag = NULL;
   int had_err = 0;
-  const GtSeedExtendDisplaySetMode setmode
-    = GT_SEED_EXTEND_DISPLAY_SET_STANDARD;
-  GtAniAccumulate ani_accumulate[2];
-
-  gt_error_check(err);
-  gt_assert(arguments != NULL);
-  ani_accumulate[0].sum_of_aligned_len = 0;
-  ani_accumulate[0].sum_of_distance = 0;
-  ani_accumulate[1].sum_of_aligned_len = 0;
-  ani_accumulate[1].sum_of_distance = 0;
-  /* Define, whether greedy extension will be performed */
-  extendxdrop = gt_option_is_set(arguments->se_ref_op_xdr);
-  if (arguments->onlyseeds || extendxdrop) {
-    extendgreedy = false;
-  }
 
-  /* Calculate error percentage from minidentity */
-  gt_assert(arguments->se_minidentity >= GT_EXTEND_MIN_IDENTITY_PERCENTAGE &&
-            arguments->se_minidentity <= 100UL);
-  errorpercentage = 100UL - arguments->se_minidentity;
-
-  /* Measure whole running time */
-  if (arguments->benchmark || arguments->verbose)
-  {
-    gt_showtime_enable();
-  }
-  if (gt_showtime_enabled())
-  {
-    seedextendtimer = gt_timer_new();
-    gt_timer_start(seedextendtimer);
-  }
-  if (!arguments->compute_ani)
-  {
-    out_display_flag = gt_querymatch_display_flag_new(arguments->display_args,
-                                                      setmode,err);
-    if (out_display_flag == NULL)
-    {
-      had_err = -1;
-    }
-  }
-
-  if (!had_err)
-  {
-    if (!gt_querymatch_gfa2_display(out_display_flag))
-    {
-      const bool idhistout
-        = (arguments->maxmat != 1 &&
-           gt_str_length(arguments->diagband_statistics_arg) == 0)
-          ? true : false;
-      gt_querymatch_Options_output(stdout,argc,argv,idhistout,
-                                   arguments->se_minidentity,
-                                   arguments->se_historysize);
-      if (!arguments->compute_ani  && !arguments->onlyseeds)
-      {
-        gt_querymatch_Fields_output(stdout,out_display_flag);
-      }
-    } else
-    {
-      printf("H\tVN:Z:2.0");
-      if (gt_querymatch_trace_display(out_display_flag))
-      {
-        printf("\tTS:i:" GT_WU "\n",
-               gt_querymatch_trace_delta_display(out_display_flag));
-      } else
-      {
-        fputc('\n',stdout);
-      }
-    }
-  }
-  /* Set character access method */
-  if (!had_err && !arguments->onlyseeds)
-  {
-    if (gt_greedy_extend_char_access(&cam_a,&cam_b,
-                                     gt_str_get(arguments->char_access_mode),
-                                     err) != 0)
-    {
-      had_err = -1;
-    }
-  }
-  if (!had_err)
+  /* If there is a 2nd read set: Load encseq B */
+  if (queryname == NULL) {
+    bencseq = gt_encseq_ref(aencseq);
+  } else
   {
-    splt = gt_diagbandseed_base_list_get(true,
-                                         gt_str_get(arguments->splt_string),
-                                         err);
-    if ((int) splt == -1) {
-      had_err = -1;
-    }
-  }
-  if (!had_err)
-  {
-    kmplt = gt_diagbandseed_base_list_get(false,
-                                          gt_str_get(arguments->kmplt_string),
-                                          err);
-    if ((int) kmplt == -1) {
-      had_err = -1;
-    }
-  }
-  if (!had_err) {
     GtEncseqLoader *encseq_loader = gt_encseq_loader_new();
     gt_encseq_loader_require_multiseq_support(encseq_loader);
     gt_encseq_loader_require_ssp_tab(encseq_loader);
     if (out_display_flag != NULL &&
-        gt_querymatch_subjectid_display(out_display_flag))
+        gt_querymatch_queryid_display(out_display_flag))
     {
       gt_encseq_loader_require_des_tab(encseq_loader);
       gt_encseq_loader_require_sds_tab(encseq_loader);
     }
-
-    /* Load encseq A */
-    aencseq = gt_encseq_loader_load(encseq_loader,
-                                    gt_str_get(arguments->dbs_indexname),
-                                    err);
-    if (aencseq == NULL) {
-      had_err = -1;
-    }
+    bencseq = gt_encseq_loader_load(encseq_loader,queryname,err);
     gt_encseq_loader_delete(encseq_loader);
   }
-  if (!had_err)
-  {
-    /* If there is a 2nd read set: Load encseq B */
-    if (gt_str_length(arguments->dbs_queryname) == 0) {
-      bencseq = gt_encseq_ref(aencseq);
-    } else
-    {
-      GtEncseqLoader *encseq_loader = gt_encseq_loader_new();
-      gt_encseq_loader_require_multiseq_support(encseq_loader);
-      gt_encseq_loader_require_ssp_tab(encseq_loader);
-      if (out_display_flag != NULL &&
-          gt_querymatch_queryid_display(out_display_flag))
-      {
-        gt_encseq_loader_require_des_tab(encseq_loader);
-        gt_encseq_loader_require_sds_tab(encseq_loader);
-      }
-      bencseq = gt_encseq_loader_load(encseq_loader,
-                                      gt_str_get(arguments->dbs_queryname),
-                                      err);
-      if (bencseq == NULL)
-      {
-        had_err = -1;
-      }
-      gt_encseq_loader_delete(encseq_loader);
-    }
-    if (bencseq == NULL) {
-      had_err = -1;
-      gt_encseq_delete(aencseq);
-    }
+  if (bencseq == NULL) {
+    had_err = -1;
   }
 
   /* Check alphabet sizes */
@@ -925,17 +846,12 @@ static int gt_seed_extend_runner(int argc,
     if (nchars != nchars_b) {
       gt_error_set(err,"encoded sequences have different alphabet "
                    "sizes %u and %u", nchars, nchars_b);
-      gt_encseq_delete(aencseq);
       gt_encseq_delete(bencseq);
       had_err = -1;
     }
   }
 
   if (had_err) {
-    if (gt_showtime_enabled()) {
-      gt_timer_delete(seedextendtimer);
-    }
-    gt_querymatch_display_flag_delete(out_display_flag);
     return had_err;
   }
 
@@ -1042,6 +958,17 @@ static int gt_seed_extend_runner(int argc,
     }
   }
 
+  /* In each region of a match of length at least seedlength + window size - 1
+     the positions of two successive minimizers differ by at most the window
+     size, so the seeds of such a match cover it completely, as without
+     minimizers, if the window size does not exceed the seedlength. */
+  if (!had_err && arguments->dbs_minimizer_window > arguments->dbs_seedlength)
+  {
+    gt_error_set(err, "argument to option \"-minimizer\" must not be larger "
+                      "than %u (seedlength)", arguments->dbs_seedlength);
+    had_err = -1;
+  }
+
   /* Set mincoverage */
   if (!had_err)
   {
@@ -1211,6 +1138,7 @@ static int gt_seed_extend_runner(int argc,
                                     arguments->dbs_memlimit,
                                     arguments->dbs_spacedseedweight,
                                     arguments->dbs_seedlength,
+                                    arguments->dbs_minimizer_window,
                                     arguments->norev,
                                     arguments->nofwd,
                                     &arguments->seedpairdistance,
@@ -1228,11 +1156,26 @@ static int gt_seed_extend_runner(int argc,
                                     extp);
 
     /* Start algorithm */
-    had_err = gt_diagbandseed_run(info,
-                                  aseqranges,
-                                  bseqranges,
-                                  &pick,
-                                  err);
+    if (kmer_index != NULL)
+    {
+      if (*kmer_index == NULL)
+      {
+        *kmer_index = gt_diagbandseed_kmer_index_new(info,aseqranges,&pick);
+      }
+      had_err = gt_diagbandseed_run_with_kmer_index(info,
+                                                    *kmer_index,
+                                                    aseqranges,
+                                                    bseqranges,
+                                                    &pick,
+                                                    err);
+    } else
+    {
+      had_err = gt_diagbandseed_run(info,
+                                    aseqranges,
+                                    bseqranges,
+                                    &pick,
+                                    err);
+    }
 
     /* clean up */
     if (bseqranges != aseqranges)
@@ -1243,8 +1186,218 @@ static int gt_seed_extend_runner(int argc,
     gt_diagbandseed_extend_params_delete(extp);
     gt_diagbandseed_info_delete(info);
   }
-  gt_encseq_delete(aencseq);
   gt_encseq_delete(bencseq);
+  return had_err;
+}
+
+static int gt_seed_extend_runner(int argc,
+                                 const char **argv,
+                                 GT_UNUSED int parsed_args,
+                                 void *tool_arguments,
+                                 GtError *err)
+{
+  GtSeedExtendArguments *arguments = tool_arguments;
+  GtEncseq *aencseq = NULL;
+  GtTimer *seedextendtimer = NULL;
+  GtExtendCharAccess cam_a = GT_EXTEND_CHAR_ACCESS_ANY,
+                     cam_b = GT_EXTEND_CHAR_ACCESS_ANY;
+  GtDiagbandseedBaseListType splt = GT_DIAGBANDSEED_BASE_LIST_UNDEFINED,
+                             kmplt = GT_DIAGBANDSEED_BASE_LIST_UNDEFINED;
+  GtUword errorpercentage = 0UL;
+  bool extendxdrop, extendgreedy = true;
+  GtSeedExtendDisplayFlag *out_display_flag = NULL;
+  int had_err = 0;
+  const GtSeedExtendDisplaySetMode setmode
+    = GT_SEED_EXTEND_DISPLAY_SET_STANDARD;
+  GtAniAccumulate ani_accumulate[2];
+
+  gt_error_check(err);
+  gt_assert(arguments != NULL);
+  ani_accumulate[0].sum_of_aligned_len = 0;
+  ani_accumulate[0].sum_of_distance = 0;
+  ani_accumulate[1].sum_of_aligned_len = 0;
+  ani_accumulate[1].sum_of_distance = 0;
+  /* Define, whether greedy extension will be performed */
+  extendxdrop = gt_option_is_set(arguments->se_ref_op_xdr);
+  if (arguments->onlyseeds || extendxdrop) {
+    extendgreedy = false;
+  }
+
+  /* Calculate error percentage from minidentity */
+  gt_assert(arguments->se_minidentity >= GT_EXTEND_MIN_IDENTITY_PERCENTAGE &&
+            arguments->se_minidentity <= 100UL);
+  errorpercentage = 100UL - arguments->se_minidentity;
+
+  /* Measure whole running time */
+  if (arguments->benchmark || arguments->verbose)
+  {
+    gt_showtime_enable();
+  }
+  if (gt_showtime_enabled())
+  {
+    seedextendtimer = gt_timer_new();
+    gt_timer_start(seedextendtimer);
+  }
+  if (!arguments->compute_ani)
+  {
+    out_display_flag = gt_querymatch_display_flag_new(arguments->display_args,
+                                                      setmode,err);
+    if (out_display_flag == NULL)
+    {
+      had_err = -1;
+    }
+  }
+
+  if (!had_err)
+  {
+    if (gt_querymatch_paf_display(out_display_flag) ||
+        gt_querymatch_sam_display(out_display_flag))
+    {
+      /* no comment lines, the SAM header is output once the subject
+         sequences are known */
+    } else if (!gt_querymatch_gfa2_display(out_display_flag))
+    {
+      const bool idhistout
+        = (arguments->maxmat != 1 &&
+           gt_str_length(arguments->diagband_statistics_arg) == 0)
+          ? true : false;
+      gt_querymatch_Options_output(stdout,argc,argv,idhistout,
+                                   arguments->se_minidentity,
+                                   arguments->se_historysize);
+      if (!arguments->compute_ani  && !arguments->onlyseeds)
+      {
+        gt_querymatch_Fields_output(stdout,out_display_flag);
+      }
+    } else
+    {
+      printf("H\tVN:Z:2.0");
+      if (gt_querymatch_trace_display(out_display_flag))
+      {
+        printf("\tTS:i:" GT_WU "\n",
+               gt_querymatch_trace_delta_display(out_display_flag));
+      } else
+      {
+        fputc('\n',stdout);
+      }
+    }
+  }
+  /* Set character access method */
+  if (!had_err && !arguments->onlyseeds)
+  {
+    if (gt_greedy_extend_char_access(&cam_a,&cam_b,
+                                     gt_str_get(arguments->char_access_mode),
+                                     err) != 0)
+    {
+      had_err = -1;
+    }
+  }
+  if (!had_err)
+  {
+    splt = gt_diagbandseed_base_list_get(true,
+                                         gt_str_get(arguments->splt_string),
+                                         err);
+    if ((int) splt == -1) {
+      had_err = -1;
+    }
+  }
+  if (!had_err)
+  {
+    kmplt = gt_diagbandseed_base_list_get(false,
+                                          gt_str_get(arguments->kmplt_string),
+                                          err);
+    if ((int) kmplt == -1) {
+      had_err = -1;
+    }
+  }
+  if (!had_err) {
+    GtEncseqLoader *encseq_loader = gt_encseq_loader_new();
+    gt_encseq_loader_require_multiseq_support(encseq_loader);
+    gt_encseq_loader_require_ssp_tab(encseq_loader);
+    if (out_display_flag != NULL &&
+        gt_querymatch_subjectid_display(out_display_flag))
+    {
+      gt_encseq_loader_require_des_tab(encseq_loader);
+      gt_encseq_loader_require_sds_tab(encseq_loader);
+    }
+
+    /* Load encseq A */
+    aencseq = gt_encseq_loader_load(encseq_loader,
+                                    gt_str_get(arguments->dbs_indexname),
+                                    err);
+    if (aencseq == NULL) {
+      had_err = -1;
+    }
+    gt_encseq_loader_delete(encseq_loader);
+  }
+  if (!had_err && gt_querymatch_sam_display(out_display_flag))
+  {
+    gt_querymatch_sam_header_output(stdout,aencseq,argc,argv);
+  }
+  if (!had_err)
+  {
+    if (gt_str_length(arguments->server_path) > 0)
+    {
+      GtDiagbandseedKmerIndex *kmer_index = NULL;
+      FILE *server_fp = gt_fa_fopen(gt_str_get(arguments->server_path),"r",
+                                    err);
+
+      if (server_fp == NULL)
+      {
+        had_err = -1;
+      } else
+      {
+        GtStr *queryname = gt_str_new();
+
+        /* each line names a query index, the results of which are flushed
+           before the next line is read */
+        while (!had_err && gt_str_read_next_line(queryname,server_fp) != EOF)
+        {
+          if (gt_str_length(queryname) > 0)
+          {
+            had_err = gt_seed_extend_compare(arguments,
+                                             aencseq,
+                                             gt_str_get(queryname),
+                                             &kmer_index,
+                                             splt,
+                                             kmplt,
+                                             cam_a,
+                                             cam_b,
+                                             extendgreedy,
+                                             extendxdrop,
+                                             errorpercentage,
+                                             out_display_flag,
+                                             ani_accumulate,
+                                             err);
+            fflush(stdout);
+          }
+          gt_str_reset(queryname);
+        }
+        gt_str_delete(queryname);
+        gt_fa_fclose(server_fp);
+      }
+      gt_diagbandseed_kmer_index_delete(kmer_index);
+    } else
+    {
+      had_err = gt_seed_extend_compare(arguments,
+                                       aencseq,
+                                       gt_str_length(arguments->dbs_queryname)
+                                         > 0
+                                         ? gt_str_get(arguments->dbs_queryname)
+                                         : NULL,
+                                       NULL,
+                                       splt,
+                                       kmplt,
+                                       cam_a,
+                                       cam_b,
+                                       extendgreedy,
+                                       extendxdrop,
+                                       errorpercentage,
+                                       out_display_flag,
+                                       ani_accumulate,
+                                       err);
+    }
+  }
+  gt_encseq_delete(aencseq);
 
   if (!had_err && gt_showtime_enabled()) {
     char *keystring;
@@ -1267,7 +1420,7 @@ static int gt_seed_extend_runner(int argc,
     gt_timer_delete(seedextendtimer);
   }
   gt_querymatch_display_flag_delete(out_display_flag);
-  if (arguments->compute_ani)
+  if (!had_err && arguments->compute_ani)
   {
     int idx;
 
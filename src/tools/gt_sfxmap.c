@@ -1187,6 +1187,9 @@ static const Optionargmodedesc stream_esq_operation[] =
                    (unsigned int) BSRS_stream_reader_multi},
   {"stream_reader_multi3","read kmers with encseq reader and from word stream",
                    (unsigned int) BSRS_stream_reader_multi3},
+  {"stream_reader_block","read kmers with encseq reader and blockwise from "
+                         "word stream",
+                   (unsigned int) BSRS_stream_reader_block},
   {"hashfirstcodes","hash first codes of each sequence in the encseq",
                    (unsigned int) BSRS_hashfirstcodes}
 };
@@ -1233,6 +1236,7 @@ static int gt_sfxmap_stream_esq(const Sfxmapoptions *arguments,GtError *err)
         if ((brsmode == BSRS_reader_multi ||
              brsmode == BSRS_stream_reader_multi ||
              brsmode == BSRS_stream_reader_multi3 ||
+             brsmode == BSRS_stream_reader_block ||
              brsmode == BSRS_hashfirstcodes) &&
              streamesq_size != 3UL)
         {
@@ -33,6 +33,7 @@
 #include "match/tyr-mkindex.h"
 #include "match/tyr-show.h"
 #include "match/tyr-search.h"
+#include "match/tyr-merhash.h"
 #include "match/tyr-mersplit.h"
 #include "match/tyr-occratio.h"
 #include "tools/gt_tallymer.h"
@@ -61,6 +62,7 @@ typedef struct
   GtStr *str_storeindex,
         *str_inputindex;
   bool storecounts,
+       storehash,
        performtest,
        verbose,
        scanfile;
@@ -98,6 +100,7 @@ static GtOptionParser *gt_tyr_mkindex_option_parser_new(void *tool_arguments)
            *optionpl,
            *optionstoreindex,
            *optionstorecounts,
+           *optionstorehash,
            *optionscan,
            *optionesa;
   Tyr_mkindex_options *arguments = tool_arguments;
@@ -157,6 +160,13 @@ static GtOptionParser *gt_tyr_mkindex_option_parser_new(void *tool_arguments)
                                          &arguments->storecounts,false);
   gt_option_parser_add_option(op, optionstorecounts);
 
+  optionstorehash = gt_option_new_bool("hash",
+                                       "store a hash table of the mers for "
+                                       "direct lookup by ``gt tallymer "
+                                       "search''",
+                                       &arguments->storehash,false);
+  gt_option_parser_add_option(op, optionstorehash);
+
   option = gt_option_new_bool("test", "perform tests to verify program "
                                       "correctness", &arguments->performtest,
                                       false);
@@ -175,6 +185,7 @@ static GtOptionParser *gt_tyr_mkindex_option_parser_new(void *tool_arguments)
 
   gt_option_imply(optionpl, optionstoreindex);
   gt_option_imply(optionstorecounts, optionstoreindex);
+  gt_option_imply(optionstorehash, optionstoreindex);
   gt_option_imply_either_2(optionstoreindex,optionminocc,optionmaxocc);
   return op;
 }
@@ -291,6 +302,21 @@ static int gt_tyr_mkindex_runner(GT_UNUSED int argc,
       haserr = true;
     }
   }
+  if (!haserr && gt_str_length(arguments->str_storeindex) > 0)
+  {
+    if (arguments->storehash)
+    {
+      if (gt_constructmerhash(gt_str_get(arguments->str_storeindex),logger,
+                              err) != 0)
+      {
+        haserr = true;
+      }
+    } else
+    {
+      /* a table of an earlier index must not survive */
+      gt_removemerhash(gt_str_get(arguments->str_storeindex));
+    }
+  }
   gt_logger_delete(logger);
   return haserr ? - 1 : 0;
 }
@@ -0,0 +1,61 @@
+Name "gt batch encseq info cached"
+Keywords "gt_batch"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname Atinsert " \
+           "#{$testdata}Atinsert.fna"
+  run_test "#{$bin}gt encseq info Atinsert"
+  run "cat #{last_stdout} #{last_stdout} > direct.out"
+  File.open("commands", "w") do |f|
+    f.puts "# the second invocation uses the cached encoded sequence"
+    f.puts "encseq info Atinsert"
+    f.puts ""
+    f.puts "encseq info 'Atinsert'"
+  end
+  run_test "#{$bin}gt batch commands"
+  run "diff #{last_stdout} direct.out"
+end
+
+Name "gt batch gff3 typecheck"
+Keywords "gt_batch"
+Test do
+  run_test "#{$bin}gt gff3 -tidy -typecheck so " \
+           "#{$testdata}standard_gene_as_tree.gff3"
+  run "cat #{last_stdout} #{last_stdout} > direct.out"
+  File.open("commands", "w") do |f|
+    2.times do
+      f.puts "gff3 -tidy -typecheck so " \
+             "#{$testdata}standard_gene_as_tree.gff3"
+    end
+  end
+  run_test "#{$bin}gt batch < commands"
+  run "diff #{last_stdout} direct.out"
+end
+
+Name "gt batch capture"
+Keywords "gt_batch"
+Test do
+  File.open("commands", "w") do |f|
+    f.puts "seqstat #{$testdata}Atinsert.fna"
+    f.puts "encseq info nonexisting"
+  end
+  run_test "#{$bin}gt batch -capture cmd commands", :retval => 1
+  grep last_stderr, "1 of 2 commands failed"
+  run_test "#{$bin}gt seqstat #{$testdata}Atinsert.fna"
+  run "diff #{last_stdout} cmd1.out"
+  grep "cmd2.err", "cannot open file 'nonexisting.esq'"
+end
+
+Name "gt batch failures"
+Keywords "gt_batch"
+Test do
+  File.open("commands", "w") do |f|
+    f.puts "nonexistingtool"
+    f.puts "batch commands"
+    f.puts "seqstat 'unterminated"
+  end
+  run_test "#{$bin}gt batch commands", :retval => 1
+  grep last_stderr, "tool 'nonexistingtool' not found"
+  grep last_stderr, "tool 'batch' cannot be run from a batch"
+  grep last_stderr, "unterminated quote"
+  grep last_stderr, "3 of 3 commands failed"
+end
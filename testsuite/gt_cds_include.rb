@@ -12,6 +12,16 @@ require 'fileutils'
   end
 end
 
+Name "gt cds test 1 (-binaryin)"
+Keywords "gt_cds binary"
+Test do
+  FileUtils.copy "#{$testdata}gt_cds_test_1.fas", "."
+  run_test "#{$bin}gt gff3 -binaryout #{$testdata}gt_cds_test_1.in | " \
+           "#{$bin}gt cds -minorflen 1 -startcodon yes " \
+           "-seqfile gt_cds_test_1.fas -matchdesc -binaryin"
+  run "diff #{last_stdout} #{$testdata}gt_cds_test_1.out"
+end
+
 Name "gt cds error message"
 Keywords "gt_cds"
 Test do
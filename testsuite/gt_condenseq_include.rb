@@ -154,6 +154,31 @@ opt_arr.each do |opt|
   end
 end
 
+Name "gt condenseq compress + kmersearch"
+Keywords "gt_condenseq compress search kmersearch"
+Test do
+  searchfiles.each_key do |file|
+    basename = File.basename(file)
+    queries = File.join(File.dirname(file), File.basename(file,'.fas'))
+    run_test "#{$bin}gt encseq encode -clipdesc -indexname #{basename} " \
+      "-md5 no " \
+      "#{file}"
+    run_test "#{$bin}gt condenseq compress " \
+      "-indexname #{basename}_nr " \
+      "-alignlength 100 " \
+      "#{basename}",
+      :maxtime => 600
+    run_test "#{$bin}gt condenseq search kmersearch " \
+      "-query #{queries}_queries_300_2x.fas " \
+      "-db #{basename}_nr -verbose > #{basename}.hits"
+    grep(last_stderr, /[1-9]+[0-9]* hits found/)
+    run_ruby "#$scriptsdir/condenseq_blastsearch_stats.rb " \
+      "#{queries}_queries_300_2x_blastn_result #{basename}.hits"
+    grep(last_stdout, /^## TP: [1-9]+[0-9]*$/)
+    grep(last_stdout, /^## FP: 0$/)
+  end
+end
+
 opt_arr.each do |opt|
   range_ext = Proc.new do |file, info|
     basename = File.basename(file)
@@ -216,6 +241,37 @@ opt_arr.each do |opt|
   end
 end
 
+Name "gt condenseq compress batches"
+Keywords "gt_condenseq compress extract batches"
+Test do
+  files.each_pair do |file, info|
+    basename = File.basename(file)
+    run_test "#{$bin}gt encseq encode -clipdesc -indexname #{basename} " \
+      "-md5 no " \
+      "#{file}"
+    run_test "#{$bin}gt encseq decode -output fasta " \
+      "#{basename} > #{basename}.fas"
+    [1, 3].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} condenseq compress -batchlength 2000 " \
+        "-indexname #{basename}_nr_#{jobs} " \
+        "-cutoff 0 " \
+        "-alignlength #{info[0]} " \
+        "#{info[3] > 0 ?
+        "-windowsize #{info[3]}" :
+        ""} " \
+        "#{info[4] > 0 ?
+        "-kmersize #{info[4]}" :
+        ""} " \
+        "#{basename} ",
+        :maxtime => 600
+      run_test "#{$bin}gt condenseq extract " \
+        "#{basename}_nr_#{jobs} > #{basename}_nr_#{jobs}.fas"
+      run "diff #{basename}.fas #{basename}_nr_#{jobs}.fas"
+    end
+    run "cmp #{basename}_nr_1.cse #{basename}_nr_3.cse"
+  end
+end
+
 Name "gt condenseq compress options fail"
 Keywords "gt_condenseq compress options fail"
 Test do
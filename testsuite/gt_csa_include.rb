@@ -30,6 +30,13 @@ Test do
   run "diff #{last_stdout} #{$testdata}U89959_csas.gff3"
 end
 
+Name "gt csa arabidopsis (-j 4)"
+Keywords "gt_csa threads"
+Test do
+  run_test "#{$bin}gt -j 4 csa #{$testdata}U89959_sas.gff3"
+  run "diff #{last_stdout} #{$testdata}U89959_csas.gff3"
+end
+
 Name "gt csa example"
 Keywords "gt_csa"
 Test do
@@ -86,6 +86,23 @@ Test do
   end
 end
 
+Name "gt hcr decompress threads"
+Keywords "gt_csr hcr threads"
+Test do
+  hcr_testcases.each do |testcase|
+    run_test "#$bin/gt compreads compress -descs "    \
+             "#{testcase} "                           \
+             "-files #$testdata/#{hcr_testfiles[0]} " \
+             "-name test"
+    run_test "#$bin/gt -j 3 compreads decompress -descs -file test"
+    run_test "diff test.fastq #$testdata/#{hcr_testfiles[0]}"
+    run_test "#$bin/gt compreads decompress -descs -file test " \
+             "-range 7 93 -name seq"
+    run_test "#$bin/gt -j 4 compreads decompress -descs -file test " \
+             "-range 7 93 -name par"
+    run_test "diff seq.fastq par.fastq"
+  end
+end
 
 rcr_testfiles = {
   "rcr_testreads_on_seq.bam" => "rcr_testseq.fa",
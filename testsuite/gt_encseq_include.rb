@@ -442,3 +442,90 @@ Test do
     end
   end
 end
+
+Name "gt encseq encode spool"
+Keywords "encseq gt_encseq_encode spool"
+Test do
+  ["at1MB", "RandomN.fna", "Atinsert.fna"].each do |file|
+    ["", "-lossless", "-sat direct"].each do |opt|
+      run_test "#{$bin}gt encseq encode #{opt} -indexname seq " +
+               "#{$testdata}#{file}"
+      [1, 3].each do |threads|
+        run_test "#{$bin}gt -j #{threads} encseq encode -spool #{opt} " +
+                 "-indexname spool #{$testdata}#{file}"
+        ["esq", "ssp", "des", "sds", "md5", "ois"].each do |suffix|
+          if File.exist?("seq.#{suffix}") then
+            run "cmp seq.#{suffix} spool.#{suffix}"
+          end
+        end
+      end
+    end
+  end
+end
+
+Name "gt encseq encode append"
+Keywords "encseq gt_encseq_encode append"
+Test do
+  files = ["#{$testdata}at1MB", "#{$testdata}Atinsert.fna",
+           "#{$testdata}RandomN.fna", "#{$testdata}Random.fna"]
+  # an index named like the temporary ones must be left alone
+  run_test "#{$bin}gt encseq encode -indexname app-append #{files[1]}"
+  run "cp app-append.esq app-append.esq.orig"
+  ["", "-sat bit", "-sat direct -spool", "-sat uchar -ssp no",
+   "-md5 no -des no -sds no"].each do |opt|
+    run_test "#{$bin}gt encseq encode #{opt} -indexname all #{files.join(' ')}"
+    run_test "#{$bin}gt encseq encode #{opt} -indexname app #{files[0]}"
+    run_test "#{$bin}gt encseq encode #{opt} -append -indexname app " +
+             "#{files[1]}"
+    run_test "#{$bin}gt -j 2 encseq encode #{opt} -append -indexname app " +
+             "#{files[2..3].join(' ')}"
+    ["esq", "ssp", "des", "sds", "md5"].each do |suffix|
+      if File.exist?("all.#{suffix}") then
+        run "cmp all.#{suffix} app.#{suffix}"
+      elsif File.exist?("app.#{suffix}") then
+        raise TestFailed, "file \"app.#{suffix}\" should not exist"
+      end
+    end
+    run_test "#{$bin}gt encseq decode all"
+    run "mv #{last_stdout} all.out"
+    run_test "#{$bin}gt encseq decode app"
+    run "cmp #{last_stdout} all.out"
+    run "rm -f all.* app.*"
+  end
+  run "cmp app-append.esq app-append.esq.orig"
+  if Dir.glob("app-append.*").sort != ["app-append.des", "app-append.esq",
+                                       "app-append.esq.orig", "app-append.md5",
+                                       "app-append.sds", "app-append.ssp"] then
+    raise TestFailed, "temporary files have been left behind"
+  end
+end
+
+Name "gt encseq encode append failure"
+Keywords "encseq gt_encseq_encode append"
+Test do
+  run_test "#{$bin}gt encseq encode -append #{$testdata}Atinsert.fna",
+           :retval => 1
+  grep last_stderr, /option -append requires option -indexname/
+  run_test "#{$bin}gt encseq encode -lossless -indexname foo " +
+           "#{$testdata}Atinsert.fna"
+  run_test "#{$bin}gt encseq encode -append -indexname foo " +
+           "#{$testdata}Random.fna", :retval => 1
+  grep last_stderr, /cannot append to index foo with lossless support/
+end
+
+Name "gt encseq bench kmers"
+Keywords "encseq gt_encseq_bench kmers"
+Test do
+  ["Atinsert.fna", "Duplicate.fna", "Random-Small.fna",
+   "at1MB"].each do |file|
+    run_test "#{$bin}gt encseq encode -indexname foo #{$testdata}#{file}"
+    [2, 7, 16, 30].each do |kmersize|
+      run_test "#{$bin}gt encseq bench -kmers #{kmersize} foo"
+      if kmersize <= 7 then
+        grep last_stdout, /^rolling update .* time/
+        grep last_stdout, /^blockwise /
+      end
+    end
+    run_test "#{$bin}gt dev sfxmap -stream-esq foo stream_reader_block 12"
+  end
+end
@@ -30,6 +30,21 @@ end
   end
 end
 
+Name "gt eval -j (multiple sequence regions)"
+Keywords "gt_eval threads"
+Test do
+  run "#{$bin}gt select -strand + #{$testdata}encode_known_genes_Mar07.gff3"
+  run "mv #{last_stdout} prediction.gff3"
+  ["", "-nuc no"].each do |opt|
+    run_test "#{$bin}gt eval #{opt} " +
+             "#{$testdata}encode_known_genes_Mar07.gff3 prediction.gff3"
+    run "mv #{last_stdout} serial.out"
+    run_test "#{$bin}gt -j 4 eval #{opt} " +
+             "#{$testdata}encode_known_genes_Mar07.gff3 prediction.gff3"
+    run "diff #{last_stdout} serial.out"
+  end
+end
+
 Name "gt eval prob 1"
 Keywords "gt_eval"
 Test do
@@ -10,6 +10,18 @@ Test do
   run "diff #{last_stdout} #{$testdata}gt_extractfeat_succ_1.out"
 end
 
+Name "gt extractfeat -seqfile test 1 (-binaryin)"
+Keywords "gt_extractfeat binary"
+Test do
+  FileUtils.copy "#{$testdata}gt_extractfeat_succ_1.fas", "."
+  run_test "#{$bin}gt gff3 -binaryout -force -o in.bin " \
+    "#{$testdata}gt_extractfeat_succ_1.gff3"
+  run_test "#{$bin}gt extractfeat -type gene " \
+    "-seqfile gt_extractfeat_succ_1.fas " \
+    "-matchdesc -binaryin in.bin"
+  run "diff #{last_stdout} #{$testdata}gt_extractfeat_succ_1.out"
+end
+
 Name "gt extractfeat -seqfile test 1 (compressed)"
 Keywords "gt_extractfeat"
 Test do
@@ -338,3 +350,170 @@ Test do
     :retval => 1
   grep(last_stderr, "could match more than one sequence")
 end
+
+Name "gt extractfeat -fastaindex"
+Keywords "gt_extractfeat fastaindex"
+Test do
+  FileUtils.copy "#{$testdata}U89959_genomic.fas", "."
+  # the first run builds the index, the second one uses it
+  2.times do
+    run_test "#{$bin}gt extractfeat -fastaindex -seqfile U89959_genomic.fas " \
+      "-matchdesc -type CDS -join -translate #{$testdata}U89959_cds.gff3"
+    run "diff #{last_stdout} #{$testdata}U89959_cds.fas"
+    run "test -e U89959_genomic.fas.fai"
+  end
+  run "#{$bin}gt extractfeat -fastaindex -seqfile U89959_genomic.fas " \
+    "-type CDS -join -seqid -target " \
+    "#{$testdata}gt_extractfeat_seqid_target.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_extractfeat_seqid_target.fas"
+end
+
+Name "gt extractfeat -fastaindex (BGZF)"
+Keywords "gt_extractfeat fastaindex"
+Test do
+  FileUtils.copy "#{$testdata}U89959_genomic_bgzf.fas.gz", "."
+  2.times do
+    run_test "#{$bin}gt extractfeat -fastaindex " \
+      "-seqfile U89959_genomic_bgzf.fas.gz -matchdesc -type CDS -join " \
+      "-translate #{$testdata}U89959_cds.gff3"
+    run "diff #{last_stdout} #{$testdata}U89959_cds.fas"
+    run "test -e U89959_genomic_bgzf.fas.gz.fai"
+    run "test -e U89959_genomic_bgzf.fas.gz.gzi"
+  end
+end
+
+Name "gt extractfeat -fastaindex (corrupt BGZF index)"
+Keywords "gt_extractfeat fastaindex"
+Test do
+  FileUtils.copy "#{$testdata}U89959_genomic_bgzf.fas.gz", "."
+  run_test "#{$bin}gt extractfeat -fastaindex " \
+    "-seqfile U89959_genomic_bgzf.fas.gz -matchdesc -type CDS -join " \
+    "-translate #{$testdata}U89959_cds.gff3"
+  # shift the uncompressed offset of the second block
+  gzi = File.binread("U89959_genomic_bgzf.fas.gz.gzi")
+  gzi[16, 8] = [10001].pack("Q<")
+  File.binwrite("U89959_genomic_bgzf.fas.gz.gzi", gzi)
+  run_test "#{$bin}gt extractfeat -fastaindex " \
+    "-seqfile U89959_genomic_bgzf.fas.gz -matchdesc -type CDS -join " \
+    "-translate #{$testdata}U89959_cds.gff3", :retval => 1
+  grep last_stderr, /does not match file/
+end
+
+Name "gt extractfeat -fastaindex (corrupt BGZF block size)"
+Keywords "gt_extractfeat fastaindex"
+Test do
+  FileUtils.copy "#{$testdata}U89959_genomic_bgzf.fas.gz", "."
+  run_test "#{$bin}gt extractfeat -fastaindex " \
+    "-seqfile U89959_genomic_bgzf.fas.gz -matchdesc -type CDS -join " \
+    "-translate #{$testdata}U89959_cds.gff3"
+  # overwrite the ISIZE field of the second block, with and without .gzi
+  bgzf = File.binread("U89959_genomic_bgzf.fas.gz")
+  bgzf[3368 + 3246 - 4, 4] = [70000].pack("L<")
+  File.binwrite("U89959_genomic_bgzf.fas.gz", bgzf)
+  FileUtils.touch ["U89959_genomic_bgzf.fas.gz.fai",
+                   "U89959_genomic_bgzf.fas.gz.gzi"]
+  run_test "#{$bin}gt extractfeat -fastaindex " \
+    "-seqfile U89959_genomic_bgzf.fas.gz -matchdesc -type CDS -join " \
+    "-translate #{$testdata}U89959_cds.gff3", :retval => 1
+  grep last_stderr, /does not match file.*block at offset 3368/
+  FileUtils.rm_f ["U89959_genomic_bgzf.fas.gz.fai",
+                  "U89959_genomic_bgzf.fas.gz.gzi"]
+  run_test "#{$bin}gt extractfeat -fastaindex " \
+    "-seqfile U89959_genomic_bgzf.fas.gz -matchdesc -type CDS -join " \
+    "-translate #{$testdata}U89959_cds.gff3", :retval => 1
+  grep last_stderr, /block at offset 3368 .* is too large/
+end
+
+Name "gt extractfeat -fastaindex (samtools index)"
+Keywords "gt_extractfeat fastaindex"
+Test do
+  FileUtils.copy "#{$testdata}gt_extractfeat_succ_1.fas", "."
+  File.open("gt_extractfeat_succ_1.fas.fai", "w") do |f|
+    f.puts "foo\t100\t5\t100\t101"
+  end
+  run_test "#{$bin}gt extractfeat -fastaindex -type gene " \
+    "-seqfile gt_extractfeat_succ_1.fas " \
+    "-matchdesc #{$testdata}gt_extractfeat_succ_1.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_extractfeat_succ_1.out"
+  File.open("gt_extractfeat_succ_1.fas.fai", "w") do |f|
+    f.puts "foo\t100\t5\t100"
+  end
+  run_test "#{$bin}gt extractfeat -fastaindex -type gene " \
+    "-seqfile gt_extractfeat_succ_1.fas " \
+    "-matchdesc #{$testdata}gt_extractfeat_succ_1.gff3", :retval => 1
+  grep(last_stderr, "is corrupt or does not match")
+end
+
+Name "gt extractfeat -fastaindex (errors)"
+Keywords "gt_extractfeat fastaindex"
+Test do
+  FileUtils.copy "#{$testdata}gt_extractfeat_succ_1.fas.gz", "."
+  run_test "#{$bin}gt extractfeat -fastaindex -type gene " \
+    "-seqfile gt_extractfeat_succ_1.fas.gz " \
+    "-matchdesc #{$testdata}gt_extractfeat_succ_1.gff3", :retval => 1
+  grep(last_stderr, "is not BGZF compressed")
+  File.open("ragged.fas", "w") do |f|
+    f.puts ">foo"
+    f.puts "ACGT"
+    f.puts "AC"
+    f.puts "ACGT"
+  end
+  run_test "#{$bin}gt extractfeat -fastaindex -type gene " \
+    "-seqfile ragged.fas " \
+    "-matchdesc #{$testdata}gt_extractfeat_succ_1.gff3", :retval => 1
+  grep(last_stderr, "has lines of different length")
+  run_test "#{$bin}gt extractfeat -fastaindex -type gene " \
+    "#{$testdata}gt_extractfeat_succ_1.gff3", :retval => 1
+  grep(last_stderr, "requires option")
+end
+
+Name "gt extractfeat compare query method combinations (-fastaindex)"
+Keywords "gt_extractfeat query_methods fastaindex"
+Test do
+  FileUtils.copy "#{$testdata}gt_extractfeat_mappings.fas", "."
+  FileUtils.copy "#{$testdata}gt_extractfeat_mappings_sep1.fas", "."
+  FileUtils.copy "#{$testdata}gt_extractfeat_mappings_sep2.fas", "."
+  FileUtils.copy "#{$testdata}gt_extractfeat_mappings_seprm_bar.fas", "."
+  FileUtils.copy "#{$testdata}gt_extractfeat_mappings_seprm_baz.fas", "."
+  FileUtils.copy "#{$testdata}gt_extractfeat_mappings_seprm_foo.fas", "."
+  FileUtils.copy "#{$testdata}gt_extractfeat_mappings_seprm_quux.fas", "."
+  ["", ".md5"].each do |md5|
+    ["-usedesc","-matchdesc"].each do |method|
+      run "#{$bin}gt extractfeat #{method} -fastaindex " \
+        "-seqfile gt_extractfeat_mappings.fas " \
+        "-type gene #{$testdata}gt_extractfeat_mappings#{md5}.gff3 "
+      run "diff #{last_stdout} " \
+        "#{$testdata}gt_extractfeat_mappings_ref#{md5}.fas"
+      run "#{$bin}gt extractfeat #{method} -fastaindex -seqfiles " \
+        "gt_extractfeat_mappings_sep1.fas " \
+        "gt_extractfeat_mappings_sep2.fas " \
+        "-type gene #{$testdata}gt_extractfeat_mappings#{md5}.gff3 "
+      run "diff #{last_stdout} " \
+        "#{$testdata}gt_extractfeat_mappings_ref#{md5}.fas"
+    end
+    run "env GT_TESTDATA=./ #{$memcheck} #{$bin}gt extractfeat -fastaindex " \
+      "-regionmapping #{$testdata}gt_extractfeat_mappings_seprm.lua " \
+      "-type gene #{$testdata}gt_extractfeat_mappings#{md5}.gff3 "
+    run "diff #{last_stdout} #{$testdata}gt_extractfeat_mappings_ref#{md5}.fas"
+  end
+end
+
+Name "gt extractfeat -matchdescstart (-fastaindex)"
+Keywords "gt_extractfeat matchdescstart fastaindex"
+Test do
+  FileUtils.copy "#{$testdata}gt_extractfeat_matchdescstart_1.fas", "."
+  FileUtils.copy "#{$testdata}gt_extractfeat_matchdescstart_2.fas", "."
+  run "#{$bin}gt extractfeat -fastaindex -seqfile " \
+    "gt_extractfeat_matchdescstart_1.fas -type gene -matchdesc " \
+    "#{$testdata}gt_extractfeat_matchdescstart_1.gff3", :retval => 1
+  grep(last_stderr, "could match more than one sequence")
+  run "#{$bin}gt extractfeat -fastaindex -seqfile " \
+    "gt_extractfeat_matchdescstart_1.fas -type gene " \
+    "-matchdescstart #{$testdata}gt_extractfeat_matchdescstart_1.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_extractfeat_matchdescstart_1.out"
+  run "#{$bin}gt extractfeat -fastaindex -seqfile " \
+    "gt_extractfeat_matchdescstart_2.fas -type gene " \
+    "-matchdescstart #{$testdata}gt_extractfeat_matchdescstart_1.gff3", \
+    :retval => 1
+  grep(last_stderr, "could match more than one sequence")
+end
@@ -1049,6 +1049,71 @@ Test do
   run_test "#{$bin}gt gff3 out.gff3.bz2 | diff #{$testdata}dynbuf.gff3 -"
 end
 
+Name "gt gff3 -writethread"
+Keywords "gt_gff3 writethread"
+Test do
+  ["dynbuf.gff3", "standard_gene_as_dag.gff3",
+   "multi_feature_simple.gff3"].each do |file|
+    run_test "#{$bin}gt gff3 #{$testdata}#{file}"
+    run "mv #{last_stdout} expected.gff3"
+    run_test "#{$bin}gt gff3 -writethread -gzip -force -o out.gff3.gz " +
+             "#{$testdata}#{file}"
+    run "gzip -dc out.gff3.gz | diff expected.gff3 -"
+  end
+end
+
+Name "gt gff3 -binaryout/-binaryin"
+Keywords "gt_gff3 binary"
+Test do
+  ["all_node_types.gff3", "standard_gene_as_dag.gff3",
+   "multi_feature_simple.gff3", "U89959_csas.gff3",
+   "standard_fasta_example.gff3", "meta_directives.gff3"].each do |file|
+    run_test "#{$bin}gt gff3 -retainids #{$testdata}#{file}"
+    run "mv #{last_stdout} expected.gff3"
+    run_test "#{$bin}gt gff3 -binaryout -force -o out.bin #{$testdata}#{file}"
+    run_test "#{$bin}gt gff3 -retainids -binaryin out.bin"
+    run "diff #{last_stdout} expected.gff3"
+  end
+end
+
+Name "gt gff3 -binaryout/-binaryin (compressed, stdin)"
+Keywords "gt_gff3 binary"
+Test do
+  run_test "#{$bin}gt gff3 -sort #{$testdata}encode_known_genes_Mar07.gff3"
+  run "mv #{last_stdout} expected.gff3"
+  run_test "#{$bin}gt gff3 -binaryout -gzip -force -o out.bin.gz " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run_test "gzip -dc out.bin.gz | #{$bin}gt gff3 -binaryin -sort -"
+  run "diff #{last_stdout} expected.gff3"
+end
+
+Name "gt gff3 -binaryin (no binary node stream)"
+Keywords "gt_gff3 binary"
+Test do
+  run_test "#{$bin}gt gff3 -binaryin #{$testdata}standard_gene_as_tree.gff3",
+           :retval => 1
+  grep last_stderr, "is not a binary node stream"
+end
+
+Name "gt gff3 -binaryin (cyclic binary node stream)"
+Keywords "gt_gff3 binary"
+Test do
+  ["binary_stream_cycle.bin", "binary_stream_selfloop.bin"].each do |file|
+    run_test "#{$bin}gt gff3 -binaryin #{$testdata}#{file}", :retval => 1
+    grep last_stderr, "corrupt binary node stream"
+  end
+end
+
+Name "gt gff3 -binaryin (truncated binary node stream)"
+Keywords "gt_gff3 binary"
+Test do
+  run_test "#{$bin}gt gff3 -binaryout -force -o out.bin " +
+           "#{$testdata}standard_gene_as_dag.gff3"
+  run "head -c 100 out.bin > truncated.bin"
+  run_test "#{$bin}gt gff3 -binaryin truncated.bin", :retval => 1
+  grep last_stderr, "unexpected end of binary node stream"
+end
+
 Name "custom_stream (C)"
 Keywords "gt_gff3 examples"
 Test do
@@ -37,6 +37,65 @@ Test do
   grep last_stdout, "input is valid GFF3"
 end
 
+def write_part_of_violation(filename)
+  File.open(filename, "w") do |f|
+    f.puts "##gff-version 3"
+    f.puts "ctg1\t.\tgene\t1\t100\t.\t+\t.\tID=g1"
+    f.puts "ctg1\t.\tintron\t10\t20\t.\t+\t.\tID=i1;Parent=g1"
+    f.puts "ctg1\t.\texon\t10\t20\t.\t+\t.\tParent=i1"
+  end
+end
+
+Name "gt gff3validator -typecheck compiled type graph"
+Keywords "gt_gff3validator typecheck"
+Test do
+  FileUtils.copy "#{$cur}/gtdata/obo_files/sofa.obo", "."
+  FileUtils.mkdir "cache"
+  cache = {"GT_CACHE_DIR" => "cache"}
+  write_part_of_violation("violation.gff3")
+  2.times do
+    run_test "#{$bin}gt gff3validator -typecheck sofa.obo #{obo_gff3_file}",
+             :env => cache
+    grep last_stdout, "input is valid GFF3"
+    if Dir.glob("cache/sofa.obo.*.gttc").length != 1 then
+      raise "compiled type graph of sofa.obo was not written to cache"
+    end
+    if File.exist?("sofa.obo.gttc") then
+      raise "compiled type graph was written next to sofa.obo"
+    end
+    run_test "#{$bin}gt gff3validator -typecheck sofa.obo violation.gff3",
+             :retval => 1, :env => cache
+    grep last_stderr, "is not part-of parent feature with type 'intron'"
+  end
+end
+
+Name "gt gff3validator -typecheck stale compiled type graph"
+Keywords "gt_gff3validator typecheck"
+Test do
+  FileUtils.copy "#{$testdata}obo_files/minimal_stanza.obo", "types.obo"
+  FileUtils.mkdir "cache"
+  cache = {"GT_CACHE_DIR" => "cache"}
+  run_test "#{$bin}gt gff3validator -typecheck types.obo #{obo_gff3_file}",
+           :retval => 1, :env => cache
+  FileUtils.copy "#{$cur}/gtdata/obo_files/sofa.obo", "types.obo"
+  run_test "#{$bin}gt gff3validator -typecheck types.obo #{obo_gff3_file}",
+           :env => cache
+  grep last_stdout, "input is valid GFF3"
+  cachefile = Dir.glob("cache/types.obo.*.gttc").first
+  File.open(cachefile, "w") { |f| f.puts "corrupt" }
+  run_test "#{$bin}gt gff3validator -typecheck types.obo #{obo_gff3_file}",
+           :env => cache
+  grep last_stdout, "input is valid GFF3"
+  # an empty cache file cannot be mapped, it must be rewritten
+  File.open(cachefile, "w") { }
+  run_test "#{$bin}gt gff3validator -typecheck types.obo #{obo_gff3_file}",
+           :env => cache
+  grep last_stdout, "input is valid GFF3"
+  if File.size(cachefile) == 0 then
+    raise "empty compiled type graph #{cachefile} was not rewritten"
+  end
+end
+
 Name "gt gff3validator corrupt file"
 Keywords "gt_gff3validator"
 Test do
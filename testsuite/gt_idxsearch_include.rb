@@ -98,6 +98,10 @@ Test do
   run_test "#{$bin}gt dev patternmatch -samples 10000 -minpl 10 -maxpl 15 " +
            " -bck -imm -ii sfx"
   run_test "#{$bin}gt dev patternmatch -samples 10000 -ii sfx"
+  run_test "#{$bin}gt dev patternmatch -samples 10000 -minpl 10 -maxpl 15 " +
+           " -batch -imm -ii sfx"
+  run_test "#{$bin}gt -j 3 dev patternmatch -samples 10000 -minpl 2 " +
+           "-maxpl 15 -batch -bck -imm -ii sfx"
 end
 
 allfiles.each do |reffile|
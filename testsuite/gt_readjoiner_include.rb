@@ -1070,6 +1070,22 @@ Test do
   run_assembly
 end
 
+Name "gt readjoiner assembly threads"
+Keywords "gt_readjoiner gt_readjoiner_threads"
+Test do
+  run "#{$bin}gt encseq encode -indexname at #{$testdata}at1MB"
+  run "#{$bin}gt simreads -coverage 5 -len 150 -force -o sim.fas at"
+  run_prefilter("sim.fas")
+  run_overlap(40)
+  ["", "-redtrans", "-errors -bubble 3 -deadend 3"].each_with_index do |o, i|
+    [1, 4].each do |threads|
+      run "#{$bin}gt -j #{threads} readjoiner assembly -readset reads #{o}"
+      run "mv reads.contigs.fas contigs-#{i}-#{threads}.fas"
+    end
+    run "cmp contigs-#{i}-1.fas contigs-#{i}-4.fas"
+  end
+end
+
 Name "gt readjoiner spmtest pw"
 Keywords "gt_readjoiner gt_readjoiner_spmtest"
 Test do
@@ -11,3 +11,12 @@ Test do
   run "#{$bin}gt dev regioncov -maxfeaturedist 220000 #{$testdata}encode_known_genes_Mar07.gff3"
   run "diff #{last_stdout} #{$testdata}gt_regioncov_test_2.out"
 end
+
+Name "gt regioncov test 3 (-store)"
+Keywords "gt_regioncov"
+Test do
+  run "#{$bin}gt dev regioncov -store #{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_regioncov_test_1.out"
+  run "#{$bin}gt dev regioncov -store -maxfeaturedist 220000 #{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_regioncov_test_2.out"
+end
@@ -575,3 +575,86 @@ Test do
     grep last_stdout, /23 418 127 P 24 2 68 35 4 82.98/
   end
 end
+
+Name "gt seed_extend: server"
+Keywords "gt_seed_extend server"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("U89959", "#{$testdata}U89959_genomic.fas")
+  run_test build_encseq("Atinsert", "#{$testdata}Atinsert.fna")
+  ["", "-parts 2"].each do |parts|
+    run "rm -f oneshot.out"
+    ["U89959", "Atinsert"].each do |query|
+      run_test "#{$bin}gt seed_extend -ii at1MB -qii #{query} " +
+               "-seedlength 14 -l 50 #{parts}"
+      run "grep -v '^#' #{last_stdout} >> oneshot.out"
+    end
+    File.open("queries", "w") do |f|
+      f.puts "U89959"
+      f.puts ""
+      f.puts "Atinsert"
+    end
+    run_test "#{$bin}gt seed_extend -ii at1MB -server queries " +
+             "-seedlength 14 -l 50 #{parts}"
+    run "grep -v '^#' #{last_stdout} > server.out"
+    run "cmp oneshot.out server.out"
+  end
+  run_test "#{$bin}gt seed_extend -ii at1MB -server queries", :retval => 1
+  grep last_stderr, /option "-server" requires option "-seedlength"/
+  run_test "#{$bin}gt seed_extend -ii at1MB -server queries -seedlength 14 " +
+           "-qii U89959", :retval => 1
+end
+
+Name "gt seed_extend: minimizer"
+Keywords "gt_seed_extend minimizer"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test "#{$bin}gt seed_extend -ii at1MB -seedlength 14 -l 100 " +
+           "-kmerfile no"
+  all_kmers = `grep -v '^#' #{last_stdout}`.lines.sort
+  for splt in $SPLT_LIST do
+    run_test "#{$bin}gt seed_extend -ii at1MB -seedlength 14 -l 100 " +
+             "-minimizer 8 -verify-alignment -kmerfile no #{splt}"
+    minimizers = `grep -v '^#' #{last_stdout}`.lines.sort
+    if minimizers.length < 0.9 * all_kmers.length or
+       (minimizers - all_kmers).length > 0.1 * minimizers.length
+      failtest("minimizers miss too many matches")
+    end
+    if minimizers.grep(/ P /).length != all_kmers.grep(/ P /).length
+      failtest("minimizers miss reverse complement matches")
+    end
+  end
+  run_test "#{$bin}gt seed_extend -ii at1MB -seedlength 14 -minimizer 15",
+           :retval => 1
+  grep last_stderr, /must not be larger than 14 \(seedlength\)/
+  run_test "#{$bin}gt seed_extend -ii at1MB -minimizer 8 -maxmat", :retval => 1
+end
+
+Name "gt seed_extend: paf and sam output"
+Keywords "gt_seed_extend outfmt paf sam"
+Test do
+  run_test build_encseq("at1MB", "#{$testdata}at1MB")
+  run_test build_encseq("Atinsert", "#{$testdata}Atinsert.fna")
+  run_test "#{$bin}gt seed_extend -ii at1MB -qii Atinsert"
+  matches = `grep -v '^#' #{last_stdout}`.lines.length
+  run_test "#{$bin}gt seed_extend -ii at1MB -qii Atinsert -outfmt paf cigar"
+  paf = File.readlines(last_stdout)
+  if paf.length != matches or
+     paf.any? {|l| l.split("\t").length != 15 or l !~ /\tcg:Z:(\d+[MID])+$/}
+    failtest("unexpected PAF output")
+  end
+  run_test "#{$bin}gt seed_extend -ii at1MB -qii Atinsert -outfmt sam"
+  grep last_stdout, /^@HD\tVN:1.6/
+  grep last_stdout, /^@SQ\tSN:gi\|5587835\|gb\|AF078689.1\|AF078689\tLN:275$/
+  sam = File.readlines(last_stdout).reject {|l| l.start_with?("@")}
+  if sam.length != matches or
+     sam.any? {|l| l.split("\t").length != 13}
+    failtest("unexpected SAM output")
+  end
+  run_test "#{$bin}gt seed_extend -ii at1MB -outfmt sam cigarX"
+  run "mv #{last_stdout} sam.out"
+  run_test "#{$bin}gt -j 3 seed_extend -ii at1MB -outfmt sam cigarX"
+  run "cmp #{last_stdout} sam.out"
+  run_test "#{$bin}gt seed_extend -ii at1MB -outfmt sam blast", :retval => 1
+  run_test "#{$bin}gt seed_extend -ii at1MB -outfmt paf sam", :retval => 1
+end
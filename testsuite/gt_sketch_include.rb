@@ -212,6 +212,35 @@ Test do
            :maxtime => 600
 end
 
+Name "gt sketch_page -seqfile (description start)"
+Keywords "gt_sketch gt_sketch_page"
+Test do
+  run "sed 's/^>gi|1877523|gb|U89959.1|/>1877523/' " + \
+      "#{$testdata}U89959_genomic.fas > genomic.fas"
+  run "cat #{$testdata}U89959_ests_unique.fas >> genomic.fas"
+  run_test "#{$bin}gt sketch_page -seqfile genomic.fas out.pdf " + \
+           "#{$testdata}U89959_sas.gff3", :maxtime => 600
+  run "test -s out.pdf"
+end
+
+Name "gt sketch_page -seqfile (single sequence)"
+Keywords "gt_sketch gt_sketch_page"
+Test do
+  run_test "#{$bin}gt sketch_page -seqfile #{$testdata}U89959_genomic.fas " + \
+           "out.pdf #{$testdata}U89959_sas.gff3", :maxtime => 600
+  run "test -s out.pdf"
+end
+
+Name "gt sketch_page -seqfile (no matching sequence)"
+Keywords "gt_sketch gt_sketch_page"
+Test do
+  run "cat #{$testdata}U89959_genomic.fas " + \
+      "#{$testdata}U89959_ests_unique.fas > genomic.fas"
+  run_test "#{$bin}gt sketch_page -seqfile genomic.fas out.pdf " + \
+           "#{$testdata}U89959_sas.gff3", :retval => 1, :maxtime => 600
+  grep last_stderr, /no description matched sequence ID '1877523'/
+end
+
 if python_tests_runnable? and not $arguments["nocairo"] then
   Name "sketch_constructed (Python)"
   Keywords "gt_sketch gt_python annotationsketch"
@@ -45,6 +45,69 @@ tyrfiles = {"Atinsert.fna" => 19,
             "trna_glutamine.fna" => 10,
             "at1MB" => 20}
 
+Name "gt tallymer search hash and threads"
+Keywords "gt_tallymer search"
+Test do
+  run_test "#{$bin}gt suffixerator -pl -dna -tis -suf -lcp " +
+           "-indexname sfxidx -db #{$testdata}at1MB"
+  run_test "#{$bin}gt tallymer mkindex -counts -pl -hash -mersize 20 " +
+           "-minocc 2 -maxocc 30 -indexname tyr-hash -esa sfxidx"
+  run_test "#{$bin}gt tallymer mkindex -counts -pl -mersize 20 " +
+           "-minocc 2 -maxocc 30 -indexname tyr-bck -esa sfxidx"
+  run_test "#{$bin}gt shredder -minlength 50 -maxlength 400 " +
+           "#{$testdata}at1MB"
+  run "mv #{last_stdout} queries.fas"
+  run_test "#{$bin}gt tallymer search -strand fp -output qseqnum qpos " +
+           "counts sequence -tyr tyr-bck -q queries.fas"
+  run "mv #{last_stdout} bck.out"
+  run_test "#{$bin}gt -j 3 tallymer search -strand fp -output qseqnum qpos " +
+           "counts sequence -tyr tyr-hash -q queries.fas"
+  run "cmp #{last_stdout} bck.out"
+end
+
+Name "gt tallymer search stale hash"
+Keywords "gt_tallymer search"
+Test do
+  run_test "#{$bin}gt suffixerator -pl -dna -tis -suf -lcp " +
+           "-indexname sfxidx -db #{$testdata}at1MB"
+  run_test "#{$bin}gt tallymer mkindex -counts -pl -hash -mersize 20 " +
+           "-minocc 2 -maxocc 30 -indexname tyr-a -esa sfxidx"
+  run "test -f tyr-a.mhs"
+  run "cp tyr-a.mhs saved.mhs"
+  run_test "#{$bin}gt tallymer mkindex -counts -pl -mersize 20 " +
+           "-minocc 2 -maxocc 30 -indexname tyr-a -esa sfxidx"
+  run "test ! -f tyr-a.mhs"
+  run_test "#{$bin}gt tallymer mkindex -counts -pl -mersize 20 " +
+           "-minocc 3 -maxocc 30 -indexname tyr-a -esa sfxidx"
+  run "cp saved.mhs tyr-a.mhs"
+  run_test "#{$bin}gt tallymer search -output qseqnum qpos " +
+           "-tyr tyr-a -q #{$testdata}U89959_genomic.fas", :retval => 1
+  grep last_stderr, /was not built from the current index/
+end
+
+Name "gt tallymer mkindex and occratio threads"
+Keywords "gt_tallymer mkindex occratio"
+Test do
+  run_test "#{$bin}gt suffixerator -pl -dna -tis -suf -lcp " +
+           "-indexname sfxidx -db #{$testdata}at1MB"
+  [1,3].each do |threads|
+    run_test "#{$bin}gt -j #{threads} tallymer mkindex -counts -pl " +
+             "-mersize 20 -minocc 2 -maxocc 30 -indexname tyr-#{threads} " +
+             "-esa sfxidx"
+    run_test "#{$bin}gt -j #{threads} tallymer mkindex -mersize 14 " +
+             "-minocc 2 -maxocc 5 -esa sfxidx"
+    run "mv #{last_stdout} dist-#{threads}.out"
+    run_test "#{$bin}gt -j #{threads} tallymer occratio -minmersize 10 " +
+             "-maxmersize 25 -output unique nonunique nonuniquemulti " +
+             "relative total -esa sfxidx"
+    run "mv #{last_stdout} occratio-#{threads}.out"
+  end
+  run "cmp tyr-1.mer tyr-3.mer"
+  run "cmp tyr-1.mct tyr-3.mct"
+  run "cmp dist-1.out dist-3.out"
+  run "cmp occratio-1.out occratio-3.out"
+end
+
 runtyrmkifail("-mersize 21 -pl")
 runtyrmkifail("-mersize 21 -pl -minocc")
 runtyrmkifail("-pl -minocc 30 -maxocc 40")
@@ -162,6 +162,7 @@ def ruby_tests_runnable?
 end
 
 # include the actual test modules
+require 'gt_batch_include'
 require 'gt_bed_to_gff3_include'
 require 'gt_cds_include'
 require 'gt_chseqids_include'